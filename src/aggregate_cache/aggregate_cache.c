@@ -0,0 +1,174 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "aggregate_cache.h"
+#include "../util/arr.h"
+#include "../util/rmalloc.h"
+#include "../configuration/config.h"
+
+#include <pthread.h>
+
+// a single cache entry
+typedef struct {
+	LabelID l;                  // label
+	Attribute_ID attr;          // attribute
+	uint64_t epoch;             // graph write epoch at build time
+	uint64_t used;              // last access tick
+	AttributeSummary *summary;  // summary, NULL if attribute can't be summarized
+} AggregateCacheEntry;
+
+struct AggregateCache {
+	AggregateCacheEntry *entries;  // cache entries
+	uint64_t tick;                 // access counter
+	pthread_mutex_t lock;          // protects entries
+};
+
+// create a new aggregate cache
+AggregateCache *AggregateCache_New(void) {
+	AggregateCache *cache = rm_malloc(sizeof(AggregateCache));
+
+	cache->tick    = 0;
+	cache->entries = array_new(AggregateCacheEntry, 0);
+	int res = pthread_mutex_init(&cache->lock, NULL);
+	ASSERT(res == 0);
+
+	return cache;
+}
+
+static void _AggregateCacheEntry_Free
+(
+	AggregateCacheEntry *e
+) {
+	if(e->summary != NULL) AttributeSummary_Free(e->summary);
+}
+
+// evict least recently used entries until the cache holds less than 'cap'
+// entries, caller must hold the cache lock
+static void _AggregateCache_Evict
+(
+	AggregateCache *cache,
+	uint64_t cap
+) {
+	while(array_len(cache->entries) > 0 && array_len(cache->entries) >= cap) {
+		uint lru = 0;
+		uint n = array_len(cache->entries);
+		for(uint i = 1; i < n; i++) {
+			if(cache->entries[i].used < cache->entries[lru].used) lru = i;
+		}
+
+		_AggregateCacheEntry_Free(cache->entries + lru);
+		array_del_fast(cache->entries, lru);
+	}
+}
+
+// get summary of attribute 'attr' of label 'l'
+// builds the summary if it is missing or stale
+AttributeSummary *AggregateCache_Get
+(
+	AggregateCache *cache,  // aggregate cache
+	const Graph *g,         // graph
+	LabelID l,              // label
+	Attribute_ID attr       // attribute
+) {
+	ASSERT(g     != NULL);
+	ASSERT(cache != NULL);
+
+	uint64_t cap;
+	Config_Option_get(Config_AGGREGATE_CACHE_SIZE, &cap);
+
+	// cache disabled, release summaries built while it was enabled
+	if(cap == 0) {
+		pthread_mutex_lock(&cache->lock);
+		_AggregateCache_Evict(cache, 0);
+		pthread_mutex_unlock(&cache->lock);
+		return NULL;
+	}
+
+	// the epoch can't change while the graph's READ lock is held
+	uint64_t epoch = Graph_WriteEpoch(g);
+
+	//--------------------------------------------------------------------------
+	// lookup
+	//--------------------------------------------------------------------------
+
+	pthread_mutex_lock(&cache->lock);
+
+	uint n = array_len(cache->entries);
+	for(uint i = 0; i < n; i++) {
+		AggregateCacheEntry *e = cache->entries + i;
+		if(e->l != l || e->attr != attr || e->epoch != epoch) continue;
+
+		e->used = ++cache->tick;
+		AttributeSummary *s = (e->summary != NULL)
+			? AttributeSummary_Share(e->summary)
+			: NULL;
+		pthread_mutex_unlock(&cache->lock);
+		return s;
+	}
+
+	pthread_mutex_unlock(&cache->lock);
+
+	//--------------------------------------------------------------------------
+	// build
+	//--------------------------------------------------------------------------
+
+	// build outside of the cache lock
+	// concurrent readers may build the same summary, the last one is kept
+	AttributeSummary *s = AttributeSummary_Build(g, l, attr);
+
+	// the writer holding the write lock may still modify the graph
+	// without advancing the epoch, don't share its summary
+	if(Graph_WriteLocked(g)) return s;
+
+	pthread_mutex_lock(&cache->lock);
+
+	// remove previous entry
+	n = array_len(cache->entries);
+	for(uint i = 0; i < n; i++) {
+		AggregateCacheEntry *e = cache->entries + i;
+		if(e->l != l || e->attr != attr) continue;
+
+		_AggregateCacheEntry_Free(e);
+		array_del_fast(cache->entries, i);
+		break;
+	}
+
+	_AggregateCache_Evict(cache, cap);
+
+	AggregateCacheEntry e = {
+		.l       = l,
+		.attr    = attr,
+		.epoch   = epoch,
+		.used    = ++cache->tick,
+		.summary = (s != NULL) ? AttributeSummary_Share(s) : NULL
+	};
+	array_append(cache->entries, e);
+
+	pthread_mutex_unlock(&cache->lock);
+
+	return s;
+}
+
+// free aggregate cache
+void AggregateCache_Free
+(
+	AggregateCache *cache  // aggregate cache
+) {
+	ASSERT(cache != NULL);
+
+	uint n = array_len(cache->entries);
+	for(uint i = 0; i < n; i++) {
+		_AggregateCacheEntry_Free(cache->entries + i);
+	}
+	array_free(cache->entries);
+
+	int res = pthread_mutex_destroy(&cache->lock);
+	ASSERT(res == 0);
+
+	rm_free(cache);
+}
+
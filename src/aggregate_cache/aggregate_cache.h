@@ -0,0 +1,45 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "attribute_summary.h"
+
+// an aggregate cache holds a graph's attribute summaries,
+// keyed by (label, attribute)
+//
+// summaries are computed from the graph's attribute sets on first access
+// and remain valid as long as the graph's write epoch is unchanged
+// once the graph is modified stale summaries are rebuilt on their next access
+//
+// the cache is bounded by the AGGREGATE_CACHE_SIZE configuration,
+// the least recently used summary is evicted once the cache is full
+// a size of 0 disables the cache
+
+typedef struct AggregateCache AggregateCache;
+
+// create a new aggregate cache
+AggregateCache *AggregateCache_New(void);
+
+// get summary of attribute 'attr' of label 'l'
+// builds the summary if it is missing or stale
+// returns NULL if the cache is disabled or the attribute
+// can't be summarized
+// caller must hold the graph's READ lock and release the returned
+// summary via AttributeSummary_Free
+AttributeSummary *AggregateCache_Get
+(
+	AggregateCache *cache,  // aggregate cache
+	const Graph *g,         // graph
+	LabelID l,              // label
+	Attribute_ID attr       // attribute
+);
+
+// free aggregate cache
+void AggregateCache_Free
+(
+	AggregateCache *cache  // aggregate cache
+);
@@ -0,0 +1,272 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "attribute_summary.h"
+#include "../util/rmalloc.h"
+#include "../graph/rg_matrix/rg_matrix_iter.h"
+
+#include <math.h>
+#include <float.h>
+#include <string.h>
+
+// return true if adding a and b will overflow
+// must match the check performed by the avg aggregate function
+#define ABOUT_TO_OVERFLOW(a, b) (signbit((a)) == signbit((b)) && \
+	   (fabsl((a)) > (DBL_MAX - fabsl((b)))))
+
+// map SIValue type to summary type
+// returns false if type can't be summarized
+static bool _SummaryType
+(
+	SIValue v,            // value
+	SummaryValueType *t   // [output] summary type
+) {
+	switch(SI_TYPE(v)) {
+		case T_INT64:
+			*t = SUMMARY_INT64;
+			return true;
+		case T_DOUBLE:
+			// NaN doesn't compare consistently, keep it out of summaries
+			if(isnan(v.doubleval)) return false;
+			*t = SUMMARY_DOUBLE;
+			return true;
+		case T_BOOL:
+			*t = SUMMARY_BOOL;
+			return true;
+		case T_STRING:
+			*t = SUMMARY_STRING;
+			return true;
+		default:
+			return false;
+	}
+}
+
+// returns true if 'a' is less than 'b', both of summary type 't'
+static bool _LessThan
+(
+	SummaryValueType t,  // summary type
+	SIValue a,           // first value
+	SIValue b            // second value
+) {
+	switch(t) {
+		case SUMMARY_INT64:
+			return a.longval < b.longval;
+		case SUMMARY_DOUBLE:
+			return a.doubleval < b.doubleval;
+		case SUMMARY_STRING:
+			return strcmp(a.stringval, b.stringval) < 0;
+		default:
+			ASSERT(false);
+			return false;
+	}
+}
+
+// build a summary of attribute 'attr' of label 'l'
+// returns NULL if the attribute values can't be summarized
+// caller must hold the graph's READ lock
+AttributeSummary *AttributeSummary_Build
+(
+	const Graph *g,     // graph
+	LabelID l,          // label
+	Attribute_ID attr   // attribute
+) {
+	ASSERT(g != NULL);
+	ASSERT(attr != ATTRIBUTE_ID_NONE);
+
+	bool valid = true;
+	bool typed = false;  // type is determined by the first value
+
+	// label doesn't hold the attribute, summarize as int64
+	SummaryValueType type = SUMMARY_INT64;
+
+	// min and max refer to the scanned attribute sets until the scan is done
+	SIValue min = SI_NullVal();
+	SIValue max = SI_NullVal();
+
+	// replicate the sum and avg aggregate functions
+	// including the avg handling of overflow
+	double sum = 0;
+	uint64_t count = 0;
+	long double total = 0;
+	bool overflow = false;
+
+	GrB_Index id;
+	RG_MatrixTupleIter it;
+	RG_Matrix L = Graph_GetLabelMatrix(g, l);
+	RG_MatrixTupleIter_attach(&it, L);
+
+	// values are visited in node ID order
+	while(RG_MatrixTupleIter_next_BOOL(&it, &id, NULL, NULL) == GrB_SUCCESS) {
+		Node n;
+		if(!Graph_GetNode(g, id, &n)) continue;
+
+		AttributeSet set = GraphEntity_GetAttributes((GraphEntity *)&n);
+		SIValue *v = AttributeSet_Get(set, attr);
+		if(v == ATTRIBUTE_NOTFOUND || SI_TYPE(*v) == T_NULL) continue;
+
+		SummaryValueType t;
+		if(!_SummaryType(*v, &t) || (typed && t != type)) {
+			// unsupported or mixed types
+			valid = false;
+			break;
+		}
+
+		type  = t;
+		typed = true;
+		count++;
+
+		if(t == SUMMARY_BOOL) continue;
+
+		// on ties the first value in node ID order is kept
+		if(count == 1 || _LessThan(t, *v, min)) min = *v;
+		if(count == 1 || _LessThan(t, max, *v)) max = *v;
+
+		if(t == SUMMARY_STRING) continue;
+
+		double d = (t == SUMMARY_INT64) ? (double)v->longval : v->doubleval;
+		long double ld = d;
+
+		sum += d;
+		if(overflow || ABOUT_TO_OVERFLOW(total, ld)) {
+			total /= (long double)count;
+			if(overflow) total *= (long double)(count - 1);
+			total += (ld / (long double)count);
+			overflow = true;
+		} else {
+			total += ld;
+		}
+	}
+
+	RG_MatrixTupleIter_detach(&it);
+
+	if(!valid) return NULL;
+
+	AttributeSummary *s = rm_malloc(sizeof(AttributeSummary));
+
+	s->type      = type;
+	s->count     = count;
+	s->sum       = sum;
+	s->avg       = (count == 0) ? 0 : (overflow ? total : total / count);
+	s->ref_count = 1;
+
+	// take ownership of string extremes
+	s->min = (SI_TYPE(min) == T_STRING)
+		? SI_DuplicateStringVal(min.stringval)
+		: min;
+	s->max = (SI_TYPE(max) == T_STRING)
+		? SI_DuplicateStringVal(max.stringval)
+		: max;
+
+	return s;
+}
+
+//------------------------------------------------------------------------------
+// aggregations
+//------------------------------------------------------------------------------
+
+// count non null values
+bool AttributeSummary_Count
+(
+	const AttributeSummary *s,  // summary
+	SIValue *res                // [output] count
+) {
+	ASSERT(s   != NULL);
+	ASSERT(res != NULL);
+
+	*res = SI_LongVal(s->count);
+	return true;
+}
+
+// sum values, numeric attributes only
+bool AttributeSummary_Sum
+(
+	const AttributeSummary *s,  // summary
+	SIValue *res                // [output] sum
+) {
+	ASSERT(s   != NULL);
+	ASSERT(res != NULL);
+
+	if(s->type != SUMMARY_INT64 && s->type != SUMMARY_DOUBLE) return false;
+
+	*res = SI_DoubleVal(s->sum);
+	return true;
+}
+
+// average values, numeric attributes only
+bool AttributeSummary_Avg
+(
+	const AttributeSummary *s,  // summary
+	SIValue *res                // [output] average
+) {
+	ASSERT(s   != NULL);
+	ASSERT(res != NULL);
+
+	if(s->type != SUMMARY_INT64 && s->type != SUMMARY_DOUBLE) return false;
+
+	*res = (s->count == 0) ? SI_NullVal() : SI_DoubleVal(s->avg);
+	return true;
+}
+
+// hand out either the minimum or the maximum value
+static bool _AttributeSummary_Extreme
+(
+	const AttributeSummary *s,  // summary
+	SIValue v,                  // extreme value
+	SIValue *res                // [output] extreme value
+) {
+	ASSERT(s   != NULL);
+	ASSERT(res != NULL);
+
+	if(s->type == SUMMARY_BOOL) return false;
+
+	*res = (SI_TYPE(v) == T_STRING) ? SI_DuplicateStringVal(v.stringval) : v;
+	return true;
+}
+
+// minimum value, numeric and string attributes only
+bool AttributeSummary_Min
+(
+	const AttributeSummary *s,  // summary
+	SIValue *res                // [output] minimum
+) {
+	return _AttributeSummary_Extreme(s, s->min, res);
+}
+
+// maximum value, numeric and string attributes only
+bool AttributeSummary_Max
+(
+	const AttributeSummary *s,  // summary
+	SIValue *res                // [output] maximum
+) {
+	return _AttributeSummary_Extreme(s, s->max, res);
+}
+
+// increase summary reference count
+AttributeSummary *AttributeSummary_Share
+(
+	AttributeSummary *s  // summary
+) {
+	ASSERT(s != NULL);
+
+	__atomic_fetch_add(&s->ref_count, 1, __ATOMIC_RELAXED);
+	return s;
+}
+
+// decrease summary reference count
+// frees summary once reference count reaches 0
+void AttributeSummary_Free
+(
+	AttributeSummary *s  // summary
+) {
+	ASSERT(s != NULL);
+
+	if(__atomic_sub_fetch(&s->ref_count, 1, __ATOMIC_ACQ_REL) > 0) return;
+
+	SIValue_Free(s->min);
+	SIValue_Free(s->max);
+	rm_free(s);
+}
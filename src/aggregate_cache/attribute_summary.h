@@ -0,0 +1,112 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "../value.h"
+#include "../graph/graph.h"
+#include "../graph/entities/attribute_set.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// an attribute summary holds the label wide aggregates of a single attribute
+// count, sum, avg, min and max, computed in a single pass over the label
+// attribute values themselves aren't copied, attribute sets remain
+// the only storage of entity attributes
+//
+// a summary is only built when all values of the attribute
+// across the label share a single scalar type:
+// int64, double (NaN excluded), bool or string
+//
+// summaries are immutable once built and are reference counted
+// see aggregate_cache.h for their lifetime
+
+typedef enum {
+	SUMMARY_INT64,   // int64 values
+	SUMMARY_DOUBLE,  // double values
+	SUMMARY_BOOL,    // boolean values
+	SUMMARY_STRING   // string values
+} SummaryValueType;
+
+typedef struct {
+	SummaryValueType type;  // values type
+	uint64_t count;         // number of nodes holding the attribute
+	double sum;             // sum of numeric values
+	double avg;             // average of numeric values
+	SIValue min;            // minimum value, null if there are no values
+	SIValue max;            // maximum value, null if there are no values
+	int ref_count;          // number of references
+} AttributeSummary;
+
+// build a summary of attribute 'attr' of label 'l'
+// returns NULL if the attribute values can't be summarized
+// caller must hold the graph's READ lock
+AttributeSummary *AttributeSummary_Build
+(
+	const Graph *g,     // graph
+	LabelID l,          // label
+	Attribute_ID attr   // attribute
+);
+
+//------------------------------------------------------------------------------
+// aggregations
+//------------------------------------------------------------------------------
+
+// the following functions produce the same result as their
+// aggregate function counterparts applied to the attribute's values
+// in node ID order
+// they return false if the aggregation doesn't apply to the values type
+
+// count non null values
+bool AttributeSummary_Count
+(
+	const AttributeSummary *s,  // summary
+	SIValue *res                // [output] count
+);
+
+// sum values, numeric attributes only
+bool AttributeSummary_Sum
+(
+	const AttributeSummary *s,  // summary
+	SIValue *res                // [output] sum
+);
+
+// average values, numeric attributes only
+bool AttributeSummary_Avg
+(
+	const AttributeSummary *s,  // summary
+	SIValue *res                // [output] average
+);
+
+// minimum value, numeric and string attributes only
+// string results are allocated and owned by the caller
+bool AttributeSummary_Min
+(
+	const AttributeSummary *s,  // summary
+	SIValue *res                // [output] minimum
+);
+
+// maximum value, numeric and string attributes only
+// string results are allocated and owned by the caller
+bool AttributeSummary_Max
+(
+	const AttributeSummary *s,  // summary
+	SIValue *res                // [output] maximum
+);
+
+// increase summary reference count
+AttributeSummary *AttributeSummary_Share
+(
+	AttributeSummary *s  // summary
+);
+
+// decrease summary reference count
+// frees summary once reference count reaches 0
+void AttributeSummary_Free
+(
+	AttributeSummary *s  // summary
+);
@@ -40,6 +40,61 @@ static bool _AllPathsCtx_LevelNotEmpty(const AllPathsCtx *ctx, uint level) {
 	return (level < array_len(ctx->levels) && array_len(ctx->levels[level]) > 0);
 }
 
+// collect the CSR snapshots traversed when expanding in direction 'dir'
+// 'csrs' must have room for 2 * relationCount snapshots
+// snapshots are owned by the context
+static uint _AllPathsCtx_GetCSRs
+(
+	AllPathsCtx *ctx,
+	GRAPH_EDGE_DIR dir,
+	CSR **csrs
+) {
+	if(dir == GRAPH_EDGE_DIR_BOTH) {
+		uint n = _AllPathsCtx_GetCSRs(ctx, GRAPH_EDGE_DIR_INCOMING, csrs);
+		return n + _AllPathsCtx_GetCSRs(ctx, GRAPH_EDGE_DIR_OUTGOING, csrs + n);
+	}
+
+	uint n = 0;
+	CSR **cache = (dir == GRAPH_EDGE_DIR_OUTGOING) ? ctx->outgoing : ctx->incoming;
+
+	for(int i = 0; i < ctx->relationCount; i++) {
+		RelationID r = ctx->relationIDs[i];
+		if(r == GRAPH_UNKNOWN_RELATION) continue;
+
+		if(cache[i] == NULL) cache[i] = Graph_GetCSR(ctx->g, r, dir);
+		csrs[n++] = cache[i];
+	}
+
+	return n;
+}
+
+// collect the edges of 'node' in direction 'dir' into ctx->neighbors
+// edges are read from the relations' CSR snapshots
+// while the write lock is held snapshots aren't cached
+// edges are read from the relation matrices instead
+static void _AllPathsCtx_CollectEdges
+(
+	AllPathsCtx *ctx,
+	const Node *node,
+	GRAPH_EDGE_DIR dir
+) {
+	if(Graph_WriteLocked(ctx->g)) {
+		for(int i = 0; i < ctx->relationCount; i++) {
+			Graph_GetNodeEdges(ctx->g, node, dir, ctx->relationIDs[i],
+					&ctx->neighbors);
+		}
+		return;
+	}
+
+	CSR *csrs[MAX(ctx->relationCount, 1)];
+	uint n = _AllPathsCtx_GetCSRs(ctx, dir, csrs);
+	NodeID id = ENTITY_GET_ID(node);
+
+	for(uint i = 0; i < n; i++) {
+		CSR_GetNodeEdges(csrs[i], ctx->g, id, &ctx->neighbors);
+	}
+}
+
 void addOutgoingNeighbors
 (
 	AllPathsCtx *ctx,
@@ -50,9 +105,7 @@ void addOutgoingNeighbors
 	if(depth > 1) frontierId = ENTITY_GET_ID(&frontier->edge);
 
 	// Get frontier neighbors.
-	for(int i = 0; i < ctx->relationCount; i++) {
-		Graph_GetNodeEdges(ctx->g, &frontier->node, GRAPH_EDGE_DIR_OUTGOING, ctx->relationIDs[i], &ctx->neighbors);
-	}
+	_AllPathsCtx_CollectEdges(ctx, &frontier->node, GRAPH_EDGE_DIR_OUTGOING);
 
 	// Add unvisited neighbors to next level.
 	uint32_t neighborsCount = array_len(ctx->neighbors);
@@ -99,9 +152,7 @@ void addIncomingNeighbors
 	if(depth > 1) frontierId = ENTITY_GET_ID(&frontier->edge);
 
 	// Get frontier neighbors.
-	for(int i = 0; i < ctx->relationCount; i++) {
-		Graph_GetNodeEdges(ctx->g, &frontier->node, GRAPH_EDGE_DIR_INCOMING, ctx->relationIDs[i], &ctx->neighbors);
-	}
+	_AllPathsCtx_CollectEdges(ctx, &frontier->node, GRAPH_EDGE_DIR_INCOMING);
 
 	// Add unvisited neighbors to next level.
 	uint32_t neighborsCount = array_len(ctx->neighbors);
@@ -195,6 +246,8 @@ AllPathsCtx *AllPathsCtx_New
 	ctx->maxLen         =  maxLen + 1;
 	ctx->relationIDs    =  relationIDs;
 	ctx->relationCount  =  relationCount;
+	ctx->outgoing       =  rm_calloc(MAX(relationCount, 1), sizeof(CSR *));
+	ctx->incoming       =  rm_calloc(MAX(relationCount, 1), sizeof(CSR *));
 	ctx->levels         =  array_new(LevelConnection *, 1);
 	ctx->path           =  Path_New(1);
 	ctx->neighbors      =  array_new(Edge, 32);
@@ -304,6 +357,12 @@ void AllPathsCtx_Free(AllPathsCtx *ctx) {
 	array_free(ctx->levels);
 	Path_Free(ctx->path);
 	array_free(ctx->neighbors);
+	for(int i = 0; i < ctx->relationCount; i++) {
+		if(ctx->outgoing[i]) CSR_Free(ctx->outgoing[i]);
+		if(ctx->incoming[i]) CSR_Free(ctx->incoming[i]);
+	}
+	rm_free(ctx->outgoing);
+	rm_free(ctx->incoming);
 	if(ctx->visited) GrB_Vector_free(&ctx->visited);
 	rm_free(ctx);
 	ctx = NULL;
@@ -19,6 +19,7 @@
 
 #include "../datatypes/path/path.h"
 #include "../graph/graph.h"
+#include "../graph/csr/csr.h"
 #include "../graph/entities/node.h"
 #include "../filter_tree/filter_tree.h"
 
@@ -34,6 +35,8 @@ typedef struct {
 	Edge *neighbors;            // Reusable buffer of edges along the current path.
 	int *relationIDs;           // edge type(s) to traverse.
 	int relationCount;          // length of relationIDs.
+	CSR **outgoing;             // outgoing adjacency of each relation, built on first use.
+	CSR **incoming;             // incoming adjacency of each relation, built on first use.
 	GRAPH_EDGE_DIR dir;         // traverse direction.
 	uint minLen;                // Path minimum length.
 	uint maxLen;                // Path max length.
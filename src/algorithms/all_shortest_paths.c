@@ -6,13 +6,15 @@
 
 #include "RG.h"
 #include "all_shortest_paths.h"
+#include "bidirectional_bfs.h"
 #include "../util/arr.h"
 #include "../util/rmalloc.h"
 
 // run BFS from `src` until `dest` is reached
 // add all nodes visited during traversal except for nodes in
 // `dest` level, so it can be used later on in `AllShortestPaths_NextPath`
-int AllShortestPaths_FindMinimumLength
+// each visited node is mapped to its distance from `src`
+static int _FindMinimumLength_BFS
 (
 	AllPathsCtx *ctx,   // context of the all shortest path
 	Node *src,          // source node
@@ -30,10 +32,10 @@ int AllShortestPaths_FindMinimumLength
 	GrB_Vector newly_visited; // nodes visited in current level
 
 	// initialize both `visited` and `newly_visited` vectors
-	GrB_Vector_new(&visited, GrB_BOOL, Graph_UncompactedNodeCount(ctx->g));
+	GrB_Vector_new(&visited, GrB_UINT64, Graph_UncompactedNodeCount(ctx->g));
 	GxB_set(visited, GxB_SPARSITY_CONTROL, GxB_BITMAP);
 
-	GrB_Vector_new(&newly_visited, GrB_BOOL, Graph_UncompactedNodeCount(ctx->g));
+	GrB_Vector_new(&newly_visited, GrB_UINT64, Graph_UncompactedNodeCount(ctx->g));
 	GxB_set(newly_visited, GxB_SPARSITY_CONTROL, GxB_BITMAP);
 
 	while (true) {
@@ -81,7 +83,7 @@ int AllShortestPaths_FindMinimumLength
 		if(is_visited) continue;
 
 		// mark node in newly_visited vector
-		GrB_Vector_setElement_BOOL(newly_visited, true, frontierID);
+		GrB_Vector_setElement_UINT64(newly_visited, depth, frontierID);
 		// add all neighbors of the current node to the next level
 		addNeighbors(ctx, &frontierConnection, depth + 1, ctx->dir);
 	}
@@ -99,6 +101,71 @@ int AllShortestPaths_FindMinimumLength
 	return depth;
 }
 
+// run a bidirectional BFS between `src` and `dest`
+// add all nodes lying on a shortest path except for `dest`
+// so it can be used later on in `AllShortestPaths_NextPath`
+// each such node is mapped to its distance from `src`
+static int _FindMinimumLength_Bidirectional
+(
+	AllPathsCtx *ctx,   // context of the all shortest path
+	Node *src,          // source node
+	Node *dest          // destination node
+) {
+	// the destination side expands over the reversed edges
+	BidirectionalBFS *bfs = BidirectionalBFS_New(ctx->g, ctx->relationIDs,
+			ctx->relationCount, ctx->dir);
+
+	int64_t len = BidirectionalBFS_Run(bfs, ENTITY_GET_ID(src),
+			ENTITY_GET_ID(dest), ctx->maxLen - 1);
+
+	// `src` is consumed, `AllShortestPaths_NextPath` starts from `dest`
+	array_clear(ctx->levels[0]);
+
+	int depth = 0;  // indicate `dest` wasn't reached
+	if(len > 0) {
+		GrB_Vector visited;
+		GrB_Vector_new(&visited, GrB_UINT64, bfs->n);
+		GxB_set(visited, GxB_SPARSITY_CONTROL, GxB_BITMAP);
+
+		NodeID *nodes = BidirectionalBFS_PathNodes(bfs);
+		uint count = array_len(nodes);
+		for(uint i = 0; i < count; i++) {
+			NodeID id = nodes[i];
+			if(id == ENTITY_GET_ID(dest)) continue;
+			GrB_Vector_setElement_UINT64(visited, bfs->src_dist[id] - 1, id);
+		}
+		array_free(nodes);
+
+		ctx->visited = visited;
+		depth = len + 1;  // switch from edge count to node count
+	}
+
+	BidirectionalBFS_Free(bfs);
+
+	return depth;
+}
+
+// find the length of the shortest paths from `src` to `dest`
+int AllShortestPaths_FindMinimumLength
+(
+	AllPathsCtx *ctx,   // context of the all shortest path
+	Node *src,          // source node
+	Node *dest          // destination node
+) {
+	ASSERT(ctx  != NULL);
+	ASSERT(src  != NULL);
+	ASSERT(dest != NULL);
+
+	// edge filters are evaluated as nodes are expanded one at a time
+	// and a path from a node to itself is a cycle which the bidirectional
+	// search doesn't look for, fallback to a single sided BFS
+	if(ctx->ft != NULL || ENTITY_GET_ID(src) == ENTITY_GET_ID(dest)) {
+		return _FindMinimumLength_BFS(ctx, src, dest);
+	}
+
+	return _FindMinimumLength_Bidirectional(ctx, src, dest);
+}
+
 // find paths from src to dest by traversing from dest to src using DFS
 // inspecting nodes which where discovered by
 // the previous call to `AllShortestPaths_FindMinimumLength`
@@ -128,16 +195,20 @@ Path *AllShortestPaths_NextPath
 	while (depth < ctx->maxLen) {
 		if (array_len(ctx->levels[depth]) > 0) {
 			// get a new node from the frontier
-			bool is_visited;
+			uint64_t level;
 			LevelConnection frontierConnection = array_pop(ctx->levels[depth]);
 			Node frontierNode = frontierConnection.node;
 			NodeID frontierID = ENTITY_GET_ID(&frontierNode);
-			GrB_Info info = GrB_Vector_extractElement_BOOL(&is_visited,
+			GrB_Info info = GrB_Vector_extractElement_UINT64(&level,
 					ctx->visited, frontierID);
 
 			// consider only previously discovered nodes
 			if(info == GrB_NO_VALUE) continue;
 
+			// a node `depth` steps away from `dest` on a shortest path
+			// is `minLen - 1 - depth` steps away from `src`
+			if(level != ctx->minLen - 1 - depth) continue;
+
 			// if we reached to the end of the path and this node is not the
 			// dst node continue
 			if(depth == ctx->maxLen - 1 &&
@@ -8,6 +8,9 @@
 
 #include "all_paths.h"
 
+// find the length of the shortest paths from `src` to `dest`
+// returns the number of nodes along a shortest path, 0 if `dest` is unreachable
+// nodes which may lie on a shortest path are recorded in ctx->visited
 int AllShortestPaths_FindMinimumLength(
 	AllPathsCtx *ctx,  // shortest path context
 	Node *src,         // start traversing from `src`
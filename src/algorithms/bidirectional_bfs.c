@@ -0,0 +1,444 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "bidirectional_bfs.h"
+#include "../util/arr.h"
+#include "../util/rmalloc.h"
+
+#include <string.h>
+
+// direction the backward adjacency is read in
+static GRAPH_EDGE_DIR _Reverse
+(
+	GRAPH_EDGE_DIR dir  // search direction
+) {
+	if(dir == GRAPH_EDGE_DIR_OUTGOING) return GRAPH_EDGE_DIR_INCOMING;
+	if(dir == GRAPH_EDGE_DIR_INCOMING) return GRAPH_EDGE_DIR_OUTGOING;
+	return dir;
+}
+
+// create a new bidirectional BFS over relation types 'rels'
+BidirectionalBFS *BidirectionalBFS_New
+(
+	const Graph *g,          // graph
+	const RelationID *rels,  // traversed relation types
+	uint nrels,              // number of relation types
+	GRAPH_EDGE_DIR dir       // search direction
+) {
+	ASSERT(g    != NULL);
+	ASSERT(rels != NULL || nrels == 0);
+
+	BidirectionalBFS *bfs = rm_malloc(sizeof(BidirectionalBFS));
+
+	// unknown relation types have no edges
+	bfs->rels  = rm_malloc(sizeof(RelationID) * MAX(nrels, 1));
+	bfs->nrels = 0;
+	for(uint i = 0; i < nrels; i++) {
+		if(rels[i] == GRAPH_UNKNOWN_RELATION) continue;
+		bfs->rels[bfs->nrels++] = rels[i];
+	}
+
+	// a search in both directions reads incoming and outgoing snapshots
+	uint cap = 2 * MAX(bfs->nrels, 1);
+
+	bfs->g         = g;
+	bfs->n         = Graph_UncompactedNodeCount(g);
+	bfs->dir       = dir;
+	bfs->fwd       = rm_malloc(sizeof(CSR *) * cap);
+	bfs->bwd       = rm_malloc(sizeof(CSR *) * cap);
+	bfs->len       = -1;
+	bfs->src       = INVALID_ENTITY_ID;
+	bfs->dest      = INVALID_ENTITY_ID;
+	bfs->nbrs      = array_new(NodeID, 0);
+	bfs->meet      = array_new(NodeID, 0);
+	bfs->edges     = array_new(Edge, 0);
+	bfs->ncsrs     = 0;
+	bfs->epoch     = 0;
+	bfs->touched   = array_new(NodeID, 0);
+	bfs->src_dist  = rm_calloc(MAX(bfs->n, 1), sizeof(uint32_t));
+	bfs->dest_dist = rm_calloc(MAX(bfs->n, 1), sizeof(uint32_t));
+
+	return bfs;
+}
+
+// release held snapshots
+static void _ReleaseSnapshots
+(
+	BidirectionalBFS *bfs  // bidirectional BFS
+) {
+	for(uint i = 0; i < bfs->ncsrs; i++) {
+		CSR_Free(bfs->fwd[i]);
+		CSR_Free(bfs->bwd[i]);
+	}
+	bfs->ncsrs = 0;
+}
+
+// acquire the snapshots of the traversed relation types
+// snapshots are kept for as long as the graph isn't modified
+// while the write lock is held no snapshots are acquired
+static void _AcquireSnapshots
+(
+	BidirectionalBFS *bfs  // bidirectional BFS
+) {
+	if(Graph_WriteLocked(bfs->g)) {
+		_ReleaseSnapshots(bfs);
+		return;
+	}
+
+	uint64_t epoch = Graph_WriteEpoch(bfs->g);
+	if(bfs->ncsrs > 0 && bfs->epoch == epoch) return;
+
+	_ReleaseSnapshots(bfs);
+
+	uint n = 0;
+	GRAPH_EDGE_DIR reverse = _Reverse(bfs->dir);
+	for(uint i = 0; i < bfs->nrels; i++) {
+		RelationID r = bfs->rels[i];
+		if(bfs->dir == GRAPH_EDGE_DIR_BOTH) {
+			bfs->fwd[n]   = Graph_GetCSR(bfs->g, r, GRAPH_EDGE_DIR_INCOMING);
+			bfs->bwd[n++] = Graph_GetCSR(bfs->g, r, GRAPH_EDGE_DIR_INCOMING);
+			bfs->fwd[n]   = Graph_GetCSR(bfs->g, r, GRAPH_EDGE_DIR_OUTGOING);
+			bfs->bwd[n++] = Graph_GetCSR(bfs->g, r, GRAPH_EDGE_DIR_OUTGOING);
+		} else {
+			bfs->fwd[n]   = Graph_GetCSR(bfs->g, r, bfs->dir);
+			bfs->bwd[n++] = Graph_GetCSR(bfs->g, r, reverse);
+		}
+	}
+
+	bfs->ncsrs = n;
+	bfs->epoch = epoch;
+}
+
+// collect the neighbors of 'v' into bfs->nbrs
+// if 'with_edges' is set, bfs->edges[i] is the edge leading to bfs->nbrs[i]
+static void _Neighbors
+(
+	BidirectionalBFS *bfs,  // bidirectional BFS
+	bool forward,           // read the forward adjacency
+	NodeID v,               // node
+	bool with_edges         // collect edges
+) {
+	array_clear(bfs->nbrs);
+	array_clear(bfs->edges);
+
+	CSR **csrs = forward ? bfs->fwd : bfs->bwd;
+
+	if(bfs->ncsrs == 0) {
+		// no snapshots, read edges from the relation matrices
+		Node node = GE_NEW_NODE();
+		node.id = v;
+		GRAPH_EDGE_DIR dir = forward ? bfs->dir : _Reverse(bfs->dir);
+		for(uint i = 0; i < bfs->nrels; i++) {
+			Graph_GetNodeEdges(bfs->g, &node, dir, bfs->rels[i], &bfs->edges);
+		}
+	} else if(with_edges) {
+		for(uint c = 0; c < bfs->ncsrs; c++) {
+			CSR_GetNodeEdges(csrs[c], bfs->g, v, &bfs->edges);
+		}
+	} else {
+		for(uint c = 0; c < bfs->ncsrs; c++) {
+			uint64_t begin;
+			uint64_t end;
+			CSR_Row(csrs[c], v, &begin, &end);
+			array_ensure_append(bfs->nbrs, csrs[c]->Aj + begin, end - begin,
+					NodeID);
+		}
+		return;
+	}
+
+	uint n = array_len(bfs->edges);
+	for(uint i = 0; i < n; i++) {
+		const Edge *e = bfs->edges + i;
+		NodeID src = Edge_GetSrcNodeID(e);
+		array_append(bfs->nbrs, (src == v) ? Edge_GetDestNodeID(e) : src);
+	}
+}
+
+// expand 'frontier' by a single level into 'next'
+// newly reached nodes already reached by the other side join the meeting layer
+static void _Expand
+(
+	BidirectionalBFS *bfs,  // bidirectional BFS
+	bool forward,           // expand over the forward adjacency
+	NodeID *frontier,       // nodes to expand
+	NodeID **next,          // [output] newly reached nodes
+	uint32_t *dist,         // this side's distances
+	const uint32_t *other,  // other side's distances
+	uint32_t level          // distance + 1 of newly reached nodes
+) {
+	uint n = array_len(frontier);
+	for(uint i = 0; i < n; i++) {
+		_Neighbors(bfs, forward, frontier[i], false);
+
+		uint m = array_len(bfs->nbrs);
+		for(uint j = 0; j < m; j++) {
+			NodeID v = bfs->nbrs[j];
+			ASSERT(v < bfs->n);
+
+			if(dist[v] != 0) continue;
+
+			dist[v] = level;
+			array_append(*next, v);
+			array_append(bfs->touched, v);
+			if(other[v] != 0) array_append(bfs->meet, v);
+		}
+	}
+}
+
+// discard the previous search and make room for 'n' node slots
+static void _Reset
+(
+	BidirectionalBFS *bfs,  // bidirectional BFS
+	uint64_t n              // number of node slots
+) {
+	uint count = array_len(bfs->touched);
+	for(uint i = 0; i < count; i++) {
+		NodeID v = bfs->touched[i];
+		bfs->src_dist[v]  = 0;
+		bfs->dest_dist[v] = 0;
+	}
+
+	array_clear(bfs->meet);
+	array_clear(bfs->touched);
+	bfs->len = -1;
+
+	if(n <= bfs->n) return;
+
+	bfs->src_dist  = rm_realloc(bfs->src_dist,  n * sizeof(uint32_t));
+	bfs->dest_dist = rm_realloc(bfs->dest_dist, n * sizeof(uint32_t));
+	memset(bfs->src_dist  + bfs->n, 0, (n - bfs->n) * sizeof(uint32_t));
+	memset(bfs->dest_dist + bfs->n, 0, (n - bfs->n) * sizeof(uint32_t));
+	bfs->n = n;
+}
+
+// search for the shortest paths from 'src' to 'dest'
+int64_t BidirectionalBFS_Run
+(
+	BidirectionalBFS *bfs,  // bidirectional BFS
+	NodeID src,             // source node
+	NodeID dest,            // destination node
+	uint64_t max_len        // maximum path length
+) {
+	ASSERT(bfs != NULL);
+
+	_Reset(bfs, Graph_UncompactedNodeCount(bfs->g));
+	_AcquireSnapshots(bfs);
+
+	ASSERT(src  < bfs->n);
+	ASSERT(dest < bfs->n);
+
+	bfs->src  = src;
+	bfs->dest = dest;
+
+	bfs->src_dist[src]   = 1;
+	bfs->dest_dist[dest] = 1;
+	array_append(bfs->touched, src);
+	array_append(bfs->touched, dest);
+
+	if(src == dest) {
+		array_append(bfs->meet, src);
+		bfs->len = 0;
+		return bfs->len;
+	}
+
+	uint32_t src_depth  = 0;
+	uint32_t dest_depth = 0;
+
+	NodeID *next          = array_new(NodeID, 0);
+	NodeID *src_frontier  = array_new(NodeID, 1);
+	NodeID *dest_frontier = array_new(NodeID, 1);
+
+	array_append(src_frontier, src);
+	array_append(dest_frontier, dest);
+
+	while(array_len(src_frontier)  > 0 &&
+		  array_len(dest_frontier) > 0 &&
+		  src_depth + dest_depth < max_len) {
+
+		array_clear(next);
+
+		// expand the smaller frontier
+		if(array_len(src_frontier) <= array_len(dest_frontier)) {
+			src_depth++;
+			_Expand(bfs, true, src_frontier, &next, bfs->src_dist,
+					bfs->dest_dist, src_depth + 1);
+
+			NodeID *t = src_frontier; src_frontier = next; next = t;
+		} else {
+			dest_depth++;
+			_Expand(bfs, false, dest_frontier, &next, bfs->dest_dist,
+					bfs->src_dist, dest_depth + 1);
+
+			NodeID *t = dest_frontier; dest_frontier = next; next = t;
+		}
+
+		// the two sides met, all meeting nodes are reached in the same level
+		if(array_len(bfs->meet) > 0) {
+			bfs->len = src_depth + dest_depth;
+			break;
+		}
+	}
+
+	array_free(next);
+	array_free(src_frontier);
+	array_free(dest_frontier);
+
+	return bfs->len;
+}
+
+// walk from the meeting layer towards the end 'dist' is measured from
+// collecting every node which is one step closer to that end
+static void _Walk
+(
+	BidirectionalBFS *bfs,  // bidirectional BFS
+	bool forward,           // walk over the forward adjacency
+	const uint32_t *dist,   // distances from the end
+	uint64_t *marked,       // collected nodes bitmap
+	NodeID **nodes          // [output] collected nodes
+) {
+	NodeID *queue = array_new(NodeID, array_len(bfs->meet));
+	array_ensure_append(queue, bfs->meet, array_len(bfs->meet), NodeID);
+
+	for(uint i = 0; i < array_len(queue); i++) {
+		NodeID v = queue[i];
+		_Neighbors(bfs, forward, v, false);
+
+		uint m = array_len(bfs->nbrs);
+		for(uint j = 0; j < m; j++) {
+			NodeID u = bfs->nbrs[j];
+			if(dist[u] == 0 || dist[u] + 1 != dist[v]) continue;
+			if(marked[u >> 6] & (1ULL << (u & 63))) continue;
+
+			marked[u >> 6] |= (1ULL << (u & 63));
+			array_append(queue, u);
+			array_append(*nodes, u);
+		}
+	}
+
+	array_free(queue);
+}
+
+// collect all nodes lying on a shortest path from 'src' to 'dest'
+NodeID *BidirectionalBFS_PathNodes
+(
+	BidirectionalBFS *bfs  // bidirectional BFS
+) {
+	ASSERT(bfs != NULL);
+
+	uint n_meet = array_len(bfs->meet);
+	NodeID *nodes = array_new(NodeID, n_meet);
+	if(bfs->len < 0) return nodes;
+
+	uint64_t *marked = rm_calloc((bfs->n + 63) / 64, sizeof(uint64_t));
+	for(uint i = 0; i < n_meet; i++) {
+		NodeID m = bfs->meet[i];
+		marked[m >> 6] |= (1ULL << (m & 63));
+		array_append(nodes, m);
+	}
+
+	// predecessors are reached over the backward adjacency
+	_Walk(bfs, false, bfs->src_dist, marked, &nodes);
+	// successors are reached over the forward adjacency
+	_Walk(bfs, true, bfs->dest_dist, marked, &nodes);
+
+	// nodes between the meeting layer and the destination
+	// weren't reached from the source, derive their distance
+	uint n = array_len(nodes);
+	for(uint i = 0; i < n; i++) {
+		NodeID v = nodes[i];
+		if(bfs->src_dist[v] == 0) {
+			bfs->src_dist[v] = bfs->len - (bfs->dest_dist[v] - 1) + 1;
+		}
+	}
+
+	rm_free(marked);
+	return nodes;
+}
+
+// step from 'v' to a neighbor one step closer to the end 'dist' is measured from
+// returns the neighbor and sets 'e' to the edge leading to it
+static NodeID _Step
+(
+	BidirectionalBFS *bfs,  // bidirectional BFS
+	bool forward,           // step over the forward adjacency
+	const uint32_t *dist,   // distances from the end
+	NodeID v,               // current node
+	Edge *e                 // [output] traversed edge
+) {
+	_Neighbors(bfs, forward, v, true);
+
+	uint n = array_len(bfs->nbrs);
+	for(uint i = 0; i < n; i++) {
+		NodeID u = bfs->nbrs[i];
+		if(dist[u] == 0 || dist[u] + 1 != dist[v]) continue;
+
+		*e = bfs->edges[i];
+		return u;
+	}
+
+	ASSERT(false && "shortest path is broken");
+	return INVALID_ENTITY_ID;
+}
+
+// collect the edges of a single shortest path from 'src' to 'dest'
+void BidirectionalBFS_Path
+(
+	BidirectionalBFS *bfs,  // bidirectional BFS
+	Edge **edges            // [output] path edges
+) {
+	ASSERT(bfs   != NULL);
+	ASSERT(edges != NULL);
+
+	if(bfs->len <= 0) return;
+
+	Edge   e;
+	NodeID m = bfs->meet[0];
+	NodeID v = m;
+
+	// walk back from the meeting node to the source
+	uint start = array_len(*edges);
+	while(bfs->src_dist[v] > 1) {
+		v = _Step(bfs, false, bfs->src_dist, v, &e);
+		array_append(*edges, e);
+	}
+
+	// edges were collected in reverse
+	uint end = array_len(*edges);
+	for(uint i = start, j = end; i + 1 < j; i++, j--) {
+		Edge t          = (*edges)[i];
+		(*edges)[i]     = (*edges)[j - 1];
+		(*edges)[j - 1] = t;
+	}
+
+	// walk forward from the meeting node to the destination
+	v = m;
+	while(bfs->dest_dist[v] > 1) {
+		v = _Step(bfs, true, bfs->dest_dist, v, &e);
+		array_append(*edges, e);
+	}
+}
+
+// free bidirectional BFS
+void BidirectionalBFS_Free
+(
+	BidirectionalBFS *bfs  // bidirectional BFS
+) {
+	ASSERT(bfs != NULL);
+
+	_ReleaseSnapshots(bfs);
+
+	array_free(bfs->nbrs);
+	array_free(bfs->meet);
+	array_free(bfs->edges);
+	array_free(bfs->touched);
+	rm_free(bfs->fwd);
+	rm_free(bfs->bwd);
+	rm_free(bfs->rels);
+	rm_free(bfs->src_dist);
+	rm_free(bfs->dest_dist);
+	rm_free(bfs);
+}
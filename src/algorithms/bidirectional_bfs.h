@@ -0,0 +1,95 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "../graph/graph.h"
+#include "../graph/csr/csr.h"
+
+// bidirectional breadth first search between a source and a destination node
+//
+// the search alternates between expanding the source side frontier
+// over the forward adjacency and the destination side frontier
+// over the backward adjacency, always expanding the smaller frontier
+// the search stops once the two sides meet, all nodes in which they meet
+// form the meeting layer, every shortest path crosses it
+//
+// the forward adjacency holds the edges of the traversed relation types
+// in the search direction, the backward adjacency holds their reverse
+// adjacency is read from the relations' CSR snapshots, which are kept
+// until the graph is modified, while the write lock is held
+// snapshots aren't cached and edges are read from the relation matrices
+//
+// a single BFS can run any number of searches, distance buffers
+// are reset between searches rather than reallocated
+
+typedef struct {
+	const Graph *g;       // graph
+	RelationID *rels;     // traversed relation types
+	uint nrels;           // number of traversed relation types
+	GRAPH_EDGE_DIR dir;   // search direction
+	CSR **fwd;            // forward adjacency
+	CSR **bwd;            // backward adjacency
+	uint ncsrs;           // number of snapshots per side, 0 if not acquired
+	uint64_t epoch;       // graph write epoch the snapshots were acquired at
+	Edge *edges;          // reusable buffer of node edges
+	NodeID *nbrs;         // reusable buffer of node neighbors
+	uint64_t n;           // number of node slots
+	uint32_t *src_dist;   // distance + 1 of each node from source, 0 if unreached
+	uint32_t *dest_dist;  // distance + 1 of each node from destination, 0 if unreached
+	NodeID *touched;      // nodes reached by the last search
+	NodeID *meet;         // meeting layer
+	NodeID src;           // source node
+	NodeID dest;          // destination node
+	int64_t len;          // shortest path length in edges, -1 if there's no path
+} BidirectionalBFS;
+
+// create a new bidirectional BFS over relation types 'rels'
+// pass GRAPH_NO_RELATION to traverse all relation types
+// unknown relation types are ignored
+BidirectionalBFS *BidirectionalBFS_New
+(
+	const Graph *g,          // graph
+	const RelationID *rels,  // traversed relation types
+	uint nrels,              // number of relation types
+	GRAPH_EDGE_DIR dir       // search direction
+);
+
+// search for the shortest paths from 'src' to 'dest'
+// discards the results of the previous search
+// paths longer than 'max_len' edges are not considered
+// returns the shortest path length in edges, -1 if there's no path
+int64_t BidirectionalBFS_Run
+(
+	BidirectionalBFS *bfs,  // bidirectional BFS
+	NodeID src,             // source node
+	NodeID dest,            // destination node
+	uint64_t max_len        // maximum path length
+);
+
+// collect all nodes lying on a shortest path from 'src' to 'dest'
+// once returned, bfs->src_dist holds the distance + 1 from source
+// of each collected node
+// caller owns the returned array
+NodeID *BidirectionalBFS_PathNodes
+(
+	BidirectionalBFS *bfs  // bidirectional BFS
+);
+
+// collect the edges of a single shortest path from 'src' to 'dest'
+// edges are appended in path order
+void BidirectionalBFS_Path
+(
+	BidirectionalBFS *bfs,  // bidirectional BFS
+	Edge **edges            // [output] path edges
+);
+
+// free bidirectional BFS
+void BidirectionalBFS_Free
+(
+	BidirectionalBFS *bfs  // bidirectional BFS
+);
+
@@ -6,6 +6,7 @@
 
 #include "utils.h"
 #include "../../query_ctx.h"
+#include "../../util/thread_profile.h"
 #include "../algebraic_expression.h"
 
 // forward declarations
@@ -70,6 +71,11 @@ RG_Matrix AlgebraicExpression_Eval
 	RG_Matrix res
 ) {
 	ASSERT(exp != NULL);
-	return _AlgebraicExpression_Eval(exp, res);
+
+	uint64_t start = ThreadProfile_GrBBegin();
+	res = _AlgebraicExpression_Eval(exp, res);
+	ThreadProfile_GrBEnd(start);
+
+	return res;
 }
 
@@ -6,6 +6,7 @@
 
 #include "utils.h"
 #include "../../query_ctx.h"
+#include "../../util/thread_profile.h"
 #include "../algebraic_expression.h"
 
 RG_Matrix _Eval_Mul
@@ -47,6 +48,7 @@ RG_Matrix _Eval_Mul
 
 		// both A and M are valid matrices, perform multiplication
 		info = RG_mxm(res, semiring, A, M) ;
+		ThreadProfile_CountMxM() ;
 		res_modified = true ;
 		// setup for next iteration
 		A = res ;
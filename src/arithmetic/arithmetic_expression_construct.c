@@ -44,12 +44,12 @@ static bool _AR_EXP_ContainsNestedAgg(const AR_ExpNode *exp) {
 	return __AR_EXP_ContainsNestedAgg(exp, in_agg);
 }
 
-#define OP_COUNT 25
+#define OP_COUNT 26
 // The OpName array is strictly parallel with the AST_Operator enum.
 static const char *OpName[OP_COUNT] = {
 	"UNKNOWN", "NULL", "OR", "XOR", "AND", "NOT", "EQ", "NEQ", "LT", "GT", "LE",  "GE",
 	"ADD", "SUB", "MUL", "DIV", "MOD", "POW", "CONTAINS", "STARTS WITH",
-	"ENDS WITH", "IN", "IS NULL", "IS NOT NULL", "XNOR"
+	"ENDS WITH", "IN", "IS NULL", "IS NOT NULL", "XNOR", "=~"
 };
 
 static inline const char *_ASTOpToString(AST_Operator op) {
@@ -587,13 +587,13 @@ static AR_ExpNode *_AR_ExpFromShortestPath
 
 	// Instantiate a context struct with traversal details.
 	ShortestPathCtx *ctx = rm_malloc(sizeof(ShortestPathCtx));
-	ctx->R              =  GrB_NULL;
 	ctx->minHops        =  start;
 	ctx->maxHops        =  end;
 	ctx->reltypes       =  NULL;
 	ctx->reltype_names  =  reltype_names;
 	ctx->reltype_count  =  array_len(reltype_names);
-	ctx->free_matrices  =  false;
+	ctx->resolved       =  false;
+	ctx->bfs            =  NULL;
 
 	AR_SetPrivateData(op, ctx);
 	AR_ExpNode *src;
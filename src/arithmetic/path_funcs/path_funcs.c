@@ -12,7 +12,7 @@
 #include "../../util/rmalloc.h"
 #include "../../configuration/config.h"
 #include "../../datatypes/path/sipath_builder.h"
-#include "../../algorithms/LAGraph/LAGraph_bfs.h"
+#include "../../algorithms/bidirectional_bfs.h"
 
 /* Creates a path from a given sequence of graph entities.
  * The first argument is the ast node represents the path.
@@ -97,9 +97,7 @@ void ShortestPath_Free(void *ctx_ptr) {
 	ShortestPathCtx *ctx = ctx_ptr;
 	if(ctx->reltypes) array_free(ctx->reltypes);
 	if(ctx->reltype_names) array_free(ctx->reltype_names);
-	if(ctx->free_matrices) {
-		GrB_free(&ctx->R);
-	}
+	if(ctx->bfs) BidirectionalBFS_Free(ctx->bfs);
 	rm_free(ctx);
 }
 
@@ -117,9 +115,8 @@ void *ShortestPath_Clone(void *orig) {
 	ctx_clone->reltypes = NULL;
 	if(ctx->reltype_names) array_clone(ctx_clone->reltype_names, ctx->reltype_names);
 	else ctx_clone->reltype_names = NULL;
-	// Do not clone matrix data
-	ctx_clone->R = GrB_NULL;
-	ctx_clone->free_matrices = false;
+	ctx_clone->resolved = false;
+	ctx_clone->bfs = NULL;
 
 	return ctx_clone;
 }
@@ -134,16 +131,11 @@ SIValue AR_SHORTEST_PATH(SIValue *argv, int argc, void *private_data) {
 	GrB_Index src_id            =  ENTITY_GET_ID(srcNode);
 	GrB_Index dest_id           =  ENTITY_GET_ID(destNode);
 
-	GrB_Info res;
-	UNUSED(res);
 	Edge *edges = NULL;
-	GrB_Vector V = GrB_NULL;  // vector of results
-	GrB_Vector PI = GrB_NULL; // vector backtracking results to their parents
 	GraphContext *gc = QueryCtx_GetGraphCtx();
+	Graph *g = gc->g;
 
-	GrB_Index max_level = (ctx->maxHops == EDGE_LENGTH_INF) ? 0 : ctx->maxHops;
-
-	if(ctx->R == GrB_NULL) {
+	if(!ctx->resolved) {
 		// First invocation, initialize unset context members.
 		if(ctx->reltype_count > 0) {
 			// Retrieve IDs of traversed relationship types.
@@ -157,109 +149,55 @@ SIValue AR_SHORTEST_PATH(SIValue *argv, int argc, void *private_data) {
 			// Update the reltype count, as it may have changed due to missing schemas
 			ctx->reltype_count = array_len(ctx->reltypes);
 		}
+		ctx->resolved = true;
+	}
 
-		// Get edge matrix and transpose matrix, if available.
-		if(ctx->reltypes == NULL) {
-			// No edge types were specified, use the overall adjacency matrix.
-			ctx->free_matrices = true;
-			res = RG_Matrix_export(&ctx->R, Graph_GetAdjacencyMatrix(gc->g,
-						false));
-			ASSERT(res == GrB_SUCCESS);
-		} else if(ctx->reltype_count == 0) {
-			// If edge types were specified but none were valid,
-			// use the zero matrix
-			ctx->free_matrices = true;
-			res = RG_Matrix_export(&ctx->R, Graph_GetZeroMatrix(gc->g));
-			ASSERT(res == GrB_SUCCESS);
-		} else if(ctx->reltype_count == 1) {
-			ctx->free_matrices = true;
-			res = RG_Matrix_export(&ctx->R, Graph_GetRelationMatrix(gc->g,
-						ctx->reltypes[0], false));
-			ASSERT(res == GrB_SUCCESS);
-		} else {
-			// we have multiple edge types, combine them into a boolean matrix
-			ctx->free_matrices = true;
-			GrB_Index dims = Graph_RequiredMatrixDim(gc->g);
-			res = GrB_Matrix_new(&ctx->R, GrB_BOOL, dims, dims);
-			ASSERT(res == GrB_SUCCESS);
-
-			for(uint i = 0; i < ctx->reltype_count; i ++) {
-				GrB_Matrix adj;
-				res = RG_Matrix_export(&adj, Graph_GetRelationMatrix(gc->g,
-							ctx->reltypes[i], false));
-				ASSERT(res == GrB_SUCCESS);
-				res = GrB_eWiseAdd(ctx->R, GrB_NULL, GrB_NULL,
-						GxB_ANY_PAIR_BOOL, ctx->R, adj, GrB_NULL);
-				ASSERT(res == GrB_SUCCESS);
-				res = GrB_Matrix_free(&adj);
-				ASSERT(res == GrB_SUCCESS);
-			}
+	// The search state is bound to the graph it was created for.
+	if(ctx->bfs != NULL && ctx->bfs->g != g) {
+		BidirectionalBFS_Free(ctx->bfs);
+		ctx->bfs = NULL;
+	}
 
-			GrB_Index nrows;
-			res = GrB_Matrix_nrows(&nrows, ctx->R);
-			ASSERT(res == GrB_SUCCESS);
-		}
+	if(ctx->bfs == NULL) {
+		// Traverse all relationship types if none were specified.
+		// If edge types were specified but none were valid, there are no edges.
+		RelationID all = GRAPH_NO_RELATION;
+		const RelationID *rels = (ctx->reltypes == NULL) ? &all : ctx->reltypes;
+		uint nrels = (ctx->reltypes == NULL) ? 1 : ctx->reltype_count;
+		// Search from both ends, the destination is expanded over incoming edges.
+		ctx->bfs = BidirectionalBFS_New(g, rels, nrels, GRAPH_EDGE_DIR_OUTGOING);
 	}
 
-	// Invoke the BFS algorithm
-	res = LG_BreadthFirstSearch_SSGrB(&V, &PI, ctx->R, src_id, &dest_id,
-		max_level);
-	ASSERT(res == GrB_SUCCESS);
-	ASSERT(V != GrB_NULL);
-	ASSERT(PI != GrB_NULL);
+	uint64_t max_len = (ctx->maxHops == EDGE_LENGTH_INF) ? UINT64_MAX : ctx->maxHops;
+	BidirectionalBFS *bfs = ctx->bfs;
 
 	SIValue p = SI_NullVal();
 
-	// The length of the path is equal to the level of the destination node
-	GrB_Index path_len;
-	res = GrB_Vector_extractElement(&path_len, V, dest_id);
-	if(res == GrB_NO_VALUE) goto cleanup; // no path found
+	// The length of the path is the number of edges separating src from dest
+	int64_t path_len = BidirectionalBFS_Run(bfs, src_id, dest_id, max_len);
+	if(path_len < 0) goto cleanup; // no path found
 
 	// Only emit a path with no edges if minHops is 0
 	if(path_len == 0 && ctx->minHops != 0) goto cleanup;
 
-	/* Build path in reverse, starting by appending the destination node.
-	 * The path is built in reverse because we have the destination's parent
-	 * in the PI array, and can use this to backtrack until we reach the source. */
-	p = SIPathBuilder_New(path_len);
-	SIPathBuilder_AppendNode(p, SI_Node(destNode));
+	edges = array_new(Edge, path_len);
+	BidirectionalBFS_Path(bfs, &edges);
+	ASSERT(array_len(edges) == path_len);
 
-	edges = array_new(Edge, 1);
+	p = SIPathBuilder_New(path_len);
+	SIPathBuilder_AppendNode(p, SI_Node(srcNode));
 
-	NodeID id = destNode->id;
 	for(uint i = 0; i < path_len; i ++) {
-		array_clear(edges);
-		GrB_Index parent_id;
-		// Find the parent of the reached node.
-		GrB_Info res = GrB_Vector_extractElement(&parent_id, PI, id);
-		ASSERT(res == GrB_SUCCESS);
-
-		// Retrieve edges connecting the parent node to the current node.
-		if(ctx->reltype_count == 0) {
-			Graph_GetEdgesConnectingNodes(gc->g, parent_id, id, GRAPH_NO_RELATION, &edges);
-		} else {
-			for(uint j = 0; j < ctx->reltype_count; j ++) {
-				Graph_GetEdgesConnectingNodes(gc->g, parent_id, id, ctx->reltypes[j], &edges);
-				if(array_len(edges) > 0) break;
-			}
-		}
-		ASSERT(array_len(edges) > 0);
 		// Append the edge to the path
-		SIPathBuilder_AppendEdge(p, SI_Edge(&edges[0]), false);
+		SIPathBuilder_AppendEdge(p, SI_Edge(&edges[i]), false);
 
 		// Append the reached node to the path.
-		id = Edge_GetSrcNodeID(&edges[0]);
 		Node n = GE_NEW_NODE();
-		Graph_GetNode(gc->g, id, &n);
+		Graph_GetNode(g, Edge_GetDestNodeID(&edges[i]), &n);
 		SIPathBuilder_AppendNode(p, SI_Node(&n));
 	}
 
-	// Reverse the path so it starts at the source
-	Path_Reverse(p.ptrval);
-
 cleanup:
-	if(V) GrB_free(&V);
-	if(PI) GrB_free(&PI);
 	if(edges) array_free(edges);
 
 	return p;
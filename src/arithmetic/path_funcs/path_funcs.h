@@ -7,6 +7,7 @@
 #pragma once
 #include "../../value.h"
 #include "../../deps/GraphBLAS/Include/GraphBLAS.h"
+#include "../../algorithms/bidirectional_bfs.h"
 
 // Context struct containing traversal data for shortestPath function calls
 typedef struct {
@@ -15,8 +16,8 @@ typedef struct {
 	const char **reltype_names;  /* Relationship type names */
 	int *reltypes;               /* Relationship type IDs */
 	uint reltype_count;          /* Number of traversed relationship types */
-	GrB_Matrix R;                /* Traversed relationship matrix */
-	bool free_matrices;          /* If true, R will ultimately be freed */
+	bool resolved;               /* Relationship type IDs were resolved */
+	BidirectionalBFS *bfs;       /* Search state, reused across invocations */
 } ShortestPathCtx;
 
 void Register_PathFuncs();
@@ -14,6 +14,7 @@
 #include "../../errors/errors.h"
 #include "../../util/math_util.h"
 #include "../../datatypes/array.h"
+#include "../../util/regex_cache.h"
 #include "../../util/json_encoder.h"
 #include "../deps/oniguruma/src/oniguruma.h"
 
@@ -322,44 +323,35 @@ SIValue AR_MATCHREGEX(SIValue *argv, int argc, void *private_data) {
 		return list;
 	}
 
-	regex_t *regex;
-	OnigErrorInfo einfo;
-	OnigRegion *region    = onig_region_new();
+	char s[ONIG_MAX_ERROR_MESSAGE_LEN];
 	const char *str       = argv[0].stringval;
 	const char *regex_str = argv[1].stringval;
 
-	int rv = onig_new(&regex, (const UChar *)regex_str, 
-		(const UChar *)(regex_str + strlen(regex_str)), ONIG_OPTION_DEFAULT,
-		ONIG_ENCODING_UTF8, ONIG_SYNTAX_JAVA, &einfo);
-	if(rv != ONIG_NORMAL) {
-		char s[ONIG_MAX_ERROR_MESSAGE_LEN];
-		onig_error_code_to_str((UChar* )s, rv, &einfo);
+	// compiled regex is owned by the cache
+	regex_t *regex = Regex_Compile(regex_str, false, s);
+	if(regex == NULL) {
 		ErrorCtx_SetError(EMSG_INVALID_REGEX, s);
-		onig_free(regex);
-		onig_region_free(region, 1);
 		SIValue_Free(list);
 		return SI_NullVal();
 	}
 
+	OnigRegion *region = onig_region_new();
 	match_regex_scan_cb_args args = {
 		.list = &list,
 		.str = str
 	};
 
-	rv = onig_scan(regex, (const UChar *)str,
+	int rv = onig_scan(regex, (const UChar *)str,
 		(const UChar *)(str + strlen(str)), region, ONIG_OPTION_DEFAULT,
 		match_regex_scan_cb, &args);
 	if(rv < 0) {
-		char s[ONIG_MAX_ERROR_MESSAGE_LEN];
 		onig_error_code_to_str((OnigUChar* )s, rv);
 		ErrorCtx_SetError(EMSG_INVALID_REGEX, s);
-		onig_free(regex);
 		onig_region_free(region, 1);
 		SIValue_Free(list);
 		return SI_NullVal();
 	}
 
-	onig_free(regex);
 	onig_region_free(region, 1);
 
 	return list;
@@ -418,22 +410,15 @@ SIValue AR_REPLACEREGEX(SIValue *argv, int argc, void *private_data) {
 		replacement = argv[2].stringval;
 	}
 
-	regex_t *regex;
-	OnigErrorInfo einfo;
-	OnigRegion *region = onig_region_new();
-
-	int rv = onig_new(&regex, (const UChar *)regex_str, 
-		(const UChar *)(regex_str + strlen(regex_str)), ONIG_OPTION_DEFAULT,
-		ONIG_ENCODING_UTF8, ONIG_SYNTAX_JAVA, &einfo);
-	if(rv != ONIG_NORMAL) {
-		char s[ONIG_MAX_ERROR_MESSAGE_LEN];
-		onig_error_code_to_str((UChar* )s, rv, &einfo);
+	// compiled regex is owned by the cache
+	char s[ONIG_MAX_ERROR_MESSAGE_LEN];
+	regex_t *regex = Regex_Compile(regex_str, false, s);
+	if(regex == NULL) {
 		ErrorCtx_SetError(EMSG_INVALID_REGEX, s);
-		onig_free(regex);
-		onig_region_free(region, 1);
 		return SI_NullVal();
 	}
 
+	OnigRegion *region = onig_region_new();
 	replace_regex_scan_cb_args args = {
 		.res = NULL,
 		.res_len = 0,
@@ -443,19 +428,17 @@ SIValue AR_REPLACEREGEX(SIValue *argv, int argc, void *private_data) {
 		.replacement_len = strlen(replacement)
 	};
 
-	rv = onig_scan(regex, (const UChar *)str,
+	int rv = onig_scan(regex, (const UChar *)str,
 		(const UChar *)(str + strlen(str)), region, ONIG_OPTION_DEFAULT,
 		replace_regex_scan_cb, &args);
 	if(rv < 0) {
-		char s[ONIG_MAX_ERROR_MESSAGE_LEN];
 		onig_error_code_to_str((OnigUChar* )s, rv);
 		ErrorCtx_SetError(EMSG_INVALID_REGEX, s);
-		onig_free(regex);
 		onig_region_free(region, 1);
+		rm_free(args.res);
 		return SI_NullVal();
 	}
 
-	onig_free(regex);
 	onig_region_free(region, 1);
 
 	// copy the remaining string
@@ -569,6 +552,34 @@ SIValue AR_ENDSWITH(SIValue *argv, int argc, void *private_data) {
 	return SI_BoolVal(true);
 }
 
+// returns true if argv[0] entirely matches the regular expression argv[1]
+// str =~ regex
+SIValue AR_REGEXMATCH(SIValue *argv, int argc, void *private_data) {
+	// No string matches null.
+	if(SIValue_IsNull(argv[0]) || SIValue_IsNull(argv[1])) return SI_NullVal();
+
+	char s[ONIG_MAX_ERROR_MESSAGE_LEN];
+	const char *str = argv[0].stringval;
+
+	// compiled regex is owned by the cache
+	regex_t *regex = Regex_Compile(argv[1].stringval, true, s);
+	if(regex == NULL) {
+		ErrorCtx_SetError(EMSG_INVALID_REGEX, s);
+		return SI_NullVal();
+	}
+
+	const UChar *start = (const UChar *)str;
+	const UChar *end   = start + strlen(str);
+	int rv = onig_match(regex, start, end, start, NULL, ONIG_OPTION_NONE);
+	if(rv < ONIG_MISMATCH) {
+		onig_error_code_to_str((OnigUChar *)s, rv);
+		ErrorCtx_SetError(EMSG_INVALID_REGEX, s);
+		return SI_NullVal();
+	}
+
+	return SI_BoolVal(rv != ONIG_MISMATCH);
+}
+
 // returns a string in which all occurrences of a specified string in the original string have been replaced by ANOTHER (specified) string.
 // for example: RETURN replace('Well I wish I was in the land of cotton', 'cotton', 'the free')
 // the result is Well I wish I was in the land of the free
@@ -854,6 +865,13 @@ void Register_StringFuncs() {
 	func_desc = AR_FuncDescNew("ends with", AR_ENDSWITH, 2, 2, types, ret_type, true, true);
 	AR_RegFunc(func_desc);
 
+	types = array_new(SIType, 2);
+	array_append(types, (T_STRING | T_NULL));
+	array_append(types, (T_STRING | T_NULL));
+	ret_type = T_BOOL | T_NULL;
+	func_desc = AR_FuncDescNew("=~", AR_REGEXMATCH, 2, 2, types, ret_type, true, true);
+	AR_RegFunc(func_desc);
+
 	types = array_new(SIType, 0);
 	ret_type = T_STRING;
 	func_desc = AR_FuncDescNew("randomuuid", AR_RANDOMUUID, 0, 0, types, ret_type, false, false);
@@ -694,7 +694,10 @@ const char *AST_ToString
 			struct cypher_input_range range = cypher_astnode_range(node);
 			uint length = range.end.offset - range.start.offset + 1;
 			str = malloc(sizeof(char) * length);
-			strncpy(str, ctx->query_data.query_no_params + range.start.offset, length - 1);
+			// ranges refer to the text the AST was built from
+			const char *q = ctx->query_data.query_normalized;
+			if(q == NULL) q = ctx->query_data.query_no_params;
+			strncpy(str, q + range.start.offset, length - 1);
 			str[length - 1] = '\0';
 		}
 		if(ast_identifier) {
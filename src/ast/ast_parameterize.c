@@ -0,0 +1,371 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "ast_parameterize.h"
+#include "../util/arr.h"
+#include "../util/rmalloc.h"
+#include "../util/sds/sds.h"
+
+#include <ctype.h>
+#include <errno.h>
+#include <string.h>
+#include <strings.h>
+
+// the query is scanned token by token, without building an AST
+// the scanner tracks clause keywords and bracket depth to determine
+// whether a literal can be replaced by a parameter
+
+// kind of the last significant token
+typedef enum {
+	TOKEN_OTHER,  // any token not listed below
+	TOKEN_DOT,    // '.' property access
+	TOKEN_STAR,   // '*' variable length relationship / multiplication
+	TOKEN_RANGE,  // '..' variable length range / list slice
+} TokenKind;
+
+typedef struct {
+	const char *q;      // query being scanned
+	size_t pos;         // current position within query
+	uint depth;         // current bracket depth
+	bool replace;       // literals at current position can be replaced
+	uint region_depth;  // depth at which literal replacement was disabled
+	TokenKind prev;     // last significant token
+	sds out;            // normalized query
+	SIValue *literals;  // extracted literals
+} Scanner;
+
+#define IDENT_START(c) (isalpha((unsigned char)(c)) || (c) == '_')
+#define IDENT_CHAR(c)  (isalnum((unsigned char)(c)) || (c) == '_')
+
+// clauses in which literals are kept as is
+static const char *_keep_clauses[] = {"RETURN", "WITH", "ORDER", "SKIP",
+	"LIMIT"};
+
+// clauses in which literals are replaced
+static const char *_replace_clauses[] = {"MATCH", "OPTIONAL", "WHERE",
+	"CREATE", "MERGE", "SET", "DELETE", "DETACH", "REMOVE", "UNWIND",
+	"FOREACH", "UNION"};
+
+static bool _is_keyword
+(
+	const char *ident,
+	size_t len,
+	const char **keywords,
+	uint n
+) {
+	for(uint i = 0; i < n; i++) {
+		if(strlen(keywords[i]) == len &&
+		   strncasecmp(ident, keywords[i], len) == 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// disable literal replacement until a clause at the current depth
+// or a lower one re-enables it
+static void _disable_replace
+(
+	Scanner *s
+) {
+	if(s->replace) {
+		s->replace = false;
+		s->region_depth = s->depth;
+	} else {
+		s->region_depth = MIN(s->region_depth, s->depth);
+	}
+}
+
+// emit a parameter in place of literal 'v'
+static void _replace_literal
+(
+	Scanner *s,
+	SIValue v
+) {
+	s->out = sdscatprintf(s->out, "$" AST_LITERAL_PARAM_PREFIX "%u",
+			array_len(s->literals));
+	array_append(s->literals, v);
+}
+
+// scan identifier, updating scanner state according to clause keywords
+// returns false if the query shouldn't be parameterized
+static bool _scan_identifier
+(
+	Scanner *s
+) {
+	const char *q     = s->q;
+	const char *ident = q + s->pos;
+	size_t len        = 0;
+
+	while(IDENT_CHAR(ident[len])) len++;
+
+	// property keys are never keywords
+	if(s->prev != TOKEN_DOT) {
+		if(len == 5 && strncasecmp(ident, "INDEX", 5) == 0) {
+			// index DDL, leave as is
+			return false;
+		} else if(len == 4 && strncasecmp(ident, "CALL", 4) == 0) {
+			// procedure call, unless a sub-query follows
+			const char *c = ident + len;
+			while(isspace((unsigned char)*c)) c++;
+			if(*c != '{') _disable_replace(s);
+		} else if(_is_keyword(ident, len, _keep_clauses,
+					sizeof(_keep_clauses) / sizeof(_keep_clauses[0]))) {
+			_disable_replace(s);
+		} else if(!s->replace && s->depth <= s->region_depth &&
+				_is_keyword(ident, len, _replace_clauses,
+					sizeof(_replace_clauses) / sizeof(_replace_clauses[0]))) {
+			s->replace = true;
+		}
+	}
+
+	s->out = sdscatlen(s->out, ident, len);
+	s->pos += len;
+	s->prev = TOKEN_OTHER;
+	return true;
+}
+
+// scan numeric literal
+static void _scan_number
+(
+	Scanner *s
+) {
+	const char *q     = s->q;
+	const char *start = q + s->pos;
+	const char *end   = start;
+	bool is_float     = false;
+
+	if(end[0] == '0' && (end[1] == 'x' || end[1] == 'X')) {
+		// hexadecimal integer
+		end += 2;
+		while(isxdigit((unsigned char)*end)) end++;
+	} else {
+		while(isdigit((unsigned char)*end)) end++;
+		if(end[0] == '.' && isdigit((unsigned char)end[1])) {
+			is_float = true;
+			end++;
+			while(isdigit((unsigned char)*end)) end++;
+		}
+		if(*end == 'e' || *end == 'E') {
+			const char *exp = end + 1;
+			if(*exp == '+' || *exp == '-') exp++;
+			if(isdigit((unsigned char)*exp)) {
+				is_float = true;
+				end = exp;
+				while(isdigit((unsigned char)*end)) end++;
+			}
+		}
+	}
+
+	size_t len = end - start;
+	s->pos += len;
+
+	// keep variable length bounds, list slices
+	// and malformed numbers as is
+	bool keep = !s->replace      ||
+		s->prev == TOKEN_STAR    ||
+		s->prev == TOKEN_RANGE   ||
+		(end[0] == '.' && end[1] == '.') ||
+		IDENT_CHAR(*end);
+
+	s->prev = TOKEN_OTHER;
+
+	if(!keep) {
+		// convert literal the same way the AST does
+		char buf[len + 1];
+		memcpy(buf, start, len);
+		buf[len] = '\0';
+
+		char *endptr = NULL;
+		errno = 0;
+		SIValue v;
+		if(is_float) {
+			v = SI_DoubleVal(strtod(buf, &endptr));
+		} else {
+			v = SI_LongVal(strtol(buf, &endptr, 0));
+		}
+
+		if(*endptr == '\0' && errno == 0) {
+			_replace_literal(s, v);
+			return;
+		}
+	}
+
+	s->out = sdscatlen(s->out, start, len);
+}
+
+// scan string literal
+// returns false if the string isn't terminated
+static bool _scan_string
+(
+	Scanner *s
+) {
+	const char *q     = s->q;
+	const char *start = q + s->pos;
+	char quote        = *start;
+	const char *c     = start + 1;
+	bool simple       = true;  // only simple escape sequences
+
+	while(*c != quote) {
+		if(*c == '\0') return false;
+		if(*c == '\\') {
+			c++;
+			if(*c == '\0') return false;
+			if(strchr("\\'\"bfnrt", *c) == NULL) simple = false;
+		}
+		c++;
+	}
+
+	size_t len = c - start + 1;  // including quotes
+	s->pos += len;
+	s->prev = TOKEN_OTHER;
+
+	if(!s->replace || !simple) {
+		s->out = sdscatlen(s->out, start, len);
+		return true;
+	}
+
+	// unescape string
+	char *str = rm_malloc(len - 1);
+	size_t n = 0;
+	for(const char *p = start + 1; p < c; p++) {
+		if(*p != '\\') {
+			str[n++] = *p;
+			continue;
+		}
+		p++;
+		switch(*p) {
+			case 'b': str[n++] = '\b'; break;
+			case 'f': str[n++] = '\f'; break;
+			case 'n': str[n++] = '\n'; break;
+			case 'r': str[n++] = '\r'; break;
+			case 't': str[n++] = '\t'; break;
+			default:  str[n++] = *p;   break;
+		}
+	}
+	str[n] = '\0';
+
+	_replace_literal(s, SI_TransferStringVal(str));
+	return true;
+}
+
+// copy a token spanning up to and including 'terminator'
+// returns false if the terminator wasn't found
+static bool _copy_until
+(
+	Scanner *s,
+	size_t skip,            // number of leading characters to skip
+	const char *terminator  // token terminator
+) {
+	const char *start = s->q + s->pos;
+	const char *end   = strstr(start + skip, terminator);
+	if(end == NULL) return false;
+
+	size_t len = end - start + strlen(terminator);
+	s->out = sdscatlen(s->out, start, len);
+	s->pos += len;
+	return true;
+}
+
+char *AST_ParameterizeLiterals
+(
+	const char *query,
+	SIValue **literals
+) {
+	ASSERT(query    != NULL);
+	ASSERT(literals != NULL);
+
+	// query already uses the reserved parameter names
+	if(strstr(query, AST_LITERAL_PARAM_PREFIX) != NULL) return NULL;
+
+	Scanner s = {
+		.q            = query,
+		.pos          = 0,
+		.depth        = 0,
+		.replace      = true,
+		.region_depth = 0,
+		.prev         = TOKEN_OTHER,
+		.out          = sdsempty(),
+		.literals     = array_new(SIValue, 0)
+	};
+
+	bool ok = true;
+	while(ok && query[s.pos] != '\0') {
+		char c = query[s.pos];
+		char next = query[s.pos + 1];
+
+		if(isspace((unsigned char)c)) {
+			s.out = sdscatlen(s.out, &c, 1);
+			s.pos++;
+		} else if(c == '/' && next == '/') {
+			// line comment, might end the query
+			if(!_copy_until(&s, 2, "\n")) {
+				s.out = sdscat(s.out, query + s.pos);
+				s.pos += strlen(query + s.pos);
+			}
+		} else if(c == '/' && next == '*') {
+			ok = _copy_until(&s, 2, "*/");
+		} else if(c == '`') {
+			// escaped identifier
+			ok = _copy_until(&s, 1, "`");
+			s.prev = TOKEN_OTHER;
+		} else if(c == '\'' || c == '"') {
+			ok = _scan_string(&s);
+		} else if(c == '$') {
+			// parameter
+			size_t len = 1;
+			while(IDENT_CHAR(query[s.pos + len])) len++;
+			s.out = sdscatlen(s.out, query + s.pos, len);
+			s.pos += len;
+			s.prev = TOKEN_OTHER;
+		} else if(IDENT_START(c)) {
+			ok = _scan_identifier(&s);
+		} else if(isdigit((unsigned char)c)) {
+			_scan_number(&s);
+		} else if(c == '.' && next == '.') {
+			s.out = sdscatlen(s.out, "..", 2);
+			s.pos += 2;
+			s.prev = TOKEN_RANGE;
+		} else if(c == '.' && isdigit((unsigned char)next)) {
+			// fraction without an integer part e.g. .5, kept as is
+			size_t len = 1;
+			while(IDENT_CHAR(query[s.pos + len])) len++;
+			s.out = sdscatlen(s.out, query + s.pos, len);
+			s.pos += len;
+			s.prev = TOKEN_OTHER;
+		} else {
+			if(c == '(' || c == '[' || c == '{') {
+				s.depth++;
+			} else if(c == ')' || c == ']' || c == '}') {
+				if(s.depth > 0) s.depth--;
+				// leaving the scope in which replacement was disabled
+				if(!s.replace && s.depth < s.region_depth) s.replace = true;
+			}
+
+			s.out = sdscatlen(s.out, &c, 1);
+			s.pos++;
+
+			if(c == '.')      s.prev = TOKEN_DOT;
+			else if(c == '*') s.prev = TOKEN_STAR;
+			else              s.prev = TOKEN_OTHER;
+		}
+	}
+
+	char *res = NULL;
+	uint n = array_len(s.literals);
+
+	if(ok && n > 0) {
+		res = rm_strdup(s.out);
+		*literals = s.literals;
+	} else {
+		for(uint i = 0; i < n; i++) SIValue_Free(s.literals[i]);
+		array_free(s.literals);
+	}
+
+	sdsfree(s.out);
+	return res;
+}
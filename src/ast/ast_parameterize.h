@@ -0,0 +1,32 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "../value.h"
+
+// name prefix of parameters introduced by literal parameterization
+// the i-th extracted literal is bound to parameter AST_LITERAL_PARAM_PREFIX<i>
+#define AST_LITERAL_PARAM_PREFIX "__lit"
+
+// replace numeric and string literals within 'query' with parameters
+// such that queries differing only by their literals share the same text
+// e.g.
+// MATCH (n:L) WHERE n.v = 1 RETURN n
+// becomes
+// MATCH (n:L) WHERE n.v = $__lit0 RETURN n
+//
+// literals are left intact where replacing them would alter the query's
+// outcome or its result-set header: WITH / RETURN projections,
+// ORDER BY, SKIP, LIMIT, procedure calls and variable length bounds
+//
+// returns NULL if the query wasn't modified, otherwise the caller owns both
+// the returned query and the 'literals' array
+char *AST_ParameterizeLiterals
+(
+	const char *query,  // query string, excluding the parameters header
+	SIValue **literals  // [output] extracted literals, in order of appearance
+);
@@ -62,6 +62,8 @@ AST_Operator AST_ConvertOperatorNode
 		return OP_IS_NULL;
 	} else if(op == CYPHER_OP_IS_NOT_NULL) {
 		return OP_IS_NOT_NULL;
+	} else if(op == CYPHER_OP_REGEX) {
+		return OP_REGEX;
 	}
 
 	return -1;
@@ -1992,8 +1992,7 @@ static VISITOR_STRATEGY _visit_binary_op
 ) {
 	const cypher_operator_t *op = cypher_ast_binary_operator_get_operator(n);
 	if(op == CYPHER_OP_SUBSCRIPT ||
-	   op == CYPHER_OP_MAP_PROJECTION ||
-	   op == CYPHER_OP_REGEX) {
+	   op == CYPHER_OP_MAP_PROJECTION) {
 		Error_UnsupportedASTOperator(op);
 		return VISITOR_BREAK;
 	}
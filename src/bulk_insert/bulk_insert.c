@@ -238,6 +238,7 @@ static int _BulkInsert_ProcessNodeFile
 				continue;
 			GraphEntity_AddProperty(ge, prop_indices[i], value);
 		}
+		GraphContext_InternAttributes(gc, *ge->attributes);
 	}
 
     Graph_SetMatrixPolicy(gc->g, SYNC_POLICY_RESIZE);
@@ -303,6 +304,7 @@ static int _BulkInsert_ProcessEdgeFile
 
 			GraphEntity_AddProperty(ge, prop_indices[i], value);
 		}
+		GraphContext_InternAttributes(gc, *ge->attributes);
 	}
 
     array_free(type_ids);
@@ -25,6 +25,7 @@ CommandCtx *CommandCtx_New
 	ExecutorThread thread,         // which thread executes this command
 	bool replicated_command,       // whether this instance was spawned by a replication command
 	bool compact,                  // whether this query was issued with the compact flag
+	bool binary,                   // whether this query was issued with the binary flag
 	long long timeout,             // the query timeout, if specified
 	bool timeout_rw,               // apply timeout on both read and write queries
 	uint64_t received_ts,          // command received at this  UNIX timestamp
@@ -37,6 +38,7 @@ CommandCtx *CommandCtx_New
 	context->query              = NULL;
 	context->thread             = thread;
 	context->compact            = compact;
+	context->binary             = binary;
 	context->timeout            = timeout;
 	context->ref_count          = ATOMIC_VAR_INIT(1);
 	context->graph_ctx          = graph_ctx;
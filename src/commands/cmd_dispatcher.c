@@ -24,18 +24,21 @@ static int _read_flags
 	RedisModuleString **argv,   // commands arguments
   	int argc,                   // number of arguments
   	bool *compact,              // compact result-set format
+  	bool *binary,               // binary result-set format
 	long long *timeout,         // query level timeout
   	bool *timeout_rw,           // apply timeout on both read and write queries
   	uint *graph_version,        // graph version [UNUSED]
   	char **errmsg               // reported error message
 ) {
 	ASSERT(compact != NULL);
+	ASSERT(binary  != NULL);
 	ASSERT(timeout != NULL);
 
 	long long max_timeout;
 
 	// set defaults
 	*compact = false;  // verbose
+	*binary  = false;
 	*graph_version = GRAPH_VERSION_MISSING;
 	Config_Option_get(Config_TIMEOUT_DEFAULT, timeout);
 	Config_Option_get(Config_TIMEOUT_MAX, &max_timeout);
@@ -62,6 +65,9 @@ static int _read_flags
 		if(!strcasecmp(arg, "--compact")) {
 			// compact result-set
 			*compact = true;
+		} else if(!strcasecmp(arg, "--binary")) {
+			// binary result-set
+			*binary = true;
 		} else if(!strcasecmp(arg, "timeout")) {
 			// query timeout
 			int err = REDISMODULE_ERR;
@@ -179,6 +185,7 @@ int CommandDispatch
 ) {
 	char *errmsg;
 	uint version;
+	bool binary;
 	bool compact;
 	bool timeout_rw;
 	long long timeout;
@@ -196,7 +203,7 @@ int CommandDispatch
 	if(_validate_command_arity(cmd, argc) == false) return RedisModule_WrongArity(ctx);
 
 	// parse additional arguments
-	int res = _read_flags(argv, argc, &compact, &timeout, &timeout_rw, &version,
+	int res = _read_flags(argv, argc, &compact, &binary, &timeout, &timeout_rw, &version,
 			&errmsg);
 	if(res == REDISMODULE_ERR) {
 		// emit error and exit if argument parsing failed
@@ -242,14 +249,14 @@ int CommandDispatch
 	if(exec_thread == EXEC_THREAD_MAIN) {
 		// run query on Redis main thread
 		context = CommandCtx_New(ctx, NULL, argv[0], query, gc, exec_thread,
-								 is_replicated, compact, timeout, timeout_rw,
+								 is_replicated, compact, binary, timeout, timeout_rw,
 								 received_ts, timer);
 		handler(context);
 	} else {
 		// run query on a dedicated thread
 		RedisModuleBlockedClient *bc = RedisGraph_BlockClient(ctx);
 		context = CommandCtx_New(NULL, bc, argv[0], query, gc, exec_thread,
-								 is_replicated, compact, timeout, timeout_rw,
+								 is_replicated, compact, binary, timeout, timeout_rw,
 								 received_ts, timer);
 
 		if(ThreadPools_AddWorkReader(handler, context, false) ==
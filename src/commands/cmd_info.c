@@ -21,8 +21,21 @@
 #define RECEIVED_TIMESTAMP_KEY_NAME "Received at"
 #define EXECUTION_DURATION_KEY_NAME "Execution duration"
 
+#define GRAPH_CACHE_HITS_KEY_NAME       "Graph cache hits"
+#define GRAPH_CACHE_MISSES_KEY_NAME     "Graph cache misses"
+#define GRAPH_CACHE_EVICTIONS_KEY_NAME  "Graph cache evictions"
+#define SHARED_CACHE_HITS_KEY_NAME      "Shared cache hits"
+#define SHARED_CACHE_MISSES_KEY_NAME    "Shared cache misses"
+#define SHARED_CACHE_EVICTIONS_KEY_NAME "Shared cache evictions"
+
+#define COMPACTION_RUNS_KEY_NAME        "Compaction runs"
+#define RECLAIMED_BYTES_KEY_NAME        "Reclaimed bytes"
+#define REPACKED_SETS_KEY_NAME          "Attribute sets repacked"
+
 #define SUBCOMMAND_NAME_RUNNING_QUERIES "RunningQueries"
 #define SUBCOMMAND_NAME_WAITING_QUERIES "WaitingQueries"
+#define SUBCOMMAND_NAME_PLAN_CACHE      "PlanCache"
+#define SUBCOMMAND_NAME_COMPACTION      "Compaction"
 
 //------------------------------------------------------------------------------
 // Info section API
@@ -240,6 +253,114 @@ static void _info_waiting_queries
 	free(cmds);
 }
 
+// handles the "GRAPH.INFO PlanCache" section
+// "GRAPH.INFO PlanCache"
+static void _info_plan_cache
+(
+	RedisModuleCtx *ctx       // redis context
+) {
+	// an example for a command and reply:
+	// command:
+	// GRAPH.INFO PlanCache
+	// reply:
+	// "PlanCache"
+	//     "Graph cache hits"
+	//     "Graph cache misses"
+	//     "Graph cache evictions"
+	//     "Shared cache hits"
+	//     "Shared cache misses"
+	//     "Shared cache evictions"
+
+	ASSERT(ctx != NULL);
+
+	//--------------------------------------------------------------------------
+	// sum per graph cache counters
+	//--------------------------------------------------------------------------
+
+	CacheStats graph_stats = {0};
+
+	KeySpaceGraphIterator it;
+	Globals_ScanGraphs(&it);
+
+	GraphContext *gc = NULL;
+	while((gc = GraphIterator_Next(&it)) != NULL) {
+		CacheStats stats;
+		Cache_GetStats(GraphContext_GetCache(gc), &stats);
+
+		graph_stats.hits      += stats.hits;
+		graph_stats.misses    += stats.misses;
+		graph_stats.evictions += stats.evictions;
+
+		GraphContext_DecreaseRefCount(gc);
+	}
+
+	// shared cache counters, zeros if plans aren't shared
+	CacheStats shared_stats = {0};
+	Cache *shared_cache = Globals_GetSharedCache();
+	if(shared_cache != NULL) Cache_GetStats(shared_cache, &shared_stats);
+
+	// create a new subsection in the reply
+	Info_AddSection(ctx, "# Plan cache", 6 * 2);
+
+	Info_SectionAddEntryLongLong(ctx, GRAPH_CACHE_HITS_KEY_NAME,
+			graph_stats.hits);
+	Info_SectionAddEntryLongLong(ctx, GRAPH_CACHE_MISSES_KEY_NAME,
+			graph_stats.misses);
+	Info_SectionAddEntryLongLong(ctx, GRAPH_CACHE_EVICTIONS_KEY_NAME,
+			graph_stats.evictions);
+	Info_SectionAddEntryLongLong(ctx, SHARED_CACHE_HITS_KEY_NAME,
+			shared_stats.hits);
+	Info_SectionAddEntryLongLong(ctx, SHARED_CACHE_MISSES_KEY_NAME,
+			shared_stats.misses);
+	Info_SectionAddEntryLongLong(ctx, SHARED_CACHE_EVICTIONS_KEY_NAME,
+			shared_stats.evictions);
+}
+
+// handles the "GRAPH.INFO Compaction" section
+// "GRAPH.INFO Compaction"
+static void _info_compaction
+(
+	RedisModuleCtx *ctx       // redis context
+) {
+	// an example for a command and reply:
+	// command:
+	// GRAPH.INFO Compaction
+	// reply:
+	// "Compaction"
+	//     "Compaction runs"
+	//     "Reclaimed bytes"
+	//     "Attribute sets repacked"
+
+	ASSERT(ctx != NULL);
+
+	//--------------------------------------------------------------------------
+	// sum per graph compaction counters
+	//--------------------------------------------------------------------------
+
+	uint64_t runs      = 0;
+	uint64_t reclaimed = 0;
+	uint64_t repacked  = 0;
+
+	KeySpaceGraphIterator it;
+	Globals_ScanGraphs(&it);
+
+	GraphContext *gc = NULL;
+	while((gc = GraphIterator_Next(&it)) != NULL) {
+		runs      += __atomic_load_n(&gc->compaction_runs, __ATOMIC_RELAXED);
+		reclaimed += __atomic_load_n(&gc->reclaimed_bytes, __ATOMIC_RELAXED);
+		repacked  += __atomic_load_n(&gc->repacked_sets, __ATOMIC_RELAXED);
+
+		GraphContext_DecreaseRefCount(gc);
+	}
+
+	// create a new subsection in the reply
+	Info_AddSection(ctx, "# Compaction", 3 * 2);
+
+	Info_SectionAddEntryLongLong(ctx, COMPACTION_RUNS_KEY_NAME, runs);
+	Info_SectionAddEntryLongLong(ctx, RECLAIMED_BYTES_KEY_NAME, reclaimed);
+	Info_SectionAddEntryLongLong(ctx, REPACKED_SETS_KEY_NAME, repacked);
+}
+
 // attempts to find the specified sections of "GRAPH.INFO" and dispatch it
 static void _handle_sections
 (
@@ -253,6 +374,8 @@ static void _handle_sections
 	int section_count = 0;
 	bool running_queries = false;
 	bool waiting_queries = false;
+	bool plan_cache      = false;
+	bool compaction      = false;
 
 	if(argc == 0) {
 		running_queries = true;
@@ -269,6 +392,14 @@ static void _handle_sections
 					  !strcasecmp(subcmd, SUBCOMMAND_NAME_WAITING_QUERIES)) {
 				waiting_queries = true;
 				section_count++;
+			} else if(!plan_cache &&
+					  !strcasecmp(subcmd, SUBCOMMAND_NAME_PLAN_CACHE)) {
+				plan_cache = true;
+				section_count++;
+			} else if(!compaction &&
+					  !strcasecmp(subcmd, SUBCOMMAND_NAME_COMPACTION)) {
+				compaction = true;
+				section_count++;
 			}
 		}
 	}
@@ -285,11 +416,17 @@ static void _handle_sections
 	if(waiting_queries) {
 		_info_waiting_queries(ctx);
 	}
+	if(plan_cache) {
+		_info_plan_cache(ctx);
+	}
+	if(compaction) {
+		_info_compaction(ctx);
+	}
 }
 
 // graph.info command handler
 // GRAPH.INFO [Section [Section ...]]
-// GRAPH.INFO RunningQueries WaitingQueries
+// GRAPH.INFO RunningQueries WaitingQueries PlanCache Compaction
 int Graph_Info
 (
 	RedisModuleCtx *ctx,       // redis module context
@@ -307,15 +307,28 @@ static void _ExecuteQuery(void *args) {
 	}
 
 	// instantiate the query ResultSet
+	bool binary  = command_ctx->binary;
 	bool compact = command_ctx->compact;
 	// replicated command don't need to return result
 	ResultSetFormatterType resultset_format =
 		profile || command_ctx->replicated_command
 		? FORMATTER_NOP
-		: (compact)
-			? FORMATTER_COMPACT
-			: FORMATTER_VERBOSE;
+		: (binary)
+			? FORMATTER_BINARY
+			: (compact)
+				? FORMATTER_COMPACT
+				: FORMATTER_VERBOSE;
 	ResultSet *result_set = NewResultSet(rm_ctx, resultset_format);
+
+	// read queries may serialize rows into the reply as they're produced
+	// write queries might fail after producing rows, rolling back
+	// their modifications, as such they reply once done
+	uint64_t stream_window;
+	Config_Option_get(Config_RESULTSET_STREAM_WINDOW, &stream_window);
+	if(readonly && stream_window > 0 && resultset_format != FORMATTER_NOP) {
+		ResultSet_Stream(result_set, stream_window);
+	}
+
 	if(exec_ctx->cached) {
 		ResultSet_CachedExecution(result_set); // indicate a cached execution
 	}
@@ -329,11 +342,14 @@ static void _ExecuteQuery(void *args) {
 		// if this is a writer query `we need to re-open the graph key with write flag
 		// this notifies Redis that the key is "dirty" any watcher on that key will
 		// be notified
-		CommandCtx_ThreadSafeContextLock(command_ctx);
+		// under group commit the GIL might already be held
+		GroupCommit *group = query_ctx->internal_exec_ctx.group;
+		bool gil_held = group != NULL && group->locked;
+		if(!gil_held) CommandCtx_ThreadSafeContextLock(command_ctx);
 		{
 			GraphContext_MarkWriter(rm_ctx, gc);
 		}
-		CommandCtx_ThreadSafeContextUnlock(command_ctx);
+		if(!gil_held) CommandCtx_ThreadSafeContextUnlock(command_ctx);
 	}
 
 	if(exec_type == EXECUTION_TYPE_QUERY) {  // query operation
@@ -433,6 +449,104 @@ static void _ExecuteQuery(void *args) {
 	GraphQueryCtx_Free(gq_ctx);
 }
 
+// returns true if plan neither reads the graph nor returns records
+// e.g. CREATE ... or UNWIND $rows AS r CREATE ...
+// such a query reaches its commit right away and replies only statistics
+static bool _BlindWrite
+(
+	const OpBase *op  // plan's root
+) {
+	switch(op->type) {
+		case OPType_CREATE:
+		case OPType_UNWIND:
+		case OPType_PROJECT:
+			break;
+		default:
+			return false;
+	}
+
+	for(uint i = 0; i < op->childCount; i++) {
+		if(!_BlindWrite(op->children[i])) return false;
+	}
+
+	return true;
+}
+
+// releases the locks held by a group commit
+static void _GroupCommit_Release
+(
+	GroupCommit *group,  // group commit
+	GraphContext *gc     // graph context
+) {
+	if(!group->locked) return;
+
+	GraphContext_UnlockCommit(group->redis_ctx, gc);
+	group->locked = false;
+}
+
+// executes the queued write queries of a graph
+// writes are dequeued in batches of up to MAX_WRITE_BATCH queries
+// consecutive blind writes within a batch are group committed:
+// the GIL and the graph's write lock are acquired by the first of them to
+// commit and handed over to the next, such that they're acquired once for
+// the entire group instead of once per query
+// any other query ends the group and executes with its own locks
+// keeping its read phase free of the write lock
+static void _ExecuteWrites(void *args) {
+	ASSERT(args != NULL);
+
+	GraphContext *gc = (GraphContext *)args;
+
+	uint max_batch;
+	Config_Option_get(Config_MAX_WRITE_BATCH, &max_batch);
+	ASSERT(max_batch > 0);
+
+	GroupCommit group = {
+		.redis_ctx = RedisModule_GetThreadSafeContext(NULL),
+		.locked    = false
+	};
+
+	uint n;
+	GraphQueryCtx *batch[max_batch];
+	while((n = GraphContext_DequeueWrites(gc, (void **)batch, max_batch)) > 0) {
+		for(uint i = 0; i < n; i++) {
+			GraphQueryCtx *gq_ctx = batch[i];
+			ExecutionCtx *exec_ctx = gq_ctx->exec_ctx;
+
+			// index operations populate indices asynchronously
+			// and are executed on their own
+			bool groupable = n > 1 &&
+				exec_ctx->exec_type == EXECUTION_TYPE_QUERY &&
+				_BlindWrite(exec_ctx->plan->root);
+
+			if(!groupable) _GroupCommit_Release(&group, gc);
+
+			gq_ctx->query_ctx->internal_exec_ctx.group =
+				groupable ? &group : NULL;
+			_ExecuteQuery(gq_ctx);
+		}
+
+		_GroupCommit_Release(&group, gc);
+	}
+
+	RedisModule_FreeThreadSafeContext(group.redis_ctx);
+
+	// release the reference acquired when the writer was scheduled
+	GraphContext_DecreaseRefCount(gc);
+}
+
+void Graph_ScheduleWrites
+(
+	GraphContext *gc  // graph context
+) {
+	ASSERT(gc != NULL);
+
+	// keep the graph context alive until its queue is drained
+	GraphContext_IncreaseRefCount(gc);
+	int res = ThreadPools_AddWorkWriter(_ExecuteWrites, gc, 1);
+	ASSERT(res == 0);
+}
+
 static void _DelegateWriter(GraphQueryCtx *gq_ctx) {
 	ASSERT(gq_ctx != NULL);
 
@@ -454,9 +568,11 @@ static void _DelegateWriter(GraphQueryCtx *gq_ctx) {
 	// reset query stage from executing back to waiting
 	QueryCtx_ResetStage(gq_ctx->query_ctx);
 
-	// dispatch work to the writer thread
-	int res = ThreadPools_AddWorkWriter(_ExecuteQuery, gq_ctx, 0);
-	ASSERT(res == 0);
+	// queue work on the graph, writes to the same graph are executed in order
+	// by a single writer at a time, while writes to different graphs
+	// are executed concurrently by the writers pool
+	GraphContext *gc = gq_ctx->graph_ctx;
+	if(GraphContext_EnqueueWrite(gc, gq_ctx)) Graph_ScheduleWrites(gc);
 }
 
 void _query
@@ -40,6 +40,9 @@ void Graph_Query(void *args);
 void Graph_Profile(void *args);
 void Graph_Explain(void *args);
 
+// schedule a writer draining the graph's queued write queries
+void Graph_ScheduleWrites(GraphContext *gc);
+
 int Graph_List(RedisModuleCtx *ctx, RedisModuleString **argv, int argc);
 int Graph_Info(RedisModuleCtx *ctx, RedisModuleString **argv, int argc);
 int Graph_Debug(RedisModuleCtx *ctx, RedisModuleString **argv, int argc);
@@ -8,7 +8,13 @@
 #include "RG.h"
 #include "../query_ctx.h"
 #include "../errors/errors.h"
+#include "../globals.h"
+#include "../util/arr.h"
+#include "../ast/ast_parameterize.h"
 #include "../execution_plan/execution_plan_clone.h"
+#include "../execution_plan/execution_plan_build/execution_plan_util.h"
+
+#include <inttypes.h>
 
 static ExecutionType _GetExecutionTypeFromAST
 (
@@ -89,6 +95,155 @@ ExecutionCtx *ExecutionCtx_Clone
 	return clone;
 }
 
+// bind literals extracted from the query to their parameters
+static void _ExecutionCtx_BindLiterals
+(
+	SIValue *literals  // extracted literals
+) {
+	rax *params = QueryCtx_GetParams();
+	if(params == NULL) {
+		params = raxNew();
+		QueryCtx_SetParams(params);
+	}
+
+	char name[32];
+	uint n = array_len(literals);
+	for(uint i = 0; i < n; i++) {
+		int len = snprintf(name, sizeof(name), AST_LITERAL_PARAM_PREFIX "%u",
+				i);
+
+		SIValue *v = rm_malloc(sizeof(SIValue));
+		*v = literals[i];
+
+		// an unreferenced user parameter might share the name
+		void *old = NULL;
+		raxInsert(params, (unsigned char *)name, len, v, &old);
+		if(old != NULL) {
+			SIValue_Free(*(SIValue *)old);
+			rm_free(old);
+		}
+	}
+
+	array_free(literals);
+}
+
+// parse query and build its execution plan
+// returns NULL on failure
+static ExecutionCtx *_ExecutionCtx_Build
+(
+	const char *q_str  // query string excluding query parameters
+) {
+	// try to parse the query
+	AST *ast = _ExecutionCtx_ParseAST(q_str);
+
+	// parser failed
+	if(ast == NULL) {
+		// if no error has been set, emit one now
+		if(!ErrorCtx_EncounteredError()) {
+			ErrorCtx_SetError(EMSG_COULD_NOT_PARSE_QUERY);
+		}
+		return NULL;
+	}
+
+	ExecutionPlan *plan = NULL;
+	ExecutionType exec_type = _GetExecutionTypeFromAST(ast);
+
+	// in case of valid query create execution plan
+	if(exec_type == EXECUTION_TYPE_QUERY) {
+		plan = ExecutionPlan_FromTLS_AST();
+
+		// TODO: there must be a better way to understand if the execution-plan
+		// was constructed correctly,
+		// maybe free the plan within ExecutionPlan_FromTLS_AST, if error was
+		// encountered and return NULL ?
+		if(ErrorCtx_EncounteredError()) {
+			// failed to construct plan
+			// clean up and return NULL
+			AST_Free(ast);
+			ExecutionPlan_Free(plan);
+			return NULL;
+		}
+	}
+
+	return _ExecutionCtx_New(ast, plan, exec_type);
+}
+
+// returns true if execution ctx can be executed against other graphs
+// sharing the same schema layout
+// index scans hold references to their graph's index and can't be shared
+static bool _ExecutionCtx_Shareable
+(
+	const ExecutionCtx *ctx  // execution context
+) {
+	const OPType types[] = {OPType_NODE_BY_INDEX_SCAN,
+		OPType_EDGE_BY_INDEX_SCAN};
+
+	OpBase **ops = ExecutionPlan_CollectOpsMatchingTypes(ctx->plan->root,
+			types, 2);
+	bool shareable = (array_len(ops) == 0);
+	array_free(ops);
+
+	return shareable;
+}
+
+// compose shared cache key from schema fingerprint and query string
+static char *_ExecutionCtx_SharedKey
+(
+	GraphContext *gc,  // graph context
+	const char *q_str  // query string
+) {
+	char *key;
+	int rc __attribute__((unused));
+	rc = asprintf(&key, "%016" PRIx64 ":%s",
+			GraphContext_SchemaFingerprint(gc), q_str);
+	return key;
+}
+
+// look up query in the graph's cache and then in the shared cache
+// returns NULL if query isn't cached
+static ExecutionCtx *_ExecutionCtx_FromCache
+(
+	Cache *cache,           // graph's cache
+	Cache *shared_cache,    // shared cache, can be NULL
+	const char *shared_key, // shared cache key
+	const char *q_str       // query string
+) {
+	ExecutionCtx *ret = Cache_GetValue(cache, q_str);
+	if(ret != NULL || shared_cache == NULL) return ret;
+
+	ret = Cache_GetValue(shared_cache, shared_key);
+	if(ret == NULL) return NULL;
+
+	// populate graph's cache with the shared execution ctx
+	// the returned value is either a copy of 'ret' or 'ret' itself
+	// in case the query was cached by a concurrent thread in the meantime
+	return Cache_SetGetValue(cache, q_str, ret);
+}
+
+// cache a newly built execution ctx
+// returns the execution ctx to execute
+static ExecutionCtx *_ExecutionCtx_Cache
+(
+	Cache *cache,            // graph's cache
+	Cache *shared_cache,     // shared cache, can be NULL
+	const char *shared_key,  // shared cache key
+	const char *q_str,       // query string
+	ExecutionCtx *exec_ctx   // execution ctx to cache
+) {
+	// share execution ctx with other graphs
+	if(shared_cache != NULL && _ExecutionCtx_Shareable(exec_ctx)) {
+		ExecutionCtx *clone = ExecutionCtx_Clone(exec_ctx);
+		if(!Cache_SetValue(shared_cache, shared_key, clone)) {
+			ExecutionCtx_Free(clone);
+		}
+	}
+
+	ExecutionCtx *ret = Cache_SetGetValue(cache, q_str, exec_ctx);
+	QueryCtx_SetAST(ret->ast);
+
+	return ret;
+}
+
 // returns the objects and information required for query execution
 // if the query contains error, a ExecutionCtx struct with the AST
 // and Execution plan objects will be NULL
@@ -133,11 +288,33 @@ ExecutionCtx *ExecutionCtx_FromQuery
 	QueryCtx *ctx = QueryCtx_GetQueryCtx();
 	ctx->query_data.query_no_params = q_str;
 
-	// get cache
-	Cache *cache = GraphContext_GetCache(QueryCtx_GetGraphCtx());
+	// replace literals with parameters
+	// queries differing only by their literals share the same cache entry
+	// the normalized text serves as the cache key and is what the AST is
+	// built from, the original text is kept for reporting
+	SIValue *literals = NULL;
+	const char *q_orig = q_str;
+	char *q_normalized = AST_ParameterizeLiterals(q_str, &literals);
+	if(q_normalized != NULL) {
+		_ExecutionCtx_BindLiterals(literals);
+		ctx->query_data.query_normalized = q_normalized;
+		q_str = q_normalized;
+	}
+
+	// get caches
+	GraphContext *gc   = QueryCtx_GetGraphCtx();
+	Cache *cache        = GraphContext_GetCache(gc);
+	Cache *shared_cache = Globals_GetSharedCache();
+	char *shared_key    = NULL;
+
+retry:
+	if(shared_cache != NULL) {
+		free(shared_key);
+		shared_key = _ExecutionCtx_SharedKey(gc, q_str);
+	}
 
 	// see if we already have a cached execution-ctx for given query
-	ret = Cache_GetValue(cache, q_str);
+	ret = _ExecutionCtx_FromCache(cache, shared_cache, shared_key, q_str);
 
 	//--------------------------------------------------------------------------
 	// cache hit
@@ -146,57 +323,41 @@ ExecutionCtx *ExecutionCtx_FromQuery
 	if(ret != NULL) {
 		parse_result_free(params_parse_result);  // free parsed params
 		ret->cached = true;                      // mark cached execution
-		return ret;
+		goto cleanup;
 	}
 
 	//--------------------------------------------------------------------------
 	// cache miss
 	//--------------------------------------------------------------------------
 
-	// try to parse the query
-	AST *ast = _ExecutionCtx_ParseAST(q_str);
+	ret = _ExecutionCtx_Build(q_str);
+
+	if(ret == NULL && q_str != q_orig) {
+		// parameterized query is invalid, fall back to the original query
+		// which reports the error as given by the user, or rightfully
+		// relies on a literal where a parameter isn't allowed
+		ErrorCtx_Clear();
+		q_str = q_orig;
+		rm_free(ctx->query_data.query_normalized);
+		ctx->query_data.query_normalized = NULL;
+		goto retry;
+	}
 
-	// parser failed
-	if(ast == NULL) {
+	if(ret == NULL) {
 		parse_result_free(params_parse_result);  // free parsed params
-
-		// if no error has been set, emit one now
-		if(!ErrorCtx_EncounteredError()) {
-			ErrorCtx_SetError(EMSG_COULD_NOT_PARSE_QUERY);
-		}
-		return NULL;
+		goto cleanup;
 	}
 
 	// associate parameters with AST
-	AST_SetParamsParseResult(ast, params_parse_result);
-
-	ExecutionType exec_type = _GetExecutionTypeFromAST(ast);
-	// in case of valid query
-	// create execution plan, and cache it and the AST
-	if(exec_type == EXECUTION_TYPE_QUERY) {
-		//----------------------------------------------------------------------
-		// build execution-plan
-		//----------------------------------------------------------------------
-		ExecutionPlan *plan = ExecutionPlan_FromTLS_AST();
-
-		// TODO: there must be a better way to understand if the execution-plan
-		// was constructed correctly,
-		// maybe free the plan within ExecutionPlan_FromTLS_AST, if error was
-		// encountered and return NULL ?
-		if(ErrorCtx_EncounteredError()) {
-			// failed to construct plan
-			// clean up and return NULL
-			AST_Free(ast);
-			ExecutionPlan_Free(plan);
-			return NULL;
-		}
+	AST_SetParamsParseResult(ret->ast, params_parse_result);
 
-		ExecutionCtx *exec_ctx = _ExecutionCtx_New(ast, plan, exec_type);
-		ret = Cache_SetGetValue(cache, q_str, exec_ctx);
-	} else {
-		ret = _ExecutionCtx_New(ast, NULL, exec_type);
+	// cache execution plan and AST
+	if(ret->exec_type == EXECUTION_TYPE_QUERY) {
+		ret = _ExecutionCtx_Cache(cache, shared_cache, shared_key, q_str, ret);
 	}
 
+cleanup:
+	free(shared_key);
 	return ret;
 }
 
@@ -64,6 +64,42 @@
 // effects replication threshold
 #define EFFECTS_THRESHOLD "EFFECTS_THRESHOLD"
 
+// max number of threads a single read query can utilize
+#define MAX_QUERY_PARALLELISM "MAX_QUERY_PARALLELISM"
+
+// config param, the size of the execution plans cache shared by all graphs
+#define SHARED_CACHE_SIZE "SHARED_CACHE_SIZE"
+
+// config param, the number of threads executing write queries
+#define WRITER_THREAD_COUNT "WRITER_THREAD_COUNT"
+
+// config param, max number of queued writes committed together
+#define MAX_WRITE_BATCH "MAX_WRITE_BATCH"
+
+// config param, max number of attribute summaries held per graph
+#define AGGREGATE_CACHE_SIZE "AGGREGATE_CACHE_SIZE"
+
+// config param, number of rows buffered by a streamed result-set
+#define RESULTSET_STREAM_WINDOW "RESULTSET_STREAM_WINDOW"
+
+// config param, collect hardware counters when profiling queries
+#define PROFILE_HW_COUNTERS "PROFILE_HW_COUNTERS"
+
+// config param, share storage of equal string attributes
+#define INTERN_STRINGS "INTERN_STRINGS"
+
+// config param, maintain trigram postings in exact-match indexes
+#define TRIGRAM_INDEX "TRIGRAM_INDEX"
+
+// config param, interval between consecutive compaction checks (ms)
+#define COMPACTION_INTERVAL "COMPACTION_INTERVAL"
+
+// config param, number of deleted entities triggering a compaction
+#define COMPACTION_MIN_DELETED "COMPACTION_MIN_DELETED"
+
+// config param, percentage of deleted entities triggering a compaction
+#define COMPACTION_DELETED_RATIO "COMPACTION_DELETED_RATIO"
+
 
 //------------------------------------------------------------------------------
 // Configuration defaults
@@ -94,6 +130,18 @@ typedef struct {
 	bool cmd_info_on;                  // If true, the GRAPH.INFO is enabled.
 	uint64_t effects_threshold;        // replicate via effects when runtime exceeds threshold
 	uint32_t max_info_queries_count;   // Maximum number of query info elements.
+	uint max_query_parallelism;        // max number of threads a single query can utilize
+	uint64_t shared_cache_size;        // size of the cache shared by all graphs, 0 disables it
+	uint writer_thread_count;          // number of threads executing write queries
+	uint max_write_batch;              // max number of queued writes committed together
+	uint64_t aggregate_cache_size;     // max number of cached attribute summaries per graph, 0 disables
+	uint64_t resultset_stream_window;  // rows buffered by a streamed result-set, 0 disables streaming
+	bool profile_hw_counters;          // collect hardware counters when profiling
+	bool intern_strings;               // share storage of equal string attributes
+	bool trigram_index;                // maintain trigram postings in exact-match indexes
+	uint64_t compaction_interval;      // ms between compaction checks, 0 disables compaction
+	uint64_t compaction_min_deleted;   // deleted entities triggering a compaction, 0 disables
+	uint64_t compaction_deleted_ratio; // percentage of deleted entities triggering a compaction, 0 disables
 } RG_Config;
 
 RG_Config config; // global module configuration
@@ -436,6 +484,188 @@ static uint64_t Config_effects_threshold_get (void) {
 	return config.effects_threshold;
 }
 
+//------------------------------------------------------------------------------
+// max query parallelism
+//------------------------------------------------------------------------------
+
+static void Config_max_query_parallelism_set
+(
+	uint dop
+) {
+	// 0 restores the default, single threaded execution
+	if(dop == 0) dop = MAX_QUERY_PARALLELISM_DEFAULT;
+	config.max_query_parallelism = dop;
+}
+
+static uint Config_max_query_parallelism_get(void) {
+	return config.max_query_parallelism;
+}
+
+//------------------------------------------------------------------------------
+// shared cache size
+//------------------------------------------------------------------------------
+
+static void Config_shared_cache_size_set
+(
+	uint64_t shared_cache_size
+) {
+	config.shared_cache_size = shared_cache_size;
+}
+
+static uint64_t Config_shared_cache_size_get(void) {
+	return config.shared_cache_size;
+}
+
+//------------------------------------------------------------------------------
+// writer thread count
+//------------------------------------------------------------------------------
+
+static void Config_writer_thread_count_set
+(
+	uint nthreads
+) {
+	config.writer_thread_count = nthreads;
+}
+
+static uint Config_writer_thread_count_get(void) {
+	return config.writer_thread_count;
+}
+
+//------------------------------------------------------------------------------
+// max write batch
+//------------------------------------------------------------------------------
+
+static void Config_max_write_batch_set
+(
+	uint batch
+) {
+	config.max_write_batch = batch;
+}
+
+static uint Config_max_write_batch_get(void) {
+	return config.max_write_batch;
+}
+
+//------------------------------------------------------------------------------
+// aggregate cache size
+//------------------------------------------------------------------------------
+
+static void Config_aggregate_cache_size_set
+(
+	uint64_t aggregate_cache_size
+) {
+	config.aggregate_cache_size = aggregate_cache_size;
+}
+
+static uint64_t Config_aggregate_cache_size_get(void) {
+	return config.aggregate_cache_size;
+}
+
+//------------------------------------------------------------------------------
+// result-set stream window
+//------------------------------------------------------------------------------
+
+static void Config_resultset_stream_window_set
+(
+	uint64_t window
+) {
+	config.resultset_stream_window = window;
+}
+
+static uint64_t Config_resultset_stream_window_get(void) {
+	return config.resultset_stream_window;
+}
+
+//------------------------------------------------------------------------------
+// profile hardware counters
+//------------------------------------------------------------------------------
+
+static void Config_profile_hw_counters_set
+(
+	bool collect
+) {
+	config.profile_hw_counters = collect;
+}
+
+static bool Config_profile_hw_counters_get(void) {
+	return config.profile_hw_counters;
+}
+
+//------------------------------------------------------------------------------
+// intern strings
+//------------------------------------------------------------------------------
+
+static void Config_intern_strings_set
+(
+	bool intern
+) {
+	config.intern_strings = intern;
+}
+
+static bool Config_intern_strings_get(void) {
+	return config.intern_strings;
+}
+
+//------------------------------------------------------------------------------
+// trigram index
+//------------------------------------------------------------------------------
+
+static void Config_trigram_index_set
+(
+	bool trigrams
+) {
+	config.trigram_index = trigrams;
+}
+
+static bool Config_trigram_index_get(void) {
+	return config.trigram_index;
+}
+
+//------------------------------------------------------------------------------
+// compaction interval
+//------------------------------------------------------------------------------
+
+static void Config_compaction_interval_set
+(
+	uint64_t interval
+) {
+	config.compaction_interval = interval;
+}
+
+static uint64_t Config_compaction_interval_get(void) {
+	return config.compaction_interval;
+}
+
+//------------------------------------------------------------------------------
+// compaction min deleted
+//------------------------------------------------------------------------------
+
+static void Config_compaction_min_deleted_set
+(
+	uint64_t min_deleted
+) {
+	config.compaction_min_deleted = min_deleted;
+}
+
+static uint64_t Config_compaction_min_deleted_get(void) {
+	return config.compaction_min_deleted;
+}
+
+//------------------------------------------------------------------------------
+// compaction deleted ratio
+//------------------------------------------------------------------------------
+
+static void Config_compaction_deleted_ratio_set
+(
+	uint64_t ratio
+) {
+	config.compaction_deleted_ratio = ratio;
+}
+
+static uint64_t Config_compaction_deleted_ratio_get(void) {
+	return config.compaction_deleted_ratio;
+}
+
 bool Config_Contains_field
 (
 	const char *field_str,
@@ -477,6 +707,30 @@ bool Config_Contains_field
 		f = Config_CMD_INFO_MAX_QUERY_COUNT;
 	} else if (!(strcasecmp(field_str, EFFECTS_THRESHOLD))) {
 		f = Config_EFFECTS_THRESHOLD;
+	} else if (!(strcasecmp(field_str, MAX_QUERY_PARALLELISM))) {
+		f = Config_MAX_QUERY_PARALLELISM;
+	} else if (!(strcasecmp(field_str, SHARED_CACHE_SIZE))) {
+		f = Config_SHARED_CACHE_SIZE;
+	} else if (!(strcasecmp(field_str, WRITER_THREAD_COUNT))) {
+		f = Config_WRITER_THREAD_COUNT;
+	} else if (!(strcasecmp(field_str, MAX_WRITE_BATCH))) {
+		f = Config_MAX_WRITE_BATCH;
+	} else if (!(strcasecmp(field_str, AGGREGATE_CACHE_SIZE))) {
+		f = Config_AGGREGATE_CACHE_SIZE;
+	} else if (!(strcasecmp(field_str, RESULTSET_STREAM_WINDOW))) {
+		f = Config_RESULTSET_STREAM_WINDOW;
+	} else if (!(strcasecmp(field_str, PROFILE_HW_COUNTERS))) {
+		f = Config_PROFILE_HW_COUNTERS;
+	} else if (!(strcasecmp(field_str, INTERN_STRINGS))) {
+		f = Config_INTERN_STRINGS;
+	} else if (!(strcasecmp(field_str, TRIGRAM_INDEX))) {
+		f = Config_TRIGRAM_INDEX;
+	} else if (!(strcasecmp(field_str, COMPACTION_INTERVAL))) {
+		f = Config_COMPACTION_INTERVAL;
+	} else if (!(strcasecmp(field_str, COMPACTION_MIN_DELETED))) {
+		f = Config_COMPACTION_MIN_DELETED;
+	} else if (!(strcasecmp(field_str, COMPACTION_DELETED_RATIO))) {
+		f = Config_COMPACTION_DELETED_RATIO;
 	} else {
 		return false;
 	}
@@ -555,6 +809,54 @@ const char *Config_Field_name
 			name = EFFECTS_THRESHOLD;
 			break;
 
+		case Config_MAX_QUERY_PARALLELISM:
+			name = MAX_QUERY_PARALLELISM;
+			break;
+
+		case Config_SHARED_CACHE_SIZE:
+			name = SHARED_CACHE_SIZE;
+			break;
+
+		case Config_WRITER_THREAD_COUNT:
+			name = WRITER_THREAD_COUNT;
+			break;
+
+		case Config_MAX_WRITE_BATCH:
+			name = MAX_WRITE_BATCH;
+			break;
+
+		case Config_AGGREGATE_CACHE_SIZE:
+			name = AGGREGATE_CACHE_SIZE;
+			break;
+
+		case Config_RESULTSET_STREAM_WINDOW:
+			name = RESULTSET_STREAM_WINDOW;
+			break;
+
+		case Config_PROFILE_HW_COUNTERS:
+			name = PROFILE_HW_COUNTERS;
+			break;
+
+		case Config_INTERN_STRINGS:
+			name = INTERN_STRINGS;
+			break;
+
+		case Config_TRIGRAM_INDEX:
+			name = TRIGRAM_INDEX;
+			break;
+
+		case Config_COMPACTION_INTERVAL:
+			name = COMPACTION_INTERVAL;
+			break;
+
+		case Config_COMPACTION_MIN_DELETED:
+			name = COMPACTION_MIN_DELETED;
+			break;
+
+		case Config_COMPACTION_DELETED_RATIO:
+			name = COMPACTION_DELETED_RATIO;
+			break;
+
 		//----------------------------------------------------------------------
 		// invalid option
 		//----------------------------------------------------------------------
@@ -622,6 +924,38 @@ static void _Config_SetToDefaults(void) {
 
 	// replicate effects if avg change time μs > effects_threshold μs
 	config.effects_threshold = 300 ;
+
+	// queries are executed by a single thread by default
+	config.max_query_parallelism = MAX_QUERY_PARALLELISM_DEFAULT;
+
+	// execution plans aren't shared between graphs by default
+	config.shared_cache_size = SHARED_CACHE_SIZE_DEFAULT;
+
+	// write queries are executed by a single thread by default
+	config.writer_thread_count = WRITER_THREAD_COUNT_DEFAULT;
+
+	// each write is committed on its own by default
+	config.max_write_batch = MAX_WRITE_BATCH_DEFAULT;
+
+	// attributes aren't stored as columns by default
+	config.aggregate_cache_size = AGGREGATE_CACHE_SIZE_DEFAULT;
+
+	// read queries stream their result-set
+	config.resultset_stream_window = RESULTSET_STREAM_WINDOW_DEFAULT;
+
+	// profiling doesn't collect hardware counters by default
+	config.profile_hw_counters = PROFILE_HW_COUNTERS_DEFAULT;
+
+	// string attributes aren't interned by default
+	config.intern_strings = INTERN_STRINGS_DEFAULT;
+
+	// exact-match indexes don't maintain trigram postings by default
+	config.trigram_index = TRIGRAM_INDEX_DEFAULT;
+
+	// graphs are compacted once enough entities were deleted
+	config.compaction_interval      = COMPACTION_INTERVAL_DEFAULT;
+	config.compaction_min_deleted   = COMPACTION_MIN_DELETED_DEFAULT;
+	config.compaction_deleted_ratio = COMPACTION_DELETED_RATIO_DEFAULT;
 }
 
 int Config_Init
@@ -930,6 +1264,174 @@ bool Config_Option_get
 		}
 		break;
 
+		//----------------------------------------------------------------------
+		// max query parallelism
+		//----------------------------------------------------------------------
+
+		case Config_MAX_QUERY_PARALLELISM: {
+			va_start(ap, field);
+			uint *dop = va_arg(ap, uint *);
+			va_end(ap);
+
+			ASSERT(dop != NULL);
+			(*dop) = Config_max_query_parallelism_get();
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// shared cache size
+		//----------------------------------------------------------------------
+
+		case Config_SHARED_CACHE_SIZE: {
+			va_start(ap, field);
+			uint64_t *shared_cache_size = va_arg(ap, uint64_t *);
+			va_end(ap);
+
+			ASSERT(shared_cache_size != NULL);
+			(*shared_cache_size) = Config_shared_cache_size_get();
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// writer thread count
+		//----------------------------------------------------------------------
+
+		case Config_WRITER_THREAD_COUNT: {
+			va_start(ap, field);
+			uint *writer_nthreads = va_arg(ap, uint *);
+			va_end(ap);
+
+			ASSERT(writer_nthreads != NULL);
+			(*writer_nthreads) = Config_writer_thread_count_get();
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// max write batch
+		//----------------------------------------------------------------------
+
+		case Config_MAX_WRITE_BATCH: {
+			va_start(ap, field);
+			uint *max_write_batch = va_arg(ap, uint *);
+			va_end(ap);
+
+			ASSERT(max_write_batch != NULL);
+			(*max_write_batch) = Config_max_write_batch_get();
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// aggregate cache size
+		//----------------------------------------------------------------------
+
+		case Config_AGGREGATE_CACHE_SIZE: {
+			va_start(ap, field);
+			uint64_t *aggregate_cache_size = va_arg(ap, uint64_t *);
+			va_end(ap);
+
+			ASSERT(aggregate_cache_size != NULL);
+			(*aggregate_cache_size) = Config_aggregate_cache_size_get();
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// result-set stream window
+		//----------------------------------------------------------------------
+
+		case Config_RESULTSET_STREAM_WINDOW: {
+			va_start(ap, field);
+			uint64_t *window = va_arg(ap, uint64_t *);
+			va_end(ap);
+
+			ASSERT(window != NULL);
+			(*window) = Config_resultset_stream_window_get();
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// profile hardware counters
+		//----------------------------------------------------------------------
+
+		case Config_PROFILE_HW_COUNTERS: {
+			va_start(ap, field);
+			bool *collect = va_arg(ap, bool *);
+			va_end(ap);
+
+			ASSERT(collect != NULL);
+			(*collect) = Config_profile_hw_counters_get();
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// intern strings
+		//----------------------------------------------------------------------
+
+		case Config_INTERN_STRINGS: {
+			va_start(ap, field);
+			bool *intern = va_arg(ap, bool *);
+			va_end(ap);
+
+			ASSERT(intern != NULL);
+			(*intern) = Config_intern_strings_get();
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// trigram index
+		//----------------------------------------------------------------------
+
+		case Config_TRIGRAM_INDEX: {
+			va_start(ap, field);
+			bool *trigrams = va_arg(ap, bool *);
+			va_end(ap);
+
+			ASSERT(trigrams != NULL);
+			(*trigrams) = Config_trigram_index_get();
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// compaction interval
+		//----------------------------------------------------------------------
+
+		case Config_COMPACTION_INTERVAL: {
+			va_start(ap, field);
+			uint64_t *interval = va_arg(ap, uint64_t *);
+			va_end(ap);
+
+			ASSERT(interval != NULL);
+			(*interval) = Config_compaction_interval_get();
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// compaction min deleted
+		//----------------------------------------------------------------------
+
+		case Config_COMPACTION_MIN_DELETED: {
+			va_start(ap, field);
+			uint64_t *min_deleted = va_arg(ap, uint64_t *);
+			va_end(ap);
+
+			ASSERT(min_deleted != NULL);
+			(*min_deleted) = Config_compaction_min_deleted_get();
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// compaction deleted ratio
+		//----------------------------------------------------------------------
+
+		case Config_COMPACTION_DELETED_RATIO: {
+			va_start(ap, field);
+			uint64_t *ratio = va_arg(ap, uint64_t *);
+			va_end(ap);
+
+			ASSERT(ratio != NULL);
+			(*ratio) = Config_compaction_deleted_ratio_get();
+		}
+		break;
+
 		//----------------------------------------------------------------------
 		// invalid option
 		//----------------------------------------------------------------------
@@ -1169,6 +1671,164 @@ bool Config_Option_set
 		}
 		break;
 
+		//----------------------------------------------------------------------
+		// max query parallelism
+		//----------------------------------------------------------------------
+
+		case Config_MAX_QUERY_PARALLELISM: {
+			long long dop;
+			if(!_Config_ParseNonNegativeInteger(val, &dop)) return false;
+			Config_max_query_parallelism_set(dop);
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// shared cache size
+		//----------------------------------------------------------------------
+
+		case Config_SHARED_CACHE_SIZE: {
+			long long shared_cache_size;
+			if(!_Config_ParseNonNegativeInteger(val, &shared_cache_size)) {
+				return false;
+			}
+			Config_shared_cache_size_set(shared_cache_size);
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// writer thread count
+		//----------------------------------------------------------------------
+
+		case Config_WRITER_THREAD_COUNT: {
+			long long writer_nthreads;
+			if(!_Config_ParsePositiveInteger(val, &writer_nthreads)) {
+				return false;
+			}
+			Config_writer_thread_count_set(writer_nthreads);
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// max write batch
+		//----------------------------------------------------------------------
+
+		case Config_MAX_WRITE_BATCH: {
+			long long max_write_batch;
+			if(!_Config_ParsePositiveInteger(val, &max_write_batch)) {
+				return false;
+			}
+			Config_max_write_batch_set(max_write_batch);
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// aggregate cache size
+		//----------------------------------------------------------------------
+
+		case Config_AGGREGATE_CACHE_SIZE: {
+			long long aggregate_cache_size;
+			if(!_Config_ParseNonNegativeInteger(val, &aggregate_cache_size)) {
+				return false;
+			}
+			Config_aggregate_cache_size_set(aggregate_cache_size);
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// result-set stream window
+		//----------------------------------------------------------------------
+
+		case Config_RESULTSET_STREAM_WINDOW: {
+			long long window;
+			if(!_Config_ParseNonNegativeInteger(val, &window)) {
+				return false;
+			}
+			Config_resultset_stream_window_set(window);
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// profile hardware counters
+		//----------------------------------------------------------------------
+
+		case Config_PROFILE_HW_COUNTERS: {
+			bool collect = false;
+			if(!_Config_ParseYesNo(val, &collect)) {
+				return false;
+			}
+			Config_profile_hw_counters_set(collect);
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// intern strings
+		//----------------------------------------------------------------------
+
+		case Config_INTERN_STRINGS: {
+			bool intern = false;
+			if(!_Config_ParseYesNo(val, &intern)) {
+				return false;
+			}
+			Config_intern_strings_set(intern);
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// trigram index
+		//----------------------------------------------------------------------
+
+		case Config_TRIGRAM_INDEX: {
+			bool trigrams = false;
+			if(!_Config_ParseYesNo(val, &trigrams)) {
+				return false;
+			}
+			Config_trigram_index_set(trigrams);
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// compaction interval
+		//----------------------------------------------------------------------
+
+		case Config_COMPACTION_INTERVAL: {
+			long long interval;
+			if(!_Config_ParseNonNegativeInteger(val, &interval)) {
+				return false;
+			}
+			Config_compaction_interval_set(interval);
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// compaction min deleted
+		//----------------------------------------------------------------------
+
+		case Config_COMPACTION_MIN_DELETED: {
+			long long min_deleted;
+			if(!_Config_ParseNonNegativeInteger(val, &min_deleted)) {
+				return false;
+			}
+			Config_compaction_min_deleted_set(min_deleted);
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// compaction deleted ratio
+		//----------------------------------------------------------------------
+
+		case Config_COMPACTION_DELETED_RATIO: {
+			long long ratio;
+			if(!_Config_ParseNonNegativeInteger(val, &ratio)) {
+				return false;
+			}
+			if(ratio > 100) {
+				if(err) *err = "COMPACTION_DELETED_RATIO must be a percentage between 0 and 100";
+				return false;
+			}
+			Config_compaction_deleted_ratio_set(ratio);
+		}
+		break;
+
 		//----------------------------------------------------------------------
 		// invalid option
 		//----------------------------------------------------------------------
@@ -15,6 +15,18 @@
 #define QUERY_MEM_CAPACITY_UNLIMITED       0
 #define NODE_CREATION_BUFFER_DEFAULT       16384
 #define DELTA_MAX_PENDING_CHANGES_DEFAULT  10000
+#define MAX_QUERY_PARALLELISM_DEFAULT      1
+#define SHARED_CACHE_SIZE_DEFAULT          0
+#define WRITER_THREAD_COUNT_DEFAULT        1
+#define MAX_WRITE_BATCH_DEFAULT            1
+#define AGGREGATE_CACHE_SIZE_DEFAULT       0
+#define RESULTSET_STREAM_WINDOW_DEFAULT    0
+#define PROFILE_HW_COUNTERS_DEFAULT        false
+#define INTERN_STRINGS_DEFAULT             false
+#define TRIGRAM_INDEX_DEFAULT              false
+#define COMPACTION_INTERVAL_DEFAULT        5000
+#define COMPACTION_MIN_DELETED_DEFAULT     16384
+#define COMPACTION_DELETED_RATIO_DEFAULT   10
 
 typedef enum {
 	Config_TIMEOUT                   = 0,   // timeout value for queries
@@ -33,7 +45,19 @@ typedef enum {
 	Config_CMD_INFO                  = 13,  // toggle on/off the GRAPH.INFO
 	Config_CMD_INFO_MAX_QUERY_COUNT  = 14,  // the max number of info queries count
 	Config_EFFECTS_THRESHOLD         = 15,  // replicate queries via effects
-	Config_END_MARKER                = 16
+	Config_MAX_QUERY_PARALLELISM     = 16,  // max number of threads a single query can utilize
+	Config_SHARED_CACHE_SIZE         = 17,  // number of entries in the cache shared by all graphs
+	Config_WRITER_THREAD_COUNT       = 18,  // number of threads executing write queries
+	Config_MAX_WRITE_BATCH           = 19,  // max number of queued writes committed together
+	Config_AGGREGATE_CACHE_SIZE      = 20,  // max number of attribute summaries held per graph
+	Config_RESULTSET_STREAM_WINDOW   = 21,  // number of rows serialized at a time, 0 disables
+	Config_PROFILE_HW_COUNTERS       = 22,  // collect hardware counters when profiling
+	Config_INTERN_STRINGS            = 23,  // share storage of equal string attributes
+	Config_TRIGRAM_INDEX             = 24,  // maintain trigram postings in exact-match indexes
+	Config_COMPACTION_INTERVAL       = 25,  // ms between compaction checks, 0 disables
+	Config_COMPACTION_MIN_DELETED    = 26,  // deleted entities triggering a compaction
+	Config_COMPACTION_DELETED_RATIO  = 27,  // percentage of deleted entities triggering a compaction
+	Config_END_MARKER                = 28
 } Config_Option_Field;
 
 // callback function, invoked once configuration changes as a result of
@@ -53,7 +77,17 @@ static const Config_Option_Field RUNTIME_CONFIGS[] = {
 	Config_DELTA_MAX_PENDING_CHANGES,
 	Config_CMD_INFO,
 	Config_CMD_INFO_MAX_QUERY_COUNT,
-	Config_EFFECTS_THRESHOLD
+	Config_EFFECTS_THRESHOLD,
+	Config_MAX_QUERY_PARALLELISM,
+	Config_MAX_WRITE_BATCH,
+	Config_AGGREGATE_CACHE_SIZE,
+	Config_RESULTSET_STREAM_WINDOW,
+	Config_PROFILE_HW_COUNTERS,
+	Config_INTERN_STRINGS,
+	Config_TRIGRAM_INDEX,
+	Config_COMPACTION_INTERVAL,
+	Config_COMPACTION_MIN_DELETED,
+	Config_COMPACTION_DELETED_RATIO
 };
 static const size_t RUNTIME_CONFIG_COUNT = sizeof(RUNTIME_CONFIGS) / sizeof(RUNTIME_CONFIGS[0]);
 
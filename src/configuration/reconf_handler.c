@@ -51,6 +51,18 @@ void reconf_handler(Config_Option_Field type) {
 			}
 			break;
 
+		//----------------------------------------------------------------------
+		// compaction interval
+		//----------------------------------------------------------------------
+
+		case Config_COMPACTION_INTERVAL:
+			{
+				// resume compaction if it was disabled
+				// the task picks up the new interval once it's re-scheduled
+				CronTask_AddCompaction();
+			}
+			break;
+
         //----------------------------------------------------------------------
         // all other options
         //----------------------------------------------------------------------
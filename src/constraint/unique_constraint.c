@@ -8,8 +8,6 @@
 #include "constraint.h"
 #include "../query_ctx.h"
 #include "../index/index.h"
-#include "redisearch_api.h"
-#include "../src/datatypes/point.h"
 #include "../graph/entities/attribute_set.h"
 
 #include <stdatomic.h>
@@ -76,124 +74,72 @@ bool EnforceUniqueEntity
 
 	UniqueConstraint _c = (UniqueConstraint)c;
 
-	Index   idx     = _c->idx;
-	bool    holds   = false;  // return value none-optimistic
-	RSIndex *rs_idx = Index_RSIndex(idx);
-
-	//--------------------------------------------------------------------------
-	// construct a RediSearch query locating entity
-	//--------------------------------------------------------------------------
-
-	// TODO: prefer to have the RediSearch query "template" constructed
-	// once and reused for each entity
-
-	SIType t;
-	SIValue *v;
-	uint8_t i     = 0;
-	RSQNode *node = NULL;  // RediSearch query node
-	RSQNode *root = NULL;  // root of RediSearch query tree
-	RSQNode *nodes[_c->n_attr];
-	RSResultsIterator *iter = NULL;
+	Index      idx   = _c->idx;
+	bool       holds = true;   // return value
+	EntityID   id    = ENTITY_GET_ID(e);
+	RangeIndex *ri   = Index_RangeIndex(idx);
 	const AttributeSet attributes = GraphEntity_GetAttributes(e);
 
 	//--------------------------------------------------------------------------
-	// create a RediSearch query
+	// collect enforced values
 	//--------------------------------------------------------------------------
 
-	for(i = 0; i < _c->n_attr; i++) {
-		Attribute_ID attr_id = _c->attrs[i];
-		const char *field = _c->attr_names[i];
-
+	SIValue values[_c->n_attr];
+	for(uint8_t i = 0; i < _c->n_attr; i++) {
 		// get current attribute from entity
-		v = AttributeSet_Get(attributes, attr_id);
+		SIValue *v = AttributeSet_Get(attributes, _c->attrs[i]);
 		if(v == ATTRIBUTE_NOTFOUND) {
 			// entity satisfies constraint in a vacuous truth manner
-			holds = true;
-			goto cleanup;
+			return true;
 		}
 
-		// create RediSearch query node according to entity attr type
-		t = SI_TYPE(*v);
-
-		if(!(t & SI_INDEXABLE)) {
-			// TODO: see RediSearch MULTI-VALUE index.
-			holds = true;
-			goto cleanup;
-		} else if(t == T_STRING) {
-			node = RediSearch_CreateTagNode(rs_idx, field);
-			RSQNode *child = RediSearch_CreateTagTokenNode(rs_idx, v->stringval);
-			RediSearch_QueryNodeAddChild(node, child);
-		} else if(t & (SI_NUMERIC | T_BOOL)) {
-			double d = SI_GET_NUMERIC((*v));
-			node = RediSearch_CreateNumericNode(rs_idx, field, d, d, true, true);
-		} else {
-			// ASSERT(t == T_POINT);
-			// double lat = (double)Point_lat(*v);
-			// double lon = (double)Point_lon(*v);
-			// node = RediSearch_CreateGeoNode(rs_idx, field, lat, lon, 0, RS_GEO_DISTANCE_M);
-			// TODO: RediSearch exact match for point.
-			holds = true;
-			goto cleanup;
+		// only strings, numerics and booleans are enforced
+		RangeKeyClass cls = RangeKey_Class(*v);
+		if(cls != RANGE_KEY_STRING  &&
+		   cls != RANGE_KEY_NUMERIC &&
+		   cls != RANGE_KEY_BOOL) {
+			return true;
 		}
 
-		ASSERT(node != NULL);
-		nodes[i] = node;
+		values[i] = *v;
 	}
 
 	//--------------------------------------------------------------------------
-	// cancat filters
+	// query index
 	//--------------------------------------------------------------------------
 
-	root = node;
-	if(_c->n_attr > 1) {
-		// intersection query node
-		root = RediSearch_CreateIntersectNode(rs_idx, false);
-		for(uint8_t i = 0; i < _c->n_attr; i++) {
-			RediSearch_QueryNodeAddChild(root, nodes[i]);
-		}
+	// locate entities sharing the first attribute's value
+	// a staging index can only be scanned entirely
+	RangeQuery *q = RangeQuery_New();
+	if(RangeIndex_Staging(ri)) {
+		q->all = true;
+	} else {
+		RangeIndexRange range = {
+			.attr        = _c->attrs[0],
+			.cls         = RangeKey_Class(values[0]),
+			.min         = SI_CloneValue(values[0]),
+			.max         = SI_CloneValue(values[0]),
+			.include_min = true,
+			.include_max = true
+		};
+		RangeQuery_AddRange(q, &range);
 	}
 
-	//--------------------------------------------------------------------------
-	// query RediSearch index
-	//--------------------------------------------------------------------------
-
-	// constraint holds if there are no duplicates, a single index match
-	iter = RediSearch_GetResultsIterator(root, rs_idx);
-	if(Constraint_GetEntityType(c) == GETYPE_NODE) {
-		// first call, expecting to find 'e' in the index
-		const EntityID *id =
-			(EntityID*)RediSearch_ResultsIteratorNext(iter, rs_idx, NULL);
-
-		ASSERT(id != NULL);
+	// constraint holds if no other entity shares all enforced values
+	EntityID other;
+	RangeIndexIterator *iter = RangeIndex_Query(ri, q);
+	while(holds && RangeIndexIterator_Next(iter, &other, NULL, NULL)) {
+		if(other == id) continue;
 
-		if(*id != ENTITY_GET_ID(e)) {
-			holds = false;
-			goto cleanup;
+		bool duplicate = true;
+		for(uint8_t i = 0; i < _c->n_attr && duplicate; i++) {
+			duplicate = RangeIndex_HasValue(ri, other, _c->attrs[i], values[i]);
 		}
-	} else {
-		// first call, expecting to find 'e' in the index
-		const EdgeIndexKey *id =
-			(EdgeIndexKey*)RediSearch_ResultsIteratorNext(iter, rs_idx, NULL);
-
-		ASSERT(id != NULL);
 
-		if(id->edge_id != ENTITY_GET_ID(e)) {
-			holds = false;
-			goto cleanup;
-		}
+		holds = !duplicate;
 	}
 
-	// second call, holds if no value is returned
-	holds = RediSearch_ResultsIteratorNext(iter, rs_idx, NULL) == NULL;
-
-cleanup:
-	if(iter != NULL) {
-		RediSearch_ResultsIteratorFree(iter);
-	} else {
-		for(uint8_t j = 0; j < i; j++) {
-			RediSearch_QueryNodeFree(nodes[j]);
-		}
-	}
+	RangeIndexIterator_Free(iter);
 
 	if(holds == false && err_msg != NULL) {
 		int res;
@@ -33,6 +33,12 @@ void Cron_AddRecurringTasks(void);
 // add stream finished queries task
 void CronTask_AddStreamFinishedQueries();
 
+// add statistics refresh task
+void CronTask_AddRefreshStatistics();
+
+// add memory compaction task
+void CronTask_AddCompaction();
+
 // create a new CRON task
 CronTaskHandle Cron_AddTask
 (
@@ -8,6 +8,8 @@
 #include "cron.h"
 #include "util/rmalloc.h"
 #include "configuration/config.h"
+#include "tasks/compact_graphs.h"
+#include "tasks/refresh_statistics.h"
 #include "tasks/stream_finished_queries.h"
 
 typedef struct RecurringTaskCtx {
@@ -80,8 +82,23 @@ void CronTask_AddStreamFinishedQueries() {
 	}
 }
 
+void CronTask_AddRefreshStatistics() {
+	// add statistics refresh task
+	// the task re-schedules itself
+	Cron_AddTask(STATISTICS_REFRESH_INTERVAL, CronTask_refreshStatistics, NULL,
+			NULL);
+}
+
+void CronTask_AddCompaction() {
+	// add memory compaction task, unless compaction is disabled
+	// the task re-schedules itself while compaction is enabled
+	CronTask_scheduleCompaction();
+}
+
 // add recurring tasks
 void Cron_AddRecurringTasks(void) {
 	CronTask_AddStreamFinishedQueries();
+	CronTask_AddRefreshStatistics();
+	CronTask_AddCompaction();
 }
 
@@ -0,0 +1,185 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "globals.h"
+#include "cron/cron.h"
+#include "compact_graphs.h"
+#include "commands/commands.h"
+#include "util/thpool/pools.h"
+#include "graph/graphcontext.h"
+#include "configuration/config.h"
+
+// number of deleted nodes and edges
+static uint64_t _DeletedCount
+(
+	const Graph *g
+) {
+	return DataBlock_DeletedItemsCount(g->nodes) +
+		DataBlock_DeletedItemsCount(g->edges);
+}
+
+// set while the compaction cron task is scheduled
+static bool _scheduled = false;
+
+// returns the interval between compaction checks, 0 if compaction is disabled
+static uint64_t _CompactionInterval(void) {
+	uint64_t interval;
+	bool res = Config_Option_get(Config_COMPACTION_INTERVAL, &interval);
+	ASSERT(res);
+	UNUSED(res);
+
+	return interval;
+}
+
+// returns true if compaction should give way to other writer tasks
+static bool _ShouldYield
+(
+	GraphContext *gc  // graph context
+) {
+	return ThreadPools_WriterQueueLength() > 0 ||
+		GraphContext_WritesPending(gc);
+}
+
+// compact graph's memory
+// executed by a writer thread while holding the graph's writer slot
+// such that no write query reserves entity IDs while compacting
+// the graph's write lock is held for a single step at a time
+// compaction doesn't alter the graph's content, as such the GIL isn't
+// required and data derived from the graph remains valid
+// at most COMPACTION_STEPS steps are performed by a single invocation
+// compaction is interrupted as soon as writer tasks are queued
+// in which case the task is re-queued behind them
+static void _compactGraph
+(
+	void *pdata  // graph context
+) {
+	GraphContext *gc = (GraphContext *)pdata;
+	Graph *g = gc->g;
+
+	// compaction was disabled, or a writer is active
+	// an interrupted compaction is resumed on a later check
+	if(_CompactionInterval() == 0 || !GraphContext_TryPauseWrites(gc)) {
+		goto cleanup;
+	}
+
+	GraphCompaction *ctx = &gc->compaction;
+
+	bool done = false;
+	for(int i = 0; i < COMPACTION_STEPS && !done && !_ShouldYield(gc); i++) {
+		Graph_AcquireMaintenanceLock(g);
+
+		// matrices are flushed explicitly
+		MATRIX_POLICY policy = Graph_SetMatrixPolicy(g, SYNC_POLICY_NOP);
+		done = !Graph_CompactStep(g, ctx);
+		Graph_SetMatrixPolicy(g, policy);
+
+		if(done) {
+			gc->compacted_deleted = _DeletedCount(g);
+		}
+
+		Graph_ReleaseLock(g);
+	}
+
+	if(done) {
+		__atomic_add_fetch(&gc->compaction_runs, 1, __ATOMIC_RELAXED);
+		__atomic_add_fetch(&gc->reclaimed_bytes, ctx->reclaimed,
+				__ATOMIC_RELAXED);
+		__atomic_add_fetch(&gc->repacked_sets, ctx->repacked,
+				__ATOMIC_RELAXED);
+		*ctx = (GraphCompaction){0};
+	}
+
+	// hand the writer slot over to queued writes
+	if(GraphContext_ResumeWrites(gc)) Graph_ScheduleWrites(gc);
+
+	// continue compacting once queued writer tasks are done
+	// the compacting thread keeps its graph context reference
+	if(!done && ThreadPools_AddWorkWriter(_compactGraph, gc, 0) == 0) return;
+
+cleanup:
+	__atomic_store_n(&gc->compacting, false, __ATOMIC_RELEASE);
+	GraphContext_DecreaseRefCount(gc);
+}
+
+// returns true if graph accumulated enough deletions since its last compaction
+// a threshold set to 0 doesn't trigger compactions
+static bool _ShouldCompact
+(
+	const GraphContext *gc
+) {
+	const Graph *g = gc->g;
+
+	// an interrupted compaction is resumed
+	if(gc->compaction.stage != COMPACTION_BLOCKS) return true;
+
+	uint64_t deleted = _DeletedCount(g);
+	if(deleted <= gc->compacted_deleted) return false;
+
+	uint64_t min_deleted;
+	uint64_t deleted_ratio;
+	Config_Option_get(Config_COMPACTION_MIN_DELETED, &min_deleted);
+	Config_Option_get(Config_COMPACTION_DELETED_RATIO, &deleted_ratio);
+
+	uint64_t delta = deleted - gc->compacted_deleted;
+	uint64_t total = DataBlock_ItemCount(g->nodes) +
+		DataBlock_ItemCount(g->edges) + deleted;
+
+	return (min_deleted > 0 && delta >= min_deleted) ||
+		(deleted_ratio > 0 && delta * 100 >= total * deleted_ratio);
+}
+
+void CronTask_scheduleCompaction(void) {
+	uint64_t interval = _CompactionInterval();
+	if(interval == 0) return;
+
+	// a single instance of the task is scheduled at any given time
+	if(__atomic_exchange_n(&_scheduled, true, __ATOMIC_ACQ_REL)) return;
+
+	Cron_AddTask(interval, CronTask_compactGraphs, NULL, NULL);
+}
+
+void CronTask_compactGraphs
+(
+	void *pdata  // task context, unused
+) {
+	// task is no longer scheduled
+	__atomic_store_n(&_scheduled, false, __ATOMIC_RELEASE);
+
+	// compaction was disabled
+	if(_CompactionInterval() == 0) return;
+
+	KeySpaceGraphIterator it;
+	Globals_ScanGraphs(&it);
+
+	GraphContext *gc = NULL;
+	while((gc = GraphIterator_Next(&it)) != NULL) {
+		// skip graphs which are being decoded
+		if(!GraphDecodeContext_Finished(gc->decoding_context)) {
+			GraphContext_DecreaseRefCount(gc);
+			continue;
+		}
+
+		// a quick, lock free, check to see if graph should be compacted
+		// deleted counts might be slightly off at this point
+		// skip graph if a compaction is already in progress
+		if(!_ShouldCompact(gc) ||
+		   __atomic_exchange_n(&gc->compacting, true, __ATOMIC_ACQUIRE)) {
+			GraphContext_DecreaseRefCount(gc);
+			continue;
+		}
+
+		// graph context reference is released by the compacting thread
+		if(ThreadPools_AddWorkWriter(_compactGraph, gc, 0) != 0) {
+			// writer queue is full, retry on next invocation
+			__atomic_store_n(&gc->compacting, false, __ATOMIC_RELEASE);
+			GraphContext_DecreaseRefCount(gc);
+		}
+	}
+
+	// re-schedule
+	CronTask_scheduleCompaction();
+}
@@ -0,0 +1,23 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+// number of compaction steps performed by a single writer task
+// once performed, the task is re-queued behind pending writer tasks
+#define COMPACTION_STEPS 8
+
+// schedule the compaction cron task
+// no-op if compaction is disabled or the task is already scheduled
+void CronTask_scheduleCompaction(void);
+
+// cron task
+// schedule a memory compaction for each graph in the keyspace
+// which accumulated deleted entities since its last compaction
+void CronTask_compactGraphs
+(
+	void *pdata  // task context, unused
+);
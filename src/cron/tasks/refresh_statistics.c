@@ -0,0 +1,84 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "globals.h"
+#include "cron/cron.h"
+#include "util/thpool/pools.h"
+#include "util/cache/cache.h"
+#include "graph/graphcontext.h"
+#include "refresh_statistics.h"
+#include "statistics/statistics.h"
+
+// collect graph statistics
+// executed by a reader thread
+static void _collectStatistics
+(
+	void *pdata  // graph context
+) {
+	GraphContext *gc = (GraphContext *)pdata;
+	Graph *g = gc->g;
+
+	Graph_AcquireReadLock(g);
+
+	// re-validate now that the graph can't change
+	Statistics *current = GraphContext_GetStatistics(gc);
+	if(Statistics_Stale(current, g)) {
+		GraphContext_SetStatistics(gc, Statistics_Collect(gc));
+		// cached plans were built using outdated statistics
+		Cache_Clear(gc->cache);
+	}
+
+	Graph_ReleaseLock(g);
+
+	if(current != NULL) Statistics_Free(current);
+
+	__atomic_store_n(&gc->stats_refresh, false, __ATOMIC_RELEASE);
+	GraphContext_DecreaseRefCount(gc);
+}
+
+void CronTask_refreshStatistics
+(
+	void *pdata  // task context, unused
+) {
+	KeySpaceGraphIterator it;
+	Globals_ScanGraphs(&it);
+
+	GraphContext *gc = NULL;
+	while((gc = GraphIterator_Next(&it)) != NULL) {
+		// skip graphs which are being decoded
+		if(!GraphDecodeContext_Finished(gc->decoding_context)) {
+			GraphContext_DecreaseRefCount(gc);
+			continue;
+		}
+
+		// a quick, lock free, check to see if statistics need a refresh
+		// node and edge counts might be slightly off at this point
+		Statistics *s = GraphContext_GetStatistics(gc);
+		bool stale = Statistics_Stale(s, gc->g);
+		if(s != NULL) Statistics_Free(s);
+
+		// skip graph if its statistics are fresh
+		// or if a refresh is already in progress
+		if(!stale ||
+		   __atomic_exchange_n(&gc->stats_refresh, true, __ATOMIC_ACQUIRE)) {
+			GraphContext_DecreaseRefCount(gc);
+			continue;
+		}
+
+		// graph context reference is released by the collecting thread
+		if(ThreadPools_AddWorkReader(_collectStatistics, gc, false) != 0) {
+			// reader queue is full, retry on next invocation
+			__atomic_store_n(&gc->stats_refresh, false, __ATOMIC_RELEASE);
+			GraphContext_DecreaseRefCount(gc);
+		}
+	}
+
+	// re-schedule
+	Cron_AddTask(STATISTICS_REFRESH_INTERVAL, CronTask_refreshStatistics, NULL,
+			NULL);
+}
+
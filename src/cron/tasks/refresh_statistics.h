@@ -0,0 +1,21 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include <stdbool.h>
+
+// interval between consecutive statistics refresh checks (ms)
+#define STATISTICS_REFRESH_INTERVAL 1000
+
+// cron task
+// schedule a statistics refresh for each graph in the keyspace
+// whose statistics became stale
+void CronTask_refreshStatistics
+(
+	void *pdata  // task context, unused
+);
+
@@ -11,6 +11,8 @@
 #include "../query_ctx.h"
 #include "../util/rmalloc.h"
 #include "../errors/errors.h"
+#include "../util/thread_profile.h"
+#include "../configuration/config.h"
 #include "./optimizations/optimizer.h"
 #include "../ast/ast_build_filter_tree.h"
 #include "execution_plan_build/execution_plan_modify.h"
@@ -445,9 +447,12 @@ ResultSet *ExecutionPlan_Execute(ExecutionPlan *plan) {
 
 	ExecutionPlan_Init(plan);
 
-	Record r = NULL;
-	// Execute the root operation and free the processed Record until the data stream is depleted.
-	while((r = OpBase_Consume(plan->root)) != NULL) ExecutionPlan_ReturnRecord(r->owner, r);
+	uint n = 0;
+	Record batch[OP_BATCH_CAP];
+	// Execute the root operation and free the processed Records until the data stream is depleted.
+	while((n = OpBase_ConsumeBatch(plan->root, batch, OP_BATCH_CAP)) > 0) {
+		for(uint i = 0; i < n; i++) ExecutionPlan_ReturnRecord(batch[i]->owner, batch[i]);
+	}
 
 	return QueryCtx_GetResultSet();
 }
@@ -471,6 +476,7 @@ bool ExecutionPlan_Drained(ExecutionPlan *plan) {
 
 static void _ExecutionPlan_Drain(OpBase *root) {
 	root->consume = deplete_consume;
+	root->consumeBatch = NULL;
 	for(int i = 0; i < root->childCount; i++) {
 		_ExecutionPlan_Drain(root->children[i]);
 	}
@@ -487,35 +493,69 @@ void ExecutionPlan_Drain(ExecutionPlan *plan) {
 // Execution plan profiling
 //------------------------------------------------------------------------------
 
-static void _ExecutionPlan_InitProfiling(OpBase *root) {
+static void _ExecutionPlan_InitProfiling
+(
+	OpBase *root,  // operation to profile
+	bool hw        // hardware counters are collected
+) {
 	root->profile = root->consume;
 	root->consume = OpBase_Profile;
-	root->stats = rm_malloc(sizeof(OpStats));
-	root->stats->profileExecTime = 0;
-	root->stats->profileRecordCount = 0;
+	root->stats = rm_calloc(1, sizeof(OpStats));
+	root->stats->profileHW = hw;
 
 	if(root->childCount) {
 		for(int i = 0; i < root->childCount; i++) {
 			OpBase *child = root->children[i];
-			_ExecutionPlan_InitProfiling(child);
+			_ExecutionPlan_InitProfiling(child, hw);
 		}
 	}
 }
 
+// operation statistics include their children's
+// deduct children's statistics, such that each operation only reports
+// the work it performed itself
 static void _ExecutionPlan_FinalizeProfiling(OpBase *root) {
+	OpStats *stats = root->stats;
+
 	if(root->childCount) {
 		for(int i = 0; i < root->childCount; i++) {
 			OpBase *child = root->children[i];
-			root->stats->profileExecTime -= child->stats->profileExecTime;
+			OpStats *child_stats = child->stats;
+			stats->profileExecTime -= child_stats->profileExecTime;
+			stats->profileMemory   -= child_stats->profileMemory;
+			stats->profileGrBTime  -= child_stats->profileGrBTime;
+			stats->profileMxMCount -= child_stats->profileMxMCount;
+			for(int j = 0; j < HW_COUNTER_COUNT; j++) {
+				stats->profileHWCounters[j] -= child_stats->profileHWCounters[j];
+			}
 			_ExecutionPlan_FinalizeProfiling(child);
 		}
 	}
-	root->stats->profileExecTime *= 1000;   // Milliseconds.
+
+	// counters are sampled independently of one another
+	// avoid reporting negative values due to sampling noise
+	if(stats->profileMemory < 0)  stats->profileMemory  = 0;
+	if(stats->profileGrBTime < 0) stats->profileGrBTime = 0;
+	for(int j = 0; j < HW_COUNTER_COUNT; j++) {
+		if(stats->profileHWCounters[j] < 0) stats->profileHWCounters[j] = 0;
+	}
+
+	stats->profileExecTime *= 1000;  // Milliseconds.
+	stats->profileGrBTime  *= 1000;  // Milliseconds.
 }
 
 ResultSet *ExecutionPlan_Profile(ExecutionPlan *plan) {
-	_ExecutionPlan_InitProfiling(plan->root);
+	bool hw = PROFILE_HW_COUNTERS_DEFAULT;
+	Config_Option_get(Config_PROFILE_HW_COUNTERS, &hw);
+
+	// collect allocations, GraphBLAS and hardware counters of this thread
+	hw = ThreadProfile_Start(hw);
+
+	_ExecutionPlan_InitProfiling(plan->root, hw);
 	ResultSet *rs = ExecutionPlan_Execute(plan);
+
+	ThreadProfile_Stop();
+
 	_ExecutionPlan_FinalizeProfiling(plan->root);
 	return rs;
 }
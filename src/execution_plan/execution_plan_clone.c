@@ -17,8 +17,11 @@ static ExecutionPlan *_ClonePlanInternals(const ExecutionPlan *template) {
 	clone->record_map = raxClone(template->record_map);
 	if(template->ast_segment) clone->ast_segment = AST_ShallowCopy(template->ast_segment);
 	if(template->query_graph) {
-		QueryGraph_ResolveUnknownRelIDs(template->query_graph);
+		// templates are shared by concurrent readers and never modified
+		// resolve relationship types created since the template was built
+		// on the clone
 		clone->query_graph = QueryGraph_Clone(template->query_graph);
+		QueryGraph_ResolveUnknownRelIDs(clone->query_graph);
 	}
 
 	return clone;
@@ -80,3 +83,22 @@ ExecutionPlan *ExecutionPlan_Clone(const ExecutionPlan *template) {
 	return clone;
 }
 
+
+OpBase *ExecutionPlan_CloneOpTree
+(
+	const OpBase *root
+) {
+	ASSERT(root != NULL);
+
+	// store the original AST pointer
+	AST *master_ast = QueryCtx_GetAST();
+	dict *old_to_new = HashTableCreate(&def_dt);
+
+	OpBase *clone = _CloneOpTree((OpBase *)root, old_to_new);
+
+	HashTableRelease(old_to_new);
+	// restore the original AST pointer
+	QueryCtx_SetAST(master_ast);
+
+	return clone;
+}
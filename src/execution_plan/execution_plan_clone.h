@@ -11,3 +11,11 @@
 /* Clones an execution plan */
 ExecutionPlan *ExecutionPlan_Clone(const ExecutionPlan *plan);
 
+
+// clones the op tree rooted at `root` into newly allocated plan segments
+// the clone can be initialized and executed independently of its template
+// free the clone via ExecutionPlan_Free on its root's plan
+OpBase *ExecutionPlan_CloneOpTree
+(
+	const OpBase *root  // root of the op tree to clone
+);
@@ -11,6 +11,8 @@
 #include "../../util/rmalloc.h"
 #include "../../util/simple_timer.h"
 
+#include <inttypes.h>
+
 // forward declarations
 Record ExecutionPlan_BorrowRecord(struct ExecutionPlan *plan);
 rax *ExecutionPlan_GetMappings(const struct ExecutionPlan *plan);
@@ -59,6 +61,8 @@ void OpBase_Init
 	op->profile  = NULL;
 	op->consume  = consume;
 	op->toString = toString;
+
+	op->consumeBatch = NULL;
 }
 
 inline Record OpBase_Consume
@@ -68,6 +72,30 @@ inline Record OpBase_Consume
 	return op->consume(op);
 }
 
+uint OpBase_ConsumeBatch
+(
+	OpBase *op,     // op to consume from
+	Record *batch,  // [output] produced records
+	uint cap        // max number of records to produce
+) {
+	ASSERT(op    != NULL);
+	ASSERT(cap   > 0);
+	ASSERT(batch != NULL);
+
+	// profiled ops collect statistics per record
+	// use the batch consume function only when not profiling
+	if(op->consumeBatch != NULL && op->stats == NULL) {
+		return op->consumeBatch(op, batch, cap);
+	}
+
+	// fallback, single record consume
+	Record r = op->consume(op);
+	if(r == NULL) return 0;
+
+	batch[0] = r;
+	return 1;
+}
+
 // mark alias as being modified by operation
 // returns the ID associated with alias
 int OpBase_Modifies
@@ -198,10 +226,38 @@ static void _OpBase_StatsToString
 	const OpBase *op,
 	sds *buff
 ) {
+	const OpStats *stats = op->stats;
+
 	*buff = sdscatprintf(*buff,
 					" | Records produced: %d, Execution time: %f ms",
-					op->stats->profileRecordCount,
-					op->stats->profileExecTime);
+					stats->profileRecordCount,
+					stats->profileExecTime);
+
+	// number of records consumed from each child
+	if(op->childCount > 0) {
+		*buff = sdscat(*buff, ", Records consumed: [");
+		for(int i = 0; i < op->childCount; i++) {
+			*buff = sdscatprintf(*buff, (i == 0) ? "%d" : ", %d",
+					op->children[i]->stats->profileRecordCount);
+		}
+		*buff = sdscat(*buff, "]");
+	}
+
+	*buff = sdscatprintf(*buff,
+					", Memory: %" PRId64 " bytes, GraphBLAS time: %f ms"
+					", Matrix multiplications: %" PRId64,
+					stats->profileMemory,
+					stats->profileGrBTime,
+					stats->profileMxMCount);
+
+	if(stats->profileHW) {
+		*buff = sdscatprintf(*buff,
+					", Cycles: %" PRId64 ", Cache misses: %" PRId64
+					", Branch misses: %" PRId64,
+					stats->profileHWCounters[HW_COUNTER_CYCLES],
+					stats->profileHWCounters[HW_COUNTER_CACHE_MISSES],
+					stats->profileHWCounters[HW_COUNTER_BRANCH_MISSES]);
+	}
 }
 
 void OpBase_ToString
@@ -222,11 +278,26 @@ Record OpBase_Profile
 	OpBase *op
 ) {
 	double tic [2];
+	ThreadProfileSample start;
+	ThreadProfileSample end;
+
+	ThreadProfile_Sample(&start);
 	// Start timer.
 	simple_tic(tic);
 	Record r = op->profile(op);
 	// Stop timer and accumulate.
 	op->stats->profileExecTime += simple_toc(tic);
+	ThreadProfile_Sample(&end);
+
+	// accumulate counters, inclusive of child operations
+	OpStats *stats = op->stats;
+	stats->profileMemory   += end.alloc - start.alloc;
+	stats->profileGrBTime  += (end.grb_time - start.grb_time) / 1e9;
+	stats->profileMxMCount += end.mxm_count - start.mxm_count;
+	for(int i = 0; i < HW_COUNTER_COUNT; i++) {
+		stats->profileHWCounters[i] += end.hw[i] - start.hw[i];
+	}
+
 	if(r) op->stats->profileRecordCount++;
 	return r;
 }
@@ -250,6 +321,15 @@ void OpBase_UpdateConsume
 	else op->consume = consume;
 }
 
+void OpBase_UpdateConsumeBatch
+(
+	OpBase *op,
+	fpConsumeBatch consumeBatch
+) {
+	ASSERT(op != NULL);
+	op->consumeBatch = consumeBatch;
+}
+
 // updates the plan of an operation
 void OpBase_BindOpToPlan
 (
@@ -8,6 +8,7 @@
 
 #include "../record.h"
 #include "../../util/arr.h"
+#include "../../util/thread_profile.h"
 #include "../../redismodule.h"
 #include "../../schema/schema.h"
 #include "../../graph/query_graph.h"
@@ -16,6 +17,9 @@
 
 #define OP_REQUIRE_NEW_DATA(opRes) (opRes & (OP_DEPLETED | OP_REFRESH)) > 0
 
+// max number of records exchanged by a single batch consume call
+#define OP_BATCH_CAP 64
+
 typedef enum {
 	OPType_ALL_NODE_SCAN,
 	OPType_NODE_BY_LABEL_SCAN,
@@ -55,6 +59,7 @@ typedef enum {
 	OPType_OR_APPLY_MULTIPLEXER,
 	OPType_AND_APPLY_MULTIPLEXER,
 	OPType_OPTIONAL,
+	OPType_EXCHANGE,
 } OPType;
 
 typedef enum {
@@ -112,6 +117,7 @@ struct ExecutionPlan;
 typedef void (*fpFree)(struct OpBase *);
 typedef OpResult(*fpInit)(struct OpBase *);
 typedef Record(*fpConsume)(struct OpBase *);
+typedef uint(*fpConsumeBatch)(struct OpBase *, Record *, uint);
 typedef OpResult(*fpReset)(struct OpBase *);
 typedef void (*fpToString)(const struct OpBase *, sds *);
 typedef struct OpBase *(*fpClone)(const struct ExecutionPlan *, const struct OpBase *);
@@ -120,6 +126,11 @@ typedef struct OpBase *(*fpClone)(const struct ExecutionPlan *, const struct OpB
 typedef struct {
 	int profileRecordCount;     // Number of records generated.
 	double profileExecTime;     // Operation total execution time in ms.
+	int64_t profileMemory;      // Number of bytes allocated.
+	double profileGrBTime;      // Time spent in GraphBLAS in ms.
+	int64_t profileMxMCount;    // Number of matrix multiplications.
+	bool profileHW;             // Hardware counters were collected.
+	int64_t profileHWCounters[HW_COUNTER_COUNT];  // Hardware counters.
 }  OpStats;
 
 struct OpBase {
@@ -129,6 +140,7 @@ struct OpBase {
 	fpReset reset;              // Reset operation state.
 	fpClone clone;              // Operation clone.
 	fpConsume consume;          // Produce next record.
+	fpConsumeBatch consumeBatch;  // Produce a batch of records (optional).
 	fpConsume profile;          // Profiled version of consume.
 	fpToString toString;        // Operation string representation.
 	const char *name;           // Operation name.
@@ -171,6 +183,19 @@ Record OpBase_Consume
 	OpBase *op
 );
 
+// consume up to `cap` records from op into `batch`
+// returns the number of records produced, 0 once op is depleted
+//
+// records within a batch are independent of one another
+// ops lacking a batch consume function produce a single record per call
+// as their records might share state with the op
+uint OpBase_ConsumeBatch
+(
+	OpBase *op,     // op to consume from
+	Record *batch,  // [output] produced records
+	uint cap        // max number of records to produce
+);
+
 // profile op
 Record OpBase_Profile
 (
@@ -262,6 +287,14 @@ void OpBase_UpdateConsume
 	fpConsume consume
 );
 
+// update operation batch consume function
+// NULL falls back to single record consumption
+void OpBase_UpdateConsumeBatch
+(
+	OpBase *op,
+	fpConsumeBatch consumeBatch
+);
+
 // updates the plan of an operation
 void OpBase_BindOpToPlan
 (
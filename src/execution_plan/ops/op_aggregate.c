@@ -14,30 +14,12 @@
 // forward declarations
 static void AggregateFree(OpBase *opBase);
 static Record AggregateConsume(OpBase *opBase);
+static uint AggregateConsumeBatch(OpBase *opBase, Record *batch, uint cap);
 static OpResult AggregateReset(OpBase *opBase);
 static OpBase *AggregateClone(const ExecutionPlan *plan, const OpBase *opBase);
 
-// fake hash function
-// hash of key is simply key
-static uint64_t _id_hash
-(
-	const void *key
-) {
-	return ((uint64_t)key);
-}
-
-// hashtable entry free callback
-static void freeCallback
-(
-	dict *d,
-	void *val
-) {
-	Group_Free((Group*)val);
-}
-
-// hashtable callbacks
-static dictType _dt = { _id_hash, NULL, NULL, NULL, NULL, freeCallback, NULL,
-	NULL, NULL, NULL};
+// number of groups space is initially allocated for
+#define AGGREGATE_INITIAL_GROUPS 256
 
 // migrate each expression projected by this operation to either
 // the array of keys or the array of aggregate functions as appropriate
@@ -63,53 +45,6 @@ static void _migrate_expressions
 	op->aggregate_count = array_len(op->aggregate_exps);
 }
 
-// clone all aggregate expression templates to associate with a new group
-static inline AR_ExpNode **_build_aggregate_exps
-(
-	OpAggregate *op
-) {
-	AR_ExpNode **agg_exps =
-		rm_malloc(op->aggregate_count * sizeof(AR_ExpNode *));
-
-	for(uint i = 0; i < op->aggregate_count; i++) {
-		agg_exps[i] = AR_EXP_Clone(op->aggregate_exps[i]);
-	}
-
-	return agg_exps;
-}
-
-// build a new group key from the SIValue results of non-aggregate expressions
-static inline SIValue *_build_group_key
-(
-	SIValue *keys,
-	uint n
-) {
-	// TODO: might be expensive incase we're generating lots of groups
-	SIValue *group_keys = rm_malloc(sizeof(SIValue) * n);
-
-	for(uint i = 0; i < n; i++) {
-		SIValue key = SI_TransferOwnership(keys + i);
-		SIValue_Persist(&key);
-		group_keys[i] = key;
-	}
-
-	return group_keys;
-}
-
-static Group *_CreateGroup
-(
-	OpAggregate *op,
-	SIValue *keys
-) {
-	// create a new group, clone group keys
-	SIValue *group_keys = _build_group_key(keys, op->key_count);
-
-	// get a fresh copy of aggregation functions
-	AR_ExpNode **agg_exps = _build_aggregate_exps(op);
-
-	return Group_New(group_keys, op->key_count, agg_exps, op->aggregate_count);
-}
-
 static XXH64_hash_t _ComputeGroupKey
 (
 	SIValue *keys,
@@ -133,9 +68,9 @@ static XXH64_hash_t _ComputeGroupKey
 	return XXH64_digest(&state);
 }
 
-// retrieves group under which given record belongs to
+// retrieves index of group under which given record belongs to
 // creates group if it doesn't exists
-static Group *_GetGroup
+static uint64_t _GetGroup
 (
 	OpAggregate *op,
 	Record r
@@ -147,27 +82,19 @@ static Group *_GetGroup
 	XXH64_hash_t hash = _ComputeGroupKey(keys, op, r);
 
 	// lookup group by hashed key
-	Group *g;
-	dictEntry *existing;
-	dictEntry *entry = HashTableAddRaw(op->groups, (void *)hash, &existing);
-	if(entry == NULL) {
-		// group exists
-		ASSERT(existing != NULL);
-
-		// free computed keys
-		for(uint i = 0; i < op->key_count; i++) {
-			SIValue_Free(keys[i]);
-		}
+	// computed keys are either moved into the group table or freed
+	bool created;
+	uint64_t group = GroupTable_FindOrInsert(op->groups, hash, keys, &created);
 
-		g = HashTableGetVal(existing);
-	} else {
-		// entry missing
-		// group does not exists, create it
-		g = _CreateGroup(op, keys);
-		HashTableSetVal(op->groups, entry, g);
+	if(created) {
+		// group does not exists, add a fresh aggregation state
+		// for each aggregate expression
+		for(uint i = 0; i < op->aggregate_count; i++) {
+			AggStates_Add(op->states + i);
+		}
 	}
 
-	return g;
+	return group;
 }
 
 static void _aggregateRecord
@@ -176,13 +103,11 @@ static void _aggregateRecord
 	Record r
 ) {
 	// get group
-	Group *g = _GetGroup(op, r);
-	ASSERT(g != NULL);
+	uint64_t group = _GetGroup(op, r);
 
 	// aggregate group exps
 	for(uint i = 0; i < op->aggregate_count; i++) {
-		AR_ExpNode *exp = g->agg[i];
-		AR_EXP_Aggregate(exp, r);
+		AggStates_Step(op->states + i, group, r);
 	}
 
 	OpBase_DeleteRecord(r);
@@ -193,14 +118,13 @@ static Record _handoff
 (
 	OpAggregate *op
 ) {
-	dictEntry *entry = HashTableNext(op->group_iter);
-	if(entry == NULL) {
+	if(op->group_idx == GroupTable_Count(op->groups)) {
 		return NULL;
 	}
 
-	Record   r    = OpBase_CreateRecord((OpBase*)op);
-	Group   *g    = (Group*)HashTableGetVal(entry);
-	SIValue *keys = g->keys;
+	uint64_t group = op->group_idx++;
+	Record   r     = OpBase_CreateRecord((OpBase*)op);
+	SIValue *keys  = GroupTable_Keys(op->groups, group);
 
 	// add all projected keys to the Record
 	for(uint i = 0; i < op->key_count; i++) {
@@ -213,9 +137,7 @@ static Record _handoff
 	// compute the final value of all aggregate expressions and add to Record
 	for(uint i = 0; i < op->aggregate_count; i++) {
 		int rec_idx = op->record_offsets[i + op->key_count];
-		AR_ExpNode *exp = g->agg[i];
-
-		SIValue agg = AR_EXP_FinalizeAggregations(exp, r);
+		SIValue agg = AggStates_Finalize(op->states + i, group, r);
 		Record_AddScalar(r, rec_idx, agg);
 	}
 
@@ -229,22 +151,28 @@ OpBase *NewAggregateOp
 ) {
 	OpAggregate *op = rm_malloc(sizeof(OpAggregate));
 
-	op->groups               = HashTableCreate(&_dt);
-	op->group_iter           = NULL;
+	op->group_idx  = 0;
+	op->aggregated = false;
 
 	OpBase_Init((OpBase *)op, OPType_AGGREGATE, "Aggregate", NULL,
 			AggregateConsume, AggregateReset, NULL, AggregateClone,
 			AggregateFree, false, plan);
-
-	// expand hashtable to 2048 slots
-	int res = HashTableExpand(op->groups, 2048);
-	ASSERT(res == DICT_OK);
+	OpBase_UpdateConsumeBatch((OpBase *)op, AggregateConsumeBatch);
 
 	// migrate each expression to the keys array or
 	// the aggregations array as appropriate
 	_migrate_expressions(op, exps);
 	array_free(exps);
 
+	// without keys there's at most a single group
+	op->groups = GroupTable_New(op->key_count,
+			(op->key_count > 0) ? AGGREGATE_INITIAL_GROUPS : 1);
+
+	op->states = rm_malloc(sizeof(AggStates) * op->aggregate_count);
+	for(uint i = 0; i < op->aggregate_count; i++) {
+		AggStates_Init(op->states + i, op->aggregate_exps[i]);
+	}
+
 	// the projected record will associate values with their resolved name
 	// to ensure that space is allocated for each entry
 	op->record_offsets = array_new(uint, op->aggregate_count + op->key_count);
@@ -264,26 +192,28 @@ OpBase *NewAggregateOp
 	return (OpBase *)op;
 }
 
-static Record AggregateConsume
+// consumes all child records and builds groups
+static void _aggregate
 (
-	OpBase *opBase
+	OpAggregate *op
 ) {
-	OpAggregate *op = (OpAggregate *)opBase;
-	if(op->group_iter != NULL) {
-		return _handoff(op);
-	}
-
 	Record r;
+	OpBase *opBase = (OpBase *)op;
+
 	if(op->op.childCount == 0) {
 		// RETURN max (1)
 		// create a 'fake' record
 		r = OpBase_CreateRecord(opBase);
 		_aggregateRecord(op, r);
 	} else {
+		uint n;
+		Record batch[OP_BATCH_CAP];
 		OpBase *child = op->op.children[0];
 		// eager consumption!
-		while((r = OpBase_Consume(child))) {
-			_aggregateRecord(op, r);
+		while((n = OpBase_ConsumeBatch(child, batch, OP_BATCH_CAP)) > 0) {
+			for(uint i = 0; i < n; i++) {
+				_aggregateRecord(op, batch[i]);
+			}
 		}
 	}
 
@@ -291,7 +221,7 @@ static Record AggregateConsume
 	// does aggregation contains keys?
 	// e.g.
 	// MATCH (n:N) WHERE n.noneExisting = 2 RETURN count(n)
-	if(HashTableElemCount(op->groups) == 0 && op->key_count == 0) {
+	if(GroupTable_Count(op->groups) == 0 && op->key_count == 0) {
 
 		// no data was processed and aggregation doesn't have a key
 		// in this case we want to return aggregation default value
@@ -315,32 +245,56 @@ static Record AggregateConsume
 		OpBase_DeleteRecord(r);
 	}
 
-	// create group iterator
-	op->group_iter = HashTableGetIterator(op->groups);
+	op->aggregated = true;
+}
+
+static Record AggregateConsume
+(
+	OpBase *opBase
+) {
+	OpAggregate *op = (OpAggregate *)opBase;
+	if(!op->aggregated) {
+		_aggregate(op);
+	}
 
 	return _handoff(op);
 }
 
-static OpResult AggregateReset
+static uint AggregateConsumeBatch
 (
-	OpBase *opBase
+	OpBase *opBase,
+	Record *batch,
+	uint cap
 ) {
 	OpAggregate *op = (OpAggregate *)opBase;
+	if(!op->aggregated) {
+		_aggregate(op);
+	}
 
-	if(op->group_iter != NULL) {
-		HashTableReleaseIterator(op->group_iter);
-		op->group_iter = NULL;
+	uint n = 0;
+	while(n < cap) {
+		Record r = _handoff(op);
+		if(r == NULL) break;
+		batch[n++] = r;
 	}
 
-	// re-create hashtable
-	unsigned long elem_count = HashTableElemCount(op->groups);
-	HashTableRelease(op->groups);
+	return n;
+}
+
+static OpResult AggregateReset
+(
+	OpBase *opBase
+) {
+	OpAggregate *op = (OpAggregate *)opBase;
 
-	op->groups = HashTableCreate(&_dt);
+	// drop all groups, retaining allocated memory
+	for(uint i = 0; i < op->aggregate_count; i++) {
+		AggStates_Clear(op->states + i);
+	}
+	GroupTable_Clear(op->groups);
 
-	// expand hashtable to previous element count
-	int res = HashTableExpand(op->groups, elem_count);
-	ASSERT(res == DICT_OK);
+	op->group_idx  = 0;
+	op->aggregated = false;
 
 	return OP_OK;
 }
@@ -404,9 +358,18 @@ static void AggregateFree
 		return;
 	}
 
-	if(op->group_iter) {
-		HashTableReleaseIterator(op->group_iter);
-		op->group_iter = NULL;
+	// states refer to aggregate expressions, free them first
+	if(op->states) {
+		for(uint i = 0; i < op->aggregate_count; i++) {
+			AggStates_Free(op->states + i);
+		}
+		rm_free(op->states);
+		op->states = NULL;
+	}
+
+	if(op->groups) {
+		GroupTable_Free(op->groups);
+		op->groups = NULL;
 	}
 
 	if(op->key_exps) {
@@ -425,11 +388,6 @@ static void AggregateFree
 		op->aggregate_exps = NULL;
 	}
 
-	if(op->groups) {
-		HashTableRelease(op->groups);
-		op->groups = NULL;
-	}
-
 	if(op->record_offsets) {
 		array_free(op->record_offsets);
 		op->record_offsets = NULL;
@@ -111,6 +111,11 @@ OpBase *NewCondVarLenTraverseOp
 	op->collect_paths      =  true;
 	op->allNeighborsCtx    =  NULL;
 	op->edgeRelationTypes  =  NULL;
+	op->record_cap         =  UNLIMITED;
+	op->records            =  NULL;
+	op->record_count       =  0;
+	op->record_idx         =  0;
+	op->emitted            =  0;
 
 	OpBase_Init((OpBase *)op, OPType_CONDITIONAL_VAR_LEN_TRAVERSE,
 				"Conditional Variable Length Traverse", CondVarLenTraverseInit,
@@ -136,6 +141,12 @@ OpBase *NewCondVarLenTraverseOp
 static OpResult CondVarLenTraverseInit(OpBase *opBase) {
 	CondVarLenTraverse *op = (CondVarLenTraverse *)opBase;
 
+	// child records are buffered in batches, 'record_cap'
+	// might be set during optimization time (applyLimit)
+	TraverseBatch_Init(&op->batch, op->record_cap);
+	op->record_cap = op->batch.cap;
+	op->records = rm_calloc(op->record_cap, sizeof(Record));
+
 	// check if variable length traversal doesn't require path construction
 	// in which case we only care for reachable destination nodes
 	// which is alot cheaper to compute
@@ -182,15 +193,58 @@ static OpResult CondVarLenTraverseInit(OpBase *opBase) {
 	return OP_OK;
 }
 
+// returns the next child record, NULL if child is depleted
+// child records are consumed in batches whose size adapts to the
+// number of records emitted per child record
+static Record _NextChildRecord(CondVarLenTraverse *op) {
+	if(op->record_idx < op->record_count) {
+		return op->records[op->record_idx++];
+	}
+
+	// adjust batch size according to the last batch's fan-out
+	if(op->record_count > 0) {
+		TraverseBatch_Update(&op->batch, op->record_count, op->emitted);
+	}
+
+	op->emitted      = 0;
+	op->record_idx   = 0;
+	op->record_count = 0;
+
+	OpBase *child = op->op.children[0];
+	while(op->record_count < op->batch.size) {
+		Record *batch = op->records + op->record_count;
+		uint n = OpBase_ConsumeBatch(child, batch,
+				op->batch.size - op->record_count);
+		if(n == 0) break;
+
+		// buffered records must outlive the child's state
+		for(uint i = 0; i < n; i++) Record_PersistScalars(batch[i]);
+		op->record_count += n;
+	}
+
+	if(op->record_count == 0) return NULL;
+
+	return op->records[op->record_idx++];
+}
+
+// frees buffered child records
+static void _FreeChildRecords(CondVarLenTraverse *op) {
+	for(uint i = op->record_idx; i < op->record_count; i++) {
+		OpBase_DeleteRecord(op->records[i]);
+	}
+	op->record_idx   = 0;
+	op->record_count = 0;
+	op->emitted      = 0;
+}
+
 static Record CondVarLenTraverseOptimizedConsume(OpBase *opBase) {
 	CondVarLenTraverse  *op     = (CondVarLenTraverse *)opBase;
-	OpBase              *child  =  op->op.children[0];
 	Node                dest    =  GE_NEW_NODE();
 	EntityID            dest_id =  INVALID_ENTITY_ID;
 
 	while((dest_id = AllNeighborsCtx_NextNeighbor(op->allNeighborsCtx)) ==
 		  INVALID_ENTITY_ID) {
-		Record childRecord = OpBase_Consume(child);
+		Record childRecord = _NextChildRecord(op);
 		if(!childRecord) return NULL;
 
 		if(op->r) OpBase_DeleteRecord(op->r);
@@ -243,6 +297,7 @@ static Record CondVarLenTraverseOptimizedConsume(OpBase *opBase) {
 	// add destination node to record
 	Record r = OpBase_CloneRecord(op->r);
 	Record_AddNode(r, op->destNodeIdx, dest);
+	op->emitted++;
 
 	return r;
 }
@@ -250,10 +305,9 @@ static Record CondVarLenTraverseOptimizedConsume(OpBase *opBase) {
 static Record CondVarLenTraverseConsume(OpBase *opBase) {
 	CondVarLenTraverse  *op     = (CondVarLenTraverse *)opBase;
 	Path                *p      =  NULL;
-	OpBase              *child  =  op->op.children[0];
 
 	while(!(p = AllPathsCtx_NextPath(op->allPathsCtx))) {
-		Record childRecord = OpBase_Consume(child);
+		Record childRecord = _NextChildRecord(op);
 		if(!childRecord) return NULL;
 
 		if(op->r) OpBase_DeleteRecord(op->r);
@@ -300,6 +354,7 @@ static Record CondVarLenTraverseConsume(OpBase *opBase) {
 
 	// add new path to record
 	if(op->edgesIdx >= 0) Record_AddScalar(r, op->edgesIdx, SI_Path(p));
+	op->emitted++;
 
 	return r;
 }
@@ -311,6 +366,8 @@ static OpResult CondVarLenTraverseReset(OpBase *ctx) {
 		op->r = NULL;
 	}
 
+	_FreeChildRecords(op);
+
 	if(op->collect_paths) {
 		if(op->allPathsCtx) {
 			AllPathsCtx_Free(op->allPathsCtx);
@@ -352,6 +409,12 @@ static void CondVarLenTraverseFree(OpBase *ctx) {
 		op->r = NULL;
 	}
 
+	if(op->records) {
+		_FreeChildRecords(op);
+		rm_free(op->records);
+		op->records = NULL;
+	}
+
 	if(op->collect_paths) {
 		if(op->allPathsCtx) {
 			AllPathsCtx_Free(op->allPathsCtx);
@@ -8,6 +8,7 @@
 
 #include "op.h"
 #include "../execution_plan.h"
+#include "shared/traverse_functions.h"
 #include "../../graph/graph.h"
 #include "../../algorithms/algorithms.h"
 #include "../../arithmetic/algebraic_expression.h"
@@ -35,6 +36,12 @@ typedef struct {
 	};
 	bool collect_paths;                    /* Whether we must populate the entire path. */
 	GRAPH_EDGE_DIR traverseDir;            /* Traverse direction. */
+	uint record_cap;                       /* Max number of child records to buffer. */
+	TraverseBatch batch;                   /* Adaptive number of child records to buffer. */
+	Record *records;                       /* Buffered child records. */
+	uint record_count;                     /* Number of buffered child records. */
+	uint record_idx;                       /* Next buffered child record to process. */
+	uint64_t emitted;                      /* Number of records emitted by current batch. */
 } CondVarLenTraverse;
 
 OpBase *NewCondVarLenTraverseOp(const ExecutionPlan *plan, Graph *g, AlgebraicExpression *ae);
@@ -9,12 +9,10 @@
 #include "shared/print_functions.h"
 #include "../../query_ctx.h"
 
-// default number of records to accumulate before traversing
-#define BATCH_SIZE 16
-
 /* Forward declarations. */
 static OpResult CondTraverseInit(OpBase *opBase);
 static Record CondTraverseConsume(OpBase *opBase);
+static uint CondTraverseConsumeBatch(OpBase *opBase, Record *batch, uint cap);
 static OpResult CondTraverseReset(OpBase *opBase);
 static OpBase *CondTraverseClone(const ExecutionPlan *plan, const OpBase *opBase);
 static void CondTraverseFree(OpBase *opBase);
@@ -79,13 +77,14 @@ OpBase *NewCondTraverseOp
 
 	op->ae         = ae;
 	op->graph      = g;
-	op->record_cap = BATCH_SIZE;
+	op->record_cap = UNLIMITED;
 
 	// Set our Op operations
 	OpBase_Init((OpBase *)op, OPType_CONDITIONAL_TRAVERSE,
 			"Conditional Traverse", CondTraverseInit, CondTraverseConsume,
 			CondTraverseReset, CondTraverseToString, CondTraverseClone,
 			CondTraverseFree, false, plan);
+	OpBase_UpdateConsumeBatch((OpBase *)op, CondTraverseConsumeBatch);
 
 	bool aware = OpBase_Aware((OpBase *)op, AlgebraicExpression_Src(ae),
 			&op->srcNodeIdx);
@@ -111,19 +110,21 @@ static OpResult CondTraverseInit(OpBase *opBase) {
 	OpCondTraverse *op = (OpCondTraverse *)opBase;
 	// Create 'records' with this Init function as 'record_cap'
 	// might be set during optimization time (applyLimit)
-	// If cap greater than BATCH_SIZE is specified,
-	// use BATCH_SIZE as the value.
-	if(op->record_cap > BATCH_SIZE) op->record_cap = BATCH_SIZE;
+	// the batch size adapts within [1, record_cap], both 'records'
+	// and the filter matrix are sized for the largest batch.
+	TraverseBatch_Init(&op->batch, op->record_cap);
+	op->record_cap = op->batch.cap;
 	op->records = rm_calloc(op->record_cap, sizeof(Record));
 
 	return OP_OK;
 }
 
-/* Each call to CondTraverseConsume emits a Record containing the
+/* Each call to _CondTraverseNext emits a Record containing the
  * traversal's endpoints and, if required, an edge.
+ * When 'independent' is set, the emitted Record doesn't share
+ * any data with the held records.
  * Returns NULL once all traversals have been performed. */
-static Record CondTraverseConsume(OpBase *opBase) {
-	OpCondTraverse *op = (OpCondTraverse *)opBase;
+static Record _CondTraverseNext(OpCondTraverse *op, bool independent) {
 	OpBase *child = op->op.children[0];
 
 	/* If we're required to update an edge and have one queued, we can return early.
@@ -131,6 +132,7 @@ static Record CondTraverseConsume(OpBase *opBase) {
 	if(op->r         != NULL  &&
 	   op->edge_ctx  != NULL  &&
 	   EdgeTraverseCtx_SetEdge(op->edge_ctx, op->r)) {
+		if(independent) return OpBase_DeepCloneRecord(op->r);
 		return OpBase_CloneRecord(op->r);
 	}
 
@@ -141,7 +143,10 @@ static Record CondTraverseConsume(OpBase *opBase) {
 		GrB_Info info = RG_MatrixTupleIter_next_UINT64(&op->iter, &src_id, &dest_id, NULL);
 
 		// Managed to get a tuple, break.
-		if(info == GrB_SUCCESS) break;
+		if(info == GrB_SUCCESS) {
+			op->emitted++;
+			break;
+		}
 
 		/* Run out of tuples, try to get new data.
 		 * Free old records. */
@@ -150,24 +155,36 @@ static Record CondTraverseConsume(OpBase *opBase) {
 			OpBase_DeleteRecord(op->records[i]);
 		}
 
+		// Adjust batch size according to the last batch's fan-out.
+		if(op->record_count > 0) {
+			TraverseBatch_Update(&op->batch, op->record_count, op->emitted);
+		}
+		op->emitted = 0;
+
 		// Ask child operations for data.
-		for(op->record_count = 0; op->record_count < op->record_cap; op->record_count++) {
-			Record childRecord = OpBase_Consume(child);
-			// If the Record is NULL, the child has been depleted.
-			if(childRecord == NULL) {
+		op->record_count = 0;
+		while(op->record_count < op->batch.size) {
+			Record *batch = op->records + op->record_count;
+			uint n = OpBase_ConsumeBatch(child, batch,
+					op->batch.size - op->record_count);
+			// If no records were produced, the child has been depleted.
+			if(n == 0) {
 				break;
 			}
-			if(!Record_GetNode(childRecord, op->srcNodeIdx)) {
-				/* The child Record may not contain the source node in scenarios like
-				 * a failed OPTIONAL MATCH. In this case, delete the Record and try again. */
-				OpBase_DeleteRecord(childRecord);
-				op->record_count--;
-				continue;
-			}
 
-			// Store received record.
-			Record_PersistScalars(childRecord);
-			op->records[op->record_count] = childRecord;
+			for(uint i = 0; i < n; i++) {
+				Record childRecord = batch[i];
+				if(!Record_GetNode(childRecord, op->srcNodeIdx)) {
+					/* The child Record may not contain the source node in scenarios like
+					 * a failed OPTIONAL MATCH. In this case, delete the Record and try again. */
+					OpBase_DeleteRecord(childRecord);
+					continue;
+				}
+
+				// Store received record.
+				Record_PersistScalars(childRecord);
+				op->records[op->record_count++] = childRecord;
+			}
 		}
 
 		// No data.
@@ -194,6 +211,24 @@ static Record CondTraverseConsume(OpBase *opBase) {
 	return OpBase_DeepCloneRecord(op->r);
 }
 
+static Record CondTraverseConsume(OpBase *opBase) {
+	return _CondTraverseNext((OpCondTraverse *)opBase, false);
+}
+
+static uint CondTraverseConsumeBatch(OpBase *opBase, Record *batch, uint cap) {
+	OpCondTraverse *op = (OpCondTraverse *)opBase;
+
+	// emitted records must outlive the held records
+	uint n = 0;
+	while(n < cap) {
+		Record r = _CondTraverseNext(op, true);
+		if(r == NULL) break;
+		batch[n++] = r;
+	}
+
+	return n;
+}
+
 static OpResult CondTraverseReset(OpBase *ctx) {
 	OpCondTraverse *op = (OpCondTraverse *)ctx;
 
@@ -202,6 +237,7 @@ static OpResult CondTraverseReset(OpBase *ctx) {
 	op->r = NULL;
 	for(uint i = 0; i < op->record_count; i++) OpBase_DeleteRecord(op->records[i]);
 	op->record_count = 0;
+	op->emitted = 0;
 
 	if(op->edge_ctx) EdgeTraverseCtx_Reset(op->edge_ctx);
 
@@ -26,6 +26,8 @@ typedef struct {
 	int destNodeIdx;            // Destination node index into record.
 	uint record_count;          // Number of held records.
 	uint record_cap;            // Max number of records to process.
+	TraverseBatch batch;        // Adaptive number of records to process.
+	uint64_t emitted;           // Number of tuples emitted by current batch.
 	Record *records;            // Array of records.
 	Record r;                   // Currently selected record.
 } OpCondTraverse;
@@ -100,8 +100,8 @@ static void _CreateEdges
 		// verify edge endpoints resolved properly, fail otherwise
 		if(unlikely(!src_node                       ||
 					!dest_node                      ||
-					GraphEntity_IsDeleted(src_node) ||
-					GraphEntity_IsDeleted(dest_node))) {
+					Graph_EntityIsDeleted(gc->g, src_node, GETYPE_NODE) ||
+					Graph_EntityIsDeleted(gc->g, dest_node, GETYPE_NODE))) {
 			ErrorCtx_RaiseRuntimeException(
 					"Failed to create relationship; endpoint was not found.");
 		}
@@ -62,7 +62,7 @@ static void _DeleteEntities
 		Node *n = nodes + i;
 
 		// skip already deleted nodes
-		if(Graph_EntityIsDeleted((GraphEntity *)n)) {
+		if(Graph_EntityIsDeleted(g, (GraphEntity *)n, GETYPE_NODE)) {
 			continue;
 		}
 
@@ -95,7 +95,7 @@ static void _DeleteEntities
 		Edge *e = edges + i;
 
 		// skip already deleted edges
-		if(Graph_EntityIsDeleted((GraphEntity *)e)) {
+		if(Graph_EntityIsDeleted(g, (GraphEntity *)e, GETYPE_EDGE)) {
 			continue;
 		}
 
@@ -7,7 +7,7 @@
 #include "op_edge_by_index_scan.h"
 #include "../../query_ctx.h"
 #include "shared/print_functions.h"
-#include "../../filter_tree/ft_to_rsq.h"
+#include "../../filter_tree/ft_to_range.h"
 
 // forward declarations
 static OpResult EdgeIndexScanInit(OpBase *opBase);
@@ -36,7 +36,7 @@ OpBase *NewEdgeIndexScanOp
 	const ExecutionPlan *plan,
 	Graph *g,
 	QGEdge *e,
-	RSIndex *idx,
+	Index idx,
 	FT_FilterNode *filter
 ) {
 	// validate inputs
@@ -143,6 +143,27 @@ static OpResult EdgeIndexScanInit
 	return OP_OK;
 }
 
+// create an iterator over the index entries matching 'filter'
+static void _BuildIterator
+(
+	OpEdgeIndexScan *op,         // executing operation
+	const FT_FilterNode *filter  // filter to convert into an index query
+) {
+	RangeQuery *q = FilterTreeToRangeQuery(&op->unresolved_filters, filter,
+			op->idx);
+	op->iter = RangeIndex_Query(Index_RangeIndex(op->idx), q);
+}
+
+// pull next edge from index
+static inline bool _NextEdge
+(
+	OpEdgeIndexScan *op,   // executing operation
+	EdgeIndexKey *edge_key // [output] edge retrieved from the index
+) {
+	return RangeIndexIterator_Next(op->iter, &edge_key->edge_id,
+			&edge_key->src_id, &edge_key->dest_id);
+}
+
 static inline void _UpdateRecord
 (
 	OpEdgeIndexScan *op,          // executing operation
@@ -207,7 +228,7 @@ static Record EdgeIndexScanConsumeFromChild
 	OpBase *opBase
 ) {
 	OpEdgeIndexScan	*op = (OpEdgeIndexScan*)opBase;
-	const EdgeIndexKey *edgeKey = NULL;
+	EdgeIndexKey edgeKey;
 
 pull_index:
 	//--------------------------------------------------------------------------
@@ -215,10 +236,9 @@ pull_index:
 	//--------------------------------------------------------------------------
 
 	if(op->iter != NULL && op->child_record != NULL) {
-		while((edgeKey = RediSearch_ResultsIteratorNext(op->iter, op->idx, NULL))
-				!= NULL) {
+		while(_NextEdge(op, &edgeKey)) {
 			// populate record with edge
-			_UpdateRecord(op, op->child_record, edgeKey);
+			_UpdateRecord(op, op->child_record, &edgeKey);
 			// apply unresolved filters
 			if(_PassUnresolvedFilters(op, op->child_record)) {
 				// clone the held Record, as it will be freed upstream
@@ -251,7 +271,7 @@ pull_index:
 	if(op->rebuild_index_query) {
 		// free previous iterator
 		if(op->iter != NULL) {
-			RediSearch_ResultsIteratorFree(op->iter);
+			RangeIndexIterator_Free(op->iter);
 			op->iter = NULL;
 		}
 
@@ -277,26 +297,18 @@ pull_index:
 		}
 		#endif
 
-		// convert filter into a RediSearch query
-		RSQNode *rs_query_node = FilterTreeToQueryNode(&op->unresolved_filters,
-				filter, op->idx);
+		// convert filter into an index query and create iterator
+		_BuildIterator(op, filter);
 		FilterTree_Free(filter);
-
-		// create iterator
-		ASSERT(rs_query_node != NULL);
-		op->iter = RediSearch_GetResultsIterator(rs_query_node, op->idx);
 	} else {
 		// build index query only once (first call)
 		// reset it if already initialized
 		if(op->iter == NULL) {
 			// first call to consume, create query and iterator
-			RSQNode *rs_query_node = FilterTreeToQueryNode(
-					&op->unresolved_filters, op->filter, op->idx);
-			ASSERT(rs_query_node != NULL);
-			op->iter = RediSearch_GetResultsIterator(rs_query_node, op->idx);
+			_BuildIterator(op, op->filter);
 		} else {
 			// reset existing iterator
-			RediSearch_ResultsIteratorReset(op->iter);
+			RangeIndexIterator_Reset(op->iter);
 		}
 	}
 
@@ -313,21 +325,16 @@ static Record EdgeIndexScanConsume
 	// create iterator on first call
 	if(op->iter == NULL) {
 		UpdateCurrentAwareIds(op);
-
-		RSQNode *rs_query_node = FilterTreeToQueryNode(&op->unresolved_filters,
-				op->filter, op->idx);
-
-		op->iter = RediSearch_GetResultsIterator(rs_query_node, op->idx);
+		_BuildIterator(op, op->filter);
 	}
 
-	const EdgeIndexKey *edgeKey = NULL;
+	EdgeIndexKey edgeKey;
 
 	// populate the Record with the actual edge
 	Record r = OpBase_CreateRecord((OpBase *)op);
-	while((edgeKey = RediSearch_ResultsIteratorNext(op->iter, op->idx, NULL))
-			!= NULL) {
+	while(_NextEdge(op, &edgeKey)) {
 		// populate record with edge
-		_UpdateRecord(op, r, edgeKey);
+		_UpdateRecord(op, r, &edgeKey);
 		// apply unresolved filters
 		if(_PassUnresolvedFilters(op, r)) {
 			return r;
@@ -343,7 +350,7 @@ static OpResult EdgeIndexScanReset(OpBase *opBase) {
 	OpEdgeIndexScan *op = (OpEdgeIndexScan *)opBase;
 
 	if(op->iter) {
-		RediSearch_ResultsIteratorFree(op->iter);
+		RangeIndexIterator_Free(op->iter);
 		op->iter = NULL;
 	}
 
@@ -357,12 +364,8 @@ static OpResult EdgeIndexScanReset(OpBase *opBase) {
 
 static void EdgeIndexScanFree(OpBase *opBase) {
 	OpEdgeIndexScan *op = (OpEdgeIndexScan *)opBase;
-	// as long as this Index iterator is alive the index is
-	// read locked, if this index scan operation is part of
-	// a query which will modified this index we'll be stuck in
-	// a dead lock, as we're unable to acquire index write lock
 	if(op->iter) {
-		RediSearch_ResultsIteratorFree(op->iter);
+		RangeIndexIterator_Free(op->iter);
 		op->iter = NULL;
 	}
 
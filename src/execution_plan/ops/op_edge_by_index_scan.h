@@ -9,20 +9,20 @@
 #include "op.h"
 #include "../execution_plan.h"
 #include "../../graph/graph.h"
-#include "redisearch_api.h"
+#include "../../index/index.h"
 
 typedef struct {
 	OpBase op;
 	Graph *g;
-	bool rebuild_index_query;           // should we rebuild RediSearch index query for each input record
-	RSIndex *idx;                       // index to query
+	bool rebuild_index_query;           // should we rebuild index query for each input record
+	Index idx;                          // index to query
 	QGEdge *edge;                       // edge scanned
 	int edgeRecIdx;                     // record index of source node
 	int srcRecIdx;                      // record index of destination node
 	int destRecIdx;                     // record index of edge
 	bool srcAware;                      // src node already resolved
 	bool destAware;                     // dest node already resolved
-	RSResultsIterator *iter;            // iterator over an index
+	RangeIndexIterator *iter;           // iterator over an index
 	FT_FilterNode *filter;              // index query
 	AR_ExpNode *current_src_node_id;    // current source node id
 	AR_ExpNode *current_dest_node_id;   // current destination node id
@@ -36,7 +36,7 @@ OpBase *NewEdgeIndexScanOp
 	const ExecutionPlan *plan,
 	Graph *g,
 	QGEdge *e,
-	RSIndex *idx,
+	Index idx,
 	FT_FilterNode *filter
 );
 
@@ -0,0 +1,574 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "op_exchange.h"
+#include "../../query_ctx.h"
+#include "../../util/arr.h"
+#include "../../errors/errors.h"
+#include "../../util/rmalloc.h"
+#include "../../util/thpool/pools.h"
+#include "../execution_plan_clone.h"
+
+#include <pthread.h>
+
+// max number of records in a chunk
+#define EXCHANGE_CHUNK_CAP 1024
+
+// max number of chunks pending hand off, per helper
+#define EXCHANGE_PENDING_CHUNKS 4
+
+// forward declarations
+static OpResult ExchangeInit(OpBase *opBase);
+static Record ExchangeConsume(OpBase *opBase);
+static uint ExchangeConsumeBatch(OpBase *opBase, Record *batch, uint cap);
+static OpBase *ExchangeClone(const ExecutionPlan *plan, const OpBase *opBase);
+static void ExchangeFree(OpBase *opBase);
+
+typedef enum {
+	WORKER_PENDING,    // scheduled, yet to start
+	WORKER_RUNNING,    // processing morsels
+	WORKER_DONE,       // finished processing
+	WORKER_CANCELLED,  // cancelled before it started
+} WorkerState;
+
+typedef struct {
+	OpBase *root;           // root of the cloned pipeline
+	NodeByLabelScan *scan;  // tap of the cloned pipeline
+	bool initialized;       // pipeline been initialized
+	WorkerState state;      // worker state, guarded by the shared lock
+	Record *spent;          // handed off records, guarded by the shared lock
+	ExchangeChunk *chunk;   // chunk being filled
+	ExchangeShared *shared; // shared exchange state
+} ExchangeWorker;
+
+struct ExchangeChunk {
+	Record *records;        // records produced by owner
+	ExchangeWorker *owner;  // producing worker
+};
+
+struct ExchangeShared {
+	QueryCtx *query_ctx;      // query context of the executing thread
+	GrB_Index nrows;          // size of the scanned ID space
+	uint morsel_count;        // number of morsels
+	uint next_morsel;         // next morsel to claim
+	bool cancelled;           // stop processing morsels
+	int ref_count;            // executing thread + scheduled helpers
+	pthread_mutex_t lock;     // guards the fields below
+	pthread_cond_t cond;      // signaled on chunk hand off and worker exit
+	ExchangeChunk **ready;    // chunks ready to be handed off
+	uint running;             // number of running helpers
+	char *error;              // first error raised by a helper
+	uint worker_count;        // number of helpers
+	ExchangeWorker *workers;  // helpers
+};
+
+//------------------------------------------------------------------------------
+// shared state
+//------------------------------------------------------------------------------
+
+static ExchangeShared *_ExchangeShared_New
+(
+	GrB_Index nrows,
+	uint morsel_count,
+	uint worker_count
+) {
+	ExchangeShared *shared = rm_calloc(1, sizeof(ExchangeShared));
+
+	shared->query_ctx    = QueryCtx_GetQueryCtx();
+	shared->nrows        = nrows;
+	shared->morsel_count = morsel_count;
+	shared->ref_count    = 1;
+	shared->ready        = array_new(ExchangeChunk *, 0);
+	shared->worker_count = worker_count;
+	shared->workers      = rm_calloc(worker_count, sizeof(ExchangeWorker));
+
+	int res = pthread_mutex_init(&shared->lock, NULL);
+	ASSERT(res == 0);
+	res = pthread_cond_init(&shared->cond, NULL);
+	ASSERT(res == 0);
+
+	return shared;
+}
+
+static void _ExchangeShared_Release
+(
+	ExchangeShared *shared
+) {
+	if(__atomic_sub_fetch(&shared->ref_count, 1, __ATOMIC_ACQ_REL) > 0) {
+		return;
+	}
+
+	// last reference, all workers are done or cancelled
+	ASSERT(array_len(shared->ready) == 0);
+	array_free(shared->ready);
+	if(shared->error != NULL) free(shared->error);
+
+	pthread_cond_destroy(&shared->cond);
+	pthread_mutex_destroy(&shared->lock);
+
+	rm_free(shared->workers);
+	rm_free(shared);
+}
+
+// claims the next morsel
+// returns false if all morsels were claimed or the exchange was cancelled
+static bool _ExchangeShared_ClaimMorsel
+(
+	ExchangeShared *shared,
+	NodeID *min,
+	NodeID *max
+) {
+	if(__atomic_load_n(&shared->cancelled, __ATOMIC_RELAXED)) return false;
+
+	uint i = __atomic_fetch_add(&shared->next_morsel, 1, __ATOMIC_RELAXED);
+	if(i >= shared->morsel_count) return false;
+
+	GrB_Index end = (GrB_Index)(i + 1) * EXCHANGE_MORSEL_SIZE;
+	*min = (GrB_Index)i * EXCHANGE_MORSEL_SIZE;
+	*max = ((end < shared->nrows) ? end : shared->nrows) - 1;
+
+	return true;
+}
+
+// cancels helpers which are yet to start
+// expecting the shared lock to be held
+static void _ExchangeShared_CancelPending
+(
+	ExchangeShared *shared
+) {
+	for(uint i = 0; i < shared->worker_count; i++) {
+		ExchangeWorker *w = shared->workers + i;
+		if(w->state == WORKER_PENDING) w->state = WORKER_CANCELLED;
+	}
+}
+
+static void _DeleteRecords
+(
+	Record *records
+) {
+	uint n = array_len(records);
+	for(uint i = 0; i < n; i++) OpBase_DeleteRecord(records[i]);
+	array_free(records);
+}
+
+static void _ExchangeChunk_Free
+(
+	ExchangeChunk *chunk
+) {
+	_DeleteRecords(chunk->records);
+	rm_free(chunk);
+}
+
+//------------------------------------------------------------------------------
+// helper
+//------------------------------------------------------------------------------
+
+// returns handed off records to the worker's record pool
+static void _ExchangeWorker_ReturnSpent
+(
+	ExchangeWorker *w
+) {
+	ExchangeShared *shared = w->shared;
+
+	pthread_mutex_lock(&shared->lock);
+	Record *spent = w->spent;
+	w->spent = NULL;
+	pthread_mutex_unlock(&shared->lock);
+
+	if(spent != NULL) _DeleteRecords(spent);
+}
+
+// hands the worker's chunk over to the executing thread
+// returns false if the exchange was cancelled
+static bool _ExchangeWorker_Publish
+(
+	ExchangeWorker *w
+) {
+	ExchangeShared *shared = w->shared;
+	ExchangeChunk  *chunk  = w->chunk;
+
+	if(chunk == NULL || array_len(chunk->records) == 0) {
+		return !__atomic_load_n(&shared->cancelled, __ATOMIC_RELAXED);
+	}
+
+	pthread_mutex_lock(&shared->lock);
+
+	// wait for the executing thread to catch up
+	uint max_pending = shared->worker_count * EXCHANGE_PENDING_CHUNKS;
+	while(array_len(shared->ready) >= max_pending && !shared->cancelled) {
+		pthread_cond_wait(&shared->cond, &shared->lock);
+	}
+
+	bool cancelled = shared->cancelled;
+	if(!cancelled) {
+		array_append(shared->ready, chunk);
+		w->chunk = NULL;
+		pthread_cond_broadcast(&shared->cond);
+	}
+
+	pthread_mutex_unlock(&shared->lock);
+
+	return !cancelled;
+}
+
+static void _ExchangeWorker_Process
+(
+	ExchangeWorker *w
+) {
+	// set an exception-handling breakpoint to capture run-time errors
+	if(SET_EXCEPTION_HANDLER()) return;
+
+	NodeID min;
+	NodeID max;
+	Record batch[OP_BATCH_CAP];
+
+	while(_ExchangeShared_ClaimMorsel(w->shared, &min, &max)) {
+		_ExchangeWorker_ReturnSpent(w);
+
+		// position the pipeline on the claimed morsel
+		NodeByLabelScanOp_SetMorsel(w->scan, min, max);
+		if(!w->initialized) {
+			ExecutionPlan_Init((ExecutionPlan *)w->root->plan);
+			w->initialized = true;
+		} else {
+			OpBase_PropagateReset(w->root);
+		}
+
+		uint n;
+		while((n = OpBase_ConsumeBatch(w->root, batch, OP_BATCH_CAP)) > 0) {
+			if(w->chunk == NULL) {
+				w->chunk = rm_malloc(sizeof(ExchangeChunk));
+				w->chunk->owner = w;
+				w->chunk->records = array_new(Record, EXCHANGE_CHUNK_CAP);
+			}
+
+			for(uint i = 0; i < n; i++) {
+				// records are about to outlive the pipeline's state
+				Record_PersistScalars(batch[i]);
+				array_append(w->chunk->records, batch[i]);
+			}
+
+			if(array_len(w->chunk->records) >= EXCHANGE_CHUNK_CAP &&
+			   !_ExchangeWorker_Publish(w)) {
+				return;
+			}
+		}
+
+		if(!_ExchangeWorker_Publish(w)) return;
+	}
+}
+
+// helper thread entry point
+static void _ExchangeWorker_Run
+(
+	void *arg
+) {
+	ExchangeWorker *w      = (ExchangeWorker *)arg;
+	ExchangeShared *shared = w->shared;
+
+	pthread_mutex_lock(&shared->lock);
+	bool start = (w->state == WORKER_PENDING);
+	if(start) {
+		w->state = WORKER_RUNNING;
+		shared->running++;
+	}
+	pthread_mutex_unlock(&shared->lock);
+
+	if(start) {
+		// the executing thread holds the graph's read lock
+		// and waits for every running helper before releasing it
+		QueryCtx_SetTLS(shared->query_ctx);
+		rm_reset_n_alloced();
+
+		_ExchangeWorker_Process(w);
+
+		// collect error, if any
+		ErrorCtx *ctx = ErrorCtx_Get();
+		char *error = ctx->error;
+		ctx->error = NULL;
+		ErrorCtx_Clear();
+		QueryCtx_RemoveFromTLS();
+
+		pthread_mutex_lock(&shared->lock);
+		if(error != NULL) {
+			if(shared->error == NULL) shared->error = error;
+			else free(error);
+			shared->cancelled = true;
+		}
+		w->state = WORKER_DONE;
+		shared->running--;
+		pthread_cond_broadcast(&shared->cond);
+		pthread_mutex_unlock(&shared->lock);
+	}
+
+	_ExchangeShared_Release(shared);
+}
+
+//------------------------------------------------------------------------------
+// exchange
+//------------------------------------------------------------------------------
+
+OpBase *NewExchangeOp
+(
+	const ExecutionPlan *plan,
+	uint dop
+) {
+	ASSERT(dop > 1);
+
+	OpExchange *op = rm_calloc(1, sizeof(OpExchange));
+	op->dop = dop;
+
+	// set our Op operations
+	OpBase_Init((OpBase *)op, OPType_EXCHANGE, "Exchange", ExchangeInit,
+			ExchangeConsume, NULL, NULL, ExchangeClone, ExchangeFree, false,
+			plan);
+	OpBase_UpdateConsumeBatch((OpBase *)op, ExchangeConsumeBatch);
+
+	return (OpBase *)op;
+}
+
+static NodeByLabelScan *_PipelineTap
+(
+	OpBase *root
+) {
+	while(root->childCount > 0) root = root->children[0];
+	ASSERT(root->type == OPType_NODE_BY_LABEL_SCAN);
+	return (NodeByLabelScan *)root;
+}
+
+static OpResult ExchangeInit
+(
+	OpBase *opBase
+) {
+	OpExchange *op = (OpExchange *)opBase;
+	ASSERT(opBase->childCount == 1);
+
+	OpBase *pipeline = opBase->children[0];
+	op->scan = _PipelineTap(pipeline);
+
+	// missing label, nothing to parallelize
+	if(op->scan->n->label_id == GRAPH_UNKNOWN_LABEL) return OP_OK;
+
+	// split the scanned ID space into morsels
+	GrB_Index nrows;
+	RG_Matrix L = Graph_GetLabelMatrix(QueryCtx_GetGraph(),
+			op->scan->n->label_id);
+	GrB_Info info = RG_Matrix_nrows(&nrows, L);
+	ASSERT(info == GrB_SUCCESS);
+
+	uint morsel_count = (nrows + EXCHANGE_MORSEL_SIZE - 1) / EXCHANGE_MORSEL_SIZE;
+
+	// a single morsel isn't worth the overhead
+	if(morsel_count < 2) return OP_OK;
+
+	uint worker_count = op->dop - 1;
+	if(worker_count > morsel_count - 1) worker_count = morsel_count - 1;
+
+	ExchangeShared *shared =
+		_ExchangeShared_New(nrows, morsel_count, worker_count);
+	op->shared = shared;
+
+	// clone the pipeline for each helper
+	// cloning must take place before the pipeline is initialized
+	for(uint i = 0; i < worker_count; i++) {
+		ExchangeWorker *w = shared->workers + i;
+		w->shared = shared;
+		w->state  = WORKER_PENDING;
+		w->root   = ExecutionPlan_CloneOpTree(pipeline);
+		w->scan   = _PipelineTap(w->root);
+	}
+
+	// claim the first morsel for the executing thread
+	NodeID min;
+	NodeID max;
+	bool claimed = _ExchangeShared_ClaimMorsel(shared, &min, &max);
+	ASSERT(claimed == true);
+	UNUSED(claimed);
+
+	NodeByLabelScanOp_SetMorsel(op->scan, min, max);
+	op->active = true;
+
+	// schedule helpers, helpers which can't be scheduled are cancelled
+	for(uint i = 0; i < worker_count; i++) {
+		ExchangeWorker *w = shared->workers + i;
+		__atomic_fetch_add(&shared->ref_count, 1, __ATOMIC_RELAXED);
+		if(ThreadPools_AddWorkReader(_ExchangeWorker_Run, w, false) != 0) {
+			pthread_mutex_lock(&shared->lock);
+			w->state = WORKER_CANCELLED;
+			pthread_mutex_unlock(&shared->lock);
+			_ExchangeShared_Release(shared);
+		}
+	}
+
+	return OP_OK;
+}
+
+// transfers records of the current helper chunk into batch
+static uint _ExchangeHandOff
+(
+	OpExchange *op,
+	Record *batch,
+	uint cap
+) {
+	uint n = 0;
+	ExchangeChunk *chunk = op->chunk;
+	uint count = array_len(chunk->records);
+
+	while(n < cap && op->chunk_idx < count) {
+		Record src = chunk->records[op->chunk_idx++];
+		Record r = OpBase_CreateRecord((OpBase *)op);
+		Record_TransferEntries(&r, src, true);
+		batch[n++] = r;
+	}
+
+	if(op->chunk_idx == count) {
+		// chunk depleted, return its records to their producer
+		ExchangeShared *shared = op->shared;
+		ExchangeWorker *owner  = chunk->owner;
+
+		pthread_mutex_lock(&shared->lock);
+		if(owner->spent == NULL) {
+			owner->spent = chunk->records;
+		} else {
+			array_ensure_append(owner->spent, chunk->records, count, Record);
+			array_free(chunk->records);
+		}
+		pthread_mutex_unlock(&shared->lock);
+
+		rm_free(chunk);
+		op->chunk     = NULL;
+		op->chunk_idx = 0;
+	}
+
+	return n;
+}
+
+static uint _ExchangeNext
+(
+	OpExchange *op,
+	Record *batch,
+	uint cap
+) {
+	OpBase         *pipeline = op->op.children[0];
+	ExchangeShared *shared   = op->shared;
+
+	// pipeline isn't parallelized, pass through
+	if(shared == NULL) return OpBase_ConsumeBatch(pipeline, batch, cap);
+
+	while(true) {
+		// hand off records produced by helpers
+		if(op->chunk != NULL) return _ExchangeHandOff(op, batch, cap);
+
+		pthread_mutex_lock(&shared->lock);
+		if(array_len(shared->ready) > 0) {
+			op->chunk = array_pop(shared->ready);
+			pthread_cond_broadcast(&shared->cond);
+		}
+		pthread_mutex_unlock(&shared->lock);
+
+		if(op->chunk != NULL) continue;
+
+		// process current morsel
+		if(op->active) {
+			uint n = OpBase_ConsumeBatch(pipeline, batch, cap);
+			if(n > 0) return n;
+			op->active = false;
+		}
+
+		// claim next morsel
+		NodeID min;
+		NodeID max;
+		if(_ExchangeShared_ClaimMorsel(shared, &min, &max)) {
+			NodeByLabelScanOp_SetMorsel(op->scan, min, max);
+			OpBase_PropagateReset(pipeline);
+			op->active = true;
+			continue;
+		}
+
+		// no morsels left, wait for running helpers
+		pthread_mutex_lock(&shared->lock);
+		_ExchangeShared_CancelPending(shared);
+		while(array_len(shared->ready) == 0 && shared->running > 0) {
+			pthread_cond_wait(&shared->cond, &shared->lock);
+		}
+		bool depleted = (array_len(shared->ready) == 0);
+		const char *error = shared->error;
+		pthread_mutex_unlock(&shared->lock);
+
+		if(error != NULL) ErrorCtx_RaiseRuntimeException("%s", error);
+		if(depleted) return 0;
+	}
+}
+
+static Record ExchangeConsume
+(
+	OpBase *opBase
+) {
+	Record r;
+	return (_ExchangeNext((OpExchange *)opBase, &r, 1) == 1) ? r : NULL;
+}
+
+static uint ExchangeConsumeBatch
+(
+	OpBase *opBase,
+	Record *batch,
+	uint cap
+) {
+	return _ExchangeNext((OpExchange *)opBase, batch, cap);
+}
+
+static OpBase *ExchangeClone
+(
+	const ExecutionPlan *plan,
+	const OpBase *opBase
+) {
+	ASSERT(opBase->type == OPType_EXCHANGE);
+	OpExchange *op = (OpExchange *)opBase;
+	return NewExchangeOp(plan, op->dop);
+}
+
+static void ExchangeFree
+(
+	OpBase *opBase
+) {
+	OpExchange *op = (OpExchange *)opBase;
+	ExchangeShared *shared = op->shared;
+	if(shared == NULL) return;
+
+	// stop helpers and wait for the running ones to exit
+	pthread_mutex_lock(&shared->lock);
+	shared->cancelled = true;
+	_ExchangeShared_CancelPending(shared);
+	pthread_cond_broadcast(&shared->cond);
+	while(shared->running > 0) {
+		pthread_cond_wait(&shared->cond, &shared->lock);
+	}
+	pthread_mutex_unlock(&shared->lock);
+
+	// helpers are idle, their record pools can be accessed
+	if(op->chunk != NULL) {
+		_ExchangeChunk_Free(op->chunk);
+		op->chunk = NULL;
+	}
+
+	uint n = array_len(shared->ready);
+	for(uint i = 0; i < n; i++) _ExchangeChunk_Free(shared->ready[i]);
+	array_clear(shared->ready);
+
+	for(uint i = 0; i < shared->worker_count; i++) {
+		ExchangeWorker *w = shared->workers + i;
+		if(w->spent != NULL) _DeleteRecords(w->spent);
+		if(w->chunk != NULL) _ExchangeChunk_Free(w->chunk);
+		ExecutionPlan_Free((ExecutionPlan *)w->root->plan);
+		w->spent = NULL;
+		w->chunk = NULL;
+		w->root  = NULL;
+	}
+
+	_ExchangeShared_Release(shared);
+	op->shared = NULL;
+}
@@ -0,0 +1,42 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "op.h"
+#include "op_node_by_label_scan.h"
+#include "../execution_plan.h"
+
+// the Exchange operation parallelizes the pipeline below it
+// the pipeline is a linear chain of streaming operations tapped by a label scan
+// the scanned ID range is split into fixed size morsels which are claimed
+// on demand by the executing thread and by up to `dop - 1` helper threads
+// each helper runs its own clone of the pipeline on a reader thread and hands
+// its records over to the executing thread, where they're merged into
+// a single stream
+
+// number of node IDs in a single morsel
+#define EXCHANGE_MORSEL_SIZE 16384
+
+typedef struct ExchangeShared ExchangeShared;
+typedef struct ExchangeChunk ExchangeChunk;
+
+typedef struct {
+	OpBase op;
+	uint dop;               // max degree of parallelism
+	NodeByLabelScan *scan;  // pipeline tap
+	bool active;            // scan is positioned on a morsel
+	ExchangeShared *shared; // state shared with helper threads
+	ExchangeChunk *chunk;   // helper records being handed off
+	uint chunk_idx;         // next record to hand off from chunk
+} OpExchange;
+
+// creates a new Exchange operation
+OpBase *NewExchangeOp
+(
+	const ExecutionPlan *plan,  // execution plan
+	uint dop                    // max degree of parallelism
+);
@@ -8,9 +8,6 @@
 #include "shared/print_functions.h"
 #include "../../query_ctx.h"
 
-// default number of records to accumulate before traversing
-#define BATCH_SIZE 16
-
 // forward declarations
 static OpResult ExpandIntoInit(OpBase *opBase);
 static Record ExpandIntoConsume(OpBase *opBase);
@@ -95,7 +92,9 @@ OpBase *NewExpandIntoOp
 	op->graph           =  g;
 	op->records         =  NULL;
 	op->edge_ctx        =  NULL;
-	op->record_cap      =  BATCH_SIZE;
+	op->record_cap      =  UNLIMITED;
+	op->emitted         =  0;
+	op->batch_count     =  0;
 	op->record_count    =  0;
 	op->single_operand  =  false;
 
@@ -163,9 +162,10 @@ static OpResult ExpandIntoInit
 
 	// create 'records' within this Init function as 'record_cap'
 	// might be set during optimization time (applyLimit)
-	// If cap greater than BATCH_SIZE is specified,
-	// use BATCH_SIZE as the value.
-	if(op->record_cap > BATCH_SIZE) op->record_cap = BATCH_SIZE;
+	// the batch size adapts within [1, record_cap], both 'records'
+	// and the filter matrix are sized for the largest batch
+	TraverseBatch_Init(&op->batch, op->record_cap);
+	op->record_cap = op->batch.cap;
 
 	op->records = rm_calloc(op->record_cap, sizeof(Record));
 
@@ -277,9 +277,15 @@ static Record ExpandIntoConsume
 		// get data
 		//----------------------------------------------------------------------
 
-		// ask child operation for at most 'record_cap' records
+		// adjust batch size according to the last batch's throughput
+		if(op->batch_count > 0) {
+			TraverseBatch_Update(&op->batch, op->batch_count, op->emitted);
+		}
+		op->emitted = 0;
+
+		// ask child operation for at most 'batch.size' records
 		int i = 0;
-		for(; i < op->record_cap; i++) {
+		for(; i < op->batch.size; i++) {
 			r = OpBase_Consume(child);
 			// did not manage to get new data, break
 			if(r == NULL) break;
@@ -301,6 +307,7 @@ static Record ExpandIntoConsume
 			op->records[i] = r;
 		}
 		op->record_count = i;
+		op->batch_count  = i;
 
 		// did not managed to produce data, depleted
 		if(op->record_count == 0) return NULL;
@@ -308,6 +315,7 @@ static Record ExpandIntoConsume
 		if(!op->single_operand) _traverse(op);
 	}
 
+	op->emitted++;
 	return r;
 }
 
@@ -326,6 +334,8 @@ static OpResult ExpandIntoReset
 		OpBase_DeleteRecord(op->records[i]);
 	}
 	op->record_count = 0;
+	op->batch_count  = 0;
+	op->emitted      = 0;
 
 	if(op->edge_ctx != NULL) EdgeTraverseCtx_Reset(op->edge_ctx);
 
@@ -341,7 +351,7 @@ static inline OpBase *ExpandIntoClone
 
 	OpExpandInto *op = (OpExpandInto *)opBase;
 
-	return NewExpandIntoOp(plan, op->graph, AlgebraicExpression_Clone(op->ae));
+	return NewExpandIntoOp(plan, QueryCtx_GetGraph(), AlgebraicExpression_Clone(op->ae));
 }
 
 // frees ExpandInto
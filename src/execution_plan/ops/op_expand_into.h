@@ -25,6 +25,9 @@ typedef struct {
 	bool single_operand;        // expression contains a single operand
 	uint record_count;          // number of held records
 	uint record_cap;            // max number of records to process
+	TraverseBatch batch;        // adaptive number of records to process
+	uint batch_count;           // number of records in current batch
+	uint64_t emitted;           // number of records emitted by current batch
 	Record *records;            // array of records
 	Record r;                   // currently selected record
 } OpExpandInto;
@@ -9,16 +9,21 @@
 
 /* Forward declarations. */
 static Record FilterConsume(OpBase *opBase);
+static uint FilterConsumeBatch(OpBase *opBase, Record *batch, uint cap);
 static OpBase *FilterClone(const ExecutionPlan *plan, const OpBase *opBase);
 static void FilterFree(OpBase *opBase);
 
 OpBase *NewFilterOp(const ExecutionPlan *plan, FT_FilterNode *filterTree) {
 	OpFilter *op = rm_malloc(sizeof(OpFilter));
-	op->filterTree = filterTree;
+	op->filterTree   = filterTree;
+	op->batch_filter = NULL;
+	op->compiled     = false;
+	op->batch_count  = 0;
 
 	// Set our Op operations
 	OpBase_Init((OpBase *)op, OPType_FILTER, "Filter", NULL, FilterConsume,
 				NULL, NULL, FilterClone, FilterFree, false, plan);
+	OpBase_UpdateConsumeBatch((OpBase *)op, FilterConsumeBatch);
 
 	return (OpBase *)op;
 }
@@ -42,6 +47,62 @@ static Record FilterConsume(OpBase *opBase) {
 	return r;
 }
 
+/* FilterConsumeBatch
+ * pulls batches from child until at least one record passes
+ * passing records are compacted into the output batch. */
+static uint FilterConsumeBatch(OpBase *opBase, Record *batch, uint cap) {
+	uint n = 0;
+	OpFilter *filter = (OpFilter *)opBase;
+	OpBase *child = filter->op.children[0];
+	Record *input = filter->batch;
+
+	// compile filter tree on first batch
+	// parameters are only available at execution time
+	if(!filter->compiled) {
+		filter->batch_filter = BatchFilter_Compile(filter->filterTree);
+		filter->compiled = true;
+	}
+
+	// rejected records are freed and their slot cleared right away
+	// such that an error raised mid-batch leaves only live records in
+	// 'filter->batch', to be freed by FilterFree
+	while(n == 0) {
+		uint count = OpBase_ConsumeBatch(child, input, MIN(cap, OP_BATCH_CAP));
+		if(count == 0) break;
+		filter->batch_count = count;
+
+		if(filter->batch_filter != NULL) {
+			// evaluate the entire batch at once
+			for(uint offset = 0; offset < count; offset += BATCH_FILTER_CAP) {
+				uint len = MIN(BATCH_FILTER_CAP, count - offset);
+				uint64_t selected = BatchFilter_Apply(filter->batch_filter,
+						input + offset, len);
+
+				for(uint i = 0; i < len; i++) {
+					if(selected & (1ULL << i)) continue;
+					OpBase_DeleteRecord(input[offset + i]);
+					input[offset + i] = NULL;
+				}
+			}
+		} else {
+			/* Pass each record through filter tree */
+			for(uint i = 0; i < count; i++) {
+				if(FilterTree_applyFilters(filter->filterTree, input[i]) ==
+						FILTER_PASS) continue;
+				OpBase_DeleteRecord(input[i]);
+				input[i] = NULL;
+			}
+		}
+
+		for(uint i = 0; i < count; i++) {
+			if(input[i] != NULL) batch[n++] = input[i];
+		}
+		filter->batch_count = 0;
+	}
+
+	return n;
+}
+
 static inline OpBase *FilterClone(const ExecutionPlan *plan, const OpBase *opBase) {
 	ASSERT(opBase->type == OPType_FILTER);
 	OpFilter *op = (OpFilter *)opBase;
@@ -51,9 +112,20 @@ static inline OpBase *FilterClone(const ExecutionPlan *plan, const OpBase *opBas
 /* Frees OpFilter*/
 static void FilterFree(OpBase *ctx) {
 	OpFilter *filter = (OpFilter *)ctx;
+	if(filter->batch_filter) {
+		BatchFilter_Free(filter->batch_filter);
+		filter->batch_filter = NULL;
+	}
+
 	if(filter->filterTree) {
 		FilterTree_Free(filter->filterTree);
 		filter->filterTree = NULL;
 	}
+
+	// free batch left over by an error
+	for(uint i = 0; i < filter->batch_count; i++) {
+		if(filter->batch[i] != NULL) OpBase_DeleteRecord(filter->batch[i]);
+	}
+	filter->batch_count = 0;
 }
 
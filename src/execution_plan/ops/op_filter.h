@@ -9,12 +9,17 @@
 #include "op.h"
 #include "../execution_plan.h"
 #include "../../filter_tree/filter_tree.h"
+#include "../../filter_tree/batch_filter.h"
 
 /* Filter
  * filters graph according to where cluase */
 typedef struct {
 	OpBase op;
 	FT_FilterNode *filterTree;
+	BatchFilter *batch_filter;  // compiled filter tree, NULL if not compilable
+	bool compiled;              // true if compilation was attempted
+	uint batch_count;           // number of records in the batch being filtered
+	Record batch[OP_BATCH_CAP]; // input batch (stored to free if we encounter an error)
 } OpFilter;
 
 /* Creates a new Filter operation */
@@ -7,7 +7,7 @@
 #include "op_node_by_index_scan.h"
 #include "../../query_ctx.h"
 #include "shared/print_functions.h"
-#include "../../filter_tree/ft_to_rsq.h"
+#include "../../filter_tree/ft_to_range.h"
 
 // forward declarations
 static OpResult IndexScanInit(OpBase *opBase);
@@ -22,7 +22,7 @@ static void IndexScanToString(const OpBase *ctx, sds *buf) {
 }
 
 OpBase *NewIndexScanOp(const ExecutionPlan *plan, Graph *g, NodeScanCtx *n,
-		RSIndex *idx, FT_FilterNode *filter) {
+		Index idx, FT_FilterNode *filter) {
 	// validate inputs
 	ASSERT(g      != NULL);
 	ASSERT(idx    != NULL);
@@ -73,6 +73,13 @@ static OpResult IndexScanInit(OpBase *opBase) {
 	return OP_OK;
 }
 
+// create an iterator over the index entries matching 'filter'
+static void _BuildIterator(IndexScan *op, const FT_FilterNode *filter) {
+	RangeQuery *q = FilterTreeToRangeQuery(&op->unresolved_filters, filter,
+			op->idx);
+	op->iter = RangeIndex_Query(Index_RangeIndex(op->idx), q);
+}
+
 static inline void _UpdateRecord(IndexScan *op, Record r, EntityID node_id) {
 	// Populate the Record with the graph entity data.
 	Node n = GE_NEW_NODE();
@@ -89,7 +96,7 @@ static inline bool _PassUnresolvedFilters(const IndexScan *op, Record r) {
 
 static Record IndexScanConsumeFromChild(OpBase *opBase) {
 	IndexScan *op = (IndexScan *)opBase;
-	const EntityID *nodeId = NULL;
+	EntityID nodeId;
 
 pull_index:
 	//--------------------------------------------------------------------------
@@ -97,10 +104,9 @@ pull_index:
 	//--------------------------------------------------------------------------
 
 	if(op->iter != NULL && op->child_record != NULL) {
-		while((nodeId = RediSearch_ResultsIteratorNext(op->iter, op->idx, NULL))
-				!= NULL) {
+		while(RangeIndexIterator_Next(op->iter, &nodeId, NULL, NULL)) {
 			// populate record with node
-			_UpdateRecord(op, op->child_record, *nodeId);
+			_UpdateRecord(op, op->child_record, nodeId);
 			// apply unresolved filters
 			if(_PassUnresolvedFilters(op, op->child_record)) {
 				// clone the held Record, as it will be freed upstream
@@ -133,7 +139,7 @@ pull_index:
 	if(op->rebuild_index_query) {
 		// free previous iterator
 		if(op->iter != NULL) {
-			RediSearch_ResultsIteratorFree(op->iter);
+			RangeIndexIterator_Free(op->iter);
 			op->iter = NULL;
 		}
 
@@ -157,25 +163,18 @@ pull_index:
 		}
 		#endif
 
-		// convert filter into a RediSearch query
-		RSQNode *rs_query_node = FilterTreeToQueryNode(&op->unresolved_filters,
-				filter, op->idx);
+		// convert filter into an index query and create iterator
+		_BuildIterator(op, filter);
 		FilterTree_Free(filter);
-
-		// create iterator
-		ASSERT(rs_query_node != NULL);
-		op->iter = RediSearch_GetResultsIterator(rs_query_node, op->idx);
 	} else {
 		// build index query only once (first call)
 		// reset it if already initialized
 		if(op->iter == NULL) {
 			// first call to consume, create query and iterator
-			RSQNode *rs_query_node = FilterTreeToQueryNode(&op->unresolved_filters, op->filter, op->idx);
-			ASSERT(rs_query_node != NULL);
-			op->iter = RediSearch_GetResultsIterator(rs_query_node, op->idx);
+			_BuildIterator(op, op->filter);
 		} else {
 			// reset existing iterator
-			RediSearch_ResultsIteratorReset(op->iter);
+			RangeIndexIterator_Reset(op->iter);
 		}
 	}
 
@@ -187,21 +186,15 @@ static Record IndexScanConsume(OpBase *opBase) {
 	IndexScan *op = (IndexScan *)opBase;
 
 	// create iterator on first call
-	if(op->iter == NULL) {
-		RSQNode *rs_query_node = FilterTreeToQueryNode(&op->unresolved_filters,
-				op->filter, op->idx);
-
-		op->iter = RediSearch_GetResultsIterator(rs_query_node, op->idx);
-	}
+	if(op->iter == NULL) _BuildIterator(op, op->filter);
 
-	const EntityID *nodeId = NULL;
+	EntityID nodeId;
 
 	// populate the Record with the actual node
 	Record r = OpBase_CreateRecord((OpBase *)op);
-	while((nodeId = RediSearch_ResultsIteratorNext(op->iter, op->idx, NULL))
-			!= NULL) {
+	while(RangeIndexIterator_Next(op->iter, &nodeId, NULL, NULL)) {
 		// populate record with node
-		_UpdateRecord(op, r, *nodeId);
+		_UpdateRecord(op, r, nodeId);
 		// apply unresolved filters
 		if(_PassUnresolvedFilters(op, r)) {
 			return r;
@@ -217,7 +210,7 @@ static OpResult IndexScanReset(OpBase *opBase) {
 	IndexScan *op = (IndexScan *)opBase;
 
 	if(op->iter) {
-		RediSearch_ResultsIteratorFree(op->iter);
+		RangeIndexIterator_Free(op->iter);
 		op->iter = NULL;
 	}
 
@@ -231,12 +224,8 @@ static OpResult IndexScanReset(OpBase *opBase) {
 
 static void IndexScanFree(OpBase *opBase) {
 	IndexScan *op = (IndexScan *)opBase;
-	/* As long as this Index iterator is alive the index is
-	 * read locked, if this index scan operation is part of
-	 * a query which will modified this index we'll be stuck in
-	 * a dead lock, as we're unable to acquire index write lock. */
 	if(op->iter != NULL) {
-		RediSearch_ResultsIteratorFree(op->iter);
+		RangeIndexIterator_Free(op->iter);
 		op->iter = NULL;
 	}
 
@@ -11,16 +11,15 @@
 #include "../../graph/graph.h"
 #include "../../index/index.h"
 #include "shared/scan_functions.h"
-#include "redisearch_api.h"
 
 typedef struct {
 	OpBase op;
 	Graph *g;
-	bool rebuild_index_query;           // should we rebuild RediSearch index query for each input record
-	RSIndex *idx;                       // index to query
+	bool rebuild_index_query;           // should we rebuild index query for each input record
+	Index idx;                          // index to query
 	NodeScanCtx *n;                     // label data of node being scanned
 	uint nodeRecIdx;                    // index of the node being scanned in the Record
-	RSResultsIterator *iter;            // rediSearch iterator over an index with the appropriate filters
+	RangeIndexIterator *iter;           // iterator over an index with the appropriate filters
 	FT_FilterNode *filter;              // filter from which to compose index query
 	FT_FilterNode *unresolved_filters;  // subset of filter, contains filters that couldn't be resolved by index
 	Record child_record;                // the Record this op acts on if it is not a tap
@@ -28,5 +27,5 @@ typedef struct {
 
 // creates a new IndexScan operation
 OpBase *NewIndexScanOp(const ExecutionPlan *plan, Graph *g, NodeScanCtx *n,
-		RSIndex *idx, FT_FilterNode *filter);
+		Index idx, FT_FilterNode *filter);
 
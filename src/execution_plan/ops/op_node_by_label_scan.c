@@ -14,6 +14,7 @@
 static OpResult NodeByLabelScanInit(OpBase *opBase);
 static Record NodeByLabelScanConsume(OpBase *opBase);
 static Record NodeByLabelScanConsumeFromChild(OpBase *opBase);
+static uint NodeByLabelScanConsumeBatch(OpBase *opBase, Record *batch, uint cap);
 static Record NodeByLabelScanNoOp(OpBase *opBase);
 static OpResult NodeByLabelScanReset(OpBase *opBase);
 static OpBase *NodeByLabelScanClone(const ExecutionPlan *plan, const OpBase *opBase);
@@ -75,6 +76,20 @@ void NodeByLabelScanOp_SetIDRange
 	op->op.name = "Node By Label and ID Scan";
 }
 
+void NodeByLabelScanOp_SetMorsel
+(
+	NodeByLabelScan *op,
+	NodeID min,
+	NodeID max
+) {
+	ASSERT(min <= max);
+
+	UnsignedRange_Free(op->id_range);
+	op->id_range = UnsignedRange_New();
+	UnsignedRange_TightenRange(op->id_range, OP_GE, min);
+	UnsignedRange_TightenRange(op->id_range, OP_LE, max);
+}
+
 static GrB_Info _ConstructIterator
 (
 	NodeByLabelScan *op
@@ -112,16 +127,19 @@ static OpResult NodeByLabelScanInit
 ) {
 	NodeByLabelScan *op = (NodeByLabelScan *)opBase;
 	OpBase_UpdateConsume(opBase, NodeByLabelScanConsume); // default consume function
+	OpBase_UpdateConsumeBatch(opBase, NodeByLabelScanConsumeBatch);
 
 	// operation has children, consume from child
 	if(opBase->childCount > 0) {
 		OpBase_UpdateConsume(opBase, NodeByLabelScanConsumeFromChild);
+		OpBase_UpdateConsumeBatch(opBase, NULL);
 		return OP_OK;
 	}
 
 	if(op->n->label_id == GRAPH_UNKNOWN_LABEL) {
 		// missing schema, use the NOP consume function
 		OpBase_UpdateConsume(opBase, NodeByLabelScanNoOp);
+		OpBase_UpdateConsumeBatch(opBase, NULL);
 		return OP_OK;
 	}	
 
@@ -130,6 +148,7 @@ static OpResult NodeByLabelScanInit
 	if(iterator_built != GrB_SUCCESS) {
 		// invalid range, use the NOP consume function
 		OpBase_UpdateConsume(opBase, NodeByLabelScanNoOp);
+		OpBase_UpdateConsumeBatch(opBase, NULL);
 		return OP_OK;
 	}
 
@@ -218,6 +237,28 @@ static Record NodeByLabelScanConsume(OpBase *opBase) {
 	return r;
 }
 
+// fills batch with up to cap nodes, one record per node
+static uint NodeByLabelScanConsumeBatch
+(
+	OpBase *opBase,
+	Record *batch,
+	uint cap
+) {
+	NodeByLabelScan *op = (NodeByLabelScan *)opBase;
+
+	uint n = 0;
+	GrB_Index nodeId;
+	while(n < cap &&
+		  RG_MatrixTupleIter_next_BOOL(&op->iter, &nodeId, NULL, NULL) ==
+		  GrB_SUCCESS) {
+		Record r = OpBase_CreateRecord(opBase);
+		_UpdateRecord(op, r, nodeId);
+		batch[n++] = r;
+	}
+
+	return n;
+}
+
 // this function is invoked when the op has no children
 // and no valid label is requested (either no label, or non existing label)
 // the op simply needs to return NULL
@@ -37,3 +37,13 @@ OpBase *NewNodeByLabelScanOp
 /* Transform a simple label scan to perform additional range query over the label  matrix. */
 void NodeByLabelScanOp_SetIDRange(NodeByLabelScan *op, UnsignedRange *id_range);
 
+// restrict the scan to the morsel [min, max]
+// unlike NodeByLabelScanOp_SetIDRange the op remains a simple label scan
+// the new range takes effect on the next init or reset
+void NodeByLabelScanOp_SetMorsel
+(
+	NodeByLabelScan *op,  // scan op
+	NodeID min,           // first node ID of the morsel
+	NodeID max            // last node ID of the morsel
+);
+
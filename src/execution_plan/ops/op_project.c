@@ -13,6 +13,7 @@
 
 /* Forward declarations. */
 static Record ProjectConsume(OpBase *opBase);
+static uint ProjectConsumeBatch(OpBase *opBase, Record *batch, uint cap);
 static OpResult ProjectReset(OpBase *opBase);
 static OpBase *ProjectClone(const ExecutionPlan *plan, const OpBase *opBase);
 static void ProjectFree(OpBase *opBase);
@@ -25,10 +26,12 @@ OpBase *NewProjectOp(const ExecutionPlan *plan, AR_ExpNode **exps) {
 	op->record_offsets = array_new(uint, op->exp_count);
 	op->r = NULL;
 	op->projection = NULL;
+	op->batch_count = 0;
 
 	// Set our Op operations
 	OpBase_Init((OpBase *)op, OPType_PROJECT, "Project", NULL, ProjectConsume,
 				ProjectReset, NULL, ProjectClone, ProjectFree, false, plan);
+	OpBase_UpdateConsumeBatch((OpBase *)op, ProjectConsumeBatch);
 
 	for(uint i = 0; i < op->exp_count; i ++) {
 		// The projected record will associate values with their resolved name
@@ -40,26 +43,12 @@ OpBase *NewProjectOp(const ExecutionPlan *plan, AR_ExpNode **exps) {
 	return (OpBase *)op;
 }
 
-static Record ProjectConsume(OpBase *opBase) {
-	OpProject *op = (OpProject *)opBase;
-
-	if(op->op.childCount) {
-		OpBase *child = op->op.children[0];
-		op->r = OpBase_Consume(child);
-		if(!op->r) return NULL;
-	} else {
-		// QUERY: RETURN 1+2
-		// Return a single record followed by NULL on the second call.
-		if(op->singleResponse) return NULL;
-		op->singleResponse = true;
-		op->r = OpBase_CreateRecord(opBase);
-	}
-
-	op->projection = OpBase_CreateRecord(opBase);
-
+// evaluates each projected expression against r
+// and sets the result in the projection record
+static void _project(OpProject *op, Record r, Record projection) {
 	for(uint i = 0; i < op->exp_count; i++) {
 		AR_ExpNode *exp = op->exps[i];
-		SIValue v = AR_EXP_Evaluate(exp, op->r);
+		SIValue v = AR_EXP_Evaluate(exp, r);
 		int rec_idx = op->record_offsets[i];
 
 		// persisting a value is only necessary when
@@ -73,7 +62,7 @@ static Record ProjectConsume(OpBase *opBase) {
 		// the logic of when to persist can be improved
 
 		if(!(v.type & SI_GRAPHENTITY)) SIValue_Persist(&v);
-		Record_Add(op->projection, rec_idx, v);
+		Record_Add(projection, rec_idx, v);
 
 		// if the value was a graph entity with its own allocation
 		// as with a query like:
@@ -83,6 +72,26 @@ static Record ProjectConsume(OpBase *opBase) {
 			SIValue_Free(v);
 		}
 	}
+}
+
+static Record ProjectConsume(OpBase *opBase) {
+	OpProject *op = (OpProject *)opBase;
+
+	if(op->op.childCount) {
+		OpBase *child = op->op.children[0];
+		op->r = OpBase_Consume(child);
+		if(!op->r) return NULL;
+	} else {
+		// QUERY: RETURN 1+2
+		// Return a single record followed by NULL on the second call.
+		if(op->singleResponse) return NULL;
+		op->singleResponse = true;
+		op->r = OpBase_CreateRecord(opBase);
+	}
+
+	op->projection = OpBase_CreateRecord(opBase);
+
+	_project(op, op->r, op->projection);
 
 	OpBase_DeleteRecord(op->r);
 	op->r = NULL;
@@ -93,6 +102,40 @@ static Record ProjectConsume(OpBase *opBase) {
 	return projection;
 }
 
+// projects an entire batch of child records
+static uint ProjectConsumeBatch(OpBase *opBase, Record *batch, uint cap) {
+	OpProject *op = (OpProject *)opBase;
+
+	// QUERY: RETURN 1+2
+	// a single record is produced, no batching required
+	if(op->op.childCount == 0) {
+		Record r = ProjectConsume(opBase);
+		if(r == NULL) return 0;
+		batch[0] = r;
+		return 1;
+	}
+
+	OpBase *child = op->op.children[0];
+	uint n = OpBase_ConsumeBatch(child, op->batch, MIN(cap, OP_BATCH_CAP));
+	op->batch_count = n;
+
+	for(uint i = 0; i < n; i++) {
+		op->projections[i] = OpBase_CreateRecord(opBase);
+	}
+
+	for(uint i = 0; i < n; i++) {
+		_project(op, op->batch[i], op->projections[i]);
+	}
+
+	for(uint i = 0; i < n; i++) {
+		OpBase_DeleteRecord(op->batch[i]);
+		batch[i] = op->projections[i];
+	}
+	op->batch_count = 0;
+
+	return n;
+}
+
 static OpResult ProjectReset(OpBase *opBase) {
 	OpProject *op = (OpProject *)opBase;
 	op->singleResponse = false;
@@ -150,4 +193,11 @@ static void ProjectFree(OpBase *ctx) {
 		OpBase_DeleteRecord(op->projection);
 		op->projection = NULL;
 	}
+
+	// free batch left over by an error
+	for(uint i = 0; i < op->batch_count; i++) {
+		OpBase_DeleteRecord(op->batch[i]);
+		OpBase_DeleteRecord(op->projections[i]);
+	}
+	op->batch_count = 0;
 }
@@ -18,6 +18,9 @@ typedef struct {
 	uint *record_offsets;           // Record IDs corresponding to each projection (including order exps).
 	bool singleResponse;            // When no child operations, return NULL after a first response.
 	uint exp_count;                 // Number of projected expressions.
+	uint batch_count;               // Number of records in the batch being projected.
+	Record batch[OP_BATCH_CAP];     // Input batch (stored to free if we encounter an error).
+	Record projections[OP_BATCH_CAP];  // Projected batch (stored to free if we encounter an error).
 } OpProject;
 
 OpBase *NewProjectOp(const ExecutionPlan *plan, AR_ExpNode **exps);
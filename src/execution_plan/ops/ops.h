@@ -20,6 +20,7 @@
 #include "op_unwind.h"
 #include "op_results.h"
 #include "op_project.h"
+#include "op_exchange.h"
 #include "op_foreach.h"
 #include "op_optional.h"
 #include "op_argument.h"
@@ -66,35 +66,38 @@ static void _CommitNodes
 	// sync policy should be set to NOP, no need to sync/resize
 	ASSERT(Graph_GetMatrixPolicy(g) == SYNC_POLICY_NOP);
 
-	for(int i = 0; i < node_count; i++) {
+	// introduce nodes into graph in bulk
+	uint *label_counts = rm_malloc(sizeof(uint) * node_count);
+	for(uint i = 0; i < node_count; i++) {
+		label_counts[i] = array_len(pending->node_labels[i]);
+	}
+
+	CreateNodes(gc, pending->created_nodes, pending->node_labels, label_counts,
+			pending->node_attributes, node_count, true);
+
+	//--------------------------------------------------------------------------
+	// enforce constraints
+	//--------------------------------------------------------------------------
+
+	for(uint i = 0; i < node_count && !constraint_violation; i++) {
 		n = pending->created_nodes[i];
+		int *labels = pending->node_labels[i];
 
-		AttributeSet attr        = pending->node_attributes[i];
-		int*         labels      = pending->node_labels[i];
-		uint         label_count = array_len(labels);
-
-		// introduce node into graph
-		CreateNode(gc, n, labels, label_count, attr, true);
-
-		//----------------------------------------------------------------------
-		// enforce constraints
-		//----------------------------------------------------------------------
-
-		if(constraint_violation == false) {
-			for(uint j = 0; j < label_count; j++) {
-				Schema *s = GraphContext_GetSchemaByID(gc, labels[j], SCHEMA_NODE);
-				char *err_msg = NULL;
-				if(!Schema_EnforceConstraints(s, (GraphEntity*)n, &err_msg)) {
-					// constraint violation
-					ASSERT(err_msg != NULL);
-					constraint_violation = true;
-					ErrorCtx_SetError("%s", err_msg);
-					free(err_msg);
-					break;
-				}
+		for(uint j = 0; j < label_counts[i]; j++) {
+			Schema *s = GraphContext_GetSchemaByID(gc, labels[j], SCHEMA_NODE);
+			char *err_msg = NULL;
+			if(!Schema_EnforceConstraints(s, (GraphEntity*)n, &err_msg)) {
+				// constraint violation
+				ASSERT(err_msg != NULL);
+				constraint_violation = true;
+				ErrorCtx_SetError("%s", err_msg);
+				free(err_msg);
+				break;
 			}
 		}
 	}
+
+	rm_free(label_counts);
 }
 
 // commit edge blueprints
@@ -144,32 +147,34 @@ static void _CommitEdges
 	// sync policy should be set to NOP, no need to sync/resize
 	ASSERT(Graph_GetMatrixPolicy(g) == SYNC_POLICY_NOP);
 
-	for(int i = 0; i < edge_count; i++) {
+	// resolve edges relation type
+	// all schemas have been created in the edge blueprint loop or earlier
+	for(uint i = 0; i < edge_count; i++) {
 		e = pending->created_edges[i];
-		NodeID src_id  = Edge_GetSrcNodeID(e);
-		NodeID dest_id = Edge_GetDestNodeID(e);
-		AttributeSet attr = pending->edge_attributes[i];
-
 		Schema *s = GraphContext_GetSchema(gc, e->relationship, SCHEMA_EDGE);
-		// all schemas have been created in the edge blueprint loop or earlier
 		ASSERT(s != NULL);
-		int relation_id = Schema_GetID(s);
+		Edge_SetRelationID(e, Schema_GetID(s));
+	}
 
-		CreateEdge(gc, e, src_id, dest_id, relation_id, attr, true);
+	// introduce edges into graph in bulk
+	CreateEdges(gc, pending->created_edges, pending->edge_attributes,
+			edge_count, true);
 
-		//----------------------------------------------------------------------
-		// enforce constraints
-		//----------------------------------------------------------------------
+	//--------------------------------------------------------------------------
+	// enforce constraints
+	//--------------------------------------------------------------------------
 
-		if(constraint_violation == false) {
-			char *err_msg = NULL;
-			if(!Schema_EnforceConstraints(s, (GraphEntity*)e, &err_msg)) {
-				// constraint violated!
-				ASSERT(err_msg != NULL);
-				constraint_violation = true;
-				ErrorCtx_SetError("%s", err_msg);
-				free(err_msg);
-			}
+	for(uint i = 0; i < edge_count && !constraint_violation; i++) {
+		e = pending->created_edges[i];
+		Schema *s = GraphContext_GetSchemaByID(gc, Edge_GetRelationID(e),
+				SCHEMA_EDGE);
+		char *err_msg = NULL;
+		if(!Schema_EnforceConstraints(s, (GraphEntity*)e, &err_msg)) {
+			// constraint violated!
+			ASSERT(err_msg != NULL);
+			constraint_violation = true;
+			ErrorCtx_SetError("%s", err_msg);
+			free(err_msg);
 		}
 	}
 }
@@ -169,3 +169,36 @@ void EdgeTraverseCtx_Free
 	rm_free(edge_ctx);
 }
 
+
+void TraverseBatch_Init
+(
+	TraverseBatch *batch,
+	uint cap
+) {
+	ASSERT(batch != NULL);
+
+	if(cap > TRAVERSE_BATCH_MAX) cap = TRAVERSE_BATCH_MAX;
+
+	batch->cap  = cap;
+	batch->size = (cap < TRAVERSE_BATCH_MIN) ? cap : TRAVERSE_BATCH_MIN;
+}
+
+void TraverseBatch_Update
+(
+	TraverseBatch *batch,
+	uint input,
+	uint64_t output
+) {
+	ASSERT(batch != NULL);
+
+	uint64_t max_output = (uint64_t)input * TRAVERSE_BATCH_FANOUT;
+
+	if(output > max_output) {
+		// high fan-out, shrink
+		if(batch->size > TRAVERSE_BATCH_MIN) batch->size /= 2;
+	} else if(input == batch->size) {
+		// child keeps up and fan-out is low, grow
+		batch->size *= 2;
+		if(batch->size > batch->cap) batch->size = batch->cap;
+	}
+}
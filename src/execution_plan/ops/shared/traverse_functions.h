@@ -9,6 +9,38 @@
 #include "../../execution_plan.h"
 #include "../../../arithmetic/algebraic_expression.h"
 
+// traversal ops accumulate a batch of records before evaluating their
+// algebraic expression, small batches result in many tiny multiplications
+// while large batches inflate the result matrix when fan-out is high
+// the batch starts small and doubles as long as the child keeps filling it
+// and the observed fan-out stays low, it shrinks back on high fan-out
+
+#define TRAVERSE_BATCH_MIN    16    // initial batch size
+#define TRAVERSE_BATCH_MAX    4096  // max batch size
+#define TRAVERSE_BATCH_FANOUT 64    // max avg number of outputs per input
+
+// adaptive traversal batch size
+typedef struct {
+	uint size;  // current batch size
+	uint cap;   // max batch size
+} TraverseBatch;
+
+// initialize batch size policy
+// `cap` bounds the batch size, e.g. a limit set by the optimizer
+void TraverseBatch_Init
+(
+	TraverseBatch *batch,  // batch to initialize
+	uint cap               // max batch size
+);
+
+// adjust batch size according to the last batch's throughput
+void TraverseBatch_Update
+(
+	TraverseBatch *batch,  // batch to update
+	uint input,            // number of records accumulated in the last batch
+	uint64_t output        // number of records produced by the last batch
+);
+
 // container struct for traversing and populating referenced edges in
 // traversal ops like CondTraverse and ExpandInto
 typedef struct {
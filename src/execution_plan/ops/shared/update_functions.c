@@ -64,7 +64,10 @@ void CommitUpdates
 		PendingUpdateCtx *update = HashTableGetVal(entry);
 
 		// if entity has been deleted, perform no updates
-		if(GraphEntity_IsDeleted(update->ge)) continue;
+		if(Graph_EntityIsDeleted(gc->g, update->ge,
+					type == ENTITY_NODE ? GETYPE_NODE : GETYPE_EDGE)) {
+			continue;
+		}
 
 		AttributeSet_PersistValues(update->attributes);
 		
@@ -159,7 +162,8 @@ void EvalEntityUpdates
 	GraphEntity *entity = Record_GetGraphEntity(r, ctx->record_idx);
 
 	// if the entity is marked as deleted, make no updates but do not error
-	if(unlikely(Graph_EntityIsDeleted(entity))) {
+	if(unlikely(Graph_EntityIsDeleted(gc->g, entity,
+				t == REC_TYPE_NODE ? GETYPE_NODE : GETYPE_EDGE))) {
 		return;
 	}
 
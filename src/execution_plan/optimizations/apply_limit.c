@@ -9,6 +9,7 @@
 #include "../ops/op_limit.h"
 #include "../ops/op_expand_into.h"
 #include "../ops/op_conditional_traverse.h"
+#include "../ops/op_cond_var_len_traverse.h"
 
 /* applyLimit will traverse the given execution plan looking for Limit operations.
  * Once one is found, all relevant child operations (e.g. Sort) will be
@@ -41,6 +42,10 @@ static void notify_limit(OpBase *op, uint limit) {
 		case OPType_CONDITIONAL_TRAVERSE:
 			((OpCondTraverse *)op)->record_cap = limit;
 			break;
+		case OPType_CONDITIONAL_VAR_LEN_TRAVERSE:
+		case OPType_CONDITIONAL_VAR_LEN_TRAVERSE_EXPAND_INTO:
+			((CondVarLenTraverse *)op)->record_cap = limit;
+			break;
 		default:
 			break;
 	}
@@ -0,0 +1,495 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "cost_model.h"
+#include "../ops/ops.h"
+#include "../../util/arr.h"
+#include "../../query_ctx.h"
+#include "../../arithmetic/arithmetic_op.h"
+#include "../../statistics/statistics.h"
+
+// max number of hops considered when estimating variable length traversals
+#define COST_MODEL_MAX_HOPS 3
+
+//------------------------------------------------------------------------------
+// selectivity
+//------------------------------------------------------------------------------
+
+// default selectivity of predicate operator
+static double _DefaultSelectivity
+(
+	AST_Operator op
+) {
+	switch(op) {
+		case OP_EQUAL:
+			return COST_MODEL_EQ_SELECTIVITY;
+		case OP_NEQUAL:
+			return 1 - COST_MODEL_EQ_SELECTIVITY;
+		case OP_LT:
+		case OP_LE:
+		case OP_GT:
+		case OP_GE:
+			return COST_MODEL_RANGE_SELECTIVITY;
+		default:
+			return COST_MODEL_DEFAULT_SELECTIVITY;
+	}
+}
+
+// estimate selectivity of predicate 'alias.attr op constant'
+// or 'alias.attr op $param'
+static double _PredicateSelectivity
+(
+	const Statistics *s,  // statistics, can be NULL
+	LabelID l,            // label of filtered node
+	const FT_FilterNode *pred
+) {
+	char *attr_name     = NULL;
+	AST_Operator op     = pred->pred.op;
+	AR_ExpNode *lhs     = pred->pred.lhs;
+	AR_ExpNode *rhs     = pred->pred.rhs;
+
+	// normalize, attribute on the left, constant on the right
+	if(!AR_EXP_IsAttribute(lhs, NULL)) {
+		AR_ExpNode *tmp = lhs;
+		lhs = rhs;
+		rhs = tmp;
+		op = ArithmeticOp_ReverseOp(op);
+	}
+
+	// a parameter's value is unknown at planning time
+	// which only matters for range predicates
+	bool constant = AR_EXP_IsConstant(rhs);
+	if(!AR_EXP_IsAttribute(lhs, &attr_name) ||
+	   (!constant && !AR_EXP_IsParameter(rhs))) {
+		return _DefaultSelectivity(op);
+	}
+
+	uint64_t ndv;
+	double presence;
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	Attribute_ID attr = GraphContext_GetAttributeID(gc, attr_name);
+
+	// attribute doesn't exists, no node passes the predicate
+	if(attr == ATTRIBUTE_ID_NONE) return 0;
+
+	// no statistics for label
+	if(s == NULL || l < 0 ||
+	   !Statistics_DistinctValues(s, l, attr, &ndv, &presence)) {
+		return _DefaultSelectivity(op);
+	}
+
+	// no sampled node holds the attribute
+	if(ndv == 0) return 0;
+
+	double fraction;
+	SIValue v = constant ? rhs->operand.constant : SI_NullVal();
+
+	switch(op) {
+		case OP_EQUAL:
+			return presence / ndv;
+		case OP_NEQUAL:
+			return presence * (1 - 1.0 / ndv);
+		case OP_LT:
+		case OP_LE:
+			if(SI_TYPE(v) & SI_NUMERIC &&
+			   Statistics_FractionBelow(s, l, attr, SI_GET_NUMERIC(v),
+				   &fraction)) {
+				return presence * fraction;
+			}
+			return presence * COST_MODEL_RANGE_SELECTIVITY;
+		case OP_GT:
+		case OP_GE:
+			if(SI_TYPE(v) & SI_NUMERIC &&
+			   Statistics_FractionBelow(s, l, attr, SI_GET_NUMERIC(v),
+				   &fraction)) {
+				return presence * (1 - fraction);
+			}
+			return presence * COST_MODEL_RANGE_SELECTIVITY;
+		default:
+			return presence * COST_MODEL_DEFAULT_SELECTIVITY;
+	}
+}
+
+// estimate selectivity of filter tree
+static double _Selectivity
+(
+	const Statistics *s,     // statistics, can be NULL
+	LabelID l,               // label of filtered node
+	const FT_FilterNode *ft  // filter tree
+) {
+	double a;
+	double b;
+
+	switch(ft->t) {
+		case FT_N_PRED:
+			return _PredicateSelectivity(s, l, ft);
+		case FT_N_COND:
+			a = _Selectivity(s, l, ft->cond.left);
+			b = _Selectivity(s, l, ft->cond.right);
+			switch(ft->cond.op) {
+				case OP_AND:
+					return a * b;
+				case OP_OR:
+					return a + b - a * b;
+				case OP_XOR:
+					return a + b - 2 * a * b;
+				default:
+					return COST_MODEL_DEFAULT_SELECTIVITY;
+			}
+		default:
+			return COST_MODEL_DEFAULT_SELECTIVITY;
+	}
+}
+
+double CostModel_FilterSelectivity
+(
+	LabelID l,
+	const char *alias,
+	const FT_FilterNode *ft
+) {
+	ASSERT(alias != NULL);
+
+	if(ft == NULL) return 1;
+
+	double selectivity = 1;
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	Statistics *s = GraphContext_GetStatistics(gc);
+
+	// consider each conjunct depending solely on 'alias'
+	const FT_FilterNode **sub_trees = FilterTree_SubTrees(ft);
+	uint n = array_len(sub_trees);
+	for(uint i = 0; i < n; i++) {
+		const FT_FilterNode *t = sub_trees[i];
+		rax *entities = FilterTree_CollectModified(t);
+
+		if(raxSize(entities) == 1 &&
+		   raxFind(entities, (unsigned char *)alias, strlen(alias))
+		   != raxNotFound) {
+			selectivity *= _Selectivity(s, l, t);
+		}
+
+		raxFree(entities);
+	}
+
+	array_free(sub_trees);
+	if(s != NULL) Statistics_Free(s);
+
+	return selectivity;
+}
+
+//------------------------------------------------------------------------------
+// cardinality
+//------------------------------------------------------------------------------
+
+// returns the label of 'n' with the fewest nodes
+// GRAPH_NO_LABEL if 'n' is unlabeled
+static LabelID _MinLabel
+(
+	const QGNode *n
+) {
+	Graph *g = QueryCtx_GetGraph();
+
+	LabelID min_label = GRAPH_NO_LABEL;
+	uint64_t min = UINT64_MAX;
+	uint label_count = QGNode_LabelCount(n);
+
+	for(uint i = 0; i < label_count; i++) {
+		LabelID l = QGNode_GetLabelID(n, i);
+		if(l == GRAPH_UNKNOWN_LABEL) return l;
+
+		uint64_t count = Graph_LabeledNodeCount(g, l);
+		if(count < min) {
+			min = count;
+			min_label = l;
+		}
+	}
+
+	return min_label;
+}
+
+double CostModel_NodeCardinality
+(
+	const QGNode *n
+) {
+	ASSERT(n != NULL);
+
+	Graph *g = QueryCtx_GetGraph();
+	double node_count = Graph_NodeCount(g);
+	uint label_count = QGNode_LabelCount(n);
+
+	if(label_count == 0) return node_count;
+
+	// assuming labels are independent of one another
+	// |A:B| = |A| * |B| / |V|
+	double cardinality = node_count;
+	for(uint i = 0; i < label_count; i++) {
+		LabelID l = QGNode_GetLabelID(n, i);
+
+		// unknown label, no nodes match
+		if(l == GRAPH_UNKNOWN_LABEL) return 0;
+
+		double count = Graph_LabeledNodeCount(g, l);
+		cardinality *= (node_count > 0) ? count / node_count : 0;
+	}
+
+	return cardinality;
+}
+
+double CostModel_NodeRows
+(
+	const QGNode *n,
+	const FT_FilterNode *ft
+) {
+	ASSERT(n != NULL);
+
+	double cardinality = CostModel_NodeCardinality(n);
+	if(ft == NULL || cardinality == 0) return cardinality;
+
+	return cardinality * CostModel_FilterSelectivity(_MinLabel(n), n->alias,
+			ft);
+}
+
+double CostModel_FanOut
+(
+	const QGEdge *e,
+	bool transposed
+) {
+	ASSERT(e != NULL);
+
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	Graph *g = gc->g;
+	Statistics *s = GraphContext_GetStatistics(gc);
+
+	double fanout = 0;
+	double node_count = MAX(Graph_NodeCount(g), 1);
+	uint relation_count = QGEdge_RelationCount(e);
+
+	// traversing all relationship-types
+	if(relation_count == 0) {
+		fanout = Graph_EdgeCount(g) / node_count;
+		if(e->bidirectional) fanout *= 2;
+		goto cleanup;
+	}
+
+	for(uint i = 0; i < relation_count; i++) {
+		RelationID r = QGEdge_RelationID(e, i);
+		if(r == GRAPH_UNKNOWN_RELATION) continue;
+
+		for(int dir = 0; dir < 2; dir++) {
+			// outgoing only, unless traversal is bidirectional
+			bool incoming = (dir == 0) ? transposed : !transposed;
+			if(dir == 1 && !e->bidirectional) break;
+
+			const DegreeHistogram *h = (s != NULL)
+				? Statistics_DegreeHistogram(s, r, incoming)
+				: NULL;
+
+			// mean degree of nodes connected via 'r'
+			// falling back to mean degree across all nodes
+			fanout += (h != NULL)
+				? DegreeHistogram_Mean(h)
+				: Graph_RelationEdgeCount(g, r) / node_count;
+		}
+	}
+
+cleanup:
+	if(s != NULL) Statistics_Free(s);
+	return fanout;
+}
+
+// estimated number of nodes reached by a variable length traversal
+// from a single node
+static double _VarLenFanOut
+(
+	const QGEdge *e,
+	bool transposed
+) {
+	double reached = 0;
+	double first = CostModel_FanOut(e, transposed);
+
+	// subsequent hops are likely to go through high degree nodes
+	// use the mean degree of a node reached by following a connection
+	double next = first;
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	Statistics *s = GraphContext_GetStatistics(gc);
+	if(s != NULL) {
+		if(QGEdge_RelationCount(e) == 1 && !e->bidirectional) {
+			RelationID r = QGEdge_RelationID(e, 0);
+			const DegreeHistogram *h = Statistics_DegreeHistogram(s, r,
+					transposed);
+			if(h != NULL) next = DegreeHistogram_WeightedMean(h);
+		}
+		Statistics_Free(s);
+	}
+
+	uint max_hops = MIN(e->maxHops, COST_MODEL_MAX_HOPS);
+	double level = 1;
+	for(uint hop = 0; hop <= max_hops; hop++) {
+		if(hop >= e->minHops) reached += level;
+		level *= (hop == 0) ? first : next;
+	}
+
+	return reached;
+}
+
+// locate the query graph edge traversed by algebraic expression
+// sets 'transposed' if the edge is traversed from its destination
+static QGEdge *_TraversedEdge
+(
+	const QueryGraph *qg,
+	const AlgebraicExpression *ae,
+	bool *transposed
+) {
+	const char *src  = AlgebraicExpression_Src((AlgebraicExpression *)ae);
+	const char *dest = AlgebraicExpression_Dest((AlgebraicExpression *)ae);
+	const char *edge = AlgebraicExpression_Edge(ae);
+
+	QGEdge *e = NULL;
+	if(edge != NULL) {
+		e = QueryGraph_GetEdgeByAlias(qg, edge);
+	} else {
+		// anonymous edge, search for an edge connecting src and dest
+		QGNode *n = QueryGraph_GetNodeByAlias(qg, src);
+		if(n == NULL) return NULL;
+
+		uint count = array_len(n->outgoing_edges);
+		for(uint i = 0; i < count && e == NULL; i++) {
+			QGEdge *candidate = n->outgoing_edges[i];
+			if(strcmp(candidate->dest->alias, dest) == 0) e = candidate;
+		}
+
+		count = array_len(n->incoming_edges);
+		for(uint i = 0; i < count && e == NULL; i++) {
+			QGEdge *candidate = n->incoming_edges[i];
+			if(strcmp(candidate->src->alias, dest) == 0) e = candidate;
+		}
+	}
+
+	if(e != NULL) *transposed = strcmp(e->src->alias, src) != 0;
+	return e;
+}
+
+// fraction of nodes matching 'alias'
+static double _LabelFraction
+(
+	const QueryGraph *qg,
+	const char *alias
+) {
+	QGNode *n = QueryGraph_GetNodeByAlias(qg, alias);
+	if(n == NULL || QGNode_LabelCount(n) == 0) return 1;
+
+	Graph *g = QueryCtx_GetGraph();
+	double node_count = Graph_NodeCount(g);
+	if(node_count == 0) return 0;
+
+	return CostModel_NodeCardinality(n) / node_count;
+}
+
+// estimated number of records produced by a traversal
+static double _EstimateTraverseRows
+(
+	const OpBase *op,
+	const AlgebraicExpression *ae,
+	double input,
+	bool var_len
+) {
+	const QueryGraph *qg = op->plan->query_graph;
+
+	bool transposed = false;
+	QGEdge *e = _TraversedEdge(qg, ae, &transposed);
+
+	Graph *g = QueryCtx_GetGraph();
+	double fanout = (e != NULL)
+		? ((var_len) ? _VarLenFanOut(e, transposed)
+					 : CostModel_FanOut(e, transposed))
+		: Graph_EdgeCount(g) / (double)MAX(Graph_NodeCount(g), 1);
+
+	// destination labels restrict reached nodes
+	const char *dest = AlgebraicExpression_Dest((AlgebraicExpression *)ae);
+	return input * fanout * _LabelFraction(qg, dest);
+}
+
+double CostModel_EstimateRows
+(
+	const OpBase *op
+) {
+	ASSERT(op != NULL);
+
+	Graph *g = QueryCtx_GetGraph();
+	double input = (op->childCount > 0)
+		? CostModel_EstimateRows(op->children[0])
+		: 1;
+
+	switch(op->type) {
+		case OPType_ALL_NODE_SCAN:
+			return input * Graph_NodeCount(g);
+
+		case OPType_NODE_BY_LABEL_SCAN: {
+			const NodeByLabelScan *scan = (const NodeByLabelScan *)op;
+			return input * CostModel_NodeCardinality(scan->n->n);
+		}
+
+		case OPType_NODE_BY_INDEX_SCAN: {
+			const IndexScan *scan = (const IndexScan *)op;
+			double cardinality = Graph_LabeledNodeCount(g, scan->n->label_id);
+			return input * cardinality * CostModel_FilterSelectivity(
+					scan->n->label_id, scan->n->alias, scan->filter);
+		}
+
+		case OPType_NODE_BY_ID_SEEK:
+			return input;
+
+		case OPType_CONDITIONAL_TRAVERSE:
+			return _EstimateTraverseRows(op, ((const OpCondTraverse *)op)->ae,
+					input, false);
+
+		case OPType_CONDITIONAL_VAR_LEN_TRAVERSE:
+			return _EstimateTraverseRows(op,
+					((const CondVarLenTraverse *)op)->ae, input, true);
+
+		case OPType_FILTER: {
+			const FT_FilterNode *ft = ((const OpFilter *)op)->filterTree;
+			rax *entities = FilterTree_CollectModified(ft);
+			double selectivity = COST_MODEL_DEFAULT_SELECTIVITY;
+
+			// single node filter, consult statistics
+			if(raxSize(entities) == 1) {
+				raxIterator it;
+				raxStart(&it, entities);
+				raxSeek(&it, "^", NULL, 0);
+				raxNext(&it);
+
+				char alias[it.key_len + 1];
+				memcpy(alias, it.key, it.key_len);
+				alias[it.key_len] = '\0';
+				raxStop(&it);
+
+				QGNode *n = QueryGraph_GetNodeByAlias(op->plan->query_graph,
+						alias);
+				if(n != NULL) {
+					selectivity = CostModel_FilterSelectivity(_MinLabel(n),
+							alias, ft);
+				}
+			}
+
+			raxFree(entities);
+			return input * selectivity;
+		}
+
+		case OPType_CARTESIAN_PRODUCT: {
+			double rows = input;
+			for(uint i = 1; i < op->childCount; i++) {
+				rows *= CostModel_EstimateRows(op->children[i]);
+			}
+			return rows;
+		}
+
+		default:
+			return input;
+	}
+}
+
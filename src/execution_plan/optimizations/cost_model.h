@@ -0,0 +1,67 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "../ops/op.h"
+#include "../../filter_tree/filter_tree.h"
+#include "../../graph/entities/qg_node.h"
+#include "../../graph/entities/qg_edge.h"
+
+// the cost model estimates cardinalities of query graph entities
+// and of execution plan operations
+// estimates are based on label / relationship-type counts maintained by
+// the graph and on the statistics periodically collected for it
+// see statistics/statistics.h
+// when statistics are not available fixed default selectivities are used
+
+// estimates are only meaningful relative to one another
+
+// selectivity of an equality predicate lacking statistics
+#define COST_MODEL_EQ_SELECTIVITY 0.1
+
+// selectivity of a range predicate lacking statistics
+#define COST_MODEL_RANGE_SELECTIVITY 0.33
+
+// selectivity of any other predicate
+#define COST_MODEL_DEFAULT_SELECTIVITY 0.5
+
+// estimated number of nodes matching 'n' disregarding filters
+double CostModel_NodeCardinality
+(
+	const QGNode *n  // query graph node
+);
+
+// estimated fraction of nodes labeled 'l' passing the filters in 'ft'
+// only sub-filters depending solely on 'alias' are considered
+double CostModel_FilterSelectivity
+(
+	LabelID l,               // node label, GRAPH_NO_LABEL if unlabeled
+	const char *alias,       // filtered alias
+	const FT_FilterNode *ft  // filters, can be NULL
+);
+
+// estimated number of nodes matching 'n' and passing the filters in 'ft'
+double CostModel_NodeRows
+(
+	const QGNode *n,         // query graph node
+	const FT_FilterNode *ft  // filters, can be NULL
+);
+
+// estimated number of connections followed when traversing 'e'
+// from a single node
+double CostModel_FanOut
+(
+	const QGEdge *e,  // query graph edge
+	bool transposed   // traverse from 'e' destination to its source
+);
+
+// estimated number of records produced by 'op'
+double CostModel_EstimateRows
+(
+	const OpBase *op  // operation
+);
+
@@ -30,7 +30,9 @@ void reduceFilters(ExecutionPlan *plan);
 void reduceTraversal(ExecutionPlan *plan);
 void reduceDistinct(ExecutionPlan *plan);
 void reduceCount(ExecutionPlan *plan);
+void reduceCachedAggregate(ExecutionPlan *plan);
 void applyLimit(ExecutionPlan *plan);
 void applySkip(ExecutionPlan *plan);
 void optimizeLabelScan(ExecutionPlan *plan);
+void parallelizePipelines(ExecutionPlan *plan);
 
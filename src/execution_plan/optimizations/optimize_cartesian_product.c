@@ -5,6 +5,7 @@
  */
 
 #include "RG.h"
+#include "cost_model.h"
 #include "../ops/op_filter.h"
 #include "../../errors/errors.h"
 #include "../ops/op_cartesian_product.h"
@@ -118,6 +119,33 @@ static OpBase **_find_entities_solving_branches(rax *entities, OpBase *cp) {
 	return solving_branches;
 }
 
+// sort branches by their estimated cardinality in descending order
+// a cartesian product re-evaluates its first branches for every record
+// produced by the following ones, placing the smallest branch last
+// minimizes the number of times branches are re-evaluated
+static void _sort_branches_by_cardinality
+(
+	OpBase **branches  // branches to sort
+) {
+	uint n = array_len(branches);
+	double rows[n];
+	for(uint i = 0; i < n; i++) rows[i] = CostModel_EstimateRows(branches[i]);
+
+	// stable insertion sort, branch count is small
+	for(uint i = 1; i < n; i++) {
+		OpBase *branch = branches[i];
+		double r = rows[i];
+		int j = i - 1;
+		while(j >= 0 && rows[j] < r) {
+			branches[j + 1] = branches[j];
+			rows[j + 1] = rows[j];
+			j--;
+		}
+		branches[j + 1] = branch;
+		rows[j + 1] = r;
+	}
+}
+
 static void _optimize_cartesian_product(ExecutionPlan *plan, OpBase *cp) {
 	// Retrieve all filter operations located upstream from the Cartesian Product.
 	FilterCtx *filter_ctx_arr = _locate_filters_and_entities(cp);
@@ -153,6 +181,7 @@ static void _optimize_cartesian_product(ExecutionPlan *plan, OpBase *cp) {
 		}
 
 		// Need to create a new cartesian product and connect the solving branches to the filter.
+		_sort_branches_by_cardinality(solving_branches);
 		OpBase *new_cp = NewCartesianProductOp(cp->plan);
 		ExecutionPlan_AddOp((OpBase *)filter_op, new_cp);
 		// Detach each solving branch from the original cp, and attach them as children for the new cp.
@@ -55,10 +55,17 @@ void optimizePlan(ExecutionPlan *plan) {
 	// try to reduce execution plan incase it perform node or edge counting
 	reduceCount(plan);
 
+	// try to compute label wide attribute aggregations from cached summaries
+	reduceCachedAggregate(plan);
+
 	// let operations know about specified limit(s)
 	applyLimit(plan);
 
 	// let operations know about specified skip(s)
 	applySkip(plan);
+
+	// split label scans into morsels processed by multiple threads
+	// must run last, as the parallel pipeline is cloned for each thread
+	parallelizePipelines(plan);
 }
 
@@ -0,0 +1,110 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "../ops/ops.h"
+#include "../../query_ctx.h"
+#include "../../configuration/config.h"
+#include "../execution_plan_build/execution_plan_modify.h"
+
+// the parallelizePipelines optimization looks for a pipeline feeding
+// a Results, Sort or Aggregate operation, where the pipeline is a linear chain
+// of streaming operations tapped by a label scan, e.g.
+//
+// Aggregate
+//     Filter
+//         Conditional Traverse
+//             Node By Label Scan
+//
+// in which case an Exchange operation is introduced at the top of the pipeline
+// splitting the label scan into morsels processed by multiple threads
+
+// returns true if op can be executed as part of a parallel pipeline
+static bool _parallelizable
+(
+	const OpBase *op
+) {
+	switch(op->type) {
+		case OPType_FILTER:
+		case OPType_PROJECT:
+		case OPType_EXPAND_INTO:
+		case OPType_CONDITIONAL_TRAVERSE:
+			return op->childCount == 1;
+		case OPType_NODE_BY_LABEL_SCAN:
+			return op->childCount == 0;
+		default:
+			return false;
+	}
+}
+
+// tries to introduce an Exchange operation right below `merge`
+static bool _parallelizePipeline
+(
+	OpBase *merge,  // op consuming the pipeline
+	uint dop        // max degree of parallelism
+) {
+	if(merge->childCount != 1) return false;
+
+	OpBase *pipeline = merge->children[0];
+
+	// the pipeline must consist of at least one operation above its tap
+	if(pipeline->childCount == 0) return false;
+
+	// all pipeline operations must be parallelizable and belong to the same
+	// plan segment, as records are exchanged between clones of this segment
+	OpBase *op = pipeline;
+	while(true) {
+		if(!_parallelizable(op) || op->plan != pipeline->plan) return false;
+		if(op->childCount == 0) break;
+		op = op->children[0];
+	}
+
+	OpBase *exchange = NewExchangeOp(pipeline->plan, dop);
+	ExecutionPlan_PushBelow(pipeline, exchange);
+
+	return true;
+}
+
+void parallelizePipelines
+(
+	ExecutionPlan *plan
+) {
+	ASSERT(plan != NULL);
+
+	// write and profiled queries are executed by a single thread
+	QueryCtx *ctx = QueryCtx_GetQueryCtx();
+	if(ctx->flags & (QueryExecutionTypeFlag_WRITE |
+					 QueryExecutionTypeFlag_PROFILE)) {
+		return;
+	}
+
+	uint dop;
+	bool res = Config_Option_get(Config_MAX_QUERY_PARALLELISM, &dop);
+	ASSERT(res);
+	UNUSED(res);
+
+	if(dop < 2) return;
+
+	// walk down the linear part of the plan looking for a merge point
+	// operations with multiple children or which may reset their child
+	// end the search
+	OpBase *op = plan->root;
+	while(op != NULL) {
+		if(op->type == OPType_RESULTS   ||
+		   op->type == OPType_SORT      ||
+		   op->type == OPType_AGGREGATE) {
+			if(_parallelizePipeline(op, dop)) return;
+		}
+
+		if(op->childCount != 1                ||
+		   op->type == OPType_OPTIONAL        ||
+		   op->type == OPType_CALLSUBQUERY    ||
+		   op->type == OPType_FOREACH) {
+			return;
+		}
+		op = op->children[0];
+	}
+}
@@ -0,0 +1,152 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "../ops/ops.h"
+#include "../../util/arr.h"
+#include "../../query_ctx.h"
+#include "../../aggregate_cache/aggregate_cache.h"
+#include "../execution_plan_build/execution_plan_modify.h"
+
+// the reduceCachedAggregate optimization looks for execution plans
+// aggregating a single attribute across all nodes of a label, e.g.
+// MATCH (p:Person) RETURN avg(p.age)
+//
+// in which case the aggregation is taken from the attribute's cached summary
+// replacing both the label scan and the aggregate operations
+// with a projection of the precomputed result
+//
+// the optimization only applies when the graph's aggregate cache is enabled
+// and the attribute can be summarized
+
+// aggregation functions which can be answered by a summary
+typedef bool (*SummaryAggFunc)(const AttributeSummary *s, SIValue *res);
+
+static SummaryAggFunc _GetSummaryAggFunc
+(
+	const char *name
+) {
+	if(strcasecmp(name, "count") == 0) return AttributeSummary_Count;
+	if(strcasecmp(name, "sum")   == 0) return AttributeSummary_Sum;
+	if(strcasecmp(name, "avg")   == 0) return AttributeSummary_Avg;
+	if(strcasecmp(name, "min")   == 0) return AttributeSummary_Min;
+	if(strcasecmp(name, "max")   == 0) return AttributeSummary_Max;
+	return NULL;
+}
+
+// checks if execution plan matches the pattern:
+// "Label Scan -> Aggregate -> Results"
+// where the aggregate function is applied to an attribute of the scanned node
+static bool _identifyCachedAggregatePattern
+(
+	OpBase *root,               // plan's root
+	OpResult **opResult,        // [output] results op
+	OpAggregate **opAggregate,  // [output] aggregate op
+	NodeByLabelScan **opScan,   // [output] label scan op
+	SummaryAggFunc *f,          // [output] aggregation function
+	const char **attr           // [output] aggregated attribute
+) {
+	OpBase *op = root;
+
+	// op results
+	if(op->type != OPType_RESULTS || op->childCount != 1) return false;
+	*opResult = (OpResult *)op;
+	op = op->children[0];
+
+	// op aggregate, expecting a single aggregation without grouping keys
+	if(op->type != OPType_AGGREGATE || op->childCount != 1) return false;
+	*opAggregate = (OpAggregate *)op;
+	if((*opAggregate)->aggregate_count != 1 ||
+	   (*opAggregate)->key_count != 0) return false;
+
+	AR_ExpNode *exp = (*opAggregate)->aggregate_exps[0];
+	if(exp->type != AR_EXP_OP ||
+	   exp->op.f->aggregate != true ||
+	   exp->op.child_count != 1 ||
+	   AR_EXP_PerformsDistinct(exp)) return false;
+
+	*f = _GetSummaryAggFunc(AR_EXP_GetFuncName(exp));
+	if(*f == NULL) return false;
+
+	// aggregated expression must be an attribute access
+	char *attr_name;
+	AR_ExpNode *arg = exp->op.children[0];
+	if(!AR_EXP_IsAttribute(arg, &attr_name)) return false;
+
+	AR_ExpNode *entity = arg->op.children[0];
+	if(entity->type != AR_EXP_OPERAND ||
+	   entity->operand.type != AR_EXP_VARIADIC) return false;
+
+	// op label scan over the entire label
+	op = op->children[0];
+	if(op->type != OPType_NODE_BY_LABEL_SCAN || op->childCount != 0) {
+		return false;
+	}
+	*opScan = (NodeByLabelScan *)op;
+	if((*opScan)->id_range != NULL) return false;
+
+	// attribute must belong to the scanned node
+	if(strcmp(entity->operand.variadic.entity_alias, (*opScan)->n->alias) != 0) {
+		return false;
+	}
+
+	*attr = attr_name;
+	return true;
+}
+
+void reduceCachedAggregate
+(
+	ExecutionPlan *plan
+) {
+	SummaryAggFunc f;
+	const char *attr;
+	OpResult *opResult;
+	NodeByLabelScan *opScan;
+	OpAggregate *opAggregate;
+
+	if(!_identifyCachedAggregatePattern(plan->root, &opResult, &opAggregate,
+				&opScan, &f, &attr)) return;
+
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+
+	// unknown label or attribute, leave plan as is
+	Schema *s = GraphContext_GetSchema(gc, opScan->n->label, SCHEMA_NODE);
+	if(s == NULL) return;
+
+	Attribute_ID attr_id = GraphContext_GetAttributeID(gc, attr);
+	if(attr_id == ATTRIBUTE_ID_NONE) return;
+
+	// get summary, the graph's READ lock is held by the executing query
+	AttributeSummary *summary = AggregateCache_Get(gc->aggregates, gc->g,
+			Schema_GetID(s), attr_id);
+	if(summary == NULL) return;
+
+	SIValue res;
+	bool applies = f(summary, &res);
+	AttributeSummary_Free(summary);
+
+	// aggregation doesn't apply to the values type, e.g. sum of strings
+	// let the aggregate operation report the error
+	if(!applies) return;
+
+	// construct a constant expression, used by a new projection operation
+	AR_ExpNode *exp = AR_EXP_NewConstOperandNode(res);
+	// the new expression must be aliased to populate the Record
+	exp->resolved_name = opAggregate->aggregate_exps[0]->resolved_name;
+	AR_ExpNode **exps = array_new(AR_ExpNode *, 1);
+	array_append(exps, exp);
+
+	OpBase *opProject = NewProjectOp(opAggregate->op.plan, exps);
+
+	// new execution plan: "Project -> Results"
+	ExecutionPlan_RemoveOp(plan, (OpBase *)opScan);
+	OpBase_Free((OpBase *)opScan);
+
+	ExecutionPlan_RemoveOp(plan, (OpBase *)opAggregate);
+	OpBase_Free((OpBase *)opAggregate);
+
+	ExecutionPlan_AddOp((OpBase *)opResult, opProject);
+}
+
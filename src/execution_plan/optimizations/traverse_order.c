@@ -20,6 +20,7 @@ static bool _should_transpose_entry_point
 	const QueryGraph *qg,
 	AlgebraicExpression *ae,
 	rax *filtered_entities,
+	const FT_FilterNode *ft,
 	rax *bound_vars
 ) {
 	// validate inputs
@@ -41,7 +42,7 @@ static bool _should_transpose_entry_point
 
 	// compute src score
 	TraverseOrder_ScoreExpressions(scored_exp, exps, 2, bound_vars,
-								   filtered_entities, qg);
+								   filtered_entities, ft, qg);
 	int src_score = scored_exp[0].score;
 
 	// transpose
@@ -51,7 +52,7 @@ static bool _should_transpose_entry_point
 
 	// compute dest score
 	TraverseOrder_ScoreExpressions(scored_exp, exps, 2, bound_vars,
-								   filtered_entities, qg);
+								   filtered_entities, ft, qg);
 	int dest_score = scored_exp[0].score;
 
 	// transpose if top scored expression is 'dest_exp'
@@ -242,7 +243,7 @@ void orderExpressions
 
 	// associate each expression with a score
 	TraverseOrder_ScoreExpressions(scored_exps, exps, _exp_count, bound_vars,
-								   filtered_entities, qg);
+								   filtered_entities, ft, qg);
 
 	// sort scored_exps on score in descending order
 	qsort(scored_exps, _exp_count, sizeof(ScoredExp),
@@ -263,7 +264,7 @@ void orderExpressions
 
 	// transpose the winning expression if the destination node is a more
 	// efficient starting point
-	if(_should_transpose_entry_point(qg, exps[0], filtered_entities,
+	if(_should_transpose_entry_point(qg, exps[0], filtered_entities, ft,
 									 bound_vars)) {
 		AlgebraicExpression_Transpose(exps);
 	}
@@ -5,9 +5,16 @@
  */
 
 #include "RG.h"
+#include "cost_model.h"
 #include "../../util/arr.h"
 #include "traverse_order_utils.h"
 
+#include <math.h>
+
+// a filtered expression is not preferred over an expression whose
+// estimated entry point cardinality is smaller by at least this factor
+#define TRAVERSE_ORDER_SKEW_FACTOR 1000
+
 static bool _AlgebraicExpression_IsVarLen
 (
 	const AlgebraicExpression *exp,
@@ -203,6 +210,27 @@ void FilterTree_CollectIndependentEntities
 	array_free(sub_trees);
 }
 
+// estimated number of rows produced by the expression's entry point
+// either the expression's source or destination, whichever is smaller
+static double _EntryPointRows
+(
+	AlgebraicExpression *exp,
+	const FT_FilterNode *ft,
+	const QueryGraph *qg
+) {
+	const char *src   = AlgebraicExpression_Src(exp);
+	const char *dest  = AlgebraicExpression_Dest(exp);
+	QGNode *src_node  = QueryGraph_GetNodeByAlias(qg, src);
+	QGNode *dest_node = QueryGraph_GetNodeByAlias(qg, dest);
+
+	double rows = CostModel_NodeRows(src_node, ft);
+	if(dest_node != src_node) {
+		rows = MIN(rows, CostModel_NodeRows(dest_node, ft));
+	}
+
+	return rows;
+}
+
 // score each expression and sort expressions by score
 void TraverseOrder_ScoreExpressions
 (
@@ -211,13 +239,14 @@ void TraverseOrder_ScoreExpressions
 	uint nexp,                   // number of expressions
 	rax *bound_vars,             // map of bounded entities
 	rax *filtered_entities,      // map of filtered entities
+	const FT_FilterNode *ft,     // filters applied to expressions, can be NULL
 	const QueryGraph *qg         // query graph
 ) {
 	// scoring of algebraic expression is done according to 3 criterias
 	// ordered by strongest to weakest:
 	// 1. The source or destination are bound
 	// 2. Existence of filters on either source or destinaion
-	// 3. Label(s) on the expression source or destination
+	// 3. Estimated cardinality of the expression's entry point
 	//
 	// the expressions will be evaluated in 3 phases, one for each criteria
 	// (from weakest to strongest)
@@ -226,11 +255,14 @@ void TraverseOrder_ScoreExpressions
 	// (the maximum score given in the previous criteria) + (criteria scoring function)
 	// where the first criteria starts with (criteria scoring function)
 	//
-	// phase 1 - check for labels on either source or destination
-	// expression scoring = _expression_labels_score
+	// phase 1 - rank expressions by the estimated cardinality of their
+	// entry point, the smaller the cardinality the higher the rank
+	// ties are broken by the number of labels on source and destination
 	//
 	// phase 2 - check for existence of filters on either source or destinaion
 	// expression scoring = (max(phase 1 scoring results)) + _expression_filter_existence_score
+	// unless the expression's cardinality is orders of magnitude larger than
+	// the cheapest expression, e.g. a filter applied to a supernode label
 	//
 	// phase 3 - bound variables
 	// phase expression scoring = (max(phase 2 scoring results)) +  _expression_bound_variable_score
@@ -239,21 +271,46 @@ void TraverseOrder_ScoreExpressions
 	int                  max          =  0;
 	int                  score        =  0;
 	int                  currmax      =  0;
+	double               min_rows     =  INFINITY;
 	AlgebraicExpression  *exp         =  NULL;
 	ScoredExp            *scored_exp  =  NULL;
 
+	bool   var_len[nexp];  // expression represents a variable length traversal
+	int    labels[nexp];   // expression label score
+	double rows[nexp];     // expression estimated entry point cardinality
+
 	//--------------------------------------------------------------------------
-	//  phase 1 score label
+	//  phase 1 score estimated cardinality
 	//--------------------------------------------------------------------------
 
 	for(uint i = 0; i < nexp; i ++) {
 		exp = exps[i];
 		scored_exp = scored_exps + i;
-
-		score = TraverseOrder_LabelsScore(exp, qg);
 		scored_exp->exp = exp;
-		scored_exp->score = score;
+		scored_exp->score = 0;
+
+		var_len[i] = _AlgebraicExpression_IsVarLen(exp, qg);
+		labels[i]  = TraverseOrder_LabelsScore(exp, qg);
+		rows[i]    = (var_len[i]) ? INFINITY : _EntryPointRows(exp, ft, qg);
+
+		min_rows = MIN(min_rows, rows[i]);
+	}
 
+	for(uint i = 0; i < nexp; i ++) {
+		// variable length traversals are never considered as entry points
+		if(var_len[i]) continue;
+
+		// rank is the number of expressions ranked lower
+		score = 1;
+		for(uint j = 0; j < nexp; j ++) {
+			if(var_len[j]) continue;
+			if(rows[j] > rows[i] ||
+			   (rows[j] == rows[i] && labels[j] < labels[i])) {
+				score++;
+			}
+		}
+
+		scored_exps[i].score = score;
 		max = MAX(max, score);
 	}
 
@@ -269,10 +326,16 @@ void TraverseOrder_ScoreExpressions
 			scored_exp = scored_exps + i;
 			exp = scored_exp->exp;
 
+			// filtered expression is too expensive to start with
+			if(!var_len[i] &&
+			   rows[i] > MAX(min_rows, 1) * TRAVERSE_ORDER_SKEW_FACTOR) {
+				continue;
+			}
+
 			score = TraverseOrder_FilterExistenceScore(exp, qg,
 													   filtered_entities);
 			if(score > 0) {
-				if(_AlgebraicExpression_IsVarLen(exp, qg)) {
+				if(var_len[i]) {
 					// variable length traversal should always "lose" to its
 					// direct prev and next expressions
 					score = currmax / 2;
@@ -305,4 +368,3 @@ void TraverseOrder_ScoreExpressions
 		}
 	}
 }
-
@@ -36,6 +36,7 @@ void TraverseOrder_ScoreExpressions
 	uint nexp,                   // number of expressions
 	rax *bound_vars,             // map of bounded entities
 	rax *filtered_entities,      // map of filtered entities
+	const FT_FilterNode *ft,     // filters applied to expressions, can be NULL
 	const QueryGraph *qg         // query graph
 );
 
@@ -5,6 +5,7 @@
  */
 
 #include "RG.h"
+#include "cost_model.h"
 #include "../../value.h"
 #include "../../util/arr.h"
 #include "../../query_ctx.h"
@@ -25,6 +26,8 @@
 #include "../execution_plan_build/execution_plan_util.h"
 #include "../execution_plan_build/execution_plan_modify.h"
 
+#include <math.h>
+
 //------------------------------------------------------------------------------
 // Filter normalization
 //------------------------------------------------------------------------------
@@ -90,8 +93,9 @@ static bool _validateInExpression(AR_ExpNode *exp) {
 }
 
 // return true if filter can be resolved by an index query
+// substring filters are only applicable to indexes with trigram postings
 static bool _applicable_predicate(const char* filtered_entity,
-		FT_FilterNode *filter) {
+		FT_FilterNode *filter, bool trigrams) {
 
 	SIValue v;
 	bool res              =  false;
@@ -105,6 +109,12 @@ static bool _applicable_predicate(const char* filtered_entity,
 
 	if(isDistanceFilter(filter)) return true;
 
+	// n.v STARTS WITH 'abc' or n.v =~ 'abc.*'
+	if(isPrefixFilter(filter)) return true;
+
+	// n.v CONTAINS 'abc', n.v ENDS WITH 'abc' or n.v =~ '.*abc.*'
+	if(trigrams && isSubstringFilter(filter)) return true;
+
 	switch(filter->t) {
 	case FT_N_PRED:
 		lhs_exp = filter->pred.lhs;
@@ -161,8 +171,10 @@ static bool _applicable_predicate(const char* filtered_entity,
 		break;
 	case FT_N_COND:
 		// require both ends of the filter to be applicable
-		res = (_applicable_predicate(filtered_entity, filter->cond.left) &&
-				_applicable_predicate(filtered_entity, filter->cond.right));
+		res = (_applicable_predicate(filtered_entity, filter->cond.left,
+					trigrams) &&
+				_applicable_predicate(filtered_entity, filter->cond.right,
+					trigrams));
 		break;
 	default:
 		break;
@@ -182,18 +194,21 @@ bool _applicableFilter
 	rax            *attr         =  NULL;
 	rax            *entities     =  NULL;
 	FT_FilterNode  *filter_tree  =  *filter;
+	RangeIndex     *ri           =  Index_RangeIndex(idx);
+	bool           trigrams      =  (ri != NULL && RangeIndex_HasTrigrams(ri));
 
 	// prepare it befor checking if applicable.
 	_normalize_filter(filtered_entity, filter);
 
-	// make sure the filter root is not a function, other then IN or distance
+	// make sure the filter root is not a function, other then IN, distance,
+	// a string prefix or a substring
 	// make sure the "not equal, <>" operator isn't used
 	if(FilterTree_containsOp(filter_tree, OP_NEQUAL)) {
 		res = false;
 		goto cleanup;
 	}
 
-	if(!_applicable_predicate(filtered_entity, filter_tree)) {
+	if(!_applicable_predicate(filtered_entity, filter_tree, trigrams)) {
 		res = false;
 		goto cleanup;
 	}
@@ -300,10 +315,10 @@ void reduce_scan_op
 	QueryGraph   *qg  =  scan->op.plan->query_graph;
 
 	// find label with filtered indexed properties
-	// that has the minimum NNZ entries
+	// that has the minimum estimated number of matching entries
 	int         min_label_id;                 // tracks min label ID
-	uint64_t    min_nnz        = UINT64_MAX;  // tracks min entries
-	RSIndex     *rs_idx        = NULL;        // the index to be applied
+	double      min_rows       = INFINITY;    // tracks min estimated entries
+	Index       min_idx        = NULL;        // the index to be applied
 	OpFilter    **filters      = NULL;        // tracks indexed filters to apply
 	uint        filters_count  = 0;           // number of matching filters
 	const char  *min_label_str = NULL;        // tracks min label name
@@ -316,7 +331,7 @@ void reduce_scan_op
 	uint label_count = QGNode_LabelCount(qn);
 	for(uint i = 0; i < label_count; i++) {
 		Index idx;
-		uint64_t nnz;
+		double rows;
 		int label_id = QGNode_GetLabelID(qn, i);
 		const char *label = QGNode_GetLabel(qn, i);
 
@@ -334,9 +349,6 @@ void reduce_scan_op
 		// TODO switch to reusable array
 		OpFilter **cur_filters = _applicableFilters((OpBase *)scan, scan->n->alias, idx);
 
-		// TODO consider heuristic which combines max
-		// number / restrictiveness of applicable filters
-		// vs. the label's NNZ?
 		uint cur_filters_count = array_len(cur_filters);
 		if(cur_filters_count == 0) {
 			// no filters
@@ -344,13 +356,17 @@ void reduce_scan_op
 			continue;
 		}
 
-		// get all applicable filter for index
-		RSIndex *cur_idx = Index_RSIndex(idx);
+		// estimate the number of entries the index will produce
+		// combining label cardinality with the filters selectivity
+		rows = Graph_LabeledNodeCount(g, label_id);
+		for(uint j = 0; j < cur_filters_count; j++) {
+			rows *= CostModel_FilterSelectivity(label_id, node_alias,
+					cur_filters[j]->filterTree);
+		}
 
-		nnz = Graph_LabeledNodeCount(g, label_id);
-		if(min_nnz > nnz) {
-			rs_idx         =  cur_idx;
-			min_nnz        =  nnz;
+		if(min_rows > rows) {
+			min_idx        =  idx;
+			min_rows       =  rows;
 			min_label_str  =  label;
 			min_label_id   =  label_id;
 
@@ -363,7 +379,7 @@ void reduce_scan_op
 	}
 
 	// no label possessed indexed and filtered attributes, return early
-	if(rs_idx == NULL) goto cleanup;
+	if(min_idx == NULL) goto cleanup;
 
 	// did we found a better label to utilize? if so swap
 	if(scan->n->label_id != min_label_id) {
@@ -397,7 +413,7 @@ void reduce_scan_op
 	}
 
 	FT_FilterNode *root = _Concat_Filters(filters);
-	OpBase *indexOp = NewIndexScanOp(scan->op.plan, scan->g, scan->n, rs_idx,
+	OpBase *indexOp = NewIndexScanOp(scan->op.plan, scan->g, scan->n, min_idx,
 			root);
 	scan->n = NULL;
 
@@ -442,9 +458,8 @@ void reduce_cond_op(ExecutionPlan *plan, OpCondTraverse *cond) {
 	uint filters_count = array_len(filters);
 	if(filters_count == 0) goto cleanup;
 
-	RSIndex *rs_idx = Index_RSIndex(idx);
 	FT_FilterNode *root = _Concat_Filters(filters);
-	OpBase *indexOp = NewEdgeIndexScanOp(cond->op.plan, cond->graph, e, rs_idx,
+	OpBase *indexOp = NewEdgeIndexScanOp(cond->op.plan, cond->graph, e, idx,
 			root);
 
 	// The OPType_ALL_NODE_SCAN operation is redundant
@@ -0,0 +1,466 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "batch_filter.h"
+#include "../query_ctx.h"
+#include "../util/rmalloc.h"
+#include "../graph/entities/graph_entity.h"
+
+#include <string.h>
+
+// comparison kernels are compiled for several instruction sets
+// the best one supported by the CPU is picked at load time
+#if defined(__GNUC__) && defined(__x86_64__) && defined(__linux__)
+#define BATCH_KERNEL __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define BATCH_KERNEL
+#endif
+
+struct BatchFilter {
+	AST_Operator op;      // comparison operator, or AND / OR
+	BatchFilter *left;    // left operand of a condition
+	BatchFilter *right;   // right operand of a condition
+	AR_ExpNode *exp;      // attribute access, borrowed from the filter tree
+	const char *alias;    // filtered entity alias
+	const char *attr;     // filtered attribute name
+	int idx;              // alias position within record
+	Attribute_ID attr_id; // filtered attribute ID
+	SIValue c;            // constant operand
+};
+
+// attribute values of a batch of records
+typedef struct {
+	int64_t i64[BATCH_FILTER_CAP];  // integer and boolean values
+	double f64[BATCH_FILTER_CAP];   // numeric values as double
+	uint64_t ints;                  // lanes holding an integer
+	uint64_t doubles;               // lanes holding a double
+	uint64_t bools;                 // lanes holding a boolean
+	uint64_t others;                // lanes holding a non null value of another type
+} Lanes;
+
+//------------------------------------------------------------------------------
+// compilation
+//------------------------------------------------------------------------------
+
+// mirror comparison operator, such that `c op x` == `x mirror(op) c`
+static AST_Operator _MirrorOp
+(
+	AST_Operator op
+) {
+	switch(op) {
+		case OP_LT: return OP_GT;
+		case OP_LE: return OP_GE;
+		case OP_GT: return OP_LT;
+		case OP_GE: return OP_LE;
+		default:    return op;
+	}
+}
+
+static bool _IsComparison
+(
+	AST_Operator op
+) {
+	return (op == OP_EQUAL || op == OP_NEQUAL || op == OP_LT || op == OP_LE ||
+			op == OP_GT    || op == OP_GE);
+}
+
+// returns true if 'exp' is an attribute access of the form `alias.attr`
+static bool _IsAliasAttribute
+(
+	const AR_ExpNode *exp
+) {
+	if(!AR_EXP_IsAttribute(exp, NULL)) return false;
+
+	const AR_ExpNode *entity = exp->op.children[0];
+	return AR_EXP_IsVariadic(entity);
+}
+
+static BatchFilter *_CompilePredicate
+(
+	const FT_FilterNode *node
+) {
+	AST_Operator op = node->pred.op;
+	if(!_IsComparison(op)) return NULL;
+
+	AR_ExpNode *attr = node->pred.lhs;
+	AR_ExpNode *c    = node->pred.rhs;
+
+	// constant on the left-hand side, mirror predicate
+	if(!_IsAliasAttribute(attr)) {
+		attr = node->pred.rhs;
+		c    = node->pred.lhs;
+		op   = _MirrorOp(op);
+	}
+
+	if(!_IsAliasAttribute(attr)) return NULL;
+	if(!AR_EXP_IsConstant(c) && !AR_EXP_IsParameter(c)) return NULL;
+
+	// evaluate constant operand
+	SIValue v = AR_EXP_Evaluate(c, NULL);
+	if(!(SI_TYPE(v) & (T_INT64 | T_DOUBLE | T_BOOL))) {
+		SIValue_Free(v);
+		return NULL;
+	}
+
+	char *attr_name;
+	AR_EXP_IsAttribute(attr, &attr_name);
+
+	BatchFilter *f = rm_calloc(1, sizeof(BatchFilter));
+
+	f->op      = op;
+	f->c       = v;
+	f->exp     = attr;
+	f->attr    = attr_name;
+	f->alias   = attr->op.children[0]->operand.variadic.entity_alias;
+	f->idx     = INVALID_INDEX;
+	f->attr_id = GraphContext_GetAttributeID(QueryCtx_GetGraphCtx(), attr_name);
+
+	return f;
+}
+
+static BatchFilter *_Compile
+(
+	const FT_FilterNode *node
+) {
+	switch(node->t) {
+		case FT_N_PRED:
+			return _CompilePredicate(node);
+
+		case FT_N_COND: {
+			// NULL is treated as FALSE which is only sound
+			// in the absence of negations
+			AST_Operator op = node->cond.op;
+			if(op != OP_AND && op != OP_OR) return NULL;
+
+			BatchFilter *left = _Compile(node->cond.left);
+			if(left == NULL) return NULL;
+
+			BatchFilter *right = _Compile(node->cond.right);
+			if(right == NULL) {
+				BatchFilter_Free(left);
+				return NULL;
+			}
+
+			BatchFilter *f = rm_calloc(1, sizeof(BatchFilter));
+			f->op    = op;
+			f->left  = left;
+			f->right = right;
+			return f;
+		}
+
+		default:
+			return NULL;
+	}
+}
+
+BatchFilter *BatchFilter_Compile
+(
+	const FT_FilterNode *root  // filter tree to compile
+) {
+	ASSERT(root != NULL);
+	return _Compile(root);
+}
+
+//------------------------------------------------------------------------------
+// comparison kernels
+//------------------------------------------------------------------------------
+
+// pack BATCH_FILTER_CAP 0/1 bytes into a bitmap
+static inline uint64_t _Pack
+(
+	const uint8_t *r  // comparison results
+) {
+	uint64_t m = 0;
+	for(uint i = 0; i < BATCH_FILTER_CAP; i += 8) {
+		// gather the low bit of 8 bytes into the top byte
+		uint64_t w;
+		memcpy(&w, r + i, sizeof(w));
+		m |= ((w * 0x0102040810204080ULL) >> 56) << i;
+	}
+	return m;
+}
+
+// compare integer lanes against 'c'
+// the sign of the wrapped difference is tested, matching SIValue_Compare
+// all lanes are compared, allowing the compiler to vectorize the loops
+BATCH_KERNEL
+static uint64_t _Compare_i64
+(
+	const int64_t *x,  // lanes
+	int64_t c,         // constant
+	AST_Operator op    // comparison operator
+) {
+	int64_t d[BATCH_FILTER_CAP];
+	for(uint i = 0; i < BATCH_FILTER_CAP; i++) {
+		d[i] = (int64_t)((uint64_t)x[i] - (uint64_t)c);
+	}
+
+	uint8_t r[BATCH_FILTER_CAP];
+	switch(op) {
+		case OP_EQUAL:
+			for(uint i = 0; i < BATCH_FILTER_CAP; i++) r[i] = (d[i] == 0);
+			break;
+		case OP_NEQUAL:
+			for(uint i = 0; i < BATCH_FILTER_CAP; i++) r[i] = (d[i] != 0);
+			break;
+		case OP_LT:
+			for(uint i = 0; i < BATCH_FILTER_CAP; i++) r[i] = (d[i] < 0);
+			break;
+		case OP_LE:
+			for(uint i = 0; i < BATCH_FILTER_CAP; i++) r[i] = (d[i] <= 0);
+			break;
+		case OP_GT:
+			for(uint i = 0; i < BATCH_FILTER_CAP; i++) r[i] = (d[i] > 0);
+			break;
+		case OP_GE:
+			for(uint i = 0; i < BATCH_FILTER_CAP; i++) r[i] = (d[i] >= 0);
+			break;
+		default:
+			ASSERT(false);
+			return 0;
+	}
+
+	return _Pack(r);
+}
+
+// compare double lanes against 'c'
+// comparisons involving NaN are false, other than inequality
+// all lanes are compared, allowing the compiler to vectorize the loops
+BATCH_KERNEL
+static uint64_t _Compare_f64
+(
+	const double *x,  // lanes
+	double c,         // constant
+	AST_Operator op   // comparison operator
+) {
+	uint8_t r[BATCH_FILTER_CAP];
+	switch(op) {
+		case OP_EQUAL:
+			for(uint i = 0; i < BATCH_FILTER_CAP; i++) r[i] = (x[i] == c);
+			break;
+		case OP_NEQUAL:
+			for(uint i = 0; i < BATCH_FILTER_CAP; i++) r[i] = (x[i] != c);
+			break;
+		case OP_LT:
+			for(uint i = 0; i < BATCH_FILTER_CAP; i++) r[i] = (x[i] < c);
+			break;
+		case OP_LE:
+			for(uint i = 0; i < BATCH_FILTER_CAP; i++) r[i] = (x[i] <= c);
+			break;
+		case OP_GT:
+			for(uint i = 0; i < BATCH_FILTER_CAP; i++) r[i] = (x[i] > c);
+			break;
+		case OP_GE:
+			for(uint i = 0; i < BATCH_FILTER_CAP; i++) r[i] = (x[i] >= c);
+			break;
+		default:
+			ASSERT(false);
+			return 0;
+	}
+
+	return _Pack(r);
+}
+
+//------------------------------------------------------------------------------
+// evaluation
+//------------------------------------------------------------------------------
+
+// gather attribute values of a batch of records into lanes
+// inactive records are treated as holding NULL
+static void _Gather
+(
+	BatchFilter *f,       // predicate
+	const Record *batch,  // records
+	uint n,               // number of records
+	uint64_t active,      // records to gather
+	Lanes *lanes          // [output] lanes
+) {
+	// attribute might have been introduced after compilation
+	if(f->attr_id == ATTRIBUTE_ID_NONE) {
+		f->attr_id = GraphContext_GetAttributeID(QueryCtx_GetGraphCtx(),
+				f->attr);
+	}
+
+	// all records in a batch share the same layout
+	if(f->idx == INVALID_INDEX) {
+		f->idx = Record_GetEntryIdx(batch[0], f->alias);
+	}
+
+	lanes->ints    = 0;
+	lanes->doubles = 0;
+	lanes->bools   = 0;
+	lanes->others  = 0;
+
+	// lanes past the end of the batch are compared but never selected
+	for(uint i = n; i < BATCH_FILTER_CAP; i++) {
+		lanes->i64[i] = 0;
+		lanes->f64[i] = 0;
+	}
+
+	for(uint i = 0; i < n; i++) {
+		uint64_t bit = 1ULL << i;
+		if(!(active & bit)) {
+			lanes->i64[i] = 0;
+			lanes->f64[i] = 0;
+			continue;
+		}
+
+		Record r = batch[i];
+		SIValue v;
+		bool owned = false;
+
+		RecordEntryType t = (f->idx != INVALID_INDEX)
+			? Record_GetType(r, f->idx)
+			: REC_TYPE_UNKNOWN;
+
+		if(t == REC_TYPE_NODE || t == REC_TYPE_EDGE) {
+			// fast path, read attribute directly from the entity
+			GraphEntity *e = Record_GetGraphEntity(r, f->idx);
+			v = *GraphEntity_GetProperty(e, f->attr_id);
+		} else {
+			// maps, points, missing entities
+			v = AR_EXP_Evaluate(f->exp, r);
+			owned = true;
+		}
+
+		switch(SI_TYPE(v)) {
+			case T_NULL:
+				break;
+			case T_INT64:
+				lanes->ints |= bit;
+				lanes->i64[i] = v.longval;
+				lanes->f64[i] = (double)v.longval;
+				break;
+			case T_DOUBLE:
+				lanes->doubles |= bit;
+				lanes->i64[i] = 0;
+				lanes->f64[i] = v.doubleval;
+				break;
+			case T_BOOL:
+				lanes->bools |= bit;
+				lanes->i64[i] = v.longval;
+				lanes->f64[i] = 0;
+				break;
+			default:
+				lanes->others |= bit;
+				lanes->i64[i] = 0;
+				lanes->f64[i] = 0;
+				break;
+		}
+
+		if(owned) SIValue_Free(v);
+	}
+}
+
+// evaluate a single predicate over a batch of records
+// NULL comparisons do not pass
+static uint64_t _ApplyPredicate
+(
+	BatchFilter *f,       // predicate
+	const Record *batch,  // records
+	uint n,               // number of records
+	uint64_t active       // records to evaluate
+) {
+	Lanes lanes;
+	_Gather(f, batch, n, active, &lanes);
+
+	uint64_t m = 0;
+	uint64_t numerics = lanes.ints | lanes.doubles;
+
+	// values of disjoint types only pass inequality
+	uint64_t disjoint = 0;
+
+	switch(SI_TYPE(f->c)) {
+		case T_INT64:
+			if(lanes.ints) {
+				m |= _Compare_i64(lanes.i64, f->c.longval, f->op) & lanes.ints;
+			}
+			if(lanes.doubles) {
+				m |= _Compare_f64(lanes.f64, (double)f->c.longval, f->op) &
+					lanes.doubles;
+			}
+			disjoint = lanes.bools | lanes.others;
+			break;
+		case T_DOUBLE:
+			if(numerics) {
+				m |= _Compare_f64(lanes.f64, f->c.doubleval, f->op) & numerics;
+			}
+			disjoint = lanes.bools | lanes.others;
+			break;
+		case T_BOOL:
+			if(lanes.bools) {
+				m |= _Compare_i64(lanes.i64, f->c.longval, f->op) & lanes.bools;
+			}
+			disjoint = numerics | lanes.others;
+			break;
+		default:
+			ASSERT(false);
+	}
+
+	if(f->op == OP_NEQUAL) m |= disjoint;
+
+	return m;
+}
+
+// evaluate filter over the active records of a batch
+// like FilterTree_applyFilters, the right-hand side of a condition is only
+// evaluated for records not decided by its left-hand side
+static uint64_t _Apply
+(
+	BatchFilter *f,       // filter
+	const Record *batch,  // records
+	uint n,               // number of records
+	uint64_t active       // records to evaluate
+) {
+	if(f->left == NULL) return _ApplyPredicate(f, batch, n, active);
+
+	uint64_t m = _Apply(f->left, batch, n, active);
+
+	if(f->op == OP_AND) {
+		// records failing the left-hand side are decided
+		if(m == 0) return 0;
+		return _Apply(f->right, batch, n, m);
+	} else {
+		// records passing the left-hand side are decided
+		uint64_t undecided = active & ~m;
+		if(undecided == 0) return m;
+		return m | _Apply(f->right, batch, n, undecided);
+	}
+}
+
+uint64_t BatchFilter_Apply
+(
+	BatchFilter *f,       // batch filter
+	const Record *batch,  // records to evaluate
+	uint n                // number of records, at most BATCH_FILTER_CAP
+) {
+	ASSERT(f     != NULL);
+	ASSERT(batch != NULL);
+	ASSERT(n > 0 && n <= BATCH_FILTER_CAP);
+
+	uint64_t all = (n == 64) ? UINT64_MAX : ((1ULL << n) - 1);
+	return _Apply(f, batch, n, all);
+}
+
+void BatchFilter_Free
+(
+	BatchFilter *f  // batch filter to free
+) {
+	ASSERT(f != NULL);
+
+	if(f->left != NULL) {
+		// condition
+		BatchFilter_Free(f->left);
+		BatchFilter_Free(f->right);
+	} else {
+		// predicate
+		SIValue_Free(f->c);
+	}
+
+	rm_free(f);
+}
+
@@ -0,0 +1,56 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "filter_tree.h"
+
+#include <stdint.h>
+
+// a batch filter is a compiled form of a filter tree
+// evaluating a batch of records at once
+//
+// filter trees made of AND / OR conditions over predicates of the form:
+// `alias.attribute OP constant` where OP is one of: =, <>, <, <=, >, >=
+// and constant is an integer, float or boolean literal or parameter
+// can be compiled
+//
+// attribute values of all records in the batch are gathered into
+// typed lanes, each predicate is then evaluated over its lanes
+// producing a selection bitmap, bitmaps are combined according to
+// the tree's conditions
+//
+// results are identical to those of FilterTree_applyFilters
+
+// max number of records evaluated at once, one bit per record
+#define BATCH_FILTER_CAP 64
+
+typedef struct BatchFilter BatchFilter;
+
+// compile filter tree into a batch filter
+// returns NULL if the tree can't be compiled
+// constants and parameters are evaluated at compile time
+// as such compilation should happen at execution time
+BatchFilter *BatchFilter_Compile
+(
+	const FT_FilterNode *root  // filter tree to compile
+);
+
+// evaluate filter over a batch of records
+// bit i of the returned bitmap is set if record i passed the filter
+uint64_t BatchFilter_Apply
+(
+	BatchFilter *f,       // batch filter
+	const Record *batch,  // records to evaluate
+	uint n                // number of records, at most BATCH_FILTER_CAP
+);
+
+// free batch filter
+void BatchFilter_Free
+(
+	BatchFilter *f  // batch filter to free
+);
+
@@ -6,6 +6,8 @@
 
 #include "filter_tree_utils.h"
 #include "RG.h"
+#include "../util/rmalloc.h"
+#include "../util/regex_cache.h"
 
 bool isInFilter(const FT_FilterNode *filter) {
 	return (filter->t == FT_N_EXP &&
@@ -94,3 +96,105 @@ bool isDistanceFilter(const FT_FilterNode *filter) {
 	return res;
 }
 
+
+// extracts attribute and literal prefix from a prefix filter
+// n.v STARTS WITH 'abc' or n.v =~ 'abc.*'
+bool extractAttributeAndPrefix(const FT_FilterNode *filter, char **attr,
+		char **prefix, bool *exact) {
+	ASSERT(filter != NULL);
+
+	if(filter->t != FT_N_EXP) return false;
+
+	AR_ExpNode *exp = filter->exp.exp;
+	if(exp->type != AR_EXP_OP) return false;
+
+	const char *func = AR_EXP_GetFuncName(exp);
+	bool regex = strcmp(func, "=~") == 0;
+	if(!regex && strcasecmp(func, "starts with") != 0) return false;
+
+	// make sure filter structure is: attribute op constant string
+	char *a = NULL;
+	SIValue v = SI_NullVal();
+	ASSERT(exp->op.child_count == 2);
+	if(!AR_EXP_IsAttribute(exp->op.children[0], &a)) return false;
+	if(!AR_EXP_ReduceToScalar(exp->op.children[1], true, &v)) return false;
+	if(SI_TYPE(v) != T_STRING) return false;
+
+	// an empty prefix doesn't constrain the attribute
+	char *p = NULL;
+	if(regex) {
+		// the regex is still required to verify each candidate
+		p = Regex_LiteralPrefix(v.stringval);
+	} else if(v.stringval[0] != '\0') {
+		p = rm_strdup(v.stringval);
+	}
+
+	if(p == NULL) return false;
+
+	if(attr) *attr = a;
+	if(exact) *exact = !regex;
+	if(prefix) {
+		*prefix = p;
+	} else {
+		rm_free(p);
+	}
+
+	return true;
+}
+
+// return true if filter constrains an attribute to a constant string prefix
+// n.name STARTS WITH 'Jo'
+bool isPrefixFilter(const FT_FilterNode *filter) {
+	return extractAttributeAndPrefix(filter, NULL, NULL, NULL);
+}
+
+// extracts attribute and literal substring from a substring filter
+// n.v CONTAINS 'abc', n.v ENDS WITH 'abc' or n.v =~ '.*abc.*'
+bool extractAttributeAndSubstring(const FT_FilterNode *filter, char **attr,
+		char **substr, bool *exact) {
+	ASSERT(filter != NULL);
+
+	if(filter->t != FT_N_EXP) return false;
+
+	AR_ExpNode *exp = filter->exp.exp;
+	if(exp->type != AR_EXP_OP) return false;
+
+	const char *func = AR_EXP_GetFuncName(exp);
+	bool regex    = strcmp(func, "=~") == 0;
+	bool contains = strcasecmp(func, "contains") == 0;
+	if(!regex && !contains && strcasecmp(func, "ends with") != 0) return false;
+
+	// make sure filter structure is: attribute op constant string
+	char *a = NULL;
+	SIValue v = SI_NullVal();
+	ASSERT(exp->op.child_count == 2);
+	if(!AR_EXP_IsAttribute(exp->op.children[0], &a)) return false;
+	if(!AR_EXP_ReduceToScalar(exp->op.children[1], true, &v)) return false;
+	if(SI_TYPE(v) != T_STRING) return false;
+
+	// an empty substring doesn't constrain the attribute
+	char *s = NULL;
+	if(regex) {
+		s = Regex_LiteralSubstring(v.stringval);
+	} else if(v.stringval[0] != '\0') {
+		s = rm_strdup(v.stringval);
+	}
+
+	if(s == NULL) return false;
+
+	if(attr) *attr = a;
+	if(exact) *exact = contains;
+	if(substr) {
+		*substr = s;
+	} else {
+		rm_free(s);
+	}
+
+	return true;
+}
+
+// return true if filter constrains an attribute to contain a constant string
+// n.name CONTAINS 'oh'
+bool isSubstringFilter(const FT_FilterNode *filter) {
+	return extractAttributeAndSubstring(filter, NULL, NULL, NULL);
+}
@@ -15,3 +15,23 @@ bool extractOriginAndRadius(const FT_FilterNode *filter, SIValue *origin,
 
 bool isDistanceFilter(const FT_FilterNode *filter);
 
+
+// extracts attribute and literal prefix from a prefix filter
+// n.v STARTS WITH 'abc' or n.v =~ 'abc.*'
+// 'exact' is set if every string starting with 'prefix' passes the filter
+// the returned prefix should be freed by the caller
+bool extractAttributeAndPrefix(const FT_FilterNode *filter, char **attr,
+		char **prefix, bool *exact);
+
+// return true if filter constrains an attribute to a constant string prefix
+bool isPrefixFilter(const FT_FilterNode *filter);
+
+// extracts attribute and literal substring from a substring filter
+// n.v CONTAINS 'abc', n.v ENDS WITH 'abc' or n.v =~ '.*abc.*'
+// 'exact' is set if every string containing 'substr' passes the filter
+// the returned substring should be freed by the caller
+bool extractAttributeAndSubstring(const FT_FilterNode *filter, char **attr,
+		char **substr, bool *exact);
+
+// return true if filter constrains an attribute to contain a constant string
+bool isSubstringFilter(const FT_FilterNode *filter);
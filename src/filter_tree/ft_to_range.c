@@ -0,0 +1,810 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "ft_to_range.h"
+#include "../util/arr.h"
+#include "filter_tree_utils.h"
+#include "../util/rmalloc.h"
+#include "../datatypes/point.h"
+#include "../datatypes/array.h"
+
+#include <math.h>
+
+// lower bound of the number of meters in one degree of latitude
+#define LAT_DEGREE_METERS 110000.0
+
+// distance is computed in single precision, pad latitude bands
+#define LAT_PADDING_METERS 100.0
+
+// edge endpoints pseudo attributes, see op_edge_by_index_scan.c
+#define SRC_ID_ATTRIBUTE  "_src_id"
+#define DEST_ID_ATTRIBUTE "_dest_id"
+
+// sub tree resolved regardless of the chosen plan
+#define PLAN_ABSORBED -1
+
+// a plan resolving a filter, the union of its ranges
+// a plan without any ranges which doesn't scan everything matches nothing
+typedef struct {
+	RangeIndexRange *ranges;  // ranges to union
+	bool all;                 // scan every indexed entity
+	bool exact;               // plan produces exactly the entities passing filter
+} RangePlan;
+
+static void _FilterTreeToPlan
+(
+	RangePlan *plan,            // [output] plan
+	const FT_FilterNode *tree,  // filter to convert
+	const Index idx             // queried index
+);
+
+//------------------------------------------------------------------------------
+// ranges
+//------------------------------------------------------------------------------
+
+#define CMP(a, b) (((a) > (b)) - ((a) < (b)))
+
+// compare two bounds of the same class
+static int _Bound_Compare
+(
+	SIValue a,
+	SIValue b
+) {
+	if(SI_TYPE(a) == T_STRING) return strcmp(a.stringval, b.stringval);
+
+	if(SI_TYPE(a) == SI_TYPE(b) && SI_TYPE(a) != T_DOUBLE) {
+		// booleans and integers
+		return CMP(a.longval, b.longval);
+	}
+
+	long double x = (SI_TYPE(a) == T_DOUBLE) ? a.doubleval : a.longval;
+	long double y = (SI_TYPE(b) == T_DOUBLE) ? b.doubleval : b.longval;
+	return CMP(x, y);
+}
+
+// initialize an unbounded range over all values of class 'cls'
+static inline void _Range_Init
+(
+	RangeIndexRange *range,  // range to initialize
+	Attribute_ID attr,       // queried attribute
+	RangeKeyClass cls        // class of values
+) {
+	range->attr        = attr;
+	range->cls         = cls;
+	range->min         = SI_NullVal();
+	range->max         = SI_NullVal();
+	range->include_min = true;
+	range->include_max = true;
+	range->substr      = NULL;
+}
+
+static void _Range_TightenMin
+(
+	RangeIndexRange *range,  // range to tighten
+	SIValue v,               // new lower bound
+	bool inclusive           // bound is inclusive
+) {
+	if(SI_TYPE(range->min) != T_NULL) {
+		int c = _Bound_Compare(v, range->min);
+		if(c < 0) return;
+		if(c == 0) {
+			range->include_min &= inclusive;
+			return;
+		}
+		SIValue_Free(range->min);
+	}
+
+	range->min         = SI_CloneValue(v);
+	range->include_min = inclusive;
+}
+
+static void _Range_TightenMax
+(
+	RangeIndexRange *range,  // range to tighten
+	SIValue v,               // new upper bound
+	bool inclusive           // bound is inclusive
+) {
+	if(SI_TYPE(range->max) != T_NULL) {
+		int c = _Bound_Compare(v, range->max);
+		if(c > 0) return;
+		if(c == 0) {
+			range->include_max &= inclusive;
+			return;
+		}
+		SIValue_Free(range->max);
+	}
+
+	range->max         = SI_CloneValue(v);
+	range->include_max = inclusive;
+}
+
+// tighten range such that it satisfies: value 'op' 'v'
+static void _Range_Tighten
+(
+	RangeIndexRange *range,  // range to tighten
+	AST_Operator op,         // comparison operator
+	SIValue v                // compared value
+) {
+	switch(op) {
+		case OP_EQUAL:
+			_Range_TightenMin(range, v, true);
+			_Range_TightenMax(range, v, true);
+			break;
+		case OP_LT:
+			_Range_TightenMax(range, v, false);
+			break;
+		case OP_LE:
+			_Range_TightenMax(range, v, true);
+			break;
+		case OP_GT:
+			_Range_TightenMin(range, v, false);
+			break;
+		case OP_GE:
+			_Range_TightenMin(range, v, true);
+			break;
+		default:
+			ASSERT(false && "unexpected operator");
+			break;
+	}
+}
+
+// returns false if no value can be within range
+static bool _Range_Valid
+(
+	const RangeIndexRange *range
+) {
+	if(SI_TYPE(range->min) == T_NULL || SI_TYPE(range->max) == T_NULL) {
+		return true;
+	}
+
+	int c = _Bound_Compare(range->min, range->max);
+	return c < 0 || (c == 0 && range->include_min && range->include_max);
+}
+
+// rank range by the number of entries it is expected to scan, lower is better
+static int _Range_Score
+(
+	const RangeIndexRange *range
+) {
+	bool has_min = SI_TYPE(range->min) != T_NULL;
+	bool has_max = SI_TYPE(range->max) != T_NULL;
+
+	// substrings spanning a trigram are resolved by trigram postings
+	// shorter substrings scan the entire class
+	if(range->substr != NULL) {
+		return (strlen(range->substr) >= RANGE_TRIGRAM_LEN) ? 1 : 3;
+	}
+
+	if(has_min && has_max) {
+		// equality
+		if(range->cls != RANGE_KEY_POINT &&
+		   _Bound_Compare(range->min, range->max) == 0) {
+			return 0;
+		}
+		return 1;
+	}
+
+	if(has_min || has_max) return 2;
+
+	// class scan
+	return 3;
+}
+
+//------------------------------------------------------------------------------
+// plans
+//------------------------------------------------------------------------------
+
+// initialize an exact plan matching nothing
+static inline void _RangePlan_Init
+(
+	RangePlan *plan
+) {
+	plan->all    = false;
+	plan->exact  = true;
+	plan->ranges = array_new(RangeIndexRange, 1);
+}
+
+static inline bool _RangePlan_Empty
+(
+	const RangePlan *plan
+) {
+	return !plan->all && array_len(plan->ranges) == 0;
+}
+
+static void _RangePlan_FreeRanges
+(
+	RangePlan *plan
+) {
+	uint n = array_len(plan->ranges);
+	for(uint i = 0; i < n; i++) {
+		SIValue_Free(plan->ranges[i].min);
+		SIValue_Free(plan->ranges[i].max);
+		if(plan->ranges[i].substr != NULL) rm_free(plan->ranges[i].substr);
+	}
+	array_clear(plan->ranges);
+}
+
+// plan can't be resolved by the index, scan every indexed entity
+static void _RangePlan_All
+(
+	RangePlan *plan
+) {
+	_RangePlan_FreeRanges(plan);
+	plan->all   = true;
+	plan->exact = false;
+}
+
+// move ranges of 'src' into 'dest', 'src' is freed
+static void _RangePlan_Move
+(
+	RangePlan *dest,
+	RangePlan *src
+) {
+	uint n = array_len(src->ranges);
+	for(uint i = 0; i < n; i++) {
+		array_append(dest->ranges, src->ranges[i]);
+	}
+	array_free(src->ranges);
+	src->ranges = NULL;
+}
+
+static void _RangePlan_Free
+(
+	RangePlan *plan
+) {
+	if(plan->ranges == NULL) return;
+
+	_RangePlan_FreeRanges(plan);
+	array_free(plan->ranges);
+	plan->ranges = NULL;
+}
+
+// rank plan by the number of entries it is expected to scan, lower is better
+static int _RangePlan_Score
+(
+	const RangePlan *plan
+) {
+	if(plan->all) return 4;
+	if(_RangePlan_Empty(plan)) return -1;
+
+	int score = 0;
+	uint n = array_len(plan->ranges);
+	for(uint i = 0; i < n; i++) {
+		int s = _Range_Score(plan->ranges + i);
+		if(s > score) score = s;
+	}
+
+	return score;
+}
+
+// returns true if plan 'a' is preferred over plan 'b'
+static bool _RangePlan_Better
+(
+	const RangePlan *a,
+	const RangePlan *b
+) {
+	int sa = _RangePlan_Score(a);
+	int sb = _RangePlan_Score(b);
+	if(sa != sb) return sa < sb;
+
+	// exact plans spare the residual filter
+	if(a->exact != b->exact) return a->exact;
+
+	return array_len(a->ranges) < array_len(b->ranges);
+}
+
+//------------------------------------------------------------------------------
+// filter to plan
+//------------------------------------------------------------------------------
+
+// returns ID of indexed attribute accessed by 'exp'
+// ATTRIBUTE_ID_NONE if 'exp' isn't an indexed attribute access
+static Attribute_ID _IndexedAttribute
+(
+	const AR_ExpNode *exp,  // expression
+	const Index idx         // queried index
+) {
+	char *attr = NULL;
+	if(!AR_EXP_IsAttribute(exp, &attr)) return ATTRIBUTE_ID_NONE;
+
+	uint n = Index_FieldsCount(idx);
+	const IndexField *fields = Index_GetFields(idx);
+	for(uint i = 0; i < n; i++) {
+		if(strcmp(fields[i].name, attr) == 0) return fields[i].id;
+	}
+
+	return ATTRIBUTE_ID_NONE;
+}
+
+static inline bool _OrderedClass
+(
+	RangeKeyClass cls
+) {
+	return cls == RANGE_KEY_BOOL    ||
+		   cls == RANGE_KEY_NUMERIC ||
+		   cls == RANGE_KEY_STRING;
+}
+
+// add an equality range or a class scan for 'v' to plan
+static void _RangePlan_AddValue
+(
+	RangePlan *plan,    // plan to update
+	Attribute_ID attr,  // queried attribute
+	AST_Operator op,    // comparison operator
+	SIValue v           // compared value
+) {
+	RangeIndexRange range;
+	RangeKeyClass cls = RangeKey_Class(v);
+
+	// comparing against NULL never passes
+	if(cls == RANGE_KEY_NONE) return;
+
+	_Range_Init(&range, attr, cls);
+
+	if(_OrderedClass(cls)) {
+		_Range_Tighten(&range, op, v);
+	} else if(cls == RANGE_KEY_POINT && op == OP_EQUAL) {
+		// points are ordered by latitude first
+		double lat = Point_lat(v);
+		range.min  = SI_DoubleVal(lat);
+		range.max  = SI_DoubleVal(lat);
+		plan->exact = false;
+	} else {
+		// values of the same class might pass, e.g. point equality
+		// scan the entire class and let the residual filter decide
+		plan->exact = false;
+	}
+
+	array_append(plan->ranges, range);
+}
+
+// n.v op exp
+static void _PredicateToPlan
+(
+	RangePlan *plan,            // [output] plan
+	const FT_FilterNode *tree,  // predicate
+	const Index idx             // queried index
+) {
+	AST_Operator op = tree->pred.op;
+	Attribute_ID attr = _IndexedAttribute(tree->pred.lhs, idx);
+
+	if(attr == ATTRIBUTE_ID_NONE ||
+	   !(op == OP_EQUAL || op == OP_LT || op == OP_LE ||
+		 op == OP_GT    || op == OP_GE)) {
+		_RangePlan_All(plan);
+		return;
+	}
+
+	SIValue v = AR_EXP_Evaluate(tree->pred.rhs, NULL);
+	_RangePlan_AddValue(plan, attr, op, v);
+	SIValue_Free(v);
+}
+
+// n.v IN [...]
+static void _InToPlan
+(
+	RangePlan *plan,            // [output] plan
+	const FT_FilterNode *tree,  // IN filter
+	const Index idx             // queried index
+) {
+	AR_ExpNode *in = tree->exp.exp;
+	Attribute_ID attr = _IndexedAttribute(in->op.children[0], idx);
+	if(attr == ATTRIBUTE_ID_NONE) {
+		_RangePlan_All(plan);
+		return;
+	}
+
+	SIValue list = AR_EXP_Evaluate(in->op.children[1], NULL);
+	if(SI_TYPE(list) != T_ARRAY) {
+		_RangePlan_All(plan);
+		SIValue_Free(list);
+		return;
+	}
+
+	// a single equality range for each element, an empty list matches nothing
+	uint n = SIArray_Length(list);
+	for(uint i = 0; i < n; i++) {
+		_RangePlan_AddValue(plan, attr, OP_EQUAL, SIArray_Get(list, i));
+	}
+
+	SIValue_Free(list);
+}
+
+// distance(n.v, origin) < radius
+// converted into a latitude band around origin
+static void _DistanceToPlan
+(
+	RangePlan *plan,            // [output] plan
+	const FT_FilterNode *tree,  // distance filter
+	const Index idx             // queried index
+) {
+	char    *field  = NULL;
+	SIValue origin  = SI_NullVal();
+	SIValue radius  = SI_NullVal();
+
+	extractOriginAndRadius(tree, &origin, &radius, &field);
+
+	// find queried attribute
+	Attribute_ID attr = ATTRIBUTE_ID_NONE;
+	uint n = Index_FieldsCount(idx);
+	const IndexField *fields = Index_GetFields(idx);
+	for(uint i = 0; i < n; i++) {
+		if(strcmp(fields[i].name, field) == 0) attr = fields[i].id;
+	}
+
+	if(attr == ATTRIBUTE_ID_NONE || SI_TYPE(origin) != T_POINT) {
+		_RangePlan_All(plan);
+	} else {
+		double r     = SI_GET_NUMERIC(radius);
+		double delta = ((r > 0) ? r : 0) + LAT_PADDING_METERS;
+		double lat   = Point_lat(origin);
+
+		delta /= LAT_DEGREE_METERS;
+
+		RangeIndexRange range;
+		_Range_Init(&range, attr, RANGE_KEY_POINT);
+		range.min = SI_DoubleVal(lat - delta);
+		range.max = SI_DoubleVal(lat + delta);
+
+		array_append(plan->ranges, range);
+
+		// the band contains points further than radius
+		plan->exact = false;
+	}
+
+	SIValue_Free(origin);
+	SIValue_Free(radius);
+}
+
+// n.v STARTS WITH 'abc' or n.v =~ 'abc.*'
+// converted into the range of strings starting with prefix
+static void _PrefixToPlan
+(
+	RangePlan *plan,            // [output] plan
+	const FT_FilterNode *tree,  // prefix filter
+	const Index idx             // queried index
+) {
+	bool exact    = false;
+	char *prefix  = NULL;
+
+	// prefix might be unavailable at runtime, e.g. n.v =~ $regex
+	Attribute_ID attr = ATTRIBUTE_ID_NONE;
+	if(extractAttributeAndPrefix(tree, NULL, &prefix, &exact)) {
+		attr = _IndexedAttribute(tree->exp.exp->op.children[0], idx);
+	}
+
+	if(attr == ATTRIBUTE_ID_NONE) {
+		_RangePlan_All(plan);
+		if(prefix != NULL) rm_free(prefix);
+		return;
+	}
+
+	RangeIndexRange range;
+	_Range_Init(&range, attr, RANGE_KEY_STRING);
+
+	// strings starting with prefix are ordered before the prefix's successor
+	// the prefix with its last byte incremented, trailing 0xFF bytes dropped
+	size_t n = strlen(prefix);
+	char *successor = rm_strdup(prefix);
+	while(n > 0 && (unsigned char)successor[n - 1] == 0xFF) n--;
+
+	if(n > 0) {
+		successor[n - 1]++;
+		successor[n] = '\0';
+		range.max         = SI_TransferStringVal(successor);
+		range.include_max = false;
+	} else {
+		rm_free(successor);
+	}
+
+	range.min = SI_TransferStringVal(prefix);
+	array_append(plan->ranges, range);
+
+	// a regex is verified against every string in range
+	plan->exact = exact;
+}
+
+// n.v CONTAINS 'abc', n.v ENDS WITH 'abc' or n.v =~ '.*abc.*'
+// converted into a substring range over all strings
+static void _SubstringToPlan
+(
+	RangePlan *plan,            // [output] plan
+	const FT_FilterNode *tree,  // substring filter
+	const Index idx             // queried index
+) {
+	bool exact    = false;
+	char *substr  = NULL;
+
+	Attribute_ID attr = ATTRIBUTE_ID_NONE;
+	if(extractAttributeAndSubstring(tree, NULL, &substr, &exact)) {
+		attr = _IndexedAttribute(tree->exp.exp->op.children[0], idx);
+	}
+
+	if(attr == ATTRIBUTE_ID_NONE) {
+		_RangePlan_All(plan);
+		if(substr != NULL) rm_free(substr);
+		return;
+	}
+
+	RangeIndexRange range;
+	_Range_Init(&range, attr, RANGE_KEY_STRING);
+	range.substr = substr;
+	array_append(plan->ranges, range);
+
+	// the index verifies containment
+	// suffixes and regexes are verified by the residual filter
+	plan->exact = exact;
+}
+
+static void _ConditionToPlan
+(
+	RangePlan *plan,            // [output] plan
+	const FT_FilterNode *tree,  // condition
+	const Index idx             // queried index
+) {
+	RangePlan l;
+	RangePlan r;
+
+	_FilterTreeToPlan(&l, tree->cond.left, idx);
+	_FilterTreeToPlan(&r, tree->cond.right, idx);
+
+	switch(tree->cond.op) {
+		case OP_OR:
+			if(l.all || r.all) {
+				_RangePlan_All(plan);
+			} else {
+				_RangePlan_Move(plan, &l);
+				_RangePlan_Move(plan, &r);
+				plan->exact = l.exact && r.exact;
+			}
+			break;
+		case OP_AND:
+			// intersecting ranges isn't supported, use the better side
+			// an empty side is exact, the conjunction matches nothing
+			if(_RangePlan_Better(&l, &r)) {
+				plan->all = l.all;
+				_RangePlan_Move(plan, &l);
+			} else {
+				plan->all = r.all;
+				_RangePlan_Move(plan, &r);
+			}
+			plan->exact = _RangePlan_Empty(plan);
+			break;
+		default:
+			// XOR, XNOR
+			_RangePlan_All(plan);
+			break;
+	}
+
+	_RangePlan_Free(&l);
+	_RangePlan_Free(&r);
+}
+
+static void _FilterTreeToPlan
+(
+	RangePlan *plan,            // [output] plan
+	const FT_FilterNode *tree,  // filter to convert
+	const Index idx             // queried index
+) {
+	_RangePlan_Init(plan);
+
+	if(isInFilter(tree)) {
+		_InToPlan(plan, tree, idx);
+	} else if(isDistanceFilter(tree)) {
+		_DistanceToPlan(plan, tree, idx);
+	} else if(isPrefixFilter(tree)) {
+		// a regex's literal prefix is preferred over its substring
+		_PrefixToPlan(plan, tree, idx);
+	} else if(isSubstringFilter(tree)) {
+		_SubstringToPlan(plan, tree, idx);
+	} else if(tree->t == FT_N_PRED) {
+		_PredicateToPlan(plan, tree, idx);
+	} else if(tree->t == FT_N_COND) {
+		_ConditionToPlan(plan, tree, idx);
+	} else {
+		_RangePlan_All(plan);
+	}
+}
+
+//------------------------------------------------------------------------------
+// filter tree to query
+//------------------------------------------------------------------------------
+
+// returns true if 'tree' constrains edge endpoints, e._src_id = constant
+// in which case the query is updated
+static bool _EndpointPredicate
+(
+	RangeQuery *q,             // query to update
+	const FT_FilterNode *tree  // sub tree
+) {
+	char *attr = NULL;
+	if(tree->t != FT_N_PRED || tree->pred.op != OP_EQUAL) return false;
+	if(!AR_EXP_IsAttribute(tree->pred.lhs, &attr)) return false;
+
+	EntityID *endpoint = NULL;
+	if(strcmp(attr, SRC_ID_ATTRIBUTE) == 0) {
+		endpoint = &q->src_id;
+	} else if(strcmp(attr, DEST_ID_ATTRIBUTE) == 0) {
+		endpoint = &q->dest_id;
+	} else {
+		return false;
+	}
+
+	SIValue v = AR_EXP_Evaluate(tree->pred.rhs, NULL);
+	ASSERT(SI_TYPE(v) == T_INT64);
+	*endpoint = v.longval;
+
+	return true;
+}
+
+// returns true if 'tree' is a comparison between an indexed attribute and an
+// orderable value or NULL, such predicates on the same attribute are merged
+static bool _MergeablePredicate
+(
+	const FT_FilterNode *tree,  // sub tree
+	const Index idx,            // queried index
+	Attribute_ID *attr,         // [output] compared attribute
+	SIValue *v                  // [output] compared value
+) {
+	if(tree->t != FT_N_PRED || isDistanceFilter(tree)) return false;
+
+	AST_Operator op = tree->pred.op;
+	if(!(op == OP_EQUAL || op == OP_LT || op == OP_LE ||
+		 op == OP_GT    || op == OP_GE)) {
+		return false;
+	}
+
+	*attr = _IndexedAttribute(tree->pred.lhs, idx);
+	if(*attr == ATTRIBUTE_ID_NONE) return false;
+
+	*v = AR_EXP_Evaluate(tree->pred.rhs, NULL);
+	RangeKeyClass cls = RangeKey_Class(*v);
+	if(cls == RANGE_KEY_NONE || _OrderedClass(cls)) return true;
+
+	SIValue_Free(*v);
+	return false;
+}
+
+// creates a range query out of given filter tree
+//
+// the filter is broken into its top level conjuncts
+// comparisons on the same attribute are merged into a single range
+// every other conjunct is converted into a plan of its own
+// the plan expected to scan the fewest entries is executed and
+// every conjunct which isn't exactly resolved by it is returned as a filter
+RangeQuery *FilterTreeToRangeQuery
+(
+	FT_FilterNode **none_converted_filters,  // [output] none converted filters
+	const FT_FilterNode *tree,               // filter tree to convert
+	const Index idx                          // queried index
+) {
+	ASSERT(idx                    != NULL);
+	ASSERT(tree                   != NULL);
+	ASSERT(none_converted_filters != NULL);
+	ASSERT(Index_RangeIndex(idx)  != NULL);
+
+	RangeQuery          *q           = RangeQuery_New();
+	const FT_FilterNode **trees      = FilterTree_SubTrees(tree);
+	uint                tree_count   = array_len(trees);
+	uint                field_count  = Index_FieldsCount(idx);
+	const IndexField    *fields      = Index_GetFields(idx);
+
+	int       owner[tree_count];                // plan resolving each sub tree
+	RangePlan plans[field_count + tree_count];  // candidate plans
+	uint      plan_count = field_count;         // first plan per field
+
+	// merged comparisons, a single range per field
+	RangeIndexRange merged[field_count];
+	bool            conflict[field_count];
+
+	for(uint i = 0; i < field_count; i++) {
+		plans[i].ranges = NULL;
+		conflict[i]     = false;
+		_Range_Init(merged + i, fields[i].id, RANGE_KEY_NONE);
+	}
+
+	//--------------------------------------------------------------------------
+	// convert sub trees
+	//--------------------------------------------------------------------------
+
+	for(uint i = 0; i < tree_count; i++) {
+		SIValue v;
+		Attribute_ID attr;
+		const FT_FilterNode *t = trees[i];
+
+		if(_EndpointPredicate(q, t)) {
+			owner[i] = PLAN_ABSORBED;
+			continue;
+		}
+
+		if(_MergeablePredicate(t, idx, &attr, &v)) {
+			uint f = 0;
+			while(fields[f].id != attr) f++;
+
+			RangeKeyClass cls = RangeKey_Class(v);
+			if(cls == RANGE_KEY_NONE) {
+				// comparing against NULL never passes
+				conflict[f] = true;
+			} else if(merged[f].cls == RANGE_KEY_NONE) {
+				merged[f].cls = cls;
+			} else if(merged[f].cls != cls) {
+				// values of different classes never compare
+				conflict[f] = true;
+			}
+
+			if(!conflict[f]) _Range_Tighten(merged + f, t->pred.op, v);
+
+			SIValue_Free(v);
+			owner[i] = f;
+			continue;
+		}
+
+		_FilterTreeToPlan(plans + plan_count, t, idx);
+		owner[i] = plan_count++;
+	}
+
+	// convert merged ranges to plans
+	for(uint i = 0; i < field_count; i++) {
+		RangeIndexRange *range = merged + i;
+		if(range->cls == RANGE_KEY_NONE && !conflict[i]) continue;
+
+		_RangePlan_Init(plans + i);
+		if(!conflict[i] && _Range_Valid(range)) {
+			array_append(plans[i].ranges, *range);
+		} else {
+			SIValue_Free(range->min);
+			SIValue_Free(range->max);
+		}
+	}
+
+	//--------------------------------------------------------------------------
+	// pick plan
+	//--------------------------------------------------------------------------
+
+	int best = -1;
+	for(uint i = 0; i < plan_count; i++) {
+		if(plans[i].ranges == NULL) continue;
+		if(best == -1 || _RangePlan_Better(plans + i, plans + best)) best = i;
+	}
+
+	if(best == -1) {
+		// endpoints constraints only
+		q->all = true;
+	} else {
+		RangePlan *plan = plans + best;
+		q->all = plan->all;
+		uint n = array_len(plan->ranges);
+		for(uint i = 0; i < n; i++) RangeQuery_AddRange(q, plan->ranges + i);
+		array_clear(plan->ranges);
+	}
+
+	//--------------------------------------------------------------------------
+	// combine remaining filters
+	//--------------------------------------------------------------------------
+
+	uint residual_count = 0;
+	const FT_FilterNode *residual[tree_count];
+	bool exact = (best != -1 && plans[best].exact);
+
+	for(uint i = 0; i < tree_count; i++) {
+		if(owner[i] == PLAN_ABSORBED) continue;
+		if(exact && owner[i] == best) continue;
+		residual[residual_count++] = trees[i];
+	}
+
+	*none_converted_filters = FilterTree_Combine(residual, residual_count);
+
+	//--------------------------------------------------------------------------
+	// clean up
+	//--------------------------------------------------------------------------
+
+	for(uint i = 0; i < plan_count; i++) _RangePlan_Free(plans + i);
+	array_free(trees);
+
+	return q;
+}
+
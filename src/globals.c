@@ -6,12 +6,15 @@
 
 #include "globals.h"
 #include "util/thpool/pools.h"
+#include "configuration/config.h"
+#include "commands/execution_ctx.h"
 
 struct Globals {
 	pthread_rwlock_t lock;              // READ/WRITE lock
 	bool process_is_child;              // running process is a child process
 	CommandCtx **command_ctxs;          // list of CommandCtxs
 	GraphContext **graphs_in_keyspace;  // list of graphs in keyspace
+	Cache *shared_cache;                // execution plans shared by all graphs
 };
 
 struct Globals _globals = {0};
@@ -27,10 +30,25 @@ void Globals_Init(void) {
 	_globals.command_ctxs = rm_calloc(ThreadPools_ThreadCount() + 1,
 			sizeof(CommandCtx *));
 
+	// create the shared execution plans cache, if enabled
+	uint64_t shared_cache_size;
+	Config_Option_get(Config_SHARED_CACHE_SIZE, &shared_cache_size);
+	if(shared_cache_size > 0) {
+		_globals.shared_cache = Cache_New(shared_cache_size,
+				(CacheEntryFreeFunc)ExecutionCtx_Free,
+				(CacheEntryCopyFunc)ExecutionCtx_Clone);
+	}
+
 	int res = pthread_rwlock_init(&_globals.lock, NULL);
 	ASSERT(res == 0);
 }
 
+// get the execution plans cache shared by all graphs
+// returns NULL if plans aren't shared
+Cache *Globals_GetSharedCache(void) {
+	return _globals.shared_cache;
+}
+
 // read global variable 'process_is_child'
 bool Globals_Get_ProcessIsChild(void) {
 	bool process_is_child = false;
@@ -266,6 +284,7 @@ void Globals_GetCommandCtxs
 void Globals_Free(void) {
 	rm_free(_globals.command_ctxs);
 	array_free(_globals.graphs_in_keyspace);
+	if(_globals.shared_cache != NULL) Cache_Free(_globals.shared_cache);
 	pthread_rwlock_destroy(&_globals.lock);
 }
 
@@ -24,6 +24,10 @@ void Globals_Set_ProcessIsChild
 // get direct access to 'graphs_in_keyspace'
 GraphContext **Globals_Get_GraphsInKeyspace(void);
 
+// get the execution plans cache shared by all graphs
+// returns NULL if plans aren't shared
+Cache *Globals_GetSharedCache(void);
+
 // add graph to global tracker
 void Globals_AddGraph
 (
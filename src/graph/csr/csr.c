@@ -0,0 +1,287 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "csr.h"
+#include "../../util/arr.h"
+#include "../../util/rmalloc.h"
+
+// unpacked content of a single relation matrix
+typedef struct {
+	RelationID r;     // relation type
+	GrB_Index nrows;  // number of rows
+	GrB_Index *Ap;    // row offsets
+	GrB_Index *Aj;    // column indices
+	uint64_t *Ax;     // entries, single edge ID or multi-edge array
+	bool iso;         // all entries share Ax[0]
+} RelationTuples;
+
+// unpack the effective content of relation 'r' in direction 'dir'
+static void _RelationTuples_Load
+(
+	const Graph *g,      // graph
+	RelationID r,        // relation type
+	GRAPH_EDGE_DIR dir,  // either incoming or outgoing
+	RelationTuples *t    // [output] relation tuples
+) {
+	GrB_Info   info;
+	GrB_Matrix A;
+	GrB_Index  Ap_size;
+	GrB_Index  Aj_size;
+	GrB_Index  Ax_size;
+
+	UNUSED(info);
+
+	RG_Matrix M = Graph_GetRelationMatrix(g, r, false);
+
+	// export M + delta-plus - delta-minus without modifying M
+	info = RG_Matrix_export(&A, M);
+	ASSERT(info == GrB_SUCCESS);
+
+	// incoming edges are the rows of the transposed matrix
+	// the transposed relation matrix holds no edge IDs, transpose A instead
+	if(dir == GRAPH_EDGE_DIR_INCOMING) {
+		GrB_Matrix AT;
+		GrB_Index  nrows;
+		GrB_Index  ncols;
+
+		info = GrB_Matrix_nrows(&nrows, A);
+		ASSERT(info == GrB_SUCCESS);
+		info = GrB_Matrix_ncols(&ncols, A);
+		ASSERT(info == GrB_SUCCESS);
+
+		info = GrB_Matrix_new(&AT, GrB_UINT64, ncols, nrows);
+		ASSERT(info == GrB_SUCCESS);
+		info = GrB_transpose(AT, NULL, NULL, A, NULL);
+		ASSERT(info == GrB_SUCCESS);
+
+		GrB_Matrix_free(&A);
+		A = AT;
+	}
+
+	t->r = r;
+	info = GrB_Matrix_nrows(&t->nrows, A);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GxB_Matrix_unpack_CSR(A, &t->Ap, &t->Aj, (void **)&t->Ax, &Ap_size,
+			&Aj_size, &Ax_size, &t->iso, NULL, NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	GrB_Matrix_free(&A);
+}
+
+static void _RelationTuples_Free
+(
+	RelationTuples *t
+) {
+	rm_free(t->Ap);
+	rm_free(t->Aj);
+	rm_free(t->Ax);
+}
+
+// entry at position 'p'
+static inline uint64_t _RelationTuples_Entry
+(
+	const RelationTuples *t,
+	GrB_Index p
+) {
+	return t->iso ? t->Ax[0] : t->Ax[p];
+}
+
+// number of edges held by entry 'x'
+static inline uint64_t _EntryEdgeCount
+(
+	uint64_t x
+) {
+	if(SINGLE_EDGE(x)) return 1;
+	return array_len((EdgeID *)(CLEAR_MSB(x)));
+}
+
+// build a CSR for relation 'r' in direction 'dir'
+CSR *CSR_Build
+(
+	const Graph *g,     // graph
+	RelationID r,       // relation type
+	GRAPH_EDGE_DIR dir  // either incoming or outgoing
+) {
+	ASSERT(g != NULL);
+	ASSERT(dir == GRAPH_EDGE_DIR_INCOMING || dir == GRAPH_EDGE_DIR_OUTGOING);
+	ASSERT(r == GRAPH_NO_RELATION || r < Graph_RelationTypeCount(g));
+
+	//--------------------------------------------------------------------------
+	// unpack relation matrices
+	//--------------------------------------------------------------------------
+
+	uint n = (r == GRAPH_NO_RELATION) ? Graph_RelationTypeCount(g) : 1;
+	RelationTuples *tuples = rm_malloc(sizeof(RelationTuples) * MAX(n, 1));
+
+	uint64_t nrows = 0;
+	for(uint i = 0; i < n; i++) {
+		RelationID rel = (r == GRAPH_NO_RELATION) ? (RelationID)i : r;
+		_RelationTuples_Load(g, rel, dir, tuples + i);
+		nrows = MAX(nrows, tuples[i].nrows);
+	}
+
+	CSR *csr = rm_malloc(sizeof(CSR));
+
+	csr->r         = r;
+	csr->dir       = dir;
+	csr->nrows     = nrows;
+	csr->Ap        = rm_calloc(nrows + 1, sizeof(uint64_t));
+	csr->ref_count = 1;
+
+	//--------------------------------------------------------------------------
+	// compute row offsets
+	//--------------------------------------------------------------------------
+
+	uint64_t *Ap = csr->Ap;
+	for(uint i = 0; i < n; i++) {
+		RelationTuples *t = tuples + i;
+		for(GrB_Index row = 0; row < t->nrows; row++) {
+			for(GrB_Index p = t->Ap[row]; p < t->Ap[row + 1]; p++) {
+				Ap[row + 1] += _EntryEdgeCount(_RelationTuples_Entry(t, p));
+			}
+		}
+	}
+
+	for(uint64_t row = 0; row < nrows; row++) Ap[row + 1] += Ap[row];
+
+	csr->nvals = Ap[nrows];
+	csr->Aj    = rm_malloc(sizeof(NodeID) * csr->nvals);
+	csr->Ae    = rm_malloc(sizeof(EdgeID) * csr->nvals);
+	csr->Ar    = (r == GRAPH_NO_RELATION)
+		? rm_malloc(sizeof(RelationID) * csr->nvals)
+		: NULL;
+
+	//--------------------------------------------------------------------------
+	// populate rows
+	//--------------------------------------------------------------------------
+
+	// next free slot of each row
+	uint64_t *next = rm_malloc(sizeof(uint64_t) * MAX(nrows, 1));
+	memcpy(next, Ap, sizeof(uint64_t) * nrows);
+
+	for(uint i = 0; i < n; i++) {
+		RelationTuples *t = tuples + i;
+		for(GrB_Index row = 0; row < t->nrows; row++) {
+			for(GrB_Index p = t->Ap[row]; p < t->Ap[row + 1]; p++) {
+				uint64_t x = _RelationTuples_Entry(t, p);
+
+				// a multi-edge entry holds a pointer to an array of edge IDs
+				EdgeID *ids   = SINGLE_EDGE(x) ? &x : (EdgeID *)(CLEAR_MSB(x));
+				uint64_t cnt  = SINGLE_EDGE(x) ? 1 : array_len(ids);
+
+				for(uint64_t k = 0; k < cnt; k++) {
+					uint64_t slot = next[row]++;
+					csr->Aj[slot] = t->Aj[p];
+					csr->Ae[slot] = ids[k];
+					if(csr->Ar != NULL) csr->Ar[slot] = t->r;
+				}
+			}
+		}
+		_RelationTuples_Free(t);
+	}
+
+	rm_free(next);
+	rm_free(tuples);
+
+	return csr;
+}
+
+// get the edge at slot 'p' of node 'id'
+void CSR_GetEdge
+(
+	const CSR *csr,   // CSR
+	const Graph *g,   // graph the CSR was built from
+	NodeID id,        // node ID
+	uint64_t p,       // slot within the node's row
+	Edge *e           // [output] edge
+) {
+	ASSERT(g   != NULL);
+	ASSERT(e   != NULL);
+	ASSERT(csr != NULL);
+	ASSERT(p   <  csr->nvals);
+
+	bool outgoing = (csr->dir == GRAPH_EDGE_DIR_OUTGOING);
+
+	*e = (Edge){0};
+	Graph_GetEdge(g, csr->Ae[p], e);
+	ASSERT(e->attributes != NULL);
+
+	e->relationID = CSR_Relation(csr, p);
+	e->src_id     = outgoing ? id : csr->Aj[p];
+	e->dest_id    = outgoing ? csr->Aj[p] : id;
+}
+
+// append the edges of node 'id' to 'edges'
+void CSR_GetNodeEdges
+(
+	const CSR *csr,   // CSR
+	const Graph *g,   // graph the CSR was built from
+	NodeID id,        // node ID
+	Edge **edges      // [output] array of edges
+) {
+	ASSERT(g     != NULL);
+	ASSERT(csr   != NULL);
+	ASSERT(edges != NULL);
+
+	uint64_t begin;
+	uint64_t end;
+	CSR_Row(csr, id, &begin, &end);
+	if(begin == end) return;
+
+	*edges = array_ensure_cap(*edges, array_len(*edges) + (end - begin));
+
+	for(uint64_t p = begin; p < end; p++) {
+		Edge e;
+		CSR_GetEdge(csr, g, id, p, &e);
+		array_append(*edges, e);
+	}
+}
+
+// memory consumed by CSR in bytes
+size_t CSR_MemoryUsage
+(
+	const CSR *csr  // CSR
+) {
+	ASSERT(csr != NULL);
+
+	size_t size = sizeof(CSR);
+	size += sizeof(uint64_t) * (csr->nrows + 1);
+	size += (sizeof(NodeID) + sizeof(EdgeID)) * csr->nvals;
+	if(csr->Ar != NULL) size += sizeof(RelationID) * csr->nvals;
+
+	return size;
+}
+
+// increase CSR reference count
+CSR *CSR_Share
+(
+	CSR *csr  // CSR
+) {
+	ASSERT(csr != NULL);
+
+	__atomic_fetch_add(&csr->ref_count, 1, __ATOMIC_RELAXED);
+	return csr;
+}
+
+// decrease CSR reference count
+// frees CSR once reference count reaches 0
+void CSR_Free
+(
+	CSR *csr  // CSR
+) {
+	ASSERT(csr != NULL);
+
+	if(__atomic_sub_fetch(&csr->ref_count, 1, __ATOMIC_ACQ_REL) > 0) return;
+
+	rm_free(csr->Ap);
+	rm_free(csr->Aj);
+	rm_free(csr->Ae);
+	if(csr->Ar != NULL) rm_free(csr->Ar);
+	rm_free(csr);
+}
+
@@ -0,0 +1,116 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "../graph.h"
+
+#include <stdint.h>
+
+// a CSR is a read-only snapshot of a relation's adjacency
+// in compressed sparse row form
+//
+// row i lists the edges leaving node i when traversing outgoing edges,
+// or the edges reaching node i when traversing incoming edges
+// each edge occupies its own slot, multi-edge entries are expanded
+// slot p holds the ID of the node on the other end of the edge
+// and the edge's ID
+//
+// a CSR built for GRAPH_NO_RELATION holds the edges of all relation types
+// and records the relation type of each edge
+//
+// CSRs are immutable once built and are reference counted
+// see csr_store.h for their lifetime
+
+struct CSR {
+	RelationID r;          // relation type, GRAPH_NO_RELATION for all types
+	GRAPH_EDGE_DIR dir;    // traversal direction, incoming or outgoing
+	uint64_t nrows;        // number of rows
+	uint64_t nvals;        // number of edges
+	uint64_t *Ap;          // row offsets, row i spans [Ap[i], Ap[i+1])
+	NodeID *Aj;            // node on the other end of each edge
+	EdgeID *Ae;            // edge IDs
+	RelationID *Ar;        // edge relation types, NULL unless r is GRAPH_NO_RELATION
+	int ref_count;         // number of references
+};
+
+typedef struct CSR CSR;
+
+// build a CSR for relation 'r' in direction 'dir'
+// caller must hold the graph's READ lock
+CSR *CSR_Build
+(
+	const Graph *g,     // graph
+	RelationID r,       // relation type
+	GRAPH_EDGE_DIR dir  // either incoming or outgoing
+);
+
+// get the slot range [*begin, *end) of node 'id'
+static inline void CSR_Row
+(
+	const CSR *csr,   // CSR
+	NodeID id,        // node ID
+	uint64_t *begin,  // [output] first slot
+	uint64_t *end     // [output] one past the last slot
+) {
+	if(id >= csr->nrows) {
+		*begin = *end = 0;
+		return;
+	}
+
+	*begin = csr->Ap[id];
+	*end   = csr->Ap[id + 1];
+}
+
+// relation type of the edge at slot 'p'
+static inline RelationID CSR_Relation
+(
+	const CSR *csr,  // CSR
+	uint64_t p       // slot
+) {
+	return (csr->Ar != NULL) ? csr->Ar[p] : csr->r;
+}
+
+// get the edge at slot 'p' of node 'id'
+// caller must hold the graph's READ lock
+void CSR_GetEdge
+(
+	const CSR *csr,   // CSR
+	const Graph *g,   // graph the CSR was built from
+	NodeID id,        // node ID
+	uint64_t p,       // slot within the node's row
+	Edge *e           // [output] edge
+);
+
+// append the edges of node 'id' to 'edges'
+// caller must hold the graph's READ lock
+void CSR_GetNodeEdges
+(
+	const CSR *csr,   // CSR
+	const Graph *g,   // graph the CSR was built from
+	NodeID id,        // node ID
+	Edge **edges      // [output] array of edges
+);
+
+// memory consumed by CSR in bytes
+size_t CSR_MemoryUsage
+(
+	const CSR *csr  // CSR
+);
+
+// increase CSR reference count
+CSR *CSR_Share
+(
+	CSR *csr  // CSR
+);
+
+// decrease CSR reference count
+// frees CSR once reference count reaches 0
+void CSR_Free
+(
+	CSR *csr  // CSR
+);
+
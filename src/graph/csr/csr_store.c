@@ -0,0 +1,126 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "csr_store.h"
+#include "../../util/arr.h"
+#include "../../util/rmalloc.h"
+
+#include <pthread.h>
+
+// a single store entry
+typedef struct {
+	RelationID r;        // relation type
+	GRAPH_EDGE_DIR dir;  // traversal direction
+	uint64_t epoch;      // graph write epoch at build time
+	CSR *csr;            // CSR
+} CSREntry;
+
+struct CSRStore {
+	CSREntry *entries;     // store entries
+	pthread_mutex_t lock;  // protects entries
+};
+
+// create a new CSR store
+CSRStore *CSRStore_New(void) {
+	CSRStore *store = rm_malloc(sizeof(CSRStore));
+
+	store->entries = array_new(CSREntry, 0);
+	int res = pthread_mutex_init(&store->lock, NULL);
+	ASSERT(res == 0);
+
+	return store;
+}
+
+// get CSR of relation 'r' in direction 'dir'
+// builds the CSR if it is missing or stale
+CSR *CSRStore_Get
+(
+	CSRStore *store,    // CSR store
+	const Graph *g,     // graph
+	RelationID r,       // relation type
+	GRAPH_EDGE_DIR dir  // either incoming or outgoing
+) {
+	ASSERT(g     != NULL);
+	ASSERT(store != NULL);
+
+	// the epoch can't change while the graph's READ lock is held
+	uint64_t epoch = Graph_WriteEpoch(g);
+
+	//--------------------------------------------------------------------------
+	// lookup
+	//--------------------------------------------------------------------------
+
+	pthread_mutex_lock(&store->lock);
+
+	uint n = array_len(store->entries);
+	for(uint i = 0; i < n; i++) {
+		CSREntry *e = store->entries + i;
+		if(e->r != r || e->dir != dir || e->epoch != epoch) continue;
+
+		CSR *csr = CSR_Share(e->csr);
+		pthread_mutex_unlock(&store->lock);
+		return csr;
+	}
+
+	pthread_mutex_unlock(&store->lock);
+
+	//--------------------------------------------------------------------------
+	// build
+	//--------------------------------------------------------------------------
+
+	// build outside of the store lock
+	// concurrent readers may build the same CSR, the last one is kept
+	CSR *csr = CSR_Build(g, r, dir);
+
+	// the writer holding the write lock may still modify the graph
+	// without advancing the epoch, don't share its CSR
+	if(Graph_WriteLocked(g)) return csr;
+
+	pthread_mutex_lock(&store->lock);
+
+	// drop stale entries, CSRs still in use are freed by their last reader
+	n = array_len(store->entries);
+	for(uint i = 0; i < n; i++) {
+		CSREntry *e = store->entries + i;
+		if(e->epoch == epoch && (e->r != r || e->dir != dir)) continue;
+
+		CSR_Free(e->csr);
+		array_del_fast(store->entries, i);
+		i--;
+		n--;
+	}
+
+	CSREntry e = {
+		.r     = r,
+		.dir   = dir,
+		.epoch = epoch,
+		.csr   = CSR_Share(csr)
+	};
+	array_append(store->entries, e);
+
+	pthread_mutex_unlock(&store->lock);
+
+	return csr;
+}
+
+// free CSR store
+void CSRStore_Free
+(
+	CSRStore *store  // CSR store
+) {
+	ASSERT(store != NULL);
+
+	uint n = array_len(store->entries);
+	for(uint i = 0; i < n; i++) CSR_Free(store->entries[i].csr);
+	array_free(store->entries);
+
+	int res = pthread_mutex_destroy(&store->lock);
+	ASSERT(res == 0);
+
+	rm_free(store);
+}
+
@@ -0,0 +1,40 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "csr.h"
+
+// a CSR store holds a graph's CSRs, keyed by (relation, direction)
+//
+// CSRs are built from the graph's relation matrices on first access
+// and remain valid as long as the graph's write epoch is unchanged
+// once the graph is modified stale CSRs are rebuilt on their next access
+// CSRs built while the graph's write lock is held aren't stored
+
+typedef struct CSRStore CSRStore;
+
+// create a new CSR store
+CSRStore *CSRStore_New(void);
+
+// get CSR of relation 'r' in direction 'dir'
+// builds the CSR if it is missing or stale
+// caller must hold the graph's READ lock and release the returned
+// CSR via CSR_Free
+CSR *CSRStore_Get
+(
+	CSRStore *store,    // CSR store
+	const Graph *g,     // graph
+	RelationID r,       // relation type
+	GRAPH_EDGE_DIR dir  // either incoming or outgoing
+);
+
+// free CSR store
+void CSRStore_Free
+(
+	CSRStore *store  // CSR store
+);
+
@@ -5,6 +5,7 @@
  */
 
 #include <limits.h>
+#include <string.h>
 
 #include "RG.h"
 #include "attribute_set.h"
@@ -394,6 +395,28 @@ AttributeSet AttributeSet_ShallowClone
     return clone;
 }
 
+// moves set into a fresh allocation, values are moved as is
+size_t AttributeSet_Repack
+(
+	AttributeSet *set  // set to move
+) {
+	ASSERT(set != NULL);
+
+	AttributeSet _set = *set;
+	if(_set == NULL) return 0;
+
+	// read-only sets are shared, leave them in place
+	if(ATTRIBUTE_SET_IS_READONLY(_set)) return 0;
+
+	size_t n = ATTRIBUTESET_BYTE_SIZE(_set);
+	AttributeSet repacked = rm_malloc(n);
+	memcpy(repacked, _set, n);
+	rm_free(_set);
+
+	*set = repacked;
+	return n;
+}
+
 // persists all attributes within given set
 void AttributeSet_PersistValues
 (
@@ -124,6 +124,14 @@ void AttributeSet_PersistValues
 	const AttributeSet set  // set to persist
 );
 
+// moves set into a fresh allocation, values are moved as is
+// allows the allocator to place long lived sets densely
+// returns the number of bytes moved
+size_t AttributeSet_Repack
+(
+	AttributeSet *set  // set to move
+);
+
 // free attribute set
 void AttributeSet_Free
 (
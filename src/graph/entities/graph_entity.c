@@ -217,9 +217,10 @@ void GraphEntity_ToString
 
 inline bool GraphEntity_IsDeleted
 (
-	const GraphEntity *e
+	const GraphEntity *e,  // entity to inspect
+	GraphEntityType t      // entity type, node or edge
 ) {
-	return Graph_EntityIsDeleted(e);
+	return Graph_EntityIsDeleted(QueryCtx_GetGraph(), e, t);
 }
 
 inline AttributeSet GraphEntity_GetAttributes
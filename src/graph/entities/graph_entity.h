@@ -90,7 +90,8 @@ void GraphEntity_ToString
 // returns true if the given graph entity has been deleted
 bool GraphEntity_IsDeleted
 (
-	const GraphEntity *e
+	const GraphEntity *e,  // entity to inspect
+	GraphEntityType t      // entity type, node or edge
 );
 
 // returns attribute-set of entity
@@ -8,6 +8,7 @@
 #include "graph.h"
 #include "../util/arr.h"
 #include "../util/rmalloc.h"
+#include "csr/csr_store.h"
 #include "rg_matrix/rg_matrix_iter.h"
 #include "../util/datablock/oo_datablock.h"
 
@@ -66,6 +67,36 @@ void Graph_AcquireWriteLock(Graph *g) {
 
 	pthread_rwlock_wrlock(&g->_rwlock);
 	g->_writelocked = true;
+	g->write_epoch++;
+}
+
+// acquire the write lock without advancing the write epoch
+// as the graph isn't marked as write locked, releasing the lock
+// doesn't advance the epoch either
+void Graph_AcquireMaintenanceLock
+(
+	Graph *g
+) {
+	ASSERT(g != NULL);
+	ASSERT(g->_writelocked == false);
+
+	pthread_rwlock_wrlock(&g->_rwlock);
+}
+
+uint64_t Graph_WriteEpoch
+(
+	const Graph *g
+) {
+	ASSERT(g != NULL);
+	return g->write_epoch;
+}
+
+bool Graph_WriteLocked
+(
+	const Graph *g
+) {
+	ASSERT(g != NULL);
+	return g->_writelocked;
 }
 
 // Release the held lock
@@ -82,6 +113,10 @@ void Graph_ReleaseLock
 	// for a reader thread to be considered as writer, performing illegal access to
 	// underline matrices, consider a context switch after unlocking `_rwlock` but
 	// before setting `_writelocked` to false
+	if(g->_writelocked) {
+		// data derived while the write lock was held might be stale
+		g->write_epoch++;
+	}
 	g->_writelocked = false;
 	pthread_rwlock_unlock(&g->_rwlock);
 }
@@ -467,6 +502,10 @@ Graph *Graph_New
 	// initialize a read-write lock scoped to the individual graph
 	_CreateRWLock(g);
 	g->_writelocked = false;
+	g->write_epoch  = 0;
+
+	// adjacency snapshots are built on demand
+	g->csrs = CSRStore_New();
 
 	// force GraphBLAS updates and resize matrices to node count by default
 	g->SynchronizeMatrix = _MatrixSynchronize;
@@ -706,6 +745,73 @@ void Graph_CreateNode
 	}
 }
 
+// create multiple nodes, labeling them accordingly
+// label matrices are populated in bulk
+void Graph_CreateNodes
+(
+	Graph *g,             // graph to operate on
+	Node **nodes,         // nodes to create
+	LabelID **labels,     // labels of each node
+	uint *label_counts,   // number of labels of each node
+	uint n                // number of nodes
+) {
+	ASSERT(g            != NULL);
+	ASSERT(nodes        != NULL || n == 0);
+	ASSERT(labels       != NULL || n == 0);
+	ASSERT(label_counts != NULL || n == 0);
+
+	GrB_Info info;
+	UNUSED(info);
+
+	uint        label_type_count = Graph_LabelTypeCount(g);
+	GrB_Index **L_ids            = rm_calloc(label_type_count, sizeof(GrB_Index *));
+	GrB_Index  *nl_I             = array_new(GrB_Index, 0);
+	GrB_Index  *nl_J             = array_new(GrB_Index, 0);
+
+	// allocate nodes and collect label tuples
+	for(uint i = 0; i < n; i++) {
+		Node *node = nodes[i];
+		Graph_CreateNode(g, node, NULL, 0);
+
+		NodeID id = ENTITY_GET_ID(node);
+		for(uint j = 0; j < label_counts[i]; j++) {
+			LabelID l = labels[i][j];
+			ASSERT(l < label_type_count);
+
+			if(L_ids[l] == NULL) L_ids[l] = array_new(GrB_Index, 1);
+			array_append(L_ids[l], id);
+			array_append(nl_I, id);
+			array_append(nl_J, l);
+		}
+	}
+
+	// set label matrices at positions [id, id]
+	for(LabelID l = 0; l < label_type_count; l++) {
+		if(L_ids[l] == NULL) continue;
+
+		uint count = array_len(L_ids[l]);
+		RG_Matrix L = Graph_GetLabelMatrix(g, l);
+		info = RG_Matrix_setElements_BOOL(L, L_ids[l], L_ids[l], count);
+		ASSERT(info == GrB_SUCCESS);
+
+		// update labels statistics
+		GraphStatistics_IncNodeCount(&g->stats, l, count);
+		array_free(L_ids[l]);
+	}
+
+	// map labels in each node's set of labels
+	uint nl_count = array_len(nl_I);
+	if(nl_count > 0) {
+		RG_Matrix nl = Graph_GetNodeLabelMatrix(g);
+		info = RG_Matrix_setElements_BOOL(nl, nl_I, nl_J, nl_count);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	rm_free(L_ids);
+	array_free(nl_I);
+	array_free(nl_J);
+}
+
 // label node with each label in 'lbls'
 void Graph_LabelNode
 (
@@ -854,6 +960,92 @@ void Graph_CreateEdge
 	Graph_FormConnection(g, src, dest, id, r);
 }
 
+// create multiple edges
+// each edge's endpoints and relation type must be set
+// relation and adjacency matrices are populated in bulk
+void Graph_CreateEdges
+(
+	Graph *g,      // graph on which to operate
+	Edge **edges,  // edges to create
+	uint n         // number of edges
+) {
+	ASSERT(g     != NULL);
+	ASSERT(edges != NULL || n == 0);
+
+	if(n == 0) return;
+
+	GrB_Info info;
+	UNUSED(info);
+
+	uint        relation_count = Graph_RelationTypeCount(g);
+	GrB_Index **R_I            = rm_calloc(relation_count, sizeof(GrB_Index *));
+	GrB_Index **R_J            = rm_calloc(relation_count, sizeof(GrB_Index *));
+	uint64_t  **R_X            = rm_calloc(relation_count, sizeof(uint64_t *));
+	GrB_Index  *adj_I          = rm_malloc(sizeof(GrB_Index) * n);
+	GrB_Index  *adj_J          = rm_malloc(sizeof(GrB_Index) * n);
+
+	// allocate edges and collect tuples
+	for(uint i = 0; i < n; i++) {
+		Edge *e = edges[i];
+		RelationID r = e->relationID;
+		ASSERT(r >= 0 && r < relation_count);
+
+#ifdef RG_DEBUG
+		// make sure both src and destination nodes exists
+		Node node = GE_NEW_NODE();
+		ASSERT(Graph_GetNode(g, e->src_id, &node)  == true);
+		ASSERT(Graph_GetNode(g, e->dest_id, &node) == true);
+#endif
+
+		EdgeID id;
+		AttributeSet *set = DataBlock_AllocateItem(g->edges, &id);
+		*set = NULL;
+
+		e->id         = id;
+		e->attributes = set;
+
+		if(R_I[r] == NULL) {
+			R_I[r] = array_new(GrB_Index, 1);
+			R_J[r] = array_new(GrB_Index, 1);
+			R_X[r] = array_new(uint64_t, 1);
+		}
+
+		array_append(R_I[r], e->src_id);
+		array_append(R_J[r], e->dest_id);
+		array_append(R_X[r], id);
+
+		adj_I[i] = e->src_id;
+		adj_J[i] = e->dest_id;
+	}
+
+	// rows represent source nodes, columns represent destination nodes
+	RG_Matrix adj = Graph_GetAdjacencyMatrix(g, false);
+	info = RG_Matrix_setElements_BOOL(adj, adj_I, adj_J, n);
+	ASSERT(info == GrB_SUCCESS);
+
+	for(RelationID r = 0; r < relation_count; r++) {
+		if(R_I[r] == NULL) continue;
+
+		uint count = array_len(R_I[r]);
+		RG_Matrix M = Graph_GetRelationMatrix(g, r, false);
+		info = RG_Matrix_setElements_UINT64(M, R_X[r], R_I[r], R_J[r], count);
+		ASSERT(info == GrB_SUCCESS);
+
+		// edges of type r have just been created, update statistics
+		GraphStatistics_IncEdgeCount(&g->stats, r, count);
+
+		array_free(R_I[r]);
+		array_free(R_J[r]);
+		array_free(R_X[r]);
+	}
+
+	rm_free(R_I);
+	rm_free(R_J);
+	rm_free(R_X);
+	rm_free(adj_I);
+	rm_free(adj_J);
+}
+
 // retrieves all either incoming or outgoing edges
 // to/from given node N, depending on given direction
 void Graph_GetNodeEdges
@@ -1111,7 +1303,7 @@ void Graph_DeleteEdges
 		NodeID      src_id    =  Edge_GetSrcNodeID(e);
 		NodeID      dest_id   =  Edge_GetDestNodeID(e);
 
-		ASSERT(!DataBlock_ItemIsDeleted((void *)e->attributes));
+		ASSERT(!DataBlock_ItemIsDeleted(g->edges, ENTITY_GET_ID(e)));
 
 		// an edge of type r has just been deleted, update statistics
 		GraphStatistics_DecEdgeCount(&g->stats, r, 1);
@@ -1157,14 +1349,21 @@ void Graph_DeleteEdges
 
 inline bool Graph_EntityIsDeleted
 (
-	const GraphEntity *e
+	const Graph *g,         // graph
+	const GraphEntity *e,   // entity to inspect
+	GraphEntityType t       // entity type, node or edge
 ) {
+	ASSERT(g != NULL);
+	ASSERT(e != NULL);
+	ASSERT(t == GETYPE_NODE || t == GETYPE_EDGE);
+
 	if(e->attributes == NULL) {
 		// most likely an entity which wasn't created just yet (reserved)
 		return false;
 	}
 
-	return DataBlock_ItemIsDeleted(e->attributes);
+	DataBlock *entities = (t == GETYPE_NODE) ? g->nodes : g->edges;
+	return DataBlock_ItemIsDeleted(entities, ENTITY_GET_ID(e));
 }
 
 static void _Graph_FreeRelationMatrices
@@ -1303,6 +1502,16 @@ RG_Matrix Graph_GetRelationMatrix
 	return m;
 }
 
+CSR *Graph_GetCSR
+(
+	const Graph *g,
+	RelationID r,
+	GRAPH_EDGE_DIR dir
+) {
+	ASSERT(g != NULL);
+	return CSRStore_Get(g->csrs, g, r, dir);
+}
+
 RG_Matrix Graph_GetAdjacencyMatrix
 (
 	const Graph *g,
@@ -1371,6 +1580,7 @@ static void _Graph_Free
 	RG_Matrix_free(&g->_zero_matrix);
 	RG_Matrix_free(&g->adjacency_matrix);
 
+	CSRStore_Free(g->csrs);
 	_Graph_FreeRelationMatrices(g);
 	array_free(g->relations);
 	GraphStatistics_FreeInternals(&g->stats);
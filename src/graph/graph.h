@@ -40,6 +40,10 @@ typedef enum {
 
 // forward declaration of Graph struct
 typedef struct Graph Graph;
+
+// adjacency snapshots, see csr/csr.h
+typedef struct CSR CSR;
+typedef struct CSRStore CSRStore;
 // typedef for synchronization function pointer
 typedef void (*SyncMatrixFunc)(const Graph *, RG_Matrix);
 
@@ -54,6 +58,8 @@ struct Graph {
 	RG_Matrix _zero_matrix;            // zero matrix
 	pthread_rwlock_t _rwlock;          // read-write lock scoped to this specific graph
 	bool _writelocked;                 // true if the read-write lock was acquired by a writer
+	uint64_t write_epoch;              // advanced whenever the graph may be modified
+	CSRStore *csrs;                    // cached adjacency snapshots
 	SyncMatrixFunc SynchronizeMatrix;  // function pointer to matrix synchronization routine
 	GraphStatistics stats;             // graph related statistics
 };
@@ -73,6 +79,29 @@ void Graph_AcquireWriteLock
 	Graph *g
 );
 
+// acquire the graph's write lock without advancing its write epoch
+// used by operations which don't alter the graph's content, e.g. compaction
+void Graph_AcquireMaintenanceLock
+(
+	Graph *g
+);
+
+// returns the graph's write epoch
+// the epoch is advanced whenever the graph's write lock is acquired
+// or released, data derived from the graph is valid as long as the epoch
+// is unchanged and the write lock isn't held
+uint64_t Graph_WriteEpoch
+(
+	const Graph *g
+);
+
+// returns true if the graph's write lock is held by a writer
+// a maintenance lock isn't considered
+bool Graph_WriteLocked
+(
+	const Graph *g
+);
+
 // release the held lock
 void Graph_ReleaseLock
 (
@@ -209,6 +238,25 @@ void Graph_CreateEdge
 	Edge *e
 );
 
+// create multiple nodes, labeling each accordingly
+void Graph_CreateNodes
+(
+	Graph *g,             // graph to operate on
+	Node **nodes,         // nodes to create
+	LabelID **labels,     // labels of each node
+	uint *label_counts,   // number of labels of each node
+	uint n                // number of nodes
+);
+
+// create multiple edges
+// each edge's source, destination and relation type must be set
+void Graph_CreateEdges
+(
+	Graph *g,      // graph on which to operate
+	Edge **edges,  // edges to create
+	uint n         // number of edges
+);
+
 // deletes nodes from the graph
 void Graph_DeleteNodes
 (
@@ -228,7 +276,36 @@ void Graph_DeleteEdges
 // returns true if the given entity has been deleted
 bool Graph_EntityIsDeleted
 (
-	const GraphEntity *e
+	const Graph *g,         // graph
+	const GraphEntity *e,   // entity to inspect
+	GraphEntityType t       // entity type, node or edge
+);
+
+// stages of an incremental memory compaction
+typedef enum {
+	COMPACTION_BLOCKS,           // release fully deleted entity blocks
+	COMPACTION_NODE_ATTRIBUTES,  // repack node attribute sets
+	COMPACTION_EDGE_ATTRIBUTES,  // repack edge attribute sets
+	COMPACTION_MATRICES,         // flush matrices pending changes
+	COMPACTION_DONE
+} CompactionStage;
+
+// state of an incremental memory compaction
+typedef struct {
+	CompactionStage stage;  // current stage
+	uint64_t pos;           // position within current stage
+	size_t reclaimed;       // number of bytes reclaimed
+	uint64_t repacked;      // number of attribute sets repacked
+} GraphCompaction;
+
+// perform a single, bounded, step of memory compaction
+// caller must hold the graph's WRITE lock
+// entity IDs are not modified
+// returns false once compaction is done
+bool Graph_CompactStep
+(
+	Graph *g,              // graph to compact
+	GraphCompaction *ctx   // compaction state, zero initialized on first call
 );
 
 // all graph matrices are required to be squared NXN
@@ -408,6 +485,17 @@ RG_Matrix Graph_GetRelationMatrix
 	bool transposed
 );
 
+// retrieves a CSR snapshot of relation 'r' in direction 'dir'
+// GRAPH_NO_RELATION yields a snapshot of all relation types
+// the snapshot is built on first use and shared until the graph is modified
+// caller must hold the graph's READ lock and release the snapshot via CSR_Free
+CSR *Graph_GetCSR
+(
+	const Graph *g,     // graph
+	RelationID r,       // relation type
+	GRAPH_EDGE_DIR dir  // either incoming or outgoing
+);
+
 // retrieves the node-label mapping matrix,
 // matrix is resized if its size doesn't match graph's node count.
 RG_Matrix Graph_GetNodeLabelMatrix
@@ -0,0 +1,157 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "graph.h"
+
+#include <sys/param.h>
+
+// memory compaction
+//
+// compaction is performed in small steps, each step is executed while holding
+// the graph's write lock, in between steps the lock is released allowing
+// queries to make progress
+//
+// compaction is performed in stages
+// 1. blocks
+//    node and edge blocks in which all items are deleted are released
+//    entity IDs and the list of free IDs are left as is, a released block
+//    is re-created once one of its IDs is reused
+//
+// 2. node and edge attributes
+//    the attribute sets of a single block are moved into fresh allocations
+//    giving the allocator a chance to pack long lived sets together
+//    only blocks in which entities were deleted since the last compaction
+//    are repacked
+//
+// 3. matrices
+//    pending changes of a single matrix are flushed into its primary matrix
+//    releasing the delta matrices, synced matrices are skipped
+
+// repack attribute sets of the next block holding new deletions
+// returns false once all blocks were visited
+static bool _CompactAttributes
+(
+	DataBlock *entities,  // entities datablock
+	GraphCompaction *ctx  // compaction state
+) {
+	// number of allocated IDs, including deleted ones
+	uint64_t n = DataBlock_ItemCount(entities) +
+		DataBlock_DeletedItemsCount(entities);
+
+	// skip blocks without new deletions
+	uint64_t start = ctx->pos * entities->blockCap;
+	for(; start < n; start += entities->blockCap) {
+		if(DataBlock_CleanBlock(entities, ctx->pos)) break;
+		ctx->pos++;
+	}
+	if(start >= n) return false;
+
+	uint64_t end = MIN(start + entities->blockCap, n);
+	for(uint64_t id = start; id < end; id++) {
+		AttributeSet *set = DataBlock_GetItem(entities, id);
+		if(set == NULL) continue;  // deleted
+
+		if(AttributeSet_Repack(set) > 0) ctx->repacked++;
+	}
+
+	ctx->pos++;
+	return true;
+}
+
+// returns the matrix at position 'pos'
+// matrices are ordered: adjacency, node labels, labels, relations
+// NULL is returned once all matrices were visited
+static RG_Matrix _CompactionMatrix
+(
+	const Graph *g,  // graph
+	uint64_t pos     // matrix position
+) {
+	if(pos == 0) return g->adjacency_matrix;
+	if(pos == 1) return g->node_labels;
+	pos -= 2;
+
+	uint64_t n = Graph_LabelTypeCount(g);
+	if(pos < n) return g->labels[pos];
+	pos -= n;
+
+	n = Graph_RelationTypeCount(g);
+	if(pos < n) return g->relations[pos];
+
+	return NULL;
+}
+
+bool Graph_CompactStep
+(
+	Graph *g,              // graph to compact
+	GraphCompaction *ctx   // compaction state, zero initialized on first call
+) {
+	ASSERT(g   != NULL);
+	ASSERT(ctx != NULL);
+
+	switch(ctx->stage) {
+		case COMPACTION_BLOCKS:
+			ctx->reclaimed += DataBlock_ReleaseDeletedBlocks(g->nodes);
+			ctx->reclaimed += DataBlock_ReleaseDeletedBlocks(g->edges);
+			ctx->stage = COMPACTION_NODE_ATTRIBUTES;
+			break;
+
+		case COMPACTION_NODE_ATTRIBUTES:
+			if(!_CompactAttributes(g->nodes, ctx)) {
+				ctx->pos   = 0;
+				ctx->stage = COMPACTION_EDGE_ATTRIBUTES;
+			}
+			break;
+
+		case COMPACTION_EDGE_ATTRIBUTES:
+			if(!_CompactAttributes(g->edges, ctx)) {
+				ctx->pos   = 0;
+				ctx->stage = COMPACTION_MATRICES;
+			}
+			break;
+
+		case COMPACTION_MATRICES: {
+			RG_Matrix m = _CompactionMatrix(g, ctx->pos);
+			if(m == NULL) {
+				ctx->stage = COMPACTION_DONE;
+				break;
+			}
+
+			// no pending changes
+			if(RG_Matrix_Synced(m)) {
+				ctx->pos++;
+				break;
+			}
+
+			size_t before;
+			size_t after;
+			GrB_Info info;
+			UNUSED(info);
+
+			info = RG_Matrix_memoryUsage(&before, m);
+			ASSERT(info == GrB_SUCCESS);
+
+			info = RG_Matrix_wait(m, true);
+			ASSERT(info == GrB_SUCCESS);
+
+			info = RG_Matrix_memoryUsage(&after, m);
+			ASSERT(info == GrB_SUCCESS);
+
+			if(after < before) ctx->reclaimed += before - after;
+			ctx->pos++;
+			break;
+		}
+
+		case COMPACTION_DONE:
+			break;
+
+		default:
+			ASSERT(false);
+			break;
+	}
+
+	return ctx->stage != COMPACTION_DONE;
+}
@@ -102,6 +102,7 @@ void CreateNode
 	ASSERT(gc != NULL);
 
 	Graph_CreateNode(gc->g, n, labels, label_count);
+	GraphContext_InternAttributes(gc, set);
 	*n->attributes = set;
 
 	// add node labels
@@ -134,6 +135,7 @@ void CreateEdge
 	ASSERT(gc != NULL);
 
 	Graph_CreateEdge(gc->g, src, dst, r, e);
+	GraphContext_InternAttributes(gc, set);
 	*e->attributes = set;
 
 	Schema *s = GraphContext_GetSchemaByID(gc, r, SCHEMA_EDGE);
@@ -150,6 +152,125 @@ void CreateEdge
 	}
 }
 
+// create multiple nodes
+// nodes are introduced to the graph and indexed in bulk
+void CreateNodes
+(
+	GraphContext *gc,
+	Node **nodes,
+	LabelID **labels,
+	uint *label_counts,
+	AttributeSet *sets,
+	uint n,
+	bool log
+) {
+	ASSERT(gc != NULL);
+	ASSERT(nodes != NULL || n == 0);
+
+	if(n == 0) return;
+
+	Graph_CreateNodes(gc->g, nodes, labels, label_counts, n);
+
+	// set attributes, group nodes by label for indexing
+	uint label_type_count = Graph_LabelTypeCount(gc->g);
+	const Node ***grouped = rm_calloc(label_type_count, sizeof(const Node **));
+
+	for(uint i = 0; i < n; i++) {
+		GraphContext_InternAttributes(gc, sets[i]);
+		*nodes[i]->attributes = sets[i];
+
+		for(uint j = 0; j < label_counts[i]; j++) {
+			LabelID l = labels[i][j];
+			Schema *s = GraphContext_GetSchemaByID(gc, l, SCHEMA_NODE);
+			ASSERT(s != NULL);
+			if(!Schema_HasIndices(s)) continue;
+
+			if(grouped[l] == NULL) grouped[l] = array_new(const Node *, 1);
+			array_append(grouped[l], nodes[i]);
+		}
+	}
+
+	for(LabelID l = 0; l < label_type_count; l++) {
+		if(grouped[l] == NULL) continue;
+
+		Schema *s = GraphContext_GetSchemaByID(gc, l, SCHEMA_NODE);
+		Schema_AddNodesToIndices(s, grouped[l], array_len(grouped[l]));
+		array_free(grouped[l]);
+	}
+	rm_free(grouped);
+
+	// add node creation operations to undo log
+	if(log == true) {
+		UndoLog undo_log = QueryCtx_GetUndoLog();
+		UndoLog_CreateNodes(undo_log, nodes, n);
+
+		// effects are recorded per node
+		EffectsBuffer *eb = QueryCtx_GetEffectsBuffer();
+		for(uint i = 0; i < n; i++) {
+			EffectsBuffer_AddCreateNodeEffect(eb, nodes[i], labels[i],
+					label_counts[i]);
+		}
+	}
+}
+
+// create multiple edges
+// edges are introduced to the graph and indexed in bulk
+void CreateEdges
+(
+	GraphContext *gc,
+	Edge **edges,
+	AttributeSet *sets,
+	uint n,
+	bool log
+) {
+	ASSERT(gc != NULL);
+	ASSERT(edges != NULL || n == 0);
+
+	if(n == 0) return;
+
+	Graph_CreateEdges(gc->g, edges, n);
+
+	// set attributes, group edges by relation for indexing
+	uint relation_count = Graph_RelationTypeCount(gc->g);
+	const Edge ***grouped = rm_calloc(relation_count, sizeof(const Edge **));
+
+	for(uint i = 0; i < n; i++) {
+		Edge *e = edges[i];
+		GraphContext_InternAttributes(gc, sets[i]);
+		*e->attributes = sets[i];
+
+		RelationID r = Edge_GetRelationID(e);
+		Schema *s = GraphContext_GetSchemaByID(gc, r, SCHEMA_EDGE);
+		// all schemas have been created in the edge blueprint loop or earlier
+		ASSERT(s != NULL);
+		if(!Schema_HasIndices(s)) continue;
+
+		if(grouped[r] == NULL) grouped[r] = array_new(const Edge *, 1);
+		array_append(grouped[r], e);
+	}
+
+	for(RelationID r = 0; r < relation_count; r++) {
+		if(grouped[r] == NULL) continue;
+
+		Schema *s = GraphContext_GetSchemaByID(gc, r, SCHEMA_EDGE);
+		Schema_AddEdgesToIndices(s, grouped[r], array_len(grouped[r]));
+		array_free(grouped[r]);
+	}
+	rm_free(grouped);
+
+	// add edge creation operations to undo log
+	if(log == true) {
+		UndoLog undo_log = QueryCtx_GetUndoLog();
+		UndoLog_CreateEdges(undo_log, edges, n);
+
+		// effects are recorded per edge
+		EffectsBuffer *eb = QueryCtx_GetEffectsBuffer();
+		for(uint i = 0; i < n; i++) {
+			EffectsBuffer_AddCreateEdgeEffect(eb, edges[i]);
+		}
+	}
+}
+
 // delete a node
 // remove the node from the relevant indexes
 // add node deletion operation to undo-log
@@ -238,6 +359,7 @@ void UpdateEntityProperties
 		UndoLog_UpdateEntity(log, ge, old_set, entity_type);
 	}
 
+	GraphContext_InternAttributes(gc, set);
 	*ge->attributes = set;
 
 	if(entity_type == GETYPE_NODE) {
@@ -261,6 +383,8 @@ void UpdateNodeProperty
 	UNUSED(res);
 	ASSERT(res == true);
 
+	GraphContext_InternValue(gc, &v);
+
 	if(attr_id == ATTRIBUTE_ID_ALL) {
 		AttributeSet_Free(n.attributes);
 	} else if(GraphEntity_GetProperty((GraphEntity *)&n, attr_id) == ATTRIBUTE_NOTFOUND) {
@@ -306,6 +430,8 @@ void UpdateEdgeProperty
 	Edge_SetDestNodeID(&e, dest_id);
 	Edge_SetRelationID(&e, r_id);
 
+	GraphContext_InternValue(gc, &v);
+
 	if(attr_id == ATTRIBUTE_ID_ALL) {
 		AttributeSet_Free(e.attributes);
 	} else if(GraphEntity_GetProperty((GraphEntity *)&e, attr_id) == ATTRIBUTE_NOTFOUND) {
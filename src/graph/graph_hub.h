@@ -40,6 +40,31 @@ void CreateEdge
 	bool log           // log operation in undo-log
 );
 
+// create multiple nodes
+// same as CreateNode, matrices and indexes are updated in bulk
+void CreateNodes
+(
+	GraphContext *gc,    // graph context to create the nodes
+	Node **nodes,        // nodes to create
+	LabelID **labels,    // labels of each node
+	uint *label_counts,  // number of labels of each node
+	AttributeSet *sets,  // attributes of each node
+	uint n,              // number of nodes
+	bool log             // log operations in undo-log
+);
+
+// create multiple edges
+// each edge's source, destination and relation type must be set
+// same as CreateEdge, matrices and indexes are updated in bulk
+void CreateEdges
+(
+	GraphContext *gc,    // graph context to create the edges
+	Edge **edges,        // edges to create
+	AttributeSet *sets,  // attributes of each edge
+	uint n,              // number of edges
+	bool log             // log operations in undo-log
+);
+
 // delete nodes
 // remove nodes from the relevant indexes
 // add node deletion operations to undo-log
@@ -12,8 +12,11 @@
 #include "../query_ctx.h"
 #include "../redismodule.h"
 #include "../util/rmalloc.h"
+#include "../util/string_pool.h"
 #include "../util/thpool/pools.h"
 #include "../constraint/constraint.h"
+#include "../statistics/statistics.h"
+#include "../aggregate_cache/aggregate_cache.h"
 #include "../serializers/graphcontext_type.h"
 #include "../commands/execution_ctx.h"
 
@@ -125,6 +128,32 @@ GraphContext *GraphContext_New
 	int rc1 = pthread_rwlock_init(&gc->_attribute_rwlock, NULL);
 	assert(rc1 == 0);
 
+	// statistics are collected in the background
+	gc->stats         = NULL;
+	gc->stats_refresh = false;
+	rc1 = pthread_mutex_init(&gc->stats_lock, NULL);
+	assert(rc1 == 0);
+
+	// write queries are queued per graph
+	gc->pending_writes   = array_new(void *, 0);
+	gc->writes_scheduled = false;
+	rc1 = pthread_mutex_init(&gc->writes_lock, NULL);
+	assert(rc1 == 0);
+
+	// attribute summaries are built on demand
+	gc->aggregates = AggregateCache_New();
+
+	// string attributes are interned on demand
+	gc->strings = StringPool_New();
+
+	// memory is compacted in the background
+	gc->compacting        = false;
+	gc->compaction        = (GraphCompaction){0};
+	gc->compacted_deleted = 0;
+	gc->compaction_runs   = 0;
+	gc->reclaimed_bytes   = 0;
+	gc->repacked_sets     = 0;
+
 	// build the execution plans cache
 	uint64_t cache_size;
 	Config_Option_get(Config_CACHE_SIZE, &cache_size);
@@ -245,6 +274,157 @@ void GraphContext_UnlockCommit
 	RedisModule_ThreadSafeContextUnlock(ctx);
 }
 
+bool GraphContext_EnqueueWrite
+(
+	GraphContext *gc,
+	void *write
+) {
+	ASSERT(gc    != NULL);
+	ASSERT(write != NULL);
+
+	pthread_mutex_lock(&gc->writes_lock);
+
+	array_append(gc->pending_writes, write);
+
+	// schedule a writer if there isn't one already
+	bool schedule = !gc->writes_scheduled;
+	gc->writes_scheduled = true;
+
+	pthread_mutex_unlock(&gc->writes_lock);
+
+	return schedule;
+}
+
+uint GraphContext_DequeueWrites
+(
+	GraphContext *gc,
+	void **writes,
+	uint n
+) {
+	ASSERT(n      > 0);
+	ASSERT(gc     != NULL);
+	ASSERT(writes != NULL);
+
+	pthread_mutex_lock(&gc->writes_lock);
+
+	ASSERT(gc->writes_scheduled);
+
+	uint count = MIN(n, array_len(gc->pending_writes));
+	if(count > 0) {
+		uint remaining = array_len(gc->pending_writes) - count;
+		memcpy(writes, gc->pending_writes, sizeof(void *) * count);
+		memmove(gc->pending_writes, gc->pending_writes + count,
+				sizeof(void *) * remaining);
+		array_trimm_len(gc->pending_writes, remaining);
+	} else {
+		// queue is drained, the next write will schedule a new writer
+		gc->writes_scheduled = false;
+	}
+
+	pthread_mutex_unlock(&gc->writes_lock);
+
+	return count;
+}
+
+// intern string value 'v' into pool
+static inline void _GraphContext_InternValue
+(
+	StringPool *pool,  // string pool
+	SIValue *v         // value to intern
+) {
+	if(SI_TYPE(*v) != T_STRING || v->allocation != M_SELF) return;
+
+	// skip long strings
+	if(strnlen(v->stringval, STRING_POOL_MAX_LEN + 1) > STRING_POOL_MAX_LEN) {
+		return;
+	}
+
+	char *s = StringPool_Intern(pool, v->stringval);
+	SIValue_Free(*v);
+	*v = SI_InternedStringVal(s);
+}
+
+void GraphContext_InternValue
+(
+	GraphContext *gc,
+	SIValue *v
+) {
+	ASSERT(v  != NULL);
+	ASSERT(gc != NULL);
+
+	bool intern;
+	Config_Option_get(Config_INTERN_STRINGS, &intern);
+	if(!intern) return;
+
+	_GraphContext_InternValue(gc->strings, v);
+}
+
+void GraphContext_InternAttributes
+(
+	GraphContext *gc,
+	AttributeSet set
+) {
+	ASSERT(gc != NULL);
+
+	if(set == NULL || ATTRIBUTE_SET_IS_READONLY(set)) return;
+
+	bool intern;
+	Config_Option_get(Config_INTERN_STRINGS, &intern);
+	if(!intern) return;
+
+	for(ushort i = 0; i < set->attr_count; i++) {
+		_GraphContext_InternValue(gc->strings, &set->attributes[i].value);
+	}
+}
+
+bool GraphContext_TryPauseWrites
+(
+	GraphContext *gc
+) {
+	ASSERT(gc != NULL);
+
+	pthread_mutex_lock(&gc->writes_lock);
+
+	bool paused = !gc->writes_scheduled;
+	gc->writes_scheduled = true;
+
+	pthread_mutex_unlock(&gc->writes_lock);
+
+	return paused;
+}
+
+bool GraphContext_ResumeWrites
+(
+	GraphContext *gc
+) {
+	ASSERT(gc != NULL);
+
+	pthread_mutex_lock(&gc->writes_lock);
+
+	ASSERT(gc->writes_scheduled);
+
+	// hand the slot over to a writer if writes were queued
+	bool schedule = array_len(gc->pending_writes) > 0;
+	gc->writes_scheduled = schedule;
+
+	pthread_mutex_unlock(&gc->writes_lock);
+
+	return schedule;
+}
+
+bool GraphContext_WritesPending
+(
+	GraphContext *gc
+) {
+	ASSERT(gc != NULL);
+
+	pthread_mutex_lock(&gc->writes_lock);
+	bool pending = array_len(gc->pending_writes) > 0;
+	pthread_mutex_unlock(&gc->writes_lock);
+
+	return pending;
+}
+
 const char *GraphContext_GetName
 (
 	const GraphContext *gc
@@ -289,6 +469,68 @@ XXH32_hash_t GraphContext_GetVersion(const GraphContext *gc) {
 	return gc->version;
 }
 
+// hash schema name and the attributes of its exact-match index
+static void _SchemaFingerprint
+(
+	XXH64_state_t *state,
+	const Schema *s
+) {
+	const char *name = Schema_GetName(s);
+	XXH64_update(state, name, strlen(name) + 1);
+
+	Index idx = ACTIVE_EXACTMATCH_IDX(s);
+	uint n = (idx != NULL) ? Index_FieldsCount(idx) : 0;
+	XXH64_update(state, &n, sizeof(n));
+
+	if(n > 0) {
+		const IndexField *fields = Index_GetFields(idx);
+		for(uint i = 0; i < n; i++) {
+			XXH64_update(state, &fields[i].id, sizeof(Attribute_ID));
+		}
+	}
+}
+
+// compute a fingerprint of the graph's schema layout
+uint64_t GraphContext_SchemaFingerprint
+(
+	GraphContext *gc
+) {
+	ASSERT(gc != NULL);
+
+	XXH64_state_t *state = XXH64_createState();
+	XXH64_reset(state, 0);
+
+	// schemas are hashed in ID order, each schema kind is prefixed by its
+	// count such that a label and a relationship-type sharing a name differ
+	uint n = array_len(gc->node_schemas);
+	XXH64_update(state, &n, sizeof(n));
+	for(uint i = 0; i < n; i++) {
+		_SchemaFingerprint(state, gc->node_schemas[i]);
+	}
+
+	n = array_len(gc->relation_schemas);
+	XXH64_update(state, &n, sizeof(n));
+	for(uint i = 0; i < n; i++) {
+		_SchemaFingerprint(state, gc->relation_schemas[i]);
+	}
+
+	pthread_rwlock_rdlock(&gc->_attribute_rwlock);
+
+	n = array_len(gc->string_mapping);
+	XXH64_update(state, &n, sizeof(n));
+	for(uint i = 0; i < n; i++) {
+		const char *attr = gc->string_mapping[i];
+		XXH64_update(state, attr, strlen(attr) + 1);
+	}
+
+	pthread_rwlock_unlock(&gc->_attribute_rwlock);
+
+	uint64_t fingerprint = XXH64_digest(state);
+	XXH64_freeState(state);
+
+	return fingerprint;
+}
+
 // get graph from graph context
 Graph *GraphContext_GetGraph
 (
@@ -299,6 +541,39 @@ Graph *GraphContext_GetGraph
 	return gc->g;
 }
 
+// get a reference to graph's statistics
+Statistics *GraphContext_GetStatistics
+(
+	GraphContext *gc
+) {
+	ASSERT(gc != NULL);
+
+	Statistics *s = NULL;
+
+	pthread_mutex_lock(&gc->stats_lock);
+	if(gc->stats != NULL) s = Statistics_Share(gc->stats);
+	pthread_mutex_unlock(&gc->stats_lock);
+
+	return s;
+}
+
+// replace graph's statistics
+void GraphContext_SetStatistics
+(
+	GraphContext *gc,
+	Statistics *s
+) {
+	ASSERT(gc != NULL);
+
+	pthread_mutex_lock(&gc->stats_lock);
+	Statistics *prev = gc->stats;
+	gc->stats = s;
+	pthread_mutex_unlock(&gc->stats_lock);
+
+	// previous statistics are freed once their last reader is done
+	if(prev != NULL) Statistics_Free(prev);
+}
+
 // Update graph context version
 static void _GraphContext_UpdateVersion(GraphContext *gc, const char *str) {
 	ASSERT(gc != NULL);
@@ -960,6 +1235,38 @@ static void _GraphContext_Free(void *arg) {
 
 	if(gc->slowlog) SlowLog_Free(gc->slowlog);
 
+	//--------------------------------------------------------------------------
+	// free statistics
+	//--------------------------------------------------------------------------
+
+	if(gc->stats) Statistics_Free(gc->stats);
+	res = pthread_mutex_destroy(&gc->stats_lock);
+	ASSERT(res == 0);
+
+	//--------------------------------------------------------------------------
+	// free pending writes queue
+	//--------------------------------------------------------------------------
+
+	// queued writes hold a reference to the graph context
+	ASSERT(array_len(gc->pending_writes) == 0);
+	array_free(gc->pending_writes);
+	res = pthread_mutex_destroy(&gc->writes_lock);
+	ASSERT(res == 0);
+
+	//--------------------------------------------------------------------------
+	// free aggregate cache
+	//--------------------------------------------------------------------------
+
+	AggregateCache_Free(gc->aggregates);
+
+	//--------------------------------------------------------------------------
+	// free string pool
+	//--------------------------------------------------------------------------
+
+	// interned strings are referenced by the graph's attributes
+	// pool is freed once the graph is
+	StringPool_Free(gc->strings);
+
 	//--------------------------------------------------------------------------
 	// clear cache
 	//--------------------------------------------------------------------------
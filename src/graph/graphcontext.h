@@ -16,6 +16,15 @@
 #include "../serializers/encode_context.h"
 #include "../serializers/decode_context.h"
 
+// optimizer statistics, see statistics/statistics.h
+typedef struct Statistics Statistics;
+
+// cached label wide attribute aggregates, see aggregate_cache/aggregate_cache.h
+typedef struct AggregateCache AggregateCache;
+
+// interned strings, see util/string_pool.h
+typedef struct StringPool StringPool;
+
 // GraphContext holds refrences to various elements of a graph object
 // It is the value sitting behind a Redis graph key
 //
@@ -43,6 +52,20 @@ typedef struct {
 	Cache *cache;                          // global cache of execution plans
 	XXH32_hash_t version;                  // graph version
 	RedisModuleString *telemetry_stream;   // telemetry stream name
+	Statistics *stats;                     // data distribution statistics
+	pthread_mutex_t stats_lock;            // protects access to stats
+	bool stats_refresh;                    // statistics refresh in progress
+	void **pending_writes;                 // write queries waiting for a writer
+	pthread_mutex_t writes_lock;           // protects pending_writes
+	bool writes_scheduled;                 // a writer is draining pending_writes
+	AggregateCache *aggregates;            // cached label wide attribute aggregates
+	StringPool *strings;                   // interned string attributes
+	bool compacting;                       // memory compaction in progress
+	GraphCompaction compaction;            // state of interrupted compaction
+	uint64_t compacted_deleted;            // deleted entities at last compaction
+	uint64_t compaction_runs;              // number of completed compactions
+	uint64_t reclaimed_bytes;              // bytes reclaimed by compaction
+	uint64_t repacked_sets;                // attribute sets repacked by compaction
 } GraphContext;
 
 //------------------------------------------------------------------------------
@@ -96,6 +119,64 @@ void GraphContext_UnlockCommit
 	GraphContext *gc
 );
 
+// queue a write query for execution
+// writes to the same graph are executed one after the other, in order
+// returns true if no writer is draining the graph's queue, in which case
+// the caller is responsible for scheduling one
+bool GraphContext_EnqueueWrite
+(
+	GraphContext *gc,  // graph context
+	void *write        // write query to queue
+);
+
+// dequeue up to 'n' queued write queries, in order of arrival
+// once the queue is empty the graph's writer is considered done
+// and 0 is returned
+uint GraphContext_DequeueWrites
+(
+	GraphContext *gc,  // graph context
+	void **writes,     // [output] dequeued write queries
+	uint n             // max number of writes to dequeue
+);
+
+// take the graph's writer slot without a write query
+// returns false if a writer is already scheduled
+// while held, queued writes wait until GraphContext_ResumeWrites is called
+bool GraphContext_TryPauseWrites
+(
+	GraphContext *gc  // graph context
+);
+
+// release the writer slot taken by GraphContext_TryPauseWrites
+// returns true if writes were queued in the meantime, in which case the slot
+// is kept and the caller is responsible for scheduling a writer
+bool GraphContext_ResumeWrites
+(
+	GraphContext *gc  // graph context
+);
+
+// returns true if write queries are waiting for a writer
+bool GraphContext_WritesPending
+(
+	GraphContext *gc  // graph context
+);
+
+// intern string value 'v' into the graph's string pool
+// 'v' must own its string, no-op if string interning is disabled
+void GraphContext_InternValue
+(
+	GraphContext *gc,  // graph context
+	SIValue *v         // value to intern
+);
+
+// intern the string attributes of 'set' into the graph's string pool
+// no-op if string interning is disabled
+void GraphContext_InternAttributes
+(
+	GraphContext *gc,  // graph context
+	AttributeSet set   // attribute set
+);
+
 // get graph name out of graph context
 const char *GraphContext_GetName
 (
@@ -122,12 +203,37 @@ XXH32_hash_t GraphContext_GetVersion
 	const GraphContext *gc
 );
 
+// compute a fingerprint of the graph's schema layout
+// graphs sharing a fingerprint assign the same IDs to the same
+// labels, relationship-types and attributes
+// and have the same exact-match indices
+uint64_t GraphContext_SchemaFingerprint
+(
+	GraphContext *gc
+);
+
 // get graph from graph context
 Graph *GraphContext_GetGraph
 (
 	const GraphContext *gc
 );
 
+// get a reference to graph's statistics
+// returns NULL if statistics were not collected
+// caller should release the returned reference via Statistics_Free
+Statistics *GraphContext_GetStatistics
+(
+	GraphContext *gc
+);
+
+// replace graph's statistics
+// the graph context takes ownership over 's'
+void GraphContext_SetStatistics
+(
+	GraphContext *gc,
+	Statistics *s
+);
+
 //------------------------------------------------------------------------------
 // Schema API
 //------------------------------------------------------------------------------
@@ -561,6 +561,8 @@ QueryGraph *QueryGraph_Clone
 		QueryGraph_ConnectNodes(clone, src, dest, clone_edge);
 	}
 
+	clone->unknown_reltype_ids = qg->unknown_reltype_ids;
+
 	return clone;
 }
 
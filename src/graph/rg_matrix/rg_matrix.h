@@ -212,6 +212,26 @@ GrB_Info RG_Matrix_setElement_UINT64      // C (i,j) = x
 	GrB_Index j                         // column index
 );
 
+// bulk version of RG_Matrix_setElement_BOOL
+GrB_Info RG_Matrix_setElements_BOOL     // C (I[k],J[k]) = true
+(
+	RG_Matrix C,                        // matrix to modify
+	const GrB_Index *I,                 // row indices
+	const GrB_Index *J,                 // column indices
+	GrB_Index n                         // number of tuples
+);
+
+// bulk version of RG_Matrix_setElement_UINT64
+// tuples sharing the same position form a multi-edge entry
+GrB_Info RG_Matrix_setElements_UINT64   // C (I[k],J[k]) = X[k]
+(
+	RG_Matrix C,                        // matrix to modify
+	const uint64_t *X,                  // values
+	const GrB_Index *I,                 // row indices
+	const GrB_Index *J,                 // column indices
+	GrB_Index n                         // number of tuples
+);
+
 GrB_Info RG_Matrix_extractElement_BOOL     // x = A(i,j)
 (
 	bool *x,                               // extracted scalar
@@ -300,6 +320,13 @@ GrB_Info RG_Matrix_wait
 	bool force_sync
 );
 
+// number of bytes used by matrix, including its deltas and transpose
+GrB_Info RG_Matrix_memoryUsage
+(
+	size_t *size,       // [output] matrix memory usage
+	const RG_Matrix C   // matrix to query
+);
+
 // get the type of the M matrix
 GrB_Info RG_Matrix_type
 (
@@ -0,0 +1,45 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "rg_matrix.h"
+
+GrB_Info RG_Matrix_memoryUsage
+(
+	size_t *size,       // [output] matrix memory usage
+	const RG_Matrix C   // matrix to query
+) {
+	ASSERT(C    != NULL);
+	ASSERT(size != NULL);
+
+	GrB_Info    info;
+	size_t      n      =  0;
+	size_t      total  =  0;
+	GrB_Matrix  M      =  RG_MATRIX_M(C);
+	GrB_Matrix  DP     =  RG_MATRIX_DELTA_PLUS(C);
+	GrB_Matrix  DM     =  RG_MATRIX_DELTA_MINUS(C);
+
+	if(RG_MATRIX_MAINTAIN_TRANSPOSE(C)) {
+		info = RG_Matrix_memoryUsage(&n, C->transposed);
+		ASSERT(info == GrB_SUCCESS);
+		total += n;
+	}
+
+	info = GxB_Matrix_memoryUsage(&n, M);
+	ASSERT(info == GrB_SUCCESS);
+	total += n;
+
+	info = GxB_Matrix_memoryUsage(&n, DP);
+	ASSERT(info == GrB_SUCCESS);
+	total += n;
+
+	info = GxB_Matrix_memoryUsage(&n, DM);
+	ASSERT(info == GrB_SUCCESS);
+	total += n;
+
+	*size = total;
+	return info;
+}
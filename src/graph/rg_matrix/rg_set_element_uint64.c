@@ -9,7 +9,10 @@
 #include "rg_matrix.h"
 #include "../../util/arr.h"
 
+#include <pthread.h>
+
 static GrB_BinaryOp _graph_edge_accum = NULL;
+static pthread_once_t _graph_edge_accum_once = PTHREAD_ONCE_INIT;
 
 void _edge_accum(void *_z, const void *_x, const void *_y) {
 	uint64_t *ids;
@@ -32,6 +35,13 @@ void _edge_accum(void *_z, const void *_x, const void *_y) {
 	*z = (uint64_t)SET_MSB(ids);
 }
 
+static void _edge_accum_init(void) {
+	GrB_Info info = GrB_BinaryOp_new(&_graph_edge_accum, _edge_accum,
+			GrB_UINT64, GrB_UINT64, GrB_UINT64);
+	UNUSED(info);
+	ASSERT(info == GrB_SUCCESS);
+}
+
 // dealing with multi-value entries
 static GrB_Info setMultiEdgeEntry
 (
@@ -43,12 +53,8 @@ static GrB_Info setMultiEdgeEntry
 	GrB_Info info;
 
 	// create edge accumulator binary function
-	// TODO: remove if condition, initialize binary operation at module load
-	if(!_graph_edge_accum) {
-		info = GrB_BinaryOp_new(&_graph_edge_accum, _edge_accum, GrB_UINT64, 
-								GrB_UINT64, GrB_UINT64);
-		ASSERT(info == GrB_SUCCESS);
-	}
+	// writers to different graphs may get here concurrently
+	pthread_once(&_graph_edge_accum_once, _edge_accum_init);
 
 	info = GxB_Matrix_subassign_UINT64(A, NULL, _graph_edge_accum, 
 									   x, &i, 1, &j, 1, NULL);
@@ -0,0 +1,267 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "rg_utils.h"
+#include "rg_matrix.h"
+#include "../../util/arr.h"
+
+#include <pthread.h>
+
+// bulk version of RG_Matrix_setElement
+// tuples are assembled into a temporary matrix T which is then applied
+// to M, delta-plus and delta-minus using whole matrix operations
+// when C is empty, tuples are built directly into M
+
+static GrB_BinaryOp _graph_edge_merge = NULL;
+static pthread_once_t _graph_edge_merge_once = PTHREAD_ONCE_INIT;
+
+// merge edge entries x and y, each is either a single edge ID
+// or a multi-edge array, y's array is consumed
+static void _edge_merge(void *_z, const void *_x, const void *_y) {
+	uint64_t *ids;
+	uint64_t       *z  =  (uint64_t *)        _z;
+	const uint64_t *x  =  (const uint64_t *)  _x;
+	const uint64_t *y  =  (const uint64_t *)  _y;
+
+	if(SINGLE_EDGE(*x)) {
+		ids = array_new(uint64_t, 2);
+		array_append(ids, *x);
+	} else {
+		ids = (uint64_t *)(CLEAR_MSB(*x));
+	}
+
+	if(SINGLE_EDGE(*y)) {
+		array_append(ids, *y);
+	} else {
+		uint64_t *y_ids = (uint64_t *)(CLEAR_MSB(*y));
+		uint n = array_len(y_ids);
+		for(uint i = 0; i < n; i++) array_append(ids, y_ids[i]);
+		array_free(y_ids);
+	}
+
+	*z = (uint64_t)SET_MSB(ids);
+}
+
+static void _edge_merge_init(void) {
+	GrB_Info info = GrB_BinaryOp_new(&_graph_edge_merge, _edge_merge,
+			GrB_UINT64, GrB_UINT64, GrB_UINT64);
+	UNUSED(info);
+	ASSERT(info == GrB_SUCCESS);
+}
+
+static bool _RG_Matrix_empty
+(
+	const RG_Matrix C
+) {
+	GrB_Index m_nvals;
+	GrB_Index dp_nvals;
+	GrB_Index dm_nvals;
+
+	GrB_Matrix_nvals(&m_nvals,  RG_MATRIX_M(C));
+	GrB_Matrix_nvals(&dp_nvals, RG_MATRIX_DELTA_PLUS(C));
+	GrB_Matrix_nvals(&dm_nvals, RG_MATRIX_DELTA_MINUS(C));
+
+	return (m_nvals + dp_nvals + dm_nvals) == 0;
+}
+
+GrB_Info RG_Matrix_setElements_BOOL     // C (I[k],J[k]) = true
+(
+	RG_Matrix C,                        // matrix to modify
+	const GrB_Index *I,                 // row indices
+	const GrB_Index *J,                 // column indices
+	GrB_Index n                         // number of tuples
+) {
+	ASSERT(C != NULL);
+	ASSERT(!RG_MATRIX_MULTI_EDGE(C));
+
+	if(n == 0) return GrB_SUCCESS;
+
+	GrB_Info   info;
+	GrB_Index  nrows;
+	GrB_Index  ncols;
+	GrB_Index  dm_nvals;
+	GrB_Scalar s;
+	GrB_Matrix T;
+
+	GrB_Matrix m  = RG_MATRIX_M(C);
+	GrB_Matrix dp = RG_MATRIX_DELTA_PLUS(C);
+	GrB_Matrix dm = RG_MATRIX_DELTA_MINUS(C);
+
+	if(RG_MATRIX_MAINTAIN_TRANSPOSE(C)) {
+		info = RG_Matrix_setElements_BOOL(C->transposed, J, I, n);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	info = GrB_Scalar_new(&s, GrB_BOOL);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Scalar_setElement_BOOL(s, true);
+	ASSERT(info == GrB_SUCCESS);
+
+	// C is empty, build M
+	if(_RG_Matrix_empty(C)) {
+		info = GxB_Matrix_build_Scalar(m, I, J, s, n);
+		ASSERT(info == GrB_SUCCESS);
+		RG_Matrix_setDirty(C);
+		GrB_Scalar_free(&s);
+		return info;
+	}
+
+	info = GrB_Matrix_nrows(&nrows, m);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Matrix_ncols(&ncols, m);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Matrix_new(&T, GrB_BOOL, nrows, ncols);
+	ASSERT(info == GrB_SUCCESS);
+	info = GxB_Matrix_build_Scalar(T, I, J, s, n);
+	ASSERT(info == GrB_SUCCESS);
+
+	// entries marked for deletion are restored: DM<!T> = DM
+	info = GrB_Matrix_nvals(&dm_nvals, dm);
+	ASSERT(info == GrB_SUCCESS);
+	if(dm_nvals > 0) {
+		info = GrB_Matrix_apply(dm, T, NULL, GrB_IDENTITY_BOOL, dm, GrB_DESC_RSC);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	// entries missing from M are added to delta-plus: DP<!M> = DP | T
+	info = GrB_Matrix_eWiseAdd_BinaryOp(dp, m, NULL, GrB_LOR, dp, T,
+			GrB_DESC_SC);
+	ASSERT(info == GrB_SUCCESS);
+
+	RG_Matrix_setDirty(C);
+
+	GrB_Matrix_free(&T);
+	GrB_Scalar_free(&s);
+
+	return info;
+}
+
+GrB_Info RG_Matrix_setElements_UINT64   // C (I[k],J[k]) = X[k]
+(
+	RG_Matrix C,                        // matrix to modify
+	const uint64_t *X,                  // values
+	const GrB_Index *I,                 // row indices
+	const GrB_Index *J,                 // column indices
+	GrB_Index n                         // number of tuples
+) {
+	ASSERT(C != NULL);
+
+	if(n == 0) return GrB_SUCCESS;
+
+	GrB_Info   info;
+	GrB_Index  nrows;
+	GrB_Index  ncols;
+	GrB_Index  m_nvals;
+	GrB_Index  dm_nvals;
+	GrB_Matrix T;
+
+	GrB_Matrix m  = RG_MATRIX_M(C);
+	GrB_Matrix dp = RG_MATRIX_DELTA_PLUS(C);
+	GrB_Matrix dm = RG_MATRIX_DELTA_MINUS(C);
+
+	if(RG_MATRIX_MAINTAIN_TRANSPOSE(C)) {
+		info = RG_Matrix_setElements_BOOL(C->transposed, J, I, n);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	// create edge merge binary function
+	// writers to different graphs may get here concurrently
+	pthread_once(&_graph_edge_merge_once, _edge_merge_init);
+
+	// C is empty, build M
+	// tuples sharing the same position form a multi-edge entry
+	if(_RG_Matrix_empty(C)) {
+		info = GrB_Matrix_build_UINT64(m, I, J, X, n, _graph_edge_merge);
+		ASSERT(info == GrB_SUCCESS);
+		RG_Matrix_setDirty(C);
+		return info;
+	}
+
+	info = GrB_Matrix_nrows(&nrows, m);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Matrix_ncols(&ncols, m);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Matrix_new(&T, GrB_UINT64, nrows, ncols);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Matrix_build_UINT64(T, I, J, X, n, _graph_edge_merge);
+	ASSERT(info == GrB_SUCCESS);
+
+	//--------------------------------------------------------------------------
+	// entries marked for deletion are replaced
+	//--------------------------------------------------------------------------
+
+	info = GrB_Matrix_nvals(&dm_nvals, dm);
+	ASSERT(info == GrB_SUCCESS);
+
+	if(dm_nvals > 0) {
+		GrB_Matrix R;
+		GrB_Index  r_nvals;
+
+		// R = T ∩ DM
+		info = GrB_Matrix_new(&R, GrB_UINT64, nrows, ncols);
+		ASSERT(info == GrB_SUCCESS);
+		info = GrB_Matrix_eWiseMult_BinaryOp(R, NULL, NULL, GrB_FIRST_UINT64,
+				T, dm, NULL);
+		ASSERT(info == GrB_SUCCESS);
+		info = GrB_Matrix_nvals(&r_nvals, R);
+		ASSERT(info == GrB_SUCCESS);
+
+		if(r_nvals > 0) {
+			// M<R> = R
+			info = GrB_Matrix_assign(m, R, NULL, R, GrB_ALL, nrows, GrB_ALL,
+					ncols, GrB_DESC_S);
+			ASSERT(info == GrB_SUCCESS);
+
+			// DM<!R> = DM
+			info = GrB_Matrix_apply(dm, R, NULL, GrB_IDENTITY_BOOL, dm,
+					GrB_DESC_RSC);
+			ASSERT(info == GrB_SUCCESS);
+
+			// T<!R> = T
+			info = GrB_Matrix_apply(T, R, NULL, GrB_IDENTITY_UINT64, T,
+					GrB_DESC_RSC);
+			ASSERT(info == GrB_SUCCESS);
+		}
+
+		GrB_Matrix_free(&R);
+	}
+
+	//--------------------------------------------------------------------------
+	// entries existing in M are merged into M
+	//--------------------------------------------------------------------------
+
+	info = GrB_Matrix_nvals(&m_nvals, m);
+	ASSERT(info == GrB_SUCCESS);
+
+	if(m_nvals > 0) {
+		// M<M> merge= T
+		info = GrB_Matrix_assign(m, m, _graph_edge_merge, T, GrB_ALL, nrows,
+				GrB_ALL, ncols, GrB_DESC_S);
+		ASSERT(info == GrB_SUCCESS);
+
+		// T<!M> = T
+		info = GrB_Matrix_apply(T, m, NULL, GrB_IDENTITY_UINT64, T,
+				GrB_DESC_RSC);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	//--------------------------------------------------------------------------
+	// remaining entries are merged into delta-plus
+	//--------------------------------------------------------------------------
+
+	info = GrB_Matrix_eWiseAdd_BinaryOp(dp, NULL, NULL, _graph_edge_merge, dp,
+			T, NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	RG_Matrix_setDirty(C);
+
+	GrB_Matrix_free(&T);
+
+	return info;
+}
@@ -0,0 +1,326 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "agg_state.h"
+#include "../errors/errors.h"
+#include "../util/rmalloc.h"
+#include "../datatypes/array.h"
+
+#include <math.h>
+#include <float.h>
+#include <strings.h>
+
+// initial number of states
+#define AGG_STATES_INITIAL_CAP 16
+
+// running average, see agg_avg.c
+typedef struct {
+	long double total;  // sum of all elements
+	uint64_t count;     // number of elements summed
+	bool overflow;      // track numeric overflow
+} AvgState;
+
+// return true if adding a and b will overflow
+#define ABOUT_TO_OVERFLOW(a, b) (signbit((a)) == signbit((b)) && \
+	   (fabsl((a)) > (DBL_MAX - fabsl((b)))))
+
+#define STATE(s, group) ((char *)(s)->states + (group) * (s)->state_size)
+
+// determine state type of aggregate expression
+static AggStateType _AggStates_Type
+(
+	const AR_ExpNode *exp  // aggregate expression
+) {
+	if(!AR_EXP_IsOperation(exp)          ||
+	   !exp->op.f->aggregate             ||
+	   exp->op.child_count != 1          ||
+	   AR_EXP_PerformsDistinct((AR_ExpNode *)exp)) {
+		return AGG_STATE_EXP;
+	}
+
+	const char *name = AR_EXP_GetFuncName(exp);
+
+	if(strcasecmp(name, "count")   == 0) return AGG_STATE_COUNT;
+	if(strcasecmp(name, "sum")     == 0) return AGG_STATE_SUM;
+	if(strcasecmp(name, "avg")     == 0) return AGG_STATE_AVG;
+	if(strcasecmp(name, "min")     == 0) return AGG_STATE_MIN;
+	if(strcasecmp(name, "max")     == 0) return AGG_STATE_MAX;
+	if(strcasecmp(name, "collect") == 0) return AGG_STATE_COLLECT;
+
+	return AGG_STATE_EXP;
+}
+
+// initialize aggregation states for aggregate expression 'exp'
+// 'exp' is not owned by the states and must outlive them
+void AggStates_Init
+(
+	AggStates *s,    // states to initialize
+	AR_ExpNode *exp  // aggregate expression
+) {
+	ASSERT(s   != NULL);
+	ASSERT(exp != NULL);
+
+	s->exp       = exp;
+	s->arg       = NULL;
+	s->arg_types = SI_ALL;
+	s->type      = _AggStates_Type(exp);
+	s->count     = 0;
+	s->cap       = 0;
+	s->states    = NULL;
+
+	if(s->type != AGG_STATE_EXP) {
+		s->arg       = exp->op.children[0];
+		s->arg_types = exp->op.f->types[0];
+	}
+
+	switch(s->type) {
+		case AGG_STATE_COUNT:
+			s->state_size = sizeof(int64_t);
+			break;
+		case AGG_STATE_SUM:
+			s->state_size = sizeof(double);
+			break;
+		case AGG_STATE_AVG:
+			s->state_size = sizeof(AvgState);
+			break;
+		case AGG_STATE_MIN:
+		case AGG_STATE_MAX:
+		case AGG_STATE_COLLECT:
+			s->state_size = sizeof(SIValue);
+			break;
+		case AGG_STATE_EXP:
+			s->state_size = sizeof(AR_ExpNode *);
+			break;
+		default:
+			ASSERT(false && "unknown aggregation state type");
+	}
+}
+
+// append a state for a new group
+void AggStates_Add
+(
+	AggStates *s  // states
+) {
+	ASSERT(s != NULL);
+
+	if(s->count == s->cap) {
+		s->cap = (s->cap > 0) ? s->cap * 2 : AGG_STATES_INITIAL_CAP;
+		s->states = rm_realloc(s->states, s->cap * s->state_size);
+	}
+
+	void *state = STATE(s, s->count);
+	s->count++;
+
+	switch(s->type) {
+		case AGG_STATE_COUNT:
+			*(int64_t *)state = 0;
+			break;
+		case AGG_STATE_SUM:
+			*(double *)state = 0;
+			break;
+		case AGG_STATE_AVG:
+			*(AvgState *)state = (AvgState){0};
+			break;
+		case AGG_STATE_MIN:
+		case AGG_STATE_MAX:
+		case AGG_STATE_COLLECT:
+			// collect's array is allocated on first use
+			*(SIValue *)state = SI_NullVal();
+			break;
+		case AGG_STATE_EXP:
+			*(AR_ExpNode **)state = AR_EXP_Clone(s->exp);
+			break;
+		default:
+			ASSERT(false && "unknown aggregation state type");
+	}
+}
+
+static void _AggStates_StepAvg
+(
+	AvgState *avg,  // average state
+	long double v   // value to aggregate
+) {
+	avg->count++;
+
+	// if we've already overflowed or adding the current value
+	// will cause us to overflow, use the incremental averaging algorithm
+	if(avg->overflow || ABOUT_TO_OVERFLOW(avg->total, v)) {
+		// divide the total by the new count
+		long double total = avg->total /= (long double)avg->count;
+		// if this is not the first call using the incremental algorithm,
+		// multiply the total by the previous count
+		if(avg->overflow) total *= (long double)(avg->count - 1);
+		// add v/count to total
+		total += (v / (long double)avg->count);
+		avg->total = total;
+		avg->overflow = true;
+	} else {
+		// no overflow
+		avg->total += v;
+	}
+}
+
+// aggregate record 'r' into the state of group 'group'
+void AggStates_Step
+(
+	AggStates *s,    // states
+	uint64_t group,  // group index
+	const Record r   // record to aggregate
+) {
+	ASSERT(s != NULL);
+	ASSERT(group < s->count);
+
+	void *state = STATE(s, group);
+
+	if(s->type == AGG_STATE_EXP) {
+		AR_EXP_Aggregate(*(AR_ExpNode **)state, r);
+		return;
+	}
+
+	SIValue v = AR_EXP_Evaluate(s->arg, r);
+
+	if(!(SI_TYPE(v) & s->arg_types)) {
+		Error_SITypeMismatch(v, s->arg_types);
+		SIValue_Free(v);
+		ErrorCtx_RaiseRuntimeException(NULL);
+		return;
+	}
+
+	// NULLs are ignored by all aggregation functions
+	if(SI_TYPE(v) == T_NULL) return;
+
+	int compared_null;
+	SIValue *current;
+
+	switch(s->type) {
+		case AGG_STATE_COUNT:
+			(*(int64_t *)state)++;
+			break;
+		case AGG_STATE_SUM:
+			*(double *)state += SI_GET_NUMERIC(v);
+			break;
+		case AGG_STATE_AVG:
+			_AggStates_StepAvg((AvgState *)state, SI_GET_NUMERIC(v));
+			break;
+		case AGG_STATE_MIN:
+			current = (SIValue *)state;
+			if((SIValue_Compare(*current, v, &compared_null) > 0) ||
+			   (compared_null == COMPARED_NULL)) {
+				SIValue_Free(*current);
+				*current = SI_CloneValue(v);
+			}
+			break;
+		case AGG_STATE_MAX:
+			current = (SIValue *)state;
+			if((SIValue_Compare(*current, v, &compared_null) < 0) ||
+			   (compared_null == COMPARED_NULL)) {
+				SIValue_Free(*current);
+				*current = SI_CloneValue(v);
+			}
+			break;
+		case AGG_STATE_COLLECT:
+			current = (SIValue *)state;
+			if(SI_TYPE(*current) == T_NULL) *current = SI_Array(1);
+			// SIArray_Append clones the added value
+			SIArray_Append(current, v);
+			break;
+		default:
+			ASSERT(false && "unknown aggregation state type");
+	}
+
+	SIValue_Free(v);
+}
+
+// compute the final value of group 'group'
+// the returned value is owned by the states
+// each group should be finalized at most once
+SIValue AggStates_Finalize
+(
+	AggStates *s,    // states
+	uint64_t group,  // group index
+	const Record r   // record holding the group's keys
+) {
+	ASSERT(s != NULL);
+	ASSERT(group < s->count);
+
+	void *state = STATE(s, group);
+	AvgState *avg;
+	SIValue *current;
+
+	switch(s->type) {
+		case AGG_STATE_COUNT:
+			return SI_LongVal(*(int64_t *)state);
+		case AGG_STATE_SUM:
+			return SI_DoubleVal(*(double *)state);
+		case AGG_STATE_AVG:
+			avg = (AvgState *)state;
+			if(avg->count == 0) return SI_NullVal();
+			// when overflowed the incremental algorithm was used
+			// and 'total' is the average
+			return avg->overflow ?
+				SI_DoubleVal(avg->total) :
+				SI_DoubleVal(avg->total / avg->count);
+		case AGG_STATE_MIN:
+		case AGG_STATE_MAX:
+			return SI_ShareValue(*(SIValue *)state);
+		case AGG_STATE_COLLECT:
+			current = (SIValue *)state;
+			if(SI_TYPE(*current) == T_NULL) *current = SI_Array(0);
+			return SI_ShareValue(*current);
+		case AGG_STATE_EXP:
+			return AR_EXP_FinalizeAggregations(*(AR_ExpNode **)state, r);
+		default:
+			ASSERT(false && "unknown aggregation state type");
+	}
+
+	return SI_NullVal();
+}
+
+// remove all states, retaining allocated memory
+void AggStates_Clear
+(
+	AggStates *s  // states
+) {
+	ASSERT(s != NULL);
+
+	switch(s->type) {
+		case AGG_STATE_MIN:
+		case AGG_STATE_MAX:
+		case AGG_STATE_COLLECT:
+			for(uint64_t i = 0; i < s->count; i++) {
+				SIValue_Free(*(SIValue *)STATE(s, i));
+			}
+			break;
+		case AGG_STATE_EXP:
+			for(uint64_t i = 0; i < s->count; i++) {
+				AR_EXP_Free(*(AR_ExpNode **)STATE(s, i));
+			}
+			break;
+		default:
+			break;
+	}
+
+	s->count = 0;
+}
+
+// free states internals
+void AggStates_Free
+(
+	AggStates *s  // states
+) {
+	ASSERT(s != NULL);
+
+	AggStates_Clear(s);
+
+	if(s->states != NULL) {
+		rm_free(s->states);
+		s->states = NULL;
+	}
+
+	s->cap = 0;
+}
+
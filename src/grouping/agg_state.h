@@ -0,0 +1,90 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "../value.h"
+#include "../execution_plan/record.h"
+#include "../arithmetic/arithmetic_expression.h"
+
+#include <stdint.h>
+
+// aggregation states of a single aggregate expression, one state per group
+//
+// an aggregate expression which is a direct call to one of
+// count, sum, avg, min, max or collect over a single non distinct argument
+// keeps a compact, function specific state per group
+// states are stored back to back in a single array indexed by group
+//
+// any other aggregate expression e.g. `count(DISTINCT x)`, `stDev(x)`
+// or `sum(x) / count(x)` is cloned per group and aggregated
+// through the expression tree
+
+typedef enum {
+	AGG_STATE_COUNT,    // int64 count
+	AGG_STATE_SUM,      // double sum
+	AGG_STATE_AVG,      // running average
+	AGG_STATE_MIN,      // minimum value
+	AGG_STATE_MAX,      // maximum value
+	AGG_STATE_COLLECT,  // array of values
+	AGG_STATE_EXP       // per group clone of the aggregate expression
+} AggStateType;
+
+typedef struct {
+	AggStateType type;   // type of state
+	AR_ExpNode *exp;     // aggregate expression
+	AR_ExpNode *arg;     // aggregated argument, compact states only
+	SIType arg_types;    // accepted argument types, compact states only
+	size_t state_size;   // size of a single state in bytes
+	uint64_t count;      // number of states
+	uint64_t cap;        // number of allocated states
+	void *states;        // states array
+} AggStates;
+
+// initialize aggregation states for aggregate expression 'exp'
+// 'exp' is not owned by the states and must outlive them
+void AggStates_Init
+(
+	AggStates *s,    // states to initialize
+	AR_ExpNode *exp  // aggregate expression
+);
+
+// append a state for a new group
+void AggStates_Add
+(
+	AggStates *s  // states
+);
+
+// aggregate record 'r' into the state of group 'group'
+void AggStates_Step
+(
+	AggStates *s,    // states
+	uint64_t group,  // group index
+	const Record r   // record to aggregate
+);
+
+// compute the final value of group 'group'
+// the returned value is owned by the states
+// each group should be finalized at most once
+SIValue AggStates_Finalize
+(
+	AggStates *s,    // states
+	uint64_t group,  // group index
+	const Record r   // record holding the group's keys
+);
+
+// remove all states, retaining allocated memory
+void AggStates_Clear
+(
+	AggStates *s  // states
+);
+
+// free states internals
+void AggStates_Free
+(
+	AggStates *s  // states
+);
+
@@ -0,0 +1,170 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "group_table.h"
+#include "../util/rmalloc.h"
+
+#include <string.h>
+
+// minimum number of slots
+#define GROUP_TABLE_MIN_SLOTS 16
+
+// round 'n' up to the next power of 2
+static uint64_t _next_pow2
+(
+	uint64_t n
+) {
+	uint64_t p = GROUP_TABLE_MIN_SLOTS;
+	while(p < n) p <<= 1;
+	return p;
+}
+
+// returns the slot holding 'hash' or the empty slot it should be placed at
+static inline GroupSlot *_GroupTable_Probe
+(
+	GroupSlot *slots,     // slots
+	uint64_t slot_count,  // number of slots, power of 2
+	uint64_t hash         // hash to locate
+) {
+	uint64_t mask = slot_count - 1;
+	uint64_t i    = hash & mask;
+
+	while(true) {
+		GroupSlot *s = slots + i;
+		if(s->group == 0 || s->hash == hash) return s;
+		i = (i + 1) & mask;
+	}
+}
+
+// double the number of slots, rehashing all groups
+static void _GroupTable_Grow
+(
+	GroupTable *t  // group table
+) {
+	uint64_t   slot_count = t->slot_count * 2;
+	GroupSlot *slots      = rm_calloc(slot_count, sizeof(GroupSlot));
+
+	for(uint64_t i = 0; i < t->slot_count; i++) {
+		GroupSlot *s = t->slots + i;
+		if(s->group == 0) continue;
+		*_GroupTable_Probe(slots, slot_count, s->hash) = *s;
+	}
+
+	rm_free(t->slots);
+	t->slots      = slots;
+	t->slot_count = slot_count;
+}
+
+// create a new group table
+GroupTable *GroupTable_New
+(
+	uint key_count,  // number of keys per group
+	uint64_t cap     // expected number of groups
+) {
+	GroupTable *t = rm_malloc(sizeof(GroupTable));
+
+	t->key_count   = key_count;
+	t->group_count = 0;
+	t->slot_count  = _next_pow2(cap * 2);
+	t->slots       = rm_calloc(t->slot_count, sizeof(GroupSlot));
+	t->keys_cap    = (key_count > 0) ? cap : 0;
+	t->keys        = (key_count > 0) ?
+		rm_malloc(sizeof(SIValue) * key_count * cap) : NULL;
+
+	return t;
+}
+
+// get the index of the group identified by 'hash'
+// creates the group if it doesn't exist, in which case 'created' is set
+// the table takes ownership of 'keys' when a group is created
+// otherwise 'keys' are freed
+uint64_t GroupTable_FindOrInsert
+(
+	GroupTable *t,    // group table
+	uint64_t hash,    // hash of keys
+	SIValue *keys,    // group keys, key_count values
+	bool *created     // [output] true if group was created
+) {
+	ASSERT(t       != NULL);
+	ASSERT(created != NULL);
+
+	GroupSlot *s = _GroupTable_Probe(t->slots, t->slot_count, hash);
+
+	if(s->group != 0) {
+		// group exists, free computed keys
+		for(uint i = 0; i < t->key_count; i++) {
+			SIValue_Free(keys[i]);
+		}
+
+		*created = false;
+		return s->group - 1;
+	}
+
+	//--------------------------------------------------------------------------
+	// create group
+	//--------------------------------------------------------------------------
+
+	uint64_t group = t->group_count++;
+
+	if(t->key_count > 0) {
+		if(group == t->keys_cap) {
+			t->keys_cap = (t->keys_cap > 0) ?
+				t->keys_cap * 2 : GROUP_TABLE_MIN_SLOTS;
+			t->keys = rm_realloc(t->keys,
+					sizeof(SIValue) * t->key_count * t->keys_cap);
+		}
+
+		SIValue *group_keys = GroupTable_Keys(t, group);
+		for(uint i = 0; i < t->key_count; i++) {
+			SIValue key = SI_TransferOwnership(keys + i);
+			SIValue_Persist(&key);
+			group_keys[i] = key;
+		}
+	}
+
+	s->hash  = hash;
+	s->group = group + 1;
+
+	// keep load factor at or below 0.5
+	if(t->group_count * 2 > t->slot_count) {
+		_GroupTable_Grow(t);
+	}
+
+	*created = true;
+	return group;
+}
+
+// remove all groups from table, retaining allocated memory
+void GroupTable_Clear
+(
+	GroupTable *t  // group table
+) {
+	ASSERT(t != NULL);
+
+	uint64_t n = t->group_count * t->key_count;
+	for(uint64_t i = 0; i < n; i++) {
+		SIValue_Free(t->keys[i]);
+	}
+
+	memset(t->slots, 0, sizeof(GroupSlot) * t->slot_count);
+	t->group_count = 0;
+}
+
+// free group table
+void GroupTable_Free
+(
+	GroupTable *t  // group table to free
+) {
+	if(t == NULL) return;
+
+	GroupTable_Clear(t);
+
+	if(t->keys != NULL) rm_free(t->keys);
+	rm_free(t->slots);
+	rm_free(t);
+}
+
@@ -0,0 +1,86 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "../value.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// a group table maps group keys to dense group indices
+//
+// groups are identified by the 64 bit hash of their keys
+// the table is an open addressing hash table using linear probing
+// slots hold a group's hash and index, the keys of all groups
+// are stored back to back in a single flat array
+//
+// group indices are assigned in insertion order, starting at 0
+// allowing per group data to be kept in contiguous arrays
+// indexed by group
+
+typedef struct {
+	uint64_t hash;   // group key hash
+	uint64_t group;  // group index + 1, 0 marks an empty slot
+} GroupSlot;
+
+typedef struct {
+	uint key_count;        // number of keys per group
+	uint64_t group_count;  // number of groups
+	uint64_t slot_count;   // number of slots, power of 2
+	GroupSlot *slots;      // hash table slots
+	SIValue *keys;         // flat key array, key_count values per group
+	uint64_t keys_cap;     // number of groups 'keys' can hold
+} GroupTable;
+
+// create a new group table
+GroupTable *GroupTable_New
+(
+	uint key_count,  // number of keys per group
+	uint64_t cap     // expected number of groups
+);
+
+// get the index of the group identified by 'hash'
+// creates the group if it doesn't exist, in which case 'created' is set
+// the table takes ownership of 'keys' when a group is created
+// otherwise 'keys' are freed
+uint64_t GroupTable_FindOrInsert
+(
+	GroupTable *t,    // group table
+	uint64_t hash,    // hash of keys
+	SIValue *keys,    // group keys, key_count values
+	bool *created     // [output] true if group was created
+);
+
+// returns the keys of group 'group'
+static inline SIValue *GroupTable_Keys
+(
+	const GroupTable *t,  // group table
+	uint64_t group        // group index
+) {
+	return t->keys + group * t->key_count;
+}
+
+// returns the number of groups in table
+static inline uint64_t GroupTable_Count
+(
+	const GroupTable *t  // group table
+) {
+	return t->group_count;
+}
+
+// remove all groups from table, retaining allocated memory
+void GroupTable_Clear
+(
+	GroupTable *t  // group table
+);
+
+// free group table
+void GroupTable_Free
+(
+	GroupTable *t  // group table to free
+);
+
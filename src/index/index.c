@@ -12,6 +12,7 @@
 #include "../util/rmalloc.h"
 #include "../datatypes/point.h"
 #include "../graph/graphcontext.h"
+#include "../configuration/config.h"
 #include "../graph/entities/node.h"
 #include "../graph/rg_matrix/rg_matrix_iter.h"
 
@@ -25,7 +26,8 @@ struct _Index {
 	char **stopwords;              // stopwords
 	GraphEntityType entity_type;   // entity type (node/edge) indexed
 	IndexType type;                // index type exact-match / fulltext
-	RSIndex *rsIdx;                // RediSearch index
+	RSIndex *rsIdx;                // RediSearch index, full-text only
+	RangeIndex *range;             // range index, exact-match only
 	uint _Atomic pending_changes;  // number of pending changes
 };
 
@@ -57,44 +59,6 @@ static void _Index_ConstructFullTextStructure
 	}
 }
 
-static void _Index_ConstructExactMatchStructure
-(
-	Index idx,
-	RSIndex *rsIdx
-) {
-	ASSERT(idx != NULL);
-	ASSERT(rsIdx != NULL);
-
-	RSFieldID fieldID;
-	uint fields_count = array_len(idx->fields);
-	unsigned types = RSFLDTYPE_NUMERIC | RSFLDTYPE_GEO | RSFLDTYPE_TAG;
-
-	for(uint i = 0; i < fields_count; i++) {
-		IndexField *field = idx->fields + i;
-		// introduce both text, numeric and geo fields
-		fieldID = RediSearch_CreateField(rsIdx, field->name, types,
-				RSFLDOPT_NONE);
-		RediSearch_TagFieldSetSeparator(rsIdx, fieldID, INDEX_SEPARATOR);
-		RediSearch_TagFieldSetCaseSensitive(rsIdx, fieldID, 1);
-	}
-
-	// introduce edge src and dest node ids as additional index fields
-	if(idx->entity_type == GETYPE_EDGE) {
-		RediSearch_CreateField(rsIdx, "_src_id", RSFLDTYPE_NUMERIC,
-				RSFLDOPT_NONE);
-		RediSearch_CreateField(rsIdx, "_dest_id", RSFLDTYPE_NUMERIC,
-				RSFLDOPT_NONE);
-	}
-
-	// for none indexable types e.g. Array introduce an additional field
-	// "none_indexable_fields" which will hold a list of attribute names
-	// that were not indexed
-	fieldID = RediSearch_CreateField(rsIdx, INDEX_FIELD_NONE_INDEXED,
-			RSFLDTYPE_TAG, RSFLDOPT_NONE);
-	RediSearch_TagFieldSetSeparator(rsIdx, fieldID, INDEX_SEPARATOR);
-	RediSearch_TagFieldSetCaseSensitive(rsIdx, fieldID, 1);
-}
-
 // responsible for creating the index structure only!
 // e.g. fields, stopwords, language
 void Index_ConstructStructure
@@ -103,6 +67,25 @@ void Index_ConstructStructure
 ) {
 	ASSERT(idx != NULL);
 	ASSERT(idx->rsIdx == NULL);
+	ASSERT(idx->range == NULL);
+
+	// exact-match indexes are served by a native range index
+	if(idx->type == IDX_EXACT_MATCH) {
+		uint fields_count = array_len(idx->fields);
+		Attribute_ID attrs[fields_count + 1];
+		for(uint i = 0; i < fields_count; i++) {
+			attrs[i] = idx->fields[i].id;
+		}
+
+		idx->range = RangeIndex_New(attrs, fields_count);
+
+		// substring lookups are served by trigram postings
+		bool trigrams;
+		Config_Option_get(Config_TRIGRAM_INDEX, &trigrams);
+		if(trigrams) RangeIndex_EnableTrigrams(idx->range);
+
+		return;
+	}
 
 	RSIndex *rsIdx = NULL;
 	RSIndexOptions *idx_options = RediSearch_CreateIndexOptions();
@@ -119,22 +102,15 @@ void Index_ConstructStructure
 	if(idx->stopwords) {
 		RediSearch_IndexOptionsSetStopwords(idx_options,
 				(const char**)idx->stopwords, array_len(idx->stopwords));
-	} else if(idx->type == IDX_EXACT_MATCH) {
-		RediSearch_IndexOptionsSetStopwords(idx_options, NULL, 0);
 	}
 
 	rsIdx = RediSearch_CreateIndex(idx->label, idx_options);
 	RediSearch_FreeIndexOptions(idx_options);
 
 	// create indexed fields
-	if(idx->type == IDX_FULLTEXT) {
-		_Index_ConstructFullTextStructure(idx, rsIdx);
-	} else {
-		_Index_ConstructExactMatchStructure(idx, rsIdx);
-	}
+	_Index_ConstructFullTextStructure(idx, rsIdx);
 
 	// set RediSearch index
-	ASSERT(idx->rsIdx == NULL);
 	idx->rsIdx = rsIdx;
 }
 
@@ -151,95 +127,33 @@ RSDoc *Index_IndexGraphEntity
 	ASSERT(key              !=  NULL);
 	ASSERT(doc_field_count  !=  NULL);
 	ASSERT(key_len          >   0);
+	ASSERT(idx->type        ==  IDX_FULLTEXT);
 
 	double     score       = 1;     // default score
 	IndexField *field      = NULL;  // current indexed field
 	SIValue    *v          = NULL;  // current indexed value
-	EntityID   id          = ENTITY_GET_ID(e);
 	uint       field_count = array_len(idx->fields);
 
 	*doc_field_count = 0;
 
-	// list of none indexable fields
-	uint none_indexable_fields_count = 0; // number of none indexed fields
-	const char *none_indexable_fields[field_count]; // none indexed fields
-
 	// create an empty document
 	RSDoc *doc = RediSearch_CreateDocument2(key, key_len, NULL, score,
 			idx->language);
 
 	// add document field for each indexed property
-	if(idx->type == IDX_FULLTEXT) {
-		for(uint i = 0; i < field_count; i++) {
-			field = idx->fields + i;
-			const char *field_name = field->name;
-			v = GraphEntity_GetProperty(e, field->id);
-			if(v == ATTRIBUTE_NOTFOUND) continue;
-
-			SIType t = SI_TYPE(*v);
-
-			// value must be of type string
-			if(t == T_STRING) {
-				*doc_field_count += 1;
-				RediSearch_DocumentAddFieldString(doc, field_name, v->stringval,
-						strlen(v->stringval), RSFLDTYPE_FULLTEXT);
-			}
-		}
-	} else {
-		for(uint i = 0; i < field_count; i++) {
-			field = idx->fields + i;
-			const char *field_name = field->name;
-			v = GraphEntity_GetProperty(e, field->id);
-			if(v == ATTRIBUTE_NOTFOUND) continue;
+	for(uint i = 0; i < field_count; i++) {
+		field = idx->fields + i;
+		const char *field_name = field->name;
+		v = GraphEntity_GetProperty(e, field->id);
+		if(v == ATTRIBUTE_NOTFOUND) continue;
 
-			SIType t = SI_TYPE(*v);
+		SIType t = SI_TYPE(*v);
 
+		// value must be of type string
+		if(t == T_STRING) {
 			*doc_field_count += 1;
-			if(t == T_STRING) {
-				RediSearch_DocumentAddFieldString(doc, field_name, v->stringval,
-						strlen(v->stringval), RSFLDTYPE_TAG);
-			} else if(t & (SI_NUMERIC | T_BOOL)) {
-				double d = SI_GET_NUMERIC(*v);
-				RediSearch_DocumentAddFieldNumber(doc, field_name, d,
-						RSFLDTYPE_NUMERIC);
-			} else if(t == T_POINT) {
-				double lat = (double)Point_lat(*v);
-				double lon = (double)Point_lon(*v);
-				RediSearch_DocumentAddFieldGeo(doc, field_name, lat, lon,
-						RSFLDTYPE_GEO);
-			} else {
-				// none indexable field
-				none_indexable_fields[none_indexable_fields_count++] =
-					field_name;
-			}
-		}
-
-		// index name of none index fields
-		if(none_indexable_fields_count > 0) {
-			// concat all none indexable field names
-			size_t len = none_indexable_fields_count - 1; // seperators
-			for(uint i = 0; i < none_indexable_fields_count; i++) {
-				len += strlen(none_indexable_fields[i]);
-			}
-
-			// add room for \0
-			len++;
-
-			char *s = NULL;
-			if(len < 512) s = alloca(len); // stack base
-			else s = rm_malloc(sizeof(char) * len); // heap base
-
-			// concat
-			len = sprintf(s, "%s", none_indexable_fields[0]);
-			for(uint i = 1; i < none_indexable_fields_count; i++) {
-				len += sprintf(s + len, "%c%s", INDEX_SEPARATOR, none_indexable_fields[i]);
-			}
-
-			RediSearch_DocumentAddFieldString(doc, INDEX_FIELD_NONE_INDEXED,
-						s, len, RSFLDTYPE_TAG);
-
-			// free if heap based
-			if(len >= 512) rm_free(s);
+			RediSearch_DocumentAddFieldString(doc, field_name, v->stringval,
+					strlen(v->stringval), RSFLDTYPE_FULLTEXT);
 		}
 	}
 
@@ -291,6 +205,7 @@ Index Index_New
 	idx->type            = type;
 	idx->label           = rm_strdup(label);
 	idx->rsIdx           = NULL;
+	idx->range           = NULL;
 	idx->fields          = array_new(IndexField, 1);
 	idx->label_id        = label_id;
 	idx->language        = NULL;
@@ -317,6 +232,7 @@ Index Index_Clone
 	memcpy(clone, idx, sizeof(_Index));
 
 	clone->rsIdx           = NULL;
+	clone->range           = NULL;
 	clone->label           = rm_strdup(idx->label);
 	clone->pending_changes = ATOMIC_VAR_INIT(0);
 	
@@ -351,7 +267,7 @@ int Index_PendingChanges
 }
 
 // disable index by increasing the number of pending changes
-// and re-creating the internal RediSearch index
+// and re-creating the internal index structure
 void Index_Disable
 (
 	Index idx  // index to disable
@@ -366,6 +282,11 @@ void Index_Disable
 		idx->rsIdx = NULL;
 	}
 
+	if(idx->range != NULL) {
+		RangeIndex_Free(idx->range);
+		idx->range = NULL;
+	}
+
 	// construct index structure
 	Index_ConstructStructure(idx);
 }
@@ -377,10 +298,16 @@ void Index_Enable
 	Index idx
 ) {
 	ASSERT(idx != NULL);
-	ASSERT(idx->rsIdx != NULL);
+	ASSERT(idx->rsIdx != NULL || idx->range != NULL);
 	ASSERT(idx->pending_changes > 0);
 
 	idx->pending_changes--;
+
+	// index is fully populated, build range tree out of staged entities
+	if(idx->pending_changes == 0 && idx->range != NULL &&
+	   RangeIndex_Staging(idx->range)) {
+		RangeIndex_Flush(idx->range);
+	}
 }
 
 // adds field to index
@@ -514,6 +441,11 @@ const char *Index_GetLanguage
 ) {
 	ASSERT(idx != NULL);
 
+	// language only applies to full-text indexes
+	if(idx->type != IDX_FULLTEXT) {
+		return (idx->language != NULL) ? idx->language : "english";
+	}
+
 	RSIndex *_idx = Index_RSIndex(idx);
 	ASSERT(_idx != NULL);
 
@@ -527,14 +459,14 @@ char **Index_GetStopwords
 ) {
 	ASSERT(idx != NULL);
 
+	if(idx->type != IDX_FULLTEXT) {
+		return NULL;
+	}
+
 	RSIndex *_idx = Index_RSIndex(idx);
 	ASSERT(_idx != NULL);
 
-	if(idx->type == IDX_FULLTEXT) {
-		return RediSearch_IndexGetStopwords(_idx, size);
-	}
-
-	return NULL;
+	return RediSearch_IndexGetStopwords(_idx, size);
 }
 
 // set indexed language
@@ -583,6 +515,16 @@ RSIndex *Index_RSIndex
 	return idx->rsIdx;
 }
 
+// returns range index
+RangeIndex *Index_RangeIndex
+(
+	const Index idx  // index to get internal range index from
+) {
+	ASSERT(idx != NULL);
+
+	return idx->range;
+}
+
 // free index
 void Index_Free
 (
@@ -594,6 +536,10 @@ void Index_Free
 		RediSearch_DropIndex(idx->rsIdx);
 	}
 
+	if(idx->range) {
+		RangeIndex_Free(idx->range);
+	}
+
 	if(idx->language) {
 		rm_free(idx->language);
 	}
@@ -10,12 +10,11 @@
 #include "../graph/entities/edge.h"
 #include "../graph/entities/graph_entity.h"
 #include "../graph/graph.h"
+#include "range_index.h"
 #include "redisearch_api.h"
 
 #define INDEX_OK 1
 #define INDEX_FAIL 0
-#define INDEX_SEPARATOR '\1'  // can't use '\0', RediSearch will terminate on \0
-#define INDEX_FIELD_NONE_INDEXED "NONE_INDEXABLE_FIELDS"
 
 #define INDEX_FIELD_DEFAULT_WEIGHT 1.0
 #define INDEX_FIELD_DEFAULT_NOSTEM false
@@ -108,12 +107,18 @@ bool Index_Enabled
 	const Index idx  // index to get state of
 );
 
-// returns RediSearch index
+// returns RediSearch index, full-text indexes only
 RSIndex *Index_RSIndex
 (
 	const Index idx  // index to get internal RediSearch index from
 );
 
+// returns range index, exact-match indexes only
+RangeIndex *Index_RangeIndex
+(
+	const Index idx  // index to get internal range index from
+);
+
 // responsible for creating the index structure only!
 // e.g. fields, stopwords, language
 void Index_ConstructStructure
@@ -156,6 +161,22 @@ void Index_IndexEdge
 	const Edge *e  // edge to index
 );
 
+// index a batch of nodes
+void Index_IndexNodes
+(
+	Index idx,           // index to populate
+	const Node **nodes,  // nodes to index
+	uint64_t n           // number of nodes
+);
+
+// index a batch of edges
+void Index_IndexEdges
+(
+	Index idx,           // index to populate
+	const Edge **edges,  // edges to index
+	uint64_t n           // number of edges
+);
+
 // remove node from index
 void Index_RemoveNode
 (
@@ -22,12 +22,20 @@ void Index_IndexEdge
 	ASSERT(idx  !=  NULL);
 	ASSERT(e    !=  NULL);
 
-	RSDoc    *doc    = NULL;
-	RSIndex  *rsIdx  = Index_RSIndex(idx);
 	EntityID src_id  = Edge_GetSrcNodeID(e);
 	EntityID dest_id = Edge_GetDestNodeID(e);
 	EntityID edge_id = ENTITY_GET_ID(e);
 
+	// exact-match indexes are served by the range index
+	if(Index_Type(idx) == IDX_EXACT_MATCH) {
+		RangeIndex_Index(Index_RangeIndex(idx), (const GraphEntity *)e, src_id,
+				dest_id);
+		return;
+	}
+
+	RSDoc    *doc    = NULL;
+	RSIndex  *rsIdx  = Index_RSIndex(idx);
+
 	EdgeIndexKey key = {.src_id = src_id, .dest_id = dest_id, .edge_id = edge_id};
 	size_t key_len = sizeof(EdgeIndexKey);
 
@@ -50,6 +58,38 @@ void Index_IndexEdge
 	RediSearch_SpecAddDocument(rsIdx, doc);
 }
 
+// index a batch of edges
+void Index_IndexEdges
+(
+	Index idx,           // index to populate
+	const Edge **edges,  // edges to index
+	uint64_t n           // number of edges
+) {
+	ASSERT(idx   != NULL);
+	ASSERT(edges != NULL || n == 0);
+
+	if(Index_Type(idx) != IDX_EXACT_MATCH) {
+		for(uint64_t i = 0; i < n; i++) {
+			Index_IndexEdge(idx, edges[i]);
+		}
+		return;
+	}
+
+	EntityID *src_ids  = rm_malloc(sizeof(EntityID) * n);
+	EntityID *dest_ids = rm_malloc(sizeof(EntityID) * n);
+
+	for(uint64_t i = 0; i < n; i++) {
+		src_ids[i]  = Edge_GetSrcNodeID(edges[i]);
+		dest_ids[i] = Edge_GetDestNodeID(edges[i]);
+	}
+
+	RangeIndex_IndexBatch(Index_RangeIndex(idx), (const GraphEntity **)edges,
+			src_ids, dest_ids, n);
+
+	rm_free(src_ids);
+	rm_free(dest_ids);
+}
+
 void Index_RemoveEdge
 (
 	Index idx,     // index to update
@@ -58,6 +98,11 @@ void Index_RemoveEdge
 	ASSERT(e   != NULL);
 	ASSERT(idx != NULL);
 
+	if(Index_Type(idx) == IDX_EXACT_MATCH) {
+		RangeIndex_Remove(Index_RangeIndex(idx), ENTITY_GET_ID(e));
+		return;
+	}
+
 	RSIndex  *rsIdx  = Index_RSIndex(idx);
 	EntityID src_id  = Edge_GetSrcNodeID(e);
 	EntityID dest_id = Edge_GetDestNodeID(e);
@@ -22,6 +22,13 @@ void Index_IndexNode
 	ASSERT(n    !=  NULL);
 	ASSERT(idx  !=  NULL);
 
+	// exact-match indexes are served by the range index
+	if(Index_Type(idx) == IDX_EXACT_MATCH) {
+		RangeIndex_Index(Index_RangeIndex(idx), (const GraphEntity *)n,
+				INVALID_ENTITY_ID, INVALID_ENTITY_ID);
+		return;
+	}
+
 	EntityID key             = ENTITY_GET_ID(n);
 	RSDoc    *doc            = NULL;
 	RSIndex  *rsIdx          = Index_RSIndex(idx);
@@ -44,6 +51,27 @@ void Index_IndexNode
 	RediSearch_SpecAddDocument(rsIdx, doc);
 }
 
+// index a batch of nodes
+void Index_IndexNodes
+(
+	Index idx,           // index to populate
+	const Node **nodes,  // nodes to index
+	uint64_t n           // number of nodes
+) {
+	ASSERT(idx   != NULL);
+	ASSERT(nodes != NULL || n == 0);
+
+	if(Index_Type(idx) == IDX_EXACT_MATCH) {
+		RangeIndex_IndexBatch(Index_RangeIndex(idx),
+				(const GraphEntity **)nodes, NULL, NULL, n);
+		return;
+	}
+
+	for(uint64_t i = 0; i < n; i++) {
+		Index_IndexNode(idx, nodes[i]);
+	}
+}
+
 void Index_RemoveNode
 (
 	Index idx,     // index to update
@@ -52,8 +80,14 @@ void Index_RemoveNode
 	ASSERT(n   != NULL);
 	ASSERT(idx != NULL);
 
-	EntityID id     = ENTITY_GET_ID(n);
-	RSIndex  *rsIdx = Index_RSIndex(idx);
+	EntityID id = ENTITY_GET_ID(n);
+
+	if(Index_Type(idx) == IDX_EXACT_MATCH) {
+		RangeIndex_Remove(Index_RangeIndex(idx), id);
+		return;
+	}
+
+	RSIndex *rsIdx = Index_RSIndex(idx);
 
 	RediSearch_DeleteDocument(rsIdx, &id, sizeof(EntityID));
 }
@@ -0,0 +1,1706 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "range_index.h"
+#include "../util/arr.h"
+#include "../util/dict.h"
+#include "../util/rmalloc.h"
+#include "../util/roaring.h"
+#include "../datatypes/point.h"
+
+#include <math.h>
+#include <string.h>
+#include <stdlib.h>
+
+// max number of entries in a tree node
+#define RANGE_NODE_CAP 64
+
+// number of entries placed in a node when bulk loading
+// leaves room for future insertions
+#define RANGE_NODE_FILL (RANGE_NODE_CAP - RANGE_NODE_CAP / 8)
+
+// max tree depth
+#define RANGE_MAX_DEPTH 32
+
+// initial number of document slots
+#define RANGE_DOCS_INITIAL_CAP 1024
+
+typedef struct {
+	Attribute_ID attr;  // indexed attribute
+	uint8_t cls;        // RangeKeyClass
+	bool is_int;        // numeric value held as an integer
+	union {
+		int64_t i;      // boolean or integer
+		double d;       // double
+		const char *s;  // string
+		struct {
+			float lat;  // latitude
+			float lon;  // longitude
+		} p;            // point
+	};
+	uint64_t prefix;    // first 8 bytes of string, big endian
+} RangeKey;
+
+typedef struct {
+	RangeKey key;      // indexed value
+	EntityID id;       // entity ID
+	EntityID src_id;   // edge source node
+	EntityID dest_id;  // edge destination node
+} RangeEntry;
+
+// compares entry 'a' against 'b'
+typedef int (*RangeCmp)(const RangeEntry *a, const RangeEntry *b);
+
+// tree node header
+typedef struct {
+	bool leaf;       // leaf or inner node
+	uint16_t count;  // number of entries or children
+} RangeNode;
+
+// leaf entries point to strings owned by documents
+typedef struct RangeLeaf {
+	RangeNode hdr;                       // header
+	struct RangeLeaf *prev;              // previous leaf
+	struct RangeLeaf *next;              // next leaf
+	RangeEntry entries[RANGE_NODE_CAP];  // sorted entries
+} RangeLeaf;
+
+// separator i is the smallest entry of child i at the time it was created
+// entries of child i are >= separator i and < separator i+1
+// separators own their strings, separator 0 is unused
+typedef struct {
+	RangeNode hdr;                        // header
+	RangeEntry seps[RANGE_NODE_CAP];      // separators
+	RangeNode *children[RANGE_NODE_CAP];  // children
+} RangeInner;
+
+// indexed values of a single entity
+typedef struct {
+	EntityID src_id;   // edge source node
+	EntityID dest_id;  // edge destination node
+	RangeKey keys[];   // one key per indexed attribute, own their strings
+} RangeDoc;
+
+struct RangeIndex {
+	Attribute_ID *attrs;   // indexed attributes
+	uint attr_count;       // number of indexed attributes
+	RangeNode *root;       // tree root
+	RangeDoc **docs;       // documents, indexed by entity ID
+	uint64_t doc_cap;      // number of document slots
+	uint64_t doc_count;    // number of documents
+	uint64_t entry_count;  // number of entries in tree
+	uint64_t version;      // incremented on every modification
+	size_t memory;         // number of bytes used
+	bool staging;          // tree isn't maintained
+	dict *trigrams;        // trigram postings, NULL if not maintained
+};
+
+//------------------------------------------------------------------------------
+// keys
+//------------------------------------------------------------------------------
+
+// returns the class of value 'v'
+RangeKeyClass RangeKey_Class
+(
+	SIValue v  // value to classify
+) {
+	switch(SI_TYPE(v)) {
+		case T_NULL:
+			return RANGE_KEY_NONE;
+		case T_BOOL:
+			return RANGE_KEY_BOOL;
+		case T_INT64:
+			return RANGE_KEY_NUMERIC;
+		case T_DOUBLE:
+			return isnan(v.doubleval) ? RANGE_KEY_OTHER : RANGE_KEY_NUMERIC;
+		case T_STRING:
+			return RANGE_KEY_STRING;
+		case T_POINT:
+			return RANGE_KEY_POINT;
+		default:
+			return RANGE_KEY_OTHER;
+	}
+}
+
+// big endian first 8 bytes of 's'
+// comparing prefixes orders strings as strcmp does
+static inline uint64_t _StringPrefix
+(
+	const char *s
+) {
+	uint64_t prefix = 0;
+	for(int i = 0; i < 8; i++) {
+		prefix <<= 8;
+		if(*s != '\0') prefix |= (unsigned char)*s++;
+	}
+	return prefix;
+}
+
+// initialize key out of value, strings are not copied
+static void _RangeKey_Init
+(
+	RangeKey *k,        // key to initialize
+	Attribute_ID attr,  // indexed attribute
+	SIValue v           // indexed value
+) {
+	k->attr   = attr;
+	k->cls    = RangeKey_Class(v);
+	k->is_int = false;
+	k->i      = 0;
+	k->prefix = 0;
+
+	switch(k->cls) {
+		case RANGE_KEY_BOOL:
+			k->i = (v.longval != 0);
+			break;
+		case RANGE_KEY_NUMERIC:
+			if(SI_TYPE(v) == T_INT64) {
+				k->is_int = true;
+				k->i      = v.longval;
+			} else {
+				k->d = v.doubleval;
+			}
+			break;
+		case RANGE_KEY_STRING:
+			k->s      = v.stringval;
+			k->prefix = _StringPrefix(v.stringval);
+			break;
+		case RANGE_KEY_POINT:
+			k->p.lat = Point_lat(v);
+			k->p.lon = Point_lon(v);
+			break;
+		default:
+			break;
+	}
+}
+
+#define CMP(a, b) (((a) > (b)) - ((a) < (b)))
+
+// compares attribute and class
+static inline int _RangeKey_CompareClass
+(
+	const RangeKey *a,
+	const RangeKey *b
+) {
+	if(a->attr != b->attr) return CMP(a->attr, b->attr);
+	return CMP(a->cls, b->cls);
+}
+
+// compares attribute, class and value
+static int _RangeKey_Compare
+(
+	const RangeKey *a,
+	const RangeKey *b
+) {
+	int c = _RangeKey_CompareClass(a, b);
+	if(c != 0) return c;
+
+	switch(a->cls) {
+		case RANGE_KEY_BOOL:
+			return CMP(a->i, b->i);
+		case RANGE_KEY_NUMERIC:
+			if(a->is_int && b->is_int) return CMP(a->i, b->i);
+			// long double represents both int64 and double values exactly
+			long double x = a->is_int ? (long double)a->i : (long double)a->d;
+			long double y = b->is_int ? (long double)b->i : (long double)b->d;
+			return CMP(x, y);
+		case RANGE_KEY_STRING:
+			if(a->prefix != b->prefix) return CMP(a->prefix, b->prefix);
+			return strcmp(a->s, b->s);
+		case RANGE_KEY_POINT:
+			if(a->p.lat != b->p.lat) return CMP(a->p.lat, b->p.lat);
+			return CMP(a->p.lon, b->p.lon);
+		default:
+			return 0;
+	}
+}
+
+static int _RangeEntry_CompareClass
+(
+	const RangeEntry *a,
+	const RangeEntry *b
+) {
+	return _RangeKey_CompareClass(&a->key, &b->key);
+}
+
+static int _RangeEntry_CompareValue
+(
+	const RangeEntry *a,
+	const RangeEntry *b
+) {
+	return _RangeKey_Compare(&a->key, &b->key);
+}
+
+// total order of entries
+static int _RangeEntry_Compare
+(
+	const RangeEntry *a,
+	const RangeEntry *b
+) {
+	int c = _RangeKey_Compare(&a->key, &b->key);
+	if(c != 0) return c;
+
+	if(a->id != b->id) return CMP(a->id, b->id);
+	if(a->src_id != b->src_id) return CMP(a->src_id, b->src_id);
+	return CMP(a->dest_id, b->dest_id);
+}
+
+static int _RangeEntry_QSortCompare
+(
+	const void *a,
+	const void *b
+) {
+	return _RangeEntry_Compare((const RangeEntry *)a, (const RangeEntry *)b);
+}
+
+// free key's string
+static inline void _RangeKey_Free
+(
+	RangeIndex *ri,  // range index
+	RangeKey *k      // key to free
+) {
+	if(k->cls == RANGE_KEY_STRING) {
+		ri->memory -= strlen(k->s) + 1;
+		rm_free((char *)k->s);
+	}
+	k->cls = RANGE_KEY_NONE;
+}
+
+// copy entry into a separator, separators own their strings
+static inline void _RangeIndex_SepCopy
+(
+	RangeIndex *ri,        // range index
+	RangeEntry *sep,       // separator
+	const RangeEntry *src  // entry to copy
+) {
+	*sep = *src;
+	if(src->key.cls == RANGE_KEY_STRING) {
+		sep->key.s = rm_strdup(src->key.s);
+		ri->memory += strlen(src->key.s) + 1;
+	}
+}
+
+//------------------------------------------------------------------------------
+// tree nodes
+//------------------------------------------------------------------------------
+
+static RangeLeaf *_RangeLeaf_New
+(
+	RangeIndex *ri
+) {
+	RangeLeaf *l = rm_malloc(sizeof(RangeLeaf));
+
+	l->hdr.leaf  = true;
+	l->hdr.count = 0;
+	l->prev      = NULL;
+	l->next      = NULL;
+
+	ri->memory += sizeof(RangeLeaf);
+	return l;
+}
+
+static RangeInner *_RangeInner_New
+(
+	RangeIndex *ri
+) {
+	RangeInner *in = rm_malloc(sizeof(RangeInner));
+
+	in->hdr.leaf  = false;
+	in->hdr.count = 0;
+
+	ri->memory += sizeof(RangeInner);
+	return in;
+}
+
+// free a single node
+static void _RangeNode_Free
+(
+	RangeIndex *ri,
+	RangeNode *n
+) {
+	if(n->leaf) {
+		ri->memory -= sizeof(RangeLeaf);
+	} else {
+		RangeInner *in = (RangeInner *)n;
+		for(uint i = 1; i < n->count; i++) {
+			_RangeKey_Free(ri, &in->seps[i].key);
+		}
+		ri->memory -= sizeof(RangeInner);
+	}
+
+	rm_free(n);
+}
+
+// free subtree rooted at 'n'
+static void _RangeNode_FreeTree
+(
+	RangeIndex *ri,
+	RangeNode *n
+) {
+	if(!n->leaf) {
+		RangeInner *in = (RangeInner *)n;
+		for(uint i = 0; i < n->count; i++) {
+			_RangeNode_FreeTree(ri, in->children[i]);
+		}
+	}
+
+	_RangeNode_Free(ri, n);
+}
+
+// returns the child of 'in' to descend into
+// the last child whose separator is < key, <= key if 'after' is set
+static inline int _RangeInner_Child
+(
+	const RangeInner *in,   // inner node
+	const RangeEntry *key,  // searched key
+	RangeCmp cmp,           // comparison function
+	bool after              // search for entries greater than key
+) {
+	int lo = 1;
+	int hi = in->hdr.count;
+
+	while(lo < hi) {
+		int mid = (lo + hi) / 2;
+		int c = cmp(in->seps + mid, key);
+		if(c < 0 || (after && c == 0)) lo = mid + 1;
+		else hi = mid;
+	}
+
+	return lo - 1;
+}
+
+// returns position of the first entry >= key, > key if 'after' is set
+static inline int _RangeLeaf_Pos
+(
+	const RangeLeaf *l,     // leaf
+	const RangeEntry *key,  // searched key
+	RangeCmp cmp,           // comparison function
+	bool after              // search for entries greater than key
+) {
+	int lo = 0;
+	int hi = l->hdr.count;
+
+	while(lo < hi) {
+		int mid = (lo + hi) / 2;
+		int c = cmp(l->entries + mid, key);
+		if(c < 0 || (after && c == 0)) lo = mid + 1;
+		else hi = mid;
+	}
+
+	return lo;
+}
+
+static inline void _RangeLeaf_InsertAt
+(
+	RangeLeaf *l,
+	int pos,
+	const RangeEntry *e
+) {
+	memmove(l->entries + pos + 1, l->entries + pos,
+			sizeof(RangeEntry) * (l->hdr.count - pos));
+	l->entries[pos] = *e;
+	l->hdr.count++;
+}
+
+static inline void _RangeInner_InsertAt
+(
+	RangeInner *in,
+	int pos,
+	const RangeEntry *sep,
+	RangeNode *child
+) {
+	int n = in->hdr.count - pos;
+	memmove(in->seps + pos + 1, in->seps + pos, sizeof(RangeEntry) * n);
+	memmove(in->children + pos + 1, in->children + pos, sizeof(RangeNode *) * n);
+	in->seps[pos]     = *sep;
+	in->children[pos] = child;
+	in->hdr.count++;
+}
+
+// remove child at position 'pos' along with its separator
+static inline void _RangeInner_RemoveAt
+(
+	RangeIndex *ri,
+	RangeInner *in,
+	int pos
+) {
+	// removing the first child, the second child's separator becomes unused
+	if(pos > 0) _RangeKey_Free(ri, &in->seps[pos].key);
+	else if(in->hdr.count > 1) _RangeKey_Free(ri, &in->seps[1].key);
+
+	int n = in->hdr.count - pos - 1;
+	memmove(in->seps + pos, in->seps + pos + 1, sizeof(RangeEntry) * n);
+	memmove(in->children + pos, in->children + pos + 1, sizeof(RangeNode *) * n);
+	in->hdr.count--;
+}
+
+// position cursor at the first entry >= key, > key if 'after' is set
+static void _RangeIndex_Seek
+(
+	const RangeIndex *ri,   // range index
+	const RangeEntry *key,  // searched key
+	RangeCmp cmp,           // comparison function
+	bool after,             // search for entries greater than key
+	RangeLeaf **leaf,       // [output] leaf, NULL if no such entry
+	int *pos                // [output] position within leaf
+) {
+	RangeNode *n = ri->root;
+	while(!n->leaf) {
+		RangeInner *in = (RangeInner *)n;
+		n = in->children[_RangeInner_Child(in, key, cmp, after)];
+	}
+
+	RangeLeaf *l = (RangeLeaf *)n;
+	int p = _RangeLeaf_Pos(l, key, cmp, after);
+
+	// leaves other than an empty root are never empty
+	if(p == l->hdr.count) {
+		l = l->next;
+		p = 0;
+	}
+
+	*leaf = l;
+	*pos  = p;
+}
+
+// insert entry into tree
+static void _RangeIndex_Insert
+(
+	RangeIndex *ri,      // range index
+	const RangeEntry *e  // entry to insert
+) {
+	int slots[RANGE_MAX_DEPTH];
+	RangeInner *path[RANGE_MAX_DEPTH];
+	int depth = 0;
+
+	RangeNode *n = ri->root;
+	while(!n->leaf) {
+		ASSERT(depth < RANGE_MAX_DEPTH);
+		RangeInner *in = (RangeInner *)n;
+		int c = _RangeInner_Child(in, e, _RangeEntry_Compare, true);
+		path[depth]  = in;
+		slots[depth] = c;
+		depth++;
+		n = in->children[c];
+	}
+
+	RangeLeaf *leaf = (RangeLeaf *)n;
+	int pos = _RangeLeaf_Pos(leaf, e, _RangeEntry_Compare, false);
+
+	ri->entry_count++;
+	ri->version++;
+
+	if(leaf->hdr.count < RANGE_NODE_CAP) {
+		_RangeLeaf_InsertAt(leaf, pos, e);
+		return;
+	}
+
+	//--------------------------------------------------------------------------
+	// split leaf
+	//--------------------------------------------------------------------------
+
+	int half = RANGE_NODE_CAP / 2;
+	RangeLeaf *right = _RangeLeaf_New(ri);
+
+	memcpy(right->entries, leaf->entries + half,
+			sizeof(RangeEntry) * (RANGE_NODE_CAP - half));
+	right->hdr.count = RANGE_NODE_CAP - half;
+	leaf->hdr.count  = half;
+
+	right->prev = leaf;
+	right->next = leaf->next;
+	if(leaf->next != NULL) leaf->next->prev = right;
+	leaf->next = right;
+
+	if(pos <= half) _RangeLeaf_InsertAt(leaf, pos, e);
+	else _RangeLeaf_InsertAt(right, pos - half, e);
+
+	RangeEntry sep;
+	RangeNode *child = (RangeNode *)right;
+	_RangeIndex_SepCopy(ri, &sep, right->entries);
+
+	//--------------------------------------------------------------------------
+	// propagate split upwards
+	//--------------------------------------------------------------------------
+
+	while(depth > 0) {
+		depth--;
+		RangeInner *p = path[depth];
+		int at = slots[depth] + 1;
+
+		if(p->hdr.count < RANGE_NODE_CAP) {
+			_RangeInner_InsertAt(p, at, &sep, child);
+			return;
+		}
+
+		// split inner node
+		int total = RANGE_NODE_CAP + 1;
+		RangeEntry seps[RANGE_NODE_CAP + 1];
+		RangeNode *children[RANGE_NODE_CAP + 1];
+
+		memcpy(seps, p->seps, sizeof(RangeEntry) * at);
+		memcpy(children, p->children, sizeof(RangeNode *) * at);
+		seps[at]     = sep;
+		children[at] = child;
+		memcpy(seps + at + 1, p->seps + at,
+				sizeof(RangeEntry) * (RANGE_NODE_CAP - at));
+		memcpy(children + at + 1, p->children + at,
+				sizeof(RangeNode *) * (RANGE_NODE_CAP - at));
+
+		half = total / 2;
+		RangeInner *r = _RangeInner_New(ri);
+
+		memcpy(p->seps, seps, sizeof(RangeEntry) * half);
+		memcpy(p->children, children, sizeof(RangeNode *) * half);
+		p->hdr.count = half;
+
+		memcpy(r->seps, seps + half, sizeof(RangeEntry) * (total - half));
+		memcpy(r->children, children + half,
+				sizeof(RangeNode *) * (total - half));
+		r->hdr.count = total - half;
+
+		// right node's first separator moves up a level
+		sep   = r->seps[0];
+		child = (RangeNode *)r;
+	}
+
+	// split root
+	RangeInner *root = _RangeInner_New(ri);
+	root->children[0] = ri->root;
+	root->children[1] = child;
+	root->seps[1]     = sep;
+	root->hdr.count   = 2;
+	ri->root = (RangeNode *)root;
+}
+
+// remove entry from tree
+// nodes are not rebalanced, empty nodes are removed from their parent
+static void _RangeIndex_Delete
+(
+	RangeIndex *ri,      // range index
+	const RangeEntry *e  // entry to remove
+) {
+	int slots[RANGE_MAX_DEPTH];
+	RangeInner *path[RANGE_MAX_DEPTH];
+	int depth = 0;
+
+	RangeNode *n = ri->root;
+	while(!n->leaf) {
+		RangeInner *in = (RangeInner *)n;
+		int c = _RangeInner_Child(in, e, _RangeEntry_Compare, true);
+		path[depth]  = in;
+		slots[depth] = c;
+		depth++;
+		n = in->children[c];
+	}
+
+	RangeLeaf *leaf = (RangeLeaf *)n;
+	int pos = _RangeLeaf_Pos(leaf, e, _RangeEntry_Compare, false);
+	ASSERT(pos < leaf->hdr.count);
+	ASSERT(_RangeEntry_Compare(leaf->entries + pos, e) == 0);
+
+	memmove(leaf->entries + pos, leaf->entries + pos + 1,
+			sizeof(RangeEntry) * (leaf->hdr.count - pos - 1));
+	leaf->hdr.count--;
+
+	ri->entry_count--;
+	ri->version++;
+
+	if(leaf->hdr.count > 0 || depth == 0) return;
+
+	//--------------------------------------------------------------------------
+	// remove empty leaf and empty ancestors
+	//--------------------------------------------------------------------------
+
+	if(leaf->prev != NULL) leaf->prev->next = leaf->next;
+	if(leaf->next != NULL) leaf->next->prev = leaf->prev;
+	_RangeNode_Free(ri, (RangeNode *)leaf);
+
+	while(depth > 0) {
+		depth--;
+		RangeInner *p = path[depth];
+		_RangeInner_RemoveAt(ri, p, slots[depth]);
+		if(p->hdr.count > 0) break;
+		_RangeNode_Free(ri, (RangeNode *)p);
+	}
+
+	// collapse root while it has a single child
+	while(!ri->root->leaf && ri->root->count == 1) {
+		RangeInner *root = (RangeInner *)ri->root;
+		ri->root = root->children[0];
+		_RangeNode_Free(ri, (RangeNode *)root);
+	}
+}
+
+// build tree out of sorted entries
+static void _RangeIndex_BulkLoad
+(
+	RangeIndex *ri,     // range index with an empty tree
+	RangeEntry *entries,  // sorted entries
+	uint64_t n            // number of entries
+) {
+	ASSERT(ri->root->leaf && ri->root->count == 0);
+
+	if(n == 0) return;
+
+	_RangeNode_Free(ri, ri->root);
+
+	uint64_t level_count = (n + RANGE_NODE_FILL - 1) / RANGE_NODE_FILL;
+	RangeNode **level = rm_malloc(sizeof(RangeNode *) * level_count);
+	const RangeEntry **mins = rm_malloc(sizeof(RangeEntry *) * level_count);
+
+	// fill leaves
+	RangeLeaf *prev = NULL;
+	for(uint64_t i = 0; i < level_count; i++) {
+		uint64_t offset = i * RANGE_NODE_FILL;
+		uint64_t count  = n - offset;
+		if(count > RANGE_NODE_FILL) count = RANGE_NODE_FILL;
+
+		RangeLeaf *l = _RangeLeaf_New(ri);
+		memcpy(l->entries, entries + offset, sizeof(RangeEntry) * count);
+		l->hdr.count = count;
+
+		l->prev = prev;
+		if(prev != NULL) prev->next = l;
+		prev = l;
+
+		level[i] = (RangeNode *)l;
+		mins[i]  = l->entries;
+	}
+
+	// build inner levels bottom up
+	while(level_count > 1) {
+		uint64_t parent_count = (level_count + RANGE_NODE_FILL - 1) /
+			RANGE_NODE_FILL;
+
+		for(uint64_t i = 0; i < parent_count; i++) {
+			uint64_t offset = i * RANGE_NODE_FILL;
+			uint64_t count  = level_count - offset;
+			if(count > RANGE_NODE_FILL) count = RANGE_NODE_FILL;
+
+			RangeInner *in = _RangeInner_New(ri);
+			for(uint64_t j = 0; j < count; j++) {
+				in->children[j] = level[offset + j];
+				if(j > 0) _RangeIndex_SepCopy(ri, in->seps + j, mins[offset + j]);
+			}
+			in->hdr.count = count;
+
+			// offset >= i, entries below 'offset' were already consumed
+			level[i] = (RangeNode *)in;
+			mins[i]  = mins[offset];
+		}
+
+		level_count = parent_count;
+	}
+
+	ri->root        = level[0];
+	ri->entry_count = n;
+	ri->version++;
+
+	rm_free(level);
+	rm_free(mins);
+}
+
+//------------------------------------------------------------------------------
+// documents
+//------------------------------------------------------------------------------
+
+static inline size_t _RangeDoc_Size
+(
+	const RangeIndex *ri
+) {
+	return sizeof(RangeDoc) + sizeof(RangeKey) * ri->attr_count;
+}
+
+static inline RangeDoc *_RangeIndex_GetDoc
+(
+	const RangeIndex *ri,
+	EntityID id
+) {
+	return (id < ri->doc_cap) ? ri->docs[id] : NULL;
+}
+
+static RangeDoc *_RangeIndex_NewDoc
+(
+	RangeIndex *ri,
+	EntityID id,
+	EntityID src_id,
+	EntityID dest_id
+) {
+	// grow document slots
+	if(id >= ri->doc_cap) {
+		uint64_t cap = (ri->doc_cap > 0) ? ri->doc_cap : RANGE_DOCS_INITIAL_CAP;
+		while(cap <= id) cap *= 2;
+
+		ri->docs = rm_realloc(ri->docs, sizeof(RangeDoc *) * cap);
+		memset(ri->docs + ri->doc_cap, 0,
+				sizeof(RangeDoc *) * (cap - ri->doc_cap));
+		ri->memory += sizeof(RangeDoc *) * (cap - ri->doc_cap);
+		ri->doc_cap = cap;
+	}
+
+	RangeDoc *doc = rm_malloc(_RangeDoc_Size(ri));
+	doc->src_id  = src_id;
+	doc->dest_id = dest_id;
+	for(uint i = 0; i < ri->attr_count; i++) {
+		_RangeKey_Init(doc->keys + i, ri->attrs[i], SI_NullVal());
+	}
+
+	ri->docs[id] = doc;
+	ri->doc_count++;
+	ri->memory += _RangeDoc_Size(ri);
+
+	return doc;
+}
+
+// builds the tree entry of a document key
+static inline RangeEntry _RangeDoc_Entry
+(
+	const RangeDoc *doc,
+	const RangeKey *k,
+	EntityID id
+) {
+	return (RangeEntry) {
+		.key = *k, .id = id, .src_id = doc->src_id, .dest_id = doc->dest_id
+	};
+}
+
+//------------------------------------------------------------------------------
+// trigrams
+//------------------------------------------------------------------------------
+
+// postings key of the trigram starting at 's' under attribute 'attr'
+static inline uint64_t _TrigramKey
+(
+	Attribute_ID attr,  // indexed attribute
+	const char *s       // trigram
+) {
+	const unsigned char *u = (const unsigned char *)s;
+	return ((uint64_t)attr << 24) | (u[0] << 16) | (u[1] << 8) | u[2];
+}
+
+// spread trigram keys across hash table buckets
+static uint64_t _TrigramHash
+(
+	const void *key
+) {
+	uint64_t h = (uint64_t)key;
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	return h;
+}
+
+static void _TrigramPostingsFree
+(
+	dict *d,
+	void *postings
+) {
+	UNUSED(d);
+	Roaring_Free(postings);
+}
+
+// maps trigram key to the set of entities containing trigram
+static dictType _trigram_dt = {_TrigramHash, NULL, NULL, NULL, NULL,
+	_TrigramPostingsFree, NULL, NULL, NULL, NULL};
+
+// complete an ongoing rehash of the trigram postings
+// postings are looked up by readers holding the read lock only
+// a lookup performs a rehash step while rehashing, mutating the table
+// rehashing is therefore completed while the write lock is held
+static void _RangeIndex_TrigramsRehash
+(
+	RangeIndex *ri  // range index
+) {
+	while(HashTableRehash(ri->trigrams, 100));
+}
+
+// add entity to the postings of each trigram of key's string
+static void _RangeIndex_AddTrigrams
+(
+	RangeIndex *ri,     // range index
+	const RangeKey *k,  // indexed key
+	EntityID id         // entity ID
+) {
+	if(ri->trigrams == NULL || k->cls != RANGE_KEY_STRING) return;
+
+	size_t len = strlen(k->s);
+	for(size_t i = 0; i + RANGE_TRIGRAM_LEN <= len; i++) {
+		dictEntry *existing;
+		void *key = (void *)_TrigramKey(k->attr, k->s + i);
+		dictEntry *de = HashTableAddRaw(ri->trigrams, key, &existing);
+
+		Roaring *postings;
+		if(de != NULL) {
+			postings = Roaring_New();
+			HashTableSetVal(ri->trigrams, de, postings);
+		} else {
+			postings = HashTableGetVal(existing);
+			ri->memory -= Roaring_Memory(postings);
+		}
+
+		Roaring_Add(postings, id);
+		ri->memory += Roaring_Memory(postings);
+	}
+
+	_RangeIndex_TrigramsRehash(ri);
+}
+
+// remove entity from the postings of each trigram of key's string
+static void _RangeIndex_RemoveTrigrams
+(
+	RangeIndex *ri,     // range index
+	const RangeKey *k,  // indexed key
+	EntityID id         // entity ID
+) {
+	if(ri->trigrams == NULL || k->cls != RANGE_KEY_STRING) return;
+
+	size_t len = strlen(k->s);
+	for(size_t i = 0; i + RANGE_TRIGRAM_LEN <= len; i++) {
+		void *key = (void *)_TrigramKey(k->attr, k->s + i);
+
+		// repeated trigrams might have emptied their postings already
+		dictEntry *de = HashTableFind(ri->trigrams, key);
+		if(de == NULL) continue;
+
+		Roaring *postings = HashTableGetVal(de);
+		ri->memory -= Roaring_Memory(postings);
+		Roaring_Remove(postings, id);
+
+		if(Roaring_Cardinality(postings) == 0) {
+			HashTableDelete(ri->trigrams, key);
+		} else {
+			ri->memory += Roaring_Memory(postings);
+		}
+	}
+
+	_RangeIndex_TrigramsRehash(ri);
+}
+
+static int _Postings_Compare
+(
+	const void *a,
+	const void *b
+) {
+	uint64_t x = Roaring_Cardinality(*(const Roaring **)a);
+	uint64_t y = Roaring_Cardinality(*(const Roaring **)b);
+	return (x > y) - (x < y);
+}
+
+// intersect the postings of each trigram of 'substr', smallest first
+// returns NULL if 'substr' can't be resolved by trigram postings
+static Roaring *_RangeIndex_TrigramCandidates
+(
+	const RangeIndex *ri,  // range index
+	Attribute_ID attr,     // queried attribute
+	const char *substr     // substring
+) {
+	size_t len = strlen(substr);
+	if(ri->trigrams == NULL || len < RANGE_TRIGRAM_LEN) return NULL;
+
+	size_t n = len - RANGE_TRIGRAM_LEN + 1;
+	const Roaring **postings = rm_malloc(sizeof(Roaring *) * n);
+
+	for(size_t i = 0; i < n; i++) {
+		void *key = (void *)_TrigramKey(attr, substr + i);
+		postings[i] = HashTableFetchValue(ri->trigrams, key);
+
+		// trigram isn't contained in any indexed string
+		if(postings[i] == NULL) {
+			rm_free(postings);
+			return Roaring_New();
+		}
+	}
+
+	qsort(postings, n, sizeof(Roaring *), _Postings_Compare);
+
+	Roaring *candidates = Roaring_Clone(postings[0]);
+	for(size_t i = 1; i < n && Roaring_Cardinality(candidates) > 0; i++) {
+		Roaring_And(candidates, postings[i]);
+	}
+
+	rm_free(postings);
+	return candidates;
+}
+
+//------------------------------------------------------------------------------
+// range index
+//------------------------------------------------------------------------------
+
+// create a new staging range index over 'attrs'
+RangeIndex *RangeIndex_New
+(
+	const Attribute_ID *attrs,  // indexed attributes
+	uint attr_count             // number of indexed attributes
+) {
+	ASSERT(attrs != NULL || attr_count == 0);
+
+	RangeIndex *ri = rm_calloc(1, sizeof(RangeIndex));
+
+	ri->attr_count = attr_count;
+	ri->attrs      = rm_malloc(sizeof(Attribute_ID) * (attr_count + 1));
+	ri->staging    = true;
+	ri->memory     = sizeof(RangeIndex) + sizeof(Attribute_ID) * attr_count;
+	memcpy(ri->attrs, attrs, sizeof(Attribute_ID) * attr_count);
+
+	ri->root = (RangeNode *)_RangeLeaf_New(ri);
+
+	return ri;
+}
+
+// maintain trigram postings
+// must be called before any entity is indexed
+void RangeIndex_EnableTrigrams
+(
+	RangeIndex *ri  // range index
+) {
+	ASSERT(ri != NULL);
+	ASSERT(ri->doc_count == 0);
+
+	if(ri->trigrams == NULL) ri->trigrams = HashTableCreate(&_trigram_dt);
+}
+
+// returns true if index maintains trigram postings
+bool RangeIndex_HasTrigrams
+(
+	const RangeIndex *ri  // range index
+) {
+	ASSERT(ri != NULL);
+
+	return ri->trigrams != NULL;
+}
+
+// index entity, replacing its previously indexed values
+// entities without any of the indexed attributes are removed
+void RangeIndex_Index
+(
+	RangeIndex *ri,        // range index
+	const GraphEntity *e,  // entity to index
+	EntityID src_id,       // edge source node, INVALID_ENTITY_ID for nodes
+	EntityID dest_id       // edge destination node, INVALID_ENTITY_ID for nodes
+) {
+	ASSERT(ri != NULL);
+	ASSERT(e  != NULL);
+
+	EntityID id = ENTITY_GET_ID(e);
+	RangeKey keys[ri->attr_count];
+	bool indexed = false;
+
+	for(uint i = 0; i < ri->attr_count; i++) {
+		SIValue *v = GraphEntity_GetProperty(e, ri->attrs[i]);
+		SIValue val = (v == ATTRIBUTE_NOTFOUND) ? SI_NullVal() : *v;
+		_RangeKey_Init(keys + i, ri->attrs[i], val);
+		indexed |= (keys[i].cls != RANGE_KEY_NONE);
+	}
+
+	// entity doesn't possess any of the indexed attributes
+	if(!indexed) {
+		RangeIndex_Remove(ri, id);
+		return;
+	}
+
+	RangeDoc *doc = _RangeIndex_GetDoc(ri, id);
+
+	// entity ID reused by a different edge
+	if(doc != NULL && (doc->src_id != src_id || doc->dest_id != dest_id)) {
+		RangeIndex_Remove(ri, id);
+		doc = NULL;
+	}
+
+	if(doc == NULL) doc = _RangeIndex_NewDoc(ri, id, src_id, dest_id);
+
+	// update modified keys only
+	for(uint i = 0; i < ri->attr_count; i++) {
+		RangeKey *prev = doc->keys + i;
+		RangeKey *curr = keys + i;
+
+		if(prev->is_int == curr->is_int && _RangeKey_Compare(prev, curr) == 0) {
+			continue;
+		}
+
+		if(!ri->staging && prev->cls != RANGE_KEY_NONE) {
+			RangeEntry entry = _RangeDoc_Entry(doc, prev, id);
+			_RangeIndex_Delete(ri, &entry);
+		}
+
+		_RangeIndex_RemoveTrigrams(ri, prev, id);
+		_RangeKey_Free(ri, prev);
+		*prev = *curr;
+
+		if(prev->cls == RANGE_KEY_STRING) {
+			prev->s = rm_strdup(curr->s);
+			ri->memory += strlen(prev->s) + 1;
+			_RangeIndex_AddTrigrams(ri, prev, id);
+		}
+
+		if(!ri->staging && prev->cls != RANGE_KEY_NONE) {
+			RangeEntry entry = _RangeDoc_Entry(doc, prev, id);
+			_RangeIndex_Insert(ri, &entry);
+		}
+	}
+
+	ri->version++;
+}
+
+// index a batch of entities
+// when the tree is empty entries are staged and bulk loaded
+// instead of being inserted one by one
+void RangeIndex_IndexBatch
+(
+	RangeIndex *ri,              // range index
+	const GraphEntity **e,       // entities to index
+	const EntityID *src_ids,     // edges source nodes, NULL for nodes
+	const EntityID *dest_ids,    // edges destination nodes, NULL for nodes
+	uint64_t n                   // number of entities
+) {
+	ASSERT(ri != NULL);
+	ASSERT(e  != NULL || n == 0);
+	ASSERT((src_ids == NULL) == (dest_ids == NULL));
+
+	bool bulk = !ri->staging          &&
+	            n > 1                 &&
+	            ri->entry_count == 0  &&
+	            ri->root->leaf        &&
+	            ri->root->count == 0;
+
+	if(bulk) ri->staging = true;
+
+	for(uint64_t i = 0; i < n; i++) {
+		EntityID src  = (src_ids  != NULL) ? src_ids[i]  : INVALID_ENTITY_ID;
+		EntityID dest = (dest_ids != NULL) ? dest_ids[i] : INVALID_ENTITY_ID;
+		RangeIndex_Index(ri, e[i], src, dest);
+	}
+
+	if(bulk) RangeIndex_Flush(ri);
+}
+
+// remove entity from index
+void RangeIndex_Remove
+(
+	RangeIndex *ri,  // range index
+	EntityID id      // entity to remove
+) {
+	ASSERT(ri != NULL);
+
+	RangeDoc *doc = _RangeIndex_GetDoc(ri, id);
+	if(doc == NULL) return;
+
+	for(uint i = 0; i < ri->attr_count; i++) {
+		RangeKey *k = doc->keys + i;
+		if(k->cls == RANGE_KEY_NONE) continue;
+
+		if(!ri->staging) {
+			RangeEntry entry = _RangeDoc_Entry(doc, k, id);
+			_RangeIndex_Delete(ri, &entry);
+		}
+		_RangeIndex_RemoveTrigrams(ri, k, id);
+		_RangeKey_Free(ri, k);
+	}
+
+	rm_free(doc);
+	ri->docs[id] = NULL;
+	ri->doc_count--;
+	ri->memory -= _RangeDoc_Size(ri);
+	ri->version++;
+}
+
+// returns true if index is staging
+bool RangeIndex_Staging
+(
+	const RangeIndex *ri  // range index
+) {
+	ASSERT(ri != NULL);
+
+	return ri->staging;
+}
+
+// build tree out of staged documents
+void RangeIndex_Flush
+(
+	RangeIndex *ri  // range index
+) {
+	ASSERT(ri != NULL);
+	ASSERT(ri->staging);
+
+	// count entries
+	uint64_t n = 0;
+	for(uint64_t id = 0; id < ri->doc_cap; id++) {
+		RangeDoc *doc = ri->docs[id];
+		if(doc == NULL) continue;
+		for(uint i = 0; i < ri->attr_count; i++) {
+			n += (doc->keys[i].cls != RANGE_KEY_NONE);
+		}
+	}
+
+	// collect, sort and load entries
+	RangeEntry *entries = rm_malloc(sizeof(RangeEntry) * (n + 1));
+
+	n = 0;
+	for(uint64_t id = 0; id < ri->doc_cap; id++) {
+		RangeDoc *doc = ri->docs[id];
+		if(doc == NULL) continue;
+		for(uint i = 0; i < ri->attr_count; i++) {
+			if(doc->keys[i].cls == RANGE_KEY_NONE) continue;
+			entries[n++] = _RangeDoc_Entry(doc, doc->keys + i, id);
+		}
+	}
+
+	qsort(entries, n, sizeof(RangeEntry), _RangeEntry_QSortCompare);
+	_RangeIndex_BulkLoad(ri, entries, n);
+
+	rm_free(entries);
+	ri->staging = false;
+}
+
+// returns true if entity 'id' is indexed with value 'v' under 'attr'
+// none orderable values never match
+bool RangeIndex_HasValue
+(
+	const RangeIndex *ri,  // range index
+	EntityID id,           // entity ID
+	Attribute_ID attr,     // attribute
+	SIValue v              // value
+) {
+	ASSERT(ri != NULL);
+
+	RangeDoc *doc = _RangeIndex_GetDoc(ri, id);
+	if(doc == NULL) return false;
+
+	for(uint i = 0; i < ri->attr_count; i++) {
+		if(ri->attrs[i] != attr) continue;
+
+		RangeKey k;
+		_RangeKey_Init(&k, attr, v);
+		if(k.cls == RANGE_KEY_NONE || k.cls == RANGE_KEY_OTHER) return false;
+
+		return _RangeKey_Compare(doc->keys + i, &k) == 0;
+	}
+
+	return false;
+}
+
+// returns number of indexed entities
+uint64_t RangeIndex_DocCount
+(
+	const RangeIndex *ri  // range index
+) {
+	ASSERT(ri != NULL);
+
+	return ri->doc_count;
+}
+
+// returns number of entries in tree
+uint64_t RangeIndex_EntryCount
+(
+	const RangeIndex *ri  // range index
+) {
+	ASSERT(ri != NULL);
+
+	return ri->entry_count;
+}
+
+// returns number of bytes used by index
+size_t RangeIndex_Memory
+(
+	const RangeIndex *ri  // range index
+) {
+	ASSERT(ri != NULL);
+
+	size_t memory = ri->memory;
+	if(ri->trigrams != NULL) memory += HashTableMemUsage(ri->trigrams);
+
+	return memory;
+}
+
+// free range index
+void RangeIndex_Free
+(
+	RangeIndex *ri  // range index to free
+) {
+	if(ri == NULL) return;
+
+	_RangeNode_FreeTree(ri, ri->root);
+
+	for(uint64_t id = 0; id < ri->doc_cap; id++) {
+		RangeDoc *doc = ri->docs[id];
+		if(doc == NULL) continue;
+		for(uint i = 0; i < ri->attr_count; i++) {
+			_RangeKey_Free(ri, doc->keys + i);
+		}
+		rm_free(doc);
+	}
+
+	if(ri->docs     != NULL) rm_free(ri->docs);
+	if(ri->trigrams != NULL) HashTableRelease(ri->trigrams);
+	rm_free(ri->attrs);
+	rm_free(ri);
+}
+
+//------------------------------------------------------------------------------
+// query
+//------------------------------------------------------------------------------
+
+// create an empty query, matching nothing
+RangeQuery *RangeQuery_New(void) {
+	RangeQuery *q = rm_malloc(sizeof(RangeQuery));
+
+	q->all     = false;
+	q->ranges  = array_new(RangeIndexRange, 1);
+	q->src_id  = INVALID_ENTITY_ID;
+	q->dest_id = INVALID_ENTITY_ID;
+
+	return q;
+}
+
+// add range to query
+// the query takes ownership of range bounds
+void RangeQuery_AddRange
+(
+	RangeQuery *q,                // query
+	const RangeIndexRange *range  // range to add
+) {
+	ASSERT(q     != NULL);
+	ASSERT(range != NULL);
+	ASSERT(range->cls != RANGE_KEY_NONE);
+
+	array_append(q->ranges, *range);
+}
+
+// free query
+void RangeQuery_Free
+(
+	RangeQuery *q  // query to free
+) {
+	if(q == NULL) return;
+
+	uint n = array_len(q->ranges);
+	for(uint i = 0; i < n; i++) {
+		SIValue_Free(q->ranges[i].min);
+		SIValue_Free(q->ranges[i].max);
+		if(q->ranges[i].substr != NULL) rm_free(q->ranges[i].substr);
+	}
+
+	array_free(q->ranges);
+	rm_free(q);
+}
+
+//------------------------------------------------------------------------------
+// iterator
+//------------------------------------------------------------------------------
+
+typedef enum {
+	RANGE_ITER_EMPTY,   // matches nothing
+	RANGE_ITER_ALL,     // scans documents
+	RANGE_ITER_CURSOR,  // scans a single range
+	RANGE_ITER_UNION,   // materialized union of ranges and substring ranges
+} RangeIterMode;
+
+// tree bounds of a single range
+typedef struct {
+	RangeEntry lo;      // lower bound
+	RangeEntry hi;      // upper bound
+	RangeCmp lo_cmp;    // compares entries against lower bound
+	RangeCmp hi_cmp;    // compares entries against upper bound
+	bool lo_after;      // skip entries equal to lower bound
+	bool hi_inclusive;  // include entries equal to upper bound
+} RangeBounds;
+
+typedef struct {
+	EntityID id;       // entity ID
+	EntityID src_id;   // edge source node
+	EntityID dest_id;  // edge destination node
+} RangeResult;
+
+struct RangeIndexIterator {
+	RangeIndex *ri;          // queried index
+	RangeQuery *q;           // query
+	RangeIterMode mode;      // iteration mode
+	RangeBounds bounds;      // bounds of a single range query
+	RangeResult *results;    // materialized union results
+	uint64_t pos;            // position within results or documents
+	RangeLeaf *leaf;         // cursor leaf, NULL once depleted
+	int leaf_pos;            // cursor position within leaf
+	uint64_t version;        // index version the cursor is valid for
+	RangeEntry last;         // last entry produced by cursor
+	char *last_str;          // copy of last produced string
+	size_t last_str_cap;     // size of last_str
+	bool started;            // iteration started
+	bool produced;           // cursor produced at least one entry
+};
+
+// bound key, point ranges are bounded by latitude
+static void _RangeBounds_Key
+(
+	RangeKey *k,                   // key to initialize
+	const RangeIndexRange *range,  // range
+	SIValue v,                     // bound
+	bool lower                     // lower or upper bound
+) {
+	if(range->cls == RANGE_KEY_POINT) {
+		_RangeKey_Init(k, range->attr, SI_NullVal());
+		k->cls   = RANGE_KEY_POINT;
+		k->p.lat = SI_GET_NUMERIC(v);
+		k->p.lon = lower ? -INFINITY : INFINITY;
+	} else {
+		_RangeKey_Init(k, range->attr, v);
+		ASSERT(k->cls == range->cls);
+	}
+}
+
+static void _RangeBounds_Init
+(
+	RangeBounds *b,               // bounds to initialize
+	const RangeIndexRange *range  // range
+) {
+	memset(b, 0, sizeof(RangeBounds));
+
+	b->lo.key.attr = range->attr;
+	b->lo.key.cls  = range->cls;
+	b->hi.key.attr = range->attr;
+	b->hi.key.cls  = range->cls;
+
+	if(SI_TYPE(range->min) == T_NULL) {
+		b->lo_cmp   = _RangeEntry_CompareClass;
+		b->lo_after = false;
+	} else {
+		_RangeBounds_Key(&b->lo.key, range, range->min, true);
+		b->lo_cmp   = _RangeEntry_CompareValue;
+		b->lo_after = !range->include_min;
+	}
+
+	if(SI_TYPE(range->max) == T_NULL) {
+		b->hi_cmp       = _RangeEntry_CompareClass;
+		b->hi_inclusive = true;
+	} else {
+		_RangeBounds_Key(&b->hi.key, range, range->max, false);
+		b->hi_cmp       = _RangeEntry_CompareValue;
+		b->hi_inclusive = range->include_max;
+	}
+}
+
+static inline bool _RangeBounds_Within
+(
+	const RangeBounds *b,
+	const RangeEntry *e
+) {
+	int c = b->hi_cmp(e, &b->hi);
+	return c < 0 || (c == 0 && b->hi_inclusive);
+}
+
+// collect candidates within substring range
+static void _RangeIndex_CollectCandidates
+(
+	const RangeIndex *ri,          // range index
+	const RangeIndexRange *range,  // substring range
+	const RangeBounds *b,          // range bounds
+	const Roaring *candidates,     // entities possibly within range
+	RangeResult **results          // [output] results
+) {
+	uint a = 0;
+	while(a < ri->attr_count && ri->attrs[a] != range->attr) a++;
+	if(a == ri->attr_count) return;
+
+	uint64_t id;
+	RoaringIterator it;
+	RoaringIterator_Init(&it, candidates);
+
+	while(RoaringIterator_Next(&it, &id)) {
+		const RangeDoc *doc = _RangeIndex_GetDoc(ri, id);
+		ASSERT(doc != NULL);
+
+		const RangeKey *k = doc->keys + a;
+		if(k->cls != RANGE_KEY_STRING) continue;
+
+		// verify bounds and substring, trigrams might not be adjacent
+		RangeEntry e = _RangeDoc_Entry(doc, k, id);
+		int c = b->lo_cmp(&e, &b->lo);
+		if(c < 0 || (c == 0 && b->lo_after)) continue;
+		if(!_RangeBounds_Within(b, &e)) continue;
+		if(strstr(k->s, range->substr) == NULL) continue;
+
+		RangeResult r = {id, doc->src_id, doc->dest_id};
+		array_append(*results, r);
+	}
+}
+
+// collect all entries within range
+// substring ranges are resolved by trigram postings when possible
+// otherwise every string within bounds is verified
+static void _RangeIndex_Collect
+(
+	const RangeIndex *ri,          // range index
+	const RangeIndexRange *range,  // range to scan
+	RangeResult **results          // [output] results
+) {
+	int pos;
+	RangeLeaf *leaf;
+	RangeBounds b;
+	const char *substr = range->substr;
+
+	_RangeBounds_Init(&b, range);
+
+	if(substr != NULL) {
+		Roaring *candidates =
+			_RangeIndex_TrigramCandidates(ri, range->attr, substr);
+		if(candidates != NULL) {
+			_RangeIndex_CollectCandidates(ri, range, &b, candidates, results);
+			Roaring_Free(candidates);
+			return;
+		}
+	}
+
+	_RangeIndex_Seek(ri, &b.lo, b.lo_cmp, b.lo_after, &leaf, &pos);
+
+	for(; leaf != NULL; leaf = leaf->next, pos = 0) {
+		for(; pos < leaf->hdr.count; pos++) {
+			const RangeEntry *e = leaf->entries + pos;
+			if(!_RangeBounds_Within(&b, e)) return;
+			if(substr != NULL && strstr(e->key.s, substr) == NULL) continue;
+
+			RangeResult r = {e->id, e->src_id, e->dest_id};
+			array_append(*results, r);
+		}
+	}
+}
+
+static int _RangeResult_Compare
+(
+	const void *a,
+	const void *b
+) {
+	const RangeResult *x = a;
+	const RangeResult *y = b;
+
+	if(x->id != y->id) return CMP(x->id, y->id);
+	if(x->src_id != y->src_id) return CMP(x->src_id, y->src_id);
+	return CMP(x->dest_id, y->dest_id);
+}
+
+// materialize union of ranges, sorted by entity ID without duplicates
+static void _RangeIndexIterator_Materialize
+(
+	RangeIndexIterator *it
+) {
+	if(it->results == NULL) it->results = array_new(RangeResult, 32);
+	array_clear(it->results);
+
+	uint n = array_len(it->q->ranges);
+	for(uint i = 0; i < n; i++) {
+		_RangeIndex_Collect(it->ri, it->q->ranges + i, &it->results);
+	}
+
+	uint count = array_len(it->results);
+	if(count == 0) return;
+
+	qsort(it->results, count, sizeof(RangeResult), _RangeResult_Compare);
+
+	// remove duplicates
+	uint j = 0;
+	for(uint i = 1; i < count; i++) {
+		if(_RangeResult_Compare(it->results + i, it->results + j) != 0) {
+			it->results[++j] = it->results[i];
+		}
+	}
+	it->results = array_trimm_len(it->results, j + 1);
+}
+
+// remember last produced entry, used to reposition cursor
+// in case the index is modified
+static void _RangeIndexIterator_SetLast
+(
+	RangeIndexIterator *it,
+	const RangeEntry *e
+) {
+	it->last     = *e;
+	it->produced = true;
+
+	if(e->key.cls == RANGE_KEY_STRING) {
+		size_t len = strlen(e->key.s) + 1;
+		if(len > it->last_str_cap) {
+			it->last_str     = rm_realloc(it->last_str, len);
+			it->last_str_cap = len;
+		}
+		memcpy(it->last_str, e->key.s, len);
+		it->last.key.s = it->last_str;
+	}
+}
+
+static bool _RangeIndexIterator_CursorNext
+(
+	RangeIndexIterator *it,
+	RangeEntry *e
+) {
+	RangeIndex *ri = it->ri;
+	const RangeBounds *b = &it->bounds;
+
+	if(!it->started) {
+		_RangeIndex_Seek(ri, &b->lo, b->lo_cmp, b->lo_after, &it->leaf,
+				&it->leaf_pos);
+		it->started = true;
+		it->version = ri->version;
+	} else if(it->leaf != NULL && it->version != ri->version) {
+		// index modified, reposition after last produced entry
+		if(it->produced) {
+			_RangeIndex_Seek(ri, &it->last, _RangeEntry_Compare, true,
+					&it->leaf, &it->leaf_pos);
+		} else {
+			_RangeIndex_Seek(ri, &b->lo, b->lo_cmp, b->lo_after, &it->leaf,
+					&it->leaf_pos);
+		}
+		it->version = ri->version;
+	}
+
+	while(it->leaf != NULL) {
+		if(it->leaf_pos >= it->leaf->hdr.count) {
+			it->leaf     = it->leaf->next;
+			it->leaf_pos = 0;
+			continue;
+		}
+
+		const RangeEntry *current = it->leaf->entries + it->leaf_pos;
+		if(!_RangeBounds_Within(b, current)) {
+			it->leaf = NULL;
+			break;
+		}
+
+		it->leaf_pos++;
+		_RangeIndexIterator_SetLast(it, current);
+		*e = *current;
+		return true;
+	}
+
+	return false;
+}
+
+// create an iterator over the entities matching query 'q'
+// the iterator takes ownership of the query
+// each matching entity is produced exactly once
+// the index may be modified while the iterator is alive
+// a staging index can only be scanned entirely
+RangeIndexIterator *RangeIndex_Query
+(
+	RangeIndex *ri,  // range index
+	RangeQuery *q    // query
+) {
+	ASSERT(ri != NULL);
+	ASSERT(q  != NULL);
+	ASSERT(!ri->staging || q->all);
+
+	RangeIndexIterator *it = rm_calloc(1, sizeof(RangeIndexIterator));
+
+	it->ri = ri;
+	it->q  = q;
+
+	uint n = array_len(q->ranges);
+	if(q->all) {
+		it->mode = RANGE_ITER_ALL;
+	} else if(n == 0) {
+		it->mode = RANGE_ITER_EMPTY;
+	} else if(n == 1 && q->ranges[0].substr == NULL) {
+		// a single range never produces the same entity twice
+		it->mode = RANGE_ITER_CURSOR;
+		_RangeBounds_Init(&it->bounds, q->ranges);
+	} else {
+		it->mode = RANGE_ITER_UNION;
+	}
+
+	return it;
+}
+
+// advance iterator, returns false once depleted
+bool RangeIndexIterator_Next
+(
+	RangeIndexIterator *it,  // iterator
+	EntityID *id,            // [output] entity ID
+	EntityID *src_id,        // [optional output] edge source node
+	EntityID *dest_id        // [optional output] edge destination node
+) {
+	ASSERT(it != NULL);
+	ASSERT(id != NULL);
+
+	RangeIndex *ri = it->ri;
+	const RangeQuery *q = it->q;
+	RangeResult r;
+
+	while(true) {
+		switch(it->mode) {
+			case RANGE_ITER_EMPTY:
+				return false;
+
+			case RANGE_ITER_ALL: {
+				RangeDoc *doc = NULL;
+				while(doc == NULL && it->pos < ri->doc_cap) {
+					r.id = it->pos++;
+					doc = ri->docs[r.id];
+				}
+				if(doc == NULL) return false;
+				r.src_id  = doc->src_id;
+				r.dest_id = doc->dest_id;
+				break;
+			}
+
+			case RANGE_ITER_CURSOR: {
+				RangeEntry e;
+				if(!_RangeIndexIterator_CursorNext(it, &e)) return false;
+				r.id      = e.id;
+				r.src_id  = e.src_id;
+				r.dest_id = e.dest_id;
+				break;
+			}
+
+			case RANGE_ITER_UNION:
+				if(!it->started) {
+					_RangeIndexIterator_Materialize(it);
+					it->started = true;
+				}
+				if(it->pos >= array_len(it->results)) return false;
+				r = it->results[it->pos++];
+				break;
+
+			default:
+				ASSERT(false && "unknown iterator mode");
+				return false;
+		}
+
+		// edge endpoints constraints
+		if(q->src_id  != INVALID_ENTITY_ID && r.src_id  != q->src_id)  continue;
+		if(q->dest_id != INVALID_ENTITY_ID && r.dest_id != q->dest_id) continue;
+
+		*id = r.id;
+		if(src_id  != NULL) *src_id  = r.src_id;
+		if(dest_id != NULL) *dest_id = r.dest_id;
+		return true;
+	}
+}
+
+// restart iterator
+void RangeIndexIterator_Reset
+(
+	RangeIndexIterator *it  // iterator
+) {
+	ASSERT(it != NULL);
+
+	it->pos      = 0;
+	it->leaf     = NULL;
+	it->started  = false;
+	it->produced = false;
+}
+
+// free iterator
+void RangeIndexIterator_Free
+(
+	RangeIndexIterator *it  // iterator to free
+) {
+	if(it == NULL) return;
+
+	RangeQuery_Free(it->q);
+	if(it->results  != NULL) array_free(it->results);
+	if(it->last_str != NULL) rm_free(it->last_str);
+
+	rm_free(it);
+}
+
@@ -0,0 +1,224 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "../value.h"
+#include "../graph/entities/graph_entity.h"
+#include "../graph/entities/attribute_set.h"
+
+#include <stdint.h>
+
+// in-memory ordered index backing exact-match indexes
+//
+// entries are kept in a B+tree ordered by:
+// (attribute, value class, value, entity ID, source ID, destination ID)
+// values of different classes never compare against each other
+// e.g. the boolean true and the integer 1 are distinct keys
+//
+// each indexed entity also has a document holding its currently indexed
+// values, documents are used to remove stale entries when an entity is
+// updated or deleted
+//
+// a newly created index is "staging", while staging only documents are
+// maintained, once populated the index is flushed, at which point all
+// entries are sorted and bulk loaded into the tree
+//
+// optionally the index maintains trigram postings, for each attribute and
+// each three consecutive bytes of an indexed string, the set of entities
+// whose string contains them, substring ranges intersect the postings of
+// their substring's trigrams to locate candidate entities
+
+// number of bytes in a trigram
+#define RANGE_TRIGRAM_LEN 3
+
+// class of indexed values, determines order between value types
+typedef enum {
+	RANGE_KEY_NONE    = 0,  // attribute missing
+	RANGE_KEY_BOOL    = 1,  // boolean
+	RANGE_KEY_NUMERIC = 2,  // integer or double
+	RANGE_KEY_STRING  = 3,  // string
+	RANGE_KEY_POINT   = 4,  // point, ordered by latitude then longitude
+	RANGE_KEY_OTHER   = 5,  // none orderable value e.g. array, NaN
+} RangeKeyClass;
+
+// range of values of a single attribute
+// string bounds and substring are owned by the range
+// point ranges are bounded by latitude, bounds are numeric
+// a substring range only matches strings containing its substring
+typedef struct {
+	Attribute_ID attr;  // queried attribute
+	RangeKeyClass cls;  // class of values within range
+	SIValue min;        // lower bound, NULL if unbounded
+	SIValue max;        // upper bound, NULL if unbounded
+	bool include_min;   // lower bound is inclusive
+	bool include_max;   // upper bound is inclusive
+	char *substr;       // [optional] substring of matching strings
+} RangeIndexRange;
+
+// index query, the union of a number of ranges
+typedef struct {
+	RangeIndexRange *ranges;  // ranges to scan
+	bool all;                 // scan every indexed entity, ignores ranges
+	EntityID src_id;          // required source node, INVALID_ENTITY_ID if any
+	EntityID dest_id;         // required destination node, INVALID_ENTITY_ID if any
+} RangeQuery;
+
+typedef struct RangeIndex RangeIndex;
+typedef struct RangeIndexIterator RangeIndexIterator;
+
+// returns the class of value 'v'
+RangeKeyClass RangeKey_Class
+(
+	SIValue v  // value to classify
+);
+
+// create a new staging range index over 'attrs'
+RangeIndex *RangeIndex_New
+(
+	const Attribute_ID *attrs,  // indexed attributes
+	uint attr_count             // number of indexed attributes
+);
+
+// maintain trigram postings
+// must be called before any entity is indexed
+void RangeIndex_EnableTrigrams
+(
+	RangeIndex *ri  // range index
+);
+
+// returns true if index maintains trigram postings
+bool RangeIndex_HasTrigrams
+(
+	const RangeIndex *ri  // range index
+);
+
+// index entity, replacing its previously indexed values
+// entities without any of the indexed attributes are removed
+void RangeIndex_Index
+(
+	RangeIndex *ri,        // range index
+	const GraphEntity *e,  // entity to index
+	EntityID src_id,       // edge source node, INVALID_ENTITY_ID for nodes
+	EntityID dest_id       // edge destination node, INVALID_ENTITY_ID for nodes
+);
+
+// index a batch of entities
+// bulk loads the tree when it is empty
+void RangeIndex_IndexBatch
+(
+	RangeIndex *ri,              // range index
+	const GraphEntity **e,       // entities to index
+	const EntityID *src_ids,     // edges source nodes, NULL for nodes
+	const EntityID *dest_ids,    // edges destination nodes, NULL for nodes
+	uint64_t n                   // number of entities
+);
+
+// remove entity from index
+void RangeIndex_Remove
+(
+	RangeIndex *ri,  // range index
+	EntityID id      // entity to remove
+);
+
+// returns true if index is staging
+bool RangeIndex_Staging
+(
+	const RangeIndex *ri  // range index
+);
+
+// build tree out of staged documents
+void RangeIndex_Flush
+(
+	RangeIndex *ri  // range index
+);
+
+// returns true if entity 'id' is indexed with value 'v' under 'attr'
+bool RangeIndex_HasValue
+(
+	const RangeIndex *ri,  // range index
+	EntityID id,           // entity ID
+	Attribute_ID attr,     // attribute
+	SIValue v              // value
+);
+
+// returns number of indexed entities
+uint64_t RangeIndex_DocCount
+(
+	const RangeIndex *ri  // range index
+);
+
+// returns number of entries in tree
+uint64_t RangeIndex_EntryCount
+(
+	const RangeIndex *ri  // range index
+);
+
+// returns number of bytes used by index
+size_t RangeIndex_Memory
+(
+	const RangeIndex *ri  // range index
+);
+
+// free range index
+void RangeIndex_Free
+(
+	RangeIndex *ri  // range index to free
+);
+
+//------------------------------------------------------------------------------
+// query
+//------------------------------------------------------------------------------
+
+// create an empty query, matching nothing
+RangeQuery *RangeQuery_New(void);
+
+// add range to query
+// the query takes ownership of range bounds and substring
+void RangeQuery_AddRange
+(
+	RangeQuery *q,                // query
+	const RangeIndexRange *range  // range to add
+);
+
+// free query
+void RangeQuery_Free
+(
+	RangeQuery *q  // query to free
+);
+
+// create an iterator over the entities matching query 'q'
+// the iterator takes ownership of the query
+// each matching entity is produced exactly once
+// the index may be modified while the iterator is alive
+// a staging index can only be scanned entirely
+RangeIndexIterator *RangeIndex_Query
+(
+	RangeIndex *ri,  // range index
+	RangeQuery *q    // query
+);
+
+// advance iterator, returns false once depleted
+bool RangeIndexIterator_Next
+(
+	RangeIndexIterator *it,  // iterator
+	EntityID *id,            // [output] entity ID
+	EntityID *src_id,        // [optional output] edge source node
+	EntityID *dest_id        // [optional output] edge destination node
+);
+
+// restart iterator
+void RangeIndexIterator_Reset
+(
+	RangeIndexIterator *it  // iterator
+);
+
+// free iterator
+void RangeIndexIterator_Free
+(
+	RangeIndexIterator *it  // iterator to free
+);
+
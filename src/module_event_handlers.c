@@ -17,6 +17,7 @@
 #include "configuration/config.h"
 #include "serializers/graphmeta_type.h"
 #include "serializers/graphcontext_type.h"
+#include "serializers/graph_extensions.h"
 
 // indicates the possibility of half-baked graphs in the keyspace
 #define INTERMEDIATE_GRAPHS (aux_field_counter > 0)
@@ -101,8 +102,10 @@ static uint64_t _GraphContext_RequiredMetaKeys(const GraphContext *gc) {
 	Config_Option_get(Config_VKEY_MAX_ENTITY_COUNT, &vkey_entity_count);
 	gc->encoding_context->vkey_entity_count = vkey_entity_count;
 
+	// matrix entries are encoded alongside the graph entities
 	uint64_t entities_count = Graph_NodeCount(gc->g) + Graph_EdgeCount(gc->g) +
-		Graph_DeletedNodeCount(gc->g) + Graph_DeletedEdgeCount(gc->g);
+		Graph_DeletedNodeCount(gc->g) + Graph_DeletedEdgeCount(gc->g) +
+		Serializer_Graph_MatrixEntryCount(gc->g);
 
 	if(entities_count == 0) return 0;
 
@@ -252,7 +252,19 @@ static bool _EmitIndex
 	// index info
 	//--------------------------------------------------------------------------
 
-	if(ctx->yield_info) {
+	if(ctx->yield_info && Index_Type(idx) == IDX_EXACT_MATCH) {
+		RangeIndex *ri = Index_RangeIndex(idx);
+		SIValue map = SI_Map(3);
+
+		Map_Add(&map, SI_ConstStringVal("numDocuments"),
+				SI_LongVal(RangeIndex_DocCount(ri)));
+		Map_Add(&map, SI_ConstStringVal("numRecords"),
+				SI_LongVal(RangeIndex_EntryCount(ri)));
+		Map_Add(&map, SI_ConstStringVal("memory"),
+				SI_LongVal(RangeIndex_Memory(ri)));
+
+		*ctx->yield_info = map;
+	} else if(ctx->yield_info) {
 		RSIdxInfo info = { .version = RS_INFO_CURRENT_VERSION };
 
 		RSIndex *rsIdx = Index_RSIndex(idx);
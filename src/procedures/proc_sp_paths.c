@@ -11,6 +11,7 @@
 #include "../query_ctx.h"
 #include "../util/rmalloc.h"
 #include "../errors/errors.h"
+#include "../graph/csr/csr.h"
 #include "../graph/graphcontext.h"
 #include "../datatypes/datatypes.h"
 
@@ -45,6 +46,8 @@ typedef struct {
 	Edge *neighbors;             // reusable buffer of edges along the current path.
 	int *relationIDs;            // edge type(s) to traverse.
 	int relationCount;           // length of relationIDs.
+	CSR **outgoing;              // outgoing adjacency of each relation, built on first use.
+	CSR **incoming;              // incoming adjacency of each relation, built on first use.
 	GRAPH_EDGE_DIR dir;          // traverse direction.
 	uint minLen;                 // path minimum length.
 	uint maxLen;                 // path max length.
@@ -76,6 +79,12 @@ static void SinglePairCtx_Free
 	if(ctx->levels) array_free(ctx->levels);
 	if(ctx->path) Path_Free(ctx->path);
 	if(ctx->neighbors) array_free(ctx->neighbors);
+	for(int i = 0; ctx->outgoing && i < ctx->relationCount; i++) {
+		if(ctx->outgoing[i]) CSR_Free(ctx->outgoing[i]);
+		if(ctx->incoming[i]) CSR_Free(ctx->incoming[i]);
+	}
+	if(ctx->outgoing) rm_free(ctx->outgoing);
+	if(ctx->incoming) rm_free(ctx->incoming);
 	if(ctx->relationIDs) {
 		array_free(ctx->relationIDs);
 	}
@@ -170,6 +179,8 @@ static void SinglePairCtx_New
 	ctx->maxLen         =  maxLen + 1;
 	ctx->relationIDs    =  relationIDs;
 	ctx->relationCount  =  relationCount;
+	ctx->outgoing       =  rm_calloc(MAX(relationCount, 1), sizeof(CSR *));
+	ctx->incoming       =  rm_calloc(MAX(relationCount, 1), sizeof(CSR *));
 	ctx->levels         =  array_new(LevelConnection *, 1);
 	ctx->path           =  Path_New(1);
 	ctx->neighbors      =  array_new(Edge, 32);
@@ -326,6 +337,34 @@ static bool _SinglePairCtx_LevelNotEmpty
 	return (level < array_len(ctx->levels) && array_len(ctx->levels[level]) > 0);
 }
 
+// collect the edges of 'node' in direction 'dir' into ctx->neighbors
+// edges are read from the relations' CSR snapshots
+// while the write lock is held snapshots aren't cached
+// edges are read from the relation matrices instead
+static void _SinglePairCtx_CollectEdges
+(
+	SinglePairCtx *ctx,
+	const Node *node,
+	GRAPH_EDGE_DIR dir
+) {
+	if(Graph_WriteLocked(ctx->g)) {
+		for(int i = 0; i < ctx->relationCount; i++) {
+			Graph_GetNodeEdges(ctx->g, node, dir, ctx->relationIDs[i],
+					&ctx->neighbors);
+		}
+		return;
+	}
+
+	CSR **csrs = (dir == GRAPH_EDGE_DIR_OUTGOING) ? ctx->outgoing : ctx->incoming;
+	NodeID id = ENTITY_GET_ID(node);
+
+	for(int i = 0; i < ctx->relationCount; i++) {
+		if(ctx->relationIDs[i] == GRAPH_UNKNOWN_RELATION) continue;
+		if(csrs[i] == NULL) csrs[i] = Graph_GetCSR(ctx->g, ctx->relationIDs[i], dir);
+		CSR_GetNodeEdges(csrs[i], ctx->g, id, &ctx->neighbors);
+	}
+}
+
 static void addOutgoingNeighbors
 (
 	SinglePairCtx *ctx,
@@ -336,9 +375,7 @@ static void addOutgoingNeighbors
 	if(depth > 1) frontierId = ENTITY_GET_ID(&frontier->edge);
 
 	// Get frontier neighbors.
-	for(int i = 0; i < ctx->relationCount; i++) {
-		Graph_GetNodeEdges(ctx->g, &frontier->node, GRAPH_EDGE_DIR_OUTGOING, ctx->relationIDs[i], &ctx->neighbors);
-	}
+	_SinglePairCtx_CollectEdges(ctx, &frontier->node, GRAPH_EDGE_DIR_OUTGOING);
 
 	// Add unvisited neighbors to next level.
 	uint32_t neighborsCount = array_len(ctx->neighbors);
@@ -366,9 +403,7 @@ static void addIncomingNeighbors
 	if(depth > 1) frontierId = ENTITY_GET_ID(&frontier->edge);
 
 	// Get frontier neighbors.
-	for(int i = 0; i < ctx->relationCount; i++) {
-		Graph_GetNodeEdges(ctx->g, &frontier->node, GRAPH_EDGE_DIR_INCOMING, ctx->relationIDs[i], &ctx->neighbors);
-	}
+	_SinglePairCtx_CollectEdges(ctx, &frontier->node, GRAPH_EDGE_DIR_INCOMING);
 
 	// Add unvisited neighbors to next level.
 	uint32_t neighborsCount = array_len(ctx->neighbors);
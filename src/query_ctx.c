@@ -347,11 +347,19 @@ bool QueryCtx_LockForCommit(void) {
 	if(ctx->internal_exec_ctx.locked_for_commit) return true;
 
 	// lock GIL
+	// under group commit the locks are acquired once, by the first query
+	// of the group to commit
+	GroupCommit *group = ctx->internal_exec_ctx.group;
+	bool group_locked = group != NULL && group->locked;
 	RedisModuleCtx *redis_ctx = ctx->global_exec_ctx.redis_ctx;
 	GraphContext *gc = ctx->gc;
 	RedisModuleString *graphID = RedisModule_CreateString(redis_ctx, gc->graph_name,
 														  strlen(gc->graph_name));
-	_QueryCtx_ThreadSafeContextLock(ctx);
+	if(group == NULL) {
+		_QueryCtx_ThreadSafeContextLock(ctx);
+	} else if(!group_locked) {
+		RedisModule_ThreadSafeContextLock(group->redis_ctx);
+	}
 
 	// open key and verify
 	RedisModuleKey *key = RedisModule_OpenKey(redis_ctx, graphID, REDISMODULE_WRITE);
@@ -372,7 +380,8 @@ bool QueryCtx_LockForCommit(void) {
 	ctx->internal_exec_ctx.key = key;
 
 	// acquire graph write lock
-	Graph_AcquireWriteLock(gc->g);
+	if(!group_locked) Graph_AcquireWriteLock(gc->g);
+	if(group != NULL) group->locked = true;
 	ctx->internal_exec_ctx.locked_for_commit = true;
 
 	return true;
@@ -382,7 +391,11 @@ clean_up:
 	RedisModule_CloseKey(key);
 
 	// unlock GIL
-	_QueryCtx_ThreadSafeContextUnlock(ctx);
+	if(group == NULL) {
+		_QueryCtx_ThreadSafeContextUnlock(ctx);
+	} else if(!group_locked) {
+		RedisModule_ThreadSafeContextUnlock(group->redis_ctx);
+	}
 
 	// if there is a break point for runtime exception, raise it, otherwise return false
 	ErrorCtx_RaiseRuntimeException(NULL);
@@ -394,16 +407,19 @@ static void _QueryCtx_UnlockCommit
 	QueryCtx *ctx
 ) {
 	GraphContext *gc = ctx->gc;
+	bool group_commit = ctx->internal_exec_ctx.group != NULL;
 
 	ctx->internal_exec_ctx.locked_for_commit = false;
 	// release graph R/W lock
-	Graph_ReleaseLock(gc->g);
+	// under group commit locks are handed over to the group's next query
+	// and released once the group is done
+	if(!group_commit) Graph_ReleaseLock(gc->g);
 
 	// close Key
 	RedisModule_CloseKey(ctx->internal_exec_ctx.key);
 
 	// unlock GIL
-	_QueryCtx_ThreadSafeContextUnlock(ctx);
+	if(!group_commit) _QueryCtx_ThreadSafeContextUnlock(ctx);
 }
 
 // starts an ulocking flow and notifies Redis after commiting changes
@@ -462,6 +478,11 @@ void QueryCtx_Free(void) {
 		ctx->query_data.params = NULL;
 	}
 
+	if(ctx->query_data.query_normalized != NULL) {
+		rm_free(ctx->query_data.query_normalized);
+		ctx->query_data.query_normalized = NULL;
+	}
+
 	rm_free(ctx);
 
 	// NULL-set the context for reuse the next time this thread receives a query
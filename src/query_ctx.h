@@ -52,12 +52,21 @@ typedef struct {
 	rax *params;                  // query parameters
 	const char *query;            // query string
 	const char *query_no_params;  // query string without parameters part
+	char *query_normalized;       // query string with literals parameterized, the AST's source
 } QueryCtx_QueryData;
 
+// locks shared by consecutive write queries which are committed as a group
+// acquired by the first query to commit, released once the group is done
+typedef struct {
+	RedisModuleCtx *redis_ctx;  // thread safe context used to lock the GIL
+	bool locked;                // GIL and graph write lock are held
+} GroupCommit;
+
 typedef struct {
 	RedisModuleKey *key;     // graph open key, for later extraction and closing
 	ResultSet *result_set;   // execution result set
 	bool locked_for_commit;  // indicates if QueryCtx_LockForCommit been called
+	GroupCommit *group;      // [optional] group commit the query is part of
 } QueryCtx_InternalExecCtx;
 
 typedef struct {
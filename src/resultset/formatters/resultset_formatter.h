@@ -39,9 +39,15 @@ typedef void (*EmitHeaderFunc)(RedisModuleCtx *ctx, const char **columns,
 // Typedef for row formatters.
 typedef void (*EmitRowFunc)(RedisModuleCtx *ctx, GraphContext *gc,
 		SIValue **row, uint numcols);
-							   
+
+// Typedef for block formatters, replying with multiple rows as a single
+// element, rows are laid out in row-major order.
+typedef void (*EmitRowsFunc)(RedisModuleCtx *ctx, GraphContext *gc,
+		SIValue **rows, uint64_t nrows, uint numcols);
+
 typedef struct {
 	EmitRowFunc    EmitRow;
+	EmitRowsFunc   EmitRows;    // optional, replaces EmitRow when set
 	EmitHeaderFunc EmitHeader;
 } ResultSetFormatter;
 
@@ -0,0 +1,486 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "resultset_formatters.h"
+#include "RG.h"
+#include "../../util/arr.h"
+#include "../../util/dict.h"
+#include "../../datatypes/datatypes.h"
+
+// binary reply formatter
+// rows are replied in blocks, each block is a single string holding
+// a self contained binary encoding of its rows, all numbers are little-endian
+//
+// Block format:
+//  row count (u32)
+//  column count (u32)
+//  strings dictionary:
+//   string count (u32)
+//   (length (u32), bytes) X string count
+//  nodes dictionary:
+//   node count (u32)
+//   (node ID (i64), label count (u32), label ID (u32) X N, properties) X node count
+//  edges dictionary:
+//   edge count (u32)
+//   (edge ID (i64), relation ID (u32), src ID (i64), dest ID (i64), properties) X edge count
+//  columns:
+//   (encoding (u8), column data) X column count
+//
+// Properties format:
+//  property count (u32)
+//  (attribute ID (u32), value) X property count
+//
+// Value format, a ValueType tag (u8) followed by:
+//  VALUE_NULL     -
+//  VALUE_STRING   string index (u32)
+//  VALUE_INTEGER  i64
+//  VALUE_BOOLEAN  u8
+//  VALUE_DOUBLE   f64
+//  VALUE_ARRAY    element count (u32), value X element count
+//  VALUE_EDGE     edge index (u32)
+//  VALUE_NODE     node index (u32)
+//  VALUE_PATH     node count (u32), node index (u32) X N,
+//                 edge count (u32), edge index (u32) X N
+//  VALUE_MAP      key count (u32), (key string index (u32), value) X key count
+//  VALUE_POINT    latitude (f64), longitude (f64)
+//
+// Column data:
+// columns in which all none null values share a single type are encoded as
+// a typed block, the encoding is the values type followed by a null bitmap
+// of (row count + 7) / 8 bytes and a fixed width value per row
+// null rows hold a zeroed value
+//  VALUE_NULL     all values are null, no data
+//  VALUE_INTEGER  i64 X row count
+//  VALUE_DOUBLE   f64 X row count
+//  VALUE_BOOLEAN  u8 X row count
+//  VALUE_STRING   string index (u32) X row count
+//  VALUE_NODE     node index (u32) X row count
+//  VALUE_EDGE     edge index (u32) X row count
+// other columns are encoded as VALUE_UNKNOWN followed by a value per row
+
+typedef unsigned char *Buffer;  // arr.h byte array
+
+// block encoding context
+typedef struct {
+	GraphContext *gc;      // graph context
+	dict *strings;         // string -> string index
+	const char **str_list; // strings by index
+	dict *nodes;           // node ID -> node index
+	uint32_t node_count;   // number of encoded nodes
+	Buffer node_buf;       // encoded nodes
+	dict *edges;           // edge ID -> edge index
+	uint32_t edge_count;   // number of encoded edges
+	Buffer edge_buf;       // encoded edges
+} BinaryBlock;
+
+static uint64_t _str_hash
+(
+	const void *key
+) {
+	return HashTableGenHashFunction(key, strlen((const char *)key));
+}
+
+static int _str_compare
+(
+	dict *d,
+	const void *key1,
+	const void *key2
+) {
+	return strcmp((const char *)key1, (const char *)key2) == 0;
+}
+
+static uint64_t _id_hash
+(
+	const void *key
+) {
+	return ((uint64_t)key);
+}
+
+// strings aren't duplicated, they're owned by the replied values
+static dictType _str_dt = { _str_hash, NULL, NULL, _str_compare, NULL, NULL,
+	NULL, NULL, NULL, NULL};
+
+static dictType _id_dt = { _id_hash, NULL, NULL, NULL, NULL, NULL, NULL,
+	NULL, NULL, NULL};
+
+// forward declarations
+static void _WriteValue(BinaryBlock *b, Buffer *buf, SIValue v);
+
+static inline void _WriteBytes
+(
+	Buffer *buf,
+	const void *ptr,
+	size_t n
+) {
+	array_ensure_append(*buf, ptr, n, unsigned char);
+}
+
+static inline void _WriteU8
+(
+	Buffer *buf,
+	uint8_t v
+) {
+	_WriteBytes(buf, &v, sizeof(uint8_t));
+}
+
+static inline void _WriteU32
+(
+	Buffer *buf,
+	uint32_t v
+) {
+	_WriteBytes(buf, &v, sizeof(uint32_t));
+}
+
+static inline void _WriteI64
+(
+	Buffer *buf,
+	int64_t v
+) {
+	_WriteBytes(buf, &v, sizeof(int64_t));
+}
+
+static inline void _WriteF64
+(
+	Buffer *buf,
+	double v
+) {
+	_WriteBytes(buf, &v, sizeof(double));
+}
+
+// returns the dictionary index of string 's', adding it if missing
+static uint32_t _InternString
+(
+	BinaryBlock *b,
+	const char *s
+) {
+	dictEntry *existing;
+	dictEntry *de = HashTableAddRaw(b->strings, (void *)s, &existing);
+	if(de == NULL) return (uint32_t)(uintptr_t)HashTableGetVal(existing);
+
+	uint32_t idx = array_len(b->str_list);
+	HashTableSetVal(b->strings, de, (void *)(uintptr_t)idx);
+	array_append(b->str_list, s);
+
+	return idx;
+}
+
+static void _WriteProperties
+(
+	BinaryBlock *b,
+	Buffer *buf,
+	const GraphEntity *e
+) {
+	const AttributeSet set = GraphEntity_GetAttributes(e);
+	uint16_t prop_count = AttributeSet_Count(set);
+
+	_WriteU32(buf, prop_count);
+	for(uint16_t i = 0; i < prop_count; i++) {
+		Attribute_ID attr_id;
+		SIValue value = AttributeSet_GetIdx(set, i, &attr_id);
+		_WriteU32(buf, attr_id);
+		_WriteValue(b, buf, value);
+	}
+}
+
+// returns the dictionary index of node 'n', encoding it if missing
+static uint32_t _InternNode
+(
+	BinaryBlock *b,
+	Node *n
+) {
+	EntityID id = ENTITY_GET_ID(n);
+
+	dictEntry *existing;
+	dictEntry *de = HashTableAddRaw(b->nodes, (void *)id, &existing);
+	if(de == NULL) return (uint32_t)(uintptr_t)HashTableGetVal(existing);
+
+	uint32_t idx = b->node_count++;
+	HashTableSetVal(b->nodes, de, (void *)(uintptr_t)idx);
+
+	uint lbls_count;
+	NODE_GET_LABELS(b->gc->g, n, lbls_count);
+
+	_WriteI64(&b->node_buf, id);
+	_WriteU32(&b->node_buf, lbls_count);
+	for(uint i = 0; i < lbls_count; i++) _WriteU32(&b->node_buf, labels[i]);
+	_WriteProperties(b, &b->node_buf, (GraphEntity *)n);
+
+	return idx;
+}
+
+// returns the dictionary index of edge 'e', encoding it if missing
+static uint32_t _InternEdge
+(
+	BinaryBlock *b,
+	Edge *e
+) {
+	EntityID id = ENTITY_GET_ID(e);
+
+	dictEntry *existing;
+	dictEntry *de = HashTableAddRaw(b->edges, (void *)id, &existing);
+	if(de == NULL) return (uint32_t)(uintptr_t)HashTableGetVal(existing);
+
+	uint32_t idx = b->edge_count++;
+	HashTableSetVal(b->edges, de, (void *)(uintptr_t)idx);
+
+	int reltype_id = Edge_GetRelationID(e);
+	ASSERT(reltype_id != GRAPH_NO_RELATION);
+
+	_WriteI64(&b->edge_buf, id);
+	_WriteU32(&b->edge_buf, reltype_id);
+	_WriteI64(&b->edge_buf, Edge_GetSrcNodeID(e));
+	_WriteI64(&b->edge_buf, Edge_GetDestNodeID(e));
+	_WriteProperties(b, &b->edge_buf, (GraphEntity *)e);
+
+	return idx;
+}
+
+static ValueType _ValueType
+(
+	SIValue v
+) {
+	switch(SI_TYPE(v)) {
+		case T_NULL:   return VALUE_NULL;
+		case T_STRING: return VALUE_STRING;
+		case T_INT64:  return VALUE_INTEGER;
+		case T_BOOL:   return VALUE_BOOLEAN;
+		case T_DOUBLE: return VALUE_DOUBLE;
+		case T_ARRAY:  return VALUE_ARRAY;
+		case T_NODE:   return VALUE_NODE;
+		case T_EDGE:   return VALUE_EDGE;
+		case T_PATH:   return VALUE_PATH;
+		case T_MAP:    return VALUE_MAP;
+		case T_POINT:  return VALUE_POINT;
+		default:       return VALUE_UNKNOWN;
+	}
+}
+
+// write value without its type tag
+static void _WritePayload
+(
+	BinaryBlock *b,
+	Buffer *buf,
+	SIValue v
+) {
+	switch(SI_TYPE(v)) {
+		case T_NULL:
+			return;
+		case T_STRING:
+			_WriteU32(buf, _InternString(b, v.stringval));
+			return;
+		case T_INT64:
+			_WriteI64(buf, v.longval);
+			return;
+		case T_BOOL:
+			_WriteU8(buf, v.longval != 0);
+			return;
+		case T_DOUBLE:
+			_WriteF64(buf, v.doubleval);
+			return;
+		case T_NODE:
+			_WriteU32(buf, _InternNode(b, v.ptrval));
+			return;
+		case T_EDGE:
+			_WriteU32(buf, _InternEdge(b, v.ptrval));
+			return;
+		case T_POINT:
+			_WriteF64(buf, Point_lat(v));
+			_WriteF64(buf, Point_lon(v));
+			return;
+		case T_ARRAY: {
+			uint32_t len = SIArray_Length(v);
+			_WriteU32(buf, len);
+			for(uint32_t i = 0; i < len; i++) {
+				_WriteValue(b, buf, SIArray_Get(v, i));
+			}
+			return;
+		}
+		case T_PATH: {
+			uint32_t node_count = SIPath_NodeCount(v);
+			_WriteU32(buf, node_count);
+			for(uint32_t i = 0; i < node_count; i++) {
+				SIValue n = SIPath_GetNode(v, i);
+				_WriteU32(buf, _InternNode(b, n.ptrval));
+			}
+
+			uint32_t edge_count = SIPath_Length(v);
+			_WriteU32(buf, edge_count);
+			for(uint32_t i = 0; i < edge_count; i++) {
+				SIValue e = SIPath_GetRelationship(v, i);
+				_WriteU32(buf, _InternEdge(b, e.ptrval));
+			}
+			return;
+		}
+		case T_MAP: {
+			uint32_t key_count = Map_KeyCount(v);
+			_WriteU32(buf, key_count);
+			for(uint32_t i = 0; i < key_count; i++) {
+				Pair p = v.map[i];
+				_WriteU32(buf, _InternString(b, p.key.stringval));
+				_WriteValue(b, buf, p.val);
+			}
+			return;
+		}
+		default:
+			RedisModule_Assert("Unhandled value type" && false);
+	}
+}
+
+// write value preceded by its type tag
+static void _WriteValue
+(
+	BinaryBlock *b,
+	Buffer *buf,
+	SIValue v
+) {
+	_WriteU8(buf, _ValueType(v));
+	_WritePayload(b, buf, v);
+}
+
+// returns the encoding of column 'col'
+// the shared type of all none null values, VALUE_UNKNOWN if there's none
+static ValueType _ColumnEncoding
+(
+	SIValue **rows,
+	uint64_t nrows,
+	uint numcols,
+	uint col
+) {
+	ValueType t = VALUE_NULL;
+
+	for(uint64_t i = 0; i < nrows; i++) {
+		ValueType vt = _ValueType(*rows[i * numcols + col]);
+		if(vt == VALUE_NULL || vt == t) continue;
+		if(t != VALUE_NULL) return VALUE_UNKNOWN;
+		t = vt;
+	}
+
+	switch(t) {
+		case VALUE_NULL:
+		case VALUE_INTEGER:
+		case VALUE_DOUBLE:
+		case VALUE_BOOLEAN:
+		case VALUE_STRING:
+		case VALUE_NODE:
+		case VALUE_EDGE:
+			return t;
+		default:
+			return VALUE_UNKNOWN;
+	}
+}
+
+static void _WriteColumn
+(
+	BinaryBlock *b,
+	Buffer *buf,
+	SIValue **rows,
+	uint64_t nrows,
+	uint numcols,
+	uint col
+) {
+	ValueType t = _ColumnEncoding(rows, nrows, numcols, col);
+	_WriteU8(buf, t);
+
+	if(t == VALUE_NULL) return;
+
+	// mixed column, tagged values
+	if(t == VALUE_UNKNOWN) {
+		for(uint64_t i = 0; i < nrows; i++) {
+			_WriteValue(b, buf, *rows[i * numcols + col]);
+		}
+		return;
+	}
+
+	// typed column, null bitmap followed by fixed width values
+	uint64_t bitmap_len = (nrows + 7) / 8;
+	uint64_t bitmap_pos = array_len(*buf);
+	*buf = array_ensure_len(*buf, bitmap_pos + bitmap_len);
+	memset(*buf + bitmap_pos, 0, bitmap_len);
+
+	for(uint64_t i = 0; i < nrows; i++) {
+		SIValue v = *rows[i * numcols + col];
+		if(SI_TYPE(v) != T_NULL) {
+			_WritePayload(b, buf, v);
+			continue;
+		}
+
+		(*buf)[bitmap_pos + i / 8] |= (1 << (i % 8));
+		switch(t) {
+			case VALUE_INTEGER:
+				_WriteI64(buf, 0);
+				break;
+			case VALUE_DOUBLE:
+				_WriteF64(buf, 0);
+				break;
+			case VALUE_BOOLEAN:
+				_WriteU8(buf, 0);
+				break;
+			default:
+				_WriteU32(buf, 0);
+				break;
+		}
+	}
+}
+
+void ResultSet_EmitBinaryRows
+(
+	RedisModuleCtx *ctx,
+	GraphContext *gc,
+	SIValue **rows,
+	uint64_t nrows,
+	uint numcols
+) {
+	ASSERT(nrows <= UINT32_MAX);
+
+	BinaryBlock b = {
+		.gc         = gc,
+		.strings    = HashTableCreate(&_str_dt),
+		.str_list   = array_new(const char *, 0),
+		.nodes      = HashTableCreate(&_id_dt),
+		.node_count = 0,
+		.node_buf   = array_new(unsigned char, 0),
+		.edges      = HashTableCreate(&_id_dt),
+		.edge_count = 0,
+		.edge_buf   = array_new(unsigned char, 0),
+	};
+
+	// encode columns, populating the dictionaries
+	Buffer columns = array_new(unsigned char, 0);
+	for(uint i = 0; i < numcols; i++) {
+		_WriteColumn(&b, &columns, rows, nrows, numcols, i);
+	}
+
+	// assemble block
+	Buffer block = array_new(unsigned char, 0);
+	_WriteU32(&block, nrows);
+	_WriteU32(&block, numcols);
+
+	uint32_t string_count = array_len(b.str_list);
+	_WriteU32(&block, string_count);
+	for(uint32_t i = 0; i < string_count; i++) {
+		uint32_t len = strlen(b.str_list[i]);
+		_WriteU32(&block, len);
+		_WriteBytes(&block, b.str_list[i], len);
+	}
+
+	_WriteU32(&block, b.node_count);
+	_WriteBytes(&block, b.node_buf, array_len(b.node_buf));
+	_WriteU32(&block, b.edge_count);
+	_WriteBytes(&block, b.edge_buf, array_len(b.edge_buf));
+	_WriteBytes(&block, columns, array_len(columns));
+
+	RedisModule_ReplyWithStringBuffer(ctx, (const char *)block,
+			array_len(block));
+
+	HashTableRelease(b.strings);
+	HashTableRelease(b.nodes);
+	HashTableRelease(b.edges);
+	array_free(b.str_list);
+	array_free(b.node_buf);
+	array_free(b.edge_buf);
+	array_free(columns);
+	array_free(block);
+}
@@ -0,0 +1,14 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+// Formatter for binary replies
+// rows are replied as a block, a binary string holding a dictionary of the
+// block's strings, nodes and edges followed by a typed encoding of each column
+void ResultSet_EmitBinaryRows(RedisModuleCtx *ctx, GraphContext *gc,
+		SIValue **rows, uint64_t nrows, uint numcols);
+
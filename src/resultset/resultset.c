@@ -73,6 +73,13 @@ ResultSet *NewResultSet
 	set->column_count        =  0;
 	set->cells_allocation    =  M_NONE;
 	set->columns_record_map  =  NULL;
+	set->streaming           =  false;
+	set->stream_started      =  false;
+	set->window              =  NULL;
+	set->window_cap          =  0;
+	set->window_rows         =  0;
+	set->streamed_rows       =  0;
+	set->reply_len           =  0;
 
 	// init resultset statistics
 	ResultSetStat_init(&set->stats);
@@ -93,6 +100,85 @@ ResultSet *NewResultSet
 	return set;
 }
 
+// free window rows
+static void _ResultSet_ClearWindow
+(
+	ResultSet *set
+) {
+	if(set->cells_allocation & (M_SELF | M_INTERN)) {
+		uint64_t n = set->window_rows * set->column_count;
+		for(uint64_t i = 0; i < n; i++) SIValue_Free(set->window[i]);
+	}
+
+	set->window_rows = 0;
+}
+
+// reply with window rows
+// the first flush emits the reply preamble followed by a rows array
+// of unknown length, set once the resultset is replied
+static void _ResultSet_FlushWindow
+(
+	ResultSet *set
+) {
+	if(!set->stream_started) {
+		_ResultSet_ReplyWithPreamble(set);
+		RedisModule_ReplyWithArray(set->ctx, REDISMODULE_POSTPONED_LEN);
+		set->stream_started = true;
+	}
+
+	if(set->formatter->EmitRows != NULL) {
+		// reply with window as a single block
+		if(set->window_rows > 0) {
+			uint64_t n = set->window_rows * set->column_count;
+			SIValue **rows = rm_malloc(sizeof(SIValue *) * n);
+			for(uint64_t i = 0; i < n; i++) rows[i] = set->window + i;
+
+			set->formatter->EmitRows(set->ctx, set->gc, rows, set->window_rows,
+					set->column_count);
+			set->reply_len++;
+			rm_free(rows);
+		}
+	} else {
+		SIValue *row[set->column_count];
+		for(uint64_t i = 0; i < set->window_rows; i++) {
+			SIValue *cells = set->window + i * set->column_count;
+			for(uint j = 0; j < set->column_count; j++) row[j] = cells + j;
+
+			set->formatter->EmitRow(set->ctx, set->gc, row, set->column_count);
+		}
+		set->reply_len += set->window_rows;
+	}
+
+	set->streamed_rows += set->window_rows;
+	_ResultSet_ClearWindow(set);
+}
+
+// stream resultset
+// rows are accumulated in a window of 'window' rows, once full
+// the window is serialized into the reply and its rows are released
+// the reply itself is buffered by Redis until the client is unblocked
+void ResultSet_Stream
+(
+	ResultSet *set,  // resultset to stream
+	uint64_t window  // number of rows to accumulate before replying
+) {
+	ASSERT(set    != NULL);
+	ASSERT(window > 0);
+	ASSERT(set->streaming == false);
+
+	// nothing to stream
+	if(set->column_count == 0) return;
+
+	// no rows were added yet
+	ASSERT(DataBlock_ItemCount(set->cells) == 0);
+	DataBlock_Free(set->cells);
+	set->cells = NULL;
+
+	set->streaming  = true;
+	set->window_cap = window;
+	set->window     = rm_malloc(sizeof(SIValue) * window * set->column_count);
+}
+
 // map each column to a record index
 // such that when resolving resultset row i column j we'll extract
 // data from record at position columns_record_map[j]
@@ -124,6 +210,7 @@ uint64_t ResultSet_RowCount
 	ASSERT(set != NULL);
 
 	if(set->column_count == 0) return 0;
+	if(set->streaming) return set->streamed_rows + set->window_rows;
 	return DataBlock_ItemCount(set->cells) / set->column_count;
 }
 
@@ -139,7 +226,9 @@ int ResultSet_AddRecord
 	// copy projected values from record to resultset
 	for(int i = 0; i < set->column_count; i++) {
 		int idx = set->columns_record_map[i];
-		SIValue *cell = DataBlock_AllocateItem(set->cells, NULL);
+		SIValue *cell = (set->streaming)
+			? set->window + set->window_rows * set->column_count + i
+			: DataBlock_AllocateItem(set->cells, NULL);
 		*cell = Record_Get(r, idx);
 		SIValue_Persist(cell);
 		set->cells_allocation |= SI_ALLOCATION(cell);
@@ -153,6 +242,11 @@ int ResultSet_AddRecord
 		Record_Remove(r, idx);
 	}
 
+	// reply with window once full
+	if(set->streaming && ++set->window_rows == set->window_cap) {
+		_ResultSet_FlushWindow(set);
+	}
+
 	return RESULTSET_OK;
 }
 
@@ -221,6 +315,32 @@ void ResultSet_CachedExecution
 	set->stats.cached = true;
 }
 
+// reply with the remaining rows of a streamed resultset
+static void _ResultSet_ReplyStream
+(
+	ResultSet *set
+) {
+	if(ErrorCtx_EncounteredError()) {
+		_ResultSet_ClearWindow(set);
+
+		// nothing was replied yet, emit error as the only response
+		if(!set->stream_started) {
+			ErrorCtx_EmitException();
+			return;
+		}
+
+		// close rows array, error takes the place of the statistics
+		RedisModule_ReplySetArrayLength(set->ctx, set->reply_len);
+		ErrorCtx_EmitException();
+		return;
+	}
+
+	_ResultSet_FlushWindow(set);
+	RedisModule_ReplySetArrayLength(set->ctx, set->reply_len);
+
+	ResultSetStat_emit(set->ctx, &set->stats); // response with statistics
+}
+
 // flush resultset to network
 void ResultSet_Reply
 (
@@ -228,6 +348,11 @@ void ResultSet_Reply
 ) {
 	ASSERT(set != NULL);
 
+	if(set->streaming) {
+		_ResultSet_ReplyStream(set);
+		return;
+	}
+
 	uint64_t row_count = ResultSet_RowCount(set);
 
 	// check to see if we've encountered a run-time error
@@ -241,7 +366,21 @@ void ResultSet_Reply
 	_ResultSet_ReplyWithPreamble(set);
 
 	// emit resultset
-	if(set->column_count > 0) {
+	if(set->column_count > 0 && set->formatter->EmitRows != NULL) {
+		// reply with all rows as a single block
+		RedisModule_ReplyWithArray(set->ctx, row_count > 0);
+		if(row_count > 0) {
+			uint64_t n = DataBlock_ItemCount(set->cells);
+			SIValue **rows = rm_malloc(sizeof(SIValue *) * n);
+			for(uint64_t i = 0; i < n; i++) {
+				rows[i] = DataBlock_GetItem(set->cells, i);
+			}
+
+			set->formatter->EmitRows(set->ctx, set->gc, rows, row_count,
+					set->column_count);
+			rm_free(rows);
+		}
+	} else if(set->column_count > 0) {
 		RedisModule_ReplyWithArray(set->ctx, row_count);
 		SIValue *row[set->column_count];
 		uint64_t cells = DataBlock_ItemCount(set->cells);
@@ -286,7 +425,7 @@ void ResultSet_Free
 	// calling SIValue_Free is required
 	if(set->cells) {
 		// free individual cells if resultset encountered a heap allocated value
-		if(set->cells_allocation & M_SELF) {
+		if(set->cells_allocation & (M_SELF | M_INTERN)) {
 			uint64_t n = DataBlock_ItemCount(set->cells);
 			for(uint64_t i = 0; i < n; i++) {
 				SIValue *v = DataBlock_GetItem(set->cells, i);
@@ -296,5 +435,11 @@ void ResultSet_Free
 		DataBlock_Free(set->cells);
 	}
 
+	// free streaming window
+	if(set->window) {
+		_ResultSet_ClearWindow(set);
+		rm_free(set->window);
+	}
+
 	rm_free(set);
 }
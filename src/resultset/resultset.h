@@ -27,6 +27,13 @@ typedef struct {
 	ResultSetFormatterType format;  // result set format; compact/verbose/nop
 	ResultSetFormatter *formatter;  // result set data formatter
 	SIAllocation cells_allocation;  // encountered values allocation
+	bool streaming;                 // rows are replied as they're produced
+	bool stream_started;            // reply preamble emitted
+	SIValue *window;                // streamed rows awaiting to be replied
+	uint64_t window_cap;            // max number of rows held by window
+	uint64_t window_rows;           // number of rows held by window
+	uint64_t streamed_rows;         // number of rows replied
+	uint64_t reply_len;             // number of replied rows array elements
 } ResultSet;
 
 // map each column to a record index
@@ -45,6 +52,17 @@ ResultSet *NewResultSet
 	ResultSetFormatterType format  // resultset format
 );
 
+// stream resultset
+// rows are accumulated in a window of 'window' rows, once full
+// the window is serialized into the reply and its rows are released
+// note: the reply of a blocked client is buffered by Redis until the client
+// is unblocked, rows are therefore delivered once the query is done
+void ResultSet_Stream
+(
+	ResultSet *set,  // resultset to stream
+	uint64_t window  // number of rows to accumulate before replying
+);
+
 // returns number of rows in result-set
 uint64_t ResultSet_RowCount
 (
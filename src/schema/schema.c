@@ -572,6 +572,50 @@ void Schema_AddEdgeToIndices
 	if(idx != NULL) Index_IndexEdge(idx, e);
 }
 
+// index a batch of nodes under all schema indices
+void Schema_AddNodesToIndices
+(
+	const Schema *s,
+	const Node **nodes,
+	uint64_t n
+) {
+	ASSERT(s != NULL);
+	ASSERT(nodes != NULL || n == 0);
+
+	Index idx = NULL;
+
+	idx = ACTIVE_EXACTMATCH_IDX(s);
+	if(idx != NULL) Index_IndexNodes(idx, nodes, n);
+
+	idx = PENDING_EXACTMATCH_IDX(s);
+	if(idx != NULL) Index_IndexNodes(idx, nodes, n);
+
+	idx = ACTIVE_FULLTEXT_IDX(s);
+	if(idx != NULL) Index_IndexNodes(idx, nodes, n);
+
+	idx = PENDING_FULLTEXT_IDX(s);
+	if(idx != NULL) Index_IndexNodes(idx, nodes, n);
+}
+
+// index a batch of edges under all schema indices
+void Schema_AddEdgesToIndices
+(
+	const Schema *s,
+	const Edge **edges,
+	uint64_t n
+) {
+	ASSERT(s != NULL);
+	ASSERT(edges != NULL || n == 0);
+
+	Index idx = NULL;
+
+	idx = ACTIVE_EXACTMATCH_IDX(s);
+	if(idx != NULL) Index_IndexEdges(idx, edges, n);
+
+	idx = PENDING_EXACTMATCH_IDX(s);
+	if(idx != NULL) Index_IndexEdges(idx, edges, n);
+}
+
 // remove node from schema indicies
 void Schema_RemoveNodeFromIndices
 (
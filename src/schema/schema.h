@@ -141,6 +141,22 @@ void Schema_AddEdgeToIndices
 	const Edge *e
 );
 
+// introduce a batch of nodes to schema indicies
+void Schema_AddNodesToIndices
+(
+	const Schema *s,
+	const Node **nodes,
+	uint64_t n
+);
+
+// introduce a batch of edges to schema indicies
+void Schema_AddEdgesToIndices
+(
+	const Schema *s,
+	const Edge **edges,
+	uint64_t n
+);
+
 // remove node from schema indicies
 void Schema_RemoveNodeFromIndices
 (
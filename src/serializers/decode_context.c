@@ -9,6 +9,14 @@
 #include "../util/arr.h"
 #include "../util/rmalloc.h"
 #include "../util/rax_extensions.h"
+#include "../util/thpool/pools.h"
+
+// a decode job handed over to a worker thread
+typedef struct {
+	GraphDecodeContext *ctx;   // decode context the job belongs to
+	void (*job)(void *);       // job to run
+	void *arg;                 // job argument
+} DecodeJob;
 
 GraphDecodeContext *GraphDecodeContext_New() {
 	GraphDecodeContext *ctx = rm_malloc(sizeof(GraphDecodeContext));
@@ -16,11 +24,22 @@ GraphDecodeContext *GraphDecodeContext_New() {
 	ctx->graph_keys_count = 1;
 	ctx->meta_keys = raxNew();
 	ctx->multi_edge = NULL;
+	ctx->matrices = NULL;
+	ctx->matrix_count = 0;
+	ctx->pending_jobs = 0;
+
+	int res = pthread_mutex_init(&ctx->lock, NULL);
+	ASSERT(res == 0);
+	res = pthread_cond_init(&ctx->jobs_done, NULL);
+	ASSERT(res == 0);
+	UNUSED(res);
+
 	return ctx;
 }
 
 void GraphDecodeContext_Reset(GraphDecodeContext *ctx) {
 	ASSERT(ctx);
+	ASSERT(ctx->pending_jobs == 0);
 
 	ctx->keys_processed    =  0;
 	ctx->graph_keys_count  =  1;
@@ -29,6 +48,8 @@ void GraphDecodeContext_Reset(GraphDecodeContext *ctx) {
 		array_free(ctx->multi_edge);
 		ctx->multi_edge = NULL;
 	}
+
+	GraphDecodeContext_ClearMatrices(ctx);
 }
 
 void GraphDecodeContext_SetKeyCount(GraphDecodeContext *ctx, uint64_t key_count) {
@@ -57,6 +78,79 @@ void GraphDecodeContext_ClearMetaKeys(GraphDecodeContext *ctx) {
 	ctx->meta_keys = raxNew();
 }
 
+void GraphDecodeContext_InitMatrices(GraphDecodeContext *ctx, uint n) {
+	ASSERT(ctx);
+	ASSERT(ctx->matrices == NULL);
+
+	ctx->matrix_count = n;
+	ctx->matrices = rm_calloc(n, sizeof(DecodedMatrix));
+}
+
+DecodedMatrix *GraphDecodeContext_GetMatrix(GraphDecodeContext *ctx, uint i) {
+	ASSERT(ctx);
+	ASSERT(i < ctx->matrix_count);
+	return ctx->matrices + i;
+}
+
+void GraphDecodeContext_ClearMatrices(GraphDecodeContext *ctx) {
+	ASSERT(ctx);
+	if(ctx->matrices == NULL) return;
+
+	// matrices handed over to the graph are NULL-ed out
+	for(uint i = 0; i < ctx->matrix_count; i++) {
+		DecodedMatrix *m = ctx->matrices + i;
+		if(m->Ap) rm_free(m->Ap);
+		if(m->Aj) rm_free(m->Aj);
+		if(m->Ax) rm_free(m->Ax);
+	}
+
+	rm_free(ctx->matrices);
+	ctx->matrices = NULL;
+	ctx->matrix_count = 0;
+}
+
+static void _GraphDecodeContext_RunJob(void *arg) {
+	DecodeJob *j = (DecodeJob *)arg;
+	GraphDecodeContext *ctx = j->ctx;
+
+	j->job(j->arg);
+	rm_free(j);
+
+	pthread_mutex_lock(&ctx->lock);
+	ctx->pending_jobs--;
+	if(ctx->pending_jobs == 0) pthread_cond_broadcast(&ctx->jobs_done);
+	pthread_mutex_unlock(&ctx->lock);
+}
+
+void GraphDecodeContext_Dispatch(GraphDecodeContext *ctx, void (*job)(void *), void *arg) {
+	ASSERT(ctx);
+	ASSERT(job);
+
+	DecodeJob *j = rm_malloc(sizeof(DecodeJob));
+	j->ctx = ctx;
+	j->job = job;
+	j->arg = arg;
+
+	pthread_mutex_lock(&ctx->lock);
+	ctx->pending_jobs++;
+	pthread_mutex_unlock(&ctx->lock);
+
+	// run job on the calling thread if the readers queue is full
+	if(ThreadPools_AddWorkReader(_GraphDecodeContext_RunJob, j, false) != 0) {
+		_GraphDecodeContext_RunJob(j);
+	}
+}
+
+void GraphDecodeContext_WaitForJobs(GraphDecodeContext *ctx) {
+	ASSERT(ctx);
+
+	pthread_mutex_lock(&ctx->lock);
+	while(ctx->pending_jobs > 0) {
+		pthread_cond_wait(&ctx->jobs_done, &ctx->lock);
+	}
+	pthread_mutex_unlock(&ctx->lock);
+}
+
 // Returns if the the number of processed keys is equal to the total number of graph keys.
 bool GraphDecodeContext_Finished(const GraphDecodeContext *ctx) {
 	ASSERT(ctx);
@@ -82,6 +176,12 @@ void GraphDecodeContext_Free(GraphDecodeContext *ctx) {
 			ctx->multi_edge = NULL;
 		}
 
+		GraphDecodeContext_WaitForJobs(ctx);
+		GraphDecodeContext_ClearMatrices(ctx);
+
+		pthread_cond_destroy(&ctx->jobs_done);
+		pthread_mutex_destroy(&ctx->lock);
+
 		rm_free(ctx);
 	}
 }
@@ -10,6 +10,18 @@
 #include "stdbool.h"
 #include "stdint.h"
 #include "rax.h"
+#include <pthread.h>
+
+// A matrix being assembled out of its decoded tiles.
+typedef struct {
+	uint64_t *Ap;               // Row offsets, holds row degrees until finalized.
+	uint64_t *Aj;               // Column indices.
+	uint64_t *Ax;               // Values, NULL for boolean matrices.
+	uint64_t nrows;             // Number of rows.
+	uint64_t nvals;             // Total number of entries.
+	uint64_t loaded;            // Number of entries loaded so far.
+	uint64_t edge_count;        // Number of edges loaded, relation matrices only.
+} DecodedMatrix;
 
 // A struct that maintains the state of a graph decoding from RDB.
 typedef struct {
@@ -17,6 +29,11 @@ typedef struct {
 	uint64_t graph_keys_count;  // The number of keys representing the graph.
 	rax *meta_keys;             // The meta keys encountered so far in the decode process.
 	uint64_t *multi_edge;       // Is relation contains multi edge values.
+	DecodedMatrix *matrices;    // Graph matrices being decoded.
+	uint matrix_count;          // Number of graph matrices.
+	uint64_t pending_jobs;      // Number of dispatched decode jobs yet to complete.
+	pthread_mutex_t lock;       // Guards pending_jobs.
+	pthread_cond_t jobs_done;   // Signaled once all dispatched jobs completed.
 } GraphDecodeContext;
 
 // Creates a new graph decoding context.
@@ -40,6 +57,22 @@ unsigned char **GraphDecodeContext_GetMetaKeys(const GraphDecodeContext *ctx);
 // Removes the stored meta key names from the context.
 void GraphDecodeContext_ClearMetaKeys(GraphDecodeContext *ctx);
 
+// Allocate 'n' empty decoded matrices.
+void GraphDecodeContext_InitMatrices(GraphDecodeContext *ctx, uint n);
+
+// Returns the i-th decoded matrix.
+DecodedMatrix *GraphDecodeContext_GetMatrix(GraphDecodeContext *ctx, uint i);
+
+// Free the decoded matrices.
+void GraphDecodeContext_ClearMatrices(GraphDecodeContext *ctx);
+
+// Hand a decode job over to a worker thread.
+// The job runs on the calling thread if it can't be queued.
+void GraphDecodeContext_Dispatch(GraphDecodeContext *ctx, void (*job)(void *), void *arg);
+
+// Block until all dispatched decode jobs completed.
+void GraphDecodeContext_WaitForJobs(GraphDecodeContext *ctx);
+
 // Returns if the number of processed keys is equal to the total number of graph keys.
 bool GraphDecodeContext_Finished(const GraphDecodeContext *ctx);
 
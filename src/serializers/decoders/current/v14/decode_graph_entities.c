@@ -0,0 +1,171 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "decode_v14.h"
+
+// a batch of attribute-sets to be parsed by a worker thread
+typedef struct {
+	GraphContext *gc;     // graph context
+	char *buf;            // binary attribute-sets
+	size_t len;           // buffer length
+	AttributeSet **sets;  // attribute-sets to populate
+	uint64_t n;           // number of attribute-sets
+} AttributeBatch;
+
+// parse a batch of binary attribute-sets
+// runs on a worker thread
+static void _LoadAttributeBatch
+(
+	void *arg
+) {
+	// Format:
+	// (#properties N, (name, value type, value) X N) X B
+
+	AttributeBatch *batch = (AttributeBatch *)arg;
+	FILE *stream = fmemopen(batch->buf, batch->len, "r");
+	ASSERT(stream != NULL);
+
+	for(uint64_t i = 0; i < batch->n; i++) {
+		ushort n;
+		fread_assert(&n, sizeof(ushort), stream);
+
+		SIValue vals[n];
+		Attribute_ID ids[n];
+
+		for(ushort j = 0; j < n; j++) {
+			fread_assert(ids + j, sizeof(Attribute_ID), stream);
+			vals[j] = SIValue_FromBinary(stream);
+		}
+
+		AttributeSet_AddNoClone(batch->sets[i], ids, vals, n, false);
+
+		// string attributes are interned as they're loaded
+		GraphContext_InternAttributes(batch->gc, *batch->sets[i]);
+	}
+
+	fclose(stream);
+	RedisModule_Free(batch->buf);
+	rm_free(batch->sets);
+	rm_free(batch);
+}
+
+// load a batch of entities
+// the entities' datablock slots are allocated by the calling thread
+// while their attribute-sets are parsed by a worker thread
+static uint64_t _RdbLoadEntityBatch
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	GraphEntityType t
+) {
+	// Format:
+	//  #entities B
+	//  entity IDs buffer
+	//  attribute-sets buffer
+
+	uint64_t  n   = RedisModule_LoadUnsigned(rdb);
+	size_t    len = 0;
+	EntityID *ids = (EntityID *)RedisModule_LoadStringBuffer(rdb, &len);
+	ASSERT(len == sizeof(EntityID) * n);
+
+	AttributeBatch *batch = rm_malloc(sizeof(AttributeBatch));
+	batch->gc   = gc;
+	batch->n    = n;
+	batch->sets = rm_malloc(sizeof(AttributeSet *) * n);
+
+	for(uint64_t i = 0; i < n; i++) {
+		if(t == GETYPE_NODE) {
+			Node node;
+			Serializer_Graph_SetNode(gc->g, ids[i], NULL, 0, &node);
+			batch->sets[i] = node.attributes;
+		} else {
+			Edge edge;
+			Serializer_Graph_SetEdgeAttributes(gc->g, ids[i], &edge);
+			batch->sets[i] = edge.attributes;
+		}
+	}
+
+	RedisModule_Free(ids);
+
+	batch->buf = RedisModule_LoadStringBuffer(rdb, &batch->len);
+	GraphDecodeContext_Dispatch(gc->decoding_context, _LoadAttributeBatch,
+			batch);
+
+	return n;
+}
+
+void RdbLoadNodes_v14
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	uint64_t node_count
+) {
+	// Format:
+	// Batch format * number of batches:
+	//  #nodes B
+	//  node IDs buffer
+	//  attribute-sets buffer:
+	//   (#properties N, (name, value type, value) X N) X B
+	//
+	// node labels are restored from the label matrices
+	// indices are populated once the entire graph is loaded
+
+	while(node_count > 0) {
+		uint64_t n = _RdbLoadEntityBatch(rdb, gc, GETYPE_NODE);
+		ASSERT(n <= node_count);
+		node_count -= n;
+	}
+}
+
+void RdbLoadDeletedNodes_v14
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	uint64_t deleted_node_count
+) {
+	// Format:
+	// node id X N
+	for(uint64_t i = 0; i < deleted_node_count; i++) {
+		NodeID id = RedisModule_LoadUnsigned(rdb);
+		Serializer_Graph_MarkNodeDeleted(gc->g, id);
+	}
+}
+
+void RdbLoadEdges_v14
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	uint64_t edge_count
+) {
+	// Format:
+	// Batch format * number of batches:
+	//  #edges B
+	//  edge IDs buffer
+	//  attribute-sets buffer:
+	//   (#properties N, (name, value type, value) X N) X B
+	//
+	// edge endpoints and relationship type are restored from the matrices
+
+	while(edge_count > 0) {
+		uint64_t n = _RdbLoadEntityBatch(rdb, gc, GETYPE_EDGE);
+		ASSERT(n <= edge_count);
+		edge_count -= n;
+	}
+}
+
+void RdbLoadDeletedEdges_v14
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	uint64_t deleted_edge_count
+) {
+	// Format:
+	// edge id X N
+	for(uint64_t i = 0; i < deleted_edge_count; i++) {
+		EdgeID id = RedisModule_LoadUnsigned(rdb);
+		Serializer_Graph_MarkEdgeDeleted(gc->g, id);
+	}
+}
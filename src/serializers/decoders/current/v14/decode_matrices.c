@@ -0,0 +1,256 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "decode_v14.h"
+
+// graph matrices are decoded tile by tile
+// the main thread reads a tile and reserves its entry range within
+// a per matrix CSR buffer held by the decode context
+// the tile is then deserialized into that range by a worker thread
+// once all virtual keys are loaded the buffers are handed over to the graph
+
+// a tile to be deserialized by a worker thread
+typedef struct {
+	DecodedMatrix *m;           // matrix the tile belongs to
+	bool relation;              // relation matrix
+	uint64_t r0;                // tile first row
+	uint64_t offset;            // position of the tile's first entry in m
+	uint64_t n;                 // tile entry count
+	char *blob;                 // serialized tile
+	size_t blob_size;           // blob size
+	uint64_t multi_edge_count;  // number of multi-edge entries
+	uint64_t *pos;              // multi-edge entries positions within tile
+	EdgeID **edges;             // multi-edge entries edge IDs
+} DecodedTile;
+
+// deserialize a tile into its matrix buffers
+// runs on a worker thread, tiles of the same matrix occupy disjoint entry
+// ranges but might share their boundary rows
+static void _LoadTile
+(
+	void *arg
+) {
+	GrB_Info info;
+	UNUSED(info);
+
+	DecodedTile   *t = (DecodedTile *)arg;
+	DecodedMatrix *m = t->m;
+
+	GrB_Matrix T;
+	GrB_Index *Tp;
+	GrB_Index *Tj;
+	void      *Tx;
+	GrB_Index  Tp_size;
+	GrB_Index  Tj_size;
+	GrB_Index  Tx_size;
+	GrB_Index  nrows;
+	bool       iso;
+	bool       jumbled;
+
+	info = GxB_Matrix_deserialize(&T, NULL, t->blob, t->blob_size, NULL);
+	ASSERT(info == GrB_SUCCESS);
+	RedisModule_Free(t->blob);
+
+	info = GrB_Matrix_nrows(&nrows, T);
+	ASSERT(info == GrB_SUCCESS);
+	ASSERT(t->r0 + nrows <= m->nrows);
+
+	info = GxB_Matrix_unpack_CSR(T, &Tp, &Tj, &Tx, &Tp_size, &Tj_size, &Tx_size,
+			&iso, &jumbled, NULL);
+	ASSERT(info == GrB_SUCCESS);
+	ASSERT(jumbled == false);
+	ASSERT(Tp[nrows] == t->n);
+
+	// accumulate row degrees, offsets are computed once all tiles are loaded
+	for(GrB_Index i = 0; i < nrows; i++) {
+		__atomic_fetch_add(m->Ap + t->r0 + i + 1, Tp[i + 1] - Tp[i],
+				__ATOMIC_RELAXED);
+	}
+
+	memcpy(m->Aj + t->offset, Tj, sizeof(GrB_Index) * t->n);
+
+	if(t->relation) {
+		uint64_t *Ax = m->Ax + t->offset;
+		memcpy(Ax, Tx, sizeof(uint64_t) * t->n);
+
+		// restore multi-edge entries
+		for(uint64_t i = 0; i < t->multi_edge_count; i++) {
+			ASSERT(t->pos[i] < t->n);
+			Ax[t->pos[i]] = SET_MSB((uint64_t)(uintptr_t)t->edges[i]);
+		}
+	}
+
+	rm_free(Tp);
+	rm_free(Tj);
+	rm_free(Tx);
+	GrB_Matrix_free(&T);
+
+	if(t->pos != NULL) {
+		rm_free(t->pos);
+		rm_free(t->edges);
+	}
+	rm_free(t);
+}
+
+// load a single tile, returns the number of entries loaded
+static uint64_t _RdbLoadTile
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc
+) {
+	// Format:
+	//  matrix ID
+	//  matrix entry count
+	//  tile first row
+	//  tile entry count
+	//  #multi-edge entries M
+	//  (tile entry position, #edges N, (edge ID) X N) X M
+	//  tile blob
+
+	GrB_Info info;
+	UNUSED(info);
+
+	Graph       *g        = gc->g;
+	uint         id       = RedisModule_LoadUnsigned(rdb);
+	uint64_t     nvals    = RedisModule_LoadUnsigned(rdb);
+	DecodedTile *t        = rm_calloc(1, sizeof(DecodedTile));
+
+	t->r0       = RedisModule_LoadUnsigned(rdb);
+	t->n        = RedisModule_LoadUnsigned(rdb);
+	t->relation = Serializer_Graph_IsRelationMatrix(g, id);
+	t->m        = GraphDecodeContext_GetMatrix(gc->decoding_context, id);
+
+	DecodedMatrix *m = t->m;
+
+	// first tile of this matrix, allocate buffers
+	if(m->Ap == NULL) {
+		GrB_Index nrows;
+		RG_Matrix M = Serializer_Graph_GetMatrix(g, id);
+		info = RG_Matrix_nrows(&nrows, M);
+		ASSERT(info == GrB_SUCCESS);
+
+		m->nrows  = nrows;
+		m->nvals  = nvals;
+		m->Ap     = rm_calloc(nrows + 1, sizeof(uint64_t));
+		m->Aj     = rm_malloc(sizeof(uint64_t) * nvals);
+		m->Ax     = t->relation ? rm_malloc(sizeof(uint64_t) * nvals) : NULL;
+	}
+	ASSERT(m->nvals == nvals);
+
+	// reserve the tile's entry range
+	ASSERT(m->loaded + t->n <= m->nvals);
+	t->offset  = m->loaded;
+	m->loaded += t->n;
+
+	//--------------------------------------------------------------------------
+	// load multi-edge entries
+	//--------------------------------------------------------------------------
+
+	uint64_t edge_count = 0;
+	t->multi_edge_count = RedisModule_LoadUnsigned(rdb);
+
+	if(t->multi_edge_count > 0) {
+		t->pos   = rm_malloc(sizeof(uint64_t) * t->multi_edge_count);
+		t->edges = rm_malloc(sizeof(EdgeID *) * t->multi_edge_count);
+	}
+
+	for(uint64_t i = 0; i < t->multi_edge_count; i++) {
+		t->pos[i] = RedisModule_LoadUnsigned(rdb);
+		uint64_t n = RedisModule_LoadUnsigned(rdb);
+		t->edges[i] = array_new(EdgeID, n);
+		for(uint64_t j = 0; j < n; j++) {
+			array_append(t->edges[i], RedisModule_LoadUnsigned(rdb));
+		}
+		edge_count += n;
+	}
+
+	if(t->relation) {
+		m->edge_count += t->n - t->multi_edge_count + edge_count;
+	}
+
+	// hand tile over to a worker thread
+	uint64_t n = t->n;
+	t->blob = RedisModule_LoadStringBuffer(rdb, &t->blob_size);
+	GraphDecodeContext_Dispatch(gc->decoding_context, _LoadTile, t);
+
+	return n;
+}
+
+void RdbLoadMatrices_v14
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	uint64_t entries_to_decode
+) {
+	// Format:
+	// Tile format * number of tiles
+
+	while(entries_to_decode > 0) {
+		uint64_t n = _RdbLoadTile(rdb, gc);
+		ASSERT(n <= entries_to_decode);
+		entries_to_decode -= n;
+	}
+}
+
+// hand decoded matrices over to the graph
+// all dispatched tiles must have been loaded
+void RdbFinalizeMatrices_v14
+(
+	GraphContext *gc
+) {
+	GrB_Info info;
+	UNUSED(info);
+
+	Graph *g = gc->g;
+	uint matrix_count = gc->decoding_context->matrix_count;
+
+	for(uint i = 0; i < matrix_count; i++) {
+		DecodedMatrix *m = GraphDecodeContext_GetMatrix(gc->decoding_context, i);
+
+		// matrix is empty
+		if(m->Ap == NULL) continue;
+		ASSERT(m->loaded == m->nvals);
+
+		// turn row degrees into row offsets
+		for(uint64_t r = 0; r < m->nrows; r++) m->Ap[r + 1] += m->Ap[r];
+		ASSERT(m->Ap[m->nrows] == m->nvals);
+
+		RG_Matrix  M        = Serializer_Graph_GetMatrix(g, i);
+		GrB_Matrix A        = RG_MATRIX_M(M);
+		bool       relation = Serializer_Graph_IsRelationMatrix(g, i);
+		bool       iso      = !relation;
+		void      *Ax       = m->Ax;
+		size_t     Ax_size  = sizeof(uint64_t) * m->nvals;
+
+		// boolean matrices hold a single value
+		if(iso) {
+			Ax      = rm_malloc(sizeof(bool));
+			Ax_size = sizeof(bool);
+			*(bool *)Ax = true;
+		}
+
+		// A takes ownership over Ap, Aj and Ax
+		info = GxB_Matrix_pack_CSR(A, (GrB_Index **)&m->Ap, (GrB_Index **)&m->Aj,
+				&Ax, sizeof(GrB_Index) * (m->nrows + 1),
+				sizeof(GrB_Index) * m->nvals, Ax_size, iso, false, NULL);
+		ASSERT(info == GrB_SUCCESS);
+		m->Ax = NULL;
+
+		// rebuild transpose
+		if(RG_MATRIX_MAINTAIN_TRANSPOSE(M)) {
+			info = GrB_Matrix_apply(RG_MATRIX_TM(M), NULL, NULL, GxB_ONE_BOOL,
+					A, GrB_DESC_T0);
+			ASSERT(info == GrB_SUCCESS);
+		}
+
+		if(relation) {
+			int r = i - Graph_LabelTypeCount(g);
+			GraphStatistics_IncEdgeCount(&g->stats, r, m->edge_count);
+		}
+	}
+
+	GraphDecodeContext_ClearMatrices(gc->decoding_context);
+}
@@ -8,6 +8,7 @@
 #include "../RG.h"
 #include "../util/rmalloc.h"
 #include "../util/rax_extensions.h"
+#include "graph_extensions.h"
 #include "../configuration/config.h"
 
 GraphEncodeContext *GraphEncodeContext_New() {
@@ -26,6 +27,7 @@ static void _GraphEncodeContext_ResetHeader(GraphEncodeContext *ctx) {
 	header->node_count = 0;
 	header->edge_count = 0;
 	header->graph_name = NULL;
+	header->matrix_entry_count = 0;
 	header->label_matrix_count = 0;
 	header->relationship_matrix_count = 0;
 
@@ -43,11 +45,7 @@ void GraphEncodeContext_Reset(GraphEncodeContext *ctx) {
 	ctx->offset = 0;
 	ctx->keys_processed = 0;
 	ctx->state = ENCODE_STATE_INIT;
-	ctx->multiple_edges_src_id = 0;
-	ctx->multiple_edges_dest_id = 0;
-	ctx->multiple_edges_array = NULL;
-	ctx->current_relation_matrix_id = 0;
-	ctx->multiple_edges_current_index = 0;
+	ctx->current_matrix_id = 0;
 
 	Config_Option_get(Config_VKEY_MAX_ENTITY_COUNT, &ctx->vkey_entity_count);
 
@@ -58,7 +56,7 @@ void GraphEncodeContext_Reset(GraphEncodeContext *ctx) {
 	}
 
 	// Avoid leaks in case or reset during encodeing.
-	RG_MatrixTupleIter_detach(&ctx->matrix_tuple_iterator);
+	GraphEncodeContext_ClearEncodedMatrix(ctx);
 }
 
 void GraphEncodeContext_InitHeader
@@ -79,6 +77,7 @@ void GraphEncodeContext_InitHeader
 	header->edge_count                 =  Graph_EdgeCount(g);
 	header->deleted_node_count         =  Graph_DeletedNodeCount(g);
 	header->deleted_edge_count         =  Graph_DeletedEdgeCount(g);
+	header->matrix_entry_count         =  Serializer_Graph_MatrixEntryCount(g);
 	header->relationship_matrix_count  =  r_count;
 	header->label_matrix_count         =  Graph_LabelTypeCount(g);
 	header->key_count                  =  GraphEncodeContext_GetKeyCount(ctx);
@@ -152,51 +151,31 @@ void GraphEncodeContext_SetDatablockIterator(GraphEncodeContext *ctx,
 	ctx->datablock_iterator = iter;
 }
 
-uint GraphEncodeContext_GetCurrentRelationID(const GraphEncodeContext *ctx) {
+uint GraphEncodeContext_GetCurrentMatrixID(const GraphEncodeContext *ctx) {
 	ASSERT(ctx);
-	return ctx->current_relation_matrix_id;
+	return ctx->current_matrix_id;
 }
 
-void GraphEncodeContext_SetCurrentRelationID(GraphEncodeContext *ctx,
-											 uint current_relation_matrix_id) {
+void GraphEncodeContext_SetCurrentMatrixID(GraphEncodeContext *ctx,
+										   uint matrix_id) {
 	ASSERT(ctx);
-	ctx->current_relation_matrix_id = current_relation_matrix_id;
+	ctx->current_matrix_id = matrix_id;
 }
 
-RG_MatrixTupleIter *GraphEncodeContext_GetMatrixTupleIterator(
-	GraphEncodeContext *ctx) {
+EncodedMatrix *GraphEncodeContext_GetEncodedMatrix(GraphEncodeContext *ctx) {
 	ASSERT(ctx);
-	return &ctx->matrix_tuple_iterator;
+	return &ctx->matrix;
 }
 
-void GraphEncodeContext_SetMutipleEdgesArray(GraphEncodeContext *ctx, EdgeID *edges,
-											 uint current_index, NodeID src, NodeID dest) {
+void GraphEncodeContext_ClearEncodedMatrix(GraphEncodeContext *ctx) {
 	ASSERT(ctx);
-	ctx->multiple_edges_array = edges;
-	ctx->multiple_edges_current_index = current_index;
-	ctx->multiple_edges_src_id = src;
-	ctx->multiple_edges_dest_id = dest;
-}
-
-EdgeID *GraphEncodeContext_GetMultipleEdgesArray(const GraphEncodeContext *ctx) {
-	ASSERT(ctx);
-	return ctx->multiple_edges_array;
-}
 
-uint GraphEncodeContext_GetMultipleEdgesCurrentIndex(const GraphEncodeContext *ctx) {
-	ASSERT(ctx);
-	return ctx->multiple_edges_current_index;
-}
+	EncodedMatrix *m = &ctx->matrix;
+	if(m->Ap != NULL) rm_free(m->Ap);
+	if(m->Aj != NULL) rm_free(m->Aj);
+	if(m->Ax != NULL) rm_free(m->Ax);
 
-
-NodeID GraphEncodeContext_GetMultipleEdgesSourceNode(const GraphEncodeContext *ctx) {
-	ASSERT(ctx);
-	return ctx->multiple_edges_src_id;
-}
-
-NodeID GraphEncodeContext_GetMultipleEdgesDestinationNode(const GraphEncodeContext *ctx) {
-	ASSERT(ctx);
-	return ctx->multiple_edges_dest_id;
+	memset(m, 0, sizeof(EncodedMatrix));
 }
 
 bool GraphEncodeContext_Finished(const GraphEncodeContext *ctx) {
@@ -217,6 +196,7 @@ static void GraphEncodeContext_FreeHeader(GraphEncodeContext *ctx) {
 void GraphEncodeContext_Free(GraphEncodeContext *ctx) {
 	if(ctx) {
 		GraphEncodeContext_FreeHeader(ctx);
+		GraphEncodeContext_ClearEncodedMatrix(ctx);
 		raxFree(ctx->meta_keys);
 		rm_free(ctx);
 	}
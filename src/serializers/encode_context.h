@@ -11,7 +11,6 @@
 #include "stdbool.h"
 #include "../graph/graph.h"
 #include "../util/datablock/datablock.h"
-#include "../graph/rg_matrix/rg_matrix_iter.h"
 #include "../graph/entities/graph_entity.h"
 #include "rax.h"
 
@@ -23,6 +22,7 @@ typedef enum {
 	ENCODE_STATE_EDGES,         // encoding edges
 	ENCODE_STATE_DELETED_EDGES, // encoding deleted edges
 	ENCODE_STATE_GRAPH_SCHEMA,  // encoding graph schemas
+	ENCODE_STATE_MATRICES,      // encoding graph matrices
 	ENCODE_STATE_FINAL          // encoding final state
 } EncodeState;
 
@@ -34,11 +34,25 @@ typedef struct {
 	uint64_t edge_count;             // number of edges
 	uint64_t deleted_node_count;      // number of deleted nodes
 	uint64_t deleted_edge_count;     // number of deleted edges
+	uint64_t matrix_entry_count;     // number of entries in all matrices
 	const char *graph_name;          // name of graph
 	uint label_matrix_count;         // number of label matrices
 	uint relationship_matrix_count;  // number of relation matrices
 } GraphEncodeHeader;
 
+// a graph matrix being encoded, unpacked in CSR form
+// the matrix is encoded in tiles, each tile holding a range of entries
+typedef struct {
+	GrB_Index *Ap;     // row offsets
+	GrB_Index *Aj;     // column indices
+	void *Ax;          // values
+	bool iso;          // all entries share the single value Ax[0]
+	GrB_Index nrows;   // number of rows
+	GrB_Index ncols;   // number of columns
+	GrB_Index nvals;   // number of entries
+	GrB_Index offset;  // number of entries already encoded
+} EncodedMatrix;
+
 // GraphEncodeContext maintains the state of a graph being encoded or decoded
 typedef struct {
 	rax *meta_keys;                             // The holds the names of meta keys representing the graph.
@@ -47,13 +61,9 @@ typedef struct {
 	uint64_t keys_processed;                    // Count the number of procssed graph keys.
 	GraphEncodeHeader header;                   // Header replied for each vkey
 	uint64_t vkey_entity_count;                 // Number of entities in a single virtual key.
-	NodeID multiple_edges_src_id;               // The current edges array sourc node id.
-	NodeID multiple_edges_dest_id;              // The current edges array destination node id.
-	EdgeID *multiple_edges_array;               // Multiple edges array, save in the context.
-	uint current_relation_matrix_id;            // Current encoded relationship matrix.
-	uint multiple_edges_current_index;          // The current index of the encoded edges array.
+	uint current_matrix_id;                     // Current encoded matrix.
+	EncodedMatrix matrix;                       // Current encoded matrix content.
 	DataBlockIterator *datablock_iterator;      // Datablock iterator to be saved in the context.
-	RG_MatrixTupleIter matrix_tuple_iterator;   // Matrix tuple iterator to be saved in the context.
 } GraphEncodeContext;
 
 // Creates a new graph encoding context.
@@ -98,31 +108,17 @@ DataBlockIterator *GraphEncodeContext_GetDatablockIterator(const GraphEncodeCont
 // Set graph encoding context datablock iterator - keep iterator state for further usage.
 void GraphEncodeContext_SetDatablockIterator(GraphEncodeContext *ctx, DataBlockIterator *iter);
 
-// Retrieve graph encoding context current encoded relation matrix id.
-uint GraphEncodeContext_GetCurrentRelationID(const GraphEncodeContext *ctx);
-
-// Set graph encoding context current encoded relation matrix id.
-void GraphEncodeContext_SetCurrentRelationID(GraphEncodeContext *ctx,
-											 uint current_relation_matrix_id);
-
-// Retrieve stored matrix tuple iterator.
-RG_MatrixTupleIter *GraphEncodeContext_GetMatrixTupleIterator(GraphEncodeContext *ctx);
-
-// Sets a multiple edges array and the current index, for saving the state of multiple edges encoding.
-void GraphEncodeContext_SetMutipleEdgesArray(GraphEncodeContext *ctx, EdgeID *edges,
-											 uint current_index, NodeID src, NodeID dest);
-
-// Retrive the multiple edges array, to continue array of multiple edge encoding.
-EdgeID *GraphEncodeContext_GetMultipleEdgesArray(const GraphEncodeContext *ctx);
+// Retrieve graph encoding context current encoded matrix id.
+uint GraphEncodeContext_GetCurrentMatrixID(const GraphEncodeContext *ctx);
 
-// Retrive the multiple edges array current index, to continue array of multiple edge encoding.
-uint GraphEncodeContext_GetMultipleEdgesCurrentIndex(const GraphEncodeContext *ctx);
+// Set graph encoding context current encoded matrix id.
+void GraphEncodeContext_SetCurrentMatrixID(GraphEncodeContext *ctx, uint matrix_id);
 
-// Retrive the multiple edges array source node.
-NodeID GraphEncodeContext_GetMultipleEdgesSourceNode(const GraphEncodeContext *ctx);
+// Retrieve the content of the current encoded matrix.
+EncodedMatrix *GraphEncodeContext_GetEncodedMatrix(GraphEncodeContext *ctx);
 
-// Retrive the multiple edges array destination node.
-NodeID GraphEncodeContext_GetMultipleEdgesDestinationNode(const GraphEncodeContext *ctx);
+// Release the content of the current encoded matrix.
+void GraphEncodeContext_ClearEncodedMatrix(GraphEncodeContext *ctx);
 
 // Returns if the the number of processed keys is equal to the total number of graph keys.
 bool GraphEncodeContext_Finished(const GraphEncodeContext *ctx);
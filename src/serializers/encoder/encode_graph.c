@@ -5,9 +5,9 @@
  */
 
 #include "encode_graph.h"
-#include "v13/encode_v13.h"
+#include "v14/encode_v14.h"
 
 void RdbSaveGraph(RedisModuleIO *rdb, void *value) {
-	RdbSaveGraph_v13(rdb, value);
+	RdbSaveGraph_v14(rdb, value);
 }
 
@@ -4,7 +4,7 @@
  * the Server Side Public License v1 (SSPLv1).
  */
 
-#include "encode_v13.h"
+#include "encode_v14.h"
 #include "../../../globals.h"
 
 // Determine whether we are in the context of a bgsave, in which case
@@ -65,7 +65,7 @@ static void _RdbSaveHeader
 	RedisModule_SaveUnsigned(rdb, header->key_count);
 
 	// save graph schemas
-	RdbSaveGraphSchema_v13(rdb, gc);
+	RdbSaveGraphSchema_v14(rdb, gc);
 }
 
 // returns a state information regarding the number of entities required
@@ -94,6 +94,10 @@ static PayloadInfo _StatePayloadInfo
 	case ENCODE_STATE_GRAPH_SCHEMA:
 		required_entities_count = 1;
 		break;
+	case ENCODE_STATE_MATRICES:
+		// each matrix entry counts as an entity
+		required_entities_count = gc->encoding_context->header.matrix_entry_count;
+		break;
 	default:
 		ASSERT(false && "Unknown encoding state in _CurrentStatePayloadInfo");
 		break;
@@ -168,7 +172,7 @@ static PayloadInfo *_RdbSaveKeySchema
 	return payloads;
 }
 
-void RdbSaveGraph_v13
+void RdbSaveGraph_v14
 (
 	RedisModuleIO *rdb,
 	void *value
@@ -177,7 +181,7 @@ void RdbSaveGraph_v13
 	//  Header
 	//  Payload(s) count: N
 	//  Key content X N:
-	//      Payload type (Nodes / Edges / Deleted nodes/ Deleted edges/ Graph schema)
+	//      Payload type (Nodes / Edges / Deleted nodes/ Deleted edges/ Graph schema / Matrices)
 	//      Entities in payload
 	//  Payload(s) X N
 	//
@@ -187,6 +191,7 @@ void RdbSaveGraph_v13
 	// 3. Edges
 	// 4. Deleted edges
 	// 5. Graph schema
+	// 6. Matrices
 	//
 	// Each payload type can spread over one or more keys. For example:
 	// A graph with 200,000 nodes, and the number of entities per payload
@@ -221,20 +226,23 @@ void RdbSaveGraph_v13
 		PayloadInfo payload = key_schema[i];
 		switch(payload.state) {
 		case ENCODE_STATE_NODES:
-			RdbSaveNodes_v13(rdb, gc, payload.entities_count);
+			RdbSaveNodes_v14(rdb, gc, payload.entities_count);
 			break;
 		case ENCODE_STATE_DELETED_NODES:
-			RdbSaveDeletedNodes_v13(rdb, gc, payload.entities_count);
+			RdbSaveDeletedNodes_v14(rdb, gc, payload.entities_count);
 			break;
 		case ENCODE_STATE_EDGES:
-			RdbSaveEdges_v13(rdb, gc, payload.entities_count);
+			RdbSaveEdges_v14(rdb, gc, payload.entities_count);
 			break;
 		case ENCODE_STATE_DELETED_EDGES:
-			RdbSaveDeletedEdges_v13(rdb, gc, payload.entities_count);
+			RdbSaveDeletedEdges_v14(rdb, gc, payload.entities_count);
 			break;
 		case ENCODE_STATE_GRAPH_SCHEMA:
 			// skip, handled in _RdbSaveHeader
 			break;
+		case ENCODE_STATE_MATRICES:
+			RdbSaveMatrices_v14(rdb, gc, payload.entities_count);
+			break;
 		default:
 			ASSERT(false && "Unknown encoding phase");
 			break;
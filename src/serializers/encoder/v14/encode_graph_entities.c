@@ -0,0 +1,259 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "encode_v14.h"
+#include "../../../datatypes/datatypes.h"
+
+// entities are encoded in batches
+// each batch holds the IDs of its entities followed by their attribute-sets
+// in a binary form, allowing the decoder to hand attribute parsing
+// over to worker threads
+#define ENTITY_BATCH_SIZE 4096
+
+// forword decleration
+static void _WriteSIValue
+(
+	unsigned char **buf,
+	const SIValue *v
+);
+
+// append n bytes from ptr to buffer
+static inline void _WriteBytes
+(
+	unsigned char **buf,
+	const void *ptr,
+	size_t n
+) {
+	array_ensure_append(*buf, ptr, n, unsigned char);
+}
+
+static void _WriteSIArray
+(
+	unsigned char **buf,
+	const SIValue *list
+) {
+	// Format:
+	// number of elements
+	// elements
+
+	uint32_t len = SIArray_Length(*list);
+	_WriteBytes(buf, &len, sizeof(uint32_t));
+	for(uint32_t i = 0; i < len; i++) {
+		SIValue value = SIArray_Get(*list, i);
+		_WriteSIValue(buf, &value);
+	}
+}
+
+// writes a binary representation of v
+// readable by SIValue_FromBinary
+static void _WriteSIValue
+(
+	unsigned char **buf,
+	const SIValue *v
+) {
+	// Format:
+	// SIType
+	// Value
+
+	bool   b;
+	size_t len;
+	SIType t = v->type;
+
+	_WriteBytes(buf, &t, sizeof(SIType));
+	switch(t) {
+		case T_POINT:
+			_WriteBytes(buf, &v->point, sizeof(Point));
+			return;
+		case T_ARRAY:
+			_WriteSIArray(buf, v);
+			return;
+		case T_STRING:
+			len = strlen(v->stringval) + 1;
+			_WriteBytes(buf, &len, sizeof(size_t));
+			_WriteBytes(buf, v->stringval, len);
+			return;
+		case T_BOOL:
+			b = SIValue_IsTrue(*v);
+			_WriteBytes(buf, &b, sizeof(bool));
+			return;
+		case T_INT64:
+			_WriteBytes(buf, &v->longval, sizeof(v->longval));
+			return;
+		case T_DOUBLE:
+			_WriteBytes(buf, &v->doubleval, sizeof(v->doubleval));
+			return;
+		case T_NULL:
+			return; // No data beyond the type needs to be encoded for a NULL value.
+		default:
+			ASSERT(0 && "Attempted to serialize value of invalid type.");
+	}
+}
+
+static void _WriteEntity
+(
+	unsigned char **buf,
+	const GraphEntity *e
+) {
+	// Format:
+	// #attributes N
+	// (name, value type, value) X N
+
+	const AttributeSet set = GraphEntity_GetAttributes(e);
+	ushort attr_count = AttributeSet_Count(set);
+
+	_WriteBytes(buf, &attr_count, sizeof(ushort));
+
+	for(ushort i = 0; i < attr_count; i++) {
+		Attribute_ID attr_id;
+		SIValue value = AttributeSet_GetIdx(set, i, &attr_id);
+		_WriteBytes(buf, &attr_id, sizeof(Attribute_ID));
+		_WriteSIValue(buf, &value);
+	}
+}
+
+static void _RdbSaveDeletedEntities_v14
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	uint64_t deleted_entities_to_encode,
+	uint64_t *deleted_id_list
+) {
+	// Get the number of deleted entities already encoded.
+	uint64_t offset = GraphEncodeContext_GetProcessedEntitiesOffset(gc->encoding_context);
+
+	// Iterated over the required range in the datablock deleted items.
+	for(uint64_t i = offset; i < offset + deleted_entities_to_encode; i++) {
+		RedisModule_SaveUnsigned(rdb, deleted_id_list[i]);
+	}
+}
+
+void RdbSaveDeletedNodes_v14
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	uint64_t deleted_nodes_to_encode
+) {
+	// Format:
+	// node id X N
+
+	if(deleted_nodes_to_encode == 0) return;
+	// get deleted nodes list
+	uint64_t *deleted_nodes_list = Serializer_Graph_GetDeletedNodesList(gc->g);
+	_RdbSaveDeletedEntities_v14(rdb, gc, deleted_nodes_to_encode, deleted_nodes_list);
+}
+
+void RdbSaveDeletedEdges_v14
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	uint64_t deleted_edges_to_encode
+) {
+	// Format:
+	// edge id X N
+
+	if(deleted_edges_to_encode == 0) return;
+
+	// get deleted edges list
+	uint64_t *deleted_edges_list = Serializer_Graph_GetDeletedEdgesList(gc->g);
+	_RdbSaveDeletedEntities_v14(rdb, gc, deleted_edges_to_encode, deleted_edges_list);
+}
+
+// encode 'n' entities of a datablock
+// the datablock iterator is kept in the context
+// as entities might spread over multiple virtual keys
+static void _RdbSaveDataBlock_v14
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	uint64_t n,
+	uint64_t total,
+	DataBlockIterator *(*scan)(const Graph *g)
+) {
+	// get the number of entities already encoded
+	uint64_t offset = GraphEncodeContext_GetProcessedEntitiesOffset(gc->encoding_context);
+
+	// get datablock iterator from context,
+	// already set to offset by a previous encodeing, or create new one
+	DataBlockIterator *iter = GraphEncodeContext_GetDatablockIterator(gc->encoding_context);
+	if(!iter) {
+		iter = scan(gc->g);
+		GraphEncodeContext_SetDatablockIterator(gc->encoding_context, iter);
+	}
+
+	EntityID      *ids   = array_new(EntityID, MIN(n, ENTITY_BATCH_SIZE));
+	unsigned char *attrs = array_new(unsigned char, 0);
+
+	while(n > 0) {
+		uint64_t batch = MIN(n, ENTITY_BATCH_SIZE);
+
+		for(uint64_t i = 0; i < batch; i++) {
+			GraphEntity e;
+			e.attributes = (AttributeSet *)DataBlockIterator_Next(iter, &e.id);
+			ASSERT(e.attributes != NULL);
+			array_append(ids, e.id);
+			_WriteEntity(&attrs, &e);
+		}
+
+		RedisModule_SaveUnsigned(rdb, batch);
+		RedisModule_SaveStringBuffer(rdb, (const char *)ids,
+				sizeof(EntityID) * batch);
+		RedisModule_SaveStringBuffer(rdb, (const char *)attrs,
+				array_len(attrs));
+
+		array_clear(ids);
+		array_clear(attrs);
+		offset += batch;
+		n -= batch;
+	}
+
+	array_free(ids);
+	array_free(attrs);
+
+	// check if done encodeing
+	if(offset == total) {
+		DataBlockIterator_Free(iter);
+		iter = NULL;
+		GraphEncodeContext_SetDatablockIterator(gc->encoding_context, iter);
+	}
+}
+
+void RdbSaveNodes_v14
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	uint64_t nodes_to_encode
+) {
+	// Format:
+	// Batch format * number of batches:
+	//  #nodes B
+	//  node IDs buffer
+	//  attribute-sets buffer:
+	//   (#properties N, (name, value type, value) X N) X B
+
+	if(nodes_to_encode == 0) return;
+
+	_RdbSaveDataBlock_v14(rdb, gc, nodes_to_encode, Graph_NodeCount(gc->g),
+			Graph_ScanNodes);
+}
+
+void RdbSaveEdges_v14
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	uint64_t edges_to_encode
+) {
+	// Format:
+	// Batch format * number of batches:
+	//  #edges B
+	//  edge IDs buffer
+	//  attribute-sets buffer:
+	//   (#properties N, (name, value type, value) X N) X B
+
+	if(edges_to_encode == 0) return;
+
+	_RdbSaveDataBlock_v14(rdb, gc, edges_to_encode, Graph_EdgeCount(gc->g),
+			Graph_ScanEdges);
+}
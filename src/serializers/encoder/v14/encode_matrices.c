@@ -0,0 +1,228 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "encode_v14.h"
+
+// graph matrices are encoded as a sequence of tiles
+// each tile is a compressed GraphBLAS blob holding a range of matrix entries
+// in row-major order, a tile covers the rows spanned by its entries
+// tiles of the same matrix are concatenated back together when decoded
+
+// find the row containing entry 'p'
+static GrB_Index _EntryRow
+(
+	const GrB_Index *Ap,  // row offsets
+	GrB_Index nrows,      // number of rows
+	GrB_Index p           // entry position
+) {
+	// binary search for the last row starting at or before 'p'
+	// rows preceding it which start at 'p' as well are empty
+	GrB_Index lo = 0;
+	GrB_Index hi = nrows;
+	while(lo < hi) {
+		GrB_Index mid = lo + (hi - lo + 1) / 2;
+		if(Ap[mid] <= p) lo = mid;
+		else hi = mid - 1;
+	}
+
+	return lo;
+}
+
+// unpack the effective content of the current matrix into the context
+static void _LoadMatrix
+(
+	GraphContext *gc,
+	EncodedMatrix *m
+) {
+	GrB_Info    info;
+	GrB_Matrix  A;
+	GrB_Index   Ap_size;
+	GrB_Index   Aj_size;
+	GrB_Index   Ax_size;
+
+	UNUSED(info);
+
+	uint id = GraphEncodeContext_GetCurrentMatrixID(gc->encoding_context);
+	RG_Matrix M = Serializer_Graph_GetMatrix(gc->g, id);
+
+	// export M + delta-plus - delta-minus without modifying M
+	info = RG_Matrix_export(&A, M);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Matrix_nrows(&m->nrows, A);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Matrix_ncols(&m->ncols, A);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GxB_Matrix_unpack_CSR(A, &m->Ap, &m->Aj, &m->Ax, &Ap_size, &Aj_size,
+			&Ax_size, &m->iso, NULL, NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	m->nvals  = m->Ap[m->nrows];
+	m->offset = 0;
+
+	GrB_Matrix_free(&A);
+}
+
+// encode entries [offset, offset + n) of the current matrix as a single tile
+static void _RdbSaveTile
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	EncodedMatrix *m,
+	uint64_t n
+) {
+	// Format:
+	//  matrix ID
+	//  matrix entry count
+	//  tile first row
+	//  tile entry count
+	//  #multi-edge entries M
+	//  (tile entry position, #edges N, (edge ID) X N) X M
+	//  tile blob
+
+	GrB_Info info;
+	UNUSED(info);
+
+	uint       id       = GraphEncodeContext_GetCurrentMatrixID(gc->encoding_context);
+	bool       relation = Serializer_Graph_IsRelationMatrix(gc->g, id);
+	GrB_Type   t        = relation ? GrB_UINT64 : GrB_BOOL;
+	size_t     t_size   = relation ? sizeof(uint64_t) : sizeof(bool);
+	GrB_Index  p0       = m->offset;
+	GrB_Index  p1       = m->offset + n;
+	GrB_Index  r0       = _EntryRow(m->Ap, m->nrows, p0);
+	GrB_Index  r1       = _EntryRow(m->Ap, m->nrows, p1 - 1);
+	GrB_Index  nrows    = r1 - r0 + 1;
+
+	//--------------------------------------------------------------------------
+	// slice tile out of the matrix
+	//--------------------------------------------------------------------------
+
+	GrB_Index *Tp = rm_malloc(sizeof(GrB_Index) * (nrows + 1));
+	GrB_Index *Tj = rm_malloc(sizeof(GrB_Index) * n);
+	void      *Tx;
+
+	for(GrB_Index i = 0; i <= nrows; i++) {
+		GrB_Index p = m->Ap[r0 + i];
+		Tp[i] = MIN(MAX(p, p0), p1) - p0;
+	}
+	memcpy(Tj, m->Aj + p0, sizeof(GrB_Index) * n);
+
+	bool iso = m->iso && !relation;
+	if(iso) {
+		Tx = rm_malloc(t_size);
+		memcpy(Tx, m->Ax, t_size);
+	} else if(m->iso) {
+		Tx = rm_malloc(t_size * n);
+		for(GrB_Index i = 0; i < n; i++) ((uint64_t *)Tx)[i] = *(uint64_t *)m->Ax;
+	} else {
+		Tx = rm_malloc(t_size * n);
+		memcpy(Tx, (char *)m->Ax + p0 * t_size, t_size * n);
+	}
+
+	RedisModule_SaveUnsigned(rdb, id);
+	RedisModule_SaveUnsigned(rdb, m->nvals);
+	RedisModule_SaveUnsigned(rdb, r0);
+	RedisModule_SaveUnsigned(rdb, n);
+
+	//--------------------------------------------------------------------------
+	// encode multi-edge entries
+	//--------------------------------------------------------------------------
+
+	// a multi-edge entry holds a pointer to an array of edge IDs
+	// the array is encoded separately and the entry is masked
+	// restored by the decoder once the tile is loaded
+	uint64_t *x = Tx;
+	uint64_t multi_edge_count = 0;
+	for(GrB_Index i = 0; i < n && relation; i++) {
+		if(!SINGLE_EDGE(x[i])) multi_edge_count++;
+	}
+
+	RedisModule_SaveUnsigned(rdb, multi_edge_count);
+	for(GrB_Index i = 0; i < n && multi_edge_count > 0; i++) {
+		if(SINGLE_EDGE(x[i])) continue;
+
+		EdgeID *edges = (EdgeID *)(CLEAR_MSB(x[i]));
+		uint edge_count = array_len(edges);
+
+		RedisModule_SaveUnsigned(rdb, i);
+		RedisModule_SaveUnsigned(rdb, edge_count);
+		for(uint j = 0; j < edge_count; j++) {
+			RedisModule_SaveUnsigned(rdb, edges[j]);
+		}
+
+		x[i] = MSB_MASK;
+		multi_edge_count--;
+	}
+
+	//--------------------------------------------------------------------------
+	// serialize tile
+	//--------------------------------------------------------------------------
+
+	GrB_Matrix      T;
+	GrB_Descriptor  desc;
+	void           *blob;
+	GrB_Index       blob_size;
+
+	info = GrB_Matrix_new(&T, t, nrows, m->ncols);
+	ASSERT(info == GrB_SUCCESS);
+
+	// T takes ownership over Tp, Tj and Tx
+	info = GxB_Matrix_pack_CSR(T, &Tp, &Tj, &Tx, sizeof(GrB_Index) * (nrows + 1),
+			sizeof(GrB_Index) * n, iso ? t_size : t_size * n, iso, false, NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	// favor decompression speed over compression ratio
+	info = GrB_Descriptor_new(&desc);
+	ASSERT(info == GrB_SUCCESS);
+	info = GxB_Desc_set(desc, GxB_COMPRESSION, GxB_COMPRESSION_LZ4);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GxB_Matrix_serialize(&blob, &blob_size, T, desc);
+	ASSERT(info == GrB_SUCCESS);
+
+	RedisModule_SaveStringBuffer(rdb, blob, blob_size);
+
+	rm_free(blob);
+	GrB_Matrix_free(&T);
+	GrB_Descriptor_free(&desc);
+}
+
+void RdbSaveMatrices_v14
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	uint64_t entries_to_encode
+) {
+	// Format:
+	// Tile format * number of tiles
+	//
+	// matrices are encoded in order: labels, relations, adjacency, node-labels
+	// the entries of all matrices add up to 'entries_to_encode'
+	// a matrix spreading over multiple virtual keys is split into tiles
+
+	GraphEncodeContext *ctx = gc->encoding_context;
+	EncodedMatrix *m = GraphEncodeContext_GetEncodedMatrix(ctx);
+
+	while(entries_to_encode > 0) {
+		// unpack next matrix
+		if(m->Ap == NULL) _LoadMatrix(gc, m);
+
+		uint64_t n = MIN(entries_to_encode, m->nvals - m->offset);
+		if(n > 0) {
+			_RdbSaveTile(rdb, gc, m, n);
+			m->offset += n;
+			entries_to_encode -= n;
+		}
+
+		// done with current matrix, advance to the next one
+		if(m->offset == m->nvals) {
+			uint id = GraphEncodeContext_GetCurrentMatrixID(ctx);
+			GraphEncodeContext_ClearEncodedMatrix(ctx);
+			GraphEncodeContext_SetCurrentMatrixID(ctx, id + 1);
+		}
+	}
+}
@@ -217,6 +217,87 @@ void Serializer_Graph_SetEdge
 	}
 }
 
+// sets an edge's attribute-set without connecting the edge
+void Serializer_Graph_SetEdgeAttributes
+(
+	Graph *g,
+	EdgeID edge_id,
+	Edge *e
+) {
+	ASSERT(g != NULL);
+	ASSERT(e != NULL);
+
+	AttributeSet *set = DataBlock_AllocateItemOutOfOrder(g->edges, edge_id);
+	*set = NULL;
+
+	e->id         = edge_id;
+	e->attributes = set;
+}
+
+uint Serializer_Graph_MatrixCount
+(
+	const Graph *g
+) {
+	ASSERT(g != NULL);
+
+	// labels, relations, adjacency and node-labels
+	return Graph_LabelTypeCount(g) + Graph_RelationTypeCount(g) + 2;
+}
+
+RG_Matrix Serializer_Graph_GetMatrix
+(
+	const Graph *g,
+	uint i
+) {
+	ASSERT(g != NULL);
+	ASSERT(i < Serializer_Graph_MatrixCount(g));
+
+	uint label_count = Graph_LabelTypeCount(g);
+	if(i < label_count) return Graph_GetLabelMatrix(g, i);
+	i -= label_count;
+
+	uint relation_count = Graph_RelationTypeCount(g);
+	if(i < relation_count) return Graph_GetRelationMatrix(g, i, false);
+	i -= relation_count;
+
+	if(i == 0) return Graph_GetAdjacencyMatrix(g, false);
+	return Graph_GetNodeLabelMatrix(g);
+}
+
+bool Serializer_Graph_IsRelationMatrix
+(
+	const Graph *g,
+	uint i
+) {
+	ASSERT(g != NULL);
+
+	uint label_count = Graph_LabelTypeCount(g);
+	return (i >= label_count && i < label_count + Graph_RelationTypeCount(g));
+}
+
+uint64_t Serializer_Graph_MatrixEntryCount
+(
+	const Graph *g
+) {
+	ASSERT(g != NULL);
+
+	GrB_Info  info;
+	uint64_t  total = 0;
+	uint      n     = Serializer_Graph_MatrixCount(g);
+
+	UNUSED(info);
+
+	for(uint i = 0; i < n; i++) {
+		GrB_Index nvals;
+		RG_Matrix M = Serializer_Graph_GetMatrix(g, i);
+		info = RG_Matrix_nvals(&nvals, M);
+		ASSERT(info == GrB_SUCCESS);
+		total += nvals;
+	}
+
+	return total;
+}
+
 // returns the graph deleted nodes list
 uint64_t *Serializer_Graph_GetDeletedNodesList
 (
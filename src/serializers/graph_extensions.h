@@ -36,6 +36,43 @@ void Serializer_Graph_SetEdge
 	Edge *e                 // pointer to edge
 );
 
+// sets an edge's attribute-set without connecting the edge
+// used when the graph's matrices are decoded separately
+void Serializer_Graph_SetEdgeAttributes
+(
+	Graph *g,               // graph to add edge to
+	EdgeID edge_id,         // edge ID
+	Edge *e                 // pointer to edge
+);
+
+// number of matrices serialized for the graph
+// label matrices, relation matrices, adjacency matrix and node-labels matrix
+uint Serializer_Graph_MatrixCount
+(
+	const Graph *g
+);
+
+// returns the i'th serialized matrix
+// matrices are ordered: labels, relations, adjacency, node-labels
+RG_Matrix Serializer_Graph_GetMatrix
+(
+	const Graph *g,         // graph to get matrix from
+	uint i                  // matrix position
+);
+
+// returns true if the i'th serialized matrix is a relation matrix
+bool Serializer_Graph_IsRelationMatrix
+(
+	const Graph *g,         // graph
+	uint i                  // matrix position
+);
+
+// total number of entries in all serialized matrices
+uint64_t Serializer_Graph_MatrixEntryCount
+(
+	const Graph *g
+);
+
 // marks a node ID as deleted
 void Serializer_Graph_MarkNodeDeleted
 (
@@ -0,0 +1,472 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "statistics.h"
+#include "../value.h"
+#include "../util/arr.h"
+#include "../util/hll.h"
+#include "../util/rmalloc.h"
+#include "../graph/graphcontext.h"
+#include "../graph/rg_matrix/rg_matrix_iter.h"
+
+#include <stdlib.h>
+
+// statistics are considered stale once the number of nodes and edges
+// changed by more than 1 / STATISTICS_STALE_RATIO since collection
+#define STATISTICS_STALE_RATIO 10
+
+// statistics of a single (label, attribute) pair
+typedef struct {
+	Attribute_ID attr;  // attribute
+	uint64_t count;     // number of sampled nodes holding the attribute
+	uint64_t ndv;       // number of distinct values
+	double *bounds;     // equi-depth histogram bounds, NULL if not collected
+} AttributeStatistics;
+
+// statistics of a single label
+typedef struct {
+	uint64_t sampled;                  // number of sampled nodes
+	AttributeStatistics *attributes;   // attributes statistics
+} LabelStatistics;
+
+struct Statistics {
+	int ref_count;               // number of references
+	uint64_t node_count;         // number of nodes at collection time
+	uint64_t edge_count;         // number of edges at collection time
+	LabelStatistics *labels;     // per label statistics
+	DegreeHistogram *out;        // per relationship-type out degree
+	DegreeHistogram *in;         // per relationship-type in degree
+};
+
+static int _cmp_double
+(
+	const void *a,
+	const void *b
+) {
+	double x = *(const double *)a;
+	double y = *(const double *)b;
+	return (x > y) - (x < y);
+}
+
+//------------------------------------------------------------------------------
+// collection
+//------------------------------------------------------------------------------
+
+// populate degree histogram from a vector of node degrees
+static void _DegreeHistogram_Populate
+(
+	DegreeHistogram *h,  // histogram to populate
+	GrB_Vector deg       // node degrees
+) {
+	GrB_Index nvals;
+	GrB_Info info = GrB_Vector_nvals(&nvals, deg);
+	ASSERT(info == GrB_SUCCESS);
+
+	memset(h, 0, sizeof(DegreeHistogram));
+	if(nvals == 0) return;
+
+	uint64_t *X = rm_malloc(sizeof(uint64_t) * nvals);
+	info = GrB_Vector_extractTuples_UINT64(NULL, X, &nvals, deg);
+	ASSERT(info == GrB_SUCCESS);
+
+	for(GrB_Index i = 0; i < nvals; i++) {
+		uint64_t d = X[i];
+		if(d == 0) continue;
+
+		h->nodes++;
+		h->edges  += d;
+		h->sum_sq += (double)d * d;
+		h->max     = MAX(h->max, d);
+		h->buckets[63 - __builtin_clzll(d)]++;
+	}
+
+	rm_free(X);
+}
+
+// compute out and in degree histograms of relationship-type 'r'
+static void _CollectDegrees
+(
+	const Graph *g,        // graph
+	RelationID r,          // relationship-type
+	DegreeHistogram *out,  // [output] out degree histogram
+	DegreeHistogram *in    // [output] in degree histogram
+) {
+	GrB_Info   info;
+	GrB_Index  n;
+	GrB_Matrix A;
+	GrB_Vector ones;
+	GrB_Vector deg;
+
+	RG_Matrix R = Graph_GetRelationMatrix(g, r, false);
+	info = RG_Matrix_export(&A, R);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Matrix_nrows(&n, A);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Vector_new(&ones, GrB_BOOL, n);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Vector_assign_BOOL(ones, NULL, NULL, true, GrB_ALL, n, NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Vector_new(&deg, GrB_UINT64, n);
+	ASSERT(info == GrB_SUCCESS);
+
+	// out degree, number of entries in each row
+	info = GrB_mxv(deg, NULL, NULL, GxB_PLUS_PAIR_UINT64, A, ones, NULL);
+	ASSERT(info == GrB_SUCCESS);
+	_DegreeHistogram_Populate(out, deg);
+
+	// in degree, number of entries in each column
+	info = GrB_mxv(deg, NULL, NULL, GxB_PLUS_PAIR_UINT64, A, ones,
+			GrB_DESC_T0);
+	ASSERT(info == GrB_SUCCESS);
+	_DegreeHistogram_Populate(in, deg);
+
+	GrB_free(&deg);
+	GrB_free(&ones);
+	GrB_free(&A);
+}
+
+// build an equi-depth histogram from 'values'
+static double *_BuildValueHistogram
+(
+	double *values  // sampled values, sorted in place
+) {
+	uint n = array_len(values);
+	if(n == 0) return NULL;
+
+	qsort(values, n, sizeof(double), _cmp_double);
+
+	double *bounds = rm_malloc(sizeof(double) * (STATISTICS_VALUE_BUCKETS + 1));
+	for(uint i = 0; i <= STATISTICS_VALUE_BUCKETS; i++) {
+		bounds[i] = values[((uint64_t)(n - 1) * i) / STATISTICS_VALUE_BUCKETS];
+	}
+
+	return bounds;
+}
+
+// sample nodes of label 'l' collecting attribute statistics
+static void _CollectLabel
+(
+	GraphContext *gc,     // graph context
+	LabelID l,            // label to sample
+	uint attr_count,      // number of attributes in graph
+	LabelStatistics *ls   // [output] label statistics
+) {
+	Graph *g = gc->g;
+
+	ls->sampled    = 0;
+	ls->attributes = array_new(AttributeStatistics, 0);
+
+	// lazily allocated per attribute distinct value estimators
+	HLL      **hlls    = rm_calloc(attr_count, sizeof(HLL *));
+	uint64_t *counts   = rm_calloc(attr_count, sizeof(uint64_t));
+	double   **values  = rm_calloc(attr_count, sizeof(double *));
+
+	// collect values of indexed attributes
+	Index idx = GraphContext_GetIndexByID(gc, l, NULL, 0, IDX_EXACT_MATCH,
+			GETYPE_NODE);
+	if(idx != NULL) {
+		uint n = Index_FieldsCount(idx);
+		const IndexField *fields = Index_GetFields(idx);
+		for(uint i = 0; i < n; i++) {
+			if(fields[i].id < attr_count) {
+				values[fields[i].id] = array_new(double, 0);
+			}
+		}
+	}
+
+	// sample label
+	GrB_Index id;
+	RG_MatrixTupleIter it;
+	RG_Matrix L = Graph_GetLabelMatrix(g, l);
+	RG_MatrixTupleIter_attach(&it, L);
+
+	while(ls->sampled < STATISTICS_SAMPLE_SIZE &&
+		  RG_MatrixTupleIter_next_BOOL(&it, &id, NULL, NULL) == GrB_SUCCESS) {
+		Node n;
+		if(!Graph_GetNode(g, id, &n)) continue;
+
+		ls->sampled++;
+		AttributeSet set = GraphEntity_GetAttributes((GraphEntity *)&n);
+		uint16_t count = AttributeSet_Count(set);
+
+		for(uint16_t i = 0; i < count; i++) {
+			Attribute_ID attr;
+			SIValue v = AttributeSet_GetIdx(set, i, &attr);
+			if(attr >= attr_count) continue;
+
+			if(hlls[attr] == NULL) {
+				hlls[attr] = rm_malloc(sizeof(HLL));
+				HLL_Init(hlls[attr]);
+			}
+
+			counts[attr]++;
+			HLL_Add(hlls[attr], SIValue_HashCode(v));
+
+			if(values[attr] != NULL && (SI_TYPE(v) & SI_NUMERIC)) {
+				array_append(values[attr], SI_GET_NUMERIC(v));
+			}
+		}
+	}
+
+	RG_MatrixTupleIter_detach(&it);
+
+	// scale sample to label cardinality
+	uint64_t label_count = Graph_LabeledNodeCount(g, l);
+	double scale = (ls->sampled > 0) ? (double)label_count / ls->sampled : 1;
+
+	for(uint attr = 0; attr < attr_count; attr++) {
+		if(hlls[attr] == NULL) continue;
+
+		uint64_t ndv = HLL_Count(hlls[attr]);
+
+		// a sampled attribute which is mostly unique is assumed to remain
+		// unique across the entire label, otherwise the sampled number
+		// of distinct values is kept as is
+		if(scale > 1 && ndv * 2 > counts[attr]) {
+			ndv = (uint64_t)(ndv * scale);
+		}
+		ndv = MAX(ndv, 1);
+
+		AttributeStatistics as = {
+			.attr   = attr,
+			.count  = counts[attr],
+			.ndv    = ndv,
+			.bounds = NULL
+		};
+
+		if(values[attr] != NULL) {
+			as.bounds = _BuildValueHistogram(values[attr]);
+		}
+
+		array_append(ls->attributes, as);
+		rm_free(hlls[attr]);
+	}
+
+	for(uint attr = 0; attr < attr_count; attr++) {
+		if(values[attr] != NULL) array_free(values[attr]);
+	}
+
+	rm_free(hlls);
+	rm_free(counts);
+	rm_free(values);
+}
+
+Statistics *Statistics_Collect
+(
+	GraphContext *gc
+) {
+	ASSERT(gc != NULL);
+
+	Graph *g = gc->g;
+	uint label_count    = Graph_LabelTypeCount(g);
+	uint relation_count = Graph_RelationTypeCount(g);
+	uint attr_count     = GraphContext_AttributeCount(gc);
+
+	Statistics *s = rm_malloc(sizeof(Statistics));
+
+	s->ref_count  = 1;
+	s->node_count = Graph_NodeCount(g);
+	s->edge_count = Graph_EdgeCount(g);
+	s->labels     = array_newlen(LabelStatistics, label_count);
+	s->out        = array_newlen(DegreeHistogram, relation_count);
+	s->in         = array_newlen(DegreeHistogram, relation_count);
+
+	for(RelationID r = 0; r < relation_count; r++) {
+		_CollectDegrees(g, r, s->out + r, s->in + r);
+	}
+
+	for(LabelID l = 0; l < label_count; l++) {
+		_CollectLabel(gc, l, attr_count, s->labels + l);
+	}
+
+	return s;
+}
+
+bool Statistics_Stale
+(
+	const Statistics *s,
+	const Graph *g
+) {
+	ASSERT(g != NULL);
+
+	uint64_t node_count = Graph_NodeCount(g);
+	uint64_t edge_count = Graph_EdgeCount(g);
+
+	// small graphs are cheap to plan for regardless of the chosen order
+	if(node_count + edge_count < STATISTICS_MIN_ENTITY_COUNT) return false;
+
+	if(s == NULL) return true;
+
+	uint64_t total = s->node_count + s->edge_count;
+	uint64_t delta = (node_count > s->node_count)
+		? node_count - s->node_count
+		: s->node_count - node_count;
+	delta += (edge_count > s->edge_count)
+		? edge_count - s->edge_count
+		: s->edge_count - edge_count;
+
+	return delta * STATISTICS_STALE_RATIO > total;
+}
+
+//------------------------------------------------------------------------------
+// accessors
+//------------------------------------------------------------------------------
+
+static const AttributeStatistics *_GetAttributeStatistics
+(
+	const Statistics *s,
+	LabelID l,
+	Attribute_ID attr
+) {
+	if(l < 0 || (uint)l >= array_len(s->labels)) return NULL;
+
+	const LabelStatistics *ls = s->labels + l;
+	uint n = array_len(ls->attributes);
+	for(uint i = 0; i < n; i++) {
+		if(ls->attributes[i].attr == attr) return ls->attributes + i;
+	}
+
+	return NULL;
+}
+
+const DegreeHistogram *Statistics_DegreeHistogram
+(
+	const Statistics *s,
+	RelationID r,
+	bool incoming
+) {
+	ASSERT(s != NULL);
+
+	if(r < 0 || (uint)r >= array_len(s->out)) return NULL;
+
+	return (incoming) ? s->in + r : s->out + r;
+}
+
+bool Statistics_DistinctValues
+(
+	const Statistics *s,
+	LabelID l,
+	Attribute_ID attr,
+	uint64_t *ndv,
+	double *presence
+) {
+	ASSERT(s        != NULL);
+	ASSERT(ndv      != NULL);
+	ASSERT(presence != NULL);
+
+	if(l < 0 || (uint)l >= array_len(s->labels)) return false;
+
+	const LabelStatistics *ls = s->labels + l;
+	if(ls->sampled == 0) return false;
+
+	// attribute not encountered while sampling
+	const AttributeStatistics *as = _GetAttributeStatistics(s, l, attr);
+	if(as == NULL) {
+		*ndv      = 0;
+		*presence = 0;
+		return true;
+	}
+
+	*ndv      = as->ndv;
+	*presence = (double)as->count / ls->sampled;
+	return true;
+}
+
+bool Statistics_FractionBelow
+(
+	const Statistics *s,
+	LabelID l,
+	Attribute_ID attr,
+	double v,
+	double *fraction
+) {
+	ASSERT(s        != NULL);
+	ASSERT(fraction != NULL);
+
+	const AttributeStatistics *as = _GetAttributeStatistics(s, l, attr);
+	if(as == NULL || as->bounds == NULL) return false;
+
+	const double *b = as->bounds;
+	if(v <= b[0]) {
+		*fraction = 0;
+		return true;
+	}
+
+	if(v > b[STATISTICS_VALUE_BUCKETS]) {
+		*fraction = 1;
+		return true;
+	}
+
+	// locate bucket containing 'v' and interpolate within it
+	uint i = 0;
+	while(i < STATISTICS_VALUE_BUCKETS - 1 && v > b[i + 1]) i++;
+
+	double width = b[i + 1] - b[i];
+	double within = (width > 0) ? (v - b[i]) / width : 0;
+	*fraction = (i + within) / STATISTICS_VALUE_BUCKETS;
+
+	return true;
+}
+
+double DegreeHistogram_Mean
+(
+	const DegreeHistogram *h
+) {
+	ASSERT(h != NULL);
+	return (h->nodes > 0) ? (double)h->edges / h->nodes : 0;
+}
+
+double DegreeHistogram_WeightedMean
+(
+	const DegreeHistogram *h
+) {
+	ASSERT(h != NULL);
+	return (h->edges > 0) ? h->sum_sq / h->edges : 0;
+}
+
+//------------------------------------------------------------------------------
+// lifecycle
+//------------------------------------------------------------------------------
+
+Statistics *Statistics_Share
+(
+	Statistics *s
+) {
+	ASSERT(s != NULL);
+	__atomic_fetch_add(&s->ref_count, 1, __ATOMIC_RELAXED);
+	return s;
+}
+
+void Statistics_Free
+(
+	Statistics *s
+) {
+	ASSERT(s != NULL);
+
+	if(__atomic_sub_fetch(&s->ref_count, 1, __ATOMIC_RELAXED) > 0) return;
+
+	uint label_count = array_len(s->labels);
+	for(uint i = 0; i < label_count; i++) {
+		LabelStatistics *ls = s->labels + i;
+		uint n = array_len(ls->attributes);
+		for(uint j = 0; j < n; j++) {
+			if(ls->attributes[j].bounds != NULL) {
+				rm_free(ls->attributes[j].bounds);
+			}
+		}
+		array_free(ls->attributes);
+	}
+
+	array_free(s->labels);
+	array_free(s->out);
+	array_free(s->in);
+	rm_free(s);
+}
+
@@ -0,0 +1,129 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "../graph/graphcontext.h"
+#include "../graph/entities/attribute_set.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// statistics is an immutable snapshot of data distribution within a graph
+// consulted by the optimizer's cost model, it holds:
+//
+// 1. per relationship-type out / in degree histograms
+// 2. per (label, attribute) distinct value estimates
+// 3. per (label, attribute) equi-depth value histograms for indexed
+//    numeric attributes
+//
+// label and relationship-type cardinalities are not part of the snapshot
+// as these are maintained by the graph itself on every write
+//
+// a snapshot is collected under the graph's READ lock
+// and is refreshed by a CRON task once the graph changed sufficiently
+
+// number of degree histogram buckets
+// bucket i counts nodes with degree in [2^i, 2^(i+1))
+#define STATISTICS_DEGREE_BUCKETS 64
+
+// number of buckets in an equi-depth value histogram
+#define STATISTICS_VALUE_BUCKETS 32
+
+// max number of nodes sampled per label
+#define STATISTICS_SAMPLE_SIZE 100000
+
+// graphs with fewer entities than this are not collected statistics for
+#define STATISTICS_MIN_ENTITY_COUNT 10000
+
+typedef struct {
+	uint64_t nodes;     // number of nodes with at least one connection
+	uint64_t edges;     // number of connections
+	uint64_t max;       // max degree
+	double sum_sq;      // sum of squared degrees
+	uint64_t buckets[STATISTICS_DEGREE_BUCKETS];  // log2 degree histogram
+} DegreeHistogram;
+
+typedef struct Statistics Statistics;
+
+// collect statistics for graph
+// caller must hold the graph's READ lock
+Statistics *Statistics_Collect
+(
+	GraphContext *gc  // graph to collect statistics for
+);
+
+// returns true if statistics no longer reflect the graph
+// 's' can be NULL, in which case statistics are considered stale
+// unless the graph is smaller than STATISTICS_MIN_ENTITY_COUNT
+bool Statistics_Stale
+(
+	const Statistics *s,  // statistics
+	const Graph *g        // graph
+);
+
+// get relationship-type degree histogram
+// returns NULL if relationship-type isn't covered by the statistics
+const DegreeHistogram *Statistics_DegreeHistogram
+(
+	const Statistics *s,  // statistics
+	RelationID r,         // relationship-type
+	bool incoming         // in degree if true, out degree otherwise
+);
+
+// get the number of distinct values of attribute 'attr'
+// among nodes of label 'l'
+// 'presence' is set to the fraction of nodes holding the attribute
+// returns false if no estimate is available
+bool Statistics_DistinctValues
+(
+	const Statistics *s,   // statistics
+	LabelID l,             // label
+	Attribute_ID attr,     // attribute
+	uint64_t *ndv,         // [output] number of distinct values
+	double *presence       // [output] fraction of nodes holding attribute
+);
+
+// estimate the fraction of numeric values of attribute 'attr'
+// among nodes of label 'l' which are smaller than 'v'
+// only available for indexed numeric attributes
+// returns false if no estimate is available
+bool Statistics_FractionBelow
+(
+	const Statistics *s,  // statistics
+	LabelID l,            // label
+	Attribute_ID attr,    // attribute
+	double v,             // value
+	double *fraction      // [output] fraction of values smaller than 'v'
+);
+
+// average degree of a node with at least one connection
+double DegreeHistogram_Mean
+(
+	const DegreeHistogram *h  // degree histogram
+);
+
+// average degree of a node reached by following a random connection
+// on skewed distributions this is much larger than the mean
+// as high degree nodes are more likely to be reached
+double DegreeHistogram_WeightedMean
+(
+	const DegreeHistogram *h  // degree histogram
+);
+
+// increase statistics reference count
+Statistics *Statistics_Share
+(
+	Statistics *s  // statistics
+);
+
+// decrease statistics reference count
+// frees statistics once reference count reaches 0
+void Statistics_Free
+(
+	Statistics *s  // statistics
+);
+
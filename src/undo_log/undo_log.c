@@ -378,6 +378,46 @@ void UndoLog_CreateEdge
 	UNDOLOG_ADD_OP(log, op);
 }
 
+// undo creation of multiple nodes
+void UndoLog_CreateNodes
+(
+	UndoLog log,           // undo log
+	Node **nodes,          // nodes created
+	uint n                 // number of nodes
+) {
+	ASSERT(log != NULL);
+	ASSERT(nodes != NULL || n == 0);
+
+	UndoOp op;
+	op.type = UNDO_CREATE_NODE;
+
+	// consecutive creations are rolled back as a single batch
+	for(uint i = 0; i < n; i++) {
+		op.create_op.n = *nodes[i];
+		UNDOLOG_ADD_OP(log, op);
+	}
+}
+
+// undo creation of multiple edges
+void UndoLog_CreateEdges
+(
+	UndoLog log,           // undo log
+	Edge **edges,          // edges created
+	uint n                 // number of edges
+) {
+	ASSERT(log != NULL);
+	ASSERT(edges != NULL || n == 0);
+
+	UndoOp op;
+	op.type = UNDO_CREATE_EDGE;
+
+	// consecutive creations are rolled back as a single batch
+	for(uint i = 0; i < n; i++) {
+		op.create_op.e = *edges[i];
+		UNDOLOG_ADD_OP(log, op);
+	}
+}
+
 // undo node deletion
 void UndoLog_DeleteNode
 (
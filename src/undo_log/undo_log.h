@@ -138,6 +138,22 @@ void UndoLog_CreateEdge
 	Edge *edge     // edge created
 );
 
+// undo creation of multiple nodes
+void UndoLog_CreateNodes
+(
+	UndoLog log,   // undo log
+	Node **nodes,  // nodes created
+	uint n         // number of nodes
+);
+
+// undo creation of multiple edges
+void UndoLog_CreateEdges
+(
+	UndoLog log,   // undo log
+	Edge **edges,  // edges created
+	uint n         // number of edges
+);
+
 // undo node deletion
 void UndoLog_DeleteNode
 (
@@ -10,12 +10,76 @@
 #include "cache_array.h"
 #include <pthread.h>
 
-static CacheEntry *_CacheEvictLRU(Cache *cache) {
-	CacheEntry *entry = CacheArray_FindMinLRU(cache->arr, cache->cap);
+// calling thread's read shard, assigned on first use
+static __thread int _thread_shard = -1;
+
+// number of threads assigned a read shard
+static uint _shard_counter = 0;
+
+// returns the calling thread's read shard
+static inline CacheReadShard *_Cache_ReadShard(const Cache *cache) {
+	if(unlikely(_thread_shard == -1)) {
+		// assign shards round robin, such that up to CACHE_READ_SHARDS
+		// threads never share a shard
+		_thread_shard = __atomic_fetch_add(&_shard_counter, 1,
+				__ATOMIC_RELAXED) % CACHE_READ_SHARDS;
+	}
+	return cache->shards + _thread_shard;
+}
+
+// acquire the calling thread's read shard
+static CacheReadShard *_Cache_ReadLock(Cache *cache) {
+	CacheReadShard *shard = _Cache_ReadShard(cache);
+
+	int res = pthread_rwlock_rdlock(&shard->lock);
+	UNUSED(res);
+	ASSERT(res == 0);
+
+	return shard;
+}
+
+static void _Cache_ReadUnlock(CacheReadShard *shard) {
+	int res = pthread_rwlock_unlock(&shard->lock);
+	UNUSED(res);
+	ASSERT(res == 0);
+}
+
+// acquire all read shards for writing, excluding every reader
+static void _Cache_WriteLock(Cache *cache) {
+	// shards are always acquired in the same order to avoid deadlocks
+	for(uint i = 0; i < CACHE_READ_SHARDS; i++) {
+		int res = pthread_rwlock_wrlock(&cache->shards[i].lock);
+		UNUSED(res);
+		ASSERT(res == 0);
+	}
+}
+
+static void _Cache_WriteUnlock(Cache *cache) {
+	for(int i = CACHE_READ_SHARDS - 1; i >= 0; i--) {
+		int res = pthread_rwlock_unlock(&cache->shards[i].lock);
+		UNUSED(res);
+		ASSERT(res == 0);
+	}
+}
+
+// returns true if key is cached, acquires only the calling thread's shard
+static bool _Cache_Contains(Cache *cache, const char *key, size_t key_len) {
+	CacheReadShard *shard = _Cache_ReadLock(cache);
+	bool found = raxFind(cache->lookup, (unsigned char *)key, key_len) !=
+		raxNotFound;
+	_Cache_ReadUnlock(shard);
+
+	return found;
+}
+
+static CacheEntry *_CacheEvict(Cache *cache) {
+	CacheEntry *entry = CacheArray_ClockEvict(cache->arr, cache->cap,
+			&cache->hand);
 	// Remove evicted element from the rax.
 	raxRemove(cache->lookup, (unsigned  char *)entry->key,
 	  strlen(entry->key), NULL);
 	CacheArray_CleanEntry(entry, cache->free_item);
+	__atomic_fetch_add(&cache->evictions, 1, __ATOMIC_RELAXED);
 
 	return entry;
 }
@@ -34,9 +98,9 @@ static bool _Cache_SetValue(Cache *cache, const char *key, void *value,
 
 	// key is not in cache! test to see if cache is full?
 	if(cache->size == cache->cap) {
-		/* the cache is full, evict the least-recently-used element
+		/* the cache is full, evict an element which wasn't used recently
 		 * and reuse its space for the new element */
-		entry = _CacheEvictLRU(cache);
+		entry = _CacheEvict(cache);
 	} else {
 		// the array has space left in it, use the next available entry
 		entry = cache->arr + cache->size++;
@@ -44,9 +108,7 @@ static bool _Cache_SetValue(Cache *cache, const char *key, void *value,
 
 	// populate the entry
 	char *k = rm_strdup(key);
-	cache->counter++;
-	CacheArray_PopulateEntry(cache->counter, entry, k, value);
-
+	CacheArray_PopulateEntry(entry, k, value);
 
 	// Add the new entry to the rax.
 	raxInsert(cache->lookup, (unsigned char *)key, key_len, entry, NULL);
@@ -61,16 +123,20 @@ Cache *Cache_New(uint cap, CacheEntryFreeFunc freeFunc, CacheEntryCopyFunc copyF
 	Cache *cache     = rm_malloc(sizeof(Cache));
 	cache->cap       = cap;
 	cache->size      = 0;
+	cache->hand      = 0;
 	cache->lookup    = raxNew();       // Instantiate key entry mapping.
-	cache->counter   = 0;             // Initialize counter to zero.
 	cache->copy_item = copyFunc;
 	cache->free_item = freeFunc;
+	cache->evictions = 0;
 	cache->arr = rm_calloc(cap, sizeof(CacheEntry)); // Array of cached values.
 
-	// Initialize the read-write lock to protect access to the cache.
-	int res = pthread_rwlock_init(&cache->_cache_rwlock, NULL);
-	UNUSED(res);
-	ASSERT(res == 0);
+	// Initialize the read-write locks to protect access to the cache.
+	cache->shards = rm_calloc(CACHE_READ_SHARDS, sizeof(CacheReadShard));
+	for(uint i = 0; i < CACHE_READ_SHARDS; i++) {
+		int res = pthread_rwlock_init(&cache->shards[i].lock, NULL);
+		UNUSED(res);
+		ASSERT(res == 0);
+	}
 
 	return cache;
 }
@@ -80,45 +146,52 @@ void *Cache_GetValue(Cache *cache, const char *key) {
 
 	ASSERT(cache != NULL);
 
-	int res = pthread_rwlock_rdlock(&cache->_cache_rwlock);
-	UNUSED(res);
-	ASSERT(res == 0);
+	CacheReadShard *shard = _Cache_ReadLock(cache);
 
 	size_t key_len = strlen(key);
 	CacheEntry *entry = raxFind(cache->lookup, (unsigned char *)key, key_len);
 
-	if(entry == raxNotFound) goto cleanup;
+	// counters are only contended by threads sharing a shard
+	if(entry == raxNotFound) {
+		__atomic_fetch_add(&shard->stats.misses, 1, __ATOMIC_RELAXED);
+		goto cleanup;
+	}
+
+	__atomic_fetch_add(&shard->stats.hits, 1, __ATOMIC_RELAXED);
 
-	// element is now the most recently used; update its LRU
-	// note that multiple threads can be here simultaneously
-	cache->counter++;
-	entry->LRU = cache->counter;
+	// mark element as recently used
+	// avoid writing to the entry if it is already marked, such that
+	// concurrent readers of a popular entry don't invalidate its cache line
+	if(!__atomic_load_n(&entry->referenced, __ATOMIC_RELAXED)) {
+		__atomic_store_n(&entry->referenced, true, __ATOMIC_RELAXED);
+	}
 
 	// return a copy of element
 	item = cache->copy_item(entry->value);
 
 cleanup:
-	res = pthread_rwlock_unlock(&cache->_cache_rwlock);
-	ASSERT(res == 0);
+	_Cache_ReadUnlock(shard);
 	return item;
 }
 
-void Cache_SetValue(Cache *cache, const char *key, void *value) {
+bool Cache_SetValue(Cache *cache, const char *key, void *value) {
 	ASSERT(key != NULL);
 	ASSERT(cache != NULL);
 
 	size_t key_len = strlen(key);
 
+	// threads racing to cache the same key only take the read lock
+	if(_Cache_Contains(cache, key, key_len)) return false;
+
 	// Acquire WRITE lock
-	int res = pthread_rwlock_wrlock(&cache->_cache_rwlock);
-	UNUSED(res);
-	ASSERT(res == 0);
+	_Cache_WriteLock(cache);
 
 	// Insert the value to the cache.
-	_Cache_SetValue(cache, key, value, key_len);
+	bool added = _Cache_SetValue(cache, key, value, key_len);
 
-	res = pthread_rwlock_unlock(&cache->_cache_rwlock);
-	ASSERT(res == 0);
+	_Cache_WriteUnlock(cache);
+
+	return added;
 }
 
 void *Cache_SetGetValue(Cache *cache, const char *key, void *value) {
@@ -128,10 +201,11 @@ void *Cache_SetGetValue(Cache *cache, const char *key, void *value) {
 	size_t key_len = strlen(key);
 	void *value_to_return = value;
 
+	// threads racing to cache the same key only take the read lock
+	if(_Cache_Contains(cache, key, key_len)) return value_to_return;
+
 	// acquire WRITE lock
-	int res = pthread_rwlock_wrlock(&cache->_cache_rwlock);
-	UNUSED(res);
-	ASSERT(res == 0);
+	_Cache_WriteLock(cache);
 
 	// return true if value was added, false if value already in cache
 	if(_Cache_SetValue(cache, key, value, key_len)) {
@@ -139,12 +213,47 @@ void *Cache_SetGetValue(Cache *cache, const char *key, void *value) {
 		value_to_return = cache->copy_item(value);
 	}
 
-	res = pthread_rwlock_unlock(&cache->_cache_rwlock);
-	ASSERT(res == 0);
+	_Cache_WriteUnlock(cache);
 
 	return value_to_return;
 }
 
+void Cache_GetStats(const Cache *cache, CacheStats *stats) {
+	ASSERT(cache != NULL);
+	ASSERT(stats != NULL);
+
+	stats->hits      = 0;
+	stats->misses    = 0;
+	stats->evictions = __atomic_load_n(&cache->evictions, __ATOMIC_RELAXED);
+
+	// sum counters across shards
+	for(uint i = 0; i < CACHE_READ_SHARDS; i++) {
+		const CacheStats *shard_stats = &cache->shards[i].stats;
+		stats->hits   += __atomic_load_n(&shard_stats->hits, __ATOMIC_RELAXED);
+		stats->misses += __atomic_load_n(&shard_stats->misses,
+				__ATOMIC_RELAXED);
+	}
+}
+
+void Cache_Clear(Cache *cache) {
+	ASSERT(cache != NULL);
+
+	// acquire WRITE lock
+	_Cache_WriteLock(cache);
+
+	// free cache entries
+	for(size_t i = 0; i < cache->size; i++) {
+		CacheArray_CleanEntry(cache->arr + i, cache->free_item);
+	}
+
+	raxFree(cache->lookup);
+	cache->lookup = raxNew();
+	cache->size   = 0;
+	cache->hand   = 0;
+
+	_Cache_WriteUnlock(cache);
+}
+
 void Cache_Free(Cache *cache) {
 	ASSERT(cache != NULL);
 
@@ -158,9 +267,12 @@ void Cache_Free(Cache *cache) {
 	rm_free(cache->arr);
 	raxFree(cache->lookup);
 
-	int res = pthread_rwlock_destroy(&cache->_cache_rwlock);
-	UNUSED(res);
-	ASSERT(res == 0);
+	for(uint i = 0; i < CACHE_READ_SHARDS; i++) {
+		int res = pthread_rwlock_destroy(&cache->shards[i].lock);
+		UNUSED(res);
+		ASSERT(res == 0);
+	}
+	rm_free(cache->shards);
 
 	rm_free(cache);
 }
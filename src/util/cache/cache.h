@@ -8,20 +8,49 @@
 
 #include "cache_array.h"
 #include "rax.h"
+#include <pthread.h>
 
 /**
- * @brief Key-value cache, uses LRU policy for eviction.
+ * @brief Cache usage counters.
+ */
+typedef struct CacheStats {
+	uint64_t hits;       // Number of lookups which found their key.
+	uint64_t misses;     // Number of lookups which didn't find their key.
+	uint64_t evictions;  // Number of entries evicted to make room for new ones.
+} CacheStats;
+
+// number of read locks a cache is sharded into
+// each thread acquires a single shard when reading
+#define CACHE_READ_SHARDS 64
+
+/**
+ * @brief A read lock shard, along with the usage counters of its readers.
+ * Padded such that the fields of distinct shards don't share a cache line.
+ */
+typedef union CacheReadShard {
+	struct {
+		pthread_rwlock_t lock;  // Acquired for read by the shard's threads.
+		CacheStats stats;       // Hits and misses of the shard's threads.
+	};
+	char _pad[192];
+} CacheReadShard;
+
+/**
+ * @brief Key-value cache, uses CLOCK policy (approximate LRU) for eviction.
+ * Readers acquire only their own shard's read lock, such that concurrent
+ * lookups don't contend on a shared lock, writers acquire all shards.
  * Assumes owership over stored objects.
  */
 typedef struct Cache {
 	uint cap;                          // Cache capacity.
 	uint size;                         // Cache current size.
-	long long counter;                 // Atomic counter for number of reads.
+	uint hand;                         // CLOCK hand, next eviction candidate.
 	rax *lookup;                       // Mapping between keys to entries, for fast lookups.
 	CacheEntry *arr;                   // Array of cache elements.
 	CacheEntryFreeFunc free_item;      // Callback function that free cached value.
 	CacheEntryCopyFunc copy_item;      // Callback function that copies cached value.
-	pthread_rwlock_t _cache_rwlock;    // Read-write lock to protect access to the cache.
+	CacheReadShard *shards;            // Read lock shards.
+	uint64_t evictions;                // Number of evicted entries.
 } Cache;
 
 /**
@@ -47,8 +76,10 @@ void *Cache_GetValue(Cache *cache, const char *key);
  * @param  *cache: cache pointer.
  * @param  *key: Key for associating with value.
  * @param  *value: pointer with the relevant value.
+ * @retval true if value was stored, false if key is already cached,
+ *         in which case the caller retains ownership over value.
  */
-void Cache_SetValue(Cache *cache, const char *key, void *item);
+bool Cache_SetValue(Cache *cache, const char *key, void *item);
 
 /**
  * @brief  Stores value under key within the cache, and return a copy of that value.
@@ -60,6 +91,19 @@ void Cache_SetValue(Cache *cache, const char *key, void *item);
  */
 void *Cache_SetGetValue(Cache *cache, const char *key, void *value);
 
+/**
+ * @brief  Retrieves cache usage counters.
+ * @param  *cache: cache pointer
+ * @param  *stats: [output] usage counters
+ */
+void Cache_GetStats(const Cache *cache, CacheStats *stats);
+
+/**
+ * @brief  Removes and frees all stored items.
+ * @param  *cache: cache pointer
+ */
+void Cache_Clear(Cache *cache);
+
 /**
  * @brief  Destroys the cache and free all stored items.
  * @param  *cache: cache pointer
@@ -8,27 +8,27 @@
 #include "../rmalloc.h"
 #include "../../RG.h"
 
-CacheEntry *CacheArray_FindMinLRU(CacheEntry *cache_arr, uint cap) {
+CacheEntry *CacheArray_ClockEvict(CacheEntry *cache_arr, uint cap, uint *hand) {
+	ASSERT(hand != NULL);
 	ASSERT(cache_arr != NULL);
 
-	CacheEntry *min_LRU_entry = cache_arr;
-
-	for(size_t i = 1; i < cap; i++) {
-		CacheEntry *current_entry = cache_arr + i;
-		if(current_entry->LRU < min_LRU_entry->LRU) {
-			min_LRU_entry = current_entry;
-		}
+	// give referenced entries a second chance
+	// terminates within two rounds, as every visited entry is unreferenced
+	while(cache_arr[*hand].referenced) {
+		cache_arr[*hand].referenced = false;
+		*hand = (*hand + 1) % cap;
 	}
 
-	return min_LRU_entry;
-}
+	CacheEntry *victim = cache_arr + *hand;
+	*hand = (*hand + 1) % cap;
 
-CacheEntry *CacheArray_PopulateEntry(long long counter, CacheEntry *entry, char *key,
-  									void *value) {
+	return victim;
+}
 
-	entry->key   = key;
-	entry->value = value;
-	entry->LRU   = counter;
+CacheEntry *CacheArray_PopulateEntry(CacheEntry *entry, char *key, void *value) {
+	entry->key        = key;
+	entry->value      = value;
+	entry->referenced = true;
 
 	return entry;
 }
@@ -47,6 +47,6 @@ void CacheArray_CleanEntry(CacheEntry *entry, CacheEntryFreeFunc free_entry) {
 		entry->value = NULL;
 	}
 
-	entry->LRU = 0;
+	entry->referenced = false;
 }
 
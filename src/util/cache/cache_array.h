@@ -27,16 +27,17 @@ typedef void *(*CacheEntryCopyFunc)(void *);
 typedef struct CacheEntry_t {
 	char *key;      // Entry key.
 	void *value;    // Entry stored value.
-	long long LRU;  // Indicates the time when the entry was last recently used.
+	bool referenced;  // CLOCK reference bit, set whenever the entry is accessed.
 } CacheEntry;
 
 
-// Returns a pointer to the entry in the cache array with the minimum LRU.
-CacheEntry *CacheArray_FindMinLRU(CacheEntry *cache_arr, uint cap);
+// Advances the CLOCK hand until an entry which wasn't referenced since the
+// last sweep is found, clearing reference bits along the way.
+// Returns a pointer to that entry.
+CacheEntry *CacheArray_ClockEvict(CacheEntry *cache_arr, uint cap, uint *hand);
 
 // Assign new values to the fields of a cache entry.
-CacheEntry *CacheArray_PopulateEntry(long long counter, CacheEntry *entry, char *key,
-  			void *value);
+CacheEntry *CacheArray_PopulateEntry(CacheEntry *entry, char *key, void *value);
 
 // Free the fields of a cache entry to prepare it for reuse.
 void CacheArray_CleanEntry(CacheEntry *entry, CacheEntryFreeFunc free_entry);
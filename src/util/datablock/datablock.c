@@ -10,7 +10,9 @@
 #include "../arr.h"
 #include "../rmalloc.h"
 #include <math.h>
+#include <string.h>
 #include <stdbool.h>
+#include <sys/param.h>
 
 // computes the number of blocks required to accommodate n items.
 #define ITEM_COUNT_TO_BLOCK_COUNT(n, cap) \
@@ -28,6 +30,44 @@
 #define GET_ITEM_BLOCK(dataBlock, idx) \
     dataBlock->blocks[ITEM_INDEX_TO_BLOCK_INDEX(idx, dataBlock->blockCap)]
 
+// number of words in a bitmap holding a bit per block
+#define DIRTY_BLOCKS_WORDS(blockCount) (((blockCount) + 63) / 64)
+
+// checks if block 'i' holds new deletions
+#define BLOCK_IS_DIRTY(dataBlock, i) \
+	(((dataBlock)->dirtyBlocks[(i) >> 6] >> ((i) & 63)) & 1)
+
+// marks block 'i' as holding new deletions
+#define MARK_BLOCK_DIRTY(dataBlock, i) \
+	((dataBlock)->dirtyBlocks[(i) >> 6] |= (1ULL << ((i) & 63)))
+
+// marks block 'i' as clean
+#define MARK_BLOCK_CLEAN(dataBlock, i) \
+	((dataBlock)->dirtyBlocks[(i) >> 6] &= ~(1ULL << ((i) & 63)))
+
+// number of bytes allocated for a single block
+#define BLOCK_BYTE_SIZE(dataBlock)                          \
+	(sizeof(Block) + DATABLOCK_BITMAP_SIZE(dataBlock->blockCap) + \
+	 dataBlock->blockCap * dataBlock->itemSize)
+
+// allocates a zeroed block
+// unless 'deleted' is set, all of its items are considered not deleted
+static Block *_DataBlock_NewBlock
+(
+	const DataBlock *dataBlock,
+	bool deleted
+) {
+	Block *block = rm_calloc(1, BLOCK_BYTE_SIZE(dataBlock));
+	block->itemSize = dataBlock->itemSize;
+
+	if(deleted) {
+		memset(DATABLOCK_BITMAP(block), 0xFF,
+				DATABLOCK_BITMAP_SIZE(dataBlock->blockCap));
+	}
+
+	return block;
+}
+
 static void _DataBlock_AddBlocks
 (
 	DataBlock *dataBlock,
@@ -43,12 +83,22 @@ static void _DataBlock_AddBlocks
 	else
 		dataBlock->blocks = rm_realloc(dataBlock->blocks, sizeof(Block *) * dataBlock->blockCount);
 
-	uint i;
-	for(i = prevBlockCount; i < dataBlock->blockCount; i++) {
-		dataBlock->blocks[i] = Block_New(dataBlock->itemSize, dataBlock->blockCap);
-		if(i > 0) dataBlock->blocks[i - 1]->next = dataBlock->blocks[i];
+	for(uint i = prevBlockCount; i < dataBlock->blockCount; i++) {
+		dataBlock->blocks[i] = _DataBlock_NewBlock(dataBlock, false);
+	}
+
+	// new blocks hold no deletions
+	uint prevWords = DIRTY_BLOCKS_WORDS(prevBlockCount);
+	uint words     = DIRTY_BLOCKS_WORDS(dataBlock->blockCount);
+	if(words > prevWords) {
+		if(!dataBlock->dirtyBlocks)
+			dataBlock->dirtyBlocks = rm_malloc(sizeof(uint64_t) * words);
+		else
+			dataBlock->dirtyBlocks = rm_realloc(dataBlock->dirtyBlocks,
+					sizeof(uint64_t) * words);
+		memset(dataBlock->dirtyBlocks + prevWords, 0,
+				sizeof(uint64_t) * (words - prevWords));
 	}
-	dataBlock->blocks[i - 1]->next = NULL;
 
 	dataBlock->itemCap = dataBlock->blockCount * dataBlock->blockCap;
 }
@@ -65,14 +115,27 @@ static inline bool _DataBlock_IndexOutOfBounds
 	return (idx >= (dataBlock->itemCount + array_len(dataBlock->deletedIdx)));
 }
 
-DataBlockItemHeader *DataBlock_GetItemHeader
+// marks item at position idx as deleted or as not deleted
+// returns the item
+static inline void *_DataBlock_MarkItem
 (
 	const DataBlock *dataBlock,
-	uint64_t idx
+	uint64_t idx,
+	bool deleted
 ) {
-	Block *block = GET_ITEM_BLOCK(dataBlock, idx);
-	idx = ITEM_POSITION_WITHIN_BLOCK(idx, dataBlock->blockCap);
-	return (DataBlockItemHeader *)block->data + (idx * block->itemSize);
+	Block **block_ref = &GET_ITEM_BLOCK(dataBlock, idx);
+	uint64_t pos = ITEM_POSITION_WITHIN_BLOCK(idx, dataBlock->blockCap);
+
+	// block was released, all of its items are deleted
+	if(*block_ref == NULL) *block_ref = _DataBlock_NewBlock(dataBlock, true);
+
+	Block *block = *block_ref;
+	uint64_t *bitmap = DATABLOCK_BITMAP(block);
+
+	if(deleted) DATABLOCK_MARK_DELETED(bitmap, pos);
+	else DATABLOCK_MARK_NOT_DELETED(bitmap, pos);
+
+	return DATABLOCK_BLOCK_ITEM(block, dataBlock->blockCap, pos);
 }
 
 //------------------------------------------------------------------------------
@@ -88,7 +151,8 @@ DataBlock *DataBlock_New
 ) {
 	DataBlock *dataBlock = rm_malloc(sizeof(DataBlock));
 	dataBlock->blocks      =  NULL;
-	dataBlock->itemSize    =  itemSize + ITEM_HEADER_SIZE;
+	dataBlock->dirtyBlocks =  NULL;
+	dataBlock->itemSize    =  itemSize;
 	dataBlock->itemCount   =  0;
 	dataBlock->blockCount  =  0;
 	dataBlock->blockCap    =  blockCap;
@@ -107,20 +171,20 @@ uint64_t DataBlock_ItemCount(const DataBlock *dataBlock) {
 
 DataBlockIterator *DataBlock_Scan(const DataBlock *dataBlock) {
 	ASSERT(dataBlock != NULL);
-	Block *startBlock = dataBlock->blocks[0];
 
 	// Deleted items are skipped, we're about to perform
 	// array_len(dataBlock->deletedIdx) skips during out scan.
 	int64_t endPos = dataBlock->itemCount + array_len(dataBlock->deletedIdx);
-	return DataBlockIterator_New(startBlock, dataBlock->blockCap, endPos);
+	return DataBlockIterator_New((Block ***)&dataBlock->blocks,
+			dataBlock->blockCap, endPos);
 }
 
 DataBlockIterator *DataBlock_FullScan(const DataBlock *dataBlock) {
 	ASSERT(dataBlock != NULL);
-	Block *startBlock = dataBlock->blocks[0];
 
 	int64_t endPos = dataBlock->blockCount * dataBlock->blockCap;
-	return DataBlockIterator_New(startBlock, dataBlock->blockCap, endPos);
+	return DataBlockIterator_New((Block ***)&dataBlock->blocks,
+			dataBlock->blockCap, endPos);
 }
 
 // Make sure datablock can accommodate at least k items.
@@ -157,12 +221,15 @@ void *DataBlock_GetItem(const DataBlock *dataBlock, uint64_t idx) {
 	// return NULL if idx is out of bounds
 	if(_DataBlock_IndexOutOfBounds(dataBlock, idx)) return NULL;
 
-	DataBlockItemHeader *item_header = DataBlock_GetItemHeader(dataBlock, idx);
+	Block *block = GET_ITEM_BLOCK(dataBlock, idx);
+	uint64_t pos = ITEM_POSITION_WITHIN_BLOCK(idx, dataBlock->blockCap);
 
 	// Incase item is marked as deleted, return NULL.
-	if(IS_ITEM_DELETED(item_header)) return NULL;
+	if(block == NULL || DATABLOCK_IS_DELETED(DATABLOCK_BITMAP(block), pos)) {
+		return NULL;
+	}
 
-	return ITEM_DATA(item_header);
+	return DATABLOCK_BLOCK_ITEM(block, dataBlock->blockCap, pos);
 }
 
 uint64_t DataBlock_GetReservedIdx(const DataBlock *dataBlock, uint64_t n) {
@@ -194,10 +261,7 @@ void *DataBlock_AllocateItem(DataBlock *dataBlock, uint64_t *idx) {
 
 	if(idx) *idx = pos;
 
-	DataBlockItemHeader *item_header = DataBlock_GetItemHeader(dataBlock, pos);
-	MARK_HEADER_AS_NOT_DELETED(item_header);
-
-	return ITEM_DATA(item_header);
+	return _DataBlock_MarkItem(dataBlock, pos, false);
 }
 
 void DataBlock_DeleteItem(DataBlock *dataBlock, uint64_t idx) {
@@ -205,16 +269,14 @@ void DataBlock_DeleteItem(DataBlock *dataBlock, uint64_t idx) {
 	ASSERT(!_DataBlock_IndexOutOfBounds(dataBlock, idx));
 
 	// Return if item already deleted.
-	DataBlockItemHeader *item_header = DataBlock_GetItemHeader(dataBlock, idx);
-	if(IS_ITEM_DELETED(item_header)) return;
+	if(DataBlock_ItemIsDeleted(dataBlock, idx)) return;
 
-	// Call item destructor.
-	if(dataBlock->destructor) {
-		unsigned char *item = ITEM_DATA(item_header);
-		dataBlock->destructor(item);
-	}
+	void *item = _DataBlock_MarkItem(dataBlock, idx, true);
+	MARK_BLOCK_DIRTY(dataBlock,
+			ITEM_INDEX_TO_BLOCK_INDEX(idx, dataBlock->blockCap));
 
-	MARK_HEADER_AS_DELETED(item_header);
+	// Call item destructor.
+	if(dataBlock->destructor) dataBlock->destructor(item);
 
 	array_append(dataBlock->deletedIdx, idx);
 	dataBlock->itemCount--;
@@ -224,9 +286,87 @@ uint DataBlock_DeletedItemsCount(const DataBlock *dataBlock) {
 	return array_len(dataBlock->deletedIdx);
 }
 
-inline bool DataBlock_ItemIsDeleted(void *item) {
-	DataBlockItemHeader *header = GET_ITEM_HEADER(item);
-	return IS_ITEM_DELETED(header);
+inline bool DataBlock_ItemIsDeleted(const DataBlock *dataBlock, uint64_t idx) {
+	ASSERT(dataBlock != NULL);
+
+	// items beyond bounds were never allocated
+	if(_DataBlock_IndexOutOfBounds(dataBlock, idx)) return false;
+
+	// released blocks hold deleted items only
+	Block *block = GET_ITEM_BLOCK(dataBlock, idx);
+	if(block == NULL) return true;
+
+	uint64_t pos = ITEM_POSITION_WITHIN_BLOCK(idx, dataBlock->blockCap);
+	return DATABLOCK_IS_DELETED(DATABLOCK_BITMAP(block), pos);
+}
+
+// checks if the first 'n' items of block are all deleted
+static bool _DataBlock_BlockDeleted
+(
+	const Block *block,  // block to inspect
+	uint64_t n           // number of items to inspect
+) {
+	const uint64_t *bitmap = DATABLOCK_BITMAP(block);
+
+	// whole words
+	uint64_t words = n / 64;
+	for(uint64_t i = 0; i < words; i++) {
+		if(bitmap[i] != UINT64_MAX) return false;
+	}
+
+	// remaining bits
+	uint64_t rem = n % 64;
+	if(rem == 0) return true;
+
+	uint64_t mask = (1ULL << rem) - 1;
+	return (bitmap[words] & mask) == mask;
+}
+
+bool DataBlock_CleanBlock
+(
+	DataBlock *dataBlock,
+	uint i
+) {
+	ASSERT(dataBlock != NULL);
+	ASSERT(i < dataBlock->blockCount);
+
+	bool dirty = BLOCK_IS_DIRTY(dataBlock, i);
+	MARK_BLOCK_CLEAN(dataBlock, i);
+
+	return dirty;
+}
+
+size_t DataBlock_ReleaseDeletedBlocks
+(
+	DataBlock *dataBlock
+) {
+	ASSERT(dataBlock != NULL);
+
+	size_t released = 0;
+	uint64_t bound = dataBlock->itemCount + array_len(dataBlock->deletedIdx);
+
+	// blocks past bound were never used, they're kept as spare capacity
+	for(uint i = 0; i < dataBlock->blockCount; i++) {
+		uint64_t start = i * dataBlock->blockCap;
+		if(start >= bound) break;
+
+		// only blocks holding new deletions might have become empty
+		Block *block = dataBlock->blocks[i];
+		if(block == NULL || !BLOCK_IS_DIRTY(dataBlock, i)) {
+			continue;
+		}
+
+		uint64_t n = MIN(dataBlock->blockCap, bound - start);
+		if(!_DataBlock_BlockDeleted(block, n)) continue;
+
+		// all items within block are deleted and their destructors were called
+		// block is re-allocated once one of its items is reused
+		Block_Free(block);
+		dataBlock->blocks[i] = NULL;
+		released += BLOCK_BYTE_SIZE(dataBlock);
+	}
+
+	return released;
 }
 
 //------------------------------------------------------------------------------
@@ -240,10 +380,8 @@ void *DataBlock_AllocateItemOutOfOrder
 ) {
 	// Check if idx<=data block's current capacity. If needed, allocate additional blocks.
 	DataBlock_Ensure(dataBlock, idx);
-	DataBlockItemHeader *item_header = DataBlock_GetItemHeader(dataBlock, idx);
-	MARK_HEADER_AS_NOT_DELETED(item_header);
 	dataBlock->itemCount++;
-	return ITEM_DATA(item_header);
+	return _DataBlock_MarkItem(dataBlock, idx, false);
 }
 
 void DataBlock_MarkAsDeletedOutOfOrder
@@ -253,16 +391,20 @@ void DataBlock_MarkAsDeletedOutOfOrder
 ) {
 	// Check if idx<=data block's current capacity. If needed, allocate additional blocks.
 	DataBlock_Ensure(dataBlock, idx);
-	DataBlockItemHeader *item_header = DataBlock_GetItemHeader(dataBlock, idx);
 	// Delete
-	MARK_HEADER_AS_DELETED(item_header);
+	_DataBlock_MarkItem(dataBlock, idx, true);
+	MARK_BLOCK_DIRTY(dataBlock,
+			ITEM_INDEX_TO_BLOCK_INDEX(idx, dataBlock->blockCap));
 	array_append(dataBlock->deletedIdx, idx);
 }
 
 void DataBlock_Free(DataBlock *dataBlock) {
-	for(uint i = 0; i < dataBlock->blockCount; i++) Block_Free(dataBlock->blocks[i]);
+	for(uint i = 0; i < dataBlock->blockCount; i++) {
+		if(dataBlock->blocks[i] != NULL) Block_Free(dataBlock->blocks[i]);
+	}
 
 	rm_free(dataBlock->blocks);
+	rm_free(dataBlock->dirtyBlocks);
 	array_free(dataBlock->deletedIdx);
 	rm_free(dataBlock);
 }
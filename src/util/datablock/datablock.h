@@ -7,6 +7,7 @@
 #pragma once
 
 #include <stdlib.h>
+#include <stdint.h>
 #include <stdbool.h>
 #include <pthread.h>
 #include "../block.h"
@@ -14,28 +15,37 @@
 
 typedef void (*fpDestructor)(void *);
 
-// Returns the item header size.
-#define ITEM_HEADER_SIZE 1
+// DataBlock blocks are laid out as ||deleted bitmap|items||
+// the bitmap holds a bit per item, set once the item is deleted
+// bitmap size is rounded up to 16 bytes, such that items are naturally aligned
 
-// DataBlock item is stored as ||header|data||. This macro retrive the data pointer out of the header pointer.
-#define ITEM_DATA(header) ((void *)((header) + ITEM_HEADER_SIZE))
+// number of bytes occupied by a block's deleted bitmap
+#define DATABLOCK_BITMAP_SIZE(blockCap) ((((blockCap) + 127) / 128) * 16)
 
-// DataBlock item is stored as ||header|data||. This macro retrive the header pointer out of the data pointer.
-#define GET_ITEM_HEADER(item) ((item) - ITEM_HEADER_SIZE)
+// retrieves block's deleted bitmap
+#define DATABLOCK_BITMAP(block) ((uint64_t *)(block)->data)
 
-// Sets the deleted bit in the header to 1.
-#define MARK_HEADER_AS_DELETED(header) ((header)->deleted |= 1)
+// retrieves item at position 'pos' within block
+#define DATABLOCK_BLOCK_ITEM(block, blockCap, pos) \
+	((void *)((block)->data + DATABLOCK_BITMAP_SIZE(blockCap) + \
+		(pos) * (block)->itemSize))
 
-// Sets the deleted bit in the header to 0.
-#define MARK_HEADER_AS_NOT_DELETED(header) ((header)->deleted &= 0)
+// checks if the item at position 'pos' within block is deleted
+#define DATABLOCK_IS_DELETED(bitmap, pos) \
+	(((bitmap)[(pos) >> 6] >> ((pos) & 63)) & 1)
 
-// Checks if the deleted bit in the header is 1 or not.
-#define IS_ITEM_DELETED(header) ((header)->deleted & 1)
+// marks the item at position 'pos' within block as deleted
+#define DATABLOCK_MARK_DELETED(bitmap, pos) \
+	((bitmap)[(pos) >> 6] |= (1ULL << ((pos) & 63)))
+
+// marks the item at position 'pos' within block as not deleted
+#define DATABLOCK_MARK_NOT_DELETED(bitmap, pos) \
+	((bitmap)[(pos) >> 6] &= ~(1ULL << ((pos) & 63)))
 
 /* The DataBlock is a container structure for holding arbitrary items of a uniform type
  * in order to reduce the number of alloc/free calls and improve locality of reference.
- * Item deletions are thread-safe, and a DataBlockIterator can be used to traverse a
- * range within the block. */
+ * Deleted items are tracked by a per block bitmap, and a DataBlockIterator can be
+ * used to traverse a range within the block. */
 typedef struct {
 	uint64_t itemCount;         // Number of items stored in datablock.
 	uint64_t itemCap;           // Number of items datablock can hold.
@@ -44,15 +54,10 @@ typedef struct {
 	uint itemSize;              // Size of a single item in bytes.
 	Block **blocks;             // Array of blocks.
 	uint64_t *deletedIdx;       // Array of free indicies.
+	uint64_t *dirtyBlocks;      // Bitmap, a bit per block holding new deletions.
 	fpDestructor destructor;    // Function pointer to a clean-up function of an item.
 } DataBlock;
 
-// This struct is for data block item header data.
-// TODO: Consider using pragma pack/pop for tight memory/word alignment.
-typedef struct {
-	unsigned char deleted: 1;  // A bit indicate if the current item is deleted or not.
-} DataBlockItemHeader;
-
 // Create a new DataBlock
 // itemCap - number of items datablock can hold before resizing.
 // itemSize - item size in bytes.
@@ -97,8 +102,18 @@ void DataBlock_DeleteItem(DataBlock *dataBlock, uint64_t idx);
 // Returns the number of deleted items.
 uint DataBlock_DeletedItemsCount(const DataBlock *dataBlock);
 
-// Returns true if the given item has been deleted.
-bool DataBlock_ItemIsDeleted(void *item);
+// Returns true if the item at position idx has been deleted.
+bool DataBlock_ItemIsDeleted(const DataBlock *dataBlock, uint64_t idx);
+
+// Returns true if items within block 'i' were deleted since the block was
+// last cleaned, and marks the block as clean.
+bool DataBlock_CleanBlock(DataBlock *dataBlock, uint i);
+
+// Frees blocks whose items are all deleted.
+// A released block is allocated again once one of its items is reused,
+// item indices and the order in which they're reused are not affected.
+// Returns the number of bytes freed.
+size_t DataBlock_ReleaseDeletedBlocks(DataBlock *dataBlock);
 
 // Free block.
 void DataBlock_Free(DataBlock *block);
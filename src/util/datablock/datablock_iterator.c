@@ -13,16 +13,16 @@
 
 DataBlockIterator *DataBlockIterator_New
 (
-	Block *block,
+	Block ***blocks,
 	uint64_t block_cap,
 	uint64_t end_pos
 ) {
-	ASSERT(block);
+	ASSERT(blocks != NULL);
 
 	DataBlockIterator *iter = rm_malloc(sizeof(DataBlockIterator));
 
-	iter->_start_block    =  block;
-	iter->_current_block  =  block;
+	iter->_blocks         =  blocks;
+	iter->_block_idx      =  0;
 	iter->_block_pos      =  0;
 	iter->_block_cap      =  block_cap;
 	iter->_current_pos    =  0;
@@ -30,6 +30,22 @@ DataBlockIterator *DataBlockIterator_New
 	return iter;
 }
 
+// advance iterator by 'n' positions within its current block
+static inline void _DataBlockIterator_Advance
+(
+	DataBlockIterator *iter,
+	uint64_t n
+) {
+	iter->_block_pos   += n;
+	iter->_current_pos += n;
+
+	// advance to next block if current block consumed
+	if(iter->_block_pos == iter->_block_cap) {
+		iter->_block_pos = 0;
+		iter->_block_idx++;
+	}
+}
+
 void *DataBlockIterator_Next
 (
 	DataBlockIterator *iter,
@@ -37,34 +53,55 @@ void *DataBlockIterator_Next
 ) {
 	ASSERT(iter != NULL);
 
-	// set default
-	void                 *item         =  NULL;
-	DataBlockItemHeader  *item_header  =  NULL;
-
 	// have we reached the end of our iterator?
-	while(iter->_current_pos < iter->_end_pos && iter->_current_block != NULL) {
-		// get item at current position
-		Block *block = iter->_current_block;
-		item_header = (DataBlockItemHeader *)block->data + (iter->_block_pos * block->itemSize);
-
-		// advance to next position
-		iter->_block_pos += 1;
-		iter->_current_pos += 1;
-
-		// advance to next block if current block consumed
-		if(iter->_block_pos == iter->_block_cap) {
-			iter->_block_pos = 0;
-			iter->_current_block = iter->_current_block->next;
+	while(iter->_current_pos < iter->_end_pos) {
+		Block    *block  =  (*iter->_blocks)[iter->_block_idx];
+		uint64_t  pos    =  iter->_block_pos;
+
+		// released block, all of its items are deleted
+		if(block == NULL) {
+			_DataBlockIterator_Advance(iter, iter->_block_cap - pos);
+			continue;
 		}
 
-		if(!IS_ITEM_DELETED(item_header)) {
-			item = ITEM_DATA(item_header);
-			if(id) *id = iter->_current_pos - 1;
+		const uint64_t *bitmap = DATABLOCK_BITMAP(block);
+
+		// scan deleted bitmap a word at a time
+		// looking for the first item at or after 'pos' which isn't deleted
+		uint64_t live = ~bitmap[pos >> 6] & (UINT64_MAX << (pos & 63));
+		if(live == 0) {
+			// remaining items within word are deleted, skip them all
+			uint64_t next = (pos | 63) + 1;
+			if(next > iter->_block_cap) next = iter->_block_cap;
+			_DataBlockIterator_Advance(iter, next - pos);
+			continue;
+		}
+
+		uint64_t next = (pos & ~(uint64_t)63) + __builtin_ctzll(live);
+		if(next >= iter->_block_cap) {
+			// bits past block's end, move to next block
+			_DataBlockIterator_Advance(iter, iter->_block_cap - pos);
+			continue;
+		}
+
+		uint64_t item_pos = iter->_current_pos + (next - pos);
+		if(item_pos >= iter->_end_pos) {
+			iter->_current_pos = iter->_end_pos;
 			break;
 		}
+
+		void *item = DATABLOCK_BLOCK_ITEM(block, iter->_block_cap, next);
+		if(id) *id = item_pos;
+
+		// position iterator right after item
+		_DataBlockIterator_Advance(iter, next - pos + 1);
+		return item;
 	}
 
-	return item;
+	// clamp position, deleted runs might have been skipped past end
+	if(iter->_current_pos > iter->_end_pos) iter->_current_pos = iter->_end_pos;
+
+	return NULL;
 }
 
 void DataBlockIterator_Reset
@@ -72,9 +109,9 @@ void DataBlockIterator_Reset
 	DataBlockIterator *iter
 ) {
 	ASSERT(iter != NULL);
+	iter->_block_idx      =  0;
 	iter->_block_pos      =  0;
 	iter->_current_pos    =  0;
-	iter->_current_block  =  iter->_start_block;
 }
 
 void DataBlockIterator_Free
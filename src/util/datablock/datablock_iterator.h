@@ -12,8 +12,8 @@
 /* Datablock iterator iterates over items within a datablock. */
 
 typedef struct {
-	Block *_start_block;			// first block accessed by iterator
-	Block *_current_block;			// current block
+	Block ***_blocks;				// datablock's blocks, array might be reallocated
+	uint64_t _block_idx;			// current block index
 	uint64_t _block_pos;			// position within a block
 	uint64_t _block_cap;            // max number of items in block
 	uint64_t _current_pos;			// iterator current position
@@ -23,7 +23,7 @@ typedef struct {
 // creates a new datablock iterator
 DataBlockIterator *DataBlockIterator_New
 (
-	Block *block,        // block from which iteration begins
+	Block ***blocks,     // datablock's blocks, released blocks are NULL
 	uint64_t block_cap,  // max number of items in block
 	uint64_t end_pos	 // iteration stops here
 );
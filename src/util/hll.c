@@ -0,0 +1,80 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "hll.h"
+
+#include <math.h>
+#include <string.h>
+
+void HLL_Init
+(
+	HLL *hll
+) {
+	ASSERT(hll != NULL);
+	memset(hll->registers, 0, sizeof(hll->registers));
+}
+
+void HLL_Add
+(
+	HLL *hll,
+	uint64_t hash
+) {
+	ASSERT(hll != NULL);
+
+	// top 'p' bits select the register
+	uint idx = hash >> (64 - HLL_PRECISION);
+
+	// rank is the position of the leftmost set bit among the remaining bits
+	// a sentinel bit bounds the rank when all remaining bits are zero
+	uint64_t w = (hash << HLL_PRECISION) | ((uint64_t)1 << (HLL_PRECISION - 1));
+	uint8_t rank = __builtin_clzll(w) + 1;
+
+	if(rank > hll->registers[idx]) hll->registers[idx] = rank;
+}
+
+void HLL_Merge
+(
+	HLL *dest,
+	const HLL *src
+) {
+	ASSERT(src  != NULL);
+	ASSERT(dest != NULL);
+
+	for(uint i = 0; i < HLL_REGISTERS; i++) {
+		if(src->registers[i] > dest->registers[i]) {
+			dest->registers[i] = src->registers[i];
+		}
+	}
+}
+
+uint64_t HLL_Count
+(
+	const HLL *hll
+) {
+	ASSERT(hll != NULL);
+
+	const double m = HLL_REGISTERS;
+	const double alpha = 0.7213 / (1.0 + 1.079 / m);
+
+	uint zeros = 0;
+	double sum = 0;
+	for(uint i = 0; i < HLL_REGISTERS; i++) {
+		uint8_t r = hll->registers[i];
+		sum += ldexp(1.0, -r);
+		if(r == 0) zeros++;
+	}
+
+	double estimate = alpha * m * m / sum;
+
+	// small range correction, use linear counting
+	if(estimate <= 2.5 * m && zeros > 0) {
+		estimate = m * log(m / zeros);
+	}
+
+	return (uint64_t)(estimate + 0.5);
+}
+
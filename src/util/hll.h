@@ -0,0 +1,48 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// HyperLogLog, a probabilistic distinct count estimator
+// with 2^HLL_PRECISION registers the standard error is ~1.04 / sqrt(2^p)
+// which is ~3% for the default precision
+
+#define HLL_PRECISION 10
+#define HLL_REGISTERS (1 << HLL_PRECISION)
+
+typedef struct {
+	uint8_t registers[HLL_REGISTERS];  // max observed rank per register
+} HLL;
+
+// initialize an empty HLL
+void HLL_Init
+(
+	HLL *hll  // HLL to initialize
+);
+
+// add a hashed element to the HLL
+// the hash is expected to be uniformly distributed over 64 bits
+void HLL_Add
+(
+	HLL *hll,      // HLL to update
+	uint64_t hash  // element hash
+);
+
+// merge 'src' into 'dest'
+void HLL_Merge
+(
+	HLL *dest,      // HLL to update
+	const HLL *src  // HLL to merge
+);
+
+// estimate the number of distinct elements added to the HLL
+uint64_t HLL_Count
+(
+	const HLL *hll  // HLL to query
+);
+
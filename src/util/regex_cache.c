@@ -0,0 +1,332 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "rmalloc.h"
+#include "regex_cache.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+// characters with a special meaning outside of a character class
+#define REGEX_META ".[]()*+?{}|^$\\"
+
+// a cached compiled pattern
+typedef struct {
+	char *pattern;   // source pattern, NULL if entry is vacant
+	bool anchored;   // pattern spans the entire subject
+	regex_t *regex;  // compiled pattern
+	uint64_t used;   // last access tick
+} RegexCacheEntry;
+
+// each thread caches its own patterns
+// a compiled regex can't be searched concurrently
+static __thread RegexCacheEntry _cache[REGEX_CACHE_SIZE];
+static __thread uint64_t _tick = 0;
+
+static int _Regex_New
+(
+	regex_t **regex,      // [output] compiled pattern
+	const char *pattern,  // pattern to compile
+	char *err             // [output] error
+) {
+	OnigErrorInfo einfo;
+	int rv = onig_new(regex, (const UChar *)pattern,
+		(const UChar *)(pattern + strlen(pattern)), ONIG_OPTION_DEFAULT,
+		ONIG_ENCODING_UTF8, ONIG_SYNTAX_JAVA, &einfo);
+
+	if(rv != ONIG_NORMAL) {
+		onig_error_code_to_str((UChar *)err, rv, &einfo);
+		onig_free(*regex);
+		*regex = NULL;
+	}
+
+	return rv;
+}
+
+// compile 'pattern', wrapping it such that it must span the entire subject
+static regex_t *_Regex_NewAnchored
+(
+	const char *pattern,  // pattern to compile
+	char *err             // [output] error
+) {
+	regex_t *regex;
+
+	// validate the pattern on its own first
+	// otherwise a pattern such as 'a)(b' becomes valid once wrapped
+	if(_Regex_New(&regex, pattern, err) != ONIG_NORMAL) return NULL;
+	onig_free(regex);
+
+	char *anchored;
+	int rc __attribute__((unused));
+	rc = asprintf(&anchored, "(?:%s)\\z", pattern);
+	_Regex_New(&regex, anchored, err);
+	free(anchored);
+
+	return regex;
+}
+
+regex_t *Regex_Compile
+(
+	const char *pattern,  // pattern to compile
+	bool anchored,        // match the entire subject
+	char *err             // [output] error of ONIG_MAX_ERROR_MESSAGE_LEN bytes
+) {
+	ASSERT(err     != NULL);
+	ASSERT(pattern != NULL);
+
+	RegexCacheEntry *victim = _cache;
+	_tick++;
+
+	// look for pattern, tracking least recently used entry
+	for(int i = 0; i < REGEX_CACHE_SIZE; i++) {
+		RegexCacheEntry *e = _cache + i;
+
+		if(e->pattern == NULL) {
+			victim = e;
+			continue;
+		}
+
+		if(e->anchored == anchored && strcmp(e->pattern, pattern) == 0) {
+			e->used = _tick;
+			return e->regex;
+		}
+
+		if(victim->pattern != NULL && e->used < victim->used) victim = e;
+	}
+
+	// cache miss, compile pattern
+	regex_t *regex;
+	if(anchored) {
+		regex = _Regex_NewAnchored(pattern, err);
+	} else {
+		_Regex_New(&regex, pattern, err);
+	}
+
+	// invalid patterns aren't cached
+	if(regex == NULL) return NULL;
+
+	// evict least recently used pattern
+	if(victim->pattern != NULL) {
+		rm_free(victim->pattern);
+		onig_free(victim->regex);
+	}
+
+	victim->pattern  = rm_strdup(pattern);
+	victim->anchored = anchored;
+	victim->regex    = regex;
+	victim->used     = _tick;
+
+	return regex;
+}
+
+char *Regex_LiteralPrefix
+(
+	const char *pattern  // regex pattern
+) {
+	ASSERT(pattern != NULL);
+
+	// an alternative might not share the prefix, e.g. 'ab|cd'
+	if(strchr(pattern, '|') != NULL) return NULL;
+
+	size_t n       = 0;
+	const char *p  = pattern;
+	char *prefix   = rm_malloc(strlen(pattern) + 1);
+
+	// a leading start anchor doesn't change the prefix
+	if(*p == '^') p++;
+
+	while(*p != '\0') {
+		const char *lit;  // current literal character
+		size_t lit_len;   // literal length in bytes
+
+		if(*p == '\\') {
+			// escaped punctuation is a literal
+			// any other escape is a class, an anchor or a back reference
+			unsigned char c = p[1];
+			if(c == '\0' || c >= 0x80 || isalnum(c)) break;
+			lit     = p + 1;
+			lit_len = 1;
+		} else if(strchr(REGEX_META, *p) != NULL) {
+			break;
+		} else {
+			// a multi-byte character is a single literal
+			lit     = p;
+			lit_len = 1;
+			if((unsigned char)*p >= 0x80) {
+				while(((unsigned char)p[lit_len] & 0xC0) == 0x80) lit_len++;
+			}
+		}
+
+		const char *next = lit + lit_len;
+
+		// literal is optional, e.g. 'ab?'
+		if(*next == '*' || *next == '?' || *next == '{') break;
+
+		memcpy(prefix + n, lit, lit_len);
+		n += lit_len;
+		p = next;
+
+		// literal is repeated, e.g. 'ab+'
+		if(*p == '+') break;
+	}
+
+	if(n == 0) {
+		rm_free(prefix);
+		return NULL;
+	}
+
+	prefix[n] = '\0';
+	return prefix;
+}
+
+// escapes matching a single character class or an anchor
+// any other escape might take arguments, e.g. '\x41' or '\p{L}'
+#define REGEX_SIMPLE_ESCAPES "dDwWsSbBAzZGhHRnrtfeav"
+
+// returns the end of the character class starting at 'p'
+// NULL if class isn't terminated
+static const char *_Regex_SkipClass
+(
+	const char *p  // class opening bracket
+) {
+	ASSERT(*p == '[');
+
+	int depth = 0;
+	const char *start = p;
+
+	while(*p != '\0') {
+		if(*p == '\\') {
+			if(p[1] == '\0') return NULL;
+			p += 2;
+			continue;
+		}
+
+		if(*p == '[') {
+			depth++;
+		} else if(*p == ']' && !(p == start + 1 ||
+					(p == start + 2 && start[1] == '^'))) {
+			// a leading ']' is a literal
+			if(--depth == 0) return p + 1;
+		}
+
+		p++;
+	}
+
+	return NULL;
+}
+
+char *Regex_LiteralSubstring
+(
+	const char *pattern  // regex pattern
+) {
+	ASSERT(pattern != NULL);
+
+	// an alternative might not contain the literal, e.g. 'abc|d'
+	// inline options might ignore case, e.g. '(?i)abc'
+	// quoted sequences aren't parsed, e.g. '\Qa|b\E'
+	if(strchr(pattern, '|')    != NULL ||
+	   strstr(pattern, "(?")   != NULL ||
+	   strstr(pattern, "\\Q")  != NULL) {
+		return NULL;
+	}
+
+	size_t len     = strlen(pattern);
+	char *run      = rm_malloc(len + 1);  // current run of literals
+	char *best     = rm_malloc(len + 1);  // longest run
+	size_t n       = 0;                   // length of current run
+	size_t best_n  = 0;                   // length of longest run
+	int depth      = 0;                   // group nesting level
+	const char *p  = pattern;
+
+	while(p != NULL && *p != '\0') {
+		const char *lit = NULL;  // current literal character
+		size_t lit_len  = 0;     // literal length in bytes
+
+		if(*p == '\\') {
+			unsigned char c = p[1];
+			if(c != '\0' && c < 0x80 && !isalnum(c)) {
+				// escaped punctuation is a literal
+				lit     = p + 1;
+				lit_len = 1;
+			} else if(c != '\0' && strchr(REGEX_SIMPLE_ESCAPES, c) != NULL) {
+				p += 2;
+			} else {
+				// escape's extent is unknown, stop scanning
+				break;
+			}
+		} else if(*p == '[') {
+			p = _Regex_SkipClass(p);
+		} else if(*p == '{') {
+			// quantifier
+			p = strchr(p, '}');
+			if(p != NULL) p++;
+		} else if(*p == '(' || *p == ')') {
+			depth += (*p == '(') ? 1 : -1;
+			p++;
+		} else if(strchr(REGEX_META, *p) != NULL) {
+			p++;
+		} else {
+			// a multi-byte character is a single literal
+			lit     = p;
+			lit_len = 1;
+			if((unsigned char)*p >= 0x80) {
+				while(((unsigned char)p[lit_len] & 0xC0) == 0x80) lit_len++;
+			}
+		}
+
+		// literals within groups might be optional, e.g. '(abc)?'
+		// a literal followed by '*', '?' or '{' is optional
+		// a literal followed by '+' is repeated, it ends the run
+		bool extend = false;
+		if(lit != NULL) {
+			p = lit + lit_len;
+			extend = depth == 0 && *p != '*' && *p != '?' && *p != '{';
+		}
+
+		if(extend) {
+			memcpy(run + n, lit, lit_len);
+			n += lit_len;
+			if(*p != '+') continue;
+		}
+
+		// run ended
+		if(n > best_n) {
+			memcpy(best, run, n);
+			best_n = n;
+		}
+		n = 0;
+	}
+
+	if(n > best_n) {
+		memcpy(best, run, n);
+		best_n = n;
+	}
+
+	rm_free(run);
+
+	if(best_n == 0) {
+		rm_free(best);
+		return NULL;
+	}
+
+	best[best_n] = '\0';
+	return best;
+}
+
+void Regex_ClearCache(void) {
+	for(int i = 0; i < REGEX_CACHE_SIZE; i++) {
+		RegexCacheEntry *e = _cache + i;
+		if(e->pattern == NULL) continue;
+
+		rm_free(e->pattern);
+		onig_free(e->regex);
+		e->pattern = NULL;
+		e->regex   = NULL;
+	}
+}
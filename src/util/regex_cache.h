@@ -0,0 +1,45 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include "oniguruma/src/oniguruma.h"
+
+// number of compiled patterns each thread keeps around
+#define REGEX_CACHE_SIZE 32
+
+// returns a compiled regex for 'pattern'
+// compiled patterns are kept in a bounded per thread LRU cache
+// the returned regex is owned by the cache and must not be freed
+// it remains valid until the calling thread compiles another pattern
+// an anchored regex only matches when it spans the entire subject
+// on failure NULL is returned and 'err' describes the error
+regex_t *Regex_Compile
+(
+	const char *pattern,  // pattern to compile
+	bool anchored,        // match the entire subject
+	char *err             // [output] error of ONIG_MAX_ERROR_MESSAGE_LEN bytes
+);
+
+// returns the literal prefix every string matching 'pattern' starts with
+// NULL if no such prefix exists or it can't be determined
+// the returned prefix should be freed by the caller
+char *Regex_LiteralPrefix
+(
+	const char *pattern  // regex pattern
+);
+
+// returns the longest literal every string matching 'pattern' contains
+// NULL if no such literal exists or it can't be determined
+// the returned literal should be freed by the caller
+char *Regex_LiteralSubstring
+(
+	const char *pattern  // regex pattern
+);
+
+// free the calling thread's compiled patterns
+void Regex_ClearCache(void);
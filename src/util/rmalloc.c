@@ -5,9 +5,11 @@
  */
 
 #include "rmalloc.h"
-
+#include "RG.h"
 #include "../errors/errors.h"
 
+#include <pthread.h>
+
 #ifdef REDIS_MODULE_TARGET /* Set this when compiling your code as a module */
 
 // amount of memory allocated for currently executed query thread_local counter
@@ -21,6 +23,12 @@
 static __thread int64_t n_alloced;
 static int64_t mem_capacity;  // maximum memory consumption for thread
 
+// number of bytes allocated by thread while allocations are tracked
+// unlike 'n_alloced' this counter is never decremented
+static __thread uint64_t n_allocated;
+static uint tracking;  // number of active allocation tracking requests
+static pthread_mutex_t allocator_lock = PTHREAD_MUTEX_INITIALIZER;
+
 // function pointers which hold the original address of RedisModule_Alloc*
 static void (*RedisModule_Free_Orig)(void *ptr);
 static void * (*RedisModule_Alloc_Orig)(size_t bytes);
@@ -32,6 +40,10 @@ void rm_reset_n_alloced() {
 	n_alloced = 0;
 }
 
+uint64_t rm_allocated_bytes(void) {
+	return n_allocated;
+}
+
 // removes n_bytes from thread memory consumption
 static inline void _nmalloc_decrement(int64_t n_bytes) {
 	n_alloced -= n_bytes;
@@ -39,6 +51,11 @@ static inline void _nmalloc_decrement(int64_t n_bytes) {
 
 // adds nbytes to thread memory consumption
 static inline void _nmalloc_increment(int64_t n_bytes) {
+	n_allocated += n_bytes;
+
+	// no memory cap, allocations are only tracked
+	if(mem_capacity <= 0) return;
+
 	n_alloced += n_bytes;
 	// check if capacity exceeded
 	if(n_alloced > mem_capacity) {
@@ -58,10 +75,14 @@ void *rm_alloc_with_capacity(size_t n_bytes) {
 }
 
 void *rm_realloc_with_capacity(void *ptr, size_t n_bytes) {
-	// remove bytes of original allocation
-	_nmalloc_decrement(RedisModule_MallocSize(ptr));
-	// track new allocation size
-	_nmalloc_increment(n_bytes);
+	// account only for the difference between the allocations sizes
+	// such that growing an allocation isn't counted as a new one
+	size_t old_size = (ptr != NULL) ? RedisModule_MallocSize(ptr) : 0;
+	if(n_bytes > old_size) {
+		_nmalloc_increment(n_bytes - old_size);
+	} else {
+		_nmalloc_decrement(old_size - n_bytes);
+	}
 	return RedisModule_Realloc_Orig(ptr, n_bytes);
 }
 
@@ -84,16 +105,17 @@ void rm_free_with_capacity(void *ptr) {
 	RedisModule_Free_Orig(ptr);
 }
 
-void rm_set_mem_capacity(int64_t cap) {
-	bool is_capped = (mem_capacity > 0); // current allocator applies memory cap
-	bool should_cap = (cap > 0); // should we use a memory capped allocator
-
-	// The local enforced capacity should be set
-	// before resetting function pointers
-	// for instance if we're switching to capped allocator
-	// we want the memory cap to be set
-	mem_capacity = cap;
-	if(should_cap && !is_capped) {
+// switch between the original and the accounting allocator
+// the accounting allocator is used as long as either a memory cap is set
+// or allocations are tracked
+// must be called with 'allocator_lock' held
+static void _rm_update_allocator
+(
+	bool account  // use accounting allocator
+) {
+	bool accounting = (RedisModule_Alloc == rm_alloc_with_capacity);
+
+	if(account && !accounting) {
 		// store the function pointer original values and change them
 		// to the capped version
 		RedisModule_Free_Orig     =  RedisModule_Free;
@@ -106,7 +128,7 @@ void rm_set_mem_capacity(int64_t cap) {
 		RedisModule_Calloc        =  rm_calloc_with_capacity;
 		RedisModule_Strdup        =  rm_strdup_with_capacity;
 		RedisModule_Realloc       =  rm_realloc_with_capacity;
-	} else if(!should_cap && is_capped) {
+	} else if(!account && accounting) {
 		// restore all function pointers to their original values
 		RedisModule_Free     =  RedisModule_Free_Orig;
 		RedisModule_Alloc    =  RedisModule_Alloc_Orig;
@@ -116,6 +138,33 @@ void rm_set_mem_capacity(int64_t cap) {
 	}
 }
 
+void rm_set_mem_capacity(int64_t cap) {
+	pthread_mutex_lock(&allocator_lock);
+
+	// The local enforced capacity should be set
+	// before resetting function pointers
+	// for instance if we're switching to capped allocator
+	// we want the memory cap to be set
+	mem_capacity = cap;
+	_rm_update_allocator(mem_capacity > 0 || tracking > 0);
+
+	pthread_mutex_unlock(&allocator_lock);
+}
+
+void rm_track_allocations(bool track) {
+	pthread_mutex_lock(&allocator_lock);
+
+	if(track) {
+		tracking++;
+	} else {
+		ASSERT(tracking > 0);
+		tracking--;
+	}
+	_rm_update_allocator(mem_capacity > 0 || tracking > 0);
+
+	pthread_mutex_unlock(&allocator_lock);
+}
+
 #else
 
 void rm_reset_n_alloced() {
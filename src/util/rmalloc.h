@@ -3,6 +3,8 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
 #include "../redismodule.h"
 
 #ifdef REDIS_MODULE_TARGET /* Set this when compiling your code as a module */
@@ -18,6 +20,14 @@ void rm_set_mem_capacity(int64_t cap);
 // reset thread memory consumption counter to 0 (no memory consumed)
 void rm_reset_n_alloced();
 
+// start or stop counting allocated bytes per thread
+// calls nest, counting stops once every start has been matched by a stop
+void rm_track_allocations(bool track);
+
+// total number of bytes allocated by the calling thread while tracking
+// the counter only grows, frees are not deducted
+uint64_t rm_allocated_bytes(void);
+
 static inline void *rm_malloc(size_t n) {
 	return RedisModule_Alloc(n);
 }
@@ -47,6 +57,8 @@ static inline char *rm_strndup(const char *s, size_t n) {
 #endif
 #ifndef REDIS_MODULE_TARGET
 /* for non redis module targets */
+#define rm_track_allocations(track)
+#define rm_allocated_bytes() 0
 #define rm_malloc malloc
 #define rm_free free
 #define rm_calloc calloc
@@ -0,0 +1,579 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "rmalloc.h"
+#include "roaring.h"
+
+#include <string.h>
+
+// max number of values held by an array container
+#define ROARING_ARRAY_MAX 4096
+
+// bitmap containers shrink back to arrays at half the array capacity
+// avoids converting a container back and forth around the threshold
+#define ROARING_BITMAP_MIN (ROARING_ARRAY_MAX / 2)
+
+// number of 64 bit words in a bitmap container, 2^16 bits
+#define ROARING_BITMAP_WORDS 1024
+#define ROARING_BITMAP_SIZE (sizeof(uint64_t) * ROARING_BITMAP_WORDS)
+
+// initial capacity of an array container
+#define ROARING_ARRAY_MIN_CAP 4
+
+// initial number of container slots
+#define ROARING_CONTAINERS_MIN_CAP 4
+
+typedef struct {
+	uint64_t key;          // high bits shared by container values
+	uint32_t card;         // number of values
+	uint32_t cap;          // array capacity, 0 for bitmap containers
+	union {
+		uint16_t *array;   // sorted low bits
+		uint64_t *bitmap;  // low bits bitmap
+	};
+} RoaringContainer;
+
+struct Roaring {
+	RoaringContainer *containers;  // containers sorted by key
+	uint32_t count;                // number of containers
+	uint32_t cap;                  // number of container slots
+	uint64_t card;                 // number of values
+	size_t memory;                 // number of bytes used
+};
+
+#define KEY(v) ((v) >> 16)
+#define LOW(v) ((uint16_t)((v) & 0xFFFF))
+#define IS_BITMAP(c) ((c)->cap == 0)
+
+//------------------------------------------------------------------------------
+// containers
+//------------------------------------------------------------------------------
+
+static inline bool _Bitmap_Test
+(
+	const uint64_t *bitmap,
+	uint16_t low
+) {
+	return (bitmap[low >> 6] >> (low & 63)) & 1;
+}
+
+// binary search 'low' in array container
+// returns true if found, 'pos' is set to its position or insertion point
+static bool _Array_Find
+(
+	const RoaringContainer *c,
+	uint16_t low,
+	uint32_t *pos
+) {
+	uint32_t lo = 0;
+	uint32_t hi = c->card;
+
+	while(lo < hi) {
+		uint32_t mid = (lo + hi) / 2;
+		if(c->array[mid] < low) lo = mid + 1;
+		else hi = mid;
+	}
+
+	*pos = lo;
+	return lo < c->card && c->array[lo] == low;
+}
+
+// resize array container
+static void _Array_Resize
+(
+	Roaring *r,
+	RoaringContainer *c,
+	uint32_t cap
+) {
+	ASSERT(cap >= c->card);
+
+	c->array   = rm_realloc(c->array, sizeof(uint16_t) * cap);
+	r->memory += sizeof(uint16_t) * cap;
+	r->memory -= sizeof(uint16_t) * c->cap;
+	c->cap     = cap;
+}
+
+static void _Container_ToBitmap
+(
+	Roaring *r,
+	RoaringContainer *c
+) {
+	ASSERT(!IS_BITMAP(c));
+
+	uint64_t *bitmap = rm_calloc(ROARING_BITMAP_WORDS, sizeof(uint64_t));
+	for(uint32_t i = 0; i < c->card; i++) {
+		uint16_t low = c->array[i];
+		bitmap[low >> 6] |= (1ULL << (low & 63));
+	}
+
+	rm_free(c->array);
+	r->memory -= sizeof(uint16_t) * c->cap;
+	r->memory += ROARING_BITMAP_SIZE;
+
+	c->bitmap = bitmap;
+	c->cap    = 0;
+}
+
+static void _Container_ToArray
+(
+	Roaring *r,
+	RoaringContainer *c
+) {
+	ASSERT(IS_BITMAP(c));
+	ASSERT(c->card <= ROARING_ARRAY_MAX);
+
+	uint32_t cap = (c->card > ROARING_ARRAY_MIN_CAP) ?
+		c->card : ROARING_ARRAY_MIN_CAP;
+	uint16_t *array = rm_malloc(sizeof(uint16_t) * cap);
+
+	uint32_t n = 0;
+	for(uint32_t w = 0; w < ROARING_BITMAP_WORDS; w++) {
+		uint64_t word = c->bitmap[w];
+		while(word != 0) {
+			array[n++] = (w << 6) | __builtin_ctzll(word);
+			word &= word - 1;
+		}
+	}
+	ASSERT(n == c->card);
+
+	rm_free(c->bitmap);
+	r->memory -= ROARING_BITMAP_SIZE;
+	r->memory += sizeof(uint16_t) * cap;
+
+	c->array = array;
+	c->cap   = cap;
+}
+
+static void _Container_FreeData
+(
+	Roaring *r,
+	RoaringContainer *c
+) {
+	if(IS_BITMAP(c)) {
+		r->memory -= ROARING_BITMAP_SIZE;
+	} else {
+		r->memory -= sizeof(uint16_t) * c->cap;
+	}
+
+	rm_free(c->array);
+	c->array = NULL;
+}
+
+static bool _Container_Add
+(
+	Roaring *r,
+	RoaringContainer *c,
+	uint16_t low
+) {
+	if(!IS_BITMAP(c)) {
+		uint32_t pos;
+		if(_Array_Find(c, low, &pos)) return false;
+
+		if(c->card < ROARING_ARRAY_MAX) {
+			if(c->card == c->cap) {
+				uint32_t cap = c->cap * 2;
+				if(cap > ROARING_ARRAY_MAX) cap = ROARING_ARRAY_MAX;
+				_Array_Resize(r, c, cap);
+			}
+
+			memmove(c->array + pos + 1, c->array + pos,
+					sizeof(uint16_t) * (c->card - pos));
+			c->array[pos] = low;
+			c->card++;
+			return true;
+		}
+
+		// array is full, switch to a bitmap
+		_Container_ToBitmap(r, c);
+	}
+
+	if(_Bitmap_Test(c->bitmap, low)) return false;
+
+	c->bitmap[low >> 6] |= (1ULL << (low & 63));
+	c->card++;
+	return true;
+}
+
+static bool _Container_Remove
+(
+	Roaring *r,
+	RoaringContainer *c,
+	uint16_t low
+) {
+	if(IS_BITMAP(c)) {
+		if(!_Bitmap_Test(c->bitmap, low)) return false;
+
+		c->bitmap[low >> 6] &= ~(1ULL << (low & 63));
+		c->card--;
+		if(c->card <= ROARING_BITMAP_MIN) _Container_ToArray(r, c);
+		return true;
+	}
+
+	uint32_t pos;
+	if(!_Array_Find(c, low, &pos)) return false;
+
+	memmove(c->array + pos, c->array + pos + 1,
+			sizeof(uint16_t) * (c->card - pos - 1));
+	c->card--;
+
+	// release unused capacity
+	if(c->card > 0 && c->cap > ROARING_ARRAY_MIN_CAP && c->card <= c->cap / 4) {
+		_Array_Resize(r, c, c->cap / 2);
+	}
+
+	return true;
+}
+
+// intersect container 'c' with container 'd' of the same key
+static void _Container_And
+(
+	Roaring *r,
+	RoaringContainer *c,
+	const RoaringContainer *d
+) {
+	ASSERT(c->key == d->key);
+
+	uint32_t n = 0;
+
+	if(!IS_BITMAP(c) && !IS_BITMAP(d)) {
+		// merge sorted arrays
+		uint32_t i = 0;
+		uint32_t j = 0;
+		while(i < c->card && j < d->card) {
+			uint16_t x = c->array[i];
+			uint16_t y = d->array[j];
+			if(x == y) c->array[n++] = x;
+			i += (x <= y);
+			j += (y <= x);
+		}
+		c->card = n;
+	} else if(!IS_BITMAP(c)) {
+		for(uint32_t i = 0; i < c->card; i++) {
+			uint16_t low = c->array[i];
+			if(_Bitmap_Test(d->bitmap, low)) c->array[n++] = low;
+		}
+		c->card = n;
+	} else if(IS_BITMAP(d)) {
+		for(uint32_t w = 0; w < ROARING_BITMAP_WORDS; w++) {
+			c->bitmap[w] &= d->bitmap[w];
+			n += __builtin_popcountll(c->bitmap[w]);
+		}
+		c->card = n;
+		if(n <= ROARING_BITMAP_MIN) _Container_ToArray(r, c);
+	} else {
+		// bitmap and array, the intersection is at most the array's size
+		uint32_t cap = (d->card > ROARING_ARRAY_MIN_CAP) ?
+			d->card : ROARING_ARRAY_MIN_CAP;
+		uint16_t *array = rm_malloc(sizeof(uint16_t) * cap);
+
+		for(uint32_t j = 0; j < d->card; j++) {
+			uint16_t low = d->array[j];
+			if(_Bitmap_Test(c->bitmap, low)) array[n++] = low;
+		}
+
+		_Container_FreeData(r, c);
+		r->memory += sizeof(uint16_t) * cap;
+		c->array = array;
+		c->cap   = cap;
+		c->card  = n;
+	}
+}
+
+//------------------------------------------------------------------------------
+// set
+//------------------------------------------------------------------------------
+
+// binary search container of 'key'
+// returns true if found, 'pos' is set to its position or insertion point
+static bool _Roaring_Find
+(
+	const Roaring *r,
+	uint64_t key,
+	uint32_t *pos
+) {
+	uint32_t lo = 0;
+	uint32_t hi = r->count;
+
+	while(lo < hi) {
+		uint32_t mid = (lo + hi) / 2;
+		if(r->containers[mid].key < key) lo = mid + 1;
+		else hi = mid;
+	}
+
+	*pos = lo;
+	return lo < r->count && r->containers[lo].key == key;
+}
+
+// insert an empty array container at position 'pos'
+static RoaringContainer *_Roaring_InsertContainer
+(
+	Roaring *r,
+	uint32_t pos,
+	uint64_t key
+) {
+	if(r->count == r->cap) {
+		uint32_t cap = (r->cap > 0) ? r->cap * 2 : ROARING_CONTAINERS_MIN_CAP;
+		r->containers = rm_realloc(r->containers,
+				sizeof(RoaringContainer) * cap);
+		r->memory += sizeof(RoaringContainer) * (cap - r->cap);
+		r->cap     = cap;
+	}
+
+	memmove(r->containers + pos + 1, r->containers + pos,
+			sizeof(RoaringContainer) * (r->count - pos));
+	r->count++;
+
+	RoaringContainer *c = r->containers + pos;
+	c->key     = key;
+	c->card    = 0;
+	c->cap     = ROARING_ARRAY_MIN_CAP;
+	c->array   = rm_malloc(sizeof(uint16_t) * ROARING_ARRAY_MIN_CAP);
+	r->memory += sizeof(uint16_t) * ROARING_ARRAY_MIN_CAP;
+
+	return c;
+}
+
+static void _Roaring_RemoveContainer
+(
+	Roaring *r,
+	uint32_t pos
+) {
+	_Container_FreeData(r, r->containers + pos);
+
+	memmove(r->containers + pos, r->containers + pos + 1,
+			sizeof(RoaringContainer) * (r->count - pos - 1));
+	r->count--;
+}
+
+// create an empty set
+Roaring *Roaring_New(void) {
+	Roaring *r = rm_calloc(1, sizeof(Roaring));
+	r->memory = sizeof(Roaring);
+	return r;
+}
+
+// clone set
+Roaring *Roaring_Clone
+(
+	const Roaring *r  // set to clone
+) {
+	ASSERT(r != NULL);
+
+	Roaring *clone = rm_malloc(sizeof(Roaring));
+	*clone = *r;
+	clone->containers = NULL;
+
+	if(r->cap > 0) {
+		clone->containers = rm_malloc(sizeof(RoaringContainer) * r->cap);
+		memcpy(clone->containers, r->containers,
+				sizeof(RoaringContainer) * r->count);
+	}
+
+	for(uint32_t i = 0; i < r->count; i++) {
+		const RoaringContainer *c = r->containers + i;
+		size_t size = IS_BITMAP(c) ?
+			ROARING_BITMAP_SIZE : sizeof(uint16_t) * c->cap;
+
+		clone->containers[i].array = rm_malloc(size);
+		memcpy(clone->containers[i].array, c->array, size);
+	}
+
+	return clone;
+}
+
+// add value to set
+// returns false if value is already a member
+bool Roaring_Add
+(
+	Roaring *r,  // set
+	uint64_t v   // value to add
+) {
+	ASSERT(r != NULL);
+
+	uint32_t pos;
+	RoaringContainer *c;
+
+	if(_Roaring_Find(r, KEY(v), &pos)) {
+		c = r->containers + pos;
+	} else {
+		c = _Roaring_InsertContainer(r, pos, KEY(v));
+	}
+
+	if(!_Container_Add(r, c, LOW(v))) return false;
+
+	r->card++;
+	return true;
+}
+
+// remove value from set
+// returns false if value isn't a member
+bool Roaring_Remove
+(
+	Roaring *r,  // set
+	uint64_t v   // value to remove
+) {
+	ASSERT(r != NULL);
+
+	uint32_t pos;
+	if(!_Roaring_Find(r, KEY(v), &pos)) return false;
+
+	RoaringContainer *c = r->containers + pos;
+	if(!_Container_Remove(r, c, LOW(v))) return false;
+
+	if(c->card == 0) _Roaring_RemoveContainer(r, pos);
+
+	r->card--;
+	return true;
+}
+
+// returns true if 'v' is a member of set
+bool Roaring_Contains
+(
+	const Roaring *r,  // set
+	uint64_t v         // value to look for
+) {
+	ASSERT(r != NULL);
+
+	uint32_t pos;
+	if(!_Roaring_Find(r, KEY(v), &pos)) return false;
+
+	const RoaringContainer *c = r->containers + pos;
+	if(IS_BITMAP(c)) return _Bitmap_Test(c->bitmap, LOW(v));
+
+	return _Array_Find(c, LOW(v), &pos);
+}
+
+// returns number of values in set
+uint64_t Roaring_Cardinality
+(
+	const Roaring *r  // set
+) {
+	ASSERT(r != NULL);
+
+	return r->card;
+}
+
+// intersect 'a' with 'b', the result is stored in 'a'
+void Roaring_And
+(
+	Roaring *a,       // set to intersect, [output] intersection
+	const Roaring *b  // set to intersect with
+) {
+	ASSERT(a != NULL);
+	ASSERT(b != NULL);
+
+	uint32_t j    = 0;  // position within b
+	uint32_t n    = 0;  // number of retained containers
+	uint64_t card = 0;  // cardinality of intersection
+
+	for(uint32_t i = 0; i < a->count; i++) {
+		RoaringContainer *c = a->containers + i;
+
+		while(j < b->count && b->containers[j].key < c->key) j++;
+
+		if(j < b->count && b->containers[j].key == c->key) {
+			_Container_And(a, c, b->containers + j);
+		} else {
+			c->card = 0;
+		}
+
+		if(c->card == 0) {
+			_Container_FreeData(a, c);
+			continue;
+		}
+
+		card += c->card;
+		a->containers[n++] = *c;
+	}
+
+	a->count = n;
+	a->card  = card;
+}
+
+// returns number of bytes used by set
+size_t Roaring_Memory
+(
+	const Roaring *r  // set
+) {
+	ASSERT(r != NULL);
+
+	return r->memory;
+}
+
+// free set
+void Roaring_Free
+(
+	Roaring *r  // set to free
+) {
+	if(r == NULL) return;
+
+	for(uint32_t i = 0; i < r->count; i++) {
+		rm_free(r->containers[i].array);
+	}
+
+	if(r->containers != NULL) rm_free(r->containers);
+	rm_free(r);
+}
+
+//------------------------------------------------------------------------------
+// iterator
+//------------------------------------------------------------------------------
+
+// initialize iterator over set
+void RoaringIterator_Init
+(
+	RoaringIterator *it,  // iterator to initialize
+	const Roaring *r      // set to iterate
+) {
+	ASSERT(it != NULL);
+	ASSERT(r  != NULL);
+
+	it->r   = r;
+	it->c   = 0;
+	it->pos = 0;
+}
+
+// advance iterator, returns false once depleted
+bool RoaringIterator_Next
+(
+	RoaringIterator *it,  // iterator
+	uint64_t *v           // [output] value
+) {
+	ASSERT(it != NULL);
+	ASSERT(v  != NULL);
+
+	const Roaring *r = it->r;
+
+	for(; it->c < r->count; it->c++, it->pos = 0) {
+		const RoaringContainer *c = r->containers + it->c;
+
+		if(!IS_BITMAP(c)) {
+			if(it->pos < c->card) {
+				*v = (c->key << 16) | c->array[it->pos++];
+				return true;
+			}
+			continue;
+		}
+
+		// bitmap, 'pos' is the next bit to inspect
+		while(it->pos < ROARING_BITMAP_WORDS * 64) {
+			uint32_t w = it->pos >> 6;
+			uint64_t word = c->bitmap[w] & (~0ULL << (it->pos & 63));
+
+			if(word != 0) {
+				uint32_t low = (w << 6) | __builtin_ctzll(word);
+				it->pos = low + 1;
+				*v = (c->key << 16) | low;
+				return true;
+			}
+
+			it->pos = (w + 1) << 6;
+		}
+	}
+
+	return false;
+}
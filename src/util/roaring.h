@@ -0,0 +1,98 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// compressed set of 64 bit integers
+//
+// values are partitioned by their high bits into containers
+// each container holds the low 16 bits of its values either as a sorted
+// array, while sparse, or as a bitmap of 2^16 bits once dense
+
+typedef struct Roaring Roaring;
+
+// iterator over the values of a set, in ascending order
+// the set must not be modified while iterated
+typedef struct {
+	const Roaring *r;  // iterated set
+	uint32_t c;        // current container
+	uint32_t pos;      // position within container
+} RoaringIterator;
+
+// create an empty set
+Roaring *Roaring_New(void);
+
+// clone set
+Roaring *Roaring_Clone
+(
+	const Roaring *r  // set to clone
+);
+
+// add value to set
+// returns false if value is already a member
+bool Roaring_Add
+(
+	Roaring *r,  // set
+	uint64_t v   // value to add
+);
+
+// remove value from set
+// returns false if value isn't a member
+bool Roaring_Remove
+(
+	Roaring *r,  // set
+	uint64_t v   // value to remove
+);
+
+// returns true if 'v' is a member of set
+bool Roaring_Contains
+(
+	const Roaring *r,  // set
+	uint64_t v         // value to look for
+);
+
+// returns number of values in set
+uint64_t Roaring_Cardinality
+(
+	const Roaring *r  // set
+);
+
+// intersect 'a' with 'b', the result is stored in 'a'
+void Roaring_And
+(
+	Roaring *a,       // set to intersect, [output] intersection
+	const Roaring *b  // set to intersect with
+);
+
+// returns number of bytes used by set
+size_t Roaring_Memory
+(
+	const Roaring *r  // set
+);
+
+// free set
+void Roaring_Free
+(
+	Roaring *r  // set to free
+);
+
+// initialize iterator over set
+void RoaringIterator_Init
+(
+	RoaringIterator *it,  // iterator to initialize
+	const Roaring *r      // set to iterate
+);
+
+// advance iterator, returns false once depleted
+bool RoaringIterator_Next
+(
+	RoaringIterator *it,  // iterator
+	uint64_t *v           // [output] value
+);
@@ -0,0 +1,172 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "rmalloc.h"
+#include "string_pool.h"
+
+#include <string.h>
+
+// get interned string header from its content
+#define INTERNED_STRING(s) \
+	((InternedString *)((char *)(s) - offsetof(InternedString, str)))
+
+static uint64_t _str_hash
+(
+	const void *key
+) {
+	return HashTableGenHashFunction(key, strlen((const char *)key));
+}
+
+static int _str_compare
+(
+	dict *d,
+	const void *key1,
+	const void *key2
+) {
+	return strcmp((const char *)key1, (const char *)key2) == 0;
+}
+
+// keys are owned by their interned strings
+static dictType _dt = { _str_hash, NULL, NULL, _str_compare, NULL, NULL,
+	NULL, NULL, NULL, NULL};
+
+StringPool *StringPool_New(void) {
+	StringPool *pool = rm_malloc(sizeof(StringPool));
+
+	pool->strings = HashTableCreate(&_dt);
+	int res = pthread_mutex_init(&pool->lock, NULL);
+	ASSERT(res == 0);
+	UNUSED(res);
+
+	return pool;
+}
+
+// acquire a reference to an interned string, unless it is being released
+// returns false if the string's last reference was already released
+static bool _StringPool_TryRetain
+(
+	InternedString *is  // interned string
+) {
+	uint32_t refcount = __atomic_load_n(&is->refcount, __ATOMIC_RELAXED);
+	while(refcount > 0) {
+		if(__atomic_compare_exchange_n(&is->refcount, &refcount, refcount + 1,
+					true, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+char *StringPool_Intern
+(
+	StringPool *pool,  // string pool
+	const char *s      // string to intern
+) {
+	ASSERT(s    != NULL);
+	ASSERT(pool != NULL);
+
+	InternedString *is;
+
+	pthread_mutex_lock(&pool->lock);
+
+	dictEntry *entry = HashTableFind(pool->strings, s);
+	if(entry != NULL) {
+		// string already interned, add a reference
+		is = INTERNED_STRING(HashTableGetKey(entry));
+		if(_StringPool_TryRetain(is)) goto done;
+
+		// string's last reference was released, its releaser is about to
+		// free it, unlink it from the pool and intern a new copy
+		int res = HashTableDelete(pool->strings, is->str);
+		ASSERT(res == DICT_OK);
+		UNUSED(res);
+	}
+
+	size_t len = strlen(s);
+	is = rm_malloc(sizeof(InternedString) + len + 1);
+	is->pool     = pool;
+	is->refcount = 1;
+	memcpy(is->str, s, len + 1);
+
+	HashTableAdd(pool->strings, is->str, NULL);
+
+done:
+	pthread_mutex_unlock(&pool->lock);
+
+	return is->str;
+}
+
+void StringPool_Retain
+(
+	const char *s  // interned string
+) {
+	ASSERT(s != NULL);
+
+	// caller holds a reference, the string can't be removed concurrently
+	InternedString *is = INTERNED_STRING(s);
+	__atomic_add_fetch(&is->refcount, 1, __ATOMIC_RELAXED);
+}
+
+void StringPool_Release
+(
+	const char *s  // interned string
+) {
+	ASSERT(s != NULL);
+
+	InternedString *is = INTERNED_STRING(s);
+
+	// the pool's lock is only acquired to remove the string
+	// once a string's count drops to 0 it is never retained again
+	// as such only a single thread gets to free it
+	if(__atomic_sub_fetch(&is->refcount, 1, __ATOMIC_ACQ_REL) > 0) return;
+
+	StringPool *pool = is->pool;
+	pthread_mutex_lock(&pool->lock);
+
+	// the string might have been unlinked and replaced by StringPool_Intern
+	dictEntry *entry = HashTableFind(pool->strings, is->str);
+	if(entry != NULL && HashTableGetKey(entry) == is->str) {
+		int res = HashTableDelete(pool->strings, is->str);
+		ASSERT(res == DICT_OK);
+		UNUSED(res);
+	}
+	rm_free(is);
+
+	pthread_mutex_unlock(&pool->lock);
+}
+
+uint64_t StringPool_Count
+(
+	StringPool *pool  // string pool
+) {
+	ASSERT(pool != NULL);
+
+	pthread_mutex_lock(&pool->lock);
+	uint64_t n = HashTableElemCount(pool->strings);
+	pthread_mutex_unlock(&pool->lock);
+
+	return n;
+}
+
+void StringPool_Free
+(
+	StringPool *pool  // string pool to free
+) {
+	ASSERT(pool != NULL);
+
+	dictEntry *entry;
+	dictIterator *it = HashTableGetIterator(pool->strings);
+	while((entry = HashTableNext(it)) != NULL) {
+		rm_free(INTERNED_STRING(HashTableGetKey(entry)));
+	}
+	HashTableReleaseIterator(it);
+
+	HashTableRelease(pool->strings);
+	pthread_mutex_destroy(&pool->lock);
+	rm_free(pool);
+}
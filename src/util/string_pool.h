@@ -0,0 +1,68 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <pthread.h>
+#include "dict.h"
+
+// strings longer than this are never interned
+// long strings tend to be unique e.g. descriptions
+#define STRING_POOL_MAX_LEN 128
+
+// a pool of reference counted, immutable strings
+// equal strings interned into the same pool share a single allocation
+// such that equal interned strings can be compared by pointer
+typedef struct StringPool {
+	dict *strings;         // interned strings
+	pthread_mutex_t lock;  // protects strings
+} StringPool;
+
+// interned string, the pool hands out pointers to 'str'
+typedef struct {
+	StringPool *pool;   // owning pool
+	uint32_t refcount;  // number of references
+	char str[];         // null terminated string
+} InternedString;
+
+// create a new string pool
+StringPool *StringPool_New(void);
+
+// intern string 's'
+// returns a reference to the pool's copy of 's'
+// the reference must be released via StringPool_Release
+char *StringPool_Intern
+(
+	StringPool *pool,  // string pool
+	const char *s      // string to intern
+);
+
+// acquire an additional reference to an interned string
+void StringPool_Retain
+(
+	const char *s  // interned string
+);
+
+// release a reference to an interned string
+// the string is removed from its pool once its last reference is released
+void StringPool_Release
+(
+	const char *s  // interned string
+);
+
+// number of distinct strings in pool
+uint64_t StringPool_Count
+(
+	StringPool *pool  // string pool
+);
+
+// free string pool along with all of its strings
+void StringPool_Free
+(
+	StringPool *pool  // string pool to free
+);
@@ -33,6 +33,9 @@ int ThreadPools_Init
 	config_read = Config_Option_get(Config_MAX_QUEUED_QUERIES, &max_queue_size);
 	ASSERT(config_read == true);
 
+	config_read = Config_Option_get(Config_WRITER_THREAD_COUNT, &writer_count);
+	ASSERT(config_read == true);
+
 	return ThreadPools_CreatePools(reader_count, writer_count, max_queue_size);
 }
 
@@ -165,6 +168,14 @@ int ThreadPools_AddWorkWriter
 	return thpool_add_work(_writers_thpool, function_p, arg_p);
 }
 
+uint64_t ThreadPools_WriterQueueLength
+(
+	void
+) {
+	ASSERT(_writers_thpool != NULL);
+	return thpool_get_jobqueue_len(_writers_thpool);
+}
+
 void ThreadPools_SetMaxPendingWork(uint64_t val) {
 	if(_readers_thpool != NULL) thpool_set_jobqueue_cap(_readers_thpool, val);
 	if(_writers_thpool != NULL) thpool_set_jobqueue_cap(_writers_thpool, val);
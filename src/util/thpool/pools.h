@@ -59,6 +59,9 @@ int ThreadPools_AddWorkWriter
 	int force                    // true will add task even if internal queue is full
 );
 
+// returns number of tasks queued in the writers thread pool
+uint64_t ThreadPools_WriterQueueLength(void);
+
 // sets the limit on max queued queries in each thread pool
 void ThreadPools_SetMaxPendingWork
 (
@@ -0,0 +1,143 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "rmalloc.h"
+#include "thread_profile.h"
+
+#include <string.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+__thread ThreadProfile thread_profile = {0};
+
+#ifdef __linux__
+
+// perf event config of each hardware counter
+static const uint64_t _hw_config[HW_COUNTER_COUNT] = {
+	PERF_COUNT_HW_CPU_CYCLES,
+	PERF_COUNT_HW_CACHE_MISSES,
+	PERF_COUNT_HW_BRANCH_MISSES
+};
+
+static void _ThreadProfile_CloseCounters(void) {
+	for(int i = 0; i < HW_COUNTER_COUNT; i++) {
+		if(thread_profile.fds[i] != -1) close(thread_profile.fds[i]);
+		thread_profile.fds[i] = -1;
+	}
+	thread_profile.hw = false;
+}
+
+// open a group of hardware counters measuring the calling thread
+// counters are unavailable when the kernel or the host doesn't expose them
+// e.g. perf_event_paranoid is too strict or running within a VM
+static bool _ThreadProfile_OpenCounters(void) {
+	int leader = -1;
+
+	for(int i = 0; i < HW_COUNTER_COUNT; i++) {
+		struct perf_event_attr attr;
+		memset(&attr, 0, sizeof(attr));
+		attr.size           = sizeof(attr);
+		attr.type           = PERF_TYPE_HARDWARE;
+		attr.config         = _hw_config[i];
+		attr.disabled       = (leader == -1);  // group is enabled by its leader
+		attr.exclude_kernel = 1;
+		attr.exclude_hv     = 1;
+		attr.read_format    = PERF_FORMAT_GROUP;
+
+		int fd = syscall(__NR_perf_event_open, &attr, 0, -1, leader, 0);
+		if(fd == -1) {
+			_ThreadProfile_CloseCounters();
+			return false;
+		}
+
+		thread_profile.fds[i] = fd;
+		if(leader == -1) leader = fd;
+	}
+
+	ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+	ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+	thread_profile.hw = true;
+	return true;
+}
+
+static void _ThreadProfile_ReadCounters
+(
+	uint64_t *counters  // [output] hardware counters
+) {
+	// group read format: number of counters followed by their values
+	uint64_t buff[1 + HW_COUNTER_COUNT];
+	ssize_t n = read(thread_profile.fds[0], buff, sizeof(buff));
+	if(n != sizeof(buff)) return;
+
+	memcpy(counters, buff + 1, sizeof(uint64_t) * HW_COUNTER_COUNT);
+}
+
+#else
+
+static void _ThreadProfile_CloseCounters(void) {
+	thread_profile.hw = false;
+}
+
+static bool _ThreadProfile_OpenCounters(void) {
+	return false;
+}
+
+static void _ThreadProfile_ReadCounters
+(
+	uint64_t *counters  // [output] hardware counters
+) {
+	UNUSED(counters);
+}
+
+#endif
+
+bool ThreadProfile_Start
+(
+	bool hw  // try collecting hardware counters
+) {
+	ASSERT(thread_profile.active == false);
+
+	thread_profile.active    = true;
+	thread_profile.hw        = false;
+	thread_profile.grb_time  = 0;
+	thread_profile.mxm_count = 0;
+	for(int i = 0; i < HW_COUNTER_COUNT; i++) thread_profile.fds[i] = -1;
+
+	// count allocated bytes
+	rm_track_allocations(true);
+
+	if(hw) _ThreadProfile_OpenCounters();
+	return thread_profile.hw;
+}
+
+void ThreadProfile_Stop(void) {
+	ASSERT(thread_profile.active == true);
+
+	_ThreadProfile_CloseCounters();
+	rm_track_allocations(false);
+	thread_profile.active = false;
+}
+
+void ThreadProfile_Sample
+(
+	ThreadProfileSample *sample  // [output] counters
+) {
+	ASSERT(sample != NULL);
+
+	memset(sample->hw, 0, sizeof(sample->hw));
+
+	sample->alloc     = rm_allocated_bytes();
+	sample->grb_time  = thread_profile.grb_time;
+	sample->mxm_count = thread_profile.mxm_count;
+
+	if(thread_profile.hw) _ThreadProfile_ReadCounters(sample->hw);
+}
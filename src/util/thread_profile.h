@@ -0,0 +1,84 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include <time.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// per thread profiling counters
+// collected while a query is being profiled
+// operations sample the counters before and after they produce a record
+// and attribute the difference to themselves
+
+// hardware counters
+typedef enum {
+	HW_COUNTER_CYCLES,         // CPU cycles
+	HW_COUNTER_CACHE_MISSES,   // last level cache misses
+	HW_COUNTER_BRANCH_MISSES,  // mispredicted branches
+	HW_COUNTER_COUNT
+} HWCounter;
+
+typedef struct {
+	bool active;                   // profiling is active on this thread
+	bool hw;                       // hardware counters are collected
+	int fds[HW_COUNTER_COUNT];     // perf event file descriptors
+	uint64_t grb_time;             // time spent in GraphBLAS in nanoseconds
+	uint64_t mxm_count;            // number of matrix multiplications
+} ThreadProfile;
+
+// snapshot of the calling thread's profiling counters
+typedef struct {
+	uint64_t alloc;                // bytes allocated
+	uint64_t grb_time;             // time spent in GraphBLAS in nanoseconds
+	uint64_t mxm_count;            // number of matrix multiplications
+	uint64_t hw[HW_COUNTER_COUNT]; // hardware counters
+} ThreadProfileSample;
+
+extern __thread ThreadProfile thread_profile;
+
+// start profiling the calling thread
+// returns true if hardware counters are collected
+bool ThreadProfile_Start
+(
+	bool hw  // try collecting hardware counters
+);
+
+// stop profiling the calling thread
+void ThreadProfile_Stop(void);
+
+// sample the calling thread's profiling counters
+void ThreadProfile_Sample
+(
+	ThreadProfileSample *sample  // [output] counters
+);
+
+static inline uint64_t _ThreadProfile_Now(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+// mark the beginning of a GraphBLAS call
+// returns the call's start time, 0 if profiling is inactive
+static inline uint64_t ThreadProfile_GrBBegin(void) {
+	return (thread_profile.active) ? _ThreadProfile_Now() : 0;
+}
+
+// mark the end of a GraphBLAS call started at 'start'
+static inline void ThreadProfile_GrBEnd
+(
+	uint64_t start  // value returned by ThreadProfile_GrBBegin
+) {
+	if(start == 0) return;
+	thread_profile.grb_time += _ThreadProfile_Now() - start;
+}
+
+// count a matrix multiplication
+static inline void ThreadProfile_CountMxM(void) {
+	if(thread_profile.active) thread_profile.mxm_count++;
+}
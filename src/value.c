@@ -15,6 +15,7 @@
 #include <ctype.h>
 #include <sys/param.h>
 #include "util/rmalloc.h"
+#include "util/string_pool.h"
 #include "datatypes/map.h"
 #include "datatypes/array.h"
 #include "datatypes/point.h"
@@ -111,6 +112,12 @@ SIValue SI_TransferStringVal(char *s) {
 	};
 }
 
+SIValue SI_InternedStringVal(char *s) {
+	return (SIValue) {
+		.stringval = s, .type = T_STRING, .allocation = M_INTERN
+	};
+}
+
 SIValue SI_Point(float latitude, float longitude) {
 	return (SIValue) {
 		.type = T_POINT, .allocation = M_NONE,
@@ -124,7 +131,7 @@ SIValue SI_Point(float latitude, float longitude) {
 SIValue SI_ShareValue(const SIValue v) {
 	SIValue dup = v;
 	// If the original value owns an allocation, mark that the duplicate shares it.
-	if(v.allocation == M_SELF) dup.allocation = M_VOLATILE;
+	if(v.allocation & (M_SELF | M_INTERN)) dup.allocation = M_VOLATILE;
 	return dup;
 }
 
@@ -135,6 +142,11 @@ SIValue SI_CloneValue(const SIValue v) {
 	if(v.allocation == M_NONE) return v; // Stack value; no allocation necessary.
 
 	if(v.type == T_STRING) {
+		// Interned strings are shared, add a reference.
+		if(v.allocation == M_INTERN) {
+			StringPool_Retain(v.stringval);
+			return v;
+		}
 		// Allocate a new copy of the input's string value.
 		return SI_DuplicateStringVal(v.stringval);
 	}
@@ -187,7 +199,7 @@ SIValue SI_ConstValue(const SIValue *v) {
 // Clone 'v' and set v's allocation to volatile if 'v' owned the memory
 SIValue SI_TransferOwnership(SIValue *v) {
 	SIValue dup = *v;
-	if(v->allocation == M_SELF) v->allocation = M_VOLATILE;
+	if(v->allocation & (M_SELF | M_INTERN)) v->allocation = M_VOLATILE;
 	return dup;
 }
 
@@ -195,7 +207,7 @@ SIValue SI_TransferOwnership(SIValue *v) {
  * with no responsibility for freeing or guarantee regarding scope.
  * This is used in cases like performing shallow copies of scalars in Record entries. */
 void SIValue_MakeVolatile(SIValue *v) {
-	if(v->allocation == M_SELF) v->allocation = M_VOLATILE;
+	if(v->allocation & (M_SELF | M_INTERN)) v->allocation = M_VOLATILE;
 }
 
 /* Ensure that any allocation held by the given SIValue is guaranteed to not go out
@@ -597,6 +609,8 @@ int SIValue_Compare(const SIValue a, const SIValue b, int *disjointOrNull) {
 
 			return SAFE_COMPARISON_RESULT(a.doubleval - b.doubleval);
 		case T_STRING:
+			// equal interned strings share their allocation
+			if(a.stringval == b.stringval) return 0;
 			return strcmp(a.stringval, b.stringval);
 		case T_NODE:
 		case T_EDGE:
@@ -826,6 +840,12 @@ SIValue SIValue_FromBinary
 }
 			
 void SIValue_Free(SIValue v) {
+	// Release reference to interned string.
+	if(v.allocation == M_INTERN) {
+		StringPool_Release(v.stringval);
+		return;
+	}
+
 	// The free routine only performs work if it owns a heap allocation.
 	if(v.allocation != M_SELF) return;
 
@@ -44,7 +44,8 @@ typedef enum {
 	M_NONE = 0,             // SIValue is not heap-allocated
 	M_SELF = (1 << 0),      // SIValue is responsible for freeing its reference
 	M_VOLATILE = (1 << 1),  // SIValue does not own its reference and may go out of scope
-	M_CONST = (1 << 2)      // SIValue does not own its allocation, but its access is safe
+	M_CONST = (1 << 2),     // SIValue does not own its allocation, but its access is safe
+	M_INTERN = (1 << 3)     // SIValue holds a reference to an interned string
 } SIAllocation;
 
 #define SI_TYPE(value) (value).type
@@ -119,6 +120,9 @@ SIValue SI_Point(float latitude, float longitude);
 // Duplicate and ultimately free the input string.
 SIValue SI_DuplicateStringVal(const char *s);
 
+// Take ownership over a reference to an interned string, see util/string_pool.h
+SIValue SI_InternedStringVal(char *s);
+
 // Neither duplicate nor assume ownership of input string.
 SIValue SI_ConstStringVal(const char *s);
 
@@ -0,0 +1,99 @@
+from common import *
+
+GRAPH_ID = "aggregate_cache"
+
+# number of 'Person' nodes
+PERSON_COUNT = 1000
+
+# label wide aggregations over a single attribute are computed
+# from cached attribute summaries, once enabled via AGGREGATE_CACHE_SIZE
+
+AGGREGATIONS = ["count", "sum", "avg", "min", "max"]
+
+class testAggregateCache():
+    def __init__(self):
+        self.env = Env(decodeResponses=True, moduleArgs='AGGREGATE_CACHE_SIZE 8')
+        self.conn = self.env.getConnection()
+        self.graph = Graph(self.conn, GRAPH_ID)
+        self.populate_graph()
+
+    def populate_graph(self):
+        # every third person is missing 'score'
+        self.graph.query(f"""UNWIND range(1, {PERSON_COUNT}) AS x
+                             CREATE (:Person {{
+                                age: x % 90,
+                                score: CASE WHEN x % 3 = 0 THEN NULL ELSE x / 7.0 END,
+                                name: 'p' + toString(x % 50),
+                                active: x % 2 = 0,
+                                mixed: CASE WHEN x % 2 = 0 THEN x ELSE toString(x) END}})""")
+
+    def set_cache_size(self, size):
+        self.conn.execute_command("GRAPH.CONFIG", "SET", "AGGREGATE_CACHE_SIZE", size)
+
+    def aggregate(self, func, attr):
+        q = f"MATCH (p:Person) RETURN {func}(p.{attr})"
+        return self.graph.query(q).result_set[0][0]
+
+    def test01_config(self):
+        conf = self.conn.execute_command("GRAPH.CONFIG", "GET", "AGGREGATE_CACHE_SIZE")
+        self.env.assertEquals(conf[1], 8)
+
+    def test02_plan(self):
+        # aggregation is reduced to a projection
+        plan = self.graph.execution_plan("MATCH (p:Person) RETURN avg(p.age)")
+        self.env.assertNotIn("Aggregate", plan)
+        self.env.assertNotIn("Node By Label Scan", plan)
+
+        # grouping, filtering and distinct aggregations aren't reduced
+        queries = ["MATCH (p:Person) RETURN p.name, avg(p.age)",
+                   "MATCH (p:Person) WHERE p.age > 3 RETURN avg(p.age)",
+                   "MATCH (p:Person) RETURN count(DISTINCT p.age)",
+                   "MATCH (p:Person) RETURN avg(p.age + 1)",
+                   "MATCH (p:Person) RETURN collect(p.age)"]
+        for q in queries:
+            plan = self.graph.execution_plan(q)
+            self.env.assertIn("Aggregate", plan)
+
+        # attributes holding mixed types aren't summarized
+        plan = self.graph.execution_plan("MATCH (p:Person) RETURN max(p.mixed)")
+        self.env.assertIn("Aggregate", plan)
+
+    def test03_results(self):
+        # results taken from summaries match results of a full scan
+        attrs = ["age", "score", "name", "active", "mixed", "none"]
+
+        expected = {}
+        self.set_cache_size(0)
+        for func in AGGREGATIONS:
+            for attr in attrs:
+                try:
+                    expected[(func, attr)] = self.aggregate(func, attr)
+                except ResponseError as e:
+                    expected[(func, attr)] = str(e)
+
+        self.set_cache_size(8)
+        for func in AGGREGATIONS:
+            for attr in attrs:
+                try:
+                    actual = self.aggregate(func, attr)
+                except ResponseError as e:
+                    actual = str(e)
+                self.env.assertEquals(actual, expected[(func, attr)])
+
+    def test04_writes(self):
+        # summaries are rebuilt once the graph is modified
+        before = self.aggregate("max", "age")
+        self.graph.query("CREATE (:Person {age: 1000})")
+        self.env.assertEquals(self.aggregate("max", "age"), 1000)
+
+        self.graph.query("MATCH (p:Person) WHERE p.age = 1000 DELETE p")
+        self.env.assertEquals(self.aggregate("max", "age"), before)
+
+        self.graph.query("MATCH (p:Person) WHERE p.age = 0 SET p.age = NULL")
+        self.env.assertEquals(self.aggregate("min", "age"), 1)
+        self.env.assertEquals(self.aggregate("count", "age"),
+                              PERSON_COUNT - PERSON_COUNT // 90)
+
+    def test05_unknown_label(self):
+        res = self.graph.query("MATCH (p:Unknown) RETURN sum(p.age)").result_set
+        self.env.assertEquals(res[0][0], 0)
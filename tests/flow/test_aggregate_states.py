@@ -0,0 +1,82 @@
+from common import *
+
+GRAPH_ID = "aggregate_states"
+
+# count, sum, avg, min, max and collect applied directly to a single argument
+# keep a compact state per group, other aggregate expressions are evaluated
+# through the expression tree, wrapping an aggregation with coalesce
+# forces the latter, results of both must match
+
+AGGREGATIONS = ["count", "sum", "avg", "min", "max", "collect"]
+
+class testAggregateStates():
+    def __init__(self):
+        self.env = Env(decodeResponses=True)
+        self.conn = self.env.getConnection()
+        self.graph = Graph(self.conn, GRAPH_ID)
+        self.populate_graph()
+
+    def populate_graph(self):
+        # 'v' is missing for every seventh node
+        self.graph.query("""UNWIND range(0, 9999) AS x
+                            CREATE (:N {
+                                k: x % 1000,
+                                s: 'g' + toString(x % 13),
+                                v: CASE WHEN x % 7 = 0 THEN NULL ELSE x / 3.0 END,
+                                i: x,
+                                name: toString(x % 101)})""")
+
+    def compare(self, func, attr, keys):
+        compact = f"MATCH (n:N) RETURN {keys} {func}(n.{attr}) AS agg ORDER BY agg"
+        tree = f"MATCH (n:N) RETURN {keys} coalesce({func}(n.{attr})) AS agg ORDER BY agg"
+
+        expected = self.graph.query(tree).result_set
+        actual = self.graph.query(compact).result_set
+
+        if func == "collect":
+            # collected values order is not guaranteed between groups
+            expected = sorted([sorted(map(str, row[-1])) for row in expected])
+            actual = sorted([sorted(map(str, row[-1])) for row in actual])
+        else:
+            expected = sorted(map(str, expected))
+            actual = sorted(map(str, actual))
+
+        self.env.assertEquals(actual, expected)
+
+    def test01_grouped(self):
+        for func in AGGREGATIONS:
+            for attr in ["v", "i", "name", "missing"]:
+                if func in ["sum", "avg"] and attr == "name":
+                    continue
+                self.compare(func, attr, "n.k,")
+                self.compare(func, attr, "n.s, n.k % 3,")
+
+    def test02_no_keys(self):
+        for func in AGGREGATIONS:
+            for attr in ["v", "i", "missing"]:
+                self.compare(func, attr, "")
+
+        # aggregation over no records produces default values
+        q = "MATCH (n:N) WHERE n.i < 0 RETURN count(n.i), sum(n.i), avg(n.i), min(n.i), max(n.i), collect(n.i)"
+        res = self.graph.query(q).result_set
+        self.env.assertEquals(res, [[0, 0, None, None, None, []]])
+
+    def test03_group_count(self):
+        # high cardinality grouping
+        q = "MATCH (n:N) RETURN n.i AS i, count(*) AS c"
+        res = self.graph.query(q).result_set
+        self.env.assertEquals(len(res), 10000)
+        self.env.assertTrue(all(row[1] == 1 for row in res))
+
+        q = "MATCH (n:N) WITH n.k AS k, count(*) AS c RETURN count(k), sum(c)"
+        res = self.graph.query(q).result_set
+        self.env.assertEquals(res, [[1000, 10000]])
+
+    def test04_type_mismatch(self):
+        # numeric aggregations reject non numeric values
+        for func in ["sum", "avg"]:
+            try:
+                self.graph.query(f"MATCH (n:N) RETURN n.k, {func}(n.name)")
+                self.env.assertTrue(False)
+            except ResponseError as e:
+                self.env.assertContains("Type mismatch", str(e))
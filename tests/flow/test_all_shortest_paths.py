@@ -1,4 +1,5 @@
 from common import *
+import random
 
 class testAllShortestPaths():
     def __init__(self):
@@ -318,3 +319,62 @@ class testAllShortestPaths():
 
         actual_result = self.cyclic_graph.query(query)
         self.env.assertEqual(actual_result.result_set, expected_result)
+
+    def test07_bidirectional_search(self):
+        # all shortest paths are searched from both ends
+        # compare against paths enumerated by a BFS over a random graph
+        g = Graph(self.env.getConnection(), "all_shortest_paths_bidirectional")
+
+        rng = random.Random(7)
+        n = 30
+        types = ['A', 'B', 'C']
+        edges = set()
+        while len(edges) < 110:
+            s = rng.randrange(n)
+            d = rng.randrange(n)
+            if s != d:
+                edges.add((s, d, rng.choice(types)))
+
+        # node 'n' is isolated
+        g.query(f"UNWIND range(0, {n}) AS v CREATE (:N {{v: v}})")
+        for t in types:
+            pairs = [[s, d] for (s, d, r) in edges if r == t]
+            g.query(f"""UNWIND $pairs AS pair
+                        MATCH (s:N {{v: pair[0]}}), (d:N {{v: pair[1]}})
+                        CREATE (s)-[:{t}]->(d)""", {'pairs': pairs})
+
+        # returns the sorted node sequences of all shortest paths
+        def bfs(src, dest, reltypes, max_hops):
+            paths = [[src]]
+            visited = {src}
+            while paths and (max_hops is None or len(paths[0]) <= max_hops):
+                extended = []
+                for path in paths:
+                    for (s, d, r) in edges:
+                        if s == path[-1] and r in reltypes and d not in visited:
+                            extended.append(path + [d])
+                reached = [p for p in extended if p[-1] == dest]
+                if reached:
+                    return sorted(reached)
+                visited.update(p[-1] for p in extended)
+                paths = extended
+            return []
+
+        pairs = [(rng.randrange(n), rng.randrange(n)) for _ in range(20)]
+        pairs += [(0, n), (n, 0)]  # no path
+        for (reltypes, max_hops) in [(types, None), (['A', 'B'], None),
+                                     (types, 2), (['B', 'C'], 3)]:
+            rels = ':' + '|:'.join(reltypes) if len(reltypes) < 3 else ''
+            hops = '' if max_hops is None else str(max_hops)
+            q = f"""MATCH (a:N {{v: $s}}), (b:N {{v: $d}})
+                    MATCH p = allShortestPaths((a)-[{rels}*..{hops}]->(b))
+                    RETURN [n IN nodes(p) | n.v] AS path
+                    ORDER BY path"""
+            for (s, d) in pairs:
+                if s == d:
+                    continue
+                res = g.query(q, {'s': s, 'd': d}).result_set
+                self.env.assertEquals([row[0] for row in res],
+                                      bfs(s, d, reltypes, max_hops))
+
+        g.delete()
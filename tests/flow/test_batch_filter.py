@@ -0,0 +1,75 @@
+from common import *
+
+GRAPH_ID = "batch_filter"
+
+# filters comparing attributes against constants are evaluated
+# a batch of records at a time, the results must match the
+# record by record evaluation of equivalent filters which can't be batched
+
+class testBatchFilter():
+    def __init__(self):
+        self.env = Env(decodeResponses=True)
+        self.conn = self.env.getConnection()
+        self.graph = Graph(self.conn, GRAPH_ID)
+        self.populate_graph()
+
+    def populate_graph(self):
+        # 'ts' holds integers, 'score' holds floats
+        # 'v' holds values of mixed types
+        self.graph.query("""UNWIND range(0, 999) AS x
+                            CREATE (:N {
+                                ts: x,
+                                score: x / 1000.0,
+                                flag: x % 2 = 0,
+                                v: CASE x % 5
+                                    WHEN 0 THEN x
+                                    WHEN 1 THEN x / 3.0
+                                    WHEN 2 THEN toString(x)
+                                    WHEN 3 THEN x % 3 = 0
+                                    ELSE NULL END})""")
+
+    def compare(self, batched, reference, params):
+        # aggregation consumes its input in batches
+        q = "MATCH (n:N) WHERE {} RETURN collect(n.ts)"
+        expected = self.graph.query(q.format(reference), params).result_set[0][0]
+        actual = self.graph.query(q.format(batched), params).result_set[0][0]
+        self.env.assertEquals(sorted(actual), sorted(expected))
+
+    def test01_range_filters(self):
+        params = {'a': 100, 'b': 900}
+        self.compare("n.ts > $a AND n.ts < $b AND n.score >= 0.5",
+                     "coalesce(n.ts) > $a AND coalesce(n.ts) < $b AND coalesce(n.score) >= 0.5",
+                     params)
+
+        self.compare("n.ts < $a OR n.score > 0.95 OR n.flag = true",
+                     "coalesce(n.ts) < $a OR coalesce(n.score) > 0.95 OR coalesce(n.flag) = true",
+                     params)
+
+        self.compare("$a >= n.ts AND n.flag <> false",
+                     "$a >= coalesce(n.ts) AND coalesce(n.flag) <> false",
+                     params)
+
+    def test02_mixed_types(self):
+        # values of disjoint types only pass inequality
+        # NULL values never pass
+        for op in ["=", "<>", "<", "<=", ">", ">="]:
+            for c in [10, 10.5, True]:
+                self.compare(f"n.v {op} $c", f"coalesce(n.v) {op} $c", {'c': c})
+
+    def test03_missing_attribute(self):
+        self.compare("n.missing > 1 OR n.ts = 7",
+                     "coalesce(n.missing) > 1 OR coalesce(n.ts) = 7", {})
+
+    def test04_error_mid_batch(self):
+        # an error raised while filtering a batch
+        # the rest of the batch must be released
+        q = "MATCH (n:N) WHERE 1 / (n.ts - 500) > 0 RETURN count(n)"
+        try:
+            self.graph.query(q)
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertContains("Division by zero", str(e))
+
+        # graph remains queryable
+        res = self.graph.query("MATCH (n:N) WHERE n.ts < 10 RETURN count(n)")
+        self.env.assertEquals(res.result_set[0][0], 10)
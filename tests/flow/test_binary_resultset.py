@@ -0,0 +1,212 @@
+import struct
+from common import *
+
+GRAPH_ID = "binary_resultset"
+
+# value types, see resultset_formatter.h
+VALUE_UNKNOWN = 0
+VALUE_NULL    = 1
+VALUE_STRING  = 2
+VALUE_INTEGER = 3
+VALUE_BOOLEAN = 4
+VALUE_DOUBLE  = 5
+VALUE_ARRAY   = 6
+VALUE_EDGE    = 7
+VALUE_NODE    = 8
+VALUE_PATH    = 9
+VALUE_MAP     = 10
+VALUE_POINT   = 11
+
+class BlockReader():
+    """decodes a binary resultset block, see resultset_replybinary.c"""
+
+    def __init__(self, blob):
+        self.blob = blob
+        self.pos = 0
+
+    def read(self, fmt):
+        v = struct.unpack_from('<' + fmt, self.blob, self.pos)
+        self.pos += struct.calcsize('<' + fmt)
+        return v[0]
+
+    def value(self):
+        return self.payload(self.read('B'))
+
+    def payload(self, t):
+        if t == VALUE_NULL:
+            return None
+        if t == VALUE_STRING:
+            return self.strings[self.read('I')]
+        if t == VALUE_INTEGER:
+            return self.read('q')
+        if t == VALUE_BOOLEAN:
+            return self.read('B') == 1
+        if t == VALUE_DOUBLE:
+            return self.read('d')
+        if t == VALUE_ARRAY:
+            return [self.value() for _ in range(self.read('I'))]
+        if t == VALUE_NODE:
+            return ('node', self.read('I'))
+        if t == VALUE_EDGE:
+            return ('edge', self.read('I'))
+        if t == VALUE_PATH:
+            nodes = [self.read('I') for _ in range(self.read('I'))]
+            edges = [self.read('I') for _ in range(self.read('I'))]
+            return ('path', nodes, edges)
+        if t == VALUE_MAP:
+            m = {}
+            for _ in range(self.read('I')):
+                k = self.strings[self.read('I')]
+                m[k] = self.value()
+            return m
+        if t == VALUE_POINT:
+            return (self.read('d'), self.read('d'))
+        raise Exception("unknown type %d" % t)
+
+    def properties(self):
+        props = {}
+        for _ in range(self.read('I')):
+            attr = self.read('I')
+            props[attr] = self.value()
+        return props
+
+    def decode(self):
+        nrows = self.read('I')
+        ncols = self.read('I')
+
+        self.strings = []
+        for _ in range(self.read('I')):
+            n = self.read('I')
+            self.strings.append(self.blob[self.pos:self.pos + n].decode())
+            self.pos += n
+
+        self.nodes = []
+        for _ in range(self.read('I')):
+            id = self.read('q')
+            labels = [self.read('I') for _ in range(self.read('I'))]
+            self.nodes.append((id, labels, self.properties()))
+
+        self.edges = []
+        for _ in range(self.read('I')):
+            id = self.read('q')
+            rel = self.read('I')
+            src = self.read('q')
+            dest = self.read('q')
+            self.edges.append((id, rel, src, dest, self.properties()))
+
+        columns = []
+        self.encodings = []
+        for _ in range(ncols):
+            t = self.read('B')
+            self.encodings.append(t)
+            if t == VALUE_NULL:
+                columns.append([None] * nrows)
+            elif t == VALUE_UNKNOWN:
+                columns.append([self.value() for _ in range(nrows)])
+            else:
+                bitmap = self.blob[self.pos:self.pos + (nrows + 7) // 8]
+                self.pos += (nrows + 7) // 8
+                col = []
+                for i in range(nrows):
+                    v = self.payload(t)
+                    col.append(None if bitmap[i // 8] & (1 << (i % 8)) else v)
+                columns.append(col)
+
+        self.env_check = self.pos == len(self.blob)
+        return [list(row) for row in zip(*columns)]
+
+
+class testBinaryResultSet():
+    def __init__(self):
+        self.env = Env(decodeResponses=False)
+        self.conn = self.env.getConnection()
+        self.graph = Graph(self.conn, GRAPH_ID)
+        self.graph.query("""UNWIND range(0, 9) AS x
+                            CREATE (:A {v: x, s: 's' + toString(x % 3)})-[:R {w: x}]->(:B)""")
+
+    def binary_query(self, q):
+        res = self.conn.execute_command("GRAPH.QUERY", GRAPH_ID, q, "--binary")
+        self.env.assertEquals(len(res), 3)
+        header = [col[1].decode() for col in res[0]]
+        rows = []
+        readers = []
+        for blob in res[1]:
+            r = BlockReader(blob)
+            rows += r.decode()
+            self.env.assertTrue(r.env_check)
+            readers.append(r)
+        return header, rows, readers
+
+    def test01_scalars(self):
+        q = """UNWIND range(0, 99) AS x
+               RETURN x, x / 2.0, x % 2 = 0, 's' + toString(x % 7),
+                      CASE WHEN x % 3 = 0 THEN NULL ELSE x END,
+                      CASE WHEN x % 2 = 0 THEN x ELSE 'odd' END,
+                      [x, 'a'], {k: x}, point({latitude: 1, longitude: 2}), NULL"""
+        header, rows, readers = self.binary_query(q)
+        self.env.assertEquals(len(header), 10)
+        self.env.assertEquals(len(rows), 100)
+
+        for x, row in enumerate(rows):
+            self.env.assertEquals(row[0], x)
+            self.env.assertEquals(row[1], x / 2.0)
+            self.env.assertEquals(row[2], x % 2 == 0)
+            self.env.assertEquals(row[3], 's' + str(x % 7))
+            self.env.assertEquals(row[4], None if x % 3 == 0 else x)
+            self.env.assertEquals(row[5], x if x % 2 == 0 else 'odd')
+            self.env.assertEquals(row[6], [x, 'a'])
+            self.env.assertEquals(row[7], {'k': x})
+            self.env.assertEquals(row[8], (1.0, 2.0))
+            self.env.assertEquals(row[9], None)
+
+        # typed column blocks
+        r = readers[0]
+        self.env.assertEquals(r.encodings[:5], [VALUE_INTEGER, VALUE_DOUBLE,
+            VALUE_BOOLEAN, VALUE_STRING, VALUE_INTEGER])
+        self.env.assertEquals(r.encodings[5:], [VALUE_UNKNOWN, VALUE_UNKNOWN,
+            VALUE_UNKNOWN, VALUE_UNKNOWN, VALUE_NULL])
+
+        # strings are encoded once per block
+        self.env.assertEquals(len(r.strings), len(set(r.strings)))
+
+    def test02_entities(self):
+        q = """MATCH p = (a:A)-[e:R]->(b:B), (c:A)
+               WHERE c.v < 3
+               RETURN a, e, p, c ORDER BY a.v, c.v"""
+        header, rows, readers = self.binary_query(q)
+        self.env.assertEquals(header, ['a', 'e', 'p', 'c'])
+        self.env.assertEquals(len(rows), 30)
+
+        # each entity is encoded once per block
+        nodes = []
+        edges = []
+        for r in readers:
+            self.env.assertEquals(len(r.nodes), len(set(n[0] for n in r.nodes)))
+            nodes += r.nodes
+            edges += r.edges
+
+        r = readers[0]
+        for row in rows[:3]:
+            a = r.nodes[row[0][1]]
+            e = r.edges[row[1][1]]
+            self.env.assertEquals(e[2], a[0])
+            self.env.assertEquals(row[2][0], 'path')
+            self.env.assertEquals(r.nodes[row[2][1][0]][0], a[0])
+            self.env.assertEquals(r.edges[row[2][2][0]][0], e[0])
+
+    def test03_streamed_blocks(self):
+        # every streamed window is replied as its own block
+        self.conn.execute_command("GRAPH.CONFIG", "SET", "RESULTSET_STREAM_WINDOW", 16)
+        header, rows, readers = self.binary_query("UNWIND range(1, 40) AS x RETURN x")
+        self.env.assertEquals(len(readers), 3)
+        self.env.assertEquals([row[0] for row in rows], list(range(1, 41)))
+
+        header, rows, readers = self.binary_query("MATCH (n:None) RETURN n")
+        self.env.assertEquals(rows, [])
+        self.env.assertEquals(len(readers), 0)
+
+        self.conn.execute_command("GRAPH.CONFIG", "SET", "RESULTSET_STREAM_WINDOW", 0)
+
+        # write queries reply once done
+        header, rows, readers = self.binary_query("CREATE (n:C {v: 1}) RETURN n.v")
+        self.env.assertEquals(rows, [[1]])
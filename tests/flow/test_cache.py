@@ -25,15 +25,17 @@ class testCache():
 
     def test_01_sanity_check(self):
         graph = Graph(redis_con, 'Cache_Sanity_Check')
+        # queries differing only by their literals share a cache entry
+        # vary the filtered attribute to produce distinct queries
         for i in range(CACHE_SIZE + 1):
-            result = graph.query("MATCH (n) WHERE n.value = {val} RETURN n".format(val=i))
+            result = graph.query("MATCH (n) WHERE n.value{val} = 1 RETURN n".format(val=i))
             self.env.assertFalse(result.cached_execution)
         
         for i in range(1, CACHE_SIZE + 1):
-            result = graph.query("MATCH (n) WHERE n.value = {val} RETURN n".format(val=i))
+            result = graph.query("MATCH (n) WHERE n.value{val} = 1 RETURN n".format(val=i))
             self.env.assertTrue(result.cached_execution)
         
-        result = graph.query("MATCH (n) WHERE n.value = 0 RETURN n")
+        result = graph.query("MATCH (n) WHERE n.value0 = 1 RETURN n")
         self.env.assertFalse(result.cached_execution)
 
         graph.delete()
@@ -287,3 +289,99 @@ class testCache():
 
         loop.run_until_complete(asyncio.wait(tasks))
 
+    def plan_cache_info(self, con):
+        # GRAPH.INFO PlanCache replies with a flat list of key value pairs
+        res = con.execute_command("GRAPH.INFO", "PlanCache")
+        self.env.assertEquals(res[0], "# Plan cache")
+        return dict(zip(res[1][::2], res[1][1::2]))
+
+    def test_15_literal_parameterization(self):
+        # queries differing only by their literals share a cache entry
+        con = self.env.getConnection()
+        graph = Graph(con, 'Cache_Literals')
+        graph.query("UNWIND range(1, 3) AS x CREATE (:N {v: x, s: 'v' + toString(x)})")
+
+        res = graph.query("MATCH (n:N) WHERE n.v = 1 RETURN n.s")
+        self.env.assertFalse(res.cached_execution)
+        self.env.assertEqual([['v1']], res.result_set)
+
+        res = graph.query("MATCH (n:N) WHERE n.v = 2 RETURN n.s")
+        self.env.assertTrue(res.cached_execution)
+        self.env.assertEqual([['v2']], res.result_set)
+
+        res = graph.query("MATCH (n:N {s: 'v3'}) RETURN n.v")
+        self.env.assertFalse(res.cached_execution)
+        self.env.assertEqual([[3]], res.result_set)
+
+        res = graph.query("MATCH (n:N {s: 'v1'}) RETURN n.v")
+        self.env.assertTrue(res.cached_execution)
+        self.env.assertEqual([[1]], res.result_set)
+
+        # projected literals are kept, result-set header is unaffected
+        res = graph.query("MATCH (n:N) WHERE n.v = 1 RETURN 'x', n.v + 1")
+        self.env.assertEqual(['\'x\'', 'n.v + 1'], [c[1] for c in res.header])
+        self.env.assertEqual([['x', 2]], res.result_set)
+
+        # literals mixed with user provided parameters
+        res = graph.query("MATCH (n:N) WHERE n.v > $min AND n.v < 3 RETURN n.v ORDER BY n.v",
+                          {'min': 1})
+        self.env.assertEqual([[2]], res.result_set)
+
+        res = graph.query("MATCH (n:N) WHERE n.v > $min AND n.v < 4 RETURN n.v ORDER BY n.v",
+                          {'min': 1})
+        self.env.assertTrue(res.cached_execution)
+        self.env.assertEqual([[2], [3]], res.result_set)
+
+        graph.delete()
+
+    def test_16_shared_cache(self):
+        # graphs with the same schema layout share execution plans
+        self.env.flush()
+        self.env.stop()
+
+        self.env = Env(decodeResponses=True,
+                       moduleArgs='CACHE_SIZE 16 SHARED_CACHE_SIZE 16')
+        con = self.env.getConnection()
+
+        graphs = [Graph(con, 'Cache_Shared_' + str(i)) for i in range(3)]
+        for i, g in enumerate(graphs):
+            g.query(f"CREATE (:A {{v: {i}}})-[:R]->(:B {{v: {i}}})")
+
+        q = "MATCH (a:A)-[:R]->(b:B) WHERE a.v = {v} RETURN b.v"
+
+        # first graph compiles the query
+        res = graphs[0].query(q.format(v=0))
+        self.env.assertFalse(res.cached_execution)
+        self.env.assertEqual([[0]], res.result_set)
+
+        before = self.plan_cache_info(con)
+
+        # other graphs reuse it
+        for i, g in enumerate(graphs[1:], 1):
+            res = g.query(q.format(v=i))
+            self.env.assertTrue(res.cached_execution)
+            self.env.assertEqual([[i]], res.result_set)
+
+        after = self.plan_cache_info(con)
+        self.env.assertEquals(after["Shared cache hits"] - before["Shared cache hits"], 2)
+        self.env.assertEquals(after["Graph cache misses"] - before["Graph cache misses"], 2)
+
+        # shared plan populated the graph's cache
+        res = graphs[1].query(q.format(v=1))
+        self.env.assertTrue(res.cached_execution)
+
+        info = self.plan_cache_info(con)
+        self.env.assertEquals(info["Graph cache hits"] - after["Graph cache hits"], 1)
+        self.env.assertEquals(info["Shared cache hits"], after["Shared cache hits"])
+
+        # a graph with a different schema layout can't reuse the plan
+        g = Graph(con, 'Cache_Shared_Other')
+        g.query("CREATE (:B)")
+        g.query("CREATE (:A {v: 0})-[:R]->(:B {v: 0})")
+        res = g.query(q.format(v=0))
+        self.env.assertFalse(res.cached_execution)
+        self.env.assertEqual([[0]], res.result_set)
+
+        info = self.plan_cache_info(con)
+        self.env.assertEquals(info["Shared cache hits"], after["Shared cache hits"])
+        self.env.assertEquals(info["Shared cache evictions"], 0)
@@ -0,0 +1,104 @@
+from common import *
+from pathos.pools import ProcessPool as Pool
+
+# number of concurrent connections
+CLIENT_COUNT = 16
+
+# number of writes issued by each client
+WRITES_PER_CLIENT = 50
+
+# tests write queries executed by a pool of writer threads
+# writes to different graphs run concurrently while writes to the same graph
+# are executed in order, possibly group committed
+
+def issue_writes(graph_id):
+    env = Env(decodeResponses=True)
+    conn = env.getConnection()
+    graph = Graph(conn, graph_id)
+
+    for i in range(WRITES_PER_CLIENT):
+        graph.query("CREATE (:N {v: $v})", {'v': i})
+
+        # a write reading the graph ends a group commit
+        # and executes with its own locks
+        if i % 5 == 0:
+            graph.query("MATCH (n:N) WHERE n.v = $v SET n.w = $v", {'v': i})
+
+        # a failing write is rolled back
+        # without affecting writes committed alongside it
+        if i % 10 == 0:
+            try:
+                graph.query("CREATE (:N {v: -1}) WITH 1 AS x RETURN x / 0")
+                return False
+            except ResponseError:
+                pass
+
+    return True
+
+def run_concurrent(graph_ids):
+    pool = Pool(nodes=CLIENT_COUNT)
+    results = pool.map(issue_writes, graph_ids)
+    pool.clear()
+    return results
+
+class testConcurrentWrites():
+    def __init__(self):
+        self.env = Env(decodeResponses=True,
+                       moduleArgs='WRITER_THREAD_COUNT 4 MAX_WRITE_BATCH 8')
+        # skip test if we're running under Valgrind
+        if VALGRIND:
+            self.env.skip() # valgrind is not working correctly with multi processing
+
+        self.conn = self.env.getConnection()
+
+    def node_count(self, graph_id):
+        g = Graph(self.conn, graph_id)
+        # failed writes are rolled back
+        res = g.query("MATCH (n:N) WHERE n.v = -1 RETURN count(n)").result_set
+        self.env.assertEquals(res[0][0], 0)
+
+        return g.query("MATCH (n:N) RETURN count(n)").result_set[0][0]
+
+    def test01_config(self):
+        conf = self.conn.execute_command("GRAPH.CONFIG", "GET", "WRITER_THREAD_COUNT")
+        self.env.assertEquals(conf[1], 4)
+
+        conf = self.conn.execute_command("GRAPH.CONFIG", "GET", "MAX_WRITE_BATCH")
+        self.env.assertEquals(conf[1], 8)
+
+        # the number of writer threads can't be modified at runtime
+        try:
+            self.conn.execute_command("GRAPH.CONFIG", "SET", "WRITER_THREAD_COUNT", 2)
+            self.env.assertTrue(False)
+        except ResponseError:
+            pass
+
+    def test02_disjoint_graphs(self):
+        # each client writes to its own graph
+        graph_ids = [f"tenant_{i}" for i in range(CLIENT_COUNT)]
+        results = run_concurrent(graph_ids)
+        self.env.assertTrue(all(results))
+
+        for graph_id in graph_ids:
+            self.env.assertEquals(self.node_count(graph_id), WRITES_PER_CLIENT)
+
+    def test03_single_graph(self):
+        # all clients write to the same graph, writes are group committed
+        graph_ids = ["hot"] * CLIENT_COUNT
+        results = run_concurrent(graph_ids)
+        self.env.assertTrue(all(results))
+
+        self.env.assertEquals(self.node_count("hot"),
+                              CLIENT_COUNT * WRITES_PER_CLIENT)
+
+        # every value was written once by each client
+        g = Graph(self.conn, "hot")
+        res = g.query("""MATCH (n:N)
+                         WITH n.v AS v, count(n) AS c
+                         RETURN min(c), max(c), count(v)""").result_set
+        self.env.assertEquals(res[0], [CLIENT_COUNT, CLIENT_COUNT, WRITES_PER_CLIENT])
+
+        # each client updated at least its own nodes
+        res = g.query("MATCH (n:N) WHERE n.w = n.v RETURN count(n)").result_set
+        self.env.assertGreaterEqual(res[0][0],
+                                    CLIENT_COUNT * WRITES_PER_CLIENT // 5)
@@ -3,7 +3,7 @@ from common import *
 redis_con = None
 redis_graph = None
 # Number of options available.
-NUMBER_OF_OPTIONS = 16
+NUMBER_OF_OPTIONS = 28
 
 class testConfig(FlowTestsBase):
     def __init__(self):
@@ -0,0 +1,73 @@
+import time
+from common import *
+
+GRAPH_ID = "cost_model"
+
+# number of nodes labeled 'Super'
+SUPER_COUNT = 100000
+
+# number of nodes labeled 'Small'
+SMALL_COUNT = 10
+
+# tests the optimizer picks traversal entry points according to estimated
+# cardinalities, derived from label counts and collected statistics
+
+class testCostModel():
+    def __init__(self):
+        self.env = Env(decodeResponses=True)
+        self.redis_con = self.env.getConnection()
+        self.graph = Graph(self.redis_con, GRAPH_ID)
+        self.populate_graph()
+
+    def populate_graph(self):
+        # a large label, each node connected to one of a few small nodes
+        self.graph.query(f"UNWIND range(0, {SMALL_COUNT} - 1) AS x CREATE (:Small {{v: x}})")
+        self.graph.query(f"""MATCH (t:Small)
+                             WITH collect(t) AS smalls
+                             UNWIND range(0, {SUPER_COUNT} - 1) AS x
+                             WITH smalls[x % {SMALL_COUNT}] AS t, x
+                             CREATE (:Super {{v: x, flag: x % 2 = 0}})-[:R]->(t)""")
+
+    def wait_for_plan(self, q, expected, timeout=10):
+        # statistics are refreshed in the background
+        # wait for the plan to reflect them
+        plan = None
+        start = time.time()
+        while time.time() - start < timeout:
+            plan = self.graph.execution_plan(q)
+            if expected in plan:
+                return plan
+            time.sleep(0.25)
+        return plan
+
+    def test01_smaller_label_entry_point(self):
+        # traversal should start at the smaller label
+        q = "MATCH (s:Super)-[:R]->(t:Small) RETURN count(s)"
+        plan = self.graph.execution_plan(q)
+        self.env.assertIn("Node By Label Scan | (t:Small)", plan)
+
+        q = "MATCH (t:Small)<-[:R]-(s:Super) RETURN count(s)"
+        plan = self.graph.execution_plan(q)
+        self.env.assertIn("Node By Label Scan | (t:Small)", plan)
+
+        res = self.graph.query(q).result_set
+        self.env.assertEquals(res[0][0], SUPER_COUNT)
+
+    def test02_filtered_entry_point(self):
+        # a selective filter on the large label makes it the entry point
+        q = "MATCH (s:Super)-[:R]->(t:Small) WHERE s.v = 7 RETURN t.v"
+        plan = self.wait_for_plan(q, "Node By Label Scan | (s:Super)")
+        self.env.assertIn("Node By Label Scan | (s:Super)", plan)
+
+        res = self.graph.query(q).result_set
+        self.env.assertEquals(res[0][0], 7 % SMALL_COUNT)
+
+    def test03_unselective_filter_entry_point(self):
+        # 'flag' has only two distinct values, once statistics are collected
+        # the filtered large label is no longer considered a good entry point
+        q = "MATCH (s:Super)-[:R]->(t:Small) WHERE s.flag = true RETURN count(s)"
+        plan = self.wait_for_plan(q, "Node By Label Scan | (t:Small)")
+        self.env.assertIn("Node By Label Scan | (t:Small)", plan)
+
+        res = self.graph.query(q).result_set
+        self.env.assertEquals(res[0][0], SUPER_COUNT // 2)
@@ -225,7 +225,9 @@ class test_encode_decode(FlowTestsBase):
         graph_name = "vkey_max_entity_count"
         redis_graph = Graph(redis_con, graph_name)
 
-        # Create 30 nodes
+        # Create 31 nodes
+        # each node also contributes an entry to the label matrix
+        # and to the node-labels matrix, 93 entities overall
         redis_graph.query("UNWIND range(0, 30) as v CREATE (:L {v: v})")
 
         # Save RDB & Load from RDB
@@ -242,14 +244,14 @@ class test_encode_decode(FlowTestsBase):
         log = logfile.read()
 
         matches = re.findall(
-            "Created (.) virtual keys for graph vkey_max_entity_count", log)
+            "Created (\d+) virtual keys for graph vkey_max_entity_count", log)
 
-        self.env.assertEqual(matches, ['3', '6'])
+        self.env.assertEqual(matches, ['9', '18'])
 
         matches = re.findall(
-            "Deleted (.) virtual keys for graph vkey_max_entity_count", log)
+            "Deleted (\d+) virtual keys for graph vkey_max_entity_count", log)
 
-        self.env.assertEqual(matches, ['3', '6'])
+        self.env.assertEqual(matches, ['9', '18'])
 
     def test10_decode_single_edge_relation_with_deleted_nodes(self):
         redis_con.flushall()
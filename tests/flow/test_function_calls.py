@@ -2750,3 +2750,34 @@ class testFunctionCallsFlow(FlowTestsBase):
         }
         for query, expected_result in query_to_expected_result.items():
             self.get_res_and_assertEquals(query, expected_result)
+
+    def test94_regex_operator(self):
+        # =~ matches the entire string
+        query_to_expected_result = {
+            "RETURN 'abc' =~ 'a.c'" : [[True]],
+            "RETURN 'abcd' =~ 'a.c'" : [[False]],
+            "RETURN 'xabc' =~ 'abc'" : [[False]],
+            "RETURN 'ab' =~ 'a|ab'" : [[True]],
+            "RETURN 'Abc' =~ '(?i)abc'" : [[True]],
+            "RETURN 'bl😉a' =~ 'bl.a'" : [[True]],
+            "RETURN null =~ 'a'" : [[None]],
+            "RETURN 'a' =~ null" : [[None]],
+            "UNWIND ['a1', 'b2', 'a3'] AS x WITH x WHERE x =~ 'a\\\\d' RETURN collect(x)" : [[['a1', 'a3']]],
+        }
+        for query, expected_result in query_to_expected_result.items():
+            self.get_res_and_assertEquals(query, expected_result)
+
+        # same pattern evaluated against many strings
+        query = "UNWIND range(1, 1000) AS x WITH toString(x) AS s WHERE s =~ '1[0-9]*0' RETURN count(s)"
+        self.get_res_and_assertEquals(query, [[12]])
+
+        # invalid regex
+        self.expect_error("RETURN 'aa' =~ '?'", "Invalid regex")
+        self.expect_error("WITH '(' AS r RETURN 'aa' =~ r", "Invalid regex")
+
+        # a pattern invalid on its own isn't accepted
+        self.expect_error("WITH 'a)(b' AS r RETURN 'ab' =~ r", "Invalid regex")
+
+        # both operands should be strings
+        self.expect_type_error("RETURN 2 =~ 'bla'")
+        self.expect_type_error("RETURN 'bla' =~ 2")
@@ -194,3 +194,37 @@ class testGraphCreationFlow(FlowTestsBase):
             result = redis_graph.query(query)
             expected_result = [[0]]
             self.env.assertEquals(result.result_set, expected_result)
+
+    def test11_bulk_create(self):
+        # entities created by a single query are committed in bulk
+        g = Graph(self.env.getConnection(), "bulk_create")
+        g.query("CREATE INDEX FOR (n:N) ON (n.v)")
+
+        # nodes, multi-edges and index entries created in one go
+        result = g.query("""UNWIND range(0, 999) AS x
+                            CREATE (a:N:M {v: x})-[:R {v: x}]->(b:N {v: x + 1000}),
+                                   (a)-[:R]->(b), (b)-[:S]->(a)""")
+        self.env.assertEquals(result.nodes_created, 2000)
+        self.env.assertEquals(result.relationships_created, 3000)
+
+        queries = [("MATCH (n:N) RETURN count(n)", 2000),
+                   ("MATCH (n:M) RETURN count(n)", 1000),
+                   ("MATCH (n:N) WHERE n.v >= 500 AND n.v < 1500 RETURN count(n)", 1000),
+                   ("MATCH (:M)-[e:R]->(:N) RETURN count(e)", 2000),
+                   ("MATCH (:N)<-[e:S]-(:N) RETURN count(e)", 1000),
+                   ("MATCH (a:M)-[:R]->(b) WHERE a.v = 7 RETURN count(DISTINCT b)", 1)]
+        for q, expected in queries:
+            self.env.assertEquals(g.query(q).result_set[0][0], expected)
+
+        # bulk creation on top of existing, partially deleted entries
+        g.query("MATCH (a:M)-[e:R]->() WHERE a.v % 2 = 0 DELETE e")
+        result = g.query("""MATCH (a:M)-[:S]-(b)
+                            CREATE (a)-[:R]->(b), (a)-[:R]->(b)""")
+        self.env.assertEquals(result.relationships_created, 2000)
+        self.env.assertEquals(g.query("MATCH (:M)-[e:R]->() RETURN count(e)").result_set[0][0], 3000)
+
+        # MERGE commits through the same path
+        result = g.query("UNWIND range(0, 99) AS x MERGE (:P {v: x})-[:T]->(:P {v: -x})")
+        self.env.assertEquals(result.nodes_created, 200)
+        self.env.assertEquals(result.relationships_created, 100)
+        self.env.assertEquals(g.query("MATCH (:P)-[e:T]->(:P) RETURN count(e)").result_set[0][0], 100)
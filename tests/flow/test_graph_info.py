@@ -433,3 +433,88 @@ class testGraphInfo(FlowTestsBase):
         # wait for all threads to complete
         for t in threads:
             t.join()
+
+    def test08_compaction(self):
+        """delete enough nodes to free an entire block
+           make sure compaction reclaims memory in the background"""
+
+        def compaction_info():
+            # GRAPH.INFO Compaction replies with a flat list of key value pairs
+            res = self.conn.execute_command("GRAPH.INFO", "Compaction")
+            self.env.assertEquals(res[0], "# Compaction")
+            return dict(zip(res[1][::2], res[1][1::2]))
+
+        g = Graph(self.conn, "compaction")
+        g.query("UNWIND range(0, 39999) AS x CREATE (:N {v: x, s: 'value' + toString(x)})")
+
+        # a node block holds 16384 nodes, delete the first block entirely
+        res = g.query("MATCH (n:N) WHERE n.v < 20000 DELETE n")
+        self.env.assertEquals(res.nodes_deleted, 20000)
+
+        # wait for compaction to run
+        info = compaction_info()
+        for _ in range(100):
+            if info["Reclaimed bytes"] > 0:
+                break
+            time.sleep(0.2)
+            info = compaction_info()
+
+        self.env.assertGreaterEqual(info["Compaction runs"], 1)
+        self.env.assertGreater(info["Reclaimed bytes"], 0)
+        self.env.assertGreater(info["Attribute sets repacked"], 0)
+
+        # compaction is transparent to queries
+        res = g.query("MATCH (n:N) RETURN count(n), min(n.v), max(n.v)")
+        self.env.assertEquals(res.result_set, [[20000, 20000, 39999]])
+
+        # deleted IDs are reused
+        g.query("UNWIND range(0, 99) AS x CREATE (:N {v: -1})")
+        res = g.query("MATCH (n:N) RETURN count(n)")
+        self.env.assertEquals(res.result_set[0][0], 20100)
+
+        g.delete()
+
+    def test09_compaction_config(self):
+        """compaction is disabled by setting its interval to 0
+           and resumed once the interval is set again"""
+
+        def compaction_runs():
+            res = self.conn.execute_command("GRAPH.INFO", "Compaction")
+            return dict(zip(res[1][::2], res[1][1::2]))["Compaction runs"]
+
+        # percentages are bounded
+        try:
+            self.conn.execute_command("GRAPH.CONFIG", "SET", "COMPACTION_DELETED_RATIO", 101)
+            self.env.assertTrue(False)
+        except redis.exceptions.ResponseError as e:
+            self.env.assertIn("COMPACTION_DELETED_RATIO", str(e))
+
+        self.conn.execute_command("GRAPH.CONFIG", "SET", "COMPACTION_INTERVAL", 0)
+
+        g = Graph(self.conn, "compaction_config")
+        g.query("UNWIND range(0, 19999) AS x CREATE (:N {v: x})")
+        g.query("MATCH (n:N) WHERE n.v < 10000 DELETE n")
+
+        # an already scheduled check might still be pending
+        time.sleep(6)
+        runs = compaction_runs()
+
+        time.sleep(1)
+        self.env.assertEquals(compaction_runs(), runs)
+
+        # resume compaction, deletions exceed the configured thresholds
+        self.conn.execute_command("GRAPH.CONFIG", "SET", "COMPACTION_MIN_DELETED", 5000)
+        self.conn.execute_command("GRAPH.CONFIG", "SET", "COMPACTION_INTERVAL", 100)
+
+        for _ in range(100):
+            if compaction_runs() > runs:
+                break
+            time.sleep(0.2)
+
+        self.env.assertGreater(compaction_runs(), runs)
+
+        # restore defaults
+        self.conn.execute_command("GRAPH.CONFIG", "SET", "COMPACTION_INTERVAL", 5000)
+        self.conn.execute_command("GRAPH.CONFIG", "SET", "COMPACTION_MIN_DELETED", 16384)
+
+        g.delete()
@@ -39,3 +39,39 @@ class testProfile(FlowTestsBase):
         self.env.assertIn("Update | Records produced: 0", profile)
         self.env.assertIn("Conditional Variable Length Traverse | (a)-[@anon_1*1..INF]->(@anon_0) | Records produced: 0", profile)
         self.env.assertIn("Node By Label Scan | (a:L) | Records produced: 0", profile)
+
+    def test03_profile_operation_counters(self):
+        redis_con.execute_command("GRAPH.QUERY", GRAPH_ID,
+                "UNWIND range(1, 10) AS x CREATE (:A {v:x})-[:R]->(:B {v:x})")
+
+        q = "MATCH (a:A)-[:R]->(b:B) RETURN a.v, b.v"
+        profile = redis_con.execute_command("GRAPH.PROFILE", GRAPH_ID, q)
+
+        for op in profile:
+            self.env.assertIn("Memory: ", op)
+            self.env.assertIn("GraphBLAS time: ", op)
+            self.env.assertIn("Matrix multiplications: ", op)
+            # hardware counters are disabled by default
+            self.env.assertNotIn("Cycles: ", op)
+
+        # the traversal consumes the scanned nodes and multiplies matrices
+        traverse = [op for op in profile if op.startswith("Conditional Traverse")][0]
+        self.env.assertIn("Records consumed: [10]", traverse)
+        self.env.assertNotIn("Matrix multiplications: 0", traverse)
+
+        # operations without children don't report consumed records
+        scan = [op for op in profile if op.startswith("Node By Label Scan")][0]
+        self.env.assertNotIn("Records consumed", scan)
+
+    def test04_profile_hw_counters(self):
+        redis_con.execute_command("GRAPH.CONFIG", "SET", "PROFILE_HW_COUNTERS", "yes")
+        try:
+            q = "MATCH (a:A) RETURN count(a)"
+            profile = redis_con.execute_command("GRAPH.PROFILE", GRAPH_ID, q)
+            profile = [x[0:x.index(',')].strip() for x in profile]
+
+            # counters are reported when available, profiling works either way
+            self.env.assertIn("Aggregate | Records produced: 1", profile)
+            self.env.assertIn("Node By Label Scan | (a:A) | Records produced: 10", profile)
+        finally:
+            redis_con.execute_command("GRAPH.CONFIG", "SET", "PROFILE_HW_COUNTERS", "no")
@@ -0,0 +1,86 @@
+from common import *
+
+GRAPH_ID = "parallelism"
+
+# number of nodes, spans multiple morsels
+NODE_COUNT = 100000
+
+# tests intra-query parallelism
+# a read query scanning a label may split the scan into morsels
+# processed by multiple reader threads, merged by an Exchange operation
+
+class testQueryParallelism():
+    def __init__(self):
+        self.env = Env(decodeResponses=True, moduleArgs="THREAD_COUNT 4")
+        self.redis_con = self.env.getConnection()
+        self.graph = Graph(self.redis_con, GRAPH_ID)
+        self.populate_graph()
+
+    def populate_graph(self):
+        q = f"""UNWIND range(0, {NODE_COUNT} - 1) AS x
+                CREATE (a:A {{v: x}})-[:R]->(:B {{v: x % 10}})"""
+        self.graph.query(q)
+
+    def set_dop(self, dop):
+        self.redis_con.execute_command("GRAPH.CONFIG", "SET",
+                                       "MAX_QUERY_PARALLELISM", dop)
+
+    def tearDown(self):
+        self.set_dop(1)
+
+    def test01_default_single_threaded(self):
+        # by default queries are executed by a single thread
+        conf = self.redis_con.execute_command("GRAPH.CONFIG", "GET",
+                                              "MAX_QUERY_PARALLELISM")
+        self.env.assertEquals(conf[1], 1)
+
+        plan = self.graph.execution_plan("MATCH (a:A) WHERE a.v > 10 RETURN count(a)")
+        self.env.assertNotIn("Exchange", plan)
+
+    def test02_exchange_placement(self):
+        self.set_dop(4)
+
+        # exchange is introduced above the parallel pipeline
+        plan = self.graph.execution_plan("MATCH (a:A) WHERE a.v > 10 RETURN count(a)")
+        self.env.assertIn("Exchange", plan)
+
+        # write queries are executed by a single thread
+        plan = self.graph.execution_plan("MATCH (a:A) WHERE a.v > 10 SET a.x = 1")
+        self.env.assertNotIn("Exchange", plan)
+
+        # limit breaks the pipeline
+        plan = self.graph.execution_plan("MATCH (a:A) RETURN a.v LIMIT 1")
+        self.env.assertNotIn("Exchange", plan)
+
+    def test03_parallel_results(self):
+        queries = [
+            "MATCH (a:A) WHERE a.v % 3 = 0 RETURN count(a)",
+            "MATCH (a:A)-[:R]->(b:B) WHERE b.v = 2 RETURN count(a), sum(a.v)",
+            "MATCH (a:A)-[:R]->(b:B) RETURN b.v, count(a) ORDER BY b.v",
+            "MATCH (a:A) WHERE a.v < 50000 RETURN a.v ORDER BY a.v DESC LIMIT 5",
+        ]
+
+        for q in queries:
+            self.set_dop(1)
+            expected = self.graph.query(q).result_set
+
+            self.set_dop(4)
+            actual = self.graph.query(q).result_set
+            self.env.assertEquals(actual, expected)
+
+        # un-ordered results
+        q = "MATCH (a:A) WHERE a.v % 1000 = 0 RETURN a.v"
+        self.set_dop(1)
+        expected = sorted(self.graph.query(q).result_set)
+        self.set_dop(4)
+        actual = sorted(self.graph.query(q).result_set)
+        self.env.assertEquals(actual, expected)
+
+    def test04_runtime_error(self):
+        # errors raised by helper threads are reported
+        self.set_dop(4)
+        try:
+            self.graph.query("MATCH (a:A) WHERE a.v / 0 > 1 RETURN count(a)")
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertIn("Division by zero", str(e))
@@ -0,0 +1,127 @@
+from common import *
+from index_utils import *
+
+GRAPH_ID = "range_index"
+
+# exact-match indexes are served by an in-memory range index
+# every query is executed twice, once against an indexed label (:A)
+# and once against an identical none indexed label (:B), results must match
+
+class testRangeIndex():
+    def __init__(self):
+        self.env = Env(decodeResponses=True)
+        self.conn = self.env.getConnection()
+        self.graph = Graph(self.conn, GRAPH_ID)
+        self.populate_graph()
+
+    def populate_graph(self):
+        # 'v' cycles through integers, doubles, booleans, strings and arrays
+        for lbl in ['A', 'B']:
+            self.graph.query(f"""UNWIND range(0, 999) AS x
+                                 CREATE (:{lbl} {{
+                                    i: x,
+                                    v: CASE x % 5
+                                        WHEN 0 THEN x % 100
+                                        WHEN 1 THEN (x % 100) / 2.0
+                                        WHEN 2 THEN x % 2 = 0
+                                        WHEN 3 THEN 's' + toString(x % 50)
+                                        ELSE [x] END,
+                                    loc: point({{latitude: x / 20.0, longitude: x / 30.0}})}})""")
+
+        create_node_exact_match_index(self.graph, 'A', 'i', 'v', 'loc', sync=True)
+
+    def compare(self, where, ret="n.i"):
+        indexed = f"MATCH (n:A) WHERE {where} RETURN {ret} ORDER BY n.i"
+        scanned = f"MATCH (n:B) WHERE {where} RETURN {ret} ORDER BY n.i"
+
+        plan = self.graph.execution_plan(indexed)
+        self.env.assertIn("Node By Index Scan", plan)
+
+        expected = self.graph.query(scanned).result_set
+        actual = self.graph.query(indexed).result_set
+        self.env.assertEquals(actual, expected)
+
+    def test01_ranges(self):
+        self.compare("n.i = 17")
+        self.compare("n.i > 990")
+        self.compare("n.i >= 10 AND n.i < 20")
+        self.compare("n.i > 10 AND n.i < 10")
+        self.compare("n.v < 10")
+        self.compare("n.v >= 2.5 AND n.v <= 7")
+        self.compare("n.v = 4.5")
+        self.compare("n.v = 4")
+
+    def test02_classes(self):
+        # booleans and numerics never compare equal
+        self.compare("n.v = true")
+        self.compare("n.v = 1")
+        self.compare("n.v < true")
+
+        # strings are ordered lexicographically
+        self.compare("n.v = 's7'")
+        self.compare("n.v > 's4' AND n.v <= 's7'")
+
+        # conflicting classes match nothing
+        self.compare("n.v = 1 AND n.v = 's1'")
+
+    def test03_in_and_or(self):
+        self.compare("n.v IN [1, 2.5, 's3', true]")
+        self.compare("n.v IN []")
+        self.compare("n.i < 5 OR n.i > 995")
+        self.compare("n.i = 5 OR n.v = 's3'")
+        self.compare("(n.i < 100 AND n.v = true) OR n.i = 500")
+        self.compare("n.i < 100 AND (n.v = 1 OR n.v = 's1')")
+
+    def test04_points(self):
+        self.compare("distance(n.loc, point({latitude: 10, longitude: 10})) < 100000")
+        self.compare("n.loc = point({latitude: 5, longitude: 3.3333333})")
+
+    def test05_updates(self):
+        for lbl in ['A', 'B']:
+            self.graph.query(f"MATCH (n:{lbl}) WHERE n.i % 3 = 0 SET n.v = n.i * 10")
+            self.graph.query(f"MATCH (n:{lbl}) WHERE n.i % 7 = 0 REMOVE n.v")
+            self.graph.query(f"MATCH (n:{lbl}) WHERE n.i % 11 = 0 DELETE n")
+            self.graph.query(f"UNWIND range(1000, 1100) AS x CREATE (:{lbl} {{i: x, v: x}})")
+
+        self.compare("n.v >= 100 AND n.v < 3000")
+        self.compare("n.i > 950")
+        self.compare("n.v = true")
+
+    def test06_runtime_values(self):
+        # index query is rebuilt for every input record
+        q = """UNWIND [1, 's2', true, 3.5] AS x
+               MATCH (n:{lbl}) WHERE n.v = x
+               RETURN x, n.i ORDER BY n.i"""
+        expected = self.graph.query(q.format(lbl='B')).result_set
+        actual = self.graph.query(q.format(lbl='A')).result_set
+        self.env.assertEquals(actual, expected)
+
+    def test07_index_info(self):
+        res = list_indicies(self.graph, 'A').result_set
+        info = res[0][6]
+        self.env.assertEquals(info['numDocuments'], self.graph.query("MATCH (n:A) RETURN count(n)").result_set[0][0])
+        self.env.assertGreater(info['numRecords'], 0)
+        self.env.assertGreater(info['memory'], 0)
+
+
+    def test08_string_prefixes(self):
+        # prefix filters are resolved by a range over the indexed strings
+        self.compare("n.v STARTS WITH 's1'")
+        self.compare("n.v STARTS WITH 's4' AND n.i < 500")
+        self.compare("n.v STARTS WITH 's1' OR n.v STARTS WITH 's2'")
+        self.compare("n.v STARTS WITH 'x'")
+
+        # a regex with a literal prefix scans the prefix range
+        # and verifies every candidate against the regex
+        self.compare("n.v =~ 's1.*'")
+        self.compare("n.v =~ 's[0-9]'")
+        self.compare("n.v =~ '^s4\\\\d'")
+        self.compare("n.v =~ 's12?'")
+
+        # no literal prefix, the regex is applied to every node
+        for where in ["n.v =~ '.*1'", "n.v =~ 's1|s2'", "n.v =~ '(?i)S1'"]:
+            plan = self.graph.execution_plan(f"MATCH (n:A) WHERE {where} RETURN n")
+            self.env.assertNotIn("Node By Index Scan", plan)
+            indexed = self.graph.query(f"MATCH (n:A) WHERE {where} RETURN n.i ORDER BY n.i").result_set
+            scanned = self.graph.query(f"MATCH (n:B) WHERE {where} RETURN n.i ORDER BY n.i").result_set
+            self.env.assertEquals(indexed, scanned)
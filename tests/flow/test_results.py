@@ -189,3 +189,34 @@ class testResultSetFlow(FlowTestsBase):
         query = """RETURN 'Foo\r\nBar'"""
         result = graph.query(query)
         self.env.assertEqual(result.result_set[0][0], 'Foo\r\nBar')
+
+    def test11_streamed_resultset(self):
+        # read queries serialize rows as they're produced
+        # once RESULTSET_STREAM_WINDOW rows accumulate
+        query = "UNWIND range(0, 2500) AS x RETURN x, 'v' + toString(x)"
+        expected = [[x, 'v' + str(x)] for x in range(0, 2501)]
+
+        for window in [1, 7, 1024, 5000, 0]:
+            redis_con.execute_command("GRAPH.CONFIG", "SET",
+                                      "RESULTSET_STREAM_WINDOW", window)
+
+            result = graph.query(query)
+            self.env.assertEqual(result.result_set, expected)
+
+            # entities are streamed as well
+            result = graph.query("MATCH (a:person) RETURN a.name, a ORDER BY a.val")
+            self.env.assertEqual([row[0] for row in result.result_set], people)
+
+            # empty resultset
+            result = graph.query("MATCH (a:none) RETURN a")
+            self.env.assertEqual(result.result_set, [])
+
+            # an error raised after rows were replied
+            try:
+                graph.query("UNWIND range(2, -2, -1) AS x RETURN 10 / x")
+                self.env.assertTrue(False)
+            except redis.exceptions.ResponseError as e:
+                self.env.assertContains("Division by zero", str(e))
+
+        redis_con.execute_command("GRAPH.CONFIG", "SET",
+                                  "RESULTSET_STREAM_WINDOW", 0)
@@ -1,4 +1,5 @@
 from common import *
+import random
 
 nodes        =  []
 GRAPH_ID     =  "shortest_path"
@@ -165,3 +166,68 @@ class testShortestPath(FlowTestsBase):
                 self.env.assertTrue(False)
             except redis.exceptions.ResponseError as e:
                 self.env.assertIn("A shortestPath requires bound nodes", str(e))
+
+    def test08_bidirectional_search(self):
+        # shortest paths are searched from both ends
+        # compare path lengths against a BFS over a random graph
+        g = Graph(self.env.getConnection(), "shortest_path_bidirectional")
+
+        rng = random.Random(42)
+        n = 40
+        types = ['A', 'B', 'C']
+        edges = set()
+        while len(edges) < 120:
+            s = rng.randrange(n)
+            d = rng.randrange(n)
+            if s != d:
+                edges.add((s, d, rng.choice(types)))
+
+        # node 'n' is isolated
+        g.query(f"UNWIND range(0, {n}) AS v CREATE (:N {{v: v}})")
+        for t in types:
+            pairs = [[s, d] for (s, d, r) in edges if r == t]
+            g.query(f"""UNWIND $pairs AS pair
+                        MATCH (s:N {{v: pair[0]}}), (d:N {{v: pair[1]}})
+                        CREATE (s)-[:{t}]->(d)""", {'pairs': pairs})
+
+        def bfs(src, dest, reltypes, max_hops):
+            frontier = [src]
+            visited = {src}
+            depth = 0
+            while frontier and (max_hops is None or depth < max_hops):
+                depth += 1
+                next_frontier = []
+                for (s, d, r) in edges:
+                    if s in frontier and r in reltypes and d not in visited:
+                        if d == dest:
+                            return depth
+                        visited.add(d)
+                        next_frontier.append(d)
+                frontier = next_frontier
+            return None
+
+        pairs = [(rng.randrange(n), rng.randrange(n)) for _ in range(25)]
+        pairs += [(0, n), (n, 0)]  # no path
+        for (reltypes, max_hops) in [(types, None), (['A', 'B'], None),
+                                     (['C'], None), (types, 2), (['A', 'C'], 3)]:
+            rels = ':' + '|:'.join(reltypes) if len(reltypes) < 3 else ''
+            hops = '' if max_hops is None else str(max_hops)
+            q = f"""MATCH (a:N {{v: $s}}), (b:N {{v: $d}})
+                    WITH shortestPath((a)-[{rels}*..{hops}]->(b)) AS p
+                    RETURN length(p), [n IN nodes(p) | n.v], [e IN relationships(p) | type(e)]"""
+            for (s, d) in pairs:
+                if s == d:
+                    continue
+                length, path, rels_types = g.query(q, {'s': s, 'd': d}).result_set[0]
+                self.env.assertEquals(length, bfs(s, d, reltypes, max_hops))
+                if length is None:
+                    continue
+
+                # path is made of existing edges of the requested types
+                self.env.assertEquals(path[0], s)
+                self.env.assertEquals(path[-1], d)
+                for i in range(length):
+                    self.env.assertIn(rels_types[i], reltypes)
+                    self.env.assertIn((path[i], path[i+1], rels_types[i]), edges)
+
+        g.delete()
@@ -0,0 +1,121 @@
+from common import *
+
+GRAPH_ID = "string_pool"
+
+# number of 'Person' nodes
+PERSON_COUNT = 1000
+
+COUNTRIES = ["Germany", "France", "Italy", "Spain"]
+
+# with INTERN_STRINGS enabled equal string attributes share their storage
+# interning is transparent to queries
+
+class testStringPool():
+    def __init__(self):
+        self.env = Env(decodeResponses=True, moduleArgs='INTERN_STRINGS yes')
+        self.conn = self.env.getConnection()
+        self.graph = Graph(self.conn, GRAPH_ID)
+        self.populate_graph()
+
+    def populate_graph(self):
+        countries = str(COUNTRIES)
+        self.graph.query(f"""UNWIND range(0, {PERSON_COUNT - 1}) AS x
+                             CREATE (p:Person {{
+                                id: x,
+                                country: {countries}[x % 4],
+                                name: 'p' + toString(x)}})
+                             CREATE (p)-[:LIVES {{since: 'year' + toString(x % 10)}}]->(:City)""")
+
+    def country_counts(self):
+        q = """MATCH (p:Person)
+               RETURN p.country, count(p)
+               ORDER BY p.country"""
+        return self.graph.query(q).result_set
+
+    def test01_config(self):
+        conf = self.conn.execute_command("GRAPH.CONFIG", "GET", "INTERN_STRINGS")
+        self.env.assertEquals(conf[1], 1)
+
+    def test02_group_and_filter(self):
+        expected = [[c, PERSON_COUNT // 4] for c in sorted(COUNTRIES)]
+        self.env.assertEquals(self.country_counts(), expected)
+
+        q = "MATCH (p:Person) WHERE p.country = 'Italy' RETURN count(p)"
+        self.env.assertEquals(self.graph.query(q).result_set[0][0], PERSON_COUNT // 4)
+
+        # compare interned values of distinct entities
+        q = """MATCH (a:Person {id: 0}), (b:Person)
+               WHERE a.country = b.country
+               RETURN count(b)"""
+        self.env.assertEquals(self.graph.query(q).result_set[0][0], PERSON_COUNT // 4)
+
+        q = "MATCH ()-[e:LIVES {since: 'year3'}]->() RETURN count(e)"
+        self.env.assertEquals(self.graph.query(q).result_set[0][0], PERSON_COUNT // 10)
+
+    def test03_update(self):
+        # move all Spanish persons to Portugal
+        q = "MATCH (p:Person {country: 'Spain'}) SET p.country = 'Portugal'"
+        res = self.graph.query(q)
+        self.env.assertEquals(res.properties_set, PERSON_COUNT // 4)
+
+        # replace attribute set, keeping interned values
+        q = "MATCH (p:Person {id: 1}) SET p = {id: 1, country: p.country, age: 30}"
+        self.graph.query(q)
+
+        q = "MATCH (p:Person {id: 1}) RETURN p.country, p.age, p.name"
+        self.env.assertEquals(self.graph.query(q).result_set, [["France", 30, None]])
+
+        countries = [c for c in COUNTRIES if c != "Spain"] + ["Portugal"]
+        expected = [[c, PERSON_COUNT // 4] for c in sorted(countries)]
+        self.env.assertEquals(self.country_counts(), expected)
+
+    def test04_rollback(self):
+        # a failed query restores interned values
+        q = """MATCH (p:Person {country: 'Germany'})
+               SET p.country = 'Austria'
+               WITH p
+               RETURN 1 / 0"""
+        try:
+            self.graph.query(q)
+            self.env.assertTrue(False)
+        except ResponseError:
+            pass
+
+        q = "MATCH (p:Person {country: 'Germany'}) RETURN count(p)"
+        self.env.assertEquals(self.graph.query(q).result_set[0][0], PERSON_COUNT // 4)
+
+    def test05_delete(self):
+        # remove all references to an interned string
+        self.graph.query("MATCH (p:Person {country: 'France'}) DETACH DELETE p")
+        self.graph.query("MATCH (p:Person {country: 'Italy'}) REMOVE p.country")
+
+        # re-introduce the same string
+        self.graph.query("CREATE (:Person {id: -1, country: 'France'})")
+
+        q = "MATCH (p:Person) WHERE p.country IN ['France', 'Italy'] RETURN p.id"
+        self.env.assertEquals(self.graph.query(q).result_set, [[-1]])
+
+    def test06_persistency(self):
+        before = self.country_counts()
+
+        # strings are interned as they're loaded
+        self.conn.execute_command("DEBUG", "RELOAD")
+
+        self.env.assertEquals(self.country_counts(), before)
+
+        # values remain shared after reload
+        self.graph.query("MATCH (p:Person {country: 'Portugal'}) SET p.country = 'Spain'")
+        q = "MATCH (p:Person) WHERE p.country = 'Spain' RETURN count(p)"
+        self.env.assertEquals(self.graph.query(q).result_set[0][0], PERSON_COUNT // 4)
+
+    def test07_disable(self):
+        # disabling interning keeps existing values intact
+        self.conn.execute_command("GRAPH.CONFIG", "SET", "INTERN_STRINGS", "no")
+
+        self.graph.query("CREATE (:Person {id: -2, country: 'Spain'})")
+        q = "MATCH (p:Person {country: 'Spain'}) RETURN count(p)"
+        self.env.assertEquals(self.graph.query(q).result_set[0][0], PERSON_COUNT // 4 + 1)
+
+        self.graph.query("MATCH (p:Person) SET p.country = 'Spain'")
+        q = "MATCH (p:Person) RETURN DISTINCT p.country"
+        self.env.assertEquals(self.graph.query(q).result_set, [["Spain"]])
@@ -0,0 +1,106 @@
+from common import *
+from index_utils import *
+
+GRAPH_ID = "trigram_index"
+
+# with TRIGRAM_INDEX enabled exact-match indexes maintain trigram postings
+# substring filters (CONTAINS, ENDS WITH, substring regexes) are resolved by
+# the index, every query is executed against an indexed label (:A)
+# and an identical none indexed label (:B), results must match
+
+SURNAMES = ["smith", "jones", "smithson", "o'brien"]
+
+class testTrigramIndex():
+    def __init__(self):
+        self.env = Env(decodeResponses=True, moduleArgs='TRIGRAM_INDEX yes')
+        self.conn = self.env.getConnection()
+        self.graph = Graph(self.conn, GRAPH_ID)
+        self.populate_graph()
+
+    def populate_graph(self):
+        surnames = str(SURNAMES)
+        for lbl in ['A', 'B']:
+            # every tenth node holds an integer instead of a name
+            self.graph.query(f"""UNWIND range(0, 999) AS x
+                                 CREATE (n:{lbl} {{i: x}})
+                                 SET n.name = CASE x % 10
+                                    WHEN 9 THEN x
+                                    ELSE 'user' + toString(x) + '-' + {surnames}[x % 4] END
+                                 CREATE (n)-[:{lbl} {{name: n.name}}]->(n)""")
+
+        create_node_exact_match_index(self.graph, 'A', 'name', sync=True)
+        create_edge_exact_match_index(self.graph, 'A', 'name', sync=True)
+
+    def compare(self, where, scan="Node By Index Scan"):
+        indexed = f"MATCH (n:A) WHERE {where} RETURN n.i ORDER BY n.i"
+        scanned = f"MATCH (n:B) WHERE {where} RETURN n.i ORDER BY n.i"
+
+        plan = self.graph.execution_plan(indexed)
+        self.env.assertIn(scan, plan)
+
+        expected = self.graph.query(scanned).result_set
+        actual = self.graph.query(indexed).result_set
+        self.env.assertEquals(actual, expected)
+
+    def test01_config(self):
+        conf = self.conn.execute_command("GRAPH.CONFIG", "GET", "TRIGRAM_INDEX")
+        self.env.assertEquals(conf[1], 1)
+
+    def test02_contains(self):
+        self.compare("n.name CONTAINS 'smith'")
+        self.compare("n.name CONTAINS 'user12'")
+        self.compare("n.name CONTAINS '7-jo'")
+        self.compare("n.name CONTAINS \"o'b\"")
+        self.compare("n.name CONTAINS 'xyz'")
+
+        # combined with other filters
+        self.compare("n.name CONTAINS 'smith' AND n.i < 100")
+        self.compare("n.name CONTAINS 'jones' OR n.name CONTAINS 'brien'")
+        self.compare("n.name CONTAINS 'smith' OR n.name = 'user1-jones'")
+
+        # substrings shorter than a trigram scan every indexed string
+        self.compare("n.name CONTAINS '-s'")
+
+    def test03_ends_with(self):
+        self.compare("n.name ENDS WITH 'smith'")
+        self.compare("n.name ENDS WITH 'son'")
+        self.compare("n.name ENDS WITH '12-smith'")
+        self.compare("n.name ENDS WITH 'user'")
+
+    def test04_regex(self):
+        # the regex's longest literal is looked up
+        # candidates are verified against the regex
+        self.compare("n.name =~ '.*smith'")
+        self.compare("n.name =~ '.*smith.*'")
+        self.compare("n.name =~ '.*[0-9]+-jones'")
+        self.compare("n.name =~ '.*1\\\\d-sm.*'")
+
+        # no required literal, the regex is applied to every node
+        for where in ["n.name =~ '.*(smith|jones)'", "n.name =~ '(?i).*SMITH'"]:
+            plan = self.graph.execution_plan(f"MATCH (n:A) WHERE {where} RETURN n")
+            self.env.assertNotIn("Node By Index Scan", plan)
+
+    def test05_edges(self):
+        for where in ["e.name CONTAINS 'smith'", "e.name ENDS WITH '3-jones'"]:
+            indexed = f"MATCH ()-[e:A]->() WHERE {where} RETURN e.name ORDER BY e.name"
+            scanned = f"MATCH ()-[e:B]->() WHERE {where} RETURN e.name ORDER BY e.name"
+
+            plan = self.graph.execution_plan(indexed)
+            self.env.assertIn("Edge By Index Scan", plan)
+
+            expected = self.graph.query(scanned).result_set
+            actual = self.graph.query(indexed).result_set
+            self.env.assertEquals(actual, expected)
+
+    def test06_updates(self):
+        # postings follow updates and deletions
+        for lbl in ['A', 'B']:
+            self.graph.query(f"""MATCH (n:{lbl}) WHERE n.i % 3 = 0
+                                 SET n.name = 'admin' + toString(n.i)""")
+            self.graph.query(f"MATCH (n:{lbl}) WHERE n.i % 7 = 0 DELETE n")
+            self.graph.query(f"MATCH (n:{lbl}) WHERE n.i % 11 = 0 SET n.name = NULL")
+
+        self.compare("n.name CONTAINS 'smith'")
+        self.compare("n.name CONTAINS 'admin'")
+        self.compare("n.name CONTAINS 'min12'")
+        self.compare("n.name ENDS WITH '99'")
@@ -344,3 +344,49 @@ class testVariableLengthTraversals(FlowTestsBase):
             self.env.assertEquals(l, 2)
             self.env.assertEquals(identity, i)
 
+
+    def test14_traverse_while_writing(self):
+        # variable length traversals executed by a write query
+        # after it modified the graph, must not leave behind stale adjacency
+        g = Graph(redis_con, "traverse_while_writing")
+        g.query("UNWIND range(0, 9) AS i CREATE (:A {v: i})-[:R]->(:B {v: i})")
+
+        q = "MATCH p = (:A)-[:R*]->() RETURN count(p)"
+        self.env.assertEquals(g.query(q).result_set[0][0], 10)
+
+        # create edges, traverse them, then delete them, all in one query
+        q = """MATCH (b:B)
+               CREATE (b)-[:R]->(:C)
+               WITH count(b) AS created
+               MATCH p = (:A)-[:R*]->()
+               WITH created, count(p) AS paths
+               MATCH ()-[e:R]->(:C)
+               DELETE e
+               RETURN created, paths, count(e)"""
+        res = g.query(q)
+        self.env.assertEquals(res.result_set[0], [10, 20, 10])
+        self.env.assertEquals(res.relationships_deleted, 10)
+
+        # traversals by later queries only observe the remaining edges
+        q = "MATCH p = (:A)-[:R*]->(x) RETURN count(p), count(DISTINCT labels(x)[0])"
+        self.env.assertEquals(g.query(q).result_set[0], [10, 1])
+
+        q = "MATCH p = (:C)<-[:R*]-() RETURN count(p)"
+        self.env.assertEquals(g.query(q).result_set[0][0], 0)
+
+        # interleave several modifications with traversals
+        q = """MATCH (a:A {v: 0})
+               CREATE (a)-[:R]->(c:C)
+               WITH c
+               MATCH p = (:A)-[:R*]->(c)
+               DELETE c
+               WITH count(p) AS paths
+               MATCH (b:B {v: 1})
+               CREATE (b)-[:R]->(:C)
+               RETURN paths"""
+        self.env.assertEquals(g.query(q).result_set[0][0], 1)
+
+        q = "MATCH p = (:A)-[:R*]->(:C) RETURN count(p)"
+        self.env.assertEquals(g.query(q).result_set[0][0], 1)
+
+        g.delete()
@@ -0,0 +1,238 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+// minimal micro-benchmark harness
+//
+// a benchmark suite is a single C file listing its benchmarks in BENCH_LIST
+// each benchmark receives a Bench and performs b->n operations:
+//
+//   void bench_foo(Bench *b) {
+//       Foo *f = Foo_New();  // setup is excluded from timing
+//       Bench_ResetTimer(b);
+//       for(uint64_t i = 0; i < b->n; i++) Foo_Op(f);
+//       Bench_StopTimer(b);
+//       Foo_Free(f);
+//   }
+//
+//   BENCH_LIST = {
+//       { "foo", bench_foo },
+//       { NULL, NULL }
+//   };
+//
+// the harness grows b->n until a single run lasts at least BENCH_TIME_MS
+// it then takes BENCH_REPEAT samples at that size and reports them as JSON
+//
+// optional hooks, defined before including this file:
+//   BENCH_INIT  statement executed once before the first benchmark
+//   BENCH_FINI  statement executed once after the last benchmark
+//
+// usage: bench_suite [--list] [name-substring]
+//
+// environment:
+//   BENCH_TIME_MS  minimal duration of a sample, default 200
+//   BENCH_REPEAT   number of samples, default 5
+
+#pragma once
+
+#include <time.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#define BENCH_DEFAULT_TIME_MS 200
+#define BENCH_DEFAULT_REPEAT  5
+#define BENCH_MAX_N           1000000000ULL
+#define BENCH_MAX_REPEAT      64
+
+typedef struct {
+	uint64_t n;          // number of operations to perform
+	uint64_t items;      // items processed by a single operation
+	uint64_t start;      // timer start, 0 when timer is stopped
+	uint64_t elapsed;    // accumulated time in nanoseconds
+} Bench;
+
+typedef struct {
+	const char *name;       // benchmark name
+	void (*func)(Bench *);  // benchmark routine
+} BenchEntry;
+
+extern const BenchEntry bench_list_[];
+
+#define BENCH_LIST const BenchEntry bench_list_[]
+
+static inline uint64_t Bench_Now(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// start timing, the timer is running when the benchmark is invoked
+static inline void Bench_StartTimer(Bench *b) {
+	if(b->start == 0) b->start = Bench_Now();
+}
+
+// stop timing, e.g. to exclude per-iteration setup
+static inline void Bench_StopTimer(Bench *b) {
+	if(b->start == 0) return;
+	b->elapsed += Bench_Now() - b->start;
+	b->start = 0;
+}
+
+// discard time measured so far and restart the timer
+static inline void Bench_ResetTimer(Bench *b) {
+	b->elapsed = 0;
+	b->start   = Bench_Now();
+}
+
+// report throughput as 'items' items per operation
+static inline void Bench_SetItems(Bench *b, uint64_t items) {
+	b->items = items;
+}
+
+// prevent the compiler from discarding a computed value
+#define Bench_DoNotOptimize(v) __asm__ volatile("" : : "g"(v) : "memory")
+
+//------------------------------------------------------------------------------
+// harness
+//------------------------------------------------------------------------------
+
+static uint64_t _bench_env
+(
+	const char *name,  // environment variable
+	uint64_t dflt      // default value
+) {
+	const char *v = getenv(name);
+	if(v == NULL || *v == '\0') return dflt;
+	uint64_t x = strtoull(v, NULL, 10);
+	return x > 0 ? x : dflt;
+}
+
+// run benchmark once with 'n' operations, returns elapsed nanoseconds
+static uint64_t _bench_run
+(
+	const BenchEntry *e,  // benchmark to run
+	uint64_t n,           // number of operations
+	uint64_t *items       // [output] items per operation
+) {
+	Bench b = {.n = n, .items = 0, .start = 0, .elapsed = 0};
+	Bench_StartTimer(&b);
+	e->func(&b);
+	Bench_StopTimer(&b);
+
+	*items = b.items;
+	return b.elapsed > 0 ? b.elapsed : 1;
+}
+
+static int _bench_cmp
+(
+	const void *a,
+	const void *b
+) {
+	double x = *(const double *)a;
+	double y = *(const double *)b;
+	return (x > y) - (x < y);
+}
+
+static void _bench_measure
+(
+	const BenchEntry *e,  // benchmark to measure
+	uint64_t time_ns,     // minimal sample duration
+	uint64_t repeat,      // number of samples
+	bool first            // first benchmark reported
+) {
+	uint64_t n     = 1;
+	uint64_t items = 0;
+	uint64_t t     = _bench_run(e, n, &items);
+
+	// grow n until a run lasts long enough, predicting the required n
+	// from the last run while growing at most 100x and at least 1.2x
+	while(t < time_ns && n < BENCH_MAX_N) {
+		double   per_op = (double)t / n;
+		uint64_t next   = (uint64_t)(time_ns * 1.2 / per_op);
+		if(next > n * 100) next = n * 100;
+		if(next < n + n / 5 + 1) next = n + n / 5 + 1;
+		if(next > BENCH_MAX_N) next = BENCH_MAX_N;
+		n = next;
+		t = _bench_run(e, n, &items);
+	}
+
+	double samples[BENCH_MAX_REPEAT];
+	double sum = 0;
+	for(uint64_t i = 0; i < repeat; i++) {
+		samples[i] = (double)_bench_run(e, n, &items) / n;
+		sum += samples[i];
+	}
+	qsort(samples, repeat, sizeof(double), _bench_cmp);
+
+	double mean   = sum / repeat;
+	double median = (repeat % 2) ? samples[repeat / 2] :
+		(samples[repeat / 2 - 1] + samples[repeat / 2]) / 2;
+
+	printf("%s\n    {\"name\": \"%s\", \"iterations\": %llu, "
+			"\"ns_per_op\": {\"min\": %.2f, \"median\": %.2f, \"mean\": %.2f}",
+			first ? "" : ",", e->name, (unsigned long long)n, samples[0],
+			median, mean);
+	if(items > 0) {
+		printf(", \"items_per_op\": %llu, \"items_per_sec\": %.0f",
+				(unsigned long long)items, items * 1e9 / median);
+	}
+	printf("}");
+	fflush(stdout);
+}
+
+// suite name, derived from the executable name
+static const char *_bench_suite
+(
+	const char *argv0
+) {
+	const char *name = strrchr(argv0, '/');
+	return name ? name + 1 : argv0;
+}
+
+int main(int argc, char **argv) {
+	const char *filter = NULL;
+
+	for(int i = 1; i < argc; i++) {
+		if(strcmp(argv[i], "--list") == 0) {
+			for(const BenchEntry *e = bench_list_; e->name != NULL; e++) {
+				printf("%s\n", e->name);
+			}
+			return 0;
+		}
+		filter = argv[i];
+	}
+
+	uint64_t time_ns = _bench_env("BENCH_TIME_MS", BENCH_DEFAULT_TIME_MS) *
+		1000000ULL;
+	uint64_t repeat = _bench_env("BENCH_REPEAT", BENCH_DEFAULT_REPEAT);
+	if(repeat > BENCH_MAX_REPEAT) repeat = BENCH_MAX_REPEAT;
+
+#ifdef BENCH_INIT
+	BENCH_INIT
+#endif
+
+	printf("{\n  \"suite\": \"%s\",\n  \"time_ms\": %llu,\n  \"repeat\": %llu,\n"
+			"  \"benchmarks\": [", _bench_suite(argv[0]),
+			(unsigned long long)(time_ns / 1000000ULL),
+			(unsigned long long)repeat);
+
+	bool first = true;
+	for(const BenchEntry *e = bench_list_; e->name != NULL; e++) {
+		if(filter != NULL && strstr(e->name, filter) == NULL) continue;
+		_bench_measure(e, time_ns, repeat, first);
+		first = false;
+	}
+
+	printf("\n  ]\n}\n");
+
+#ifdef BENCH_FINI
+	BENCH_FINI
+#endif
+
+	return 0;
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "src/value.h"
+#include "src/query_ctx.h"
+#include "src/util/rmalloc.h"
+#include "src/arithmetic/funcs.h"
+#include "src/execution_plan/record.h"
+#include "src/arithmetic/arithmetic_expression.h"
+#include "bench_graph.h"
+
+#define NODE_COUNT 1024
+
+static GraphContext *gc = NULL;
+
+static void setup() {
+	// use the malloc family for allocations
+	Alloc_Reset();
+
+	// initialize GraphBLAS
+	GrB_init(GrB_NONBLOCKING);
+	GxB_Global_Option_set(GxB_FORMAT, GxB_BY_ROW);
+	GxB_Global_Option_set(GxB_HYPER_SWITCH, GxB_NEVER_HYPER);
+
+	QueryCtx_Init();
+	AR_RegisterFuncs();
+
+	gc = BenchGraph_NewContext();
+	BenchGraph_Uniform(gc, NODE_COUNT, 0, BENCH_SEED);
+}
+
+#define BENCH_INIT setup();
+#include "bench.h"
+
+// record layout: x (integer), s (string), n (node)
+enum {X_IDX, S_IDX, N_IDX, IDX_COUNT};
+
+static rax *_mapping(void) {
+	rax *mapping = raxNew();
+	raxInsert(mapping, (unsigned char *)"x", 1, (void *)(intptr_t)X_IDX, NULL);
+	raxInsert(mapping, (unsigned char *)"s", 1, (void *)(intptr_t)S_IDX, NULL);
+	raxInsert(mapping, (unsigned char *)"n", 1, (void *)(intptr_t)N_IDX, NULL);
+	return mapping;
+}
+
+// binary operation node
+static AR_ExpNode *_op
+(
+	const char *f,
+	AR_ExpNode *l,
+	AR_ExpNode *r
+) {
+	AR_ExpNode *exp = AR_EXP_NewOpNode(f, true, 2);
+	exp->op.children[0] = l;
+	exp->op.children[1] = r;
+	return exp;
+}
+
+// evaluate 'exp' against NODE_COUNT records holding different values
+static void _evaluate
+(
+	Bench *b,
+	AR_ExpNode *exp  // expression to evaluate, freed
+) {
+	Bench_StopTimer(b);
+
+	Node n;
+	rax *mapping = _mapping();
+	Record records[NODE_COUNT];
+	char *strings[NODE_COUNT];
+
+	for(uint i = 0; i < NODE_COUNT; i++) {
+		int rc __attribute__((unused));
+		rc = asprintf(strings + i, "value%u", i);
+		Graph_GetNode(gc->g, i, &n);
+		records[i] = Record_New(mapping);
+		Record_AddScalar(records[i], X_IDX, SI_LongVal(i));
+		Record_AddScalar(records[i], S_IDX, SI_ConstStringVal(strings[i]));
+		Record_AddNode(records[i], N_IDX, n);
+	}
+
+	Bench_ResetTimer(b);
+
+	uint64_t sum = 0;
+	for(uint64_t i = 0; i < b->n; i++) {
+		SIValue v = AR_EXP_Evaluate(exp, records[i % NODE_COUNT]);
+		sum += SI_TYPE(v);
+		SIValue_Free(v);
+	}
+
+	Bench_StopTimer(b);
+	Bench_DoNotOptimize(sum);
+
+	for(uint i = 0; i < NODE_COUNT; i++) {
+		Record_Free(records[i]);
+		free(strings[i]);
+	}
+	raxFree(mapping);
+	AR_EXP_Free(exp);
+}
+
+// constant expression: 1 + 2
+void bench_constant(Bench *b) {
+	_evaluate(b, _op("add", AR_EXP_NewConstOperandNode(SI_LongVal(1)),
+				AR_EXP_NewConstOperandNode(SI_LongVal(2))));
+}
+
+// variable lookup: x
+void bench_variable(Bench *b) {
+	_evaluate(b, AR_EXP_NewVariableOperandNode("x"));
+}
+
+// arithmetic over a variable: x * 2 + 1 > 100
+void bench_arithmetic(Bench *b) {
+	AR_ExpNode *mul = _op("mul", AR_EXP_NewVariableOperandNode("x"),
+			AR_EXP_NewConstOperandNode(SI_LongVal(2)));
+	AR_ExpNode *add = _op("add", mul,
+			AR_EXP_NewConstOperandNode(SI_LongVal(1)));
+	_evaluate(b, _op("gt", add, AR_EXP_NewConstOperandNode(SI_LongVal(100))));
+}
+
+// string function: toUpper(s)
+void bench_string_function(Bench *b) {
+	AR_ExpNode *exp = AR_EXP_NewOpNode("toUpper", false, 1);
+	exp->op.children[0] = AR_EXP_NewVariableOperandNode("s");
+	_evaluate(b, exp);
+}
+
+// node attribute access: n.v
+void bench_property(Bench *b) {
+	_evaluate(b, AR_EXP_NewAttributeAccessNode(
+				AR_EXP_NewVariableOperandNode("n"), BENCH_ATTR_V));
+}
+
+// predicate over node attributes: n.v > 500 AND n.name = 'name7'
+void bench_property_predicate(Bench *b) {
+	AR_ExpNode *v = AR_EXP_NewAttributeAccessNode(
+			AR_EXP_NewVariableOperandNode("n"), BENCH_ATTR_V);
+	AR_ExpNode *name = AR_EXP_NewAttributeAccessNode(
+			AR_EXP_NewVariableOperandNode("n"), BENCH_ATTR_NAME);
+	AR_ExpNode *gt = _op("gt", v, AR_EXP_NewConstOperandNode(SI_LongVal(500)));
+	AR_ExpNode *eq = _op("eq", name,
+			AR_EXP_NewConstOperandNode(SI_ConstStringVal("name7")));
+	_evaluate(b, _op("and", gt, eq));
+}
+
+BENCH_LIST = {
+	{"constant",           bench_constant},
+	{"variable",           bench_variable},
+	{"arithmetic",         bench_arithmetic},
+	{"string_function",    bench_string_function},
+	{"property",           bench_property},
+	{"property_predicate", bench_property_predicate},
+	{NULL, NULL}
+};
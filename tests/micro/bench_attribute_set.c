@@ -0,0 +1,133 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "src/value.h"
+#include "src/util/rmalloc.h"
+#include "src/graph/entities/attribute_set.h"
+#include "bench_graph.h"
+
+#define BENCH_INIT Alloc_Reset();
+#include "bench.h"
+
+#define SET_COUNT 4096  // number of attribute sets looked up in turn
+
+// create SET_COUNT sets, each holding 'attr_count' integer attributes
+// attribute IDs are [0, attr_count) added in random order
+static AttributeSet *_populate
+(
+	uint16_t attr_count
+) {
+	uint64_t rng = BENCH_SEED;
+	Attribute_ID ids[attr_count];
+	AttributeSet *sets = rm_calloc(SET_COUNT, sizeof(AttributeSet));
+
+	for(uint i = 0; i < SET_COUNT; i++) {
+		for(uint16_t j = 0; j < attr_count; j++) ids[j] = j;
+
+		// shuffle attribute IDs
+		for(uint16_t j = attr_count - 1; j > 0; j--) {
+			uint16_t k = BenchRand_Below(&rng, j + 1);
+			Attribute_ID t = ids[j];
+			ids[j] = ids[k];
+			ids[k] = t;
+		}
+
+		for(uint16_t j = 0; j < attr_count; j++) {
+			AttributeSet_Add(sets + i, ids[j], SI_LongVal(j));
+		}
+	}
+
+	return sets;
+}
+
+static void _free
+(
+	AttributeSet *sets
+) {
+	for(uint i = 0; i < SET_COUNT; i++) AttributeSet_Free(sets + i);
+	rm_free(sets);
+}
+
+static void _get
+(
+	Bench *b,
+	uint16_t attr_count,  // number of attributes per set
+	bool hit              // look up existing attributes
+) {
+	Bench_StopTimer(b);
+	uint64_t rng = BENCH_SEED;
+	AttributeSet *sets = _populate(attr_count);
+	Bench_ResetTimer(b);
+
+	uint64_t found = 0;
+	for(uint64_t i = 0; i < b->n; i++) {
+		Attribute_ID id = BenchRand_Below(&rng, attr_count);
+		if(!hit) id += attr_count;
+		SIValue *v = AttributeSet_Get(sets[i % SET_COUNT], id);
+		found += (v != ATTRIBUTE_NOTFOUND);
+	}
+
+	Bench_StopTimer(b);
+	Bench_DoNotOptimize(found);
+	_free(sets);
+}
+
+void bench_get_4(Bench *b) {
+	_get(b, 4, true);
+}
+
+void bench_get_16(Bench *b) {
+	_get(b, 16, true);
+}
+
+void bench_get_64(Bench *b) {
+	_get(b, 64, true);
+}
+
+void bench_get_missing_16(Bench *b) {
+	_get(b, 16, false);
+}
+
+// build a set of 16 attributes one attribute at a time
+void bench_add_16(Bench *b) {
+	Bench_SetItems(b, 16);
+
+	for(uint64_t i = 0; i < b->n; i++) {
+		AttributeSet set = NULL;
+		for(Attribute_ID id = 0; id < 16; id++) {
+			AttributeSet_Add(&set, id, SI_LongVal(id));
+		}
+		Bench_StopTimer(b);
+		AttributeSet_Free(&set);
+		Bench_StartTimer(b);
+	}
+}
+
+// update an existing attribute in place
+void bench_update_16(Bench *b) {
+	Bench_StopTimer(b);
+	uint64_t rng = BENCH_SEED;
+	AttributeSet *sets = _populate(16);
+	Bench_ResetTimer(b);
+
+	for(uint64_t i = 0; i < b->n; i++) {
+		Attribute_ID id = BenchRand_Below(&rng, 16);
+		AttributeSet_Update(sets + (i % SET_COUNT), id, SI_LongVal(i));
+	}
+
+	Bench_StopTimer(b);
+	_free(sets);
+}
+
+BENCH_LIST = {
+	{"get_4",          bench_get_4},
+	{"get_16",         bench_get_16},
+	{"get_64",         bench_get_64},
+	{"get_missing_16", bench_get_missing_16},
+	{"add_16",         bench_add_16},
+	{"update_16",      bench_update_16},
+	{NULL, NULL}
+};
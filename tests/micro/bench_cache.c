@@ -0,0 +1,184 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "src/util/rmalloc.h"
+#include "src/util/cache/cache.h"
+#include "bench_graph.h"
+
+#include <pthread.h>
+
+#define BENCH_INIT Alloc_Reset();
+#include "bench.h"
+
+#define CACHE_SIZE 64    // number of cached entries
+#define KEY_COUNT  4096  // number of distinct keys
+#define MAX_READERS 32   // maximum number of concurrent reader threads
+
+// cached value, copied on every hit
+typedef struct {
+	int v;
+} CacheObj;
+
+static CacheObj *CacheObj_New(int v) {
+	CacheObj *obj = rm_malloc(sizeof(CacheObj));
+	obj->v = v;
+	return obj;
+}
+
+static CacheObj *CacheObj_Dup(const CacheObj *obj) {
+	return CacheObj_New(obj->v);
+}
+
+static void CacheObj_Free(CacheObj *obj) {
+	rm_free(obj);
+}
+
+// query like keys, differing only by their suffix
+static char **_keys(void) {
+	char **keys = rm_malloc(sizeof(char *) * KEY_COUNT);
+	for(uint i = 0; i < KEY_COUNT; i++) {
+		int rc __attribute__((unused));
+		rc = asprintf(keys + i,
+				"MATCH (n:N)-[:R]->(m:N) WHERE n.v > $v RETURN m.name LIMIT %u",
+				i);
+	}
+	return keys;
+}
+
+static void _free_keys(char **keys) {
+	for(uint i = 0; i < KEY_COUNT; i++) free(keys[i]);
+	rm_free(keys);
+}
+
+static Cache *_cache(void) {
+	return Cache_New(CACHE_SIZE, (CacheEntryFreeFunc)CacheObj_Free,
+			(CacheEntryCopyFunc)CacheObj_Dup);
+}
+
+// look up cached keys
+void bench_hit(Bench *b) {
+	Bench_StopTimer(b);
+	char **keys = _keys();
+	Cache *cache = _cache();
+	for(uint i = 0; i < CACHE_SIZE; i++) {
+		Cache_SetValue(cache, keys[i], CacheObj_New(i));
+	}
+	Bench_ResetTimer(b);
+
+	for(uint64_t i = 0; i < b->n; i++) {
+		CacheObj *obj = Cache_GetValue(cache, keys[i % CACHE_SIZE]);
+		CacheObj_Free(obj);
+	}
+
+	Bench_StopTimer(b);
+	Cache_Free(cache);
+	_free_keys(keys);
+}
+
+// look up missing keys
+void bench_miss(Bench *b) {
+	Bench_StopTimer(b);
+	char **keys = _keys();
+	Cache *cache = _cache();
+	for(uint i = 0; i < CACHE_SIZE; i++) {
+		Cache_SetValue(cache, keys[i], CacheObj_New(i));
+	}
+	Bench_ResetTimer(b);
+
+	uint64_t misses = 0;
+	for(uint64_t i = 0; i < b->n; i++) {
+		const char *key = keys[CACHE_SIZE + i % (KEY_COUNT - CACHE_SIZE)];
+		misses += (Cache_GetValue(cache, key) == NULL);
+	}
+
+	Bench_StopTimer(b);
+	Bench_DoNotOptimize(misses);
+	Cache_Free(cache);
+	_free_keys(keys);
+}
+
+// insert keys into a full cache, evicting an entry on every insertion
+void bench_set_evict(Bench *b) {
+	Bench_StopTimer(b);
+	char **keys = _keys();
+	Cache *cache = _cache();
+	Bench_ResetTimer(b);
+
+	for(uint64_t i = 0; i < b->n; i++) {
+		CacheObj *obj = CacheObj_New(i);
+		CacheObj *ret = Cache_SetGetValue(cache, keys[i % KEY_COUNT], obj);
+		CacheObj_Free(ret);
+	}
+
+	Bench_StopTimer(b);
+	Cache_Free(cache);
+	_free_keys(keys);
+}
+
+typedef struct {
+	Cache *cache;               // cache to read from
+	const char *key;            // key to look up
+	uint64_t n;                 // number of lookups to perform
+	pthread_barrier_t *barrier; // start all readers together
+} ReaderCtx;
+
+static void *_reader(void *arg) {
+	ReaderCtx *ctx = (ReaderCtx *)arg;
+	pthread_barrier_wait(ctx->barrier);
+
+	for(uint64_t i = 0; i < ctx->n; i++) {
+		CacheObj *obj = Cache_GetValue(ctx->cache, ctx->key);
+		CacheObj_Free(obj);
+	}
+
+	return NULL;
+}
+
+// 'n' threads look up the same key concurrently
+// each thread performs b->n lookups, reported time is per lookup of a thread
+static void _bench_concurrent_hit(Bench *b, int n) {
+	Bench_StopTimer(b);
+	char **keys = _keys();
+	Cache *cache = _cache();
+	Cache_SetValue(cache, keys[0], CacheObj_New(0));
+
+	pthread_t threads[MAX_READERS];
+	ReaderCtx ctxs[MAX_READERS];
+	pthread_barrier_t barrier;
+	pthread_barrier_init(&barrier, NULL, n + 1);
+
+	for(int i = 0; i < n; i++) {
+		ctxs[i] = (ReaderCtx){.cache = cache, .key = keys[0], .n = b->n,
+			.barrier = &barrier};
+		pthread_create(threads + i, NULL, _reader, ctxs + i);
+	}
+
+	Bench_ResetTimer(b);
+	pthread_barrier_wait(&barrier);
+	for(int i = 0; i < n; i++) pthread_join(threads[i], NULL);
+	Bench_StopTimer(b);
+
+	pthread_barrier_destroy(&barrier);
+	Cache_Free(cache);
+	_free_keys(keys);
+}
+
+void bench_hit_8_threads(Bench *b) {
+	_bench_concurrent_hit(b, 8);
+}
+
+void bench_hit_32_threads(Bench *b) {
+	_bench_concurrent_hit(b, 32);
+}
+
+BENCH_LIST = {
+	{"hit",            bench_hit},
+	{"miss",           bench_miss},
+	{"set_evict",      bench_set_evict},
+	{"hit_8_threads",  bench_hit_8_threads},
+	{"hit_32_threads", bench_hit_32_threads},
+	{NULL, NULL}
+};
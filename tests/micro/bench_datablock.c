@@ -0,0 +1,143 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "src/util/rmalloc.h"
+#include "src/util/datablock/datablock.h"
+#include "src/util/datablock/datablock_iterator.h"
+#include "bench_graph.h"
+
+#define BENCH_INIT Alloc_Reset();
+#include "bench.h"
+
+#define BLOCK_CAP   16384
+#define ITEM_COUNT  (1 << 20)   // number of items in pre-populated blocks
+
+// item layout similar to a graph entity's attribute set pointer
+typedef struct {
+	void *attributes;
+	uint64_t v;
+} Item;
+
+// datablock holding ITEM_COUNT items
+// every 'delete_every' item is deleted, 0 to keep all items
+static DataBlock *_populate
+(
+	uint64_t delete_every
+) {
+	DataBlock *db = DataBlock_New(BLOCK_CAP, ITEM_COUNT, sizeof(Item), NULL);
+	for(uint64_t i = 0; i < ITEM_COUNT; i++) {
+		Item *item = DataBlock_AllocateItem(db, NULL);
+		item->v = i;
+	}
+
+	if(delete_every > 0) {
+		for(uint64_t i = 0; i < ITEM_COUNT; i += delete_every) {
+			DataBlock_DeleteItem(db, i);
+		}
+	}
+
+	return db;
+}
+
+// allocate items at the end of the datablock
+void bench_allocate(Bench *b) {
+	DataBlock *db = DataBlock_New(BLOCK_CAP, BLOCK_CAP, sizeof(Item), NULL);
+
+	for(uint64_t i = 0; i < b->n; i++) {
+		// bound memory consumption, start over with an empty datablock
+		if(DataBlock_ItemCount(db) == ITEM_COUNT) {
+			Bench_StopTimer(b);
+			DataBlock_Free(db);
+			db = DataBlock_New(BLOCK_CAP, BLOCK_CAP, sizeof(Item), NULL);
+			Bench_StartTimer(b);
+		}
+		Item *item = DataBlock_AllocateItem(db, NULL);
+		item->v = i;
+	}
+
+	Bench_StopTimer(b);
+	DataBlock_Free(db);
+}
+
+// delete an item and allocate its replacement, reusing deleted slots
+void bench_delete_allocate(Bench *b) {
+	Bench_StopTimer(b);
+	uint64_t rng = BENCH_SEED;
+	DataBlock *db = _populate(0);
+	Bench_ResetTimer(b);
+
+	for(uint64_t i = 0; i < b->n; i++) {
+		uint64_t id;
+		DataBlock_DeleteItem(db, BenchRand_Below(&rng, ITEM_COUNT));
+		Item *item = DataBlock_AllocateItem(db, &id);
+		item->v = id;
+	}
+
+	Bench_StopTimer(b);
+	DataBlock_Free(db);
+}
+
+// random access by item ID
+void bench_get_item(Bench *b) {
+	Bench_StopTimer(b);
+	uint64_t sum = 0;
+	uint64_t rng = BENCH_SEED;
+	DataBlock *db = _populate(0);
+	Bench_ResetTimer(b);
+
+	for(uint64_t i = 0; i < b->n; i++) {
+		Item *item = DataBlock_GetItem(db, BenchRand_Below(&rng, ITEM_COUNT));
+		sum += item->v;
+	}
+
+	Bench_StopTimer(b);
+	Bench_DoNotOptimize(sum);
+	DataBlock_Free(db);
+}
+
+static void _scan
+(
+	Bench *b,
+	uint64_t delete_every
+) {
+	Bench_StopTimer(b);
+	DataBlock *db = _populate(delete_every);
+	Bench_SetItems(b, DataBlock_ItemCount(db));
+	Bench_ResetTimer(b);
+
+	uint64_t sum = 0;
+	for(uint64_t i = 0; i < b->n; i++) {
+		Item *item;
+		DataBlockIterator *it = DataBlock_Scan(db);
+		while((item = DataBlockIterator_Next(it, NULL)) != NULL) {
+			sum += item->v;
+		}
+		DataBlockIterator_Free(it);
+	}
+
+	Bench_StopTimer(b);
+	Bench_DoNotOptimize(sum);
+	DataBlock_Free(db);
+}
+
+// full scan over a dense datablock
+void bench_scan_dense(Bench *b) {
+	_scan(b, 0);
+}
+
+// full scan skipping 10% deleted items
+void bench_scan_sparse(Bench *b) {
+	_scan(b, 10);
+}
+
+BENCH_LIST = {
+	{"allocate",        bench_allocate},
+	{"delete_allocate", bench_delete_allocate},
+	{"get_item",        bench_get_item},
+	{"scan_dense",      bench_scan_dense},
+	{"scan_sparse",     bench_scan_sparse},
+	{NULL, NULL}
+};
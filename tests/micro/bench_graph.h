@@ -0,0 +1,205 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+// reproducible synthetic graphs for micro-benchmarks
+//
+// graphs are generated from a fixed seed so that consecutive runs,
+// and runs against different commits, operate on identical data
+//
+// every generated graph has a single node label BENCH_LABEL
+// and a single relationship type BENCH_RELATION
+// nodes carry two attributes:
+//   BENCH_ATTR_V     integer in [0, 1000)
+//   BENCH_ATTR_NAME  string "name<v>"
+
+#pragma once
+
+#include "src/util/arr.h"
+#include "src/query_ctx.h"
+#include "src/graph/graph.h"
+#include "src/util/rmalloc.h"
+#include "src/commands/execution_ctx.h"
+#include "src/aggregate_cache/aggregate_cache.h"
+#include "src/graph/graphcontext.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#define BENCH_SEED       0x5eed5eed5eedULL
+#define BENCH_LABEL      "N"
+#define BENCH_RELATION   "R"
+#define BENCH_ATTR_V     "v"
+#define BENCH_ATTR_NAME  "name"
+
+//------------------------------------------------------------------------------
+// random number generator
+//------------------------------------------------------------------------------
+
+// xorshift64*, state must be non zero
+static inline uint64_t BenchRand_Next(uint64_t *state) {
+	uint64_t x = *state;
+	x ^= x >> 12;
+	x ^= x << 25;
+	x ^= x >> 27;
+	*state = x;
+	return x * 0x2545F4914F6CDD1DULL;
+}
+
+// uniform integer in [0, n)
+static inline uint64_t BenchRand_Below(uint64_t *state, uint64_t n) {
+	return BenchRand_Next(state) % n;
+}
+
+// uniform double in [0, 1)
+static inline double BenchRand_Double(uint64_t *state) {
+	return (BenchRand_Next(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+//------------------------------------------------------------------------------
+// graph context
+//------------------------------------------------------------------------------
+
+// create an in-process graph context and set it in the query context
+// the graph context is not registered with redis
+static GraphContext *BenchGraph_NewContext(void) {
+	GraphContext *gc = rm_calloc(1, sizeof(GraphContext));
+
+	gc->g                = Graph_New(16384, 16384);
+	gc->ref_count        = 1;
+	gc->graph_name       = rm_strdup("bench");
+	gc->attributes       = raxNew();
+	gc->string_mapping   = array_new(char *, 64);
+	gc->node_schemas     = array_new(Schema *, GRAPH_DEFAULT_LABEL_CAP);
+	gc->relation_schemas = array_new(Schema *, GRAPH_DEFAULT_RELATION_TYPE_CAP);
+	gc->queries_log      = QueriesLog_New();
+	gc->pending_writes   = array_new(void *, 0);
+	gc->aggregates       = AggregateCache_New();
+	gc->cache            = Cache_New(64, (CacheEntryFreeFunc)ExecutionCtx_Free,
+			(CacheEntryCopyFunc)ExecutionCtx_Clone);
+
+	pthread_rwlock_init(&gc->_attribute_rwlock, NULL);
+	pthread_mutex_init(&gc->stats_lock, NULL);
+	pthread_mutex_init(&gc->writes_lock, NULL);
+
+	Graph_SetMatrixPolicy(gc->g, SYNC_POLICY_FLUSH_RESIZE);
+	QueryCtx_SetGraphCtx(gc);
+
+	return gc;
+}
+
+//------------------------------------------------------------------------------
+// generators
+//------------------------------------------------------------------------------
+
+typedef struct {
+	LabelID l;           // node label
+	RelationID r;        // relationship type
+	Attribute_ID v;      // integer attribute
+	Attribute_ID name;   // string attribute
+} BenchSchema;
+
+static BenchSchema _BenchGraph_Schema(GraphContext *gc) {
+	bool created;
+	BenchSchema s;
+
+	s.l    = Schema_GetID(GraphContext_AddSchema(gc, BENCH_LABEL, SCHEMA_NODE));
+	s.r    = Schema_GetID(GraphContext_AddSchema(gc, BENCH_RELATION,
+				SCHEMA_EDGE));
+	s.v    = GraphContext_FindOrAddAttribute(gc, BENCH_ATTR_V, &created);
+	s.name = GraphContext_FindOrAddAttribute(gc, BENCH_ATTR_NAME, &created);
+
+	return s;
+}
+
+static void _BenchGraph_CreateNodes
+(
+	GraphContext *gc,       // graph context
+	const BenchSchema *s,   // graph schema
+	uint64_t node_count,    // number of nodes to create
+	uint64_t *rng           // random number generator state
+) {
+	char name[32];
+	Graph *g = gc->g;
+	LabelID l = s->l;
+
+	Graph_AllocateNodes(g, node_count);
+	for(uint64_t i = 0; i < node_count; i++) {
+		Node n = GE_NEW_NODE();
+		Graph_CreateNode(g, &n, &l, 1);
+
+		int64_t v = BenchRand_Below(rng, 1000);
+		snprintf(name, sizeof(name), "name%" PRId64, v);
+		AttributeSet_Add(n.attributes, s->v, SI_LongVal(v));
+		AttributeSet_Add(n.attributes, s->name, SI_ConstStringVal(name));
+	}
+}
+
+// populate graph with 'node_count' nodes and 'edge_count' edges
+// edge endpoints are picked uniformly at random
+static void BenchGraph_Uniform
+(
+	GraphContext *gc,     // graph context to populate
+	uint64_t node_count,  // number of nodes
+	uint64_t edge_count,  // number of edges
+	uint64_t seed         // random seed
+) {
+	ASSERT(node_count > 0);
+
+	Edge e;
+	uint64_t rng = seed | 1;
+	BenchSchema s = _BenchGraph_Schema(gc);
+
+	_BenchGraph_CreateNodes(gc, &s, node_count, &rng);
+
+	Graph_AllocateEdges(gc->g, edge_count);
+	for(uint64_t i = 0; i < edge_count; i++) {
+		NodeID src  = BenchRand_Below(&rng, node_count);
+		NodeID dest = BenchRand_Below(&rng, node_count);
+		Graph_CreateEdge(gc->g, src, dest, s.r, &e);
+	}
+}
+
+// populate graph with 2^scale nodes and edge_factor * 2^scale edges
+// following the R-MAT recursive matrix model (a = 0.57, b = c = 0.19)
+// yielding a power-law degree distribution as in graph500
+static void BenchGraph_RMAT
+(
+	GraphContext *gc,      // graph context to populate
+	uint scale,            // log2 of the number of nodes
+	uint edge_factor,      // average out degree
+	uint64_t seed          // random seed
+) {
+	const double a = 0.57;
+	const double b = 0.19;
+	const double c = 0.19;
+
+	Edge e;
+	uint64_t rng        = seed | 1;
+	uint64_t node_count = 1ULL << scale;
+	uint64_t edge_count = node_count * edge_factor;
+	BenchSchema s       = _BenchGraph_Schema(gc);
+
+	_BenchGraph_CreateNodes(gc, &s, node_count, &rng);
+
+	Graph_AllocateEdges(gc->g, edge_count);
+	for(uint64_t i = 0; i < edge_count; i++) {
+		NodeID src  = 0;
+		NodeID dest = 0;
+		// descend into one of the adjacency matrix quadrants per bit
+		for(uint bit = 0; bit < scale; bit++) {
+			double p = BenchRand_Double(&rng);
+			if(p < a) continue;
+			if(p < a + b) dest |= 1ULL << bit;
+			else if(p < a + b + c) src |= 1ULL << bit;
+			else {
+				src  |= 1ULL << bit;
+				dest |= 1ULL << bit;
+			}
+		}
+		Graph_CreateEdge(gc->g, src, dest, s.r, &e);
+	}
+}
@@ -0,0 +1,191 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "src/query_ctx.h"
+#include "src/util/rmalloc.h"
+#include "src/arithmetic/funcs.h"
+#include "src/util/thpool/pools.h"
+#include "src/resultset/resultset.h"
+#include "src/procedures/procedure.h"
+#include "src/commands/execution_ctx.h"
+#include "src/execution_plan/execution_plan.h"
+#include "src/execution_plan/execution_plan_clone.h"
+#include "bench_graph.h"
+
+// canned queries are executed against an R-MAT graph
+// of 2^GRAPH_SCALE nodes and GRAPH_EDGE_FACTOR * 2^GRAPH_SCALE edges
+#define GRAPH_SCALE        14
+#define GRAPH_EDGE_FACTOR  8
+
+static GraphContext *gc = NULL;
+
+static void setup() {
+	// use the malloc family for allocations
+	Alloc_Reset();
+
+	ThreadPools_CreatePools(1, 1, 2);
+	QueryCtx_Init();
+
+	// initialize GraphBLAS
+	GrB_init(GrB_NONBLOCKING);
+	GxB_Global_Option_set(GxB_FORMAT, GxB_BY_ROW);
+	GxB_Global_Option_set(GxB_HYPER_SWITCH, GxB_NEVER_HYPER);
+
+	Proc_Register();     // register procedures
+	AR_RegisterFuncs();  // register arithmetic functions
+
+	gc = BenchGraph_NewContext();
+	BenchGraph_RMAT(gc, GRAPH_SCALE, GRAPH_EDGE_FACTOR, BENCH_SEED);
+
+	// apply pending matrix changes ahead of the first query
+	Graph_ApplyAllPending(gc->g, true);
+}
+
+static void tearDown() {
+	GraphContext_DecreaseRefCount(gc);
+	GrB_finalize();
+}
+
+#define BENCH_INIT setup();
+#define BENCH_FINI tearDown();
+#include "bench.h"
+
+// build query's AST and execution plan
+static ExecutionPlan *_build
+(
+	const char *query,  // query to build
+	AST **ast           // [output] query's AST
+) {
+	QueryCtx *ctx = QueryCtx_GetQueryCtx();
+	ctx->query_data.query_no_params = query;
+	cypher_parse_result_t *parse_result =
+		cypher_parse(query, NULL, NULL, CYPHER_PARSE_ONLY_STATEMENTS);
+	*ast = AST_Build(parse_result);
+	return ExecutionPlan_FromTLS_AST();
+}
+
+// execute a fresh copy of 'plan' as done on a plan cache hit
+// records are produced but not formatted
+static void _execute
+(
+	const ExecutionPlan *plan  // plan to execute
+) {
+	ExecutionPlan *clone = ExecutionPlan_Clone(plan);
+	ResultSet *set = NewResultSet(NULL, FORMATTER_NOP);
+	QueryCtx_SetResultSet(set);
+
+	Graph_AcquireReadLock(gc->g);
+	Graph_SetMatrixPolicy(gc->g, SYNC_POLICY_FLUSH_RESIZE);
+
+	ExecutionPlan_PreparePlan(clone);
+	ExecutionPlan_Execute(clone);
+	ExecutionPlan_Free(clone);
+
+	Graph_ReleaseLock(gc->g);
+
+	ResultSet_Free(set);
+}
+
+static void _run
+(
+	Bench *b,
+	const char *query  // query to run
+) {
+	Bench_StopTimer(b);
+	AST *ast;
+	ExecutionPlan *plan = _build(query, &ast);
+	Bench_ResetTimer(b);
+
+	for(uint64_t i = 0; i < b->n; i++) {
+		QueryCtx_SetAST(ast);
+		_execute(plan);
+	}
+
+	Bench_StopTimer(b);
+	ExecutionPlan_Free(plan);
+	AST_Free(ast);
+}
+
+//------------------------------------------------------------------------------
+// query execution
+//------------------------------------------------------------------------------
+
+void bench_label_scan_count(Bench *b) {
+	_run(b, "MATCH (n:N) RETURN count(n)");
+}
+
+void bench_label_scan_filter(Bench *b) {
+	_run(b, "MATCH (n:N) WHERE n.v > 500 RETURN n.name");
+}
+
+void bench_aggregate(Bench *b) {
+	_run(b, "MATCH (n:N) RETURN n.v % 10, count(n), avg(n.v)");
+}
+
+void bench_order_limit(Bench *b) {
+	_run(b, "MATCH (n:N) RETURN n.v ORDER BY n.v DESC LIMIT 10");
+}
+
+void bench_one_hop(Bench *b) {
+	_run(b, "MATCH (n:N)-[:R]->(m:N) WHERE n.v < 100 RETURN m.v");
+}
+
+void bench_two_hop_count(Bench *b) {
+	_run(b, "MATCH (n:N)-[:R]->()-[:R]->(m) WHERE n.v < 10 RETURN count(m)");
+}
+
+void bench_var_len(Bench *b) {
+	_run(b, "MATCH (n:N)-[:R*1..3]->(m) WHERE n.v = 3 RETURN count(m)");
+}
+
+void bench_unwind(Bench *b) {
+	_run(b, "UNWIND range(1, 10000) AS x RETURN sum(x * 2)");
+}
+
+//------------------------------------------------------------------------------
+// query compilation
+//------------------------------------------------------------------------------
+
+#define COMPILED_QUERY \
+	"MATCH (n:N)-[:R]->(m:N) WHERE n.v > 10 AND m.name STARTS WITH 'name1' " \
+	"WITH n, count(m) AS c ORDER BY c DESC LIMIT 10 RETURN n.name, c"
+
+// parse query, build its AST and execution plan
+void bench_plan_build(Bench *b) {
+	for(uint64_t i = 0; i < b->n; i++) {
+		AST *ast;
+		ExecutionPlan *plan = _build(COMPILED_QUERY, &ast);
+		ExecutionPlan_Free(plan);
+		AST_Free(ast);
+	}
+}
+
+// retrieve a cached execution plan
+void bench_plan_cache_hit(Bench *b) {
+	QueryCtx *ctx = QueryCtx_GetQueryCtx();
+
+	for(uint64_t i = 0; i < b->n; i++) {
+		ExecutionCtx *exec_ctx = ExecutionCtx_FromQuery(COMPILED_QUERY);
+		ExecutionCtx_Free(exec_ctx);
+
+		rm_free(ctx->query_data.query_normalized);
+		ctx->query_data.query_normalized = NULL;
+	}
+}
+
+BENCH_LIST = {
+	{"label_scan_count",  bench_label_scan_count},
+	{"label_scan_filter", bench_label_scan_filter},
+	{"aggregate",         bench_aggregate},
+	{"order_limit",       bench_order_limit},
+	{"one_hop",           bench_one_hop},
+	{"two_hop_count",     bench_two_hop_count},
+	{"var_len",           bench_var_len},
+	{"unwind",            bench_unwind},
+	{"plan_build",        bench_plan_build},
+	{"plan_cache_hit",    bench_plan_cache_hit},
+	{NULL, NULL}
+};
@@ -0,0 +1,131 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "src/value.h"
+#include "src/util/rmalloc.h"
+#include "src/execution_plan/record.h"
+#include "bench_graph.h"
+
+#define BENCH_INIT Alloc_Reset();
+#include "bench.h"
+
+// mapping of 'n' aliases
+static rax *_mapping
+(
+	uint n
+) {
+	char alias[16];
+	rax *mapping = raxNew();
+	for(uint i = 0; i < n; i++) {
+		int len = snprintf(alias, sizeof(alias), "e%u", i);
+		raxInsert(mapping, (unsigned char *)alias, len, (void *)(intptr_t)i,
+				NULL);
+	}
+	return mapping;
+}
+
+// record holding a mix of integers, strings and nodes
+static Record _populate
+(
+	rax *mapping
+) {
+	char str[32];
+	Record r = Record_New(mapping);
+	uint n = Record_length(r);
+
+	for(uint i = 0; i < n; i++) {
+		switch(i % 3) {
+			case 0:
+				Record_AddScalar(r, i, SI_LongVal(i));
+				break;
+			case 1:
+				snprintf(str, sizeof(str), "value%u", i);
+				Record_AddScalar(r, i, SI_DuplicateStringVal(str));
+				break;
+			default: {
+				Node node = GE_NEW_NODE();
+				node.id = i;
+				Record_AddNode(r, i, node);
+				break;
+			}
+		}
+	}
+
+	return r;
+}
+
+static void _clone
+(
+	Bench *b,
+	uint n,    // number of record entries
+	bool deep  // deep clone
+) {
+	Bench_StopTimer(b);
+	rax *mapping = _mapping(n);
+	Record r = _populate(mapping);
+	Record clone = Record_New(mapping);
+	Bench_ResetTimer(b);
+
+	for(uint64_t i = 0; i < b->n; i++) {
+		if(deep) Record_DeepClone(r, clone);
+		else Record_Clone(r, clone);
+		Record_FreeEntries(clone);
+	}
+
+	Bench_StopTimer(b);
+	Record_Free(clone);
+	Record_Free(r);
+	raxFree(mapping);
+}
+
+void bench_clone_4(Bench *b) {
+	_clone(b, 4, false);
+}
+
+void bench_clone_16(Bench *b) {
+	_clone(b, 16, false);
+}
+
+void bench_deep_clone_4(Bench *b) {
+	_clone(b, 4, true);
+}
+
+void bench_deep_clone_16(Bench *b) {
+	_clone(b, 16, true);
+}
+
+// merge a fully populated record into an empty one
+void bench_merge_16(Bench *b) {
+	Bench_StopTimer(b);
+	rax *mapping = _mapping(16);
+	Record r = _populate(mapping);
+	Record src = Record_New(mapping);
+	Record dest = Record_New(mapping);
+
+	// merging transfers ownership, merge from a shallow clone
+	Record_Clone(r, src);
+	Bench_ResetTimer(b);
+
+	for(uint64_t i = 0; i < b->n; i++) {
+		Record_Merge(dest, src);
+		Record_FreeEntries(dest);
+	}
+
+	Bench_StopTimer(b);
+	Record_Free(dest);
+	Record_Free(src);
+	Record_Free(r);
+	raxFree(mapping);
+}
+
+BENCH_LIST = {
+	{"clone_4",       bench_clone_4},
+	{"clone_16",      bench_clone_16},
+	{"deep_clone_4",  bench_deep_clone_4},
+	{"deep_clone_16", bench_deep_clone_16},
+	{"merge_16",      bench_merge_16},
+	{NULL, NULL}
+};
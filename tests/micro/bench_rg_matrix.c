@@ -0,0 +1,268 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "src/util/rmalloc.h"
+#include "src/graph/rg_matrix/rg_matrix.h"
+#include "src/graph/rg_matrix/rg_matrix_iter.h"
+#include "bench_graph.h"
+
+static void setup() {
+	// use the malloc family for allocations
+	Alloc_Reset();
+
+	// initialize GraphBLAS
+	GrB_init(GrB_NONBLOCKING);
+	GxB_Global_Option_set(GxB_FORMAT, GxB_BY_ROW);
+	GxB_Global_Option_set(GxB_HYPER_SWITCH, GxB_NEVER_HYPER);
+}
+
+#define BENCH_INIT setup();
+#define BENCH_FINI GrB_finalize();
+#include "bench.h"
+
+#define DIM       (1 << 16)   // matrix dimension
+#define NVALS     (1 << 20)   // number of entries in pre-populated matrices
+#define BATCH     (1 << 16)   // number of entries modified between flushes
+
+// matrix holding NVALS uniformly distributed entries, flushed
+static RG_Matrix _populate(void) {
+	RG_Matrix A;
+	uint64_t rng = BENCH_SEED;
+	RG_Matrix_new(&A, GrB_BOOL, DIM, DIM);
+
+	for(uint64_t i = 0; i < NVALS; i++) {
+		GrB_Index r = BenchRand_Below(&rng, DIM);
+		GrB_Index c = BenchRand_Below(&rng, DIM);
+		RG_Matrix_setElement_BOOL(A, r, c);
+	}
+	RG_Matrix_wait(A, true);
+
+	return A;
+}
+
+// set random entries, pending changes accumulate in delta-plus
+// the matrix is flushed once every BATCH entries, flushing is timed
+void bench_set_element(Bench *b) {
+	RG_Matrix A;
+	uint64_t rng = BENCH_SEED;
+	RG_Matrix_new(&A, GrB_BOOL, DIM, DIM);
+
+	for(uint64_t i = 0; i < b->n; i++) {
+		GrB_Index r = BenchRand_Below(&rng, DIM);
+		GrB_Index c = BenchRand_Below(&rng, DIM);
+		RG_Matrix_setElement_BOOL(A, r, c);
+		if((i + 1) % BATCH == 0) RG_Matrix_wait(A, true);
+	}
+	RG_Matrix_wait(A, true);
+
+	Bench_StopTimer(b);
+	RG_Matrix_free(&A);
+}
+
+// same as set_element using the bulk setter
+void bench_set_elements(Bench *b) {
+	Bench_StopTimer(b);
+
+	RG_Matrix A;
+	uint64_t rng = BENCH_SEED;
+	GrB_Index *I = rm_malloc(sizeof(GrB_Index) * BATCH);
+	GrB_Index *J = rm_malloc(sizeof(GrB_Index) * BATCH);
+	RG_Matrix_new(&A, GrB_BOOL, DIM, DIM);
+
+	Bench_ResetTimer(b);
+
+	uint64_t remaining = b->n;
+	while(remaining > 0) {
+		uint64_t n = remaining < BATCH ? remaining : BATCH;
+		for(uint64_t i = 0; i < n; i++) {
+			I[i] = BenchRand_Below(&rng, DIM);
+			J[i] = BenchRand_Below(&rng, DIM);
+		}
+		RG_Matrix_setElements_BOOL(A, I, J, n);
+		RG_Matrix_wait(A, true);
+		remaining -= n;
+	}
+
+	Bench_StopTimer(b);
+	rm_free(I);
+	rm_free(J);
+	RG_Matrix_free(&A);
+}
+
+// remove random entries from a flushed matrix and add them back
+// removals accumulate in delta-minus until the matrix is flushed
+void bench_remove_element(Bench *b) {
+	Bench_StopTimer(b);
+
+	RG_Matrix A = _populate();
+	GrB_Index *I = rm_malloc(sizeof(GrB_Index) * BATCH);
+	GrB_Index *J = rm_malloc(sizeof(GrB_Index) * BATCH);
+
+	// collect entries to remove
+	GrB_Index n = 0;
+	RG_MatrixTupleIter it = {0};
+	RG_MatrixTupleIter_attach(&it, A);
+	while(n < BATCH &&
+		  RG_MatrixTupleIter_next_BOOL(&it, I + n, J + n, NULL) == GrB_SUCCESS) {
+		n++;
+	}
+	RG_MatrixTupleIter_detach(&it);
+
+	Bench_ResetTimer(b);
+
+	for(uint64_t i = 0; i < b->n; i++) {
+		uint64_t k = i % n;
+		RG_Matrix_removeElement_BOOL(A, I[k], J[k]);
+
+		// restore removed entries, untimed
+		if(k == n - 1) {
+			RG_Matrix_wait(A, true);
+			Bench_StopTimer(b);
+			RG_Matrix_setElements_BOOL(A, I, J, n);
+			RG_Matrix_wait(A, true);
+			Bench_StartTimer(b);
+		}
+	}
+
+	Bench_StopTimer(b);
+	rm_free(I);
+	rm_free(J);
+	RG_Matrix_free(&A);
+}
+
+// flush BATCH pending additions into M
+void bench_wait(Bench *b) {
+	Bench_StopTimer(b);
+
+	uint64_t rng = BENCH_SEED;
+	RG_Matrix A = _populate();
+	Bench_SetItems(b, BATCH);
+
+	for(uint64_t i = 0; i < b->n; i++) {
+		for(uint64_t j = 0; j < BATCH; j++) {
+			GrB_Index r = BenchRand_Below(&rng, DIM);
+			GrB_Index c = BenchRand_Below(&rng, DIM);
+			RG_Matrix_setElement_BOOL(A, r, c);
+		}
+		Bench_StartTimer(b);
+		RG_Matrix_wait(A, true);
+		Bench_StopTimer(b);
+	}
+
+	RG_Matrix_free(&A);
+}
+
+static void _iterate
+(
+	Bench *b,
+	bool pending  // iterate over a matrix with pending changes
+) {
+	Bench_StopTimer(b);
+
+	uint64_t rng = BENCH_SEED;
+	RG_Matrix A = _populate();
+
+	// introduce pending additions and deletions
+	if(pending) {
+		for(uint64_t i = 0; i < BATCH; i++) {
+			GrB_Index r = BenchRand_Below(&rng, DIM);
+			GrB_Index c = BenchRand_Below(&rng, DIM);
+			RG_Matrix_setElement_BOOL(A, r, c);
+		}
+
+		// remove every 16th entry
+		GrB_Index r;
+		GrB_Index c;
+		GrB_Index *I = array_new(GrB_Index, 0);
+		GrB_Index *J = array_new(GrB_Index, 0);
+		RG_MatrixTupleIter it = {0};
+		RG_MatrixTupleIter_attach(&it, A);
+		for(uint64_t n = 0;
+			RG_MatrixTupleIter_next_BOOL(&it, &r, &c, NULL) == GrB_SUCCESS;
+			n++) {
+			if(n % 16 != 0) continue;
+			array_append(I, r);
+			array_append(J, c);
+		}
+		RG_MatrixTupleIter_detach(&it);
+
+		for(uint i = 0; i < array_len(I); i++) {
+			RG_Matrix_removeElement_BOOL(A, I[i], J[i]);
+		}
+		array_free(I);
+		array_free(J);
+	}
+
+	GrB_Index nvals;
+	RG_Matrix_nvals(&nvals, A);
+	Bench_SetItems(b, nvals);
+
+	Bench_ResetTimer(b);
+
+	uint64_t sum = 0;
+	RG_MatrixTupleIter it = {0};
+	RG_MatrixTupleIter_attach(&it, A);
+	for(uint64_t i = 0; i < b->n; i++) {
+		GrB_Index r;
+		GrB_Index c;
+		RG_MatrixTupleIter_reset(&it);
+		while(RG_MatrixTupleIter_next_BOOL(&it, &r, &c, NULL) == GrB_SUCCESS) {
+			sum += c;
+		}
+	}
+	RG_MatrixTupleIter_detach(&it);
+
+	Bench_StopTimer(b);
+	Bench_DoNotOptimize(sum);
+	RG_Matrix_free(&A);
+}
+
+// scan all entries of a flushed matrix
+void bench_iterate(Bench *b) {
+	_iterate(b, false);
+}
+
+// scan all entries of a matrix with pending additions and deletions
+void bench_iterate_pending(Bench *b) {
+	_iterate(b, true);
+}
+
+// scan random rows
+void bench_iterate_row(Bench *b) {
+	Bench_StopTimer(b);
+
+	uint64_t rng = BENCH_SEED;
+	RG_Matrix A = _populate();
+
+	Bench_ResetTimer(b);
+
+	uint64_t sum = 0;
+	RG_MatrixTupleIter it = {0};
+	RG_MatrixTupleIter_attach(&it, A);
+	for(uint64_t i = 0; i < b->n; i++) {
+		GrB_Index c;
+		RG_MatrixTupleIter_iterate_row(&it, BenchRand_Below(&rng, DIM));
+		while(RG_MatrixTupleIter_next_BOOL(&it, NULL, &c, NULL) == GrB_SUCCESS) {
+			sum += c;
+		}
+	}
+	RG_MatrixTupleIter_detach(&it);
+
+	Bench_StopTimer(b);
+	Bench_DoNotOptimize(sum);
+	RG_Matrix_free(&A);
+}
+
+BENCH_LIST = {
+	{"set_element",     bench_set_element},
+	{"set_elements",    bench_set_elements},
+	{"remove_element",  bench_remove_element},
+	{"wait",            bench_wait},
+	{"iterate",         bench_iterate},
+	{"iterate_pending", bench_iterate_pending},
+	{"iterate_row",     bench_iterate_row},
+	{NULL, NULL}
+};
@@ -0,0 +1,84 @@
+#!/bin/bash
+
+PROGNAME="${BASH_SOURCE[0]}"
+HERE="$(cd "$(dirname "$PROGNAME")" &>/dev/null && pwd)"
+ROOT=$(cd $HERE/../.. && pwd)
+READIES=$ROOT/deps/readies
+. $READIES/shibumi/defs
+
+cd $HERE
+
+#----------------------------------------------------------------------------------------------
+
+help() {
+	cat <<-'END'
+		Run micro-benchmarks
+
+		[ARGVARS...] benchmarks.sh [--help|help]
+
+		Argument variables:
+		BINROOT=path        Path to repo binary root dir
+		BENCH=name          Run a single benchmark suite, e.g. bench_datablock
+		FILTER=substr       Run benchmarks whose name contains substr
+		OUT=file            Write JSON results to file (default: stdout)
+
+		BENCH_TIME_MS=ms    Minimal duration of a sample (default: 200)
+		BENCH_REPEAT=n      Number of samples per benchmark (default: 5)
+
+		NOP=1               Dry run
+		HELP=1              Show help
+
+		Compare two result files with:
+		tests/micro/compare.py base.json head.json
+
+	END
+}
+
+#----------------------------------------------------------------------------------------------
+
+[[ $1 == --help || $1 == help || $HELP == 1 ]] && { help; exit 0; }
+
+OP=
+[[ $NOP == 1 ]] && OP=echo
+
+if [[ -z $BINROOT || ! -d $BINROOT ]]; then
+	eprint "BINROOT not defined or nonexistant"
+	exit 1
+fi
+
+BENCH_DIR="$(cd $BINROOT/src/tests/micro; pwd)"
+
+if [[ -n $BENCH ]]; then
+	BENCHES=$BENCH_DIR/$BENCH
+else
+	BENCHES=$(find $BENCH_DIR -name "bench_*" -type f -perm -u+x | sort)
+fi
+
+COMMIT=$(git -C $ROOT rev-parse --short HEAD 2>/dev/null)
+
+E=0
+RESULTS=$(mktemp)
+{
+	echo "{"
+	echo "\"commit\": \"$COMMIT\","
+	echo "\"suites\": ["
+	first=1
+	for bench in $BENCHES; do
+		[[ $first == 1 ]] || echo ","
+		first=0
+		>&2 echo "Running $bench ..."
+		{ $OP $bench $FILTER; (( E |= $? )); } || true
+	done
+	echo "]"
+	echo "}"
+} > $RESULTS
+
+if [[ -n $OUT ]]; then
+	mv $RESULTS $OUT
+	echo "Results written to $OUT"
+else
+	cat $RESULTS
+	rm -f $RESULTS
+fi
+
+exit $E
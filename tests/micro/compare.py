@@ -0,0 +1,63 @@
+#!/usr/bin/env python3
+
+# compare two micro-benchmark result files produced by benchmarks.sh
+# reports the median time per operation of every benchmark present in both
+# exits with status 1 if a benchmark slowed down by more than --threshold
+
+import sys
+import json
+import argparse
+
+
+def load(path):
+    with open(path) as f:
+        results = json.load(f)
+
+    # accept both a merged result file and a single suite's output
+    suites = results["suites"] if "suites" in results else [results]
+
+    medians = {}
+    for suite in suites:
+        for bench in suite["benchmarks"]:
+            key = "%s/%s" % (suite["suite"], bench["name"])
+            medians[key] = bench["ns_per_op"]["median"]
+    return medians
+
+
+def main():
+    parser = argparse.ArgumentParser(description="compare micro-benchmark results")
+    parser.add_argument("base", help="baseline results")
+    parser.add_argument("head", help="results to compare against baseline")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="regression threshold in percent (default: 10)")
+    args = parser.parse_args()
+
+    base = load(args.base)
+    head = load(args.head)
+
+    regressions = 0
+    width = max([len(k) for k in base] + [len("benchmark")])
+    print("%-*s %14s %14s %9s" % (width, "benchmark", "base ns/op", "head ns/op", "delta"))
+
+    for key in sorted(base):
+        if key not in head:
+            continue
+        b = base[key]
+        h = head[key]
+        delta = (h - b) / b * 100 if b > 0 else 0
+        mark = ""
+        if delta > args.threshold:
+            mark = "  regression"
+            regressions += 1
+        elif delta < -args.threshold:
+            mark = "  improvement"
+        print("%-*s %14.2f %14.2f %+8.1f%%%s" % (width, key, b, h, delta, mark))
+
+    for key in sorted(set(base) ^ set(head)):
+        print("%-*s only in %s" % (width, key, "base" if key in base else "head"))
+
+    return 1 if regressions > 0 else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,118 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "src/value.h"
+#include "src/util/arr.h"
+#include "src/util/rmalloc.h"
+#include "src/ast/ast_parameterize.h"
+
+void setup() {
+	Alloc_Reset();
+}
+
+#define TEST_INIT setup();
+#include "acutest.h"
+
+// parameterize 'query' and validate the outcome
+static void _validate
+(
+	const char *query,     // query to parameterize
+	const char *expected,  // expected query, NULL if unmodified
+	SIValue *values,       // expected literals
+	uint n                 // number of expected literals
+) {
+	SIValue *literals = NULL;
+	char *res = AST_ParameterizeLiterals(query, &literals);
+
+	if(expected == NULL) {
+		TEST_ASSERT(res == NULL);
+		return;
+	}
+
+	TEST_ASSERT(res != NULL);
+	TEST_ASSERT(strcmp(res, expected) == 0);
+	TEST_MSG("expected: %s, got: %s", expected, res);
+
+	TEST_ASSERT(array_len(literals) == n);
+	for(uint i = 0; i < n; i++) {
+		TEST_ASSERT(SIValue_Compare(literals[i], values[i], NULL) == 0);
+		SIValue_Free(literals[i]);
+	}
+
+	array_free(literals);
+	rm_free(res);
+}
+
+void test_parameterizeFilters() {
+	SIValue values[3] = {SI_LongVal(1), SI_ConstStringVal("a'b"),
+		SI_DoubleVal(2.5)};
+
+	_validate("MATCH (n:L) WHERE n.v = 1 RETURN n",
+			"MATCH (n:L) WHERE n.v = $__lit0 RETURN n", values, 1);
+
+	_validate("MATCH (n:L {v: 1, s: 'a\\'b'}) WHERE n.f > 2.5 RETURN n",
+			"MATCH (n:L {v: $__lit0, s: $__lit1}) WHERE n.f > $__lit2 RETURN n",
+			values, 3);
+}
+
+void test_parameterizeKeepProjections() {
+	SIValue values[2] = {SI_LongVal(1), SI_LongVal(2)};
+
+	// projected literals determine the result-set header
+	_validate("RETURN 1", NULL, NULL, 0);
+	_validate("RETURN [x IN [1, 2] WHERE x > 1]", NULL, NULL, 0);
+
+	_validate("UNWIND [1, 2] AS x WITH x, 3 AS y WHERE x > 2 RETURN x + 4",
+			"UNWIND [$__lit0, $__lit1] AS x WITH x, 3 AS y WHERE x > $__lit2 RETURN x + 4",
+			(SIValue[]){SI_LongVal(1), SI_LongVal(2), SI_LongVal(2)}, 3);
+
+	// ORDER BY, SKIP and LIMIT are kept as is
+	_validate("MATCH (n) WHERE n.v = 1 RETURN n ORDER BY n.v SKIP 2 LIMIT 3",
+			"MATCH (n) WHERE n.v = $__lit0 RETURN n ORDER BY n.v SKIP 2 LIMIT 3",
+			values, 1);
+
+	// sub-query projections
+	_validate("CALL { MATCH (n) WHERE n.v = 1 RETURN n } MATCH (m) WHERE m.v = 2 RETURN n, m, 3",
+			"CALL { MATCH (n) WHERE n.v = $__lit0 RETURN n } MATCH (m) WHERE m.v = $__lit1 RETURN n, m, 3",
+			values, 2);
+}
+
+void test_parameterizeKeepLiterals() {
+	SIValue values[1] = {SI_LongVal(1)};
+
+	// variable length bounds
+	_validate("MATCH (a)-[*1..3]->(b) WHERE a.v = 1 RETURN b",
+			"MATCH (a)-[*1..3]->(b) WHERE a.v = $__lit0 RETURN b", values, 1);
+
+	// procedure arguments
+	_validate("CALL db.idx.fulltext.queryNodes('L', 'x') YIELD node RETURN node",
+			NULL, NULL, 0);
+
+	// index DDL
+	_validate("CREATE INDEX FOR (n:L) ON (n.v)", NULL, NULL, 0);
+
+	// integer overflow is reported by the parser
+	_validate("MATCH (n) WHERE n.v = 99999999999999999999 RETURN n", NULL,
+			NULL, 0);
+
+	// unterminated string
+	_validate("MATCH (n) WHERE n.v = 'a RETURN n", NULL, NULL, 0);
+
+	// reserved parameter names
+	_validate("MATCH (n) WHERE n.v = $__lit0 AND n.x = 1 RETURN n", NULL,
+			NULL, 0);
+
+	// identifiers, property keys and comments
+	_validate("MATCH (n1) // 2\nWHERE n1.`v 3` = 1 RETURN n1",
+			"MATCH (n1) // 2\nWHERE n1.`v 3` = $__lit0 RETURN n1", values, 1);
+}
+
+TEST_LIST = {
+	{"parameterizeFilters", test_parameterizeFilters},
+	{"parameterizeKeepProjections", test_parameterizeKeepProjections},
+	{"parameterizeKeepLiterals", test_parameterizeKeepLiterals},
+	{NULL, NULL}
+};
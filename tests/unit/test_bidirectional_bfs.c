@@ -0,0 +1,208 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "src/util/arr.h"
+#include "src/util/rmalloc.h"
+#include "src/configuration/config.h"
+#include "src/algorithms/bidirectional_bfs.h"
+
+void setup();
+void tearDown();
+
+#define TEST_INIT setup();
+#define TEST_FINI tearDown();
+
+#include "acutest.h"
+
+void setup() {
+	// use the malloc family for allocations
+	Alloc_Reset();
+
+	// initialize GraphBLAS
+	GrB_init(GrB_NONBLOCKING);
+	GxB_Global_Option_set(GxB_FORMAT, GxB_BY_ROW);
+	GxB_Global_Option_set(GxB_HYPER_SWITCH, GxB_NEVER_HYPER);
+}
+
+void tearDown() {
+	GrB_finalize();
+}
+
+// connections:
+// 0 -> 1, 0 -> 2, 1 -> 3, 2 -> 3, 3 -> 4, 0 -> 5, 5 -> 6
+static Graph *BuildGraph(void) {
+	Edge e;
+	Node n;
+	Graph *g = Graph_New(8, 8);
+	RelationID r = Graph_AddRelationType(g);
+
+	for(int i = 0; i < 7; i++) {
+		n = GE_NEW_NODE();
+		Graph_CreateNode(g, &n, NULL, 0);
+	}
+
+	Graph_CreateEdge(g, 0, 1, r, &e);
+	Graph_CreateEdge(g, 0, 2, r, &e);
+	Graph_CreateEdge(g, 1, 3, r, &e);
+	Graph_CreateEdge(g, 2, 3, r, &e);
+	Graph_CreateEdge(g, 3, 4, r, &e);
+	Graph_CreateEdge(g, 0, 5, r, &e);
+	Graph_CreateEdge(g, 5, 6, r, &e);
+
+	return g;
+}
+
+static int64_t _Search
+(
+	Graph *g,
+	NodeID src,
+	NodeID dest,
+	uint64_t max_len,
+	NodeID **nodes,
+	Edge **edges
+) {
+	RelationID r = 0;
+	BidirectionalBFS *bfs = BidirectionalBFS_New(g, &r, 1,
+			GRAPH_EDGE_DIR_OUTGOING);
+
+	int64_t len = BidirectionalBFS_Run(bfs, src, dest, max_len);
+	if(edges != NULL) BidirectionalBFS_Path(bfs, edges);
+
+	if(nodes != NULL) {
+		*nodes = BidirectionalBFS_PathNodes(bfs);
+		// path nodes are at their distance from the source
+		for(uint i = 0; i < array_len(*nodes); i++) {
+			NodeID id = (*nodes)[i];
+			TEST_ASSERT(bfs->src_dist[id] >= 1);
+			TEST_ASSERT(bfs->src_dist[id] <= len + 1);
+		}
+	}
+
+	BidirectionalBFS_Free(bfs);
+
+	return len;
+}
+
+void test_shortestPath() {
+	Graph *g = BuildGraph();
+	Edge *edges = array_new(Edge, 0);
+
+	TEST_ASSERT(_Search(g, 0, 4, UINT64_MAX, NULL, &edges) == 3);
+	TEST_ASSERT(array_len(edges) == 3);
+
+	// edges are ordered from source to destination
+	NodeID expected = 0;
+	for(uint i = 0; i < array_len(edges); i++) {
+		TEST_ASSERT(edges[i].src_id == expected);
+		expected = edges[i].dest_id;
+	}
+	TEST_ASSERT(expected == 4);
+
+	array_free(edges);
+	Graph_Free(g);
+}
+
+void test_pathNodes() {
+	Graph *g = BuildGraph();
+	NodeID *nodes = NULL;
+
+	// both routes through 1 and 2 are shortest, 5 and 6 are not on any
+	TEST_ASSERT(_Search(g, 0, 4, UINT64_MAX, &nodes, NULL) == 3);
+	TEST_ASSERT(array_len(nodes) == 5);
+
+	bool on_path[7] = {0};
+	for(uint i = 0; i < array_len(nodes); i++) on_path[nodes[i]] = true;
+	TEST_ASSERT(on_path[0] && on_path[1] && on_path[2] && on_path[3] && on_path[4]);
+	TEST_ASSERT(!on_path[5] && !on_path[6]);
+
+	array_free(nodes);
+	Graph_Free(g);
+}
+
+void test_noPath() {
+	Graph *g = BuildGraph();
+
+	// edges are directed
+	TEST_ASSERT(_Search(g, 4, 0, UINT64_MAX, NULL, NULL) == -1);
+	// path exceeds maximum length
+	TEST_ASSERT(_Search(g, 0, 4, 2, NULL, NULL) == -1);
+	TEST_ASSERT(_Search(g, 0, 4, 3, NULL, NULL) == 3);
+	// a node is at distance 0 from itself
+	TEST_ASSERT(_Search(g, 6, 6, UINT64_MAX, NULL, NULL) == 0);
+
+	Graph_Free(g);
+}
+
+void test_reuse() {
+	Graph *g = BuildGraph();
+	RelationID r = 0;
+	BidirectionalBFS *bfs = BidirectionalBFS_New(g, &r, 1,
+			GRAPH_EDGE_DIR_OUTGOING);
+
+	// distances of a previous search don't leak into the next one
+	TEST_ASSERT(BidirectionalBFS_Run(bfs, 0, 4, UINT64_MAX) == 3);
+	TEST_ASSERT(BidirectionalBFS_Run(bfs, 4, 0, UINT64_MAX) == -1);
+	TEST_ASSERT(BidirectionalBFS_Run(bfs, 0, 6, UINT64_MAX) == 2);
+	TEST_ASSERT(BidirectionalBFS_Run(bfs, 1, 4, UINT64_MAX) == 2);
+
+	// the search picks up nodes and edges created since the last search
+	Edge e;
+	Node n = GE_NEW_NODE();
+	Graph_AcquireWriteLock(g);
+	Graph_CreateNode(g, &n, NULL, 0);
+	Graph_CreateEdge(g, 6, ENTITY_GET_ID(&n), r, &e);
+	Graph_ReleaseLock(g);
+	TEST_ASSERT(BidirectionalBFS_Run(bfs, 0, ENTITY_GET_ID(&n), UINT64_MAX) == 3);
+
+	// unknown relation types have no edges
+	RelationID unknown = GRAPH_UNKNOWN_RELATION;
+	BidirectionalBFS *none = BidirectionalBFS_New(g, &unknown, 1,
+			GRAPH_EDGE_DIR_OUTGOING);
+	TEST_ASSERT(BidirectionalBFS_Run(none, 0, 1, UINT64_MAX) == -1);
+	TEST_ASSERT(BidirectionalBFS_Run(none, 1, 1, UINT64_MAX) == 0);
+
+	BidirectionalBFS_Free(none);
+	BidirectionalBFS_Free(bfs);
+	Graph_Free(g);
+}
+
+void test_writeLocked() {
+	Graph *g = BuildGraph();
+	Edge *edges = array_new(Edge, 0);
+	RelationID r = GRAPH_NO_RELATION;
+	BidirectionalBFS *bfs = BidirectionalBFS_New(g, &r, 1,
+			GRAPH_EDGE_DIR_BOTH);
+
+	// while write locked edges are read from the relation matrices
+	Graph_AcquireWriteLock(g);
+	TEST_ASSERT(BidirectionalBFS_Run(bfs, 4, 0, UINT64_MAX) == 3);
+	BidirectionalBFS_Path(bfs, &edges);
+	TEST_ASSERT(bfs->ncsrs == 0);
+	TEST_ASSERT(array_len(edges) == 3);
+	TEST_ASSERT(edges[0].dest_id == 4);
+	TEST_ASSERT(edges[2].src_id == 0);
+	Graph_ReleaseLock(g);
+
+	// once released snapshots are used again
+	array_clear(edges);
+	TEST_ASSERT(BidirectionalBFS_Run(bfs, 4, 0, UINT64_MAX) == 3);
+	BidirectionalBFS_Path(bfs, &edges);
+	TEST_ASSERT(bfs->ncsrs == 2);
+	TEST_ASSERT(array_len(edges) == 3);
+
+	array_free(edges);
+	BidirectionalBFS_Free(bfs);
+	Graph_Free(g);
+}
+
+TEST_LIST = {
+	{"shortestPath", test_shortestPath},
+	{"pathNodes", test_pathNodes},
+	{"noPath", test_noPath},
+	{"reuse", test_reuse},
+	{"writeLocked", test_writeLocked},
+	{NULL, NULL}
+};
@@ -8,6 +8,8 @@
 #include "src/util/cache/cache.h"
 #include "src/execution_plan/execution_plan.h"
 
+#include <pthread.h>
+
 void setup() {
 	Alloc_Reset();
 }
@@ -99,8 +101,142 @@ void test_executionPlanCache() {
 	TEST_ASSERT(free_count == 9);
 }
 
+void test_cacheClear() {
+	free_count = 0;
+	Cache *cache = Cache_New(2, (CacheEntryFreeFunc)CacheObj_Free,
+			(CacheEntryCopyFunc)CacheObj_Dup);
+
+	const char *key1 = "MATCH (a) RETURN a";
+	const char *key2 = "MATCH (b) RETURN b";
+
+	Cache_SetValue(cache, key1, CacheObj_New("1"));
+	Cache_SetValue(cache, key2, CacheObj_New("2"));
+
+	// clearing the cache frees all stored items
+	Cache_Clear(cache);
+	TEST_ASSERT(free_count == 2);
+	TEST_ASSERT(Cache_GetValue(cache, key1) == NULL);
+	TEST_ASSERT(Cache_GetValue(cache, key2) == NULL);
+
+	// cache is usable after being cleared
+	CacheObj *item = CacheObj_New("1");
+	Cache_SetValue(cache, key1, item);
+	CacheObj *from_cache = (CacheObj*)Cache_GetValue(cache, key1);
+	TEST_ASSERT(CacheObj_EQ(item, from_cache));
+	CacheObj_Free(from_cache);
+
+	Cache_Free(cache);
+
+	// 2 cleared items, 1 copy and 1 stored item
+	TEST_ASSERT(free_count == 4);
+}
+
+void test_cacheStats() {
+	Cache *cache = Cache_New(1, (CacheEntryFreeFunc)CacheObj_Free,
+			(CacheEntryCopyFunc)CacheObj_Dup);
+
+	CacheStats stats;
+	Cache_GetStats(cache, &stats);
+	TEST_ASSERT(stats.hits == 0);
+	TEST_ASSERT(stats.misses == 0);
+	TEST_ASSERT(stats.evictions == 0);
+
+	const char *key1 = "MATCH (a) RETURN a";
+	const char *key2 = "MATCH (b) RETURN b";
+
+	// miss
+	TEST_ASSERT(Cache_GetValue(cache, key1) == NULL);
+
+	// hit
+	CacheObj *item = CacheObj_New("1");
+	TEST_ASSERT(Cache_SetValue(cache, key1, item));
+	CacheObj_Free(Cache_GetValue(cache, key1));
+
+	// key already cached, caller retains ownership
+	CacheObj *dup = CacheObj_New("1");
+	TEST_ASSERT(!Cache_SetValue(cache, key1, dup));
+	CacheObj_Free(dup);
+
+	// eviction
+	TEST_ASSERT(Cache_SetValue(cache, key2, CacheObj_New("2")));
+
+	Cache_GetStats(cache, &stats);
+	TEST_ASSERT(stats.hits == 1);
+	TEST_ASSERT(stats.misses == 1);
+	TEST_ASSERT(stats.evictions == 1);
+
+	Cache_Free(cache);
+}
+
+typedef struct {
+	Cache *cache;     // cache to read from
+	const char *key;  // cached key to look up
+	int misses;       // number of lookups which missed
+} ReaderCtx;
+
+static void *_reader(void *arg) {
+	ReaderCtx *ctx = (ReaderCtx *)arg;
+
+	for(int i = 0; i < 1000; i++) {
+		CacheObj *obj = Cache_GetValue(ctx->cache, ctx->key);
+		if(obj == NULL) {
+			ctx->misses++;
+			continue;
+		}
+		rm_free(obj);
+	}
+
+	return NULL;
+}
+
+void test_cacheConcurrentReaders() {
+	Cache *cache = Cache_New(64, (CacheEntryFreeFunc)CacheObj_Free,
+			(CacheEntryCopyFunc)CacheObj_Dup);
+
+	const char *key = "MATCH (a) RETURN a";
+	TEST_ASSERT(Cache_SetValue(cache, key, CacheObj_New("1")));
+
+	// readers look up a cached key while other keys are being inserted
+	int n = 8;
+	pthread_t threads[n];
+	ReaderCtx ctxs[n];
+	for(int i = 0; i < n; i++) {
+		ctxs[i] = (ReaderCtx){.cache = cache, .key = key, .misses = 0};
+		pthread_create(threads + i, NULL, _reader, ctxs + i);
+	}
+
+	char *keys[32];
+	for(int i = 0; i < 32; i++) {
+		int rc = asprintf(keys + i, "MATCH (a) RETURN a LIMIT %d", i);
+		UNUSED(rc);
+		TEST_ASSERT(Cache_SetValue(cache, keys[i], CacheObj_New(keys[i])));
+		// key is already cached, caller retains ownership over value
+		CacheObj *obj = CacheObj_New(keys[i]);
+		TEST_ASSERT(Cache_SetGetValue(cache, keys[i], obj) == obj);
+		rm_free(obj);
+	}
+
+	for(int i = 0; i < n; i++) {
+		pthread_join(threads[i], NULL);
+		TEST_ASSERT(ctxs[i].misses == 0);
+	}
+
+	// every reader's hits are accounted for
+	CacheStats stats;
+	Cache_GetStats(cache, &stats);
+	TEST_ASSERT(stats.hits == 1000 * n);
+	TEST_ASSERT(stats.misses == 0);
+	TEST_ASSERT(stats.evictions == 0);
+
+	Cache_Free(cache);
+	for(int i = 0; i < 32; i++) free(keys[i]);
+}
+
 TEST_LIST = {
 	{"executionPlanCache", test_executionPlanCache},
+	{"cacheClear", test_cacheClear},
+	{"cacheStats", test_cacheStats},
+	{"cacheConcurrentReaders", test_cacheConcurrentReaders},
 	{NULL, NULL}
 };
 
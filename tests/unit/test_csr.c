@@ -0,0 +1,173 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "src/util/arr.h"
+#include "src/util/rmalloc.h"
+#include "src/graph/graph.h"
+#include "src/graph/csr/csr.h"
+#include "src/configuration/config.h"
+
+void setup();
+void tearDown();
+
+#define TEST_INIT setup();
+#define TEST_FINI tearDown();
+
+#include "acutest.h"
+
+void setup() {
+	// use the malloc family for allocations
+	Alloc_Reset();
+
+	// initialize GraphBLAS
+	GrB_init(GrB_NONBLOCKING);
+	GxB_Global_Option_set(GxB_FORMAT, GxB_BY_ROW);
+	GxB_Global_Option_set(GxB_HYPER_SWITCH, GxB_NEVER_HYPER);
+}
+
+void tearDown() {
+	GrB_finalize();
+}
+
+// connections:
+// R: 0 -> 1, 0 -> 1, 0 -> 2, 2 -> 0
+// S: 0 -> 3, 3 -> 3
+static Graph *BuildGraph(void) {
+	Edge e;
+	Node n;
+	Graph *g = Graph_New(4, 8);
+	RelationID R = Graph_AddRelationType(g);
+	RelationID S = Graph_AddRelationType(g);
+
+	for(int i = 0; i < 4; i++) {
+		n = GE_NEW_NODE();
+		Graph_CreateNode(g, &n, NULL, 0);
+	}
+
+	Graph_CreateEdge(g, 0, 1, R, &e);
+	Graph_CreateEdge(g, 0, 1, R, &e);
+	Graph_CreateEdge(g, 0, 2, R, &e);
+	Graph_CreateEdge(g, 2, 0, R, &e);
+	Graph_CreateEdge(g, 0, 3, S, &e);
+	Graph_CreateEdge(g, 3, 3, S, &e);
+
+	return g;
+}
+
+// number of edges of node 'id' in CSR
+static uint64_t _Degree(const CSR *csr, NodeID id) {
+	uint64_t begin;
+	uint64_t end;
+	CSR_Row(csr, id, &begin, &end);
+	return end - begin;
+}
+
+void test_outgoing() {
+	Graph *g = BuildGraph();
+	CSR *csr = Graph_GetCSR(g, 0, GRAPH_EDGE_DIR_OUTGOING);
+
+	TEST_ASSERT(csr->nvals == 4);
+	TEST_ASSERT(_Degree(csr, 0) == 3);
+	TEST_ASSERT(_Degree(csr, 1) == 0);
+	TEST_ASSERT(_Degree(csr, 2) == 1);
+	TEST_ASSERT(_Degree(csr, 3) == 0);
+
+	// multi-edge entries are expanded
+	Edge *edges = array_new(Edge, 0);
+	CSR_GetNodeEdges(csr, g, 0, &edges);
+	TEST_ASSERT(array_len(edges) == 3);
+
+	uint to_1 = 0;
+	for(uint i = 0; i < array_len(edges); i++) {
+		TEST_ASSERT(edges[i].src_id == 0);
+		TEST_ASSERT(edges[i].relationID == 0);
+		TEST_ASSERT(edges[i].attributes != NULL);
+		if(edges[i].dest_id == 1) to_1++;
+	}
+	TEST_ASSERT(to_1 == 2);
+
+	array_free(edges);
+	CSR_Free(csr);
+	Graph_Free(g);
+}
+
+void test_incoming() {
+	Graph *g = BuildGraph();
+	CSR *csr = Graph_GetCSR(g, 0, GRAPH_EDGE_DIR_INCOMING);
+
+	TEST_ASSERT(csr->nvals == 4);
+	TEST_ASSERT(_Degree(csr, 0) == 1);
+	TEST_ASSERT(_Degree(csr, 1) == 2);
+	TEST_ASSERT(_Degree(csr, 2) == 1);
+
+	Edge *edges = array_new(Edge, 0);
+	CSR_GetNodeEdges(csr, g, 1, &edges);
+	TEST_ASSERT(array_len(edges) == 2);
+	TEST_ASSERT(edges[0].id != edges[1].id);
+	for(uint i = 0; i < array_len(edges); i++) {
+		TEST_ASSERT(edges[i].src_id  == 0);
+		TEST_ASSERT(edges[i].dest_id == 1);
+	}
+
+	array_free(edges);
+	CSR_Free(csr);
+	Graph_Free(g);
+}
+
+void test_all_relations() {
+	Graph *g = BuildGraph();
+	CSR *csr = Graph_GetCSR(g, GRAPH_NO_RELATION, GRAPH_EDGE_DIR_OUTGOING);
+
+	TEST_ASSERT(csr->nvals == 6);
+	TEST_ASSERT(_Degree(csr, 0) == 4);
+	TEST_ASSERT(_Degree(csr, 3) == 1);
+
+	Edge *edges = array_new(Edge, 0);
+	CSR_GetNodeEdges(csr, g, 3, &edges);
+	TEST_ASSERT(array_len(edges) == 1);
+	TEST_ASSERT(edges[0].relationID == 1);
+	TEST_ASSERT(edges[0].src_id     == 3);
+	TEST_ASSERT(edges[0].dest_id    == 3);
+
+	array_free(edges);
+	CSR_Free(csr);
+	Graph_Free(g);
+}
+
+void test_invalidation() {
+	Graph *g = BuildGraph();
+
+	// snapshots are shared while the graph is unchanged
+	CSR *a = Graph_GetCSR(g, 0, GRAPH_EDGE_DIR_OUTGOING);
+	CSR *b = Graph_GetCSR(g, 0, GRAPH_EDGE_DIR_OUTGOING);
+	TEST_ASSERT(a == b);
+	CSR_Free(b);
+
+	// modify graph
+	Edge e;
+	Graph_AcquireWriteLock(g);
+	Graph_CreateEdge(g, 1, 2, 0, &e);
+	Graph_ReleaseLock(g);
+
+	// stale snapshot is rebuilt, previous snapshot remains usable
+	b = Graph_GetCSR(g, 0, GRAPH_EDGE_DIR_OUTGOING);
+	TEST_ASSERT(a != b);
+	TEST_ASSERT(a->nvals == 4);
+	TEST_ASSERT(b->nvals == 5);
+	TEST_ASSERT(_Degree(b, 1) == 1);
+
+	CSR_Free(a);
+	CSR_Free(b);
+	Graph_Free(g);
+}
+
+TEST_LIST = {
+	{"outgoing", test_outgoing},
+	{"incoming", test_incoming},
+	{"all_relations", test_all_relations},
+	{"invalidation", test_invalidation},
+	{NULL, NULL}
+};
@@ -28,16 +28,13 @@ void test_dataBlockNew() {
 
 	TEST_ASSERT(dataBlock->itemCount == 0);     // No items were added.
 	TEST_ASSERT(dataBlock->itemCap >= 1024);
-	TEST_ASSERT(dataBlock->itemSize == itemSize + ITEM_HEADER_SIZE);
+	TEST_ASSERT(dataBlock->itemSize == itemSize);
 	TEST_ASSERT(dataBlock->blockCount >= 1024 / DATABLOCK_BLOCK_CAP);
 
 	for(int i = 0; i < dataBlock->blockCount; i++) {
 		Block *block = dataBlock->blocks[i];
 		TEST_ASSERT(block->itemSize == dataBlock->itemSize);
 		TEST_ASSERT(block->data != NULL);
-		if(i > 0) {
-			TEST_ASSERT(dataBlock->blocks[i - 1]->next == dataBlock->blocks[i]);
-		}
 	}
 
 	DataBlock_Free(dataBlock);
@@ -149,8 +146,8 @@ void test_dataBlockRemoveItem() {
 	DataBlock_DeleteItem(dataBlock, 0);
 	TEST_ASSERT(dataBlock->itemCount == itemCount - 1);
 	TEST_ASSERT(array_len(dataBlock->deletedIdx) == 1);
-	DataBlockItemHeader *header = (DataBlockItemHeader *)dataBlock->blocks[0]->data;
-	TEST_ASSERT(IS_ITEM_DELETED(header));
+	TEST_ASSERT(DataBlock_ItemIsDeleted(dataBlock, 0));
+	TEST_ASSERT(!DataBlock_ItemIsDeleted(dataBlock, 1));
 
 	// Try to get item from deleted cell.
 	item = (int *)DataBlock_GetItem(dataBlock, 0);
@@ -170,7 +167,8 @@ void test_dataBlockRemoveItem() {
 	int *newItem = (int *)DataBlock_AllocateItem(dataBlock, NULL);
 	TEST_ASSERT(dataBlock->itemCount == itemCount);
 	TEST_ASSERT(array_len(dataBlock->deletedIdx) == 0);
-	TEST_ASSERT((void *)newItem == (void *)((dataBlock->blocks[0]->data) + ITEM_HEADER_SIZE));
+	TEST_ASSERT((void *)newItem == (void *)((dataBlock->blocks[0]->data) +
+				DATABLOCK_BITMAP_SIZE(DATABLOCK_BLOCK_CAP)));
 
 	it = DataBlock_Scan(dataBlock);
 	counter = 0;
@@ -230,12 +228,172 @@ void test_dataBlockOutOfOrderBuilding() {
 	DataBlockIterator_Free(it);
 }
 
+void test_dataBlockScanDeletedRuns() {
+	// small blocks, such that deleted runs span words and blocks
+	uint64_t blockCap = 200;
+	uint itemCount = 1000;
+	DataBlock *dataBlock = DataBlock_New(blockCap, itemCount, sizeof(int64_t), NULL);
+
+	for(uint i = 0; i < itemCount; i++) {
+		int64_t *item = (int64_t *)DataBlock_AllocateItem(dataBlock, NULL);
+		// items are naturally aligned
+		TEST_ASSERT(((uintptr_t)item % sizeof(int64_t)) == 0);
+		*item = i;
+	}
+
+	// delete everything but [0, 10), 130, 199, 200, 640 and [990, 1000)
+	for(uint i = 10; i < 990; i++) {
+		if(i == 130 || i == 199 || i == 200 || i == 640) continue;
+		DataBlock_DeleteItem(dataBlock, i);
+	}
+
+	int64_t expected[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 130, 199, 200, 640,
+		990, 991, 992, 993, 994, 995, 996, 997, 998, 999};
+	uint expected_count = sizeof(expected) / sizeof(expected[0]);
+	TEST_ASSERT(DataBlock_ItemCount(dataBlock) == expected_count);
+
+	uint64_t id;
+	DataBlockIterator *it = DataBlock_Scan(dataBlock);
+	for(uint i = 0; i < expected_count; i++) {
+		int64_t *item = (int64_t *)DataBlockIterator_Next(it, &id);
+		TEST_ASSERT(item != NULL);
+		TEST_ASSERT(*item == expected[i]);
+		TEST_ASSERT(id == expected[i]);
+	}
+	TEST_ASSERT(DataBlockIterator_Next(it, NULL) == NULL);
+	TEST_ASSERT(DataBlockIterator_Position(it) == itemCount);
+
+	// iterator doesn't pass its end position even if the tail is deleted
+	for(uint i = 990; i < itemCount; i++) DataBlock_DeleteItem(dataBlock, i);
+	DataBlockIterator_Free(it);
+	it = DataBlock_Scan(dataBlock);
+	uint count = 0;
+	while(DataBlockIterator_Next(it, NULL)) count++;
+	TEST_ASSERT(count == expected_count - 10);
+	TEST_ASSERT(DataBlockIterator_Position(it) == itemCount);
+
+	DataBlockIterator_Free(it);
+	DataBlock_Free(dataBlock);
+}
+
+void test_dataBlockReleaseDeletedBlocks() {
+	uint64_t blockCap = 128;
+	uint itemCount = 4 * blockCap + 10;
+	DataBlock *dataBlock = DataBlock_New(blockCap, itemCount, sizeof(int), NULL);
+
+	for(uint i = 0; i < itemCount; i++) {
+		int *item = (int *)DataBlock_AllocateItem(dataBlock, NULL);
+		*item = i;
+	}
+
+	// delete blocks 1 and 3 entirely, and all but a single item of block 2
+	for(uint i = blockCap; i < 4 * blockCap; i++) {
+		if(i == 2 * blockCap + 5) continue;
+		DataBlock_DeleteItem(dataBlock, i);
+	}
+
+	uint64_t deleted[3 * blockCap - 1];
+	memcpy(deleted, dataBlock->deletedIdx, sizeof(deleted));
+
+	size_t released = DataBlock_ReleaseDeletedBlocks(dataBlock);
+	TEST_ASSERT(released > 2 * blockCap * sizeof(int));
+	TEST_ASSERT(dataBlock->blocks[0] != NULL);
+	TEST_ASSERT(dataBlock->blocks[1] == NULL);
+	TEST_ASSERT(dataBlock->blocks[2] != NULL);
+	TEST_ASSERT(dataBlock->blocks[3] == NULL);
+	TEST_ASSERT(dataBlock->blocks[4] != NULL);
+
+	// nothing left to release
+	TEST_ASSERT(DataBlock_ReleaseDeletedBlocks(dataBlock) == 0);
+
+	// free list is unaffected
+	TEST_ASSERT(array_len(dataBlock->deletedIdx) == 3 * blockCap - 1);
+	TEST_ASSERT(memcmp(deleted, dataBlock->deletedIdx, sizeof(deleted)) == 0);
+
+	// released items are deleted
+	TEST_ASSERT(DataBlock_GetItem(dataBlock, blockCap) == NULL);
+	TEST_ASSERT(DataBlock_ItemIsDeleted(dataBlock, 3 * blockCap + 1));
+	TEST_ASSERT(*(int *)DataBlock_GetItem(dataBlock, 2 * blockCap + 5) ==
+			2 * blockCap + 5);
+
+	// scan skips released blocks
+	uint64_t id;
+	uint count = 0;
+	DataBlockIterator *it = DataBlock_Scan(dataBlock);
+	while(DataBlockIterator_Next(it, &id)) {
+		TEST_ASSERT(id < blockCap || id == 2 * blockCap + 5 ||
+				id >= 4 * blockCap);
+		count++;
+	}
+	TEST_ASSERT(count == DataBlock_ItemCount(dataBlock));
+	DataBlockIterator_Free(it);
+
+	// reusing an index re-allocates its block
+	uint64_t idx;
+	int *item = (int *)DataBlock_AllocateItem(dataBlock, &idx);
+	TEST_ASSERT(idx == deleted[3 * blockCap - 2]);
+	*item = -1;
+	TEST_ASSERT(DataBlock_GetItem(dataBlock, idx) == item);
+
+	Block *block = dataBlock->blocks[idx / blockCap];
+	TEST_ASSERT(block != NULL);
+	for(uint64_t i = (idx / blockCap) * blockCap;
+			i < (idx / blockCap + 1) * blockCap; i++) {
+		TEST_ASSERT(DataBlock_ItemIsDeleted(dataBlock, i) == (i != idx));
+	}
+
+	DataBlock_Free(dataBlock);
+}
+
+void test_dataBlockCleanBlock() {
+	uint64_t blockCap = 64;
+	uint itemCount = 3 * blockCap;
+	DataBlock *dataBlock = DataBlock_New(blockCap, itemCount, sizeof(int), NULL);
+
+	for(uint i = 0; i < itemCount; i++) {
+		DataBlock_AllocateItem(dataBlock, NULL);
+	}
+
+	// no deletions
+	for(uint i = 0; i < 3; i++) TEST_ASSERT(!DataBlock_CleanBlock(dataBlock, i));
+
+	DataBlock_DeleteItem(dataBlock, blockCap + 3);
+	DataBlock_DeleteItem(dataBlock, blockCap + 7);
+
+	TEST_ASSERT(!DataBlock_CleanBlock(dataBlock, 0));
+	TEST_ASSERT(DataBlock_CleanBlock(dataBlock, 1));
+	TEST_ASSERT(!DataBlock_CleanBlock(dataBlock, 2));
+
+	// block is clean until one of its items is deleted again
+	TEST_ASSERT(!DataBlock_CleanBlock(dataBlock, 1));
+
+	// reusing a deleted item doesn't dirty its block
+	DataBlock_AllocateItem(dataBlock, NULL);
+	TEST_ASSERT(!DataBlock_CleanBlock(dataBlock, 1));
+
+	// blocks added while growing are clean
+	DataBlock_Accommodate(dataBlock, 2 * blockCap);
+	TEST_ASSERT(dataBlock->blockCount > 3);
+	for(uint i = 3; i < dataBlock->blockCount; i++) {
+		TEST_ASSERT(!DataBlock_CleanBlock(dataBlock, i));
+	}
+
+	// out of order deletions dirty their block
+	DataBlock_MarkAsDeletedOutOfOrder(dataBlock, 4 * blockCap + 1);
+	TEST_ASSERT(DataBlock_CleanBlock(dataBlock, 4));
+
+	DataBlock_Free(dataBlock);
+}
+
 TEST_LIST = {
 	{"dataBlockNew", test_dataBlockNew},
 	{"dataBlockAddItem", test_dataBlockAddItem },
 	{"dataBlockScan", test_dataBlockScan},
 	{"dataBlockRemoveItem", test_dataBlockRemoveItem},
 	{"dataBlockOutOfOrderBuilding", test_dataBlockOutOfOrderBuilding},
+	{"dataBlockScanDeletedRuns", test_dataBlockScanDeletedRuns},
+	{"dataBlockReleaseDeletedBlocks", test_dataBlockReleaseDeletedBlocks},
+	{"dataBlockCleanBlock", test_dataBlockCleanBlock},
 	{NULL, NULL}
 };
 
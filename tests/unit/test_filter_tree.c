@@ -9,9 +9,12 @@
 #include "src/util/rmalloc.h"
 #include "src/errors/errors.h"
 #include "src/filter_tree/filter_tree.h"
+#include "src/filter_tree/batch_filter.h"
+#include "src/datatypes/map.h"
 #include "src/ast/ast_build_filter_tree.h"
 #include "src/arithmetic/funcs.h"
 
+#include <math.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -630,6 +633,113 @@ void test_compact() {
 	AST_Free(ast);
 }
 
+// build a record holding a map bound to 'me'
+// {age: age, height: height}, NULL values are omitted
+static Record _build_map_record
+(
+	rax *mapping,
+	SIValue age,
+	SIValue height
+) {
+	SIValue map = Map_New(2);
+	if(SI_TYPE(age) != T_NULL) Map_Add(&map, SI_ConstStringVal("age"), age);
+	if(SI_TYPE(height) != T_NULL) {
+		Map_Add(&map, SI_ConstStringVal("height"), height);
+	}
+
+	Record r = Record_New(mapping);
+	Record_AddScalar(r, 0, map);
+	return r;
+}
+
+void test_batchFilter() {
+	rax *mapping = raxNew();
+	raxInsert(mapping, (unsigned char *)"me", 2, (void *)0, NULL);
+
+	SIValue values[] = {
+		SI_NullVal(), SI_LongVal(0), SI_LongVal(-1), SI_LongVal(34),
+		SI_LongVal(188), SI_LongVal(INT64_MAX), SI_LongVal(INT64_MIN),
+		SI_DoubleVal(33.5), SI_DoubleVal(34.0), SI_DoubleVal(170.5),
+		SI_DoubleVal(NAN), SI_DoubleVal(INFINITY), SI_DoubleVal(-INFINITY),
+		SI_BoolVal(true), SI_BoolVal(false), SI_ConstStringVal("34")
+	};
+	uint value_count = sizeof(values) / sizeof(values[0]);
+
+	// every (age, height) combination
+	uint n = 0;
+	Record records[256];
+	for(uint i = 0; i < value_count; i++) {
+		for(uint j = 0; j < value_count; j++) {
+			records[n++] = _build_map_record(mapping, values[i], values[j]);
+		}
+	}
+
+	const char *filters[] = {
+		"me.age > 34",
+		"me.age = 34",
+		"me.age <> 34",
+		"34 >= me.age",
+		"me.age < 33.5",
+		"me.age >= -1.5",
+		"me.age = true",
+		"me.age <> false",
+		"me.age > 3 AND me.height <= 188",
+		"me.age < 0 OR me.height = 170.5",
+		"(me.age > 1 OR me.age < -1) AND me.height <> 0",
+		"me.age < -9223372036854775807 OR me.age > 9223372036854775806"
+	};
+
+	for(uint i = 0; i < sizeof(filters) / sizeof(filters[0]); i++) {
+		char q[256];
+		sprintf(q, "MATCH (me) WHERE %s RETURN me", filters[i]);
+		FT_FilterNode *tree = build_tree_from_query(q);
+
+		BatchFilter *f = BatchFilter_Compile(tree);
+		TEST_ASSERT(f != NULL);
+		TEST_MSG("filter: %s", filters[i]);
+
+		// evaluate in batches of various sizes
+		for(uint offset = 0; offset < n; offset += BATCH_FILTER_CAP - 3) {
+			uint len = MIN(BATCH_FILTER_CAP - 3, n - offset);
+			uint64_t selected = BatchFilter_Apply(f, records + offset, len);
+
+			for(uint j = 0; j < len; j++) {
+				bool expected = FilterTree_applyFilters(tree,
+						records[offset + j]) == FILTER_PASS;
+				bool actual = selected & (1ULL << j);
+				TEST_ASSERT(expected == actual);
+				TEST_MSG("filter: %s, record: %u", filters[i], offset + j);
+			}
+		}
+
+		BatchFilter_Free(f);
+		FilterTree_Free(tree);
+		AST_Free(QueryCtx_GetAST());
+	}
+
+	// trees which can't be compiled
+	const char *unsupported[] = {
+		"me.age > me.height",
+		"me.age = 'a'",
+		"me.age + 1 > 3",
+		"me.age > 3 XOR me.height > 3",
+		"me.age IS NULL"
+	};
+
+	for(uint i = 0; i < sizeof(unsupported) / sizeof(unsupported[0]); i++) {
+		char q[256];
+		sprintf(q, "MATCH (me) WHERE %s RETURN me", unsupported[i]);
+		FT_FilterNode *tree = build_tree_from_query(q);
+		TEST_ASSERT(BatchFilter_Compile(tree) == NULL);
+		TEST_MSG("filter: %s", unsupported[i]);
+		FilterTree_Free(tree);
+		AST_Free(QueryCtx_GetAST());
+	}
+
+	for(uint i = 0; i < n; i++) Record_Free(records[i]);
+	raxFree(mapping);
+}
+
 TEST_LIST = {
 	{"subTrees", test_subTrees},
 	{"collectModified", test_collectModified},
@@ -637,5 +747,6 @@ TEST_LIST = {
 	{"containsFunc", test_containsFunc},
 	{"clone", test_clone},
 	{"compact", test_compact},
+	{"batchFilter", test_batchFilter},
 	{NULL, NULL}
 };
@@ -0,0 +1,124 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "src/value.h"
+#include "src/util/rmalloc.h"
+#include "src/grouping/group_table.h"
+
+#include <stdio.h>
+
+void setup() {
+	Alloc_Reset();
+}
+
+#define TEST_INIT setup();
+#include "acutest.h"
+
+// hash a single key
+static uint64_t _hash
+(
+	SIValue v
+) {
+	XXH64_state_t state;
+	XXH64_reset(&state, 0);
+	SIValue_HashUpdate(v, &state);
+	return XXH64_digest(&state);
+}
+
+void test_groupTableInsert() {
+	bool created;
+	uint64_t n = 10000;
+	GroupTable *t = GroupTable_New(1, 4);
+
+	// insert n distinct groups, forcing the table to grow
+	for(uint64_t i = 0; i < n; i++) {
+		char buf[32];
+		sprintf(buf, "%d", (int)i);
+		SIValue key = SI_ConstStringVal(buf);
+		uint64_t g = GroupTable_FindOrInsert(t, _hash(key), &key, &created);
+		TEST_ASSERT(created);
+		TEST_ASSERT(g == i);
+	}
+
+	TEST_ASSERT(GroupTable_Count(t) == n);
+
+	// lookup existing groups, groups are numbered in insertion order
+	for(uint64_t i = 0; i < n; i++) {
+		char buf[32];
+		sprintf(buf, "%d", (int)i);
+		SIValue key = SI_ConstStringVal(buf);
+		uint64_t g = GroupTable_FindOrInsert(t, _hash(key), &key, &created);
+		TEST_ASSERT(!created);
+		TEST_ASSERT(g == i);
+
+		// keys are persisted
+		SIValue *keys = GroupTable_Keys(t, g);
+		TEST_ASSERT(strcmp(keys[0].stringval, buf) == 0);
+		TEST_ASSERT(keys[0].stringval != buf);
+	}
+
+	TEST_ASSERT(GroupTable_Count(t) == n);
+
+	GroupTable_Free(t);
+}
+
+void test_groupTableNumerics() {
+	bool created;
+	GroupTable *t = GroupTable_New(1, 16);
+
+	// integers and integral doubles share a group
+	SIValue k = SI_LongVal(3);
+	uint64_t a = GroupTable_FindOrInsert(t, _hash(k), &k, &created);
+	TEST_ASSERT(created);
+
+	k = SI_DoubleVal(3.0);
+	uint64_t b = GroupTable_FindOrInsert(t, _hash(k), &k, &created);
+	TEST_ASSERT(!created);
+	TEST_ASSERT(a == b);
+
+	k = SI_DoubleVal(3.5);
+	b = GroupTable_FindOrInsert(t, _hash(k), &k, &created);
+	TEST_ASSERT(created);
+	TEST_ASSERT(a != b);
+
+	GroupTable_Free(t);
+}
+
+void test_groupTableClear() {
+	bool created;
+	GroupTable *t = GroupTable_New(2, 16);
+
+	for(int i = 0; i < 100; i++) {
+		SIValue keys[2] = {SI_LongVal(i), SI_DuplicateStringVal("key")};
+		XXH64_state_t state;
+		XXH64_reset(&state, 0);
+		SIValue_HashUpdate(keys[0], &state);
+		SIValue_HashUpdate(keys[1], &state);
+		GroupTable_FindOrInsert(t, XXH64_digest(&state), keys, &created);
+		TEST_ASSERT(created);
+	}
+
+	TEST_ASSERT(GroupTable_Count(t) == 100);
+
+	GroupTable_Clear(t);
+	TEST_ASSERT(GroupTable_Count(t) == 0);
+
+	// table is usable once cleared
+	SIValue keys[2] = {SI_LongVal(0), SI_ConstStringVal("key")};
+	uint64_t g = GroupTable_FindOrInsert(t, _hash(keys[0]), keys, &created);
+	TEST_ASSERT(created);
+	TEST_ASSERT(g == 0);
+
+	GroupTable_Free(t);
+}
+
+TEST_LIST = {
+	{"groupTableInsert", test_groupTableInsert},
+	{"groupTableNumerics", test_groupTableNumerics},
+	{"groupTableClear", test_groupTableClear},
+	{NULL, NULL}
+};
+
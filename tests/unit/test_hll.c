@@ -0,0 +1,80 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "src/util/hll.h"
+#include "src/util/rmalloc.h"
+#include "xxhash.h"
+
+#include <math.h>
+#include <stdbool.h>
+
+void setup() {
+	Alloc_Reset();
+}
+
+#define TEST_INIT setup();
+#include "acutest.h"
+
+static uint64_t _hash(uint64_t v) {
+	return XXH64(&v, sizeof(v), 0);
+}
+
+// returns true if 'estimate' is within 10% of 'expected'
+static bool _close(uint64_t estimate, uint64_t expected) {
+	return fabs((double)estimate - (double)expected) <= expected * 0.1;
+}
+
+void test_hllEmpty() {
+	HLL hll;
+	HLL_Init(&hll);
+	TEST_ASSERT(HLL_Count(&hll) == 0);
+}
+
+void test_hllCount() {
+	HLL hll;
+	uint64_t counts[4] = {10, 1000, 50000, 1000000};
+
+	for(int i = 0; i < 4; i++) {
+		HLL_Init(&hll);
+		for(uint64_t j = 0; j < counts[i]; j++) HLL_Add(&hll, _hash(j));
+		TEST_ASSERT(_close(HLL_Count(&hll), counts[i]));
+	}
+}
+
+void test_hllDuplicates() {
+	HLL hll;
+	HLL_Init(&hll);
+
+	// duplicates do not affect the estimate
+	for(int i = 0; i < 100; i++) {
+		for(uint64_t j = 0; j < 500; j++) HLL_Add(&hll, _hash(j));
+	}
+
+	TEST_ASSERT(_close(HLL_Count(&hll), 500));
+}
+
+void test_hllMerge() {
+	HLL a;
+	HLL b;
+	HLL_Init(&a);
+	HLL_Init(&b);
+
+	// a = [0, 20000), b = [10000, 30000)
+	for(uint64_t i = 0;     i < 20000; i++) HLL_Add(&a, _hash(i));
+	for(uint64_t i = 10000; i < 30000; i++) HLL_Add(&b, _hash(i));
+
+	HLL_Merge(&a, &b);
+	TEST_ASSERT(_close(HLL_Count(&a), 30000));
+}
+
+TEST_LIST = {
+	{"hllEmpty", test_hllEmpty},
+	{"hllCount", test_hllCount},
+	{"hllDuplicates", test_hllDuplicates},
+	{"hllMerge", test_hllMerge},
+	{NULL, NULL}
+};
+
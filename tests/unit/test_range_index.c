@@ -0,0 +1,275 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "src/value.h"
+#include "src/util/rmalloc.h"
+#include "src/index/range_index.h"
+#include "src/graph/entities/attribute_set.h"
+
+#include <stdio.h>
+
+void setup() {
+	Alloc_Reset();
+}
+
+#define TEST_INIT setup();
+#include "acutest.h"
+
+#define ATTR 0
+#define N 20000
+
+static AttributeSet sets[N];
+
+// set entity 'id' attribute to 'v' and index it
+static void _index
+(
+	RangeIndex *ri,
+	EntityID id,
+	SIValue v
+) {
+	AttributeSet_Free(sets + id);
+	AttributeSet_Add(sets + id, ATTR, v);
+
+	GraphEntity e = {.attributes = sets + id, .id = id};
+	RangeIndex_Index(ri, &e, INVALID_ENTITY_ID, INVALID_ENTITY_ID);
+}
+
+// count entities within [lo, hi)
+static uint64_t _count
+(
+	RangeIndex *ri,
+	SIValue lo,
+	SIValue hi
+) {
+	RangeQuery *q = RangeQuery_New();
+	RangeIndexRange r = {
+		.attr        = ATTR,
+		.cls         = RangeKey_Class(lo),
+		.min         = SI_CloneValue(lo),
+		.max         = SI_CloneValue(hi),
+		.include_min = true,
+		.include_max = false
+	};
+	RangeQuery_AddRange(q, &r);
+
+	EntityID id;
+	uint64_t n = 0;
+	RangeIndexIterator *it = RangeIndex_Query(ri, q);
+	while(RangeIndexIterator_Next(it, &id, NULL, NULL)) n++;
+	RangeIndexIterator_Free(it);
+
+	return n;
+}
+
+static void _free_sets(void) {
+	for(int i = 0; i < N; i++) AttributeSet_Free(sets + i);
+}
+
+void test_rangeIndexNumeric() {
+	Attribute_ID attrs[1] = {ATTR};
+	RangeIndex *ri = RangeIndex_New(attrs, 1);
+
+	// stage entities, tree is bulk loaded on flush
+	for(int i = 0; i < N; i++) _index(ri, i, SI_LongVal(i % 1000));
+	TEST_ASSERT(RangeIndex_Staging(ri));
+	RangeIndex_Flush(ri);
+	TEST_ASSERT(!RangeIndex_Staging(ri));
+	TEST_ASSERT(RangeIndex_EntryCount(ri) == N);
+
+	TEST_ASSERT(_count(ri, SI_LongVal(10), SI_LongVal(20)) == 10 * N / 1000);
+
+	// integers and doubles share a class
+	TEST_ASSERT(_count(ri, SI_DoubleVal(9.5), SI_DoubleVal(10.5)) == N / 1000);
+
+	// update entities in place
+	for(int i = 0; i < N; i += 2) _index(ri, i, SI_DoubleVal(-1.5));
+	TEST_ASSERT(RangeIndex_EntryCount(ri) == N);
+	TEST_ASSERT(_count(ri, SI_LongVal(-2), SI_LongVal(0)) == N / 2);
+
+	// remove entities
+	for(int i = 0; i < N; i += 4) RangeIndex_Remove(ri, i);
+	TEST_ASSERT(RangeIndex_DocCount(ri) == N - N / 4);
+	TEST_ASSERT(_count(ri, SI_LongVal(-2), SI_LongVal(0)) == N / 4);
+
+	RangeIndex_Free(ri);
+	_free_sets();
+}
+
+void test_rangeIndexClasses() {
+	Attribute_ID attrs[1] = {ATTR};
+	RangeIndex *ri = RangeIndex_New(attrs, 1);
+	RangeIndex_Flush(ri);
+
+	_index(ri, 0, SI_BoolVal(true));
+	_index(ri, 1, SI_LongVal(1));
+	_index(ri, 2, SI_ConstStringVal("1"));
+
+	// booleans, numerics and strings are distinct keys
+	TEST_ASSERT(RangeIndex_HasValue(ri, 0, ATTR, SI_BoolVal(true)));
+	TEST_ASSERT(!RangeIndex_HasValue(ri, 0, ATTR, SI_LongVal(1)));
+	TEST_ASSERT(RangeIndex_HasValue(ri, 1, ATTR, SI_DoubleVal(1.0)));
+	TEST_ASSERT(!RangeIndex_HasValue(ri, 1, ATTR, SI_BoolVal(true)));
+	TEST_ASSERT(RangeIndex_HasValue(ri, 2, ATTR, SI_ConstStringVal("1")));
+
+	TEST_ASSERT(_count(ri, SI_LongVal(0), SI_LongVal(2)) == 1);
+	TEST_ASSERT(_count(ri, SI_ConstStringVal("0"), SI_ConstStringVal("2")) == 1);
+
+	RangeIndex_Free(ri);
+	_free_sets();
+}
+
+void test_rangeIndexUnion() {
+	char buf[32];
+	Attribute_ID attrs[1] = {ATTR};
+	RangeIndex *ri = RangeIndex_New(attrs, 1);
+
+	for(int i = 0; i < 1000; i++) {
+		sprintf(buf, "s%04d", i);
+		_index(ri, i, SI_ConstStringVal(buf));
+	}
+	RangeIndex_Flush(ri);
+
+	// overlapping ranges, each entity is produced once
+	RangeQuery *q = RangeQuery_New();
+	RangeIndexRange a = {.attr = ATTR, .cls = RANGE_KEY_STRING,
+		.min = SI_DuplicateStringVal("s0010"), .max = SI_DuplicateStringVal("s0020"),
+		.include_min = true, .include_max = true};
+	RangeIndexRange b = {.attr = ATTR, .cls = RANGE_KEY_STRING,
+		.min = SI_DuplicateStringVal("s0015"), .max = SI_DuplicateStringVal("s0030"),
+		.include_min = false, .include_max = false};
+	RangeQuery_AddRange(q, &a);
+	RangeQuery_AddRange(q, &b);
+
+	EntityID id;
+	EntityID prev = 0;
+	int n = 0;
+	RangeIndexIterator *it = RangeIndex_Query(ri, q);
+	while(RangeIndexIterator_Next(it, &id, NULL, NULL)) {
+		if(n > 0) TEST_ASSERT(id > prev);
+		prev = id;
+		n++;
+	}
+	TEST_ASSERT(n == 20);
+
+	// iterator is restartable
+	RangeIndexIterator_Reset(it);
+	n = 0;
+	while(RangeIndexIterator_Next(it, &id, NULL, NULL)) n++;
+	TEST_ASSERT(n == 20);
+
+	RangeIndexIterator_Free(it);
+	RangeIndex_Free(ri);
+	_free_sets();
+}
+
+void test_rangeIndexModifyWhileIterating() {
+	Attribute_ID attrs[1] = {ATTR};
+	RangeIndex *ri = RangeIndex_New(attrs, 1);
+
+	for(int i = 0; i < 1000; i++) _index(ri, i, SI_LongVal(i));
+	RangeIndex_Flush(ri);
+
+	RangeQuery *q = RangeQuery_New();
+	RangeIndexRange r = {.attr = ATTR, .cls = RANGE_KEY_NUMERIC,
+		.min = SI_LongVal(0), .max = SI_NullVal(), .include_min = true};
+	RangeQuery_AddRange(q, &r);
+
+	// remove every other entity as it is produced
+	EntityID id;
+	int n = 0;
+	RangeIndexIterator *it = RangeIndex_Query(ri, q);
+	while(RangeIndexIterator_Next(it, &id, NULL, NULL) && n <= 1000) {
+		if(id % 2 == 0) RangeIndex_Remove(ri, id);
+		n++;
+	}
+	TEST_ASSERT(n == 1000);
+	TEST_ASSERT(RangeIndex_DocCount(ri) == 500);
+
+	RangeIndexIterator_Free(it);
+	RangeIndex_Free(ri);
+	_free_sets();
+}
+
+// count entities whose string contains 'substr'
+static uint64_t _count_substr
+(
+	RangeIndex *ri,
+	const char *substr
+) {
+	RangeQuery *q = RangeQuery_New();
+	RangeIndexRange r = {
+		.attr        = ATTR,
+		.cls         = RANGE_KEY_STRING,
+		.min         = SI_NullVal(),
+		.max         = SI_NullVal(),
+		.include_min = true,
+		.include_max = true,
+		.substr      = rm_strdup(substr)
+	};
+	RangeQuery_AddRange(q, &r);
+
+	EntityID id;
+	uint64_t n = 0;
+	RangeIndexIterator *it = RangeIndex_Query(ri, q);
+	while(RangeIndexIterator_Next(it, &id, NULL, NULL)) n++;
+	RangeIndexIterator_Free(it);
+
+	return n;
+}
+
+void test_rangeIndexTrigrams() {
+	char buf[32];
+	Attribute_ID attrs[1] = {ATTR};
+	RangeIndex *ri = RangeIndex_New(attrs, 1);
+	RangeIndex_EnableTrigrams(ri);
+	TEST_ASSERT(RangeIndex_HasTrigrams(ri));
+
+	for(int i = 0; i < 1000; i++) {
+		sprintf(buf, "user%03d", i);
+		_index(ri, i, SI_ConstStringVal(buf));
+	}
+	_index(ri, 1000, SI_LongVal(12));
+	_index(ri, 1001, SI_ConstStringVal("abcxbcd"));
+	RangeIndex_Flush(ri);
+
+	// resolved by trigram postings
+	TEST_ASSERT(_count_substr(ri, "user") == 1000);
+	TEST_ASSERT(_count_substr(ri, "r12") == 10);
+	TEST_ASSERT(_count_substr(ri, "123") == 1);
+	TEST_ASSERT(_count_substr(ri, "ser9") == 100);
+	TEST_ASSERT(_count_substr(ri, "xyz") == 0);
+
+	// candidates are verified, 'abcxbcd' holds both trigrams of 'abcd'
+	TEST_ASSERT(_count_substr(ri, "bcd") == 1);
+	TEST_ASSERT(_count_substr(ri, "abcd") == 0);
+
+	// shorter substrings scan every string
+	TEST_ASSERT(_count_substr(ri, "12") == 20);
+
+	// postings follow updates and removals
+	for(int i = 0; i < 1000; i += 2) {
+		sprintf(buf, "admin%03d", i);
+		_index(ri, i, SI_ConstStringVal(buf));
+	}
+	for(int i = 1; i < 1000; i += 4) RangeIndex_Remove(ri, i);
+
+	TEST_ASSERT(_count_substr(ri, "user") == 250);
+	TEST_ASSERT(_count_substr(ri, "admin") == 500);
+	TEST_ASSERT(_count_substr(ri, "min12") == 5);
+
+	RangeIndex_Free(ri);
+	_free_sets();
+}
+
+TEST_LIST = {
+	{"rangeIndexNumeric", test_rangeIndexNumeric},
+	{"rangeIndexClasses", test_rangeIndexClasses},
+	{"rangeIndexUnion", test_rangeIndexUnion},
+	{"rangeIndexModifyWhileIterating", test_rangeIndexModifyWhileIterating},
+	{"rangeIndexTrigrams", test_rangeIndexTrigrams},
+	{NULL, NULL}
+};
+
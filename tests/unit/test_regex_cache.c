@@ -0,0 +1,173 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "src/util/rmalloc.h"
+#include "src/util/regex_cache.h"
+
+#include <stdio.h>
+#include <string.h>
+
+void setup() {
+	Alloc_Reset();
+}
+
+void tearDown() {
+	Regex_ClearCache();
+}
+
+#define TEST_INIT setup();
+#define TEST_FINI tearDown();
+#include "acutest.h"
+
+static bool _match(regex_t *regex, const char *str) {
+	const UChar *start = (const UChar *)str;
+	const UChar *end   = start + strlen(str);
+	return onig_match(regex, start, end, start, NULL, ONIG_OPTION_NONE) >= 0;
+}
+
+void test_regexCacheReuse() {
+	char err[ONIG_MAX_ERROR_MESSAGE_LEN];
+
+	// compiling the same pattern twice returns the cached regex
+	regex_t *a = Regex_Compile("a.c", false, err);
+	regex_t *b = Regex_Compile("a.c", false, err);
+	TEST_ASSERT(a != NULL);
+	TEST_ASSERT(a == b);
+
+	// anchored patterns are cached separately
+	regex_t *c = Regex_Compile("a.c", true, err);
+	TEST_ASSERT(c != NULL);
+	TEST_ASSERT(c != a);
+	TEST_ASSERT(Regex_Compile("a.c", true, err) == c);
+}
+
+void test_regexCacheAnchored() {
+	char err[ONIG_MAX_ERROR_MESSAGE_LEN];
+
+	regex_t *regex = Regex_Compile("a|ab", true, err);
+	TEST_ASSERT(regex != NULL);
+	TEST_ASSERT(_match(regex, "a"));
+	TEST_ASSERT(_match(regex, "ab"));
+	TEST_ASSERT(!_match(regex, "abc"));
+
+	regex = Regex_Compile("a.c", false, err);
+	TEST_ASSERT(_match(regex, "abcd"));
+
+	regex = Regex_Compile("a.c", true, err);
+	TEST_ASSERT(!_match(regex, "abcd"));
+}
+
+void test_regexCacheInvalid() {
+	char err[ONIG_MAX_ERROR_MESSAGE_LEN];
+
+	err[0] = '\0';
+	TEST_ASSERT(Regex_Compile("?", false, err) == NULL);
+	TEST_ASSERT(strlen(err) > 0);
+
+	// patterns invalid on their own are rejected even once anchored
+	err[0] = '\0';
+	TEST_ASSERT(Regex_Compile("a)(b", true, err) == NULL);
+	TEST_ASSERT(strlen(err) > 0);
+}
+
+void test_regexCacheEviction() {
+	char pattern[32];
+	char err[ONIG_MAX_ERROR_MESSAGE_LEN];
+
+	regex_t *first = Regex_Compile("p0", false, err);
+
+	// fill the cache, keeping 'p0' the most recently used pattern
+	for(int i = 1; i < REGEX_CACHE_SIZE * 2; i++) {
+		sprintf(pattern, "p%d", i);
+		TEST_ASSERT(Regex_Compile(pattern, false, err) != NULL);
+		TEST_ASSERT(Regex_Compile("p0", false, err) == first);
+	}
+
+	// the least recently used pattern is recompiled
+	regex_t *regex = Regex_Compile("p1", false, err);
+	TEST_ASSERT(regex != NULL);
+	TEST_ASSERT(_match(regex, "p1"));
+}
+
+void test_regexLiteralPrefix() {
+	const char *patterns[] = {
+		"abc",     "abc",
+		"abc.*",   "abc",
+		"^abc",    "abc",
+		"ab?c",    "a",
+		"ab*",     "a",
+		"ab{2}",   "a",
+		"ab+c",    "ab",
+		"a\\.b.*", "a.b",
+		"ab\\d",   "ab",
+		"a[bc]",   "a",
+		"a(b)",    "a",
+		"😀x?",    "😀",
+		"x😀?",    "x",
+	};
+
+	uint n = sizeof(patterns) / sizeof(patterns[0]);
+	for(uint i = 0; i < n; i += 2) {
+		char *prefix = Regex_LiteralPrefix(patterns[i]);
+		TEST_ASSERT(prefix != NULL);
+		TEST_CHECK(strcmp(prefix, patterns[i + 1]) == 0);
+		TEST_MSG("pattern: %s, prefix: %s", patterns[i], prefix);
+		rm_free(prefix);
+	}
+
+	// no literal prefix
+	const char *none[] = {".*abc", "a?bc", "ab|cd", "(?i)abc", "\\dabc", ""};
+	n = sizeof(none) / sizeof(none[0]);
+	for(uint i = 0; i < n; i++) {
+		TEST_CHECK(Regex_LiteralPrefix(none[i]) == NULL);
+		TEST_MSG("pattern: %s", none[i]);
+	}
+}
+
+void test_regexLiteralSubstring() {
+	const char *patterns[] = {
+		"abc",           "abc",
+		".*smith.*",     "smith",
+		"a.*bcd",        "bcd",
+		"^ab.cd$",       "ab",
+		"xy?abcd",       "abcd",
+		"abc+de",        "abc",
+		"[a-z]+son",     "son",
+		"[]abcd]x",      "x",
+		"x{12345}yz",    "yz",
+		"(abcd)?ef",     "ef",
+		"a\\.b\\dcd",    "a.b",
+		"\\w+😀😀",      "😀😀",
+	};
+
+	uint n = sizeof(patterns) / sizeof(patterns[0]);
+	for(uint i = 0; i < n; i += 2) {
+		char *substr = Regex_LiteralSubstring(patterns[i]);
+		TEST_ASSERT(substr != NULL);
+		TEST_CHECK(strcmp(substr, patterns[i + 1]) == 0);
+		TEST_MSG("pattern: %s, substring: %s", patterns[i], substr);
+		rm_free(substr);
+	}
+
+	// no required literal
+	const char *none[] = {".*", "abc|def", "(?i)abc", "\\Qabc\\E",
+		"\\x41\\x42", "(abc)", "[abc]+", "a*b?", ""};
+	n = sizeof(none) / sizeof(none[0]);
+	for(uint i = 0; i < n; i++) {
+		TEST_CHECK(Regex_LiteralSubstring(none[i]) == NULL);
+		TEST_MSG("pattern: %s", none[i]);
+	}
+}
+
+TEST_LIST = {
+	{"regexCacheReuse", test_regexCacheReuse},
+	{"regexCacheAnchored", test_regexCacheAnchored},
+	{"regexCacheInvalid", test_regexCacheInvalid},
+	{"regexCacheEviction", test_regexCacheEviction},
+	{"regexLiteralPrefix", test_regexLiteralPrefix},
+	{"regexLiteralSubstring", test_regexLiteralSubstring},
+	{NULL, NULL}
+};
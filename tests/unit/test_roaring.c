@@ -0,0 +1,153 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "src/util/rmalloc.h"
+#include "src/util/roaring.h"
+
+#include <stdlib.h>
+
+void setup() {
+	Alloc_Reset();
+}
+
+#define TEST_INIT setup();
+#include "acutest.h"
+
+// validate set holds exactly the members of 'expected'
+static void _validate
+(
+	const Roaring *r,
+	const bool *expected,
+	uint64_t n
+) {
+	uint64_t v;
+	uint64_t count = 0;
+	RoaringIterator it;
+
+	for(uint64_t i = 0; i < n; i++) {
+		TEST_ASSERT(Roaring_Contains(r, i) == expected[i]);
+		count += expected[i];
+	}
+	TEST_ASSERT(Roaring_Cardinality(r) == count);
+
+	// values are produced in ascending order
+	uint64_t produced = 0;
+	int64_t prev = -1;
+	RoaringIterator_Init(&it, r);
+	while(RoaringIterator_Next(&it, &v)) {
+		TEST_ASSERT((int64_t)v > prev);
+		TEST_ASSERT(v < n && expected[v]);
+		prev = v;
+		produced++;
+	}
+	TEST_ASSERT(produced == count);
+}
+
+void test_roaringAddRemove() {
+	Roaring *r = Roaring_New();
+
+	TEST_ASSERT(Roaring_Cardinality(r) == 0);
+	TEST_ASSERT(!Roaring_Contains(r, 7));
+	TEST_ASSERT(!Roaring_Remove(r, 7));
+
+	TEST_ASSERT(Roaring_Add(r, 7));
+	TEST_ASSERT(!Roaring_Add(r, 7));
+	TEST_ASSERT(Roaring_Add(r, 1 << 20));
+	TEST_ASSERT(Roaring_Add(r, UINT64_MAX));
+
+	TEST_ASSERT(Roaring_Contains(r, 7));
+	TEST_ASSERT(Roaring_Contains(r, 1 << 20));
+	TEST_ASSERT(Roaring_Contains(r, UINT64_MAX));
+	TEST_ASSERT(!Roaring_Contains(r, 8));
+	TEST_ASSERT(Roaring_Cardinality(r) == 3);
+
+	TEST_ASSERT(Roaring_Remove(r, 7));
+	TEST_ASSERT(!Roaring_Remove(r, 7));
+	TEST_ASSERT(!Roaring_Contains(r, 7));
+	TEST_ASSERT(Roaring_Cardinality(r) == 2);
+
+	Roaring_Free(r);
+}
+
+void test_roaringDense() {
+	// spans several containers, some of which become bitmaps
+	uint64_t n = 200000;
+	bool *expected = calloc(n, sizeof(bool));
+	Roaring *r = Roaring_New();
+
+	srand(42);
+	for(uint64_t i = 0; i < n; i++) {
+		if(rand() % 3 == 0) continue;
+		expected[i] = true;
+		TEST_ASSERT(Roaring_Add(r, i));
+	}
+	_validate(r, expected, n);
+
+	size_t dense = Roaring_Memory(r);
+
+	// remove most values, bitmaps shrink back to arrays
+	for(uint64_t i = 0; i < n; i++) {
+		if(!expected[i] || i % 50 == 0) continue;
+		expected[i] = false;
+		TEST_ASSERT(Roaring_Remove(r, i));
+	}
+	_validate(r, expected, n);
+	TEST_ASSERT(Roaring_Memory(r) < dense);
+
+	Roaring_Free(r);
+	free(expected);
+}
+
+void test_roaringAnd() {
+	uint64_t n = 150000;
+	bool *expected = calloc(n, sizeof(bool));
+
+	Roaring *a = Roaring_New();
+	Roaring *b = Roaring_New();
+
+	// 'a' mixes dense and sparse containers
+	// 'b' is sparse in the first container and dense in the second
+	for(uint64_t i = 0; i < n; i++) {
+		bool in_a = (i < 70000) ? (i % 2 == 0) : (i % 97 == 0);
+		bool in_b = (i < 65536) ? (i % 33 == 0) : (i % 3 == 0);
+		if(in_a) Roaring_Add(a, i);
+		if(in_b) Roaring_Add(b, i);
+		expected[i] = in_a && in_b;
+	}
+
+	Roaring *c = Roaring_Clone(a);
+	TEST_ASSERT(Roaring_Memory(c) == Roaring_Memory(a));
+
+	Roaring_And(a, b);
+	_validate(a, expected, n);
+
+	// intersection is commutative
+	Roaring_And(b, c);
+	_validate(b, expected, n);
+
+	// intersecting with an empty set empties the set
+	Roaring *empty = Roaring_New();
+	Roaring_And(c, empty);
+	TEST_ASSERT(Roaring_Cardinality(c) == 0);
+
+	RoaringIterator it;
+	uint64_t v;
+	RoaringIterator_Init(&it, c);
+	TEST_ASSERT(!RoaringIterator_Next(&it, &v));
+
+	Roaring_Free(a);
+	Roaring_Free(b);
+	Roaring_Free(c);
+	Roaring_Free(empty);
+	free(expected);
+}
+
+TEST_LIST = {
+	{"roaringAddRemove", test_roaringAddRemove},
+	{"roaringDense", test_roaringDense},
+	{"roaringAnd", test_roaringAnd},
+	{NULL, NULL}
+};
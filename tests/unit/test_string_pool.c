@@ -0,0 +1,141 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "src/value.h"
+#include "src/util/rmalloc.h"
+#include "src/util/string_pool.h"
+
+#include <string.h>
+#include <pthread.h>
+
+void setup() {
+	Alloc_Reset();
+}
+
+#define TEST_INIT setup();
+#include "acutest.h"
+
+void test_stringPoolIntern() {
+	StringPool *pool = StringPool_New();
+
+	char buff[16];
+	strcpy(buff, "Germany");
+
+	// equal strings share a single allocation
+	char *a = StringPool_Intern(pool, "Germany");
+	char *b = StringPool_Intern(pool, buff);
+	char *c = StringPool_Intern(pool, "France");
+
+	TEST_ASSERT(a == b);
+	TEST_ASSERT(a != c);
+	TEST_ASSERT(a != buff);
+	TEST_ASSERT(strcmp(a, "Germany") == 0);
+	TEST_ASSERT(strcmp(c, "France") == 0);
+	TEST_ASSERT(StringPool_Count(pool) == 2);
+
+	StringPool_Release(a);
+	StringPool_Release(b);
+	StringPool_Release(c);
+
+	StringPool_Free(pool);
+}
+
+void test_stringPoolRelease() {
+	StringPool *pool = StringPool_New();
+
+	char *a = StringPool_Intern(pool, "active");
+	char *b = StringPool_Intern(pool, "active");
+	StringPool_Retain(a);
+
+	// string is kept as long as it is referenced
+	StringPool_Release(a);
+	StringPool_Release(b);
+	TEST_ASSERT(StringPool_Count(pool) == 1);
+
+	StringPool_Release(a);
+	TEST_ASSERT(StringPool_Count(pool) == 0);
+
+	// string is re-created once interned again
+	a = StringPool_Intern(pool, "active");
+	TEST_ASSERT(strcmp(a, "active") == 0);
+	TEST_ASSERT(StringPool_Count(pool) == 1);
+
+	// pool frees strings which are still referenced
+	StringPool_Free(pool);
+}
+
+void test_stringPoolValues() {
+	StringPool *pool = StringPool_New();
+
+	SIValue a = SI_InternedStringVal(StringPool_Intern(pool, "status"));
+	SIValue b = SI_InternedStringVal(StringPool_Intern(pool, "status"));
+
+	TEST_ASSERT(a.stringval == b.stringval);
+	TEST_ASSERT(SIValue_Compare(a, b, NULL) == 0);
+	TEST_ASSERT(SIValue_Compare(a, SI_ConstStringVal("status"), NULL) == 0);
+
+	// cloning an interned string adds a reference
+	SIValue clone = SI_CloneValue(a);
+	TEST_ASSERT(clone.allocation == M_INTERN);
+	TEST_ASSERT(clone.stringval == a.stringval);
+
+	// shared values don't own a reference
+	SIValue shared = SI_ShareValue(a);
+	TEST_ASSERT(shared.allocation == M_VOLATILE);
+
+	SIValue_Free(a);
+	SIValue_Free(b);
+	TEST_ASSERT(StringPool_Count(pool) == 1);
+
+	SIValue_Free(clone);
+	TEST_ASSERT(StringPool_Count(pool) == 0);
+
+	StringPool_Free(pool);
+}
+
+// repeatedly intern and release a handful of strings
+static void *_churn(void *arg) {
+	StringPool *pool = (StringPool *)arg;
+	const char *strs[3] = {"red", "green", "blue"};
+
+	for(int i = 0; i < 20000; i++) {
+		char *s = StringPool_Intern(pool, strs[i % 3]);
+		if(strcmp(s, strs[i % 3]) != 0) return (void *)1;
+		StringPool_Release(s);
+	}
+
+	return NULL;
+}
+
+void test_stringPoolConcurrentRelease() {
+	StringPool *pool = StringPool_New();
+
+	// strings are dropped and re-created while other threads
+	// intern them concurrently
+	int n = 4;
+	pthread_t threads[n];
+	for(int i = 0; i < n; i++) {
+		pthread_create(threads + i, NULL, _churn, pool);
+	}
+
+	for(int i = 0; i < n; i++) {
+		void *res;
+		pthread_join(threads[i], &res);
+		TEST_ASSERT(res == NULL);
+	}
+
+	TEST_ASSERT(StringPool_Count(pool) == 0);
+
+	StringPool_Free(pool);
+}
+
+TEST_LIST = {
+	{"stringPoolIntern", test_stringPoolIntern},
+	{"stringPoolRelease", test_stringPoolRelease},
+	{"stringPoolValues", test_stringPoolValues},
+	{"stringPoolConcurrentRelease", test_stringPoolConcurrentRelease},
+	{NULL, NULL}
+};